@@ -28,12 +28,18 @@ class IndexPack extends TextBuiltin {
 	@Option(name = "--index-version", usage = "usage_indexFileFormatToCreate")
 	private int indexVersion = -1;
 
+	@Option(name = "--threads", usage = "usage_threadsToResolveDeltas")
+	private int threads = -1;
+
 	@Override
 	protected void run() {
 		BufferedInputStream in = new BufferedInputStream(ins);
 		try (ObjectInserter inserter = db.newObjectInserter()) {
 			PackParser p = inserter.newPackParser(in);
 			p.setAllowThin(fixThin);
+			if (threads != -1) {
+				p.setThreads(threads);
+			}
 			if (indexVersion != -1 && p instanceof ObjectDirectoryPackParser) {
 				ObjectDirectoryPackParser imp = (ObjectDirectoryPackParser) p;
 				imp.setIndexVersion(indexVersion);
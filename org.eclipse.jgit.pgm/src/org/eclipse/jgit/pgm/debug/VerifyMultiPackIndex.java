@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.pgm.debug;
+
+import static org.eclipse.jgit.internal.storage.pack.PackExt.INDEX;
+
+import java.io.File;
+import java.nio.file.Files;
+import java.security.MessageDigest;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.Map;
+
+import org.eclipse.jgit.internal.storage.file.FileRepository;
+import org.eclipse.jgit.internal.storage.file.Pack;
+import org.eclipse.jgit.internal.storage.file.PackIndex;
+import org.eclipse.jgit.internal.storage.midx.MultiPackIndex;
+import org.eclipse.jgit.internal.storage.midx.MultiPackIndexLoader;
+import org.eclipse.jgit.lib.Constants;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.lib.TextProgressMonitor;
+import org.eclipse.jgit.pgm.Command;
+import org.eclipse.jgit.pgm.TextBuiltin;
+
+/**
+ * Verifies the multi-pack-index of the repository against its packs.
+ */
+@Command(usage = "usage_VerifyMultiPackIndex")
+class VerifyMultiPackIndex extends TextBuiltin {
+
+	@SuppressWarnings("nls")
+	@Override
+	protected void run() throws Exception {
+		if (!(db instanceof FileRepository)) {
+			throw die("not a file repository");
+		}
+		FileRepository repo = (FileRepository) db;
+		File midxFile = new File(repo.getObjectDatabase().getPackDirectory(),
+				Constants.MULTI_PACK_INDEX);
+		byte[] raw = Files.readAllBytes(midxFile.toPath());
+		MessageDigest md = Constants.newMessageDigest();
+		md.update(raw, 0, raw.length - Constants.OBJECT_ID_LENGTH);
+		byte[] trailer = Arrays.copyOfRange(raw,
+				raw.length - Constants.OBJECT_ID_LENGTH, raw.length);
+		if (!Arrays.equals(md.digest(), trailer)) {
+			throw die("checksum mismatch");
+		}
+
+		MultiPackIndex midx = MultiPackIndexLoader.open(midxFile);
+		Map<String, PackIndex> indexes = new HashMap<>();
+		for (Pack p : repo.getObjectDatabase().getPacks()) {
+			indexes.put(p.getPackFile().create(INDEX).getName(),
+					p.getIndex());
+		}
+		String[] names = midx.getPackNames();
+		PackIndex[] byPackId = new PackIndex[names.length];
+		for (int i = 0; i < names.length; i++) {
+			byPackId[i] = indexes.get(names[i]);
+			if (byPackId[i] == null) {
+				throw die("missing pack " + names[i]);
+			}
+			if (i > 0 && names[i - 1].compareTo(names[i]) >= 0) {
+				throw die("pack names out of order: " + names[i]);
+			}
+		}
+
+		TextProgressMonitor pm = new TextProgressMonitor(errw);
+		pm.beginTask("Verifying object offsets", midx.getObjectCount());
+		ObjectId prev = null;
+		for (int pos = 0; pos < midx.getObjectCount(); pos++) {
+			ObjectId id = midx.getObjectId(pos);
+			if (prev != null && prev.compareTo(id) >= 0) {
+				throw die("objects out of order at " + id.name());
+			}
+			long offset = byPackId[midx.getPackId(pos)].findOffset(id);
+			if (offset != midx.getOffset(pos)) {
+				throw die("incorrect offset for " + id.name() + ": "
+						+ midx.getOffset(pos) + " != " + offset);
+			}
+			prev = id;
+			pm.update(1);
+		}
+		pm.endTask();
+
+		pm.beginTask("Verifying object coverage", names.length);
+		for (PackIndex idx : byPackId) {
+			for (PackIndex.MutableEntry e : idx) {
+				if (midx.findPosition(e.toObjectId()) < 0) {
+					throw die("object missing: " + e.name());
+				}
+			}
+			pm.update(1);
+		}
+		pm.endTask();
+		outw.println("OK");
+	}
+}
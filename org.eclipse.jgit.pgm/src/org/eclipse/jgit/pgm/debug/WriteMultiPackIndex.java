@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.pgm.debug;
+
+import org.eclipse.jgit.internal.storage.file.FileRepository;
+import org.eclipse.jgit.internal.storage.file.GC;
+import org.eclipse.jgit.lib.TextProgressMonitor;
+import org.eclipse.jgit.pgm.Command;
+import org.eclipse.jgit.pgm.TextBuiltin;
+
+/**
+ * Writes a multi-pack-index covering all packs of the repository.
+ */
+@Command(usage = "usage_WriteMultiPackIndex")
+class WriteMultiPackIndex extends TextBuiltin {
+
+	@Override
+	protected void run() throws Exception {
+		if (!(db instanceof FileRepository)) {
+			throw die("not a file repository"); //$NON-NLS-1$
+		}
+		GC gc = new GC((FileRepository) db);
+		gc.setProgressMonitor(new TextProgressMonitor(errw));
+		gc.writeMultiPackIndex();
+	}
+}
@@ -25,6 +25,7 @@
 import java.io.OutputStream;
 import java.io.PrintWriter;
 import java.nio.file.Files;
+import java.util.Properties;
 import java.util.Set;
 import java.util.concurrent.TimeUnit;
 
@@ -1335,6 +1336,62 @@ public void testAddGitlinkDoesNotChange() throws Exception {
 		}
 	}
 
+	@Test
+	public void testAddFilesInParallel() throws Exception {
+		StoredConfig config = db.getConfig();
+		config.setInt(ConfigConstants.CONFIG_ADD_SECTION, null,
+				ConfigConstants.CONFIG_KEY_WORKERS, 4);
+		config.setString(ConfigConstants.CONFIG_CORE_SECTION, null,
+				ConfigConstants.CONFIG_KEY_AUTOCRLF, "input");
+		config.save();
+		writeTrashFile(".gitattributes", "*.bin -text\n");
+		for (int i = 0; i < 150; i++) {
+			writeTrashFile("dir" + (i % 7) + "/f" + i + ".bin",
+					"content " + i + "\r\n");
+		}
+		// Converted on the calling thread
+		writeTrashFile("crlf.txt", "a\r\nb\r\n");
+		try (Git git = new Git(db)) {
+			DirCache dc = git.add().addFilepattern(".").call();
+			assertEquals(152, dc.getEntryCount());
+			ObjectInserter.Formatter fmt = new ObjectInserter.Formatter();
+			for (int i = 0; i < dc.getEntryCount(); i++) {
+				DirCacheEntry e = dc.getEntry(i);
+				String path = e.getPathString();
+				String content = path.equals("crlf.txt") ? "a\nb\n"
+						: read(path);
+				assertEquals(path,
+						fmt.idFor(Constants.OBJ_BLOB, content.getBytes(UTF_8)),
+						e.getObjectId());
+				assertTrue(db.getObjectDatabase().has(e.getObjectId()));
+			}
+		}
+	}
+
+	@Test
+	public void testAddManyFilesInParallelWritesPacks() throws Exception {
+		StoredConfig config = db.getConfig();
+		config.setInt(ConfigConstants.CONFIG_ADD_SECTION, null,
+				ConfigConstants.CONFIG_KEY_WORKERS, 2);
+		config.save();
+		for (int i = 0; i < 1000; i++) {
+			writeTrashFile("d" + (i % 10) + "/f" + i, "content " + i);
+		}
+		try (Git git = new Git(db)) {
+			DirCache dc = git.add().addFilepattern(".").call();
+			assertEquals(1000, dc.getEntryCount());
+			for (int i = 0; i < dc.getEntryCount(); i++) {
+				DirCacheEntry e = dc.getEntry(i);
+				assertEquals(read(e.getPathString()),
+						new String(db.open(e.getObjectId()).getBytes(),
+								UTF_8));
+			}
+			Properties stats = git.gc().getStatistics();
+			assertEquals(Long.valueOf(0), stats.get("numberOfLooseObjects"));
+			assertTrue(((Long) stats.get("numberOfPackFiles")).longValue() > 0);
+		}
+	}
+
 	private static DirCacheEntry addEntryToBuilder(String path, File file,
 			ObjectInserter newObjectInserter, DirCacheBuilder builder, int stage)
 			throws IOException {
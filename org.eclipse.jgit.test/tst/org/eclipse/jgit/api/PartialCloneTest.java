@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.api;
+
+import static java.nio.charset.StandardCharsets.UTF_8;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertThrows;
+import static org.junit.Assert.assertTrue;
+
+import java.io.File;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+import org.eclipse.jgit.errors.MissingObjectException;
+import org.eclipse.jgit.junit.JGitTestUtil;
+import org.eclipse.jgit.junit.RepositoryTestCase;
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.lib.Repository;
+import org.eclipse.jgit.lib.StoredConfig;
+import org.eclipse.jgit.revwalk.RevCommit;
+import org.eclipse.jgit.transport.FilterSpec;
+import org.eclipse.jgit.util.LazyFetch;
+import org.junit.Before;
+import org.junit.Test;
+
+public class PartialCloneTest extends RepositoryTestCase {
+	private Git git;
+
+	private RevCommit initial;
+
+	@Before
+	public void setup() throws Exception {
+		StoredConfig config = db.getConfig();
+		config.setBoolean("uploadpack", null, "allowfilter", true);
+		config.setBoolean("uploadpack", null, "allowreachablesha1inwant",
+				true);
+		config.save();
+
+		git = new Git(db);
+		writeTrashFile("a.txt", "a");
+		writeTrashFile("dir/b.txt", "b");
+		writeTrashFile("dir/c.txt", "c");
+		git.add().addFilepattern(".").call();
+		initial = git.commit().setMessage("initial").call();
+	}
+
+	@Test
+	public void testCloneWithoutBlobs() throws Exception {
+		Repository clone = cloneWithoutBlobs(true);
+		StoredConfig config = clone.getConfig();
+		assertEquals("origin",
+				config.getString(ConfigConstants.CONFIG_EXTENSIONS_SECTION,
+						null, ConfigConstants.CONFIG_KEY_PARTIAL_CLONE));
+		assertTrue(config.getBoolean(ConfigConstants.CONFIG_REMOTE_SECTION,
+				"origin", ConfigConstants.CONFIG_KEY_PROMISOR, false));
+		assertEquals("blob:none",
+				config.getString(ConfigConstants.CONFIG_REMOTE_SECTION,
+						"origin",
+						ConfigConstants.CONFIG_KEY_PARTIAL_CLONE_FILTER));
+		assertEquals(1, config.getInt(ConfigConstants.CONFIG_CORE_SECTION,
+				ConfigConstants.CONFIG_KEY_REPO_FORMAT_VERSION, 0));
+
+		assertTrue(clone.getObjectDatabase().has(initial.getTree()));
+		ObjectId blob = blobOf("dir/b.txt");
+		assertFalse(clone.getObjectDatabase().has(blob));
+		assertEquals(1, packs(clone, ".promisor").size());
+	}
+
+	@Test
+	public void testOpenFetchesMissingBlob() throws Exception {
+		Repository clone = cloneWithoutBlobs(true);
+		ObjectId blob = blobOf("dir/b.txt");
+		assertEquals("b",
+				new String(clone.open(blob).getCachedBytes(), UTF_8));
+		assertTrue(clone.getObjectDatabase().has(blob));
+		assertFalse(clone.getObjectDatabase().has(blobOf("dir/c.txt")));
+		// Packs fetched from the promisor remote are marked too.
+		assertEquals(2, packs(clone, ".promisor").size());
+	}
+
+	@Test
+	public void testCheckoutFetchesBlobsAtOnce() throws Exception {
+		Repository clone = cloneWithoutBlobs(false);
+		File work = clone.getWorkTree();
+		assertEquals("a", read(new File(work, "a.txt")));
+		assertEquals("b", read(new File(work, "dir/b.txt")));
+		assertEquals("c", read(new File(work, "dir/c.txt")));
+		// One pack from the clone, one with all blobs of the checkout.
+		assertEquals(2, packs(clone, ".pack").size());
+		assertTrue(Git.wrap(clone).status().call().isClean());
+	}
+
+	@Test
+	public void testDisabledFetchOnWorkerThread() throws Exception {
+		Repository clone = cloneWithoutBlobs(true);
+		ObjectId blob = blobOf("dir/b.txt");
+		ExecutorService pool = Executors.newSingleThreadExecutor();
+		boolean enabled = LazyFetch.disable();
+		try {
+			Future<?> f = pool
+					.submit(LazyFetch.inherit(() -> clone.open(blob)));
+			ExecutionException e = assertThrows(ExecutionException.class,
+					f::get);
+			assertTrue(e.getCause() instanceof MissingObjectException);
+		} finally {
+			LazyFetch.restore(enabled);
+			pool.shutdown();
+		}
+		assertFalse(clone.getObjectDatabase().has(blob));
+	}
+
+	@Test
+	public void testFetchUsesPartialCloneFilter() throws Exception {
+		Repository clone = cloneWithoutBlobs(true);
+		writeTrashFile("d.txt", "d");
+		git.add().addFilepattern("d.txt").call();
+		RevCommit second = git.commit().setMessage("second").call();
+
+		Git.wrap(clone).fetch().call();
+		assertTrue(clone.getObjectDatabase().has(second));
+		assertFalse(clone.getObjectDatabase().has(blobOf("d.txt")));
+		assertEquals(2, packs(clone, ".promisor").size());
+	}
+
+	@Test
+	public void testGcKeepsPromisorPack() throws Exception {
+		Repository clone = cloneWithoutBlobs(true);
+		File promisor = packs(clone, ".promisor").get(0);
+		Git local = Git.wrap(clone);
+		JGitTestUtil.write(new File(clone.getWorkTree(), "e.txt"), "e");
+		local.add().addFilepattern("e.txt").call();
+		RevCommit commit = local.commit().setMessage("local").call();
+
+		local.gc().call();
+		assertTrue(promisor.exists());
+		assertEquals(2, packs(clone, ".pack").size());
+		assertTrue(clone.getObjectDatabase().has(commit.getTree()));
+		assertTrue(clone.getObjectDatabase().has(initial.getTree()));
+		// The promised blobs are neither fetched nor looked for.
+		assertFalse(clone.getObjectDatabase().has(blobOf("dir/b.txt")));
+		assertEquals(1, packs(clone, ".promisor").size());
+	}
+
+	private Repository cloneWithoutBlobs(boolean noCheckout)
+			throws Exception {
+		File directory = createTempDirectory("partial");
+		Git clone = Git.cloneRepository().setDirectory(directory)
+				.setURI("file://" + db.getWorkTree().getAbsolutePath())
+				.setFilterSpec(FilterSpec.fromFilterLine("blob:none"))
+				.setNoCheckout(noCheckout).call();
+		addRepoToClose(clone.getRepository());
+		return clone.getRepository();
+	}
+
+	private ObjectId blobOf(String path) throws Exception {
+		return db.resolve("HEAD:" + path);
+	}
+
+	private static List<File> packs(Repository repo, String ext) {
+		File dir = new File(repo.getDirectory(), "objects/pack");
+		List<File> files = new ArrayList<>();
+		for (File f : dir.listFiles()) {
+			if (f.getName().endsWith(ext)) {
+				files.add(f);
+			}
+		}
+		return files;
+	}
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.dircache;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import java.io.File;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.security.MessageDigest;
+import java.util.Arrays;
+
+import org.eclipse.jgit.junit.RepositoryTestCase;
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.Constants;
+import org.eclipse.jgit.lib.FileMode;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.storage.file.FileBasedConfig;
+import org.eclipse.jgit.util.NB;
+import org.junit.Before;
+import org.junit.Test;
+
+public class DirCacheOffsetTableTest extends RepositoryTestCase {
+	private static final int ENTRY_COUNT = 25000;
+
+	@Before
+	public void setup() throws Exception {
+		FileBasedConfig cfg = db.getConfig();
+		cfg.setInt(ConfigConstants.CONFIG_INDEX_SECTION, null,
+				ConfigConstants.CONFIG_KEY_THREADS, 4);
+		cfg.save();
+	}
+
+	@Test
+	public void testReadWriteOffsetTable() throws Exception {
+		assertRoundTrip();
+	}
+
+	@Test
+	public void testReadWriteOffsetTable_PathCompressed() throws Exception {
+		FileBasedConfig cfg = db.getConfig();
+		cfg.setInt(ConfigConstants.CONFIG_INDEX_SECTION, null,
+				ConfigConstants.CONFIG_KEY_VERSION, 4);
+		cfg.save();
+		assertRoundTrip();
+	}
+
+	@Test
+	public void testNoOffsetTableWithSingleThread() throws Exception {
+		FileBasedConfig cfg = db.getConfig();
+		cfg.setBoolean(ConfigConstants.CONFIG_INDEX_SECTION, null,
+				ConfigConstants.CONFIG_KEY_THREADS, false);
+		cfg.save();
+		writeEntries();
+
+		byte[] raw = Files.readAllBytes(db.getIndexFile().toPath());
+		assertFalse(contains(raw, "IEOT"));
+		assertFalse(contains(raw, "EOIE"));
+	}
+
+	@Test
+	public void testUnknownOptionalExtensionIsPreserved() throws Exception {
+		FileBasedConfig cfg = db.getConfig();
+		cfg.setBoolean(ConfigConstants.CONFIG_INDEX_SECTION, null,
+				ConfigConstants.CONFIG_KEY_RECORD_END_OF_INDEX_ENTRIES,
+				false);
+		cfg.save();
+		DirCache dc = db.lockDirCache();
+		DirCacheBuilder b = dc.builder();
+		b.add(entry("a"));
+		b.add(entry("b"));
+		b.finish();
+		dc.write();
+		assertTrue(dc.commit());
+
+		File idx = db.getIndexFile();
+		byte[] raw = Files.readAllBytes(idx.toPath());
+		byte[] ext = { 'Z', 'Z', 'Z', 'Z', 0, 0, 0, 3, 'a', 'b', 'c' };
+		byte[] modified = new byte[raw.length + ext.length];
+		int end = raw.length - Constants.OBJECT_ID_LENGTH;
+		System.arraycopy(raw, 0, modified, 0, end);
+		System.arraycopy(ext, 0, modified, end, ext.length);
+		MessageDigest md = Constants.newMessageDigest();
+		md.update(modified, 0, end + ext.length);
+		md.digest(modified, end + ext.length, Constants.OBJECT_ID_LENGTH);
+		Files.write(idx.toPath(), modified);
+
+		dc = db.lockDirCache();
+		assertEquals(2, dc.getEntryCount());
+		dc.write();
+		assertTrue(dc.commit());
+		assertTrue(contains(Files.readAllBytes(idx.toPath()), "ZZZZ"));
+
+		// Changing the entries invalidates the extension.
+		dc = db.lockDirCache();
+		b = dc.builder();
+		b.add(entry("a"));
+		b.finish();
+		dc.write();
+		assertTrue(dc.commit());
+		assertFalse(contains(Files.readAllBytes(idx.toPath()), "ZZZZ"));
+	}
+
+	private void assertRoundTrip() throws Exception {
+		// Read the missing index first, so that the repository configuration
+		// is known when the index is read again.
+		DirCache dc = db.readDirCache();
+		assertEquals(0, dc.getEntryCount());
+
+		DirCacheEntry[] expected = writeEntries();
+
+		byte[] raw = Files.readAllBytes(db.getIndexFile().toPath());
+		int eoie = raw.length - Constants.OBJECT_ID_LENGTH - 8 - 24;
+		assertEquals("EOIE",
+				new String(raw, eoie, 4, StandardCharsets.US_ASCII));
+		int extStart = NB.decodeInt32(raw, eoie + 8);
+		assertEquals("IEOT",
+				new String(raw, extStart, 4, StandardCharsets.US_ASCII));
+		// 25000 entries on 4 threads are split into 3 blocks.
+		assertEquals(4 + 3 * 8, NB.decodeInt32(raw, extStart + 4));
+
+		dc.read();
+		assertEquals(expected.length, dc.getEntryCount());
+		for (int i = 0; i < expected.length; i++) {
+			DirCacheEntry e = dc.getEntry(i);
+			assertEquals(expected[i].getPathString(), e.getPathString());
+			assertEquals(expected[i].getObjectId(), e.getObjectId());
+			assertEquals(expected[i].getFileMode(), e.getFileMode());
+		}
+
+		dc = db.readDirCache();
+		assertEquals(expected.length, dc.getEntryCount());
+		assertEquals(expected[expected.length - 1].getPathString(),
+				dc.getEntry(expected.length - 1).getPathString());
+	}
+
+	private DirCacheEntry[] writeEntries() throws Exception {
+		DirCacheEntry[] entries = new DirCacheEntry[ENTRY_COUNT];
+		DirCache dc = db.lockDirCache();
+		DirCacheBuilder b = dc.builder();
+		for (int i = 0; i < entries.length; i++) {
+			entries[i] = entry(String.format("d%03d/f%05d",
+					Integer.valueOf(i / 100), Integer.valueOf(i)));
+			b.add(entries[i]);
+		}
+		b.finish();
+		dc.write();
+		assertTrue(dc.commit());
+		return entries;
+	}
+
+	private static DirCacheEntry entry(String path) {
+		DirCacheEntry e = new DirCacheEntry(path);
+		e.setFileMode(FileMode.REGULAR_FILE);
+		byte[] id = new byte[Constants.OBJECT_ID_LENGTH];
+		NB.encodeInt32(id, 0, path.hashCode());
+		e.setObjectId(ObjectId.fromRaw(id));
+		return e;
+	}
+
+	private static boolean contains(byte[] raw, String ext) {
+		byte[] sig = ext.getBytes(StandardCharsets.US_ASCII);
+		for (int i = 0; i + sig.length <= raw.length; i++) {
+			if (Arrays.equals(raw, i, i + sig.length, sig, 0, sig.length)) {
+				return true;
+			}
+		}
+		return false;
+	}
+}
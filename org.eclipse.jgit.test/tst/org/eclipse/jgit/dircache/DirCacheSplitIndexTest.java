@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.dircache;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+import java.io.File;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.time.Instant;
+import java.util.Arrays;
+
+import org.eclipse.jgit.dircache.DirCacheEditor.DeletePath;
+import org.eclipse.jgit.dircache.DirCacheEditor.PathEdit;
+import org.eclipse.jgit.junit.RepositoryTestCase;
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.Constants;
+import org.eclipse.jgit.lib.FileMode;
+import org.eclipse.jgit.lib.ObjectInserter;
+import org.eclipse.jgit.storage.file.FileBasedConfig;
+import org.junit.Before;
+import org.junit.Test;
+
+public class DirCacheSplitIndexTest extends RepositoryTestCase {
+	private static final int ENTRY_COUNT = 20;
+
+	@Before
+	public void setup() throws Exception {
+		setSplitIndex(Boolean.TRUE);
+		DirCache dc = db.lockDirCache();
+		DirCacheBuilder b = dc.builder();
+		for (int i = 0; i < ENTRY_COUNT; i++) {
+			b.add(entry(path(i)));
+		}
+		b.finish();
+		dc.write();
+		assertTrue(dc.commit());
+	}
+
+	@Test
+	public void testFirstWriteCreatesSharedIndex() throws Exception {
+		File[] shared = sharedIndexes();
+		assertEquals(1, shared.length);
+		byte[] raw = Files.readAllBytes(db.getIndexFile().toPath());
+		assertTrue(contains(raw, "link"));
+		assertTrue(raw.length < shared[0].length());
+		assertPaths(db.readDirCache(), allPaths());
+	}
+
+	@Test
+	public void testModifiedEntryIsReplaced() throws Exception {
+		File[] shared = sharedIndexes();
+		DirCache dc = db.lockDirCache();
+		dc.getEntry(path(3)).setLength(42);
+		dc.write();
+		assertTrue(dc.commit());
+
+		assertArrayEquals(shared, sharedIndexes());
+		DirCache read = db.readDirCache();
+		assertPaths(read, allPaths());
+		assertEquals(42, read.getEntry(path(3)).getLength());
+		assertEquals(1, read.getEntry(path(4)).getLength());
+	}
+
+	@Test
+	public void testAddedAndDeletedEntries() throws Exception {
+		File[] shared = sharedIndexes();
+		DirCache dc = db.lockDirCache();
+		DirCacheEditor editor = dc.editor();
+		editor.add(new DeletePath(path(5)));
+		editor.add(new PathEdit("f05a") {
+			@Override
+			public void apply(DirCacheEntry ent) {
+				fill(ent);
+			}
+		});
+		editor.add(new PathEdit(path(7)) {
+			@Override
+			public void apply(DirCacheEntry ent) {
+				ent.setLength(7);
+			}
+		});
+		editor.finish();
+		dc.write();
+		assertTrue(dc.commit());
+
+		assertArrayEquals(shared, sharedIndexes());
+		String[] expected = allPaths();
+		expected[5] = "f05a";
+		DirCache read = db.readDirCache();
+		assertPaths(read, expected);
+		assertNull(read.getEntry(path(5)));
+		assertEquals(7, read.getEntry(path(7)).getLength());
+
+		// Unmodified entries of the split index stay in the shared index.
+		dc = db.lockDirCache();
+		dc.write();
+		assertTrue(dc.commit());
+		assertArrayEquals(shared, sharedIndexes());
+		assertPaths(db.readDirCache(), expected);
+	}
+
+	@Test
+	public void testTooManyChangesWriteNewSharedIndex() throws Exception {
+		DirCache dc = db.lockDirCache();
+		for (int i = 0; i < 5; i++) {
+			dc.getEntry(path(i)).setLength(42);
+		}
+		dc.write();
+		assertTrue(dc.commit());
+
+		assertEquals(2, sharedIndexes().length);
+		DirCache read = db.readDirCache();
+		assertPaths(read, allPaths());
+		for (int i = 0; i < 5; i++) {
+			assertEquals(42, read.getEntry(path(i)).getLength());
+		}
+	}
+
+	@Test
+	public void testExpireSharedIndexes() throws Exception {
+		FileBasedConfig cfg = db.getConfig();
+		cfg.setInt(ConfigConstants.CONFIG_SPLIT_INDEX_SECTION, null,
+				ConfigConstants.CONFIG_KEY_MAX_PERCENT_CHANGE, 0);
+		cfg.setString(ConfigConstants.CONFIG_SPLIT_INDEX_SECTION, null,
+				ConfigConstants.CONFIG_KEY_SHARED_INDEX_EXPIRE, "now");
+		cfg.save();
+		File old = sharedIndexes()[0];
+		old.setLastModified(System.currentTimeMillis() - 60_000);
+
+		DirCache dc = db.lockDirCache();
+		dc.getEntry(path(0)).setLength(42);
+		dc.write();
+		assertTrue(dc.commit());
+
+		File[] shared = sharedIndexes();
+		assertEquals(1, shared.length);
+		assertFalse(shared[0].equals(old));
+	}
+
+	@Test
+	public void testDisableSplitIndex() throws Exception {
+		setSplitIndex(Boolean.FALSE);
+		DirCache dc = db.lockDirCache();
+		dc.getEntry(path(3)).setLength(42);
+		dc.write();
+		assertTrue(dc.commit());
+
+		byte[] raw = Files.readAllBytes(db.getIndexFile().toPath());
+		assertFalse(contains(raw, "link"));
+		DirCache read = db.readDirCache();
+		assertPaths(read, allPaths());
+		assertEquals(42, read.getEntry(path(3)).getLength());
+	}
+
+	@Test
+	public void testUnsetKeepsSplitIndex() throws Exception {
+		setSplitIndex(null);
+		DirCache dc = db.lockDirCache();
+		dc.getEntry(path(3)).setLength(42);
+		dc.write();
+		assertTrue(dc.commit());
+
+		byte[] raw = Files.readAllBytes(db.getIndexFile().toPath());
+		assertTrue(contains(raw, "link"));
+		assertEquals(42, db.readDirCache().getEntry(path(3)).getLength());
+	}
+
+	private void setSplitIndex(Boolean split) throws Exception {
+		FileBasedConfig cfg = db.getConfig();
+		if (split == null) {
+			cfg.unset(ConfigConstants.CONFIG_CORE_SECTION, null,
+					ConfigConstants.CONFIG_KEY_SPLIT_INDEX);
+		} else {
+			cfg.setBoolean(ConfigConstants.CONFIG_CORE_SECTION, null,
+					ConfigConstants.CONFIG_KEY_SPLIT_INDEX,
+					split.booleanValue());
+		}
+		cfg.save();
+	}
+
+	private File[] sharedIndexes() {
+		File[] files = db.getDirectory()
+				.listFiles((d, name) -> name.startsWith("sharedindex."));
+		Arrays.sort(files);
+		return files;
+	}
+
+	private static String path(int i) {
+		return String.format("f%02d", Integer.valueOf(i));
+	}
+
+	private static String[] allPaths() {
+		String[] paths = new String[ENTRY_COUNT];
+		for (int i = 0; i < ENTRY_COUNT; i++) {
+			paths[i] = path(i);
+		}
+		return paths;
+	}
+
+	private static DirCacheEntry entry(String path) {
+		DirCacheEntry e = new DirCacheEntry(path);
+		fill(e);
+		return e;
+	}
+
+	private static void fill(DirCacheEntry e) {
+		e.setFileMode(FileMode.REGULAR_FILE);
+		e.setLastModified(Instant.ofEpochSecond(1000));
+		e.setLength(1);
+		e.setObjectId(new ObjectInserter.Formatter().idFor(
+				Constants.OBJ_BLOB,
+				e.getPathString().getBytes(StandardCharsets.UTF_8)));
+	}
+
+	private static void assertPaths(DirCache dc, String... paths) {
+		assertEquals(paths.length, dc.getEntryCount());
+		for (int i = 0; i < paths.length; i++) {
+			assertEquals(paths[i], dc.getEntry(i).getPathString());
+		}
+	}
+
+	private static boolean contains(byte[] raw, String ext) {
+		byte[] b = ext.getBytes(StandardCharsets.US_ASCII);
+		for (int i = 0; i + b.length <= raw.length; i++) {
+			if (Arrays.equals(raw, i, i + b.length, b, 0, b.length)) {
+				return true;
+			}
+		}
+		return false;
+	}
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.dircache;
+
+import static java.nio.charset.StandardCharsets.UTF_8;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assume.assumeFalse;
+import static org.junit.Assume.assumeTrue;
+
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.List;
+import java.util.Set;
+
+import org.eclipse.jgit.api.Git;
+import org.eclipse.jgit.junit.RepositoryTestCase;
+import org.eclipse.jgit.lib.Constants;
+import org.eclipse.jgit.lib.IndexDiff;
+import org.eclipse.jgit.treewalk.FileTreeIterator;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+public class FsMonitorTest extends RepositoryTestCase {
+	private final TestMonitor monitor = new TestMonitor();
+
+	@Before
+	public void setup() throws Exception {
+		FsMonitor.setProvider(r -> r == db ? monitor : null);
+		writeTrashFile("a", "a");
+		writeTrashFile("dir/b", "b");
+		writeTrashFile("dir/c", "c");
+		try (Git git = new Git(db)) {
+			git.add().addFilepattern(".").call();
+			git.commit().setMessage("initial").call();
+		}
+		fsTick(db.getIndexFile());
+	}
+
+	@After
+	public void resetProvider() {
+		FsMonitor.setProvider(null);
+	}
+
+	@Test
+	public void testUnmodifiedEntriesAreRecorded() throws Exception {
+		assertTrue(diff().getModified().isEmpty());
+
+		DirCache dc = db.readDirCache();
+		assertEquals(monitor.token(), dc.getFsMonitorToken());
+		dc.refreshFsMonitor(monitor);
+		for (int i = 0; i < dc.getEntryCount(); i++) {
+			assertTrue(dc.getEntry(i).isFsMonitorValid());
+		}
+	}
+
+	@Test
+	public void testStoredEntriesNeedMonitor() throws Exception {
+		diff();
+		DirCache dc = db.readDirCache();
+		for (int i = 0; i < dc.getEntryCount(); i++) {
+			assertFalse(dc.getEntry(i).isFsMonitorValid());
+		}
+
+		// Writing the index keeps the stored entries valid.
+		dc = db.lockDirCache();
+		dc.write();
+		assertTrue(dc.commit());
+		assertTrue(refreshed().getEntry("a").isFsMonitorValid());
+
+		// A repository without monitor drops the extension.
+		FsMonitor.setProvider(null);
+		dc = db.lockDirCache();
+		dc.write();
+		assertTrue(dc.commit());
+		assertNull(db.readDirCache().getFsMonitorToken());
+	}
+
+	@Test
+	public void testValidEntriesAreNotChecked() throws Exception {
+		diff();
+		writeTrashFile("a", "modified");
+		writeTrashFile("dir/b", "modified");
+
+		// Without a report from the monitor the files are not looked at.
+		assertTrue(diff().getModified().isEmpty());
+
+		monitor.changed.add("a");
+		assertEquals(Set.of("a"), diff().getModified());
+		assertFalse(refreshed().getEntry("a").isFsMonitorValid());
+
+		monitor.changed.add("dir/");
+		assertEquals(Set.of("a", "dir/b"), diff().getModified());
+		assertTrue(refreshed().getEntry("dir/c").isFsMonitorValid());
+	}
+
+	@Test
+	public void testUnknownChangesCheckAllEntries() throws Exception {
+		diff();
+		writeTrashFile("dir/c", "modified");
+		monitor.everything = true;
+		assertEquals(Set.of("dir/c"), diff().getModified());
+	}
+
+	@Test
+	public void testModifiedEntryIsNotValid() throws Exception {
+		diff();
+		DirCache dc = db.lockDirCache();
+		dc.refreshFsMonitor(monitor);
+		DirCacheEntry e = dc.getEntry("a");
+		assertTrue(e.isFsMonitorValid());
+		e.setLength(42);
+		assertFalse(e.isFsMonitorValid());
+		dc.write();
+		assertTrue(dc.commit());
+		assertFalse(refreshed().getEntry("a").isFsMonitorValid());
+		assertTrue(refreshed().getEntry("dir/b").isFsMonitorValid());
+	}
+
+	@Test
+	public void testParseHookOutput() {
+		FsMonitor.Changes c = HookFsMonitor
+				.parse("t2\0a\0dir/\0".getBytes(UTF_8));
+		assertEquals("t2", c.getToken());
+		assertEquals(List.of("a", "dir/"), c.getPaths());
+
+		c = HookFsMonitor.parse("t2\0/\0".getBytes(UTF_8));
+		assertEquals("t2", c.getToken());
+		assertNull(c.getPaths());
+
+		c = HookFsMonitor.parse(new byte[0]);
+		assertNull(c.getToken());
+		assertNull(c.getPaths());
+	}
+
+	@Test
+	public void testWatchServiceMonitor() throws Exception {
+		try (WatchServiceFsMonitor m = WatchServiceFsMonitor.get(db)) {
+			assumeTrue(m.isWatching());
+			FsMonitor.Changes c = m.query(null);
+			assertNotNull(c.getToken());
+			assertNull(c.getPaths());
+
+			writeTrashFile("a", "modified");
+			c = m.query(c.getToken());
+			assertEquals(List.of("a"), c.getPaths());
+
+			c = m.query(c.getToken());
+			assertTrue(c.getPaths().isEmpty());
+
+			writeTrashFile("new/d", "d");
+			c = m.query(c.getToken());
+			assertTrue(c.getPaths().contains("new"));
+		}
+	}
+
+	@Test
+	public void testPollingWatchServiceReportsEverything() throws Exception {
+		try (WatchServiceFsMonitor m = WatchServiceFsMonitor.get(db)) {
+			assumeFalse(m.isWatching());
+			FsMonitor.Changes c = m.query(null);
+			assertNull(c.getToken());
+			assertNull(c.getPaths());
+		}
+	}
+
+	private DirCache refreshed() throws Exception {
+		DirCache dc = db.readDirCache();
+		dc.refreshFsMonitor(monitor);
+		return dc;
+	}
+
+	private IndexDiff diff() throws Exception {
+		IndexDiff diff = new IndexDiff(db, Constants.HEAD,
+				new FileTreeIterator(db));
+		diff.diff();
+		return diff;
+	}
+
+	private static class TestMonitor extends FsMonitor {
+		final List<String> changed = new ArrayList<>();
+
+		boolean everything;
+
+		private int queries;
+
+		String token() {
+			return Integer.toString(queries);
+		}
+
+		@Override
+		public Changes query(String token) {
+			Collection<String> paths = everything ? null
+					: new ArrayList<>(changed);
+			changed.clear();
+			everything = false;
+			queries++;
+			return new Changes(token(), paths);
+		}
+	}
+}
@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.dircache;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assume.assumeTrue;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.time.Instant;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+
+import org.eclipse.jgit.api.Git;
+import org.eclipse.jgit.attributes.FilterCommand;
+import org.eclipse.jgit.attributes.FilterCommandRegistry;
+import org.eclipse.jgit.junit.RepositoryTestCase;
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.Constants;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.lib.ObjectInserter;
+import org.eclipse.jgit.lib.Repository;
+import org.eclipse.jgit.revwalk.RevCommit;
+import org.eclipse.jgit.storage.file.FileBasedConfig;
+import org.eclipse.jgit.storage.file.FileRepositoryBuilder;
+import org.eclipse.jgit.util.FS;
+import org.eclipse.jgit.util.FS_POSIX;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+public class ParallelCheckoutTest extends RepositoryTestCase {
+	private static final int DIRS = 10;
+
+	private static final int FILES = 30;
+
+	private static final String SMUDGE = Constants.BUILTIN_FILTER_PREFIX
+			+ "record/smudge";
+
+	/** Names of the threads which wrote a file, by path. */
+	private final Map<String, Set<String>> writers = new ConcurrentHashMap<>();
+
+	/** Names of the threads which ran the smudge filter. */
+	private final Set<String> filters = ConcurrentHashMap.newKeySet();
+
+	private RecordingFS fs;
+
+	private Git git;
+
+	private RevCommit initial;
+
+	@Before
+	public void setup() throws Exception {
+		assumeTrue(db.getFS() instanceof FS_POSIX);
+		FilterCommandRegistry.register(SMUDGE,
+				(repo, in, out) -> new RecordingFilter(in, out));
+		FileBasedConfig cfg = db.getConfig();
+		cfg.setInt(ConfigConstants.CONFIG_CHECKOUT_SECTION, null,
+				ConfigConstants.CONFIG_KEY_WORKERS, 4);
+		cfg.setInt(ConfigConstants.CONFIG_CHECKOUT_SECTION, null,
+				ConfigConstants.CONFIG_KEY_THRESHOLD_FOR_PARALLELISM, 10);
+		cfg.setString("filter", "record", "smudge", SMUDGE);
+		cfg.save();
+
+		// A file system recording the threads which write files
+		fs = new RecordingFS(db.getFS());
+		Repository repo = new FileRepositoryBuilder()
+				.setGitDir(db.getDirectory()).setFS(fs).build();
+		addRepoToClose(repo);
+		git = new Git(repo);
+		writeFiles("v1");
+		git.add().addFilepattern(".").call();
+		initial = git.commit().setMessage("initial").call();
+	}
+
+	@Test
+	public void testCheckoutBranch() throws Exception {
+		git.branchCreate().setName("side").call();
+		writeFiles("v2");
+		// A file replaced by a directory, and the other way round.
+		deleteTrashFile("d0/f0");
+		writeTrashFile("d0/f0/g", "g");
+		deleteTrashFile("d1/f0");
+		deleteTrashFile("d1/f1");
+		deleteTrashFile("d1");
+		writeTrashFile("d1", "d1");
+		git.add().addFilepattern(".").setUpdate(true).call();
+		git.add().addFilepattern(".").call();
+		RevCommit second = git.commit().setMessage("second").call();
+
+		writers.clear();
+		git.checkout().setName("side").call();
+		assertFiles("v1");
+		assertTrue(new File(trash, "d1").isDirectory());
+		assertEquals(initial.getTree(), indexTree());
+		assertWrittenByWorkers();
+
+		git.checkout().setName("master").call();
+		assertEquals("g", read("d0/f0/g"));
+		assertEquals("d1", read("d1"));
+		assertFiles("v2", "d0/f0", "d1");
+		assertEquals(second.getTree(), indexTree());
+		assertTrue(git.status().call().isClean());
+	}
+
+	@Test
+	public void testCheckoutEntriesUpdateIndex() throws Exception {
+		git.branchCreate().setName("side").call();
+		writeFiles("v2");
+		git.add().addFilepattern(".").call();
+		git.commit().setMessage("second").call();
+
+		writers.clear();
+		git.checkout().setName("side").call();
+		assertFiles("v1");
+		assertWrittenByWorkers();
+		// Lengths and modification times were recorded in the index.
+		DirCache dc = db.readDirCache();
+		for (int i = 0; i < dc.getEntryCount(); i++) {
+			DirCacheEntry e = dc.getEntry(i);
+			assertEquals(new File(trash, e.getPathString()).length(),
+					e.getLength());
+		}
+		assertTrue(git.status().call().isClean());
+	}
+
+	@Test
+	public void testBelowThresholdIsSequential() throws Exception {
+		git.branchCreate().setName("side").call();
+		writeTrashFile("d0/f0", "changed");
+		git.add().addFilepattern(".").call();
+		git.commit().setMessage("second").call();
+
+		writers.clear();
+		git.checkout().setName("side").call();
+		assertEquals(content("v1", 0, 0), read("d0/f0"));
+		assertFiles("v1");
+		assertWrittenByCallingThread("d0/f0");
+		assertFalse(isWrittenByWorkers());
+		assertFalse(git.status().call().hasUncommittedChanges());
+	}
+
+	@Test
+	public void testFilteredEntriesAreWrittenByCallingThread()
+			throws Exception {
+		git.branchCreate().setName("side").call();
+		writeTrashFile(".gitattributes", "d0/* filter=record");
+		writeFiles("v2");
+		git.add().addFilepattern(".").call();
+		git.commit().setMessage("second").call();
+
+		git.checkout().setName("side").call();
+		writers.clear();
+		filters.clear();
+		git.checkout().setName("master").call();
+		assertFiles("v2");
+		assertEquals(Set.of(Thread.currentThread().getName()), filters);
+		for (int f = 0; f < FILES; f++) {
+			assertWrittenByCallingThread("d0/f" + f);
+		}
+		assertWrittenByWorkers();
+	}
+
+	@Test
+	public void testCaseFoldedCollisionsAreWrittenByCallingThread()
+			throws Exception {
+		// Both spellings must fit in the working tree
+		assumeTrue(FS.DETECTED.isCaseSensitive());
+		git.branchCreate().setName("side").call();
+		writeFiles("v2");
+		// Sorted before the colliding paths
+		writeTrashFile("D3", "file");
+		writeTrashFile("d1/F2", "file");
+		git.add().addFilepattern(".").call();
+		git.commit().setMessage("second").call();
+
+		fs.caseSensitive = false;
+		git.checkout().setName("side").call();
+		writers.clear();
+		git.checkout().setName("master").call();
+		assertFiles("v2");
+		assertEquals("file", read("D3"));
+		assertEquals("file", read("d1/F2"));
+		assertWrittenByCallingThread("d1/f2");
+		for (int f = 0; f < FILES; f++) {
+			assertWrittenByCallingThread("d3/f" + f);
+		}
+		assertWrittenByWorkers();
+	}
+
+	@After
+	public void unregisterFilter() {
+		FilterCommandRegistry.unregister(SMUDGE);
+	}
+
+	private void writeFiles(String version) throws Exception {
+		for (int d = 0; d < DIRS; d++) {
+			for (int f = 0; f < FILES; f++) {
+				writeTrashFile("d" + d + "/f" + f, content(version, d, f));
+			}
+		}
+	}
+
+	/**
+	 * Assert that all files have the content of a version, except the given
+	 * paths and the files below them.
+	 */
+	private void assertFiles(String version, String... replaced)
+			throws Exception {
+		for (int d = 0; d < DIRS; d++) {
+			for (int f = 0; f < FILES; f++) {
+				String path = "d" + d + "/f" + f;
+				if (isReplaced(path, replaced)) {
+					continue;
+				}
+				assertTrue(path, new File(trash, path).isFile());
+				assertEquals(path, content(version, d, f), read(path));
+			}
+		}
+	}
+
+	private static boolean isReplaced(String path, String... replaced) {
+		for (String r : replaced) {
+			if (path.equals(r) || path.startsWith(r + '/')) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	private boolean isWrittenByWorkers() {
+		return writers.values().stream().flatMap(Set::stream)
+				.anyMatch(ParallelCheckoutTest::isWorker);
+	}
+
+	private void assertWrittenByWorkers() {
+		assertTrue(isWrittenByWorkers());
+	}
+
+	private void assertWrittenByCallingThread(String path) {
+		Set<String> threads = writers.get(path);
+		assertTrue(path, threads != null
+				&& threads.contains(Thread.currentThread().getName()));
+		assertFalse(path,
+				threads.stream().anyMatch(ParallelCheckoutTest::isWorker));
+	}
+
+	private static boolean isWorker(String threadName) {
+		return threadName.startsWith("JGit-Worker-");
+	}
+
+	private ObjectId indexTree() throws Exception {
+		try (ObjectInserter ins = db.newObjectInserter()) {
+			return db.readDirCache().writeTree(ins);
+		}
+	}
+
+	private static String content(String version, int d, int f) {
+		return version + " " + d + " " + f + "\n";
+	}
+
+	private class RecordingFilter extends FilterCommand {
+		private final byte[] buf = new byte[8192];
+
+		RecordingFilter(InputStream in, OutputStream out) {
+			super(in, out);
+		}
+
+		@Override
+		public int run() throws IOException {
+			filters.add(Thread.currentThread().getName());
+			int n = in.read(buf);
+			if (n < 0) {
+				in.close();
+				out.close();
+				return -1;
+			}
+			out.write(buf, 0, n);
+			return n;
+		}
+	}
+
+	private class RecordingFS extends FS_POSIX {
+		volatile boolean caseSensitive = true;
+
+		RecordingFS(FS src) {
+			super(src);
+		}
+
+		@Override
+		public FS newInstance() {
+			return new RecordingFS(this);
+		}
+
+		@Override
+		public boolean isCaseSensitive() {
+			return caseSensitive;
+		}
+
+		@Override
+		public Instant lastModifiedInstant(File f) {
+			// Checkout asks for the modification time of each file written
+			writers.computeIfAbsent(Repository.stripWorkDir(trash, f),
+					p -> ConcurrentHashMap.newKeySet())
+					.add(Thread.currentThread().getName());
+			return super.lastModifiedInstant(f);
+		}
+	}
+}
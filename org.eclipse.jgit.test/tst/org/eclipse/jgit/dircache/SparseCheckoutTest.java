@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.dircache;
+
+import static java.nio.charset.StandardCharsets.UTF_8;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+import java.io.File;
+import java.util.List;
+
+import org.eclipse.jgit.api.Git;
+import org.eclipse.jgit.api.MergeResult;
+import org.eclipse.jgit.api.Status;
+import org.eclipse.jgit.junit.RepositoryTestCase;
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.Constants;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.lib.ObjectInserter;
+import org.eclipse.jgit.revwalk.RevCommit;
+import org.eclipse.jgit.storage.file.FileBasedConfig;
+import org.eclipse.jgit.treewalk.TreeWalk;
+import org.junit.Before;
+import org.junit.Test;
+
+public class SparseCheckoutTest extends RepositoryTestCase {
+	private Git git;
+
+	@Before
+	public void setup() throws Exception {
+		git = new Git(db);
+		writeTrashFile("root.txt", "root");
+		writeTrashFile("a/x", "x");
+		writeTrashFile("a/b/y", "y");
+		writeTrashFile("a/b/c/z", "z");
+		writeTrashFile("c/w", "1\n2\n3\n4\n5\n");
+		writeTrashFile("d/v", "v");
+		git.add().addFilepattern(".").call();
+		git.commit().setMessage("initial").call();
+	}
+
+	@Test
+	public void testConePatterns() throws Exception {
+		SparseCheckout cone = SparseCheckout.cone(List.of("a/b/", "/c"));
+		assertTrue(cone.isCone());
+		assertTrue(cone.isIncluded("root.txt"));
+		assertTrue(cone.isIncluded("a/x"));
+		assertTrue(cone.isIncluded("a/b/y"));
+		assertTrue(cone.isIncluded("a/b/c/z"));
+		assertTrue(cone.isIncluded("c/w"));
+		assertFalse(cone.isIncluded("a/e/f"));
+		assertFalse(cone.isIncluded("d/v"));
+		assertFalse(cone.isIncluded("cc/w"));
+
+		cone.write(db);
+		assertEquals("/*\n!/*/\n/a/\n!/a/*/\n/a/b/\n/c/\n",
+				read(new File(db.getDirectory(), "info/sparse-checkout")));
+		SparseCheckout read = SparseCheckout.get(db);
+		assertTrue(read.isCone());
+		assertEquals(List.of("a/b", "c"), List.copyOf(read.getDirectories()));
+		assertTrue(read.isIncluded("a/x"));
+		assertTrue(read.isIncluded("a/b/c/z"));
+		assertFalse(read.isIncluded("a/e/f"));
+		assertFalse(read.isIncluded("d/v"));
+	}
+
+	@Test
+	public void testNestedDirectoriesAreMerged() throws Exception {
+		SparseCheckout cone = SparseCheckout.cone(List.of("a", "a/b", "d"));
+		assertEquals(List.of("a", "d"), List.copyOf(cone.getDirectories()));
+		assertTrue(cone.isIncluded("a/e/f"));
+	}
+
+	@Test
+	public void testNonConePatterns() throws Exception {
+		writeTrashFile(".git/info/sparse-checkout", "/*\n!/*/\n*.txt\n/d/\n");
+		FileBasedConfig cfg = db.getConfig();
+		cfg.setBoolean(ConfigConstants.CONFIG_CORE_SECTION, null,
+				ConfigConstants.CONFIG_KEY_SPARSE_CHECKOUT, true);
+		cfg.save();
+		SparseCheckout patterns = SparseCheckout.get(db);
+		assertFalse(patterns.isCone());
+		assertTrue(patterns.isIncluded("root.txt"));
+		assertTrue(patterns.isIncluded("a/b/notes.txt"));
+		assertTrue(patterns.isIncluded("d/v"));
+		assertFalse(patterns.isIncluded("a/x"));
+	}
+
+	@Test
+	public void testDisabled() throws Exception {
+		SparseCheckout.cone(List.of("a")).write(db);
+		FileBasedConfig cfg = db.getConfig();
+		cfg.setBoolean(ConfigConstants.CONFIG_CORE_SECTION, null,
+				ConfigConstants.CONFIG_KEY_SPARSE_CHECKOUT, false);
+		cfg.save();
+		assertNull(SparseCheckout.get(db));
+	}
+
+	@Test
+	public void testCheckoutRemovesFilesOutsideCone() throws Exception {
+		writeTrashFile("c/w", "dirty");
+		SparseCheckout.cone(List.of("a/b")).write(db);
+		checkoutHead();
+
+		assertTrue(new File(trash, "root.txt").exists());
+		assertTrue(new File(trash, "a/x").exists());
+		assertTrue(new File(trash, "a/b/y").exists());
+		assertTrue(new File(trash, "a/b/c/z").exists());
+		assertFalse(new File(trash, "d").exists());
+		// Modified files are kept.
+		assertEquals("dirty", read("c/w"));
+
+		DirCache dc = db.readDirCache();
+		assertTrue(dc.getEntry("d/v").isSkipWorkTree());
+		assertFalse(dc.getEntry("c/w").isSkipWorkTree());
+		assertFalse(dc.getEntry("a/x").isSkipWorkTree());
+		assertFalse(dc.getEntry("a/b/c/z").isSkipWorkTree());
+
+		Status status = git.status().call();
+		assertTrue(status.getMissing().isEmpty());
+		assertEquals(1, status.getModified().size());
+	}
+
+	@Test
+	public void testWidenCone() throws Exception {
+		SparseCheckout.cone(List.of("a")).write(db);
+		checkoutHead();
+		assertFalse(new File(trash, "d/v").exists());
+
+		SparseCheckout.cone(List.of("a", "d")).write(db);
+		checkoutHead();
+		assertEquals("v", read("d/v"));
+		assertFalse(db.readDirCache().getEntry("d/v").isSkipWorkTree());
+		assertTrue(git.status().call().isClean());
+	}
+
+	@Test
+	public void testCheckoutBranch() throws Exception {
+		git.branchCreate().setName("side").call();
+		writeTrashFile("a/b/y", "y2");
+		writeTrashFile("d/v", "v2");
+		writeTrashFile("d/u", "u");
+		git.add().addFilepattern(".").call();
+		RevCommit second = git.commit().setMessage("second").call();
+		git.checkout().setName("side").call();
+		SparseCheckout.cone(List.of("a")).write(db);
+		checkoutHead();
+
+		git.checkout().setName("master").call();
+		assertEquals("y2", read("a/b/y"));
+		assertFalse(new File(trash, "d").exists());
+		DirCache dc = db.readDirCache();
+		assertTrue(dc.getEntry("d/v").isSkipWorkTree());
+		assertTrue(dc.getEntry("d/u").isSkipWorkTree());
+		assertEquals(second.getTree(), indexTree());
+		assertTrue(git.status().call().isClean());
+	}
+
+	@Test
+	public void testAdd() throws Exception {
+		SparseCheckout.cone(List.of("a")).write(db);
+		checkoutHead();
+		writeTrashFile("a/new", "new");
+		writeTrashFile("d/new", "new");
+
+		git.add().addFilepattern(".").setUpdate(true).call();
+		git.add().addFilepattern(".").call();
+		DirCache dc = db.readDirCache();
+		assertNotNull(dc.getEntry("a/new"));
+		assertNull(dc.getEntry("d/new"));
+		assertNotNull(dc.getEntry("d/v"));
+		assertTrue(dc.getEntry("d/v").isSkipWorkTree());
+		assertNotNull(dc.getEntry("c/w"));
+	}
+
+	@Test
+	public void testMerge() throws Exception {
+		git.branchCreate().setName("side").call();
+		writeTrashFile("a/x", "x2");
+		writeTrashFile("c/w", "1 master\n2\n3\n4\n5\n");
+		git.add().addFilepattern(".").call();
+		git.commit().setMessage("master").call();
+		git.checkout().setName("side").call();
+		writeTrashFile("d/v", "v2");
+		writeTrashFile("c/w", "1\n2\n3\n4\n5 side\n");
+		git.add().addFilepattern(".").call();
+		RevCommit side = git.commit().setMessage("side").call();
+		git.checkout().setName("master").call();
+
+		SparseCheckout.cone(List.of("a")).write(db);
+		checkoutHead();
+		MergeResult result = git.merge().include(side).call();
+		assertTrue(result.getMergeStatus().isSuccessful());
+
+		assertEquals("x2", read("a/x"));
+		assertFalse(new File(trash, "c").exists());
+		assertFalse(new File(trash, "d").exists());
+		DirCache dc = db.readDirCache();
+		assertTrue(dc.getEntry("c/w").isSkipWorkTree());
+		assertTrue(dc.getEntry("d/v").isSkipWorkTree());
+		assertEquals("1 master\n2\n3\n4\n5 side\n", readBlob("c/w"));
+		assertEquals("v2", readBlob("d/v"));
+		assertTrue(git.status().call().isClean());
+	}
+
+	@Test
+	public void testSkipWorkTreeFlagIsStored() throws Exception {
+		DirCache dc = db.lockDirCache();
+		DirCacheEntry entry = dc.getEntry("d/v");
+		entry.setSkipWorkTree(true);
+		assertTrue(new DirCacheEntry(entry).isSkipWorkTree());
+		DirCacheEntry copy = new DirCacheEntry("e");
+		copy.copyMetaData(entry);
+		assertTrue(copy.isSkipWorkTree());
+		dc.write();
+		assertTrue(dc.commit());
+
+		dc = db.readDirCache();
+		assertTrue(dc.getEntry("d/v").isSkipWorkTree());
+		assertFalse(dc.getEntry("c/w").isSkipWorkTree());
+		dc = db.lockDirCache();
+		dc.getEntry("d/v").setSkipWorkTree(false);
+		dc.write();
+		assertTrue(dc.commit());
+		assertFalse(db.readDirCache().getEntry("d/v").isSkipWorkTree());
+	}
+
+	private void checkoutHead() throws Exception {
+		ObjectId tree = db.resolve(Constants.HEAD + "^{tree}");
+		new DirCacheCheckout(db, tree, db.lockDirCache(), tree).checkout();
+	}
+
+	private ObjectId indexTree() throws Exception {
+		try (ObjectInserter ins = db.newObjectInserter()) {
+			return db.readDirCache().writeTree(ins);
+		}
+	}
+
+	private String readBlob(String path) throws Exception {
+		try (TreeWalk tw = TreeWalk.forPath(db, path, indexTree())) {
+			return new String(db.open(tw.getObjectId(0)).getCachedBytes(),
+					UTF_8);
+		}
+	}
+}
@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.dircache;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+
+import java.io.File;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Set;
+
+import org.eclipse.jgit.api.Git;
+import org.eclipse.jgit.junit.RepositoryTestCase;
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.Constants;
+import org.eclipse.jgit.lib.FileMode;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.lib.ObjectInserter;
+import org.eclipse.jgit.lib.ObjectReader;
+import org.eclipse.jgit.revwalk.RevCommit;
+import org.eclipse.jgit.storage.file.FileBasedConfig;
+import org.eclipse.jgit.treewalk.TreeWalk;
+import org.junit.Before;
+import org.junit.Test;
+
+public class SparseIndexTest extends RepositoryTestCase {
+	private Git git;
+
+	private RevCommit initial;
+
+	@Before
+	public void setup() throws Exception {
+		git = new Git(db);
+		writeTrashFile("root.txt", "root");
+		writeTrashFile("a/x", "x");
+		writeTrashFile("a/b/y", "y");
+		writeTrashFile("a/e/f", "f");
+		writeTrashFile("c/w", "w");
+		writeTrashFile("d/v", "v");
+		writeTrashFile("d/g/u", "u");
+		git.add().addFilepattern(".").call();
+		initial = git.commit().setMessage("initial").call();
+
+		setSparseIndex(true);
+		SparseCheckout.cone(List.of("a/b")).write(db);
+		checkoutHead();
+	}
+
+	@Test
+	public void testCollapsedDirectories() throws Exception {
+		DirCache dc = db.readDirCache();
+		assertEquals(List.of("a/b/y", "a/e/", "a/x", "c/", "d/", "root.txt"),
+				paths(dc));
+		DirCacheEntry d = dc.getEntry("d/");
+		assertTrue(d.isSparseDirectory());
+		assertTrue(d.isSkipWorkTree());
+		assertEquals(FileMode.TREE, d.getFileMode());
+		assertEquals(treeOf("d"), d.getObjectId());
+		assertNull(dc.getEntry("d/t"));
+		assertFalse(dc.getEntry("a/x").isSparseDirectory());
+
+		assertFalse(new File(trash, "d").exists());
+		assertFalse(new File(trash, "a/e").exists());
+		assertEquals(initial.getTree(), indexTree());
+		assertTrue(git.status().call().isClean());
+	}
+
+	@Test
+	public void testLookupExpandsSparseDirectory() throws Exception {
+		DirCache dc = db.lockDirCache();
+		DirCacheEntry c = dc.getEntry("c/");
+		DirCacheEntry d = dc.getEntry("d/");
+		DirCacheEntry u = dc.getEntry("d/g/u");
+		assertNotNull(u);
+		assertTrue(u.isSkipWorkTree());
+		assertEquals(List.of("a/b/y", "a/e/", "a/x", "c/", "d/g/u", "d/v",
+				"root.txt"), paths(dc));
+		DirCacheEntry[] within = dc.getEntriesWithin("c");
+		assertEquals(1, within.length);
+		assertEquals("c/w", within[0].getPathString());
+
+		// The directories are collapsed again, reusing the entries read
+		dc.write();
+		assertTrue(dc.commit());
+		assertEquals(List.of("a/b/y", "a/e/", "a/x", "c/", "d/", "root.txt"),
+				paths(dc));
+		assertSame(c, dc.getEntry("c/"));
+		assertSame(d, dc.getEntry("d/"));
+		assertEquals(initial.getTree(), indexTree());
+	}
+
+	@Test
+	public void testWalkExpandsSparseDirectories() throws Exception {
+		DirCache dc = db.readDirCache();
+		Set<String> skipped = Set.of("a/e/f", "c/w", "d/g/u", "d/v");
+		List<String> paths = new ArrayList<>();
+		try (TreeWalk tw = new TreeWalk(db)) {
+			tw.addTree(new DirCacheIterator(dc));
+			tw.setRecursive(true);
+			while (tw.next()) {
+				DirCacheEntry e = tw.getTree(0, DirCacheIterator.class)
+						.getDirCacheEntry();
+				assertEquals(skipped.contains(tw.getPathString()),
+						e.isSkipWorkTree());
+				paths.add(tw.getPathString());
+			}
+		}
+		assertEquals(List.of("a/b/y", "a/e/f", "a/x", "c/w", "d/g/u", "d/v",
+				"root.txt"), paths);
+
+		try (TreeWalk tw = new TreeWalk(db)) {
+			tw.addTree(new DirCacheIterator(dc));
+			assertTrue(tw.next());
+			assertEquals("a", tw.getPathString());
+			assertTrue(tw.next());
+			assertEquals("c", tw.getPathString());
+			assertTrue(tw.getTree(0, DirCacheIterator.class)
+					.isSparseDirectory());
+			assertEquals(treeOf("c"), tw.getObjectId(0));
+		}
+	}
+
+	@Test
+	public void testCheckoutBranchOutsideCone() throws Exception {
+		git.branchCreate().setName("side").call();
+		DirCache dc = db.lockDirCache();
+		DirCacheEditor editor = dc.editor();
+		editor.add(new DirCacheEditor.PathEdit("d/g/t") {
+			@Override
+			public void apply(DirCacheEntry ent) {
+				ent.setFileMode(FileMode.REGULAR_FILE);
+				ent.setObjectId(blob("t"));
+				ent.setSkipWorkTree(true);
+			}
+		});
+		editor.add(new DirCacheEditor.DeletePath("d/v"));
+		assertTrue(editor.commit());
+		RevCommit second = git.commit().setMessage("second").call();
+		assertEquals(List.of("a/b/y", "a/e/", "a/x", "c/", "d/", "root.txt"),
+				paths(db.readDirCache()));
+		assertEquals(second.getTree(), indexTree());
+
+		git.checkout().setName("side").call();
+		assertEquals(treeOf("d"), db.readDirCache().getEntry("d/")
+				.getObjectId());
+		assertEquals(initial.getTree(), indexTree());
+
+		git.checkout().setName("master").call();
+		assertEquals(second.getTree(), indexTree());
+		assertFalse(new File(trash, "d").exists());
+		assertTrue(git.status().call().isClean());
+	}
+
+	@Test
+	public void testWidenCone() throws Exception {
+		SparseCheckout.cone(List.of("a/b", "d")).write(db);
+		checkoutHead();
+		assertEquals("v", read("d/v"));
+		assertEquals("u", read("d/g/u"));
+		DirCache dc = db.readDirCache();
+		assertEquals(List.of("a/b/y", "a/e/", "a/x", "c/", "d/g/u", "d/v",
+				"root.txt"), paths(dc));
+		assertFalse(dc.getEntry("d/v").isSkipWorkTree());
+		assertTrue(git.status().call().isClean());
+	}
+
+	@Test
+	public void testAddKeepsSparseDirectories() throws Exception {
+		writeTrashFile("a/b/new", "new");
+		git.add().addFilepattern(".").call();
+		DirCache dc = db.readDirCache();
+		assertNotNull(dc.getEntry("a/b/new"));
+		assertTrue(dc.getEntry("d/").isSparseDirectory());
+		assertTrue(dc.getEntry("c/").isSparseDirectory());
+	}
+
+	@Test
+	public void testDisabledExpandsIndex() throws Exception {
+		setSparseIndex(false);
+		DirCache dc = db.lockDirCache();
+		dc.write();
+		assertTrue(dc.commit());
+		dc = db.readDirCache();
+		assertEquals(List.of("a/b/y", "a/e/f", "a/x", "c/w", "d/g/u", "d/v",
+				"root.txt"), paths(dc));
+		assertTrue(dc.getEntry("d/g/u").isSkipWorkTree());
+		assertFalse(dc.hasSparseDirectories());
+		assertEquals(initial.getTree(), indexTree());
+	}
+
+	@Test
+	public void testExpandSparseDirectories() throws Exception {
+		DirCache dc = db.readDirCache();
+		assertTrue(dc.hasSparseDirectories());
+		try (ObjectReader reader = db.newObjectReader()) {
+			dc.expandSparseDirectories(reader);
+		}
+		assertFalse(dc.hasSparseDirectories());
+		assertTrue(dc.getEntry("d/v").isSkipWorkTree());
+		assertTrue(dc.getEntry("a/e/f").isSkipWorkTree());
+		assertEquals(initial.getTree(), indexTree(dc));
+	}
+
+	private void setSparseIndex(boolean sparse) throws Exception {
+		FileBasedConfig cfg = db.getConfig();
+		cfg.setBoolean(ConfigConstants.CONFIG_INDEX_SECTION, null,
+				ConfigConstants.CONFIG_KEY_SPARSE_INDEX, sparse);
+		cfg.save();
+	}
+
+	private void checkoutHead() throws Exception {
+		ObjectId tree = db.resolve(Constants.HEAD + "^{tree}");
+		new DirCacheCheckout(db, tree, db.lockDirCache(), tree).checkout();
+	}
+
+	private ObjectId treeOf(String dir) throws Exception {
+		try (TreeWalk tw = TreeWalk.forPath(db, dir, initial.getTree())) {
+			return tw.getObjectId(0);
+		}
+	}
+
+	private ObjectId blob(String content) {
+		try (ObjectInserter ins = db.newObjectInserter()) {
+			ObjectId id = ins.insert(Constants.OBJ_BLOB,
+					Constants.encode(content));
+			ins.flush();
+			return id;
+		} catch (Exception e) {
+			throw new IllegalStateException(e);
+		}
+	}
+
+	private ObjectId indexTree() throws Exception {
+		return indexTree(db.readDirCache());
+	}
+
+	private ObjectId indexTree(DirCache dc) throws Exception {
+		try (ObjectInserter ins = db.newObjectInserter()) {
+			return dc.writeTree(ins);
+		}
+	}
+
+	private static List<String> paths(DirCache dc) {
+		List<String> paths = new ArrayList<>();
+		for (int i = 0; i < dc.getEntryCount(); i++) {
+			paths.add(dc.getEntry(i).getPathString());
+		}
+		return paths;
+	}
+}
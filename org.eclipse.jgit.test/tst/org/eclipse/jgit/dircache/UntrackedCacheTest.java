@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.dircache;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+import java.io.File;
+import java.util.Set;
+import java.util.TreeSet;
+
+import org.eclipse.jgit.api.Git;
+import org.eclipse.jgit.junit.RepositoryTestCase;
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.Constants;
+import org.eclipse.jgit.lib.IndexDiff;
+import org.eclipse.jgit.storage.file.FileBasedConfig;
+import org.eclipse.jgit.treewalk.FileTreeIterator;
+import org.junit.Before;
+import org.junit.Test;
+
+public class UntrackedCacheTest extends RepositoryTestCase {
+
+	@Before
+	public void setup() throws Exception {
+		FileBasedConfig cfg = db.getConfig();
+		cfg.setBoolean(ConfigConstants.CONFIG_CORE_SECTION, null,
+				ConfigConstants.CONFIG_KEY_UNTRACKED_CACHE, true);
+		cfg.save();
+
+		writeTrashFile(".gitignore", "*.o\n");
+		writeTrashFile("tracked", "tracked");
+		writeTrashFile("src/a.c", "a");
+		try (Git git = new Git(db)) {
+			git.add().addFilepattern(".").call();
+			git.commit().setMessage("initial").call();
+		}
+		writeTrashFile("untracked", "untracked");
+		writeTrashFile("src/b.c", "b");
+		writeTrashFile("src/a.o", "object");
+		writeTrashFile("new/c.c", "c");
+		fsTick(db.getIndexFile());
+	}
+
+	@Test
+	public void testCacheIsRecordedAndReused() throws Exception {
+		IndexDiff first = diff();
+		UntrackedCache cache = db.readDirCache().getUntrackedCache();
+		assertNotNull(cache);
+		assertUntrackedNames(cache.getRoot(), "new/", "untracked");
+		assertUntrackedNames(cache.getRoot().getDirectory("src"), "b.c");
+
+		fsTick(db.getIndexFile());
+		IndexDiff second = diff();
+		assertEquals(first.getUntracked(), second.getUntracked());
+		assertEquals(first.getIgnoredNotInIndex(),
+				second.getIgnoredNotInIndex());
+		assertEquals(Set.of("untracked", "src/b.c", "new/c.c"),
+				second.getUntracked());
+		assertEquals(Set.of("src/a.o"), second.getIgnoredNotInIndex());
+	}
+
+	@Test
+	public void testNewFileInvalidatesDirectory() throws Exception {
+		diff();
+		fsTick(new File(trash, "src"));
+		writeTrashFile("src/d.c", "d");
+		fsTick(db.getIndexFile());
+
+		IndexDiff diff = diff();
+		assertTrue(diff.getUntracked().contains("src/d.c"));
+		assertUntrackedNames(db.readDirCache().getUntrackedCache().getRoot()
+				.getDirectory("src"), "b.c", "d.c");
+	}
+
+	@Test
+	public void testChangedIgnoreRulesInvalidateDirectory() throws Exception {
+		diff();
+		writeTrashFile(".gitignore", "*.o\n*.c\n");
+		fsTick(db.getIndexFile());
+
+		IndexDiff diff = diff();
+		assertFalse(diff.getUntracked().contains("src/b.c"));
+		assertTrue(diff.getIgnoredNotInIndex().contains("src/b.c"));
+	}
+
+	@Test
+	public void testRemovedIndexEntryBecomesUntracked() throws Exception {
+		diff();
+		try (Git git = new Git(db)) {
+			git.rm().setCached(true).addFilepattern("src/a.c").call();
+		}
+		fsTick(db.getIndexFile());
+
+		IndexDiff diff = diff();
+		assertTrue(diff.getUntracked().contains("src/a.c"));
+	}
+
+	@Test
+	public void testDisablingRemovesCache() throws Exception {
+		diff();
+		assertNotNull(db.readDirCache().getUntrackedCache());
+
+		FileBasedConfig cfg = db.getConfig();
+		cfg.setBoolean(ConfigConstants.CONFIG_CORE_SECTION, null,
+				ConfigConstants.CONFIG_KEY_UNTRACKED_CACHE, false);
+		cfg.save();
+		diff();
+		assertNull(db.readDirCache().getUntrackedCache());
+	}
+
+	private IndexDiff diff() throws Exception {
+		IndexDiff diff = new IndexDiff(db, Constants.HEAD,
+				new FileTreeIterator(db));
+		diff.diff();
+		return diff;
+	}
+
+	private static void assertUntrackedNames(UntrackedCache.Directory dir,
+			String... expected) {
+		assertNotNull(dir);
+		assertEquals(new TreeSet<>(Set.of(expected)),
+				new TreeSet<>(dir.getUntracked()));
+	}
+}
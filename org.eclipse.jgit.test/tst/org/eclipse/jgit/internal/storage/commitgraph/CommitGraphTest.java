@@ -204,6 +204,26 @@ public void testGraphWithMerges() throws Exception {
 		assertEquals(getGenerationNumber(c8), 5);
 	}
 
+	@Test
+	public void testGraphCorrectedCommitDates() throws Exception {
+		RevCommit c1 = commit();
+		RevCommit c2 = commit(c1);
+		// c3 was committed with a clock running late
+		tr.tick(-1000);
+		RevCommit c3 = commit(c2);
+		tr.tick(2000);
+		RevCommit c4 = commit(c3);
+
+		writeAndReadCommitGraph(Collections.singleton(c4));
+		verifyCommitGraph();
+
+		assertEquals(c1.getCommitTime(), getCorrectedCommitDate(c1));
+		assertEquals(c2.getCommitTime(), getCorrectedCommitDate(c2));
+		assertTrue(c3.getCommitTime() < c2.getCommitTime());
+		assertEquals(c2.getCommitTime() + 1, getCorrectedCommitDate(c3));
+		assertEquals(c4.getCommitTime(), getCorrectedCommitDate(c4));
+	}
+
 	@Test
 	public void testGraphComputeChangedPaths() throws Exception {
 		RevCommit a = tr.commit(tr.tree(tr.file("d/f", tr.blob("a"))));
@@ -278,6 +298,11 @@ int getGenerationNumber(ObjectId id) {
 		return COMMIT_GENERATION_UNKNOWN;
 	}
 
+	long getCorrectedCommitDate(ObjectId id) {
+		int graphPos = commitGraph.findGraphPosition(id);
+		return commitGraph.getCommitData(graphPos).getCorrectedCommitDate();
+	}
+
 	RevCommit commit(RevCommit... parents) throws Exception {
 		return tr.commit(parents);
 	}
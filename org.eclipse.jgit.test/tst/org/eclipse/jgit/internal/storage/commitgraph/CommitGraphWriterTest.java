@@ -89,7 +89,7 @@ public void testWriterWithExtraEdgeList() throws Exception {
 		assertTrue(data.length > 0);
 		byte[] headers = new byte[8];
 		System.arraycopy(data, 0, headers, 0, 8);
-		assertArrayEquals(new byte[] { 'C', 'G', 'P', 'H', 1, 1, 6, 0 },
+		assertArrayEquals(new byte[] { 'C', 'G', 'P', 'H', 1, 1, 7, 0 },
 				headers);
 		assertEquals(CommitGraphConstants.CHUNK_ID_OID_FANOUT,
 				NB.decodeInt32(data, 8));
@@ -97,12 +97,14 @@ public void testWriterWithExtraEdgeList() throws Exception {
 				NB.decodeInt32(data, 20));
 		assertEquals(CommitGraphConstants.CHUNK_ID_COMMIT_DATA,
 				NB.decodeInt32(data, 32));
-		assertEquals(CommitGraphConstants.CHUNK_ID_EXTRA_EDGE_LIST,
+		assertEquals(CommitGraphConstants.CHUNK_ID_GENERATION_DATA,
 				NB.decodeInt32(data, 44));
-		assertEquals(CommitGraphConstants.CHUNK_ID_BLOOM_FILTER_INDEX,
+		assertEquals(CommitGraphConstants.CHUNK_ID_EXTRA_EDGE_LIST,
 				NB.decodeInt32(data, 56));
-		assertEquals(CommitGraphConstants.CHUNK_ID_BLOOM_FILTER_DATA,
+		assertEquals(CommitGraphConstants.CHUNK_ID_BLOOM_FILTER_INDEX,
 				NB.decodeInt32(data, 68));
+		assertEquals(CommitGraphConstants.CHUNK_ID_BLOOM_FILTER_DATA,
+				NB.decodeInt32(data, 80));
 	}
 
 	@Test
@@ -123,7 +125,7 @@ public void testWriterWithoutExtraEdgeList() throws Exception {
 		assertTrue(data.length > 0);
 		byte[] headers = new byte[8];
 		System.arraycopy(data, 0, headers, 0, 8);
-		assertArrayEquals(new byte[] { 'C', 'G', 'P', 'H', 1, 1, 5, 0 },
+		assertArrayEquals(new byte[] { 'C', 'G', 'P', 'H', 1, 1, 6, 0 },
 				headers);
 		assertEquals(CommitGraphConstants.CHUNK_ID_OID_FANOUT,
 				NB.decodeInt32(data, 8));
@@ -131,10 +133,12 @@ public void testWriterWithoutExtraEdgeList() throws Exception {
 				NB.decodeInt32(data, 20));
 		assertEquals(CommitGraphConstants.CHUNK_ID_COMMIT_DATA,
 				NB.decodeInt32(data, 32));
-		assertEquals(CommitGraphConstants.CHUNK_ID_BLOOM_FILTER_INDEX,
+		assertEquals(CommitGraphConstants.CHUNK_ID_GENERATION_DATA,
 				NB.decodeInt32(data, 44));
-		assertEquals(CommitGraphConstants.CHUNK_ID_BLOOM_FILTER_DATA,
+		assertEquals(CommitGraphConstants.CHUNK_ID_BLOOM_FILTER_INDEX,
 				NB.decodeInt32(data, 56));
+		assertEquals(CommitGraphConstants.CHUNK_ID_BLOOM_FILTER_DATA,
+				NB.decodeInt32(data, 68));
 	}
 
 	@Test
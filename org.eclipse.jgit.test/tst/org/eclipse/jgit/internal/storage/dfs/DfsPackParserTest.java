@@ -10,7 +10,10 @@
 package org.eclipse.jgit.internal.storage.dfs;
 
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_MIN_BYTES_OBJ_SIZE_INDEX;
+import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_INDEX_THREADS;
+import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_THREADS;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_PACK_SECTION;
+import static org.junit.Assert.assertArrayEquals;
 import static org.junit.Assert.assertEquals;
 
 import java.io.IOException;
@@ -20,6 +23,7 @@
 import org.eclipse.jgit.lib.NullProgressMonitor;
 import org.eclipse.jgit.lib.ObjectId;
 import org.eclipse.jgit.lib.ObjectInserter;
+import org.eclipse.jgit.lib.ObjectReader;
 import org.eclipse.jgit.transport.InMemoryPack;
 import org.eclipse.jgit.transport.PackParser;
 import org.junit.Before;
@@ -66,4 +70,58 @@ public void parse_writeObjSizeIdx() throws IOException {
 		assertEquals(1, packList.packs.length);
 		assertEquals(1, packList.packs[0].getIndexedObjectSize(reader, blobA));
 	}
+
+	@Test
+	public void parse_packThreadsDoNotApply() throws IOException {
+		repo.getConfig().setInt(CONFIG_PACK_SECTION, null, CONFIG_KEY_THREADS,
+				4);
+		InMemoryPack pack = new InMemoryPack();
+		pack.header(0);
+		pack.digest();
+		try (ObjectInserter ins = repo.newObjectInserter()) {
+			PackParser parser = ins.newPackParser(pack.toInputStream());
+			assertEquals(1, parser.getThreads());
+		}
+	}
+
+	@Test
+	public void parse_resolveDeltasInParallel() throws IOException {
+		repo.getConfig().setInt(CONFIG_PACK_SECTION, null,
+				CONFIG_KEY_INDEX_THREADS, 2);
+		ObjectInserter.Formatter fmt = new ObjectInserter.Formatter();
+		ObjectId blobA = fmt.idFor(Constants.OBJ_BLOB, new byte[] { 'a' });
+		ObjectId blobC = fmt.idFor(Constants.OBJ_BLOB, new byte[] { 'c' });
+
+		InMemoryPack pack = new InMemoryPack();
+		pack.header(4);
+		pack.write((Constants.OBJ_BLOB) << 4 | 1);
+		pack.deflate(new byte[] { 'a' });
+		pack.write((Constants.OBJ_BLOB) << 4 | 1);
+		pack.deflate(new byte[] { 'c' });
+
+		pack.write((Constants.OBJ_REF_DELTA) << 4 | 4);
+		pack.copyRaw(blobA);
+		pack.deflate(new byte[] { 0x1, 0x1, 0x1, 'b' });
+		pack.write((Constants.OBJ_REF_DELTA) << 4 | 4);
+		pack.copyRaw(blobC);
+		pack.deflate(new byte[] { 0x1, 0x1, 0x1, 'd' });
+		pack.digest();
+
+		try (ObjectInserter ins = repo.newObjectInserter()) {
+			PackParser parser = ins.newPackParser(pack.toInputStream());
+			assertEquals(2, parser.getThreads());
+			parser.parse(NullProgressMonitor.INSTANCE,
+					NullProgressMonitor.INSTANCE);
+			ins.flush();
+		}
+
+		try (ObjectReader reader = repo.newObjectReader()) {
+			assertArrayEquals(new byte[] { 'b' }, reader
+					.open(fmt.idFor(Constants.OBJ_BLOB, new byte[] { 'b' }))
+					.getCachedBytes());
+			assertArrayEquals(new byte[] { 'd' }, reader
+					.open(fmt.idFor(Constants.OBJ_BLOB, new byte[] { 'd' }))
+					.getCachedBytes());
+		}
+	}
 }
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.file;
+
+import static java.nio.charset.StandardCharsets.UTF_8;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+import org.eclipse.jgit.errors.MissingObjectException;
+import org.eclipse.jgit.junit.TestRepository.CommitBuilder;
+import org.eclipse.jgit.lib.AsyncObjectLoaderQueue;
+import org.eclipse.jgit.lib.AsyncObjectSizeQueue;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.lib.ObjectReader;
+import org.eclipse.jgit.revwalk.RevBlob;
+import org.junit.Before;
+import org.junit.Test;
+
+public class AsyncObjectQueueTest extends GcTestCase {
+	private static final int PACKED = 500;
+
+	private static final int LOOSE = 20;
+
+	private final Map<ObjectId, String> contents = new HashMap<>();
+
+	private final List<ObjectId> ids = new ArrayList<>();
+
+	@Before
+	public void setup() throws Exception {
+		CommitBuilder cb = tr.branch("master").commit();
+		for (int i = 0; i < PACKED; i++) {
+			// Similar contents, so that some blobs are stored as deltas.
+			String content = "header\n".repeat(20) + "blob " + i;
+			cb.add("f" + i, blob(content));
+		}
+		cb.create();
+		gc.gc().get();
+		assertEquals(0, gc.getStatistics().numberOfLooseObjects);
+
+		for (int i = 0; i < LOOSE; i++) {
+			blob("loose " + i);
+		}
+	}
+
+	@Test
+	public void testOpenAll() throws Exception {
+		try (ObjectReader reader = repo.newObjectReader()) {
+			AsyncObjectLoaderQueue<ObjectId> q = reader.open(ids, true);
+			try {
+				Map<ObjectId, String> seen = new HashMap<>();
+				while (q.next()) {
+					ObjectId id = q.getCurrent();
+					assertEquals(id, q.getObjectId());
+					seen.put(id, new String(q.open().getCachedBytes(), UTF_8));
+				}
+				assertEquals(contents, seen);
+			} finally {
+				q.release();
+			}
+		}
+	}
+
+	@Test
+	public void testSizeOfAll() throws Exception {
+		try (ObjectReader reader = repo.newObjectReader()) {
+			AsyncObjectSizeQueue<ObjectId> q = reader.getObjectSize(ids,
+					true);
+			try {
+				int cnt = 0;
+				while (q.next()) {
+					String content = contents.get(q.getCurrent());
+					assertEquals(content.length(), q.getSize());
+					cnt++;
+				}
+				assertEquals(ids.size(), cnt);
+			} finally {
+				q.release();
+			}
+		}
+	}
+
+	@Test
+	public void testMissingObject() throws Exception {
+		ObjectId missing = ObjectId
+				.fromString("0123456789012345678901234567890123456789");
+		ids.add(PACKED / 2, missing);
+		try (ObjectReader reader = repo.newObjectReader()) {
+			AsyncObjectLoaderQueue<ObjectId> q = reader.open(ids, true);
+			int found = 0;
+			boolean reported = false;
+			try {
+				while (q.next()) {
+					try {
+						q.open();
+						found++;
+					} catch (MissingObjectException e) {
+						assertEquals(missing, q.getCurrent());
+						reported = true;
+					}
+				}
+			} finally {
+				q.release();
+			}
+			assertTrue(reported);
+			assertEquals(PACKED + LOOSE, found);
+
+			AsyncObjectSizeQueue<ObjectId> sq = reader.getObjectSize(ids,
+					true);
+			found = 0;
+			reported = false;
+			try {
+				for (;;) {
+					try {
+						if (!sq.next()) {
+							break;
+						}
+						found++;
+					} catch (MissingObjectException e) {
+						assertEquals(missing, sq.getCurrent());
+						reported = true;
+					}
+				}
+			} finally {
+				sq.release();
+			}
+			assertTrue(reported);
+			assertEquals(PACKED + LOOSE, found);
+		}
+	}
+
+	@Test
+	public void testReleaseEarly() throws Exception {
+		try (ObjectReader reader = repo.newObjectReader()) {
+			for (int i = 0; i < 10; i++) {
+				AsyncObjectLoaderQueue<ObjectId> q = reader.open(ids, true);
+				try {
+					assertTrue(q.next());
+					q.open();
+				} finally {
+					q.release();
+				}
+				assertFalse(q.next());
+			}
+		}
+	}
+
+	@Test
+	public void testSlowReader() throws Exception {
+		try (ObjectReader reader = repo.newObjectReader()) {
+			AsyncObjectLoaderQueue<ObjectId> q = reader.open(ids, true);
+			try {
+				Map<ObjectId, String> seen = new HashMap<>();
+				while (q.next()) {
+					if (seen.isEmpty()) {
+						// Let the workers give up waiting for room.
+						Thread.sleep(2000);
+					}
+					seen.put(q.getCurrent(),
+							new String(q.open().getCachedBytes(), UTF_8));
+				}
+				assertEquals(contents, seen);
+			} finally {
+				q.release();
+			}
+		}
+	}
+
+	@Test
+	public void testEmpty() throws Exception {
+		try (ObjectReader reader = repo.newObjectReader()) {
+			AsyncObjectLoaderQueue<ObjectId> q = reader.open(List.of(), true);
+			try {
+				assertFalse(q.next());
+			} finally {
+				q.release();
+			}
+		}
+	}
+
+	private RevBlob blob(String content) throws Exception {
+		RevBlob b = tr.blob(content);
+		contents.put(b, content);
+		ids.add(b);
+		return b;
+	}
+}
@@ -11,6 +11,7 @@
 package org.eclipse.jgit.internal.storage.file;
 
 import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
 import static org.junit.Assert.assertFalse;
 import static org.junit.Assert.assertTrue;
 
@@ -19,6 +20,8 @@
 import java.io.InputStream;
 import java.util.Collections;
 
+import org.eclipse.jgit.internal.storage.commitgraph.CommitGraph;
+import org.eclipse.jgit.internal.storage.commitgraph.CommitGraphChain;
 import org.eclipse.jgit.junit.TestRepository;
 import org.eclipse.jgit.lib.ConfigConstants;
 import org.eclipse.jgit.lib.Constants;
@@ -162,6 +165,135 @@ public void testWriteCommitGraphOnly() throws Exception {
 		assertGraphFile(graphFile);
 	}
 
+	@Test
+	public void testWriteSplitCommitGraph() throws Exception {
+		StoredConfig config = repo.getConfig();
+		config.setBoolean(ConfigConstants.CONFIG_CORE_SECTION, null,
+				ConfigConstants.CONFIG_COMMIT_GRAPH, true);
+		config.setBoolean(ConfigConstants.CONFIG_GC_SECTION, null,
+				ConfigConstants.CONFIG_KEY_SPLIT_COMMIT_GRAPH, true);
+		gc.setPackExpireAgeMillis(0);
+		File graphFile = new File(repo.getObjectsDirectory(),
+				Constants.INFO_COMMIT_GRAPH);
+		File graphsDir = new File(repo.getObjectsDirectory(),
+				Constants.INFO_COMMIT_GRAPHS);
+
+		RevCommit tip1 = commitChain(10);
+		gc.writeCommitGraph(Collections.singleton(tip1));
+		assertFalse(graphFile.exists());
+		assertTrue(new File(graphsDir, Constants.COMMIT_GRAPH_CHAIN).exists());
+		CommitGraphChain chain = getCommitGraphChain();
+		assertEquals(1, chain.getLayerCount());
+		assertEquals(10, chain.getCommitCnt());
+
+		// A small layer is added on top of the large one
+		RevCommit tip2 = extend(tip1, 1);
+		gc.writeCommitGraph(Collections.singleton(tip2));
+		chain = getCommitGraphChain();
+		assertEquals(2, chain.getLayerCount());
+		assertEquals(10, chain.getLayerCommitCnt(0));
+		assertEquals(1, chain.getLayerCommitCnt(1));
+		CommitGraph.CommitData data = chain
+				.getCommitData(chain.findGraphPosition(tip2));
+		assertEquals(11, data.getGeneration());
+		assertEquals(tip1, chain.getObjectId(data.getParents()[0]));
+		assertTrue(data.getCorrectedCommitDate() >= tip2.getCommitTime());
+		assertEquals(2, layerFiles(graphsDir).length);
+
+		// Nothing new, the chain is unchanged
+		gc.writeCommitGraph(Collections.singleton(tip2));
+		assertEquals(2, getCommitGraphChain().getLayerCount());
+
+		// Layers of similar size are merged
+		RevCommit tip3 = extend(tip2, 5);
+		fsTick();
+		gc.writeCommitGraph(Collections.singleton(tip3));
+		chain = getCommitGraphChain();
+		assertEquals(1, chain.getLayerCount());
+		assertEquals(16, chain.getCommitCnt());
+		assertEquals(16, chain.getCommitData(chain.findGraphPosition(tip3))
+				.getGeneration());
+		assertEquals(1, layerFiles(graphsDir).length);
+
+		// A single commit-graph file replaces the chain
+		config.setBoolean(ConfigConstants.CONFIG_GC_SECTION, null,
+				ConfigConstants.CONFIG_KEY_SPLIT_COMMIT_GRAPH, false);
+		fsTick();
+		gc.writeCommitGraph(Collections.singleton(tip3));
+		assertGraphFile(graphFile);
+		assertFalse(
+				new File(graphsDir, Constants.COMMIT_GRAPH_CHAIN).exists());
+		assertEquals(0, layerFiles(graphsDir).length);
+	}
+
+	@Test
+	public void testKeepUnexpiredCommitGraphLayers() throws Exception {
+		StoredConfig config = repo.getConfig();
+		config.setBoolean(ConfigConstants.CONFIG_CORE_SECTION, null,
+				ConfigConstants.CONFIG_COMMIT_GRAPH, true);
+		config.setBoolean(ConfigConstants.CONFIG_GC_SECTION, null,
+				ConfigConstants.CONFIG_KEY_SPLIT_COMMIT_GRAPH, true);
+		File graphsDir = new File(repo.getObjectsDirectory(),
+				Constants.INFO_COMMIT_GRAPHS);
+
+		RevCommit tip = commitChain(3);
+		gc.writeCommitGraph(Collections.singleton(tip));
+		tip = extend(tip, 3);
+		gc.writeCommitGraph(Collections.singleton(tip));
+		assertEquals(1, getCommitGraphChain().getLayerCount());
+		// Readers of the previous chain may still open its layer
+		assertEquals(2, layerFiles(graphsDir).length);
+
+		config.setBoolean(ConfigConstants.CONFIG_GC_SECTION, null,
+				ConfigConstants.CONFIG_KEY_SPLIT_COMMIT_GRAPH, false);
+		gc.writeCommitGraph(Collections.singleton(tip));
+		assertEquals(2, layerFiles(graphsDir).length);
+
+		gc.setPackExpireAgeMillis(0);
+		fsTick();
+		gc.writeCommitGraph(Collections.singleton(tip));
+		assertEquals(0, layerFiles(graphsDir).length);
+	}
+
+	@Test
+	public void testSplitCommitGraphReplacesFile() throws Exception {
+		StoredConfig config = repo.getConfig();
+		config.setBoolean(ConfigConstants.CONFIG_CORE_SECTION, null,
+				ConfigConstants.CONFIG_COMMIT_GRAPH, true);
+		File graphFile = new File(repo.getObjectsDirectory(),
+				Constants.INFO_COMMIT_GRAPH);
+
+		RevCommit tip = commitChain(3);
+		gc.writeCommitGraph(Collections.singleton(tip));
+		assertGraphFile(graphFile);
+
+		config.setBoolean(ConfigConstants.CONFIG_GC_SECTION, null,
+				ConfigConstants.CONFIG_KEY_SPLIT_COMMIT_GRAPH, true);
+		tip = extend(tip, 1);
+		gc.writeCommitGraph(Collections.singleton(tip));
+		assertFalse(graphFile.exists());
+		CommitGraphChain chain = getCommitGraphChain();
+		assertEquals(1, chain.getLayerCount());
+		assertEquals(4, chain.getCommitCnt());
+	}
+
+	private CommitGraphChain getCommitGraphChain() {
+		CommitGraph graph = repo.getObjectDatabase().getCommitGraph().get();
+		assertTrue(graph instanceof CommitGraphChain);
+		return (CommitGraphChain) graph;
+	}
+
+	private RevCommit extend(RevCommit tip, int depth) throws Exception {
+		for (int i = 0; i < depth; i++) {
+			tip = tr.commit().parent(tip).message("" + i).create();
+		}
+		return tip;
+	}
+
+	private static File[] layerFiles(File graphsDir) {
+		return graphsDir.listFiles((d, name) -> name.endsWith(".graph"));
+	}
+
 	private void assertGraphFile(File graphFile) throws Exception {
 		assertTrue(graphFile.exists());
 		try (InputStream os = new FileInputStream(graphFile)) {
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.file;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+import java.util.Collections;
+
+import org.eclipse.jgit.junit.TestRepository.BranchBuilder;
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.lib.RefUpdate;
+import org.eclipse.jgit.revwalk.RevBlob;
+import org.eclipse.jgit.revwalk.RevCommit;
+import org.junit.Before;
+import org.junit.Test;
+
+public class GcCruftPackTest extends GcTestCase {
+
+	@Override
+	@Before
+	public void setUp() throws Exception {
+		super.setUp();
+		repo.getConfig().setBoolean(ConfigConstants.CONFIG_GC_SECTION, null,
+				ConfigConstants.CONFIG_KEY_CRUFT_PACKS, true);
+	}
+
+	@Test
+	public void testUnreachableLooseObjectsGoToCruftPack() throws Exception {
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		RevCommit tip = bb.commit().add("a", "a").create();
+		RevBlob unreachable = tr.blob("unreachable");
+		long mtime = lastModified(unreachable) / 1000;
+
+		gc.repack();
+
+		stats = gc.getStatistics();
+		assertEquals(0, stats.numberOfLooseObjects);
+		assertEquals(2, stats.numberOfPackFiles);
+		Pack cruft = findCruftPack();
+		assertNotNull(cruft);
+		assertTrue(cruft.hasObject(unreachable));
+		assertFalse(cruft.hasObject(tip));
+		assertEquals(mtime, mtimeOf(cruft, unreachable));
+		assertEquals(2, gc.getPackStatistics().size());
+	}
+
+	@Test
+	public void testUnreachablePackedObjectsGoToCruftPack() throws Exception {
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		bb.commit().add("a", "a").create();
+		BranchBuilder side = tr.branch("refs/heads/side");
+		RevCommit sideTip = side.commit().add("s", "s").create();
+		gc.repack();
+		assertNull(findCruftPack());
+
+		RefUpdate u = repo.updateRef("refs/heads/side");
+		u.setForceUpdate(true);
+		u.delete();
+		gc.setPackExpireAgeMillis(0);
+		fsTick();
+		gc.repack();
+
+		stats = gc.getStatistics();
+		assertEquals(0, stats.numberOfLooseObjects);
+		assertEquals(2, stats.numberOfPackFiles);
+		Pack cruft = findCruftPack();
+		assertNotNull(cruft);
+		assertTrue(cruft.hasObject(sideTip));
+		assertTrue(repo.getObjectDatabase().has(sideTip));
+	}
+
+	@Test
+	public void testRepackKeepsRecordedMtimes() throws Exception {
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		bb.commit().add("a", "a").create();
+		RevBlob unreachable = tr.blob("unreachable");
+		gc.repack();
+		long mtime = mtimeOf(findCruftPack(), unreachable);
+
+		gc.setPackExpireAgeMillis(0);
+		fsTick();
+		bb.commit().add("b", "b").create();
+		gc.repack();
+
+		assertEquals(2, gc.getStatistics().numberOfPackFiles);
+		assertEquals(mtime, mtimeOf(findCruftPack(), unreachable));
+	}
+
+	@Test
+	public void testPruneExpiresCruftObjects() throws Exception {
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		RevCommit tip = bb.commit().add("a", "a").create();
+		RevBlob unreachable = tr.blob("unreachable");
+		gc.repack();
+		assertNotNull(findCruftPack());
+
+		// Objects which are still recent are not pruned.
+		gc.prune(Collections.<ObjectId> emptySet());
+		assertTrue(repo.getObjectDatabase().has(unreachable));
+
+		gc.setExpireAgeMillis(0);
+		fsTick();
+		gc.prune(Collections.<ObjectId> emptySet());
+
+		assertFalse(repo.getObjectDatabase().has(unreachable));
+		assertTrue(repo.getObjectDatabase().has(tip));
+		assertNull(findCruftPack());
+		assertEquals(1, gc.getStatistics().numberOfPackFiles);
+	}
+
+	@Test
+	public void testPruneKeepsReferencedCruftObjects() throws Exception {
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		bb.commit().add("a", "a").create();
+		RevBlob unreachable = tr.blob("unreachable");
+		RevBlob referenced = tr.blob("referenced");
+		gc.repack();
+		tr.lightweightTag("t", referenced);
+
+		gc.setExpireAgeMillis(0);
+		fsTick();
+		gc.prune(Collections.<ObjectId> emptySet());
+
+		assertFalse(repo.getObjectDatabase().has(unreachable));
+		assertTrue(repo.getObjectDatabase().has(referenced));
+		Pack cruft = findCruftPack();
+		assertNotNull(cruft);
+		assertEquals(1, cruft.getIndex().getObjectCount());
+	}
+
+	private Pack findCruftPack() {
+		for (Pack p : repo.getObjectDatabase().getPacks()) {
+			if (p.isCruft()) {
+				return p;
+			}
+		}
+		return null;
+	}
+
+	private static long mtimeOf(Pack pack, ObjectId id) throws Exception {
+		PackMtimes mtimes = pack.getMtimes();
+		int position = 0;
+		for (PackIndex.MutableEntry e : pack) {
+			if (id.equals(e.toObjectId())) {
+				return mtimes.getMtime(position);
+			}
+			position++;
+		}
+		throw new AssertionError(id.name());
+	}
+}
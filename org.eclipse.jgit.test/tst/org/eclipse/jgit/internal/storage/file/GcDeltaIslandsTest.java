@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.file;
+
+import static org.eclipse.jgit.lib.Constants.OBJ_BLOB;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import java.util.List;
+
+import org.eclipse.jgit.internal.storage.pack.DeltaIslands;
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.ObjectReader;
+import org.eclipse.jgit.revwalk.RevBlob;
+import org.eclipse.jgit.revwalk.RevCommit;
+import org.eclipse.jgit.storage.file.FileBasedConfig;
+import org.eclipse.jgit.storage.pack.PackConfig;
+import org.eclipse.jgit.storage.pack.PackStatistics;
+import org.junit.Before;
+import org.junit.Test;
+
+public class GcDeltaIslandsTest extends GcTestCase {
+	private static final String ISLAND = "^refs/forks/([^/]+)/";
+
+	private RevBlob base;
+
+	private RevBlob changed;
+
+	@Override
+	@Before
+	public void setUp() throws Exception {
+		super.setUp();
+		StringBuilder content = new StringBuilder();
+		for (int i = 0; i < 200; i++) {
+			content.append("line ").append(i).append('\n');
+		}
+		base = tr.blob(content.toString());
+		// Smaller than the base, so the delta search may use the base.
+		content.setLength(content.lastIndexOf("line "));
+		changed = tr.blob(content.append("changed\n").toString());
+	}
+
+	@Test
+	public void testUnrelatedForks() throws Exception {
+		tr.update("refs/forks/a/heads/main",
+				tr.commit().add("f", base).create());
+		tr.update("refs/forks/b/heads/main",
+				tr.commit().add("f", changed).create());
+
+		gc.gc().get();
+		assertEquals(1, blobDeltas());
+
+		enableIslands();
+		gc.gc().get();
+		// The stored delta crosses islands and must not be reused.
+		assertEquals(0, blobDeltas());
+	}
+
+	@Test
+	public void testSharedHistory() throws Exception {
+		RevCommit a = tr.commit().add("f", base).create();
+		tr.update("refs/forks/a/heads/main", a);
+		tr.update("refs/forks/b/heads/main",
+				tr.commit().parent(a).add("f", changed).create());
+
+		try (ObjectReader reader = repo.newObjectReader()) {
+			DeltaIslands islands = DeltaIslands.compute(reader,
+					new String[] { ISLAND },
+					repo.getRefDatabase().getRefs(), null);
+			assertEquals(List.of("a", "b"), islands.getIslandNames());
+			assertTrue(islands.isInIsland(base, "a"));
+			assertTrue(islands.isInIsland(base, "b"));
+			assertFalse(islands.isInIsland(changed, "a"));
+			assertTrue(islands.isInIsland(changed, "b"));
+			assertTrue(islands.canDelta(changed, base));
+			assertFalse(islands.canDelta(base, changed));
+		}
+
+		enableIslands();
+		gc.gc().get();
+		assertEquals(1, blobDeltas());
+	}
+
+	@Test
+	public void testIslandsIgnoredUnlessEnabled() throws Exception {
+		tr.update("refs/forks/a/heads/main",
+				tr.commit().add("f", base).create());
+		tr.update("refs/forks/b/heads/main",
+				tr.commit().add("f", changed).create());
+		FileBasedConfig config = repo.getConfig();
+		config.setString(ConfigConstants.CONFIG_PACK_SECTION, null,
+				ConfigConstants.CONFIG_KEY_ISLAND, ISLAND);
+		config.save();
+		gc.setPackConfig(new PackConfig(repo));
+
+		gc.gc().get();
+		assertEquals(1, blobDeltas());
+	}
+
+	private void enableIslands() throws Exception {
+		FileBasedConfig config = repo.getConfig();
+		config.setString(ConfigConstants.CONFIG_PACK_SECTION, null,
+				ConfigConstants.CONFIG_KEY_ISLAND, ISLAND);
+		config.setBoolean(ConfigConstants.CONFIG_REPACK_SECTION, null,
+				ConfigConstants.CONFIG_KEY_USE_DELTA_ISLANDS, true);
+		config.save();
+		gc.setPackConfig(new PackConfig(repo));
+	}
+
+	private long blobDeltas() {
+		long deltas = 0;
+		for (PackStatistics s : gc.getPackStatistics()) {
+			deltas += s.byObjectType(OBJ_BLOB).getDeltas();
+		}
+		return deltas;
+	}
+}
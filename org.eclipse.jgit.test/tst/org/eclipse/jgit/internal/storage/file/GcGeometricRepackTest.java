@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.file;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import java.io.BufferedOutputStream;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.OutputStream;
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.List;
+import java.util.Set;
+
+import org.eclipse.jgit.internal.storage.pack.PackExt;
+import org.eclipse.jgit.internal.storage.pack.PackWriter;
+import org.eclipse.jgit.junit.TestRepository.BranchBuilder;
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.NullProgressMonitor;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.revwalk.RevCommit;
+import org.eclipse.jgit.storage.pack.PackStatistics;
+import org.junit.Test;
+
+public class GcGeometricRepackTest extends GcTestCase {
+
+	@Test
+	public void testGeometricSplit() {
+		assertEquals(0, GC.geometricSplit(new long[0], 2));
+		assertEquals(0, GC.geometricSplit(new long[] { 10 }, 2));
+		assertEquals(0, GC.geometricSplit(new long[] { 10, 100, 1000 }, 2));
+		assertEquals(2, GC.geometricSplit(new long[] { 5, 5 }, 2));
+		assertEquals(2, GC.geometricSplit(new long[] { 1, 1, 100 }, 2));
+		// Combining the first two packs breaks the progression with the
+		// third one.
+		assertEquals(3, GC.geometricSplit(new long[] { 1, 1, 2, 100 }, 2));
+		assertEquals(4, GC.geometricSplit(new long[] { 1, 1, 2, 100 }, 100));
+	}
+
+	@Test
+	public void testCombineSmallPacksAndLooseObjects() throws Exception {
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		RevCommit base = commitChain(20);
+		bb.update(base);
+		gc.repack();
+		Collection<Pack> packs = repo.getObjectDatabase().getPacks();
+		assertEquals(1, packs.size());
+		Pack large = packs.iterator().next();
+
+		RevCommit c1 = bb.commit().add("b", "b1").create();
+		Pack small1 = packIncremental(c1, base);
+		RevCommit c2 = bb.commit().add("b", "b2").create();
+		Pack small2 = packIncremental(c2, c1);
+		RevCommit c3 = bb.commit().add("b", "b3").create();
+		assertEquals(3, repo.getObjectDatabase().getPacks().size());
+		assertEquals(3, gc.getStatistics().numberOfLooseObjects);
+
+		gc.setPackExpireAgeMillis(0);
+		fsTick();
+		Collection<Pack> newPacks = gc.geometricRepack();
+		assertEquals(1, newPacks.size());
+		Pack combined = newPacks.iterator().next();
+		assertEquals(9, combined.getIndex().getObjectCount());
+
+		stats = gc.getStatistics();
+		assertEquals(0, stats.numberOfLooseObjects);
+		assertEquals(2, stats.numberOfPackFiles);
+		assertTrue(large.getPackFile().exists());
+		assertFalse(small1.getPackFile().exists());
+		assertFalse(small2.getPackFile().exists());
+		for (RevCommit c : List.of(base, c1, c2, c3)) {
+			assertTrue(repo.getObjectDatabase().has(c));
+		}
+
+		List<PackStatistics> packStats = gc.getPackStatistics();
+		assertEquals(1, packStats.size());
+		assertEquals(large.getPackFile().length(),
+				packStats.get(0).getReusedPackBytes());
+		assertTrue(packStats.get(0).getRewrittenPackBytes() > 0);
+	}
+
+	@Test
+	public void testKeepUnexpiredPacks() throws Exception {
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		RevCommit base = commitChain(20);
+		bb.update(base);
+		gc.repack();
+		RevCommit c1 = bb.commit().add("b", "b1").create();
+		Pack small1 = packIncremental(c1, base);
+		RevCommit c2 = bb.commit().add("b", "b2").create();
+		Pack small2 = packIncremental(c2, c1);
+
+		assertEquals(1, gc.geometricRepack().size());
+		assertTrue(small1.getPackFile().exists());
+		assertTrue(small2.getPackFile().exists());
+		assertEquals(4, gc.getStatistics().numberOfPackFiles);
+		for (RevCommit c : List.of(base, c1, c2)) {
+			assertTrue(repo.getObjectDatabase().has(c));
+		}
+	}
+
+	@Test
+	public void testProgressionIsLeftAlone() throws Exception {
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		RevCommit base = commitChain(20);
+		bb.update(base);
+		gc.repack();
+		RevCommit c1 = bb.commit().add("b", "b1").create();
+		packIncremental(c1, base);
+		List<String> before = packNames();
+
+		assertTrue(gc.geometricRepack().isEmpty());
+		assertTrue(gc.getPackStatistics().isEmpty());
+		assertEquals(before, packNames());
+	}
+
+	@Test
+	public void testGcUsesConfiguredFactor() throws Exception {
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		RevCommit base = commitChain(20);
+		bb.update(base);
+		gc.repack();
+		Pack large = repo.getObjectDatabase().getPacks().iterator().next();
+		bb.commit().add("b", "b1").create();
+
+		repo.getConfig().setInt(ConfigConstants.CONFIG_REPACK_SECTION, null,
+				ConfigConstants.CONFIG_KEY_GEOMETRIC_FACTOR, 2);
+		gc.gc().get();
+
+		stats = gc.getStatistics();
+		assertEquals(0, stats.numberOfLooseObjects);
+		assertEquals(2, stats.numberOfPackFiles);
+		assertTrue(large.getPackFile().exists());
+	}
+
+	@Test
+	public void testFullRepackStatistics() throws Exception {
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		bb.update(commitChain(5));
+		gc.repack();
+		Pack old = repo.getObjectDatabase().getPacks().iterator().next();
+		long oldSize = old.getPackFile().length();
+		bb.commit().add("b", "b1").create();
+
+		gc.repack();
+		List<PackStatistics> packStats = gc.getPackStatistics();
+		assertEquals(1, packStats.size());
+		assertEquals(oldSize, packStats.get(0).getRewrittenPackBytes());
+		assertEquals(0, packStats.get(0).getReusedPackBytes());
+	}
+
+	private Pack packIncremental(ObjectId want, ObjectId have)
+			throws Exception {
+		ObjectDirectory odb = repo.getObjectDatabase();
+		NullProgressMonitor m = NullProgressMonitor.INSTANCE;
+		PackFile pack;
+		try (PackWriter pw = new PackWriter(repo)) {
+			pw.preparePack(m, Set.of(want), Set.of(have));
+			pack = new PackFile(odb.getPackDirectory(), pw.computeName(),
+					PackExt.PACK);
+			try (OutputStream out = new BufferedOutputStream(
+					new FileOutputStream(pack))) {
+				pw.writePack(m, m, out);
+			}
+			try (OutputStream out = new BufferedOutputStream(
+					new FileOutputStream(pack.create(PackExt.INDEX)))) {
+				pw.writeIndex(out);
+			}
+		}
+		Pack p = odb.openPack(pack);
+		gc.prunePacked();
+		return p;
+	}
+
+	private List<String> packNames() {
+		List<String> names = new ArrayList<>();
+		File[] files = repo.getObjectDatabase().getPackDirectory().listFiles();
+		if (files != null) {
+			for (File f : files) {
+				names.add(f.getName());
+			}
+		}
+		names.sort(null);
+		return names;
+	}
+}
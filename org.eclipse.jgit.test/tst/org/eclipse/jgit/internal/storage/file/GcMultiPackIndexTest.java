@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.file;
+
+import static java.nio.charset.StandardCharsets.UTF_8;
+import static org.eclipse.jgit.internal.storage.pack.PackExt.INDEX;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertTrue;
+
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.util.Arrays;
+import java.util.Collection;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Set;
+
+import org.eclipse.jgit.internal.storage.midx.MultiPackIndex;
+import org.eclipse.jgit.internal.storage.midx.MultiPackIndexLoader;
+import org.eclipse.jgit.internal.storage.pack.CachedPack;
+import org.eclipse.jgit.internal.storage.pack.PackWriter;
+import org.eclipse.jgit.junit.TestRepository.BranchBuilder;
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.Constants;
+import org.eclipse.jgit.lib.NullProgressMonitor;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.lib.ObjectReader;
+import org.eclipse.jgit.lib.StoredConfig;
+import org.eclipse.jgit.revwalk.RevBlob;
+import org.eclipse.jgit.revwalk.RevCommit;
+import org.junit.Test;
+
+public class GcMultiPackIndexTest extends GcTestCase {
+
+	@Test
+	public void testMultiPackIndexConfig() {
+		StoredConfig config = repo.getConfig();
+		assertFalse(gc.shouldWriteMultiPackIndexWhenGc());
+
+		config.setBoolean(ConfigConstants.CONFIG_GC_SECTION, null,
+				ConfigConstants.CONFIG_KEY_WRITE_MULTI_PACK_INDEX, true);
+		assertTrue(gc.shouldWriteMultiPackIndexWhenGc());
+	}
+
+	@Test
+	public void testWriteCoversAllPacks() throws Exception {
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		bb.commit().add("A", "A").create();
+		tr.packAndPrune();
+		bb.commit().add("B", "B").create();
+		tr.packAndPrune();
+		bb.commit().add("C", "C").create();
+		tr.packAndPrune();
+
+		Collection<Pack> packs = repo.getObjectDatabase().getPacks();
+		assertEquals(3, packs.size());
+		gc.writeMultiPackIndex();
+
+		MultiPackIndex midx = MultiPackIndexLoader.open(midxFile());
+		Set<String> names = new HashSet<>(Arrays.asList(midx.getPackNames()));
+		Set<ObjectId> all = new HashSet<>();
+		for (Pack p : packs) {
+			assertTrue(names.contains(p.getPackFile().create(INDEX).getName()));
+			for (PackIndex.MutableEntry e : p) {
+				all.add(e.toObjectId());
+				assertTrue(midx.findPosition(e.toObjectId()) >= 0);
+			}
+		}
+		assertEquals(all.size(), midx.getObjectCount());
+	}
+
+	@Test
+	public void testReadObjectsThroughMultiPackIndex() throws Exception {
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		RevBlob a = tr.blob("A");
+		bb.commit().add("A", a).create();
+		tr.packAndPrune();
+		RevBlob b = tr.blob("B");
+		bb.commit().add("B", b).create();
+		tr.packAndPrune();
+		gc.writeMultiPackIndex();
+
+		// Force a rescan of the pack directory to pick up the index.
+		repo.getObjectDatabase().close();
+		try (ObjectReader reader = repo.newObjectReader()) {
+			assertTrue(reader.has(a));
+			assertTrue(reader.has(b));
+			assertEquals("A", new String(reader.open(a).getBytes(), UTF_8));
+			assertEquals(1, reader.getObjectSize(b, Constants.OBJ_BLOB));
+			assertEquals(Set.of(b), new HashSet<>(
+					reader.resolve(b.abbreviate(10))));
+		}
+	}
+
+	@Test
+	public void testRepackDeletesStaleMultiPackIndex() throws Exception {
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		bb.commit().add("A", "A").create();
+		tr.packAndPrune();
+		gc.writeMultiPackIndex();
+		RevBlob b = tr.blob("B");
+		bb.commit().add("B", b).create();
+
+		// Repacking deletes the covered pack and the stale index with it.
+		gc.setExpireAgeMillis(0);
+		gc.setPackExpireAgeMillis(0);
+		fsTick();
+		gc.gc().get();
+		assertFalse(midxFile().exists());
+		try (ObjectReader reader = repo.newObjectReader()) {
+			assertTrue(reader.has(b));
+		}
+	}
+
+	@Test
+	public void testWriteWhenGc() throws Exception {
+		StoredConfig config = repo.getConfig();
+		config.setBoolean(ConfigConstants.CONFIG_GC_SECTION, null,
+				ConfigConstants.CONFIG_KEY_WRITE_MULTI_PACK_INDEX, true);
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		bb.commit().add("A", "A").create();
+
+		gc.gc().get();
+		MultiPackIndex midx = MultiPackIndexLoader.open(midxFile());
+		assertNotNull(midx);
+		assertEquals(repo.getObjectDatabase().getPacks().size(),
+				midx.getPackNames().length);
+	}
+
+	@Test
+	public void testWriteBitmaps() throws Exception {
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		bb.commit().add("A", "A").create();
+		tr.packAndPrune();
+		RevCommit tip = bb.commit().add("B", "B").create();
+		tr.packAndPrune();
+		gc.writeMultiPackIndex();
+
+		MultiPackIndex midx = MultiPackIndexLoader.open(midxFile());
+		File bitmapFile = new File(repo.getObjectDatabase().getPackDirectory(),
+				MultiPackBitmapIndex.getFileName(midx));
+		assertTrue(bitmapFile.exists());
+		PackBitmapIndex bitmaps = MultiPackBitmapIndex.open(bitmapFile, midx);
+		assertEquals(midx.getObjectCount(), bitmaps.getObjectCount());
+		// Both packs hold everything reachable from the tip.
+		assertEquals(midx.getObjectCount(),
+				bitmaps.getBitmap(tip).cardinality());
+
+		repo.getObjectDatabase().close();
+		try (ObjectReader reader = repo.newObjectReader()) {
+			BitmapIndexImpl index = (BitmapIndexImpl) reader.getBitmapIndex();
+			assertTrue(index
+					.getPackBitmapIndex() instanceof MultiPackBitmapIndex);
+		}
+		try (PackWriter pw = new PackWriter(repo)) {
+			pw.setUseBitmaps(true);
+			pw.preparePack(NullProgressMonitor.INSTANCE, Set.of(tip),
+					PackWriter.NONE);
+			assertEquals(midx.getObjectCount(), pw.getObjectCount());
+			assertEquals(0, pw.getStatistics().getBitmapIndexMisses());
+		}
+	}
+
+	@Test
+	public void testReuseLeadingPackWithBitmaps() throws Exception {
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		bb.commit().add("A", "A").create();
+		tr.packAndPrune();
+		RevCommit tip = bb.commit().add("B", "B").create();
+		tr.packAndPrune();
+		RevCommit next = bb.commit().add("C", "C").create();
+		gc.writeMultiPackIndex();
+		Pack leading = null;
+		for (Pack p : repo.getObjectDatabase().getPacks()) {
+			if (leading == null
+					|| p.getObjectCount() > leading.getObjectCount()) {
+				leading = p;
+			}
+		}
+
+		repo.getObjectDatabase().close();
+		try (PackWriter pw = new PackWriter(repo)) {
+			pw.setUseBitmaps(true);
+			pw.setUseCachedPacks(true);
+			pw.setReuseValidatingObjects(false);
+			pw.preparePack(NullProgressMonitor.INSTANCE, Set.of(tip),
+					PackWriter.NONE);
+			pw.writePack(NullProgressMonitor.INSTANCE,
+					NullProgressMonitor.INSTANCE,
+					new ByteArrayOutputStream());
+			List<CachedPack> reused = pw.getStatistics().getReusedPacks();
+			assertEquals(1, reused.size());
+			assertEquals(leading.getObjectCount(),
+					reused.get(0).getObjectCount());
+		}
+		try (PackWriter pw = new PackWriter(repo)) {
+			pw.setUseBitmaps(true);
+			pw.setUseCachedPacks(true);
+			pw.setReuseValidatingObjects(false);
+			pw.preparePack(NullProgressMonitor.INSTANCE, Set.of(next),
+					PackWriter.NONE);
+			pw.writePack(NullProgressMonitor.INSTANCE,
+					NullProgressMonitor.INSTANCE,
+					new ByteArrayOutputStream());
+			assertEquals(1, pw.getStatistics().getReusedPacks().size());
+		}
+	}
+
+	@Test
+	public void testDeleteStaleBitmaps() throws Exception {
+		BranchBuilder bb = tr.branch("refs/heads/master");
+		bb.commit().add("A", "A").create();
+		tr.packAndPrune();
+		gc.writeMultiPackIndex();
+		File oldBitmap = new File(repo.getObjectDatabase().getPackDirectory(),
+				MultiPackBitmapIndex
+						.getFileName(MultiPackIndexLoader.open(midxFile())));
+		assertTrue(oldBitmap.exists());
+
+		bb.commit().add("B", "B").create();
+		tr.packAndPrune();
+		gc.writeMultiPackIndex();
+		assertFalse(oldBitmap.exists());
+		assertTrue(new File(repo.getObjectDatabase().getPackDirectory(),
+				MultiPackBitmapIndex
+						.getFileName(MultiPackIndexLoader.open(midxFile())))
+				.exists());
+	}
+
+	private File midxFile() {
+		return new File(repo.getObjectDatabase().getPackDirectory(),
+				Constants.MULTI_PACK_INDEX);
+	}
+}
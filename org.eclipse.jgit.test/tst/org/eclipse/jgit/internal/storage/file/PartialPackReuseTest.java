@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.file;
+
+import static org.eclipse.jgit.internal.storage.pack.PackWriter.NONE;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Set;
+
+import org.eclipse.jgit.internal.storage.file.PackIndex.MutableEntry;
+import org.eclipse.jgit.internal.storage.pack.CachedPack;
+import org.eclipse.jgit.internal.storage.pack.PackWriter;
+import org.eclipse.jgit.junit.TestRepository.BranchBuilder;
+import org.eclipse.jgit.lib.NullProgressMonitor;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.lib.ObjectInserter;
+import org.eclipse.jgit.revwalk.ObjectWalk;
+import org.eclipse.jgit.revwalk.RevCommit;
+import org.eclipse.jgit.revwalk.RevObject;
+import org.eclipse.jgit.storage.pack.PackConfig;
+import org.eclipse.jgit.storage.pack.PackStatistics;
+import org.junit.Before;
+import org.junit.Test;
+
+public class PartialPackReuseTest extends GcTestCase {
+	private RevCommit oldMain;
+
+	private RevCommit main;
+
+	private RevCommit side;
+
+	@Override
+	@Before
+	public void setUp() throws Exception {
+		super.setUp();
+		StringBuilder text = new StringBuilder();
+		for (int i = 0; i < 300; i++) {
+			text.append("line ").append(i).append('\n');
+		}
+		RevCommit base = tr.branch("refs/heads/main").commit()
+				.add("f", text.toString()).create();
+		tr.update("refs/heads/side", base);
+
+		// Interleave the versions of both branches, so the pack stores
+		// objects of the side branch between the deltas of the main branch.
+		BranchBuilder mainBranch = tr.branch("refs/heads/main");
+		BranchBuilder sideBranch = tr.branch("refs/heads/side");
+		for (int i = 1; i <= 6; i++) {
+			main = mainBranch.commit()
+					.add("f", text.append("main ").append(i).append('\n')
+							.toString())
+					.add("m" + i, "main file " + i).create();
+			side = sideBranch.commit()
+					.add("f", text.append("side ").append(i).append('\n')
+							.toString())
+					.add("s" + i, "side file " + i).create();
+			if (i == 3) {
+				oldMain = main;
+			}
+		}
+		gc.gc().get();
+	}
+
+	@Test
+	public void testClone() throws Exception {
+		PackStatistics stats = fetch(Set.of(main), NONE, true);
+		assertTrue(partiallyReused(stats));
+		assertTrue(stats.getReusedObjects() > 0);
+	}
+
+	@Test
+	public void testFetch() throws Exception {
+		PackStatistics stats = fetch(Set.of(main), Set.of(oldMain), true);
+		assertTrue(partiallyReused(stats));
+	}
+
+	@Test
+	public void testFetchBothBranches() throws Exception {
+		PackStatistics stats = fetch(Set.of(main, side), Set.of(oldMain),
+				true);
+		assertTrue(partiallyReused(stats));
+	}
+
+	@Test
+	public void testDisabled() throws Exception {
+		PackStatistics stats = fetch(Set.of(main), NONE, false);
+		assertTrue(stats.getReusedPacks().isEmpty());
+	}
+
+	private static boolean partiallyReused(PackStatistics stats) {
+		List<CachedPack> packs = stats.getReusedPacks();
+		return packs.size() == 1
+				&& packs.get(0) instanceof LocalPartialCachedPack;
+	}
+
+	/**
+	 * Write a pack as for a fetch, and verify it can be indexed and has
+	 * exactly the objects needed.
+	 */
+	private PackStatistics fetch(Set<ObjectId> want, Set<ObjectId> have,
+			boolean partialReuse) throws Exception {
+		PackConfig config = new PackConfig(repo);
+		config.setPartialPackReuse(partialReuse);
+		ByteArrayOutputStream out = new ByteArrayOutputStream();
+		PackStatistics stats;
+		try (PackWriter pw = new PackWriter(config, repo.newObjectReader())) {
+			pw.setUseBitmaps(true);
+			pw.setUseCachedPacks(true);
+			pw.setDeltaBaseAsOffset(true);
+			pw.setReuseValidatingObjects(false);
+			pw.preparePack(NullProgressMonitor.INSTANCE, want, have);
+			pw.writePack(NullProgressMonitor.INSTANCE,
+					NullProgressMonitor.INSTANCE, out);
+			stats = pw.getStatistics();
+		}
+
+		FileRepository dst = createBareRepository();
+		Pack pack;
+		try (ObjectInserter ins = dst.newObjectInserter()) {
+			ObjectDirectoryPackParser p = (ObjectDirectoryPackParser) ins
+					.newPackParser(new ByteArrayInputStream(out.toByteArray()));
+			p.setKeepEmpty(true);
+			p.parse(NullProgressMonitor.INSTANCE);
+			pack = p.getPack();
+		}
+		Set<ObjectId> sent = new HashSet<>();
+		for (MutableEntry e : pack) {
+			sent.add(e.toObjectId());
+		}
+		assertEquals(needed(want, have), sent);
+		assertEquals(sent.size(), stats.getTotalObjects());
+		return stats;
+	}
+
+	private Set<ObjectId> needed(Set<ObjectId> want, Set<ObjectId> have)
+			throws Exception {
+		Set<ObjectId> needed = new HashSet<>();
+		try (ObjectWalk ow = new ObjectWalk(repo)) {
+			for (ObjectId id : want) {
+				ow.markStart(ow.parseAny(id));
+			}
+			for (ObjectId id : have) {
+				ow.markUninteresting(ow.parseAny(id));
+			}
+			for (RevObject o; (o = ow.next()) != null;) {
+				needed.add(o.copy());
+			}
+			for (RevObject o; (o = ow.nextObject()) != null;) {
+				needed.add(o.copy());
+			}
+		}
+		return needed;
+	}
+}
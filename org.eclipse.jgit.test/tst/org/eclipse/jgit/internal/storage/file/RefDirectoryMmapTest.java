@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.file;
+
+import static java.nio.charset.StandardCharsets.UTF_8;
+import static org.eclipse.jgit.lib.Constants.HEAD;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.file.Files;
+import java.time.Instant;
+import java.util.List;
+
+import org.eclipse.jgit.junit.LocalDiskRepositoryTestCase;
+import org.eclipse.jgit.junit.TestRepository;
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.Ref;
+import org.eclipse.jgit.lib.RefDatabase;
+import org.eclipse.jgit.lib.RefUpdate;
+import org.eclipse.jgit.revwalk.RevCommit;
+import org.eclipse.jgit.revwalk.RevTag;
+import org.eclipse.jgit.storage.file.FileBasedConfig;
+import org.junit.Before;
+import org.junit.Test;
+
+public class RefDirectoryMmapTest extends LocalDiskRepositoryTestCase {
+	private static final int CHANGES = 500;
+
+	private FileRepository diskRepo;
+
+	private RefDirectory refdir;
+
+	private RevCommit A;
+
+	private RevCommit B;
+
+	private RevTag v1_0;
+
+	@Override
+	@Before
+	public void setUp() throws Exception {
+		super.setUp();
+		FileRepository db = createBareRepository();
+		FileBasedConfig cfg = db.getConfig();
+		cfg.setBoolean(ConfigConstants.CONFIG_CORE_SECTION, null,
+				ConfigConstants.CONFIG_KEY_PACKED_REFS_MMAP, true);
+		cfg.save();
+		diskRepo = new FileRepository(db.getDirectory());
+		addRepoToClose(diskRepo);
+		refdir = (RefDirectory) diskRepo.getRefDatabase();
+
+		try (TestRepository<FileRepository> repo = new TestRepository<>(
+				diskRepo)) {
+			A = repo.commit().create();
+			B = repo.commit(A);
+			v1_0 = repo.tag("v1_0", B);
+			repo.getRevWalk().parseBody(v1_0);
+		}
+	}
+
+	@Test
+	public void testExactRef() throws IOException {
+		writeSortedPackedRefs();
+		for (int i = 0; i < CHANGES; i++) {
+			Ref ref = refdir.exactRef(change(i));
+			assertEquals(change(i), ref.getName());
+			assertEquals(i % 2 == 0 ? A : B, ref.getObjectId());
+			assertTrue(ref.getStorage().isPacked());
+			assertTrue(ref.isPeeled());
+		}
+		assertNull(refdir.exactRef("refs/changes/"));
+		assertNull(refdir.exactRef(change(CHANGES)));
+		assertNull(refdir.exactRef("refs/a"));
+		assertNull(refdir.exactRef("refs/zzz"));
+
+		Ref tag = refdir.exactRef("refs/tags/v1.0");
+		assertEquals(v1_0, tag.getObjectId());
+		assertEquals(v1_0.getObject(), tag.getPeeledObjectId());
+
+		Ref head = refdir.exactRef(HEAD);
+		assertTrue(head.isSymbolic());
+		assertEquals(A, head.getObjectId());
+	}
+
+	@Test
+	public void testGetRefsByPrefix() throws IOException {
+		writeSortedPackedRefs();
+		List<Ref> tags = refdir.getRefsByPrefix("refs/tags/");
+		assertEquals(1, tags.size());
+		assertEquals("refs/tags/v1.0", tags.get(0).getName());
+
+		List<Ref> changes = refdir.getRefsByPrefix("refs/changes/1");
+		assertEquals(100, changes.size());
+		assertEquals(change(100), changes.get(0).getName());
+		assertEquals(change(199), changes.get(99).getName());
+
+		assertTrue(refdir.getRefsByPrefix("refs/changes/9").isEmpty());
+		assertEquals(CHANGES + 4, refdir.getRefs(RefDatabase.ALL).size());
+	}
+
+	@Test
+	public void testUnsortedFileIsParsed() throws IOException {
+		writePackedRefs("# pack-refs with: peeled \n" //
+				+ B.name() + " refs/heads/b\n" //
+				+ A.name() + " refs/heads/a\n");
+		assertEquals(A, refdir.exactRef("refs/heads/a").getObjectId());
+		assertEquals(B, refdir.exactRef("refs/heads/b").getObjectId());
+		assertEquals(2, refdir.getRefsByPrefix("refs/heads/").size());
+	}
+
+	@Test
+	public void testUpdatesRewriteSortedFile() throws Exception {
+		writeSortedPackedRefs();
+		RefUpdate u = diskRepo.updateRef(change(7));
+		u.setForceUpdate(true);
+		assertEquals(RefUpdate.Result.FORCED, u.delete());
+		assertNull(refdir.exactRef(change(7)));
+		assertEquals(B, refdir.exactRef(change(9)).getObjectId());
+
+		u = diskRepo.updateRef("refs/heads/new");
+		u.setNewObjectId(B);
+		assertEquals(RefUpdate.Result.NEW, u.update());
+		refdir.pack(List.of("refs/heads/new"));
+		assertFalse(new File(diskRepo.getDirectory(), "refs/heads/new")
+				.exists());
+
+		String content = new String(Files.readAllBytes(
+				refdir.packedRefsFile.toPath()), UTF_8);
+		assertTrue(content.startsWith("# pack-refs with: peeled sorted\n"));
+		Ref ref = refdir.exactRef("refs/heads/new");
+		assertEquals(B, ref.getObjectId());
+		assertTrue(ref.getStorage().isPacked());
+		assertEquals(CHANGES + 4, refdir.getRefs(RefDatabase.ALL).size());
+	}
+
+	@Test
+	public void testNamesAreComparedByBytes() throws IOException {
+		// git sorts by bytes: U+FF5E sorts before U+1F600 in UTF-8, but after
+		// its surrogate pair in UTF-16.
+		String fullwidth = "refs/heads/\uFF5E";
+		String emoji = "refs/heads/\uD83D\uDE00";
+		writePackedRefs("# pack-refs with: peeled fully-peeled sorted \n" //
+				+ A.name() + " " + fullwidth + "\n" //
+				+ B.name() + " " + emoji + "\n");
+		assertEquals(A, refdir.exactRef(fullwidth).getObjectId());
+		assertEquals(B, refdir.exactRef(emoji).getObjectId());
+		List<Ref> heads = refdir.getRefsByPrefix(emoji);
+		assertEquals(1, heads.size());
+		assertEquals(emoji, heads.get(0).getName());
+	}
+
+	@Test
+	public void testUpdatesOnWindows() throws Exception {
+		mockSystemReader.setWindows();
+		writeSortedPackedRefs();
+		assertEquals(B, refdir.exactRef(change(9)).getObjectId());
+		RefUpdate u = diskRepo.updateRef(change(7));
+		u.setForceUpdate(true);
+		assertEquals(RefUpdate.Result.FORCED, u.delete());
+		assertNull(refdir.exactRef(change(7)));
+		assertEquals(B, refdir.exactRef(change(9)).getObjectId());
+	}
+
+	private static String change(int i) {
+		return String.format("refs/changes/%03d", Integer.valueOf(i));
+	}
+
+	private void writeSortedPackedRefs() throws IOException {
+		StringBuilder b = new StringBuilder(
+				"# pack-refs with: peeled fully-peeled sorted \n");
+		for (int i = 0; i < CHANGES; i++) {
+			b.append((i % 2 == 0 ? A : B).name()).append(' ')
+					.append(change(i)).append('\n');
+		}
+		b.append(A.name()).append(" refs/heads/master\n");
+		b.append(B.name()).append(" refs/heads/other\n");
+		b.append(v1_0.name()).append(" refs/tags/v1.0\n");
+		b.append('^').append(v1_0.getObject().name()).append('\n');
+		writePackedRefs(b.toString());
+	}
+
+	private void writePackedRefs(String content) throws IOException {
+		File pr = new File(diskRepo.getDirectory(), "packed-refs");
+		write(pr, content);
+		diskRepo.getFS().setLastModified(pr.toPath(),
+				Instant.now().minusSeconds(3600));
+	}
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.midx;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Set;
+
+import org.eclipse.jgit.internal.storage.file.PackIndex;
+import org.eclipse.jgit.internal.storage.file.PackIndexWriter;
+import org.eclipse.jgit.lib.AbbreviatedObjectId;
+import org.eclipse.jgit.lib.NullProgressMonitor;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.transport.PackedObjectInfo;
+import org.junit.Test;
+
+public class MultiPackIndexWriterTest {
+
+	private static final ObjectId A = ObjectId
+			.fromString("1111111111111111111111111111111111111111");
+
+	private static final ObjectId B = ObjectId
+			.fromString("2222222222222222222222222222222222222222");
+
+	private static final ObjectId C = ObjectId
+			.fromString("2233333333333333333333333333333333333333");
+
+	private static final ObjectId D = ObjectId
+			.fromString("dddddddddddddddddddddddddddddddddddddddd");
+
+	@Test
+	public void testRoundTrip() throws Exception {
+		PackIndex first = index(new ObjectId[] { A, B }, new long[] { 12, 34 });
+		PackIndex second = index(new ObjectId[] { B, C, D },
+				new long[] { 12, 56, 0x90000000L });
+
+		// "pack-b" is preferred although it sorts after "pack-a".
+		MultiPackIndex midx = roundTrip(new MultiPackIndexWriter()
+				.addPack("pack-b.idx", first).addPack("pack-a.idx", second));
+
+		assertArrayEquals(new String[] { "pack-a.idx", "pack-b.idx" },
+				midx.getPackNames());
+		assertEquals(4, midx.getObjectCount());
+		assertObject(midx, A, 1, 12);
+		assertObject(midx, B, 1, 34);
+		assertObject(midx, C, 0, 56);
+		assertObject(midx, D, 0, 0x90000000L);
+		assertEquals(-1, midx.findPosition(
+				ObjectId.fromString("3333333333333333333333333333333333333333")));
+	}
+
+	@Test
+	public void testObjectsAreSorted() throws Exception {
+		PackIndex idx = index(new ObjectId[] { A, B, C, D },
+				new long[] { 12, 34, 56, 78 });
+		MultiPackIndex midx = roundTrip(
+				new MultiPackIndexWriter().addPack("pack-a.idx", idx));
+		for (int i = 0; i < midx.getObjectCount(); i++) {
+			assertEquals(i, midx.findPosition(midx.getObjectId(i)));
+			if (i > 0) {
+				assertTrue(midx.getObjectId(i - 1)
+						.compareTo(midx.getObjectId(i)) < 0);
+			}
+		}
+	}
+
+	@Test
+	public void testResolve() throws Exception {
+		PackIndex idx = index(new ObjectId[] { A, B, C, D },
+				new long[] { 12, 34, 56, 78 });
+		MultiPackIndex midx = roundTrip(
+				new MultiPackIndexWriter().addPack("pack-a.idx", idx));
+
+		Set<ObjectId> matches = new HashSet<>();
+		midx.resolve(matches, AbbreviatedObjectId.fromString("22"), 10);
+		assertEquals(new HashSet<>(List.of(B, C)), matches);
+
+		matches.clear();
+		midx.resolve(matches, AbbreviatedObjectId.fromString("223"), 10);
+		assertEquals(Collections.singleton(C), matches);
+	}
+
+	@Test
+	public void testPseudoPackOrder() throws Exception {
+		PackIndex first = index(new ObjectId[] { A, B }, new long[] { 34, 12 });
+		PackIndex second = index(new ObjectId[] { B, C, D },
+				new long[] { 12, 78, 56 });
+
+		// The preferred pack comes first, then packs by pack-int-id, each
+		// ordered by offset.
+		MultiPackIndex midx = roundTrip(new MultiPackIndexWriter()
+				.addPack("pack-b.idx", first).addPack("pack-a.idx", second));
+		ObjectId[] expected = { B, A, D, C };
+		for (int i = 0; i < expected.length; i++) {
+			int pos = midx.getPositionAtPseudoPackPosition(i);
+			assertEquals(expected[i], midx.getObjectId(pos));
+			assertEquals(i, midx.getPseudoPackPosition(pos));
+		}
+	}
+
+	@Test(expected = MultiPackIndexFormatException.class)
+	public void testNotAMultiPackIndex() throws Exception {
+		MultiPackIndexLoader.read(new ByteArrayInputStream(new byte[64]));
+	}
+
+	private static void assertObject(MultiPackIndex midx, ObjectId id,
+			int packId, long offset) {
+		int pos = midx.findPosition(id);
+		assertTrue(pos >= 0);
+		assertEquals(id, midx.getObjectId(pos));
+		assertEquals(packId, midx.getPackId(pos));
+		assertEquals(offset, midx.getOffset(pos));
+	}
+
+	private static MultiPackIndex roundTrip(MultiPackIndexWriter writer)
+			throws IOException {
+		ByteArrayOutputStream out = new ByteArrayOutputStream();
+		writer.write(NullProgressMonitor.INSTANCE, out);
+		return MultiPackIndexLoader
+				.read(new ByteArrayInputStream(out.toByteArray()));
+	}
+
+	private static PackIndex index(ObjectId[] ids, long[] offsets)
+			throws IOException {
+		List<PackedObjectInfo> objects = new ArrayList<>();
+		for (int i = 0; i < ids.length; i++) {
+			PackedObjectInfo info = new PackedObjectInfo(ids[i]);
+			info.setOffset(offsets[i]);
+			objects.add(info);
+		}
+		Collections.sort(objects);
+		ByteArrayOutputStream out = new ByteArrayOutputStream();
+		PackIndexWriter.createVersion(out, 2).write(objects, new byte[20]);
+		return PackIndex.read(new ByteArrayInputStream(out.toByteArray()));
+	}
+}
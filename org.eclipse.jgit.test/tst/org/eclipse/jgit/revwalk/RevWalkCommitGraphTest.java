@@ -405,6 +405,32 @@ List<Ref> allMergedInto(RevCommit needle) throws IOException {
 		return rw.getMergedInto(rw.lookupCommit(needle), refs);
 	}
 
+	@Test
+	public void testMergedIntoWithClockSkew() throws Exception {
+		RevCommit c1 = commit();
+		RevCommit c2 = commit(c1);
+		// c3 was committed with a clock running late
+		RevCommit c3 = commit(-1000, c2);
+		RevCommit c4 = commit(c1);
+		branch(c3, "commits/3");
+		branch(c4, "commits/4");
+		enableAndWriteCommitGraph();
+
+		reinitializeRevWalk();
+		c1 = rw.parseCommit(c1);
+		c3 = rw.parseCommit(c3);
+		c4 = rw.parseCommit(c4);
+		assertTrue(c3.getCommitTime() < c1.getCommitTime());
+		assertTrue(c3.getCorrectedCommitDate() > c1.getCorrectedCommitDate());
+
+		assertTrue(rw.cannotReach(c1, c3));
+		assertFalse(rw.cannotReach(c3, c1));
+		assertFalse(rw.cannotReach(c3, c4));
+		assertTrue(rw.isMergedInto(c1, c3));
+		assertFalse(rw.isMergedInto(c3, c1));
+		assertFalse(rw.isMergedInto(c4, c3));
+	}
+
 	void assertRefsEquals(List<Ref> expecteds, List<Ref> actuals) {
 		assertEquals(expecteds.size(), actuals.size());
 		Collections.sort(expecteds, Comparator.comparing(Ref::getName));
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.transport;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.OutputStream;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.List;
+import java.util.Set;
+import java.util.concurrent.atomic.AtomicReference;
+
+import org.eclipse.jgit.internal.storage.dfs.DfsRepositoryDescription;
+import org.eclipse.jgit.internal.storage.dfs.InMemoryRepository;
+import org.eclipse.jgit.junit.TestRepository;
+import org.eclipse.jgit.lib.NullProgressMonitor;
+import org.eclipse.jgit.lib.Repository;
+import org.eclipse.jgit.revwalk.RevCommit;
+import org.eclipse.jgit.storage.pack.PackStatistics;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+public class BundleUriTest {
+	@Rule
+	public TemporaryFolder tmp = new TemporaryFolder();
+
+	private final Object ctx = new Object();
+
+	private TestProtocol<Object> testProtocol;
+
+	private InMemoryRepository server;
+
+	private TestRepository<InMemoryRepository> remote;
+
+	private AtomicReference<PackStatistics> stats;
+
+	private URIish uri;
+
+	private RevCommit base;
+
+	private RevCommit tip;
+
+	@Before
+	public void setUp() throws Exception {
+		server = newRepo("server");
+		remote = new TestRepository<>(server);
+		base = remote.commit().add("a", "a").add("b", "b").create();
+		tip = remote.commit().parent(base).add("a", "changed").create();
+		remote.update("master", tip);
+
+		stats = new AtomicReference<>();
+		testProtocol = new TestProtocol<>((Object req, Repository db) -> {
+			UploadPack up = new UploadPack(db);
+			up.setExtraParameters(Set.of("version=2"));
+			up.setPostUploadHook(stats::set);
+			return up;
+		}, null);
+		uri = testProtocol.register(ctx, server);
+	}
+
+	@After
+	public void tearDown() {
+		Transport.unregister(testProtocol);
+		remote.close();
+	}
+
+	private static InMemoryRepository newRepo(String name) {
+		return new InMemoryRepository(new DfsRepositoryDescription(name));
+	}
+
+	private File writeBundle(RevCommit commit) throws Exception {
+		File file = tmp.newFile("base.bundle");
+		BundleWriter writer = new BundleWriter(server);
+		writer.include("refs/heads/master", commit);
+		try (OutputStream out = new FileOutputStream(file)) {
+			writer.writeBundle(NullProgressMonitor.INSTANCE, out);
+		}
+		return file;
+	}
+
+	private void advertise(String... bundleUris) {
+		server.getConfig().setBoolean("uploadpack", null,
+				"advertisebundleuris", true);
+		server.getConfig().setString("bundle", null, "version", "1");
+		server.getConfig().setString("bundle", null, "mode", "all");
+		for (int i = 0; i < bundleUris.length; i++) {
+			server.getConfig().setString("bundle", "b" + i, "uri",
+					bundleUris[i]);
+			server.getConfig().setInt("bundle", "b" + i, "creationToken",
+					i + 1);
+		}
+	}
+
+	private InMemoryRepository clone(boolean useBundleUri) throws Exception {
+		// The bundles are local files, but the remote is not local.
+		return clone(useBundleUri, true);
+	}
+
+	private InMemoryRepository clone(boolean useBundleUri, boolean allowFile)
+			throws Exception {
+		InMemoryRepository client = newRepo("client");
+		try (Transport tn = testProtocol.open(uri, client, "server")) {
+			tn.setUseBundleUri(useBundleUri);
+			tn.setAllowFileBundleUri(allowFile);
+			tn.fetch(NullProgressMonitor.INSTANCE, Collections.singletonList(
+					new RefSpec("+refs/heads/*:refs/remotes/origin/*")));
+		}
+		assertEquals(tip, client.exactRef("refs/remotes/origin/master")
+				.getObjectId());
+		return client;
+	}
+
+	@Test
+	public void testCloneFetchesBundleFirst() throws Exception {
+		advertise(writeBundle(base).getAbsolutePath());
+		InMemoryRepository client = clone(true);
+		assertEquals(base,
+				client.exactRef("refs/bundles/master").getObjectId());
+		// Only the new commit, its tree and the changed blob are sent.
+		assertEquals(3, stats.get().getTotalObjects());
+	}
+
+	@Test
+	public void testBundleUriDisabled() throws Exception {
+		advertise(writeBundle(base).getAbsolutePath());
+		InMemoryRepository client = clone(false);
+		assertNull(client.exactRef("refs/bundles/master"));
+		assertEquals(7, stats.get().getTotalObjects());
+	}
+
+	@Test
+	public void testLocalBundleOfRemoteIsSkipped() throws Exception {
+		advertise("file://" + writeBundle(base).getAbsolutePath());
+		InMemoryRepository client = clone(true, false);
+		assertNull(client.exactRef("refs/bundles/master"));
+		assertEquals(7, stats.get().getTotalObjects());
+	}
+
+	@Test
+	public void testMissingBundleIsSkipped() throws Exception {
+		File missing = new File(tmp.getRoot(), "missing.bundle");
+		advertise(missing.getAbsolutePath());
+		InMemoryRepository client = clone(true);
+		assertNull(client.exactRef("refs/bundles/master"));
+		assertEquals(7, stats.get().getTotalObjects());
+	}
+
+	@Test
+	public void testParseBundleList() throws Exception {
+		List<String> lines = Arrays.asList("bundle.version=1",
+				"bundle.mode=any", "bundle.new.uri=https://example.com/new",
+				"bundle.new.creationToken=20",
+				"bundle.old.uri=file:///srv/old.bundle",
+				"bundle.old.creationToken=10",
+				"bundle.relative.uri=relative.bundle",
+				"bundle.relative.creationToken=5",
+				"bundle.nouri.creationToken=1");
+		BundleList list = BundleList.parse(lines,
+				new URIish("ssh://example.com/repo.git"));
+		assertTrue(list.isAny());
+		assertEquals(2, list.getBundles().size());
+		assertEquals("/srv/old.bundle",
+				list.getBundles().get(0).uri.getPath());
+		assertEquals("example.com", list.getBundles().get(1).uri.getHost());
+	}
+
+	@Test
+	public void testParseRelativeUris() throws Exception {
+		List<String> lines = Arrays.asList("bundle.version=1",
+				"bundle.a.uri=bundles/a.bundle", "bundle.a.creationToken=1",
+				"bundle.b.uri=../b.bundle", "bundle.b.creationToken=2");
+		List<BundleList.Bundle> bundles = BundleList
+				.parse(lines, new URIish("https://example.com/git/repo.git"))
+				.getBundles();
+		assertEquals(2, bundles.size());
+		assertEquals("https://example.com/git/repo.git/bundles/a.bundle",
+				bundles.get(0).uri.toString());
+		assertEquals("https://example.com/git/b.bundle",
+				bundles.get(1).uri.toString());
+
+		File repo = tmp.newFolder("repo.git");
+		bundles = BundleList.parse(lines, new URIish(repo.getAbsolutePath()))
+				.getBundles();
+		assertEquals(2, bundles.size());
+		assertEquals(new File(repo, "bundles/a.bundle").getAbsolutePath(),
+				bundles.get(0).uri.getPath());
+		assertEquals(new File(tmp.getRoot(), "b.bundle").getAbsolutePath(),
+				bundles.get(1).uri.getPath());
+	}
+
+	@Test
+	public void testParseUnsupportedVersion() throws Exception {
+		BundleList list = BundleList.parse(
+				Arrays.asList("bundle.version=2",
+						"bundle.a.uri=https://example.com/a"),
+				new URIish("https://example.com/repo.git"));
+		assertFalse(list.isAny());
+		assertTrue(list.getBundles().isEmpty());
+	}
+}
@@ -13,7 +13,10 @@
 
 package org.eclipse.jgit.transport;
 
+import static org.junit.Assert.assertArrayEquals;
 import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNull;
 import static org.junit.Assert.assertTrue;
 import static org.junit.Assert.fail;
 
@@ -29,6 +32,7 @@
 
 import org.eclipse.jgit.errors.TooLargeObjectInPackException;
 import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.internal.storage.file.ObjectDirectory;
 import org.eclipse.jgit.internal.storage.file.ObjectDirectoryPackParser;
 import org.eclipse.jgit.internal.storage.file.Pack;
 import org.eclipse.jgit.junit.JGitTestUtil;
@@ -181,6 +185,28 @@ public void testParsePack2ReadsObjectSizes() throws IOException {
 		}
 	}
 
+	@Test
+	public void testParallelResolveDeltas() throws IOException {
+		File packFile = JGitTestUtil.getTestResourceFile(
+				"pack-df2982f284bbabb6bdb59ee3fcc6eb0983e20371.pack");
+		try (InputStream is = new FileInputStream(packFile)) {
+			ObjectDirectoryPackParser p = (ObjectDirectoryPackParser) index(is);
+			p.setThreads(4);
+			p.parse(NullProgressMonitor.INSTANCE);
+			Pack pack = p.getPack();
+
+			List<PackedObjectInfo> objects = p.getSortedObjectList(null);
+			assertEquals(pack.getIndex().getObjectCount(), objects.size());
+			for (PackedObjectInfo obj : objects) {
+				assertTrue(pack.hasObject(obj));
+				assertEquals(obj.getCRC() & 0xffffffffL,
+						pack.getIndex().findCRC32(obj));
+				assertEquals(obj.getName(), obj.getFullSize(),
+						db.getObjectDatabase().open(obj).getSize());
+			}
+		}
+	}
+
 	@Test
 	public void testTinyThinPack() throws Exception {
 		RevBlob a;
@@ -546,6 +572,86 @@ public void testDataAfterPackFooterSplitHeaderRead() throws Exception {
 		assertEquals(0x7e, in.read());
 	}
 
+	@Test
+	public void testUnpackLimitStoresLooseObjects() throws Exception {
+		byte[] data = Constants.encode("unpack me");
+		byte[] changed = Constants.encode("unpack mb");
+		InMemoryPack pack = new InMemoryPack();
+		pack.header(2);
+		pack.write((Constants.OBJ_BLOB) << 4 | 9); // offset 12
+		pack.deflate(data);
+		int deltaOffset = pack.toByteArray().length;
+		pack.write((Constants.OBJ_OFS_DELTA) << 4 | 6);
+		pack.write(deltaOffset - 12);
+		// Copy "unpack m" from the base, then insert "b".
+		pack.deflate(new byte[] { 9, 9, (byte) 0x90, 8, 1, 'b' });
+		pack.digest();
+
+		ObjectDirectoryPackParser p = (ObjectDirectoryPackParser) index(
+				pack.toInputStream());
+		p.setUnpackLimit(3);
+		assertNull(p.parse(NullProgressMonitor.INSTANCE));
+		assertNull(p.getPack());
+		assertEquals(2, p.getReceivedPackStatistics().getNumLooseObjects());
+
+		ObjectDirectory odb = (ObjectDirectory) db.getObjectDatabase();
+		assertTrue(odb.getPacks().isEmpty());
+		try (ObjectInserter.Formatter fmt = new ObjectInserter.Formatter()) {
+			ObjectId id = fmt.idFor(Constants.OBJ_BLOB, data);
+			ObjectId changedId = fmt.idFor(Constants.OBJ_BLOB, changed);
+			assertTrue(odb.fileFor(id).isFile());
+			assertTrue(odb.fileFor(changedId).isFile());
+			assertArrayEquals(changed, db.open(changedId).getBytes());
+		}
+	}
+
+	@Test
+	public void testUnpackLimitKeepsLargerPack() throws Exception {
+		InMemoryPack pack = new InMemoryPack();
+		pack.header(2);
+		pack.write((Constants.OBJ_BLOB) << 4 | 1);
+		pack.deflate(new byte[] { 'a' });
+		pack.write((Constants.OBJ_BLOB) << 4 | 1);
+		pack.deflate(new byte[] { 'b' });
+		pack.digest();
+
+		ObjectDirectoryPackParser p = (ObjectDirectoryPackParser) index(
+				pack.toInputStream());
+		p.setUnpackLimit(2);
+		p.parse(NullProgressMonitor.INSTANCE);
+		assertNotNull(p.getPack());
+		assertEquals(0, p.getReceivedPackStatistics().getNumLooseObjects());
+	}
+
+	@Test
+	public void testUnpackLimitThinPack() throws Exception {
+		RevBlob a;
+		try (TestRepository<Repository> d = new TestRepository<>(db)) {
+			db.incrementOpen();
+			a = d.blob("a");
+		}
+
+		InMemoryPack pack = new InMemoryPack();
+		pack.header(1);
+		pack.write((Constants.OBJ_REF_DELTA) << 4 | 4);
+		pack.copyRaw(a);
+		pack.deflate(new byte[] { 0x1, 0x1, 0x1, 'b' });
+		pack.digest();
+
+		ObjectDirectoryPackParser p = (ObjectDirectoryPackParser) index(
+				pack.toInputStream());
+		p.setAllowThin(true);
+		p.setUnpackLimit(100);
+		p.parse(NullProgressMonitor.INSTANCE);
+		assertNull(p.getPack());
+		// The base appended to complete the thin pack is not written again.
+		assertEquals(1, p.getReceivedPackStatistics().getNumLooseObjects());
+		try (ObjectInserter.Formatter fmt = new ObjectInserter.Formatter()) {
+			assertTrue(db.getObjectDatabase().has(
+					fmt.idFor(Constants.OBJ_BLOB, new byte[] { 'b' })));
+		}
+	}
+
 	private ObjectInserter inserter;
 
 	@After
@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.transport;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.time.Duration;
+import java.util.Collections;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import org.eclipse.jgit.internal.storage.dfs.DfsRepositoryDescription;
+import org.eclipse.jgit.internal.storage.dfs.InMemoryRepository;
+import org.eclipse.jgit.junit.TestRepository;
+import org.eclipse.jgit.lib.NullProgressMonitor;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.lib.Repository;
+import org.eclipse.jgit.revwalk.RevCommit;
+import org.eclipse.jgit.storage.pack.PackConfig;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+public class PackResponseCacheTest {
+	private static final long MAX_SIZE = 1024 * 1024;
+
+	private static final ObjectId KEY1 = ObjectId
+			.fromString("0123456789012345678901234567890123456789");
+
+	private static final ObjectId KEY2 = ObjectId
+			.fromString("1234567890123456789012345678901234567890");
+
+	private static final byte[] PACK = { 'P', 'A', 'C', 'K', 1, 2, 3 };
+
+	@Rule
+	public TemporaryFolder tmp = new TemporaryFolder();
+
+	private final Object ctx = new Object();
+
+	private TestProtocol<Object> testProtocol;
+
+	private InMemoryRepository server;
+
+	private TestRepository<InMemoryRepository> remote;
+
+	private CountingCache cache;
+
+	private URIish uri;
+
+	private PackConfig packConfig;
+
+	/** Counts the calls of the cache and the generations of packs. */
+	private static class CountingCache implements PackResponseCache {
+		final PackResponseCache delegate;
+
+		final AtomicInteger calls = new AtomicInteger();
+
+		final AtomicInteger generated = new AtomicInteger();
+
+		CountingCache(PackResponseCache delegate) {
+			this.delegate = delegate;
+		}
+
+		@Override
+		public void writePack(ObjectId key, PackGenerator generator,
+				OutputStream out) throws IOException {
+			calls.incrementAndGet();
+			delegate.writePack(key, o -> {
+				generated.incrementAndGet();
+				generator.writePack(o);
+			}, out);
+		}
+	}
+
+	@Before
+	public void setUp() throws Exception {
+		server = newRepo("server");
+		remote = new TestRepository<>(server);
+		cache = new CountingCache(new FilePackResponseCache(tmp.getRoot(),
+				Duration.ofMinutes(10), MAX_SIZE));
+		testProtocol = new TestProtocol<>((Object req, Repository db) -> {
+			UploadPack up = new UploadPack(db);
+			up.setPackResponseCache(cache);
+			up.setPackConfig(packConfig);
+			return up;
+		}, null);
+		uri = testProtocol.register(ctx, server);
+	}
+
+	@After
+	public void tearDown() {
+		Transport.unregister(testProtocol);
+		remote.close();
+	}
+
+	private static InMemoryRepository newRepo(String name) {
+		return new InMemoryRepository(new DfsRepositoryDescription(name));
+	}
+
+	private void fetch(InMemoryRepository client, RevCommit want)
+			throws Exception {
+		fetch(client, want, FilterSpec.NO_FILTER);
+	}
+
+	private void fetch(InMemoryRepository client, RevCommit want,
+			FilterSpec filter) throws Exception {
+		try (Transport tn = testProtocol.open(uri, client, "server")) {
+			tn.setFilterSpec(filter);
+			tn.fetch(NullProgressMonitor.INSTANCE, Collections.singletonList(
+					new RefSpec("refs/heads/master:refs/heads/master")));
+		}
+		assertTrue(client.getObjectDatabase().has(want));
+	}
+
+	@Test
+	public void testIdenticalClonesGeneratePackOnce() throws Exception {
+		RevCommit tip = remote.commit().add("f", "content").create();
+		remote.update("master", tip);
+
+		fetch(newRepo("client1"), tip);
+		fetch(newRepo("client2"), tip);
+		assertEquals(2, cache.calls.get());
+		assertEquals(1, cache.generated.get());
+
+		RevCommit next = remote.commit().parent(tip).add("f", "changed")
+				.create();
+		remote.update("master", next);
+		fetch(newRepo("client3"), next);
+		assertEquals(3, cache.calls.get());
+		assertEquals(2, cache.generated.get());
+	}
+
+	@Test
+	public void testPackConfigChangingPackIsPartOfKey() throws Exception {
+		RevCommit tip = remote.commit().add("f", "content").create();
+		remote.update("master", tip);
+
+		packConfig = new PackConfig();
+		packConfig.setDeltaCacheSize(1024);
+		fetch(newRepo("client1"), tip);
+		packConfig = new PackConfig();
+		packConfig.setDeltaCacheSize(2048);
+		fetch(newRepo("client2"), tip);
+		assertEquals(1, cache.generated.get());
+
+		packConfig = new PackConfig();
+		packConfig.setCompressionLevel(1);
+		fetch(newRepo("client3"), tip);
+		assertEquals(2, cache.generated.get());
+	}
+
+	@Test
+	public void testFetchWithCommonObjectsIsNotCached() throws Exception {
+		RevCommit tip = remote.commit().add("f", "content").create();
+		remote.update("master", tip);
+		InMemoryRepository client = newRepo("client");
+		fetch(client, tip);
+		assertEquals(1, cache.calls.get());
+
+		RevCommit next = remote.commit().parent(tip).add("f", "changed")
+				.create();
+		remote.update("master", next);
+		fetch(client, next);
+		assertEquals(1, cache.calls.get());
+	}
+
+	@Test
+	public void testFilteredFetchIsNotCached() throws Exception {
+		server.getConfig().setBoolean("uploadpack", null, "allowfilter",
+				true);
+		RevCommit tip = remote.commit().add("f", "content").create();
+		remote.update("master", tip);
+		fetch(newRepo("client"), tip, FilterSpec.withBlobLimit(0));
+		assertEquals(0, cache.calls.get());
+	}
+
+	@Test
+	public void testOldestPacksAreDeletedBeyondMaxSize() throws Exception {
+		FilePackResponseCache files = new FilePackResponseCache(
+				tmp.getRoot(), Duration.ofMinutes(10), PACK.length + 1);
+		assertArrayEquals(PACK, writePack(files, KEY1));
+		assertTrue(packFile(KEY1).isFile());
+		assertArrayEquals(PACK, writePack(files, KEY2));
+		assertFalse(packFile(KEY1).exists());
+		assertTrue(packFile(KEY2).isFile());
+	}
+
+	@Test
+	public void testExpiredPacksAreDeleted() throws Exception {
+		FilePackResponseCache files = new FilePackResponseCache(
+				tmp.getRoot(), Duration.ofMinutes(10), MAX_SIZE);
+		writePack(files, KEY1);
+		assertTrue(packFile(KEY1).setLastModified(
+				System.currentTimeMillis() - Duration.ofHours(1).toMillis()));
+		writePack(files, KEY2);
+		assertFalse(packFile(KEY1).exists());
+		assertTrue(packFile(KEY2).isFile());
+	}
+
+	@Test
+	public void testPackLargerThanMaxSizeIsNotStored() throws Exception {
+		FilePackResponseCache files = new FilePackResponseCache(
+				tmp.getRoot(), Duration.ofMinutes(10), PACK.length - 1);
+		assertArrayEquals(PACK, writePack(files, KEY1));
+		assertEquals(0, tmp.getRoot().list().length);
+	}
+
+	@Test
+	public void testConcurrentRequestsWaitForGeneration() throws Exception {
+		FilePackResponseCache files = new FilePackResponseCache(
+				tmp.getRoot(), Duration.ofMinutes(10), MAX_SIZE);
+		CountDownLatch started = new CountDownLatch(1);
+		CountDownLatch release = new CountDownLatch(1);
+		AtomicInteger generated = new AtomicInteger();
+		PackResponseCache.PackGenerator generator = out -> {
+			generated.incrementAndGet();
+			started.countDown();
+			try {
+				release.await();
+			} catch (InterruptedException e) {
+				throw new IOException(e);
+			}
+			out.write(PACK);
+		};
+
+		ExecutorService pool = Executors.newFixedThreadPool(2);
+		try {
+			Future<byte[]> first = pool.submit(() -> {
+				ByteArrayOutputStream out = new ByteArrayOutputStream();
+				files.writePack(KEY1, generator, out);
+				return out.toByteArray();
+			});
+			assertTrue(started.await(10, TimeUnit.SECONDS));
+			Future<byte[]> second = pool.submit(() -> {
+				ByteArrayOutputStream out = new ByteArrayOutputStream();
+				files.writePack(KEY1, generator, out);
+				return out.toByteArray();
+			});
+			release.countDown();
+			assertArrayEquals(PACK, first.get(10, TimeUnit.SECONDS));
+			assertArrayEquals(PACK, second.get(10, TimeUnit.SECONDS));
+		} finally {
+			pool.shutdownNow();
+		}
+		assertEquals(1, generated.get());
+	}
+
+	private static byte[] writePack(FilePackResponseCache files, ObjectId key)
+			throws IOException {
+		ByteArrayOutputStream out = new ByteArrayOutputStream();
+		files.writePack(key, o -> o.write(PACK), out);
+		return out.toByteArray();
+	}
+
+	private File packFile(ObjectId key) {
+		return new File(tmp.getRoot(), key.name() + ".pack");
+	}
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.transport;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import java.util.Collections;
+import java.util.Random;
+
+import org.eclipse.jgit.internal.storage.dfs.DfsRepositoryDescription;
+import org.eclipse.jgit.internal.storage.dfs.InMemoryRepository;
+import org.eclipse.jgit.junit.TestRepository;
+import org.eclipse.jgit.lib.NullProgressMonitor;
+import org.eclipse.jgit.lib.Repository;
+import org.eclipse.jgit.lib.Sets;
+import org.eclipse.jgit.revwalk.RevCommit;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+public class PushNegotiationTest {
+	private static final int BLOB_SIZE = 20000;
+
+	private final Object ctx = new Object();
+
+	private InMemoryRepository server;
+
+	private InMemoryRepository client;
+
+	private TestProtocol<Object> testProtocol;
+
+	private URIish uri;
+
+	private long packSize;
+
+	private RevCommit base;
+
+	@Before
+	public void setUp() throws Exception {
+		server = newRepo("server");
+		client = newRepo("client");
+		testProtocol = new TestProtocol<>((Object req, Repository db) -> {
+			UploadPack up = new UploadPack(db);
+			up.setExtraParameters(Sets.of("version=2"));
+			return up;
+		}, (Object req, Repository db) -> {
+			ReceivePack rp = new ReceivePack(db);
+			// The commit the client builds on is hidden from push.
+			rp.setRefFilter(refs -> Collections.emptyMap());
+			rp.setPostReceiveHook(
+					(receivePack, commands) -> packSize = receivePack
+							.getPackSize());
+			return rp;
+		});
+		uri = testProtocol.register(ctx, server);
+
+		try (TestRepository<InMemoryRepository> remote = new TestRepository<>(
+				server);
+				TestRepository<InMemoryRepository> local = new TestRepository<>(
+						client)) {
+			base = createBase(remote);
+			remote.update("refs/hidden/base", base);
+			assertEquals(base, createBase(local));
+			RevCommit tip = local.commit().message("tip").parent(base)
+					.add("b.txt", "b").create();
+			local.update("master", tip);
+		}
+	}
+
+	@After
+	public void tearDown() {
+		Transport.unregister(testProtocol);
+	}
+
+	private static InMemoryRepository newRepo(String name) {
+		return new InMemoryRepository(new DfsRepositoryDescription(name));
+	}
+
+	private static RevCommit createBase(TestRepository<?> repo)
+			throws Exception {
+		byte[] data = new byte[BLOB_SIZE];
+		new Random(42).nextBytes(data);
+		return repo.commit().message("base").add("a.bin", repo.blob(data))
+				.create();
+	}
+
+	@Test
+	public void testNegotiationOmitsObjectsOfHiddenRefs() throws Exception {
+		server.getConfig().setBoolean("uploadpack", null,
+				"advertisewaitfordone", true);
+		push(true);
+		assertTrue(packSize < BLOB_SIZE / 10);
+	}
+
+	@Test
+	public void testWithoutNegotiation() throws Exception {
+		server.getConfig().setBoolean("uploadpack", null,
+				"advertisewaitfordone", true);
+		push(false);
+		assertTrue(packSize > BLOB_SIZE);
+	}
+
+	@Test
+	public void testRemoteWithoutWaitForDone() throws Exception {
+		push(true);
+		assertTrue(packSize > BLOB_SIZE);
+	}
+
+	private void push(boolean negotiate) throws Exception {
+		try (Transport tn = testProtocol.open(uri, client, "server")) {
+			tn.setPushNegotiate(negotiate);
+			RemoteRefUpdate update = new RemoteRefUpdate(client,
+					"refs/heads/master", "refs/heads/master", false, null,
+					null);
+			PushResult result = tn.push(NullProgressMonitor.INSTANCE,
+					Collections.singleton(update));
+			assertEquals(RemoteRefUpdate.Status.OK,
+					result.getRemoteUpdate("refs/heads/master").getStatus());
+		}
+		assertEquals(client.exactRef("refs/heads/master").getObjectId(),
+				server.exactRef("refs/heads/master").getObjectId());
+	}
+}
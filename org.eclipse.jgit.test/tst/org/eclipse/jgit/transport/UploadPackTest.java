@@ -2425,6 +2425,100 @@ public void testNegotiationTipDoesNotDoFullClone() throws Exception {
 		assertTrue(countHavesHook.havesSentDuringNegotiation.isEmpty());
 	}
 
+	@Test
+	public void testSkippingNegotiation() throws Exception {
+		RevCommit base = remote.commit().message("base").create();
+		RevCommit next = remote.commit().message("next").parent(base)
+				.create();
+		AtomicReference<UploadPack> uploadPack = new AtomicReference<>();
+		testProtocol = new TestProtocol<>((Object req, Repository db) -> {
+			UploadPack up = new UploadPack(db);
+			uploadPack.set(up);
+			return up;
+		}, null);
+		uri = testProtocol.register(ctx, server);
+
+		FetchResult consecutive = fetchAfterLocalCommits(base, next,
+				NegotiationAlgorithm.CONSECUTIVE);
+		long consecutiveHaves = uploadPack.get().getStatistics().getHaves();
+		FetchResult skipping = fetchAfterLocalCommits(base, next,
+				NegotiationAlgorithm.SKIPPING);
+		long skippingHaves = uploadPack.get().getStatistics().getHaves();
+
+		// All 100 local commits and the base, or only a few of them.
+		assertEquals(101, consecutiveHaves);
+		assertTrue(skippingHaves < 20);
+		assertTrue(skipping.getNegotiationRoundTrips() > 0);
+		assertTrue(skipping.getNegotiationRoundTrips() < consecutive
+				.getNegotiationRoundTrips());
+	}
+
+	@Test
+	public void testNoopNegotiation() throws Exception {
+		RevCommit base = remote.commit().message("base").create();
+		RevCommit next = remote.commit().message("next").parent(base)
+				.create();
+		AtomicReference<UploadPack> uploadPack = new AtomicReference<>();
+		testProtocol = new TestProtocol<>((Object req, Repository db) -> {
+			UploadPack up = new UploadPack(db);
+			uploadPack.set(up);
+			return up;
+		}, null);
+		uri = testProtocol.register(ctx, server);
+
+		FetchResult result = fetchAfterLocalCommits(base, next,
+				NegotiationAlgorithm.NOOP);
+		assertEquals(0, uploadPack.get().getStatistics().getHaves());
+		assertEquals(1, result.getNegotiationRoundTrips());
+	}
+
+	@Test
+	public void testNegotiationAlgorithmConfig() throws Exception {
+		client.getConfig().setString(ConfigConstants.CONFIG_FETCH_SECTION,
+				null, ConfigConstants.CONFIG_KEY_NEGOTIATION_ALGORITHM,
+				"skipping");
+		assertEquals(NegotiationAlgorithm.SKIPPING,
+				new FetchConfig(client.getConfig()).negotiationAlgorithm);
+		client.getConfig().setString(ConfigConstants.CONFIG_FETCH_SECTION,
+				null, ConfigConstants.CONFIG_KEY_NEGOTIATION_ALGORITHM,
+				"default");
+		assertEquals(NegotiationAlgorithm.CONSECUTIVE,
+				new FetchConfig(client.getConfig()).negotiationAlgorithm);
+	}
+
+	/**
+	 * Fetch {@code base} into a new client, commit 100 commits on top of it
+	 * locally and then fetch {@code next}.
+	 */
+	private FetchResult fetchAfterLocalCommits(RevCommit base,
+			RevCommit next, NegotiationAlgorithm algorithm) throws Exception {
+		InMemoryRepository local = newRepo("local-" + algorithm);
+		remote.update("master", base);
+		try (Transport tn = testProtocol.open(uri, local, "server")) {
+			tn.fetch(NullProgressMonitor.INSTANCE, Collections.singletonList(
+					new RefSpec("refs/heads/master:refs/heads/master")));
+		}
+		try (TestRepository<InMemoryRepository> localRepo = new TestRepository<>(
+				local)) {
+			RevCommit tip = localRepo.getRevWalk().parseCommit(base);
+			for (int i = 0; i < 100; i++) {
+				tip = localRepo.commit().message("local-" + i).parent(tip)
+						.create();
+			}
+			localRepo.update("local", tip);
+		}
+
+		remote.update("master", next);
+		try (Transport tn = testProtocol.open(uri, local, "server")) {
+			tn.setNegotiationAlgorithm(algorithm);
+			FetchResult result = tn.fetch(NullProgressMonitor.INSTANCE,
+					Collections.singletonList(new RefSpec(
+							"refs/heads/master:refs/heads/master")));
+			assertTrue(local.getObjectDatabase().has(next));
+			return result;
+		}
+	}
+
 	private static class CountHavesPreUploadHook implements PreUploadHook {
 		Set<ObjectId> havesSentDuringNegotiation = new HashSet<>();
 
@@ -15,11 +15,18 @@
 import static org.eclipse.jgit.lib.FileMode.TYPE_GITLINK;
 import static org.eclipse.jgit.lib.FileMode.TYPE_TREE;
 
+import java.io.File;
 import java.io.IOException;
 import java.io.InputStream;
+import java.io.InterruptedIOException;
+import java.nio.channels.Channels;
+import java.nio.channels.FileChannel;
 import java.time.Instant;
 import java.util.ArrayList;
 import java.util.List;
+import java.util.concurrent.Future;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicInteger;
 
 import org.eclipse.jgit.api.errors.FilterFailedException;
 import org.eclipse.jgit.api.errors.GitAPIException;
@@ -30,7 +37,13 @@
 import org.eclipse.jgit.dircache.DirCacheBuilder;
 import org.eclipse.jgit.dircache.DirCacheEntry;
 import org.eclipse.jgit.dircache.DirCacheIterator;
+import org.eclipse.jgit.dircache.FsMonitor;
+import org.eclipse.jgit.dircache.SparseCheckout;
 import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.internal.storage.file.ObjectDirectory;
+import org.eclipse.jgit.internal.util.Workers;
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.CoreConfig.EolStreamType;
 import org.eclipse.jgit.lib.FileMode;
 import org.eclipse.jgit.lib.ObjectId;
 import org.eclipse.jgit.lib.ObjectInserter;
@@ -55,6 +68,43 @@
  */
 public class AddCommand extends GitCommand<DirCache> {
 
+	/**
+	 * Minimum number of files to insert for using several workers, if
+	 * configured by {@code add.workers}. Not configurable, as documented for
+	 * {@code add.workers}.
+	 */
+	private static final int PARALLEL_THRESHOLD = 100;
+
+	/**
+	 * Minimum number of files to insert for writing packs instead of loose
+	 * objects when using several workers. Not configurable, as documented
+	 * for {@code add.workers}.
+	 */
+	private static final int PACK_THRESHOLD = 1000;
+
+	/** A blob read from an unfiltered file, not inserted yet. */
+	private static class PendingBlob {
+		final DirCacheEntry entry;
+
+		final File file;
+
+		PendingBlob(DirCacheEntry entry, File file) {
+			this.entry = entry;
+			this.file = file;
+		}
+
+		void insert(ObjectInserter inserter) throws IOException {
+			// Take the length from the opened file, the file may have
+			// changed since the working tree was scanned.
+			try (FileChannel channel = FileChannel.open(file.toPath())) {
+				long length = channel.size();
+				entry.setObjectId(inserter.insert(OBJ_BLOB, length,
+						Channels.newInputStream(channel)));
+				entry.setLength(length);
+			}
+		}
+	}
+
 	private List<String> filepatterns;
 
 	private WorkingTreeIterator workingTreeIterator;
@@ -128,10 +178,15 @@ public DirCache call() throws GitAPIException, NoFilepatternException {
 			tw.setOperationType(OperationType.CHECKIN_OP);
 			dc = repo.lockDirCache();
 
+			if (workingTreeIterator == null) {
+				workingTreeIterator = new FileTreeIterator(repo);
+				FsMonitor fsMonitor = FsMonitor.get(repo);
+				if (fsMonitor != null) {
+					dc.refreshFsMonitor(fsMonitor);
+				}
+			}
 			DirCacheBuilder builder = dc.builder();
 			tw.addTree(new DirCacheBuildIterator(builder));
-			if (workingTreeIterator == null)
-				workingTreeIterator = new FileTreeIterator(repo);
 			workingTreeIterator.setDirCacheIterator(tw, 0);
 			tw.addTree(workingTreeIterator);
 			TreeFilter pathFilter = null;
@@ -150,6 +205,9 @@ public DirCache call() throws GitAPIException, NoFilepatternException {
 			}
 
 			byte[] lastAdded = null;
+			int workers = getWorkers();
+			SparseCheckout sparse = SparseCheckout.get(repo);
+			List<PendingBlob> pending = new ArrayList<>();
 
 			while (tw.next()) {
 				DirCacheIterator c = tw.getTree(0, DirCacheIterator.class);
@@ -179,6 +237,17 @@ public DirCache call() throws GitAPIException, NoFilepatternException {
 					continue;
 				}
 
+				if ((entry != null && entry.isSkipWorkTree())
+						|| (entry == null && sparse != null
+								&& !sparse.isIncluded(tw.getPathString()))) {
+					// Paths outside of a sparse checkout are not added, and
+					// their missing files are not removed.
+					if (entry != null) {
+						builder.add(entry);
+					}
+					continue;
+				}
+
 				if (f == null) { // working tree file does not exist
 					if (entry != null
 							&& (!update || GITLINK == entry.getFileMode())) {
@@ -216,15 +285,22 @@ public DirCache call() throws GitAPIException, NoFilepatternException {
 				if (GITLINK != mode) {
 					entry.setLength(f.getEntryLength());
 					entry.setLastModified(f.getEntryLastModifiedInstant());
-					long len = f.getEntryContentLength();
-					// We read and filter the content multiple times.
-					// f.getEntryContentLength() reads and filters the input and
-					// inserter.insert(...) does it again. That's because an
-					// ObjectInserter needs to know the length before it starts
-					// inserting. TODO: Fix this by using Buffers.
-					try (InputStream in = f.openEntryStream()) {
-						ObjectId id = inserter.insert(OBJ_BLOB, len, in);
-						entry.setObjectId(id);
+					if (workers > 1 && isUnfiltered(f, mode)) {
+						// Hashed and deflated later, possibly in parallel.
+						pending.add(new PendingBlob(entry,
+								((FileTreeIterator) f).getEntryFile()));
+					} else {
+						// We read and filter the content multiple times.
+						// f.getEntryContentLength() reads and filters the
+						// input and inserter.insert(...) does it again.
+						// That's because an ObjectInserter needs to know the
+						// length before it starts inserting. TODO: Fix this
+						// by using Buffers.
+						long len = f.getEntryContentLength();
+						try (InputStream in = f.openEntryStream()) {
+							ObjectId id = inserter.insert(OBJ_BLOB, len, in);
+							entry.setObjectId(id);
+						}
 					}
 				} else {
 					entry.setLength(0);
@@ -234,6 +310,7 @@ public DirCache call() throws GitAPIException, NoFilepatternException {
 				builder.add(entry);
 				lastAdded = path;
 			}
+			insert(pending, inserter, workers);
 			inserter.flush();
 			builder.commit();
 			setCallable(false);
@@ -251,6 +328,73 @@ public DirCache call() throws GitAPIException, NoFilepatternException {
 		return dc;
 	}
 
+	private int getWorkers() {
+		int workers = repo.getConfig().getInt(
+				ConfigConstants.CONFIG_ADD_SECTION,
+				ConfigConstants.CONFIG_KEY_WORKERS, 1);
+		return workers < 1 ? Runtime.getRuntime().availableProcessors()
+				: workers;
+	}
+
+	private static boolean isUnfiltered(WorkingTreeIterator f, FileMode mode)
+			throws IOException {
+		return f instanceof FileTreeIterator
+				&& (FileMode.REGULAR_FILE.equals(mode)
+						|| FileMode.EXECUTABLE_FILE.equals(mode))
+				&& f.getCleanFilterCommand() == null
+				&& f.getEolStreamType() == EolStreamType.DIRECT;
+	}
+
+	/**
+	 * Insert the blobs of unfiltered files.
+	 * <p>
+	 * Reading, hashing and deflating the files is CPU bound, so many files
+	 * are inserted by several workers, each with its own inserter. Many
+	 * files are written as one pack per worker instead of loose objects.
+	 */
+	private void insert(List<PendingBlob> blobs, ObjectInserter inserter,
+			int workers) throws IOException {
+		if (blobs.size() < PARALLEL_THRESHOLD) {
+			for (PendingBlob blob : blobs) {
+				blob.insert(inserter);
+			}
+			return;
+		}
+		boolean packed = blobs.size() >= PACK_THRESHOLD
+				&& repo.getObjectDatabase() instanceof ObjectDirectory;
+		AtomicInteger next = new AtomicInteger();
+		AtomicBoolean failed = new AtomicBoolean();
+		int n = Math.min(workers, blobs.size());
+		List<Future<?>> futures = new ArrayList<>(n);
+		for (int w = 0; w < n; w++) {
+			futures.add(Workers.getExecutor().submit(() -> {
+				try (ObjectInserter ins = packed
+						? ((ObjectDirectory) repo.getObjectDatabase())
+								.newPackInserter()
+						: repo.newObjectInserter()) {
+					int i;
+					while (!failed.get()
+							&& (i = next.getAndIncrement()) < blobs.size()) {
+						blobs.get(i).insert(ins);
+					}
+					ins.flush();
+				} catch (IOException | RuntimeException e) {
+					failed.set(true);
+					throw e;
+				}
+				return null;
+			}));
+		}
+		for (Future<?> f : futures) {
+			try {
+				Workers.join(f);
+			} catch (InterruptedException e) {
+				failed.set(true);
+				throw new InterruptedIOException();
+			}
+		}
+	}
+
 	/**
 	 * Set whether to only match against already tracked files
 	 *
@@ -481,7 +481,8 @@ public void apply(DirCacheEntry ent) {
 									ent);
 							throw new JGitInternalException(e.getMessage(), e);
 						}
-					} else {
+					} else if (!ent.isSkipWorkTree()) {
+						// Paths outside of a sparse checkout stay absent.
 						checkoutPath(ent, r, checkout, path,
 								new CheckoutMetadata(eolStreamType,
 										filterCommand));
@@ -518,6 +519,11 @@ public void apply(DirCacheEntry ent) {
 					}
 					ent.setObjectId(blobId);
 					ent.setFileMode(mode);
+					if (ent.isSkipWorkTree()) {
+						// Outside of a sparse checkout, only the index is
+						// updated.
+						return;
+					}
 					checkoutPath(ent, r, checkout, path,
 							new CheckoutMetadata(eolStreamType, filterCommand));
 					actuallyModifiedPaths.add(path);
@@ -40,10 +40,13 @@
 import org.eclipse.jgit.lib.Ref;
 import org.eclipse.jgit.lib.RefUpdate;
 import org.eclipse.jgit.lib.Repository;
+import org.eclipse.jgit.lib.StoredConfig;
 import org.eclipse.jgit.revwalk.RevCommit;
 import org.eclipse.jgit.revwalk.RevWalk;
 import org.eclipse.jgit.submodule.SubmoduleWalk;
 import org.eclipse.jgit.transport.FetchResult;
+import org.eclipse.jgit.transport.FilterSpec;
+import org.eclipse.jgit.transport.GitProtocolConstants;
 import org.eclipse.jgit.transport.RefSpec;
 import org.eclipse.jgit.transport.RemoteConfig;
 import org.eclipse.jgit.transport.TagOpt;
@@ -101,6 +104,10 @@ public class CloneCommand extends TransportCommand<CloneCommand, Git> {
 
 	private List<String> shallowExcludes = new ArrayList<>();
 
+	private FilterSpec filterSpec = FilterSpec.NO_FILTER;
+
+	private Boolean useBundleUri;
+
 	private ShutdownHook.Listener shutdownListener = this::cleanup;
 
 	private enum FETCH_TYPE {
@@ -293,6 +300,9 @@ private FetchResult fetch(Repository clonedRepo, URIish u)
 			config.setTagOpt(tagOption);
 		}
 		config.update(clonedRepo.getConfig());
+		if (!filterSpec.isNoOp()) {
+			setupPartialClone(clonedRepo.getConfig());
+		}
 
 		clonedRepo.getConfig().save();
 
@@ -314,11 +324,27 @@ private FetchResult fetch(Repository clonedRepo, URIish u)
 			command.setShallowSince(shallowSince);
 		}
 		command.setShallowExcludes(shallowExcludes);
+		command.setFilterSpec(filterSpec);
+		command.setUseBundleUri(useBundleUri);
 		configure(command);
 
 		return command.call();
 	}
 
+	private void setupPartialClone(StoredConfig config) {
+		// The filter line is "filter <spec>", the configuration holds <spec>.
+		String filter = filterSpec.filterLine()
+				.substring(GitProtocolConstants.OPTION_FILTER.length() + 1);
+		config.setBoolean(ConfigConstants.CONFIG_REMOTE_SECTION, remote,
+				ConfigConstants.CONFIG_KEY_PROMISOR, true);
+		config.setString(ConfigConstants.CONFIG_REMOTE_SECTION, remote,
+				ConfigConstants.CONFIG_KEY_PARTIAL_CLONE_FILTER, filter);
+		config.setString(ConfigConstants.CONFIG_EXTENSIONS_SECTION, null,
+				ConfigConstants.CONFIG_KEY_PARTIAL_CLONE, remote);
+		config.setLong(ConfigConstants.CONFIG_CORE_SECTION, null,
+				ConfigConstants.CONFIG_KEY_REPO_FORMAT_VERSION, 1);
+	}
+
 	private List<RefSpec> calculateRefSpecs(FETCH_TYPE type,
 			String remoteName) {
 		List<RefSpec> specs = new ArrayList<>();
@@ -821,6 +847,44 @@ public CloneCommand addShallowExclude(@NonNull ObjectId shallowExclude) {
 		return this;
 	}
 
+	/**
+	 * Creates a partial clone, like {@code git clone --filter}.
+	 * <p>
+	 * The remote becomes a promisor remote of the clone: objects omitted by
+	 * the filter are fetched from it when they are read.
+	 *
+	 * @param filter
+	 *            the filter selecting the objects to clone, for example
+	 *            {@code FilterSpec.fromFilterLine("blob:none")}; must not be
+	 *            {@code null}
+	 * @return {@code this}
+	 * @since 6.9
+	 */
+	public CloneCommand setFilterSpec(@NonNull FilterSpec filter) {
+		this.filterSpec = filter;
+		return this;
+	}
+
+	/**
+	 * Set whether to fetch the bundles advertised by the remote before
+	 * fetching from the remote, like {@code git clone -c transfer.bundleURI}.
+	 * <p>
+	 * Pre-built bundles served from a static file server take most of the
+	 * work of a clone off the remote, which then only sends the objects
+	 * missing from the bundles.
+	 *
+	 * @param useBundleUri
+	 *            true to fetch the advertised bundles first; by default
+	 *            {@code transfer.bundleURI} of the user configuration is used
+	 * @return {@code this}
+	 * @see org.eclipse.jgit.transport.Transport#setUseBundleUri(boolean)
+	 * @since 6.9
+	 */
+	public CloneCommand setUseBundleUri(boolean useBundleUri) {
+		this.useBundleUri = Boolean.valueOf(useBundleUri);
+		return this;
+	}
+
 	private static void validateDirs(File directory, File gitDir, boolean bare)
 			throws IllegalStateException {
 		if (directory != null) {
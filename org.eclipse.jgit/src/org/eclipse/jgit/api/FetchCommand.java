@@ -29,6 +29,7 @@
 import org.eclipse.jgit.errors.ConfigInvalidException;
 import org.eclipse.jgit.errors.NoRemoteRepositoryException;
 import org.eclipse.jgit.errors.NotSupportedException;
+import org.eclipse.jgit.errors.PackProtocolException;
 import org.eclipse.jgit.errors.TransportException;
 import org.eclipse.jgit.internal.JGitText;
 import org.eclipse.jgit.lib.ConfigConstants;
@@ -42,6 +43,8 @@
 import org.eclipse.jgit.revwalk.RevWalk;
 import org.eclipse.jgit.submodule.SubmoduleWalk;
 import org.eclipse.jgit.transport.FetchResult;
+import org.eclipse.jgit.transport.FilterSpec;
+import org.eclipse.jgit.transport.NegotiationAlgorithm;
 import org.eclipse.jgit.transport.RefSpec;
 import org.eclipse.jgit.transport.TagOpt;
 import org.eclipse.jgit.transport.Transport;
@@ -87,6 +90,12 @@ public class FetchCommand extends TransportCommand<FetchCommand, FetchResult> {
 
 	private boolean unshallow;
 
+	private FilterSpec filterSpec;
+
+	private NegotiationAlgorithm negotiationAlgorithm;
+
+	private Boolean useBundleUri;
+
 	/**
 	 * Callback for status of fetch operation.
 	 *
@@ -234,6 +243,11 @@ public FetchResult call() throws GitAPIException, InvalidRemoteException,
 				transport.setDeepenSince(deepenSince);
 			}
 			transport.setDeepenNots(shallowExcludes);
+			transport.setFilterSpec(getFilterSpec());
+			transport.setNegotiationAlgorithm(negotiationAlgorithm);
+			if (useBundleUri != null) {
+				transport.setUseBundleUri(useBundleUri.booleanValue());
+			}
 			configure(transport);
 			FetchResult result = transport.fetch(monitor,
 					applyOptions(refSpecs), initialBranch);
@@ -259,6 +273,23 @@ public FetchResult call() throws GitAPIException, InvalidRemoteException,
 
 	}
 
+	private FilterSpec getFilterSpec() throws PackProtocolException {
+		if (filterSpec != null) {
+			return filterSpec;
+		}
+		// Further fetches from a promisor remote reuse the filter of the
+		// partial clone.
+		StoredConfig config = repo.getConfig();
+		String filter = config.getString(ConfigConstants.CONFIG_REMOTE_SECTION,
+				remote, ConfigConstants.CONFIG_KEY_PARTIAL_CLONE_FILTER);
+		if (filter == null || !config.getBoolean(
+				ConfigConstants.CONFIG_REMOTE_SECTION, remote,
+				ConfigConstants.CONFIG_KEY_PROMISOR, false)) {
+			return FilterSpec.NO_FILTER;
+		}
+		return FilterSpec.fromFilterLine(filter);
+	}
+
 	private List<RefSpec> applyOptions(List<RefSpec> refSpecs2) {
 		if (!isForceUpdate()) {
 			return refSpecs2;
@@ -665,7 +696,48 @@ public FetchCommand setUnshallow(boolean unshallow) {
 		return this;
 	}
 
+	/**
+	 * Set the filter selecting the objects to fetch, like
+	 * {@code git fetch --filter}.
+	 * <p>
+	 * Objects omitted by the filter are fetched on demand from a promisor
+	 * remote when they are read. If no filter is set, fetching from a
+	 * promisor remote uses the filter configured by
+	 * {@code remote.<name>.partialclonefilter}.
+	 *
+	 * @param filter
+	 *            the filter; {@link FilterSpec#NO_FILTER} to fetch all
+	 *            objects
+	 * @return {@code this}
+	 * @since 6.9
+	 */
+	public FetchCommand setFilterSpec(@NonNull FilterSpec filter) {
+		this.filterSpec = filter;
+		return this;
+	}
+
+	/**
+	 * Set the algorithm used to find the commits common with the remote, like
+	 * {@code git fetch -c fetch.negotiationAlgorithm=<algorithm>}.
+	 *
+	 * @param algorithm
+	 *            the negotiation algorithm; null to use
+	 *            {@code fetch.negotiationAlgorithm} of the repository
+	 * @return {@code this}
+	 * @since 6.9
+	 */
+	public FetchCommand setNegotiationAlgorithm(
+			NegotiationAlgorithm algorithm) {
+		checkCallable();
+		this.negotiationAlgorithm = algorithm;
+		return this;
+	}
+
 	void setShallowExcludes(List<String> shallowExcludes) {
 		this.shallowExcludes = shallowExcludes;
 	}
+
+	void setUseBundleUri(Boolean useBundleUri) {
+		this.useBundleUri = useBundleUri;
+	}
 }
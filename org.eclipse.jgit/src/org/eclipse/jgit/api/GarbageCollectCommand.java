@@ -29,6 +29,7 @@
 import org.eclipse.jgit.lib.Repository;
 import org.eclipse.jgit.lib.StoredConfig;
 import org.eclipse.jgit.storage.pack.PackConfig;
+import org.eclipse.jgit.storage.pack.PackStatistics;
 
 /**
  * A class used to execute a {@code gc} command. It has setters for all
@@ -65,6 +66,8 @@ public class GarbageCollectCommand extends GitCommand<Properties> {
 
 	private Boolean packKeptObjects;
 
+	private Integer geometricFactor;
+
 	/**
 	 * Constructor for GarbageCollectCommand.
 	 *
@@ -146,6 +149,25 @@ public GarbageCollectCommand setPackKeptObjects(boolean packKeptObjects) {
 		return this;
 	}
 
+	/**
+	 * Keep the object counts of pack files in a geometric progression with
+	 * the given factor instead of repacking all objects, like
+	 * "git repack --geometric=&lt;factor&gt;". Only loose objects and the
+	 * smallest pack files breaking the progression are combined into a new
+	 * pack file. If not set the config parameter
+	 * {@code repack.geometricFactor} is used.
+	 *
+	 * @param factor
+	 *            factor of the geometric progression; 0 or 1 to repack all
+	 *            objects
+	 * @return this instance
+	 * @since 6.9
+	 */
+	public GarbageCollectCommand setGeometricFactor(int factor) {
+		this.geometricFactor = Integer.valueOf(factor);
+		return this;
+	}
+
 	/**
 	 * Whether to preserve old pack files instead of deleting them.
 	 *
@@ -192,9 +214,21 @@ public Properties call() throws GitAPIException {
 				if (this.packKeptObjects != null) {
 					gc.setPackKeptObjects(packKeptObjects.booleanValue());
 				}
+				if (this.geometricFactor != null) {
+					gc.setGeometricFactor(geometricFactor.intValue());
+				}
 				try {
 					gc.gc().get();
-					return toProperties(gc.getStatistics());
+					Properties p = toProperties(gc.getStatistics());
+					long rewritten = 0;
+					long reused = 0;
+					for (PackStatistics s : gc.getPackStatistics()) {
+						rewritten += s.getRewrittenPackBytes();
+						reused += s.getReusedPackBytes();
+					}
+					p.put("bytesRewritten", Long.valueOf(rewritten)); //$NON-NLS-1$
+					p.put("bytesReused", Long.valueOf(reused)); //$NON-NLS-1$
+					return p;
 				} catch (ParseException | InterruptedException
 						| ExecutionException e) {
 					throw new JGitInternalException(JGitText.get().gcFailed, e);
@@ -161,18 +161,13 @@ public void checkoutGitlink(DirCacheEntry entry, String gitPath)
 	 */
 	public void checkout(DirCacheEntry entry, CheckoutMetadata metadata,
 			ObjectReader reader, String gitPath) throws IOException {
-		if (metadata == null) {
-			metadata = CheckoutMetadata.EMPTY;
-		}
-		FS fs = cache.getRepository().getFS();
 		ObjectLoader ol = reader.open(entry.getObjectId());
 		String path = gitPath != null ? gitPath : entry.getPathString();
-		File f = new File(cache.getRepository().getWorkTree(), path);
-		File parentDir = f.getParentFile();
-		CacheItem cachedParent = cache.safeCreateDirectory(path, parentDir,
-				true);
-		if (entry.getFileMode() == FileMode.SYMLINK
-				&& options.getSymLinks() == SymLinks.TRUE) {
+		if (isSymLink(entry)) {
+			FS fs = cache.getRepository().getFS();
+			File f = new File(cache.getRepository().getWorkTree(), path);
+			CacheItem cachedParent = cache.safeCreateDirectory(path,
+					f.getParentFile(), true);
 			byte[] bytes = ol.getBytes();
 			String target = RawParseUtils.decode(bytes);
 			if (recursiveDelete && Files.isDirectory(f.toPath(),
@@ -185,7 +180,71 @@ public void checkout(DirCacheEntry entry, CheckoutMetadata metadata,
 			entry.setLastModified(fs.lastModifiedInstant(f));
 			return;
 		}
+		writeFile(entry, metadata, ol, path, prepareFile(path));
+	}
 
+	/**
+	 * Whether the entry is checked out as a symbolic link.
+	 *
+	 * @param entry
+	 *            entry to check out
+	 * @return {@code true} if the entry is a symbolic link and symbolic links
+	 *         are supported
+	 */
+	boolean isSymLink(DirCacheEntry entry) {
+		return entry.getFileMode() == FileMode.SYMLINK
+				&& options.getSymLinks() == SymLinks.TRUE;
+	}
+
+	/**
+	 * Prepare writing a regular file by creating its parent directory.
+	 * <p>
+	 * This updates the cached file modes, and must not be called concurrently.
+	 *
+	 * @param path
+	 *            git path of the file
+	 * @return the file in the working tree
+	 * @throws IOException
+	 *             if the parent directory cannot be created
+	 */
+	File prepareFile(String path) throws IOException {
+		File f = new File(cache.getRepository().getWorkTree(), path);
+		CacheItem cachedParent = cache.safeCreateDirectory(path,
+				f.getParentFile(), true);
+		// Whatever the cache knew about the file is outdated once it is
+		// written.
+		cachedParent.remove(f.getName());
+		return f;
+	}
+
+	/**
+	 * Write a regular file prepared by {@link #prepareFile(String)}.
+	 * <p>
+	 * This does not use the cached file modes, so different files may be
+	 * written concurrently.
+	 *
+	 * @param entry
+	 *            entry to check out, updated with the length and modification
+	 *            time of the file
+	 * @param metadata
+	 *            {@link CheckoutMetadata} to use for CR/LF handling and
+	 *            smudge filtering, or {@code null}
+	 * @param ol
+	 *            loader of the blob to write
+	 * @param path
+	 *            git path of the file
+	 * @param f
+	 *            the file in the working tree
+	 * @throws IOException
+	 *             if the file cannot be written
+	 */
+	void writeFile(DirCacheEntry entry, CheckoutMetadata metadata,
+			ObjectLoader ol, String path, File f) throws IOException {
+		if (metadata == null) {
+			metadata = CheckoutMetadata.EMPTY;
+		}
+		FS fs = cache.getRepository().getFS();
+		File parentDir = f.getParentFile();
 		String name = f.getName();
 		if (name.length() > 200) {
 			name = name.substring(0, 200);
@@ -222,7 +281,6 @@ public void checkout(DirCacheEntry entry, CheckoutMetadata metadata,
 				FileUtils.delete(f, FileUtils.RECURSIVE);
 			}
 			FileUtils.rename(tmpFile, f, StandardCopyOption.ATOMIC_MOVE);
-			cachedParent.remove(f.getName());
 		} catch (IOException e) {
 			throw new IOException(
 					MessageFormat.format(JGitText.get().renameFileFailed,
@@ -13,23 +13,47 @@
 package org.eclipse.jgit.dircache;
 
 import static java.nio.charset.StandardCharsets.ISO_8859_1;
+import static java.nio.charset.StandardCharsets.UTF_8;
 
 import java.io.BufferedInputStream;
 import java.io.BufferedOutputStream;
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
 import java.io.EOFException;
 import java.io.File;
 import java.io.FileNotFoundException;
+import java.io.FileOutputStream;
 import java.io.IOException;
 import java.io.InputStream;
+import java.io.InterruptedIOException;
 import java.io.OutputStream;
+import java.io.UncheckedIOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.file.StandardCopyOption;
 import java.security.DigestOutputStream;
 import java.security.MessageDigest;
 import java.text.MessageFormat;
+import java.text.ParseException;
 import java.time.Instant;
 import java.util.ArrayList;
 import java.util.Arrays;
+import java.util.BitSet;
+import java.util.Collection;
+import java.util.Collections;
 import java.util.Comparator;
+import java.util.Date;
+import java.util.IdentityHashMap;
 import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.function.Predicate;
 
 import org.eclipse.jgit.errors.CorruptObjectException;
 import org.eclipse.jgit.errors.IndexReadException;
@@ -55,12 +79,21 @@
 import org.eclipse.jgit.treewalk.TreeWalk.OperationType;
 import org.eclipse.jgit.treewalk.filter.PathFilterGroup;
 import org.eclipse.jgit.util.FS;
+import org.eclipse.jgit.util.FileUtils;
+import org.eclipse.jgit.util.GitDateParser;
 import org.eclipse.jgit.util.IO;
 import org.eclipse.jgit.util.MutableInteger;
 import org.eclipse.jgit.util.NB;
+import org.eclipse.jgit.util.RawParseUtils;
+import org.eclipse.jgit.util.StringUtils;
+import org.eclipse.jgit.util.SystemReader;
 import org.eclipse.jgit.util.TemporaryBuffer;
+import org.eclipse.jgit.util.io.CountingOutputStream;
 import org.eclipse.jgit.util.io.SilentFileInputStream;
 
+import com.googlecode.javaewah.EWAHCompressedBitmap;
+import com.googlecode.javaewah.IntIterator;
+
 /**
  * Support for the Git dircache (aka index file).
  * <p>
@@ -79,6 +112,36 @@ public class DirCache {
 
 	private static final int EXT_TREE = 0x54524545 /* 'TREE' */;
 
+	private static final int EXT_EOIE = 0x454f4945 /* 'EOIE' */;
+
+	private static final int EXT_IEOT = 0x49454f54 /* 'IEOT' */;
+
+	private static final int EXT_UNTR = 0x554e5452 /* 'UNTR' */;
+
+	private static final int EXT_FSMN = 0x46534d4e /* 'FSMN' */;
+
+	/** Version of the 'FSMN' extension storing an opaque token. */
+	private static final int FSMN_VERSION = 2;
+
+	private static final int EXT_LINK = 0x6c696e6b /* 'link' */;
+
+	private static final int EXT_SDIR = 0x73646972 /* 'sdir' */;
+
+	/** Prefix of the file names of shared indexes of split indexes. */
+	private static final String SHARED_INDEX_PREFIX = "sharedindex."; //$NON-NLS-1$
+
+	private static final int DEFAULT_MAX_PERCENT_CHANGE = 20;
+
+	private static final String DEFAULT_SHARED_INDEX_EXPIRE = "2.weeks.ago"; //$NON-NLS-1$
+
+	/** Size of the 'EOIE' extension: entries end offset and header hash. */
+	private static final int EOIE_SIZE = 4 + Constants.OBJECT_ID_LENGTH;
+
+	private static final int IEOT_VERSION = 1;
+
+	/** Minimum number of entries worth a block of the offset table. */
+	private static final int THREAD_COST = 10000;
+
 	private static final DirCacheEntry[] NO_ENTRIES = {};
 
 	private static final byte[] NO_CHECKSUM = {};
@@ -307,6 +370,53 @@ public static DirCache lock(final File indexLocation, final FS fs,
 	/** Cache tree for this index; null if the cache tree is not available. */
 	private DirCacheTree tree;
 
+	/**
+	 * Optional extensions not understood by JGit, including their header.
+	 * They are written back as long as the entries are not replaced.
+	 */
+	private List<byte[]> unknownExtensions = Collections.emptyList();
+
+	/** Untracked cache; null if the index has none. */
+	private UntrackedCache untrackedCache;
+
+	/**
+	 * Token of the file system monitor the entries flagged as valid by the
+	 * monitor are valid for; null if the index has none.
+	 */
+	private String fsMonitorToken;
+
+	/**
+	 * Positions of the entries not valid for {@link #fsMonitorToken}, while
+	 * reading the index.
+	 */
+	private EWAHCompressedBitmap fsMonitorDirty;
+
+	/**
+	 * Entries the index file stored as valid for {@link #fsMonitorToken}.
+	 * They are only flagged as valid by {@link #refreshFsMonitor(FsMonitor)},
+	 * after the monitor confirmed the token; null once applied.
+	 */
+	private DirCacheEntry[] fsMonitorStored;
+
+	/**
+	 * Sparse directories expanded since the index was read, by the first
+	 * entry of their tree. Collapsing the same entries again reuses the
+	 * directory entry instead of writing its tree.
+	 */
+	private final Map<DirCacheEntry, SparseExpansion> expansions = new IdentityHashMap<>();
+
+	/**
+	 * Entries of the shared index this index is split from, by position;
+	 * null if the index is not split.
+	 */
+	private DirCacheEntry[] sharedEntries;
+
+	/** Checksum of the shared index, naming its file. */
+	private ObjectId sharedIndexId;
+
+	/** The 'link' extension, while reading the index. */
+	private byte[] link;
+
 	/** Our active lock (if we hold it); null if we don't have it locked. */
 	private LockFile myLock;
 
@@ -379,9 +489,42 @@ DirCacheVersion getVersion() {
 	}
 
 	void replace(DirCacheEntry[] e, int cnt) {
+		if (untrackedCache != null) {
+			invalidateUntrackedCache(e, cnt);
+		}
 		sortedEntries = e;
 		entryCnt = cnt;
 		tree = null;
+		unknownExtensions = Collections.emptyList();
+	}
+
+	/**
+	 * Invalidate the untracked cache for all paths which are added to or
+	 * removed from the index.
+	 */
+	private void invalidateUntrackedCache(DirCacheEntry[] e, int cnt) {
+		int i = 0;
+		int j = 0;
+		while (i < entryCnt || j < cnt) {
+			int cmp;
+			if (i == entryCnt) {
+				cmp = 1;
+			} else if (j == cnt) {
+				cmp = -1;
+			} else {
+				byte[] a = sortedEntries[i].path;
+				byte[] b = e[j].path;
+				cmp = cmp(a, a.length, b, b.length);
+			}
+			if (cmp < 0) {
+				untrackedCache.invalidate(sortedEntries[i++].path);
+			} else if (cmp > 0) {
+				untrackedCache.invalidate(e[j++].path);
+			} else {
+				i++;
+				j++;
+			}
+		}
 	}
 
 	/**
@@ -407,7 +550,11 @@ else if (snapshot == null || snapshot.isModified(liveFile)) {
 			try (SilentFileInputStream inStream = new SilentFileInputStream(
 					liveFile)) {
 				clear();
-				readFrom(inStream);
+				if (!readWithOffsetTable(inStream.getChannel())) {
+					readFrom(inStream);
+				}
+				mergeSharedIndex();
+				applyFsMonitorDirty();
 			} catch (FileNotFoundException fnfe) {
 				if (liveFile.exists()) {
 					// Panic: the index file exists but we can't read it
@@ -445,6 +592,15 @@ public void clear() {
 		sortedEntries = NO_ENTRIES;
 		entryCnt = 0;
 		tree = null;
+		unknownExtensions = Collections.emptyList();
+		untrackedCache = null;
+		fsMonitorToken = null;
+		fsMonitorDirty = null;
+		fsMonitorStored = null;
+		expansions.clear();
+		sharedEntries = null;
+		sharedIndexId = null;
+		link = null;
 		readIndexChecksum = NO_CHECKSUM;
 	}
 
@@ -459,31 +615,7 @@ private void readFrom(InputStream inStream) throws IOException,
 		final byte[] hdr = new byte[20];
 		IO.readFully(in, hdr, 0, 12);
 		md.update(hdr, 0, 12);
-		if (!is_DIRC(hdr))
-			throw new CorruptObjectException(JGitText.get().notADIRCFile);
-		int versionCode = NB.decodeInt32(hdr, 4);
-		DirCacheVersion ver = DirCacheVersion.fromInt(versionCode);
-		if (ver == null) {
-			throw new CorruptObjectException(
-					MessageFormat.format(JGitText.get().unknownDIRCVersion,
-							Integer.valueOf(versionCode)));
-		}
-		boolean extended = false;
-		switch (ver) {
-		case DIRC_VERSION_MINIMUM:
-			break;
-		case DIRC_VERSION_EXTENDED:
-		case DIRC_VERSION_PATHCOMPRESS:
-			extended = true;
-			break;
-		default:
-			throw new CorruptObjectException(MessageFormat
-					.format(JGitText.get().unknownDIRCVersion, ver));
-		}
-		version = ver;
-		entryCnt = NB.decodeInt32(hdr, 8);
-		if (entryCnt < 0)
-			throw new CorruptObjectException(JGitText.get().DIRCHasTooManyEntries);
+		boolean extended = readHeader(hdr);
 
 		snapshot = FileSnapshot.save(liveFile);
 		Instant smudge = snapshot.lastModifiedInstant();
@@ -517,34 +649,27 @@ private void readFrom(InputStream inStream) throws IOException,
 
 			long sz = NB.decodeUInt32(hdr, 4);
 			switch (NB.decodeInt32(hdr, 0)) {
-			case EXT_TREE: {
-				if (Integer.MAX_VALUE < sz) {
-					throw new CorruptObjectException(MessageFormat.format(
-							JGitText.get().DIRCExtensionIsTooLargeAt,
-							formatExtensionName(hdr), Long.valueOf(sz)));
-				}
-				final byte[] raw = new byte[(int) sz];
-				IO.readFully(in, raw, 0, raw.length);
-				md.update(raw, 0, raw.length);
-				tree = new DirCacheTree(raw, new MutableInteger(), null);
+			case EXT_EOIE:
+			case EXT_IEOT:
+				// Only used to read the entries in parallel, and
+				// recomputed when the index is written.
+				skipOptionalExtension(in, md, hdr, sz);
 				break;
-			}
 			default:
-				if (hdr[0] >= 'A' && hdr[0] <= 'Z') {
-					// The extension is optional and is here only as
-					// a performance optimization. Since we do not
-					// understand it, we can safely skip past it, after
-					// we include its data in our checksum.
-					//
+				if (Integer.MAX_VALUE - 8 < sz) {
+					if (!isOptionalExtension(hdr)) {
+						throw new CorruptObjectException(MessageFormat.format(
+								JGitText.get().DIRCExtensionIsTooLargeAt,
+								formatExtensionName(hdr), Long.valueOf(sz)));
+					}
 					skipOptionalExtension(in, md, hdr, sz);
-				} else {
-					// The extension is not an optimization and is
-					// _required_ to understand this index format.
-					// Since we did not trap it above we must abort.
-					//
-					throw new CorruptObjectException(MessageFormat.format(JGitText.get().DIRCExtensionNotSupportedByThisVersion
-							, formatExtensionName(hdr)));
+					break;
 				}
+				final byte[] raw = new byte[8 + (int) sz];
+				System.arraycopy(hdr, 0, raw, 0, 8);
+				IO.readFully(in, raw, 8, (int) sz);
+				md.update(raw, 8, (int) sz);
+				readExtension(raw);
 			}
 		}
 
@@ -558,6 +683,521 @@ private void readFrom(InputStream inStream) throws IOException,
 		}
 	}
 
+	/**
+	 * Read the index entries on several threads, using the offsets recorded
+	 * in the 'IEOT' extension.
+	 * <p>
+	 * The extension is only trusted if the 'EOIE' extension at the end of
+	 * the file validates the extension headers it was written with. If the
+	 * index does not carry both extensions, or is too small to be worth
+	 * splitting, nothing is read and the caller has to fall back to reading
+	 * the index sequentially.
+	 *
+	 * @param fc
+	 *            channel of the index file, only accessed at explicit
+	 *            positions
+	 * @return {@code true} if the index was read; {@code false} if the index
+	 *         has to be read sequentially
+	 * @throws IOException
+	 *             the index file could not be read or is corrupt
+	 */
+	private boolean readWithOffsetTable(FileChannel fc) throws IOException {
+		readConfig();
+		int threads = getThreads();
+		if (threads < 2) {
+			return false;
+		}
+
+		// The 'EOIE' extension is the last one, before the checksum.
+		//
+		long size = fc.size();
+		long eoieAt = size - Constants.OBJECT_ID_LENGTH - 8 - EOIE_SIZE;
+		if (eoieAt < 12) {
+			return false;
+		}
+		byte[] eoie = new byte[8 + EOIE_SIZE];
+		readFully(fc, eoieAt, eoie);
+		if (NB.decodeInt32(eoie, 0) != EXT_EOIE
+				|| NB.decodeInt32(eoie, 4) != EOIE_SIZE) {
+			return false;
+		}
+		long extStart = NB.decodeUInt32(eoie, 8);
+		if (extStart < 12 || extStart > eoieAt
+				|| eoieAt - extStart > Integer.MAX_VALUE) {
+			return false;
+		}
+
+		byte[] ext = new byte[(int) (eoieAt - extStart)];
+		readFully(fc, extStart, ext);
+		MessageDigest headers = Constants.newMessageDigest();
+		List<byte[]> extensions = new ArrayList<>();
+		byte[] ieot = null;
+		for (int ptr = 0; ptr < ext.length;) {
+			if (ext.length - ptr < 8) {
+				return false;
+			}
+			long sz = NB.decodeUInt32(ext, ptr + 4);
+			if (sz > ext.length - ptr - 8) {
+				return false;
+			}
+			headers.update(ext, ptr, 8);
+			int end = ptr + 8 + (int) sz;
+			if (NB.decodeInt32(ext, ptr) == EXT_IEOT) {
+				ieot = Arrays.copyOfRange(ext, ptr + 8, end);
+			} else {
+				extensions.add(Arrays.copyOfRange(ext, ptr, end));
+			}
+			ptr = end;
+		}
+		if (!Arrays.equals(headers.digest(),
+				Arrays.copyOfRange(eoie, 12, eoie.length))) {
+			return false;
+		}
+		if (ieot == null || ieot.length < 4
+				|| NB.decodeInt32(ieot, 0) != IEOT_VERSION
+				|| (ieot.length - 4) % 8 != 0) {
+			return false;
+		}
+		int blockCnt = (ieot.length - 4) / 8;
+		if (blockCnt < 2) {
+			return false;
+		}
+
+		final byte[] hdr = new byte[12];
+		readFully(fc, 0, hdr);
+		boolean extended = readHeader(hdr);
+
+		// Only use the table if it exactly covers the entries.
+		//
+		long[] offsets = new long[blockCnt + 1];
+		int[] starts = new int[blockCnt + 1];
+		for (int i = 0; i < blockCnt; i++) {
+			offsets[i] = NB.decodeUInt32(ieot, 4 + 8 * i);
+			long cnt = NB.decodeUInt32(ieot, 8 + 8 * i);
+			if (cnt == 0 || cnt > entryCnt - starts[i]) {
+				return false;
+			}
+			starts[i + 1] = starts[i] + (int) cnt;
+		}
+		offsets[blockCnt] = extStart;
+		if (offsets[0] != 12 || starts[blockCnt] != entryCnt) {
+			return false;
+		}
+		for (int i = 0; i < blockCnt; i++) {
+			long len = offsets[i + 1] - offsets[i];
+			if (len <= 0 || len > Integer.MAX_VALUE) {
+				return false;
+			}
+		}
+
+		snapshot = FileSnapshot.save(liveFile);
+		Instant smudge = snapshot.lastModifiedInstant();
+		sortedEntries = new DirCacheEntry[entryCnt];
+
+		ExecutorService pool = Executors
+				.newFixedThreadPool(Math.min(threads, blockCnt + 1));
+		try {
+			List<Future<?>> futures = new ArrayList<>(blockCnt + 1);
+			Future<byte[]> checksum = null;
+			if (!skipHash) {
+				checksum = pool.submit(() -> {
+					return digest(fc, size - Constants.OBJECT_ID_LENGTH);
+				});
+				futures.add(checksum);
+			}
+			for (int i = 0; i < blockCnt; i++) {
+				long offset = offsets[i];
+				int len = (int) (offsets[i + 1] - offset);
+				int first = starts[i];
+				int cnt = starts[i + 1] - first;
+				futures.add(pool.submit(() -> {
+					readEntries(fc, offset, len, first, cnt, extended,
+							smudge);
+					return null;
+				}));
+			}
+
+			for (byte[] raw : extensions) {
+				if (NB.decodeInt32(raw, 0) != EXT_EOIE) {
+					readExtension(raw);
+				}
+			}
+
+			for (Future<?> f : futures) {
+				join(f);
+			}
+
+			byte[] trailer = new byte[Constants.OBJECT_ID_LENGTH];
+			readFully(fc, size - trailer.length, trailer);
+			readIndexChecksum = checksum != null ? join(checksum)
+					: NullMessageDigest.getInstance().digest();
+			if (!(skipHash
+					|| Arrays.equals(readIndexChecksum, trailer)
+					|| Arrays.equals(NullMessageDigest.getInstance().digest(),
+							trailer))) {
+				throw new CorruptObjectException(
+						JGitText.get().DIRCChecksumMismatch);
+			}
+		} catch (InterruptedException e) {
+			throw new InterruptedIOException();
+		} finally {
+			pool.shutdownNow();
+		}
+		return true;
+	}
+
+	/**
+	 * Parse the 'FSMN' extension. The entries it refers to may still be
+	 * read in parallel, they are recorded by {@link #applyFsMonitorDirty()}.
+	 * <p>
+	 * An extension which cannot be used only costs the checks it would have
+	 * avoided, and is dropped.
+	 */
+	private void readFsMonitor(byte[] raw) {
+		if (raw.length < 12 || NB.decodeInt32(raw, 8) != FSMN_VERSION) {
+			return;
+		}
+		int nul = RawParseUtils.next(raw, 12, '\0') - 1;
+		if (raw[nul] != 0 || raw.length - (nul + 5) < 0) {
+			return;
+		}
+		int size = NB.decodeInt32(raw, nul + 1);
+		if (size < 0 || size > raw.length - (nul + 5)) {
+			return;
+		}
+		EWAHCompressedBitmap dirty = new EWAHCompressedBitmap();
+		try {
+			dirty.deserialize(new DataInputStream(
+					new ByteArrayInputStream(raw, nul + 5, size)));
+		} catch (IOException | RuntimeException e) {
+			return;
+		}
+		fsMonitorToken = RawParseUtils.decode(UTF_8, raw, 12, nul);
+		fsMonitorDirty = dirty;
+	}
+
+	/**
+	 * Merge the entries read from a split index with the entries of its
+	 * shared index, as described by the 'link' extension.
+	 * <p>
+	 * The entries of the split index start with the entries replacing
+	 * entries of the shared index, which have no name, followed by the
+	 * added entries.
+	 */
+	private void mergeSharedIndex() throws IOException {
+		byte[] raw = link;
+		link = null;
+		if (raw == null) {
+			for (int i = 0; i < entryCnt; i++) {
+				if (sortedEntries[i].path.length == 0) {
+					throw new CorruptObjectException(
+							JGitText.get().DIRCEntryWithoutName);
+				}
+			}
+			return;
+		}
+
+		int ptr = 8 + Constants.OBJECT_ID_LENGTH;
+		if (raw.length < ptr) {
+			throw new CorruptObjectException(
+					JGitText.get().DIRCCorruptLinkExtension);
+		}
+		ObjectId id = ObjectId.fromRaw(raw, 8);
+		EWAHCompressedBitmap delete = new EWAHCompressedBitmap();
+		EWAHCompressedBitmap replace = new EWAHCompressedBitmap();
+		if (ptr < raw.length) {
+			int rest;
+			try {
+				DataInputStream in = new DataInputStream(
+						new ByteArrayInputStream(raw, ptr, raw.length - ptr));
+				delete.deserialize(in);
+				replace.deserialize(in);
+				rest = in.available();
+			} catch (IOException | RuntimeException e) {
+				rest = -1;
+			}
+			if (rest != 0) {
+				throw new CorruptObjectException(
+						JGitText.get().DIRCCorruptLinkExtension);
+			}
+		}
+
+		File file = new File(liveFile.getParentFile(),
+				SHARED_INDEX_PREFIX + id.name());
+		if (!file.isFile()) {
+			throw new IndexReadException(MessageFormat.format(
+					JGitText.get().DIRCMissingSharedIndex,
+					file.getAbsolutePath()));
+		}
+		DirCache shared = new DirCache(file, null);
+		shared.read();
+		if (shared.sharedIndexId != null
+				|| !id.equals(ObjectId.fromRaw(shared.readIndexChecksum))) {
+			throw new CorruptObjectException(MessageFormat.format(
+					JGitText.get().DIRCCorruptSharedIndex,
+					file.getAbsolutePath()));
+		}
+
+		DirCacheEntry[] base = Arrays.copyOf(shared.sortedEntries,
+				shared.entryCnt);
+		DirCacheEntry[] merged = base.clone();
+		for (int i = 0; i < base.length; i++) {
+			base[i].basePosition = i + 1;
+		}
+		int r = 0;
+		for (IntIterator i = replace.intIterator(); i.hasNext();) {
+			int pos = i.next();
+			if (pos >= base.length || r >= entryCnt
+					|| sortedEntries[r].path.length != 0) {
+				throw new CorruptObjectException(
+						JGitText.get().DIRCCorruptLinkExtension);
+			}
+			DirCacheEntry e = new DirCacheEntry(base[pos].path,
+					sortedEntries[r++]);
+			e.basePosition = pos + 1;
+			merged[pos] = e;
+		}
+		int deleted = 0;
+		for (IntIterator i = delete.intIterator(); i.hasNext();) {
+			int pos = i.next();
+			if (pos >= base.length || merged[pos] != base[pos]) {
+				throw new CorruptObjectException(
+						JGitText.get().DIRCCorruptLinkExtension);
+			}
+			merged[pos] = null;
+			deleted++;
+		}
+
+		// The added entries are sorted, and replace entries of the
+		// shared index with the same path and stage.
+		DirCacheEntry[] result = new DirCacheEntry[base.length - deleted
+				+ entryCnt - r];
+		int n = 0;
+		int b = 0;
+		for (;;) {
+			while (b < merged.length && merged[b] == null) {
+				b++;
+			}
+			if (b == merged.length && r == entryCnt) {
+				break;
+			}
+			if (r < entryCnt && sortedEntries[r].path.length == 0) {
+				throw new CorruptObjectException(
+						JGitText.get().DIRCCorruptLinkExtension);
+			}
+			int cmp;
+			if (b == merged.length) {
+				cmp = 1;
+			} else if (r == entryCnt) {
+				cmp = -1;
+			} else {
+				cmp = cmp(merged[b], sortedEntries[r]);
+				if (cmp == 0) {
+					cmp = merged[b].getStage() - sortedEntries[r].getStage();
+				}
+			}
+			if (cmp < 0) {
+				result[n++] = merged[b++];
+			} else {
+				if (cmp == 0) {
+					b++;
+				}
+				result[n++] = sortedEntries[r++];
+			}
+		}
+		sortedEntries = result;
+		entryCnt = n;
+		sharedEntries = base;
+		sharedIndexId = id;
+	}
+
+	private void applyFsMonitorDirty() {
+		EWAHCompressedBitmap dirty = fsMonitorDirty;
+		fsMonitorDirty = null;
+		if (dirty == null) {
+			return;
+		}
+		if (dirty.sizeInBits() > entryCnt) {
+			fsMonitorToken = null;
+			return;
+		}
+		// Without asking the monitor the entries cannot be trusted; only
+		// remember which ones were valid.
+		List<DirCacheEntry> valid = new ArrayList<>(entryCnt);
+		IntIterator i = dirty.intIterator();
+		int d = i.hasNext() ? i.next() : -1;
+		for (int p = 0; p < entryCnt; p++) {
+			if (p == d) {
+				d = i.hasNext() ? i.next() : -1;
+			} else {
+				valid.add(sortedEntries[p]);
+			}
+		}
+		fsMonitorStored = valid.toArray(new DirCacheEntry[0]);
+	}
+
+	private static <T> T join(Future<T> f)
+			throws IOException, InterruptedException {
+		try {
+			return f.get();
+		} catch (ExecutionException e) {
+			Throwable err = e.getCause();
+			if (err instanceof IOException) {
+				throw (IOException) err;
+			}
+			if (err instanceof RuntimeException) {
+				throw (RuntimeException) err;
+			}
+			if (err instanceof Error) {
+				throw (Error) err;
+			}
+			throw new IOException(err.getMessage(), err);
+		}
+	}
+
+	private void readEntries(FileChannel fc, long offset, int len, int first,
+			int cnt, boolean extended, Instant smudge) throws IOException {
+		byte[] buf = new byte[len];
+		readFully(fc, offset, buf);
+		InputStream in = new ByteArrayInputStream(buf);
+		MessageDigest md = NullMessageDigest.getInstance();
+		byte[] infos = new byte[DirCacheEntry.getMaximumInfoLength(extended)
+				* cnt];
+		MutableInteger infoAt = new MutableInteger();
+		DirCacheEntry previous = null;
+		for (int i = first; i < first + cnt; i++) {
+			previous = new DirCacheEntry(infos, infoAt, in, md, smudge,
+					version, previous);
+			sortedEntries[i] = previous;
+		}
+		if (in.available() != 0) {
+			throw new CorruptObjectException(MessageFormat.format(
+					JGitText.get().DIRCOffsetTableMismatch,
+					Long.valueOf(offset)));
+		}
+	}
+
+	private static byte[] digest(FileChannel fc, long len) throws IOException {
+		MessageDigest md = Constants.newMessageDigest();
+		ByteBuffer buf = ByteBuffer.allocate(64 * 1024);
+		for (long pos = 0; pos < len;) {
+			buf.clear();
+			if (len - pos < buf.capacity()) {
+				buf.limit((int) (len - pos));
+			}
+			int n = fc.read(buf, pos);
+			if (n < 0) {
+				throw new EOFException();
+			}
+			md.update(buf.array(), 0, n);
+			pos += n;
+		}
+		return md.digest();
+	}
+
+	private static void readFully(FileChannel fc, long pos, byte[] dst)
+			throws IOException {
+		ByteBuffer buf = ByteBuffer.wrap(dst);
+		while (buf.hasRemaining()) {
+			if (fc.read(buf, pos + buf.position()) < 0) {
+				throw new EOFException();
+			}
+		}
+	}
+
+	/**
+	 * Parse the header of the index file.
+	 *
+	 * @param hdr
+	 *            the first 12 bytes of the index file
+	 * @return whether the entries may use extended flags
+	 * @throws CorruptObjectException
+	 *             the header is not valid
+	 */
+	private boolean readHeader(byte[] hdr) throws CorruptObjectException {
+		if (!is_DIRC(hdr))
+			throw new CorruptObjectException(JGitText.get().notADIRCFile);
+		int versionCode = NB.decodeInt32(hdr, 4);
+		DirCacheVersion ver = DirCacheVersion.fromInt(versionCode);
+		if (ver == null) {
+			throw new CorruptObjectException(
+					MessageFormat.format(JGitText.get().unknownDIRCVersion,
+							Integer.valueOf(versionCode)));
+		}
+		boolean extended = false;
+		switch (ver) {
+		case DIRC_VERSION_MINIMUM:
+			break;
+		case DIRC_VERSION_EXTENDED:
+		case DIRC_VERSION_PATHCOMPRESS:
+			extended = true;
+			break;
+		default:
+			throw new CorruptObjectException(MessageFormat
+					.format(JGitText.get().unknownDIRCVersion, ver));
+		}
+		version = ver;
+		entryCnt = NB.decodeInt32(hdr, 8);
+		if (entryCnt < 0)
+			throw new CorruptObjectException(JGitText.get().DIRCHasTooManyEntries);
+		return extended;
+	}
+
+	/**
+	 * Parse an extension other than 'EOIE' and 'IEOT'.
+	 *
+	 * @param raw
+	 *            the extension, starting with its 8 byte header
+	 * @throws CorruptObjectException
+	 *             the extension is required but not supported
+	 */
+	private void readExtension(byte[] raw) throws CorruptObjectException {
+		switch (NB.decodeInt32(raw, 0)) {
+		case EXT_TREE: {
+			MutableInteger ptr = new MutableInteger();
+			ptr.value = 8;
+			tree = new DirCacheTree(raw, ptr, null);
+			break;
+		}
+		case EXT_UNTR:
+			untrackedCache = UntrackedCache.parse(raw, 8, raw.length,
+					snapshot.lastModifiedInstant());
+			break;
+		case EXT_FSMN:
+			readFsMonitor(raw);
+			break;
+		case EXT_LINK:
+			link = raw;
+			break;
+		case EXT_SDIR:
+			// Only marks the index as sparse, sparse directory entries are
+			// recognized by their mode.
+			break;
+		default:
+			if (isOptionalExtension(raw)) {
+				// The extension is optional and is here only as
+				// a performance optimization. Since we do not
+				// understand it, we keep it to write it back.
+				//
+				if (unknownExtensions.isEmpty()) {
+					unknownExtensions = new ArrayList<>(2);
+				}
+				unknownExtensions.add(raw);
+			} else {
+				// The extension is not an optimization and is
+				// _required_ to understand this index format.
+				// Since we did not trap it above we must abort.
+				//
+				throw new CorruptObjectException(MessageFormat.format(JGitText.get().DIRCExtensionNotSupportedByThisVersion
+						, formatExtensionName(raw)));
+			}
+		}
+	}
+
+	private static boolean isOptionalExtension(byte[] hdr) {
+		return hdr[0] >= 'A' && hdr[0] <= 'Z';
+	}
+
 	private void skipOptionalExtension(final InputStream in,
 			final MessageDigest md, final byte[] hdr, long sz)
 			throws IOException {
@@ -629,6 +1269,9 @@ public void write() throws IOException {
 		requireLocked(tmp);
 		try (OutputStream o = tmp.getOutputStream();
 				OutputStream bo = new BufferedOutputStream(o)) {
+			if (repository != null) {
+				updateSparseIndex();
+			}
 			writeTo(liveFile.getParentFile(), bo);
 		} catch (IOException | RuntimeException | Error err) {
 			tmp.unlock();
@@ -639,7 +1282,8 @@ public void write() throws IOException {
 	void writeTo(File dir, OutputStream os) throws IOException {
 		readConfig();
 		MessageDigest foot = newMessageDigest();
-		DigestOutputStream dos = new DigestOutputStream(os, foot);
+		CountingOutputStream cnt = new CountingOutputStream(os);
+		DigestOutputStream dos = new DigestOutputStream(cnt, foot);
 		if (version == null
 				|| version == DirCacheVersion.DIRC_VERSION_MINIMUM) {
 			version = DirCacheVersion.DIRC_VERSION_MINIMUM;
@@ -651,16 +1295,6 @@ void writeTo(File dir, OutputStream os) throws IOException {
 			}
 		}
 
-		// Write the header.
-		//
-		final byte[] tmp = new byte[128];
-		System.arraycopy(SIG_DIRC, 0, tmp, 0, SIG_DIRC.length);
-		NB.encodeInt32(tmp, 4, version.getVersionCode());
-		NB.encodeInt32(tmp, 8, entryCnt);
-		dos.write(tmp, 0, 12);
-
-		// Write the individual file entries.
-
 		Instant smudge;
 		if (myLock != null) {
 			// For new files we need to smudge the index entry
@@ -687,7 +1321,85 @@ void writeTo(File dir, OutputStream os) throws IOException {
 			if (e.mightBeRacilyClean(smudge)) {
 				e.smudgeRacilyClean();
 			}
-			e.write(dos, version, i == 0 ? null : sortedEntries[i - 1]);
+		}
+
+		// A split index only stores the entries which differ from its
+		// shared index.
+		//
+		DirCacheConfig config = getConfig();
+		DirCacheEntry[] entries = sortedEntries;
+		int count = entryCnt;
+		byte[] linkExt = null;
+		if (config != null ? config.isSplitIndex(sharedEntries != null)
+				: sharedEntries != null) {
+			SplitIndexWriter split = new SplitIndexWriter(dir, config);
+			entries = split.entries;
+			count = split.count;
+			linkExt = split.link;
+		} else {
+			sharedEntries = null;
+			sharedIndexId = null;
+		}
+
+		// Write the header.
+		//
+		final byte[] tmp = new byte[128];
+		System.arraycopy(SIG_DIRC, 0, tmp, 0, SIG_DIRC.length);
+		NB.encodeInt32(tmp, 4, version.getVersionCode());
+		NB.encodeInt32(tmp, 8, count);
+		dos.write(tmp, 0, 12);
+
+		// Split the entries into blocks that can be read in parallel.
+		//
+		int blockEntries = count;
+		int blockCnt = 1;
+		if (config != null && config.isRecordOffsetTable()
+				&& config.isRecordEndOfIndexEntries()) {
+			int threads = getThreads();
+			blockCnt = Math.min(threads,
+					(count + THREAD_COST - 1) / THREAD_COST);
+			if (blockCnt > 1) {
+				blockEntries = (count + blockCnt - 1) / blockCnt;
+				blockCnt = (count + blockEntries - 1) / blockEntries;
+			}
+		}
+		long[] blockOffsets = new long[Math.max(blockCnt, 1)];
+
+		// Write the individual file entries.
+		//
+		for (int i = 0; i < count; i++) {
+			boolean blockStart = i % blockEntries == 0;
+			if (blockStart) {
+				blockOffsets[i / blockEntries] = cnt.getCount();
+			}
+			entries[i].write(dos, version, i == 0 ? null : entries[i - 1],
+					blockStart);
+		}
+
+		// Extensions, in the order C Git writes them.
+		//
+		long extStart = cnt.getCount();
+		MessageDigest headers = Constants.newMessageDigest();
+		if (blockCnt > 1 && extStart <= 0xffffffffL) {
+			byte[] ieot = new byte[8 + 4 + 8 * blockCnt];
+			NB.encodeInt32(ieot, 0, EXT_IEOT);
+			NB.encodeInt32(ieot, 4, ieot.length - 8);
+			NB.encodeInt32(ieot, 8, IEOT_VERSION);
+			for (int b = 0; b < blockCnt; b++) {
+				NB.encodeInt32(ieot, 12 + 8 * b, (int) blockOffsets[b]);
+				NB.encodeInt32(ieot, 16 + 8 * b,
+						Math.min(blockEntries, count - b * blockEntries));
+			}
+			headers.update(ieot, 0, 8);
+			dos.write(ieot);
+		}
+
+		if (linkExt != null) {
+			NB.encodeInt32(tmp, 0, EXT_LINK);
+			NB.encodeInt32(tmp, 4, linkExt.length);
+			headers.update(tmp, 0, 8);
+			dos.write(tmp, 0, 8);
+			dos.write(linkExt);
 		}
 
 		if (writeTree) {
@@ -700,17 +1412,90 @@ void writeTo(File dir, OutputStream os) throws IOException {
 
 				NB.encodeInt32(tmp, 0, EXT_TREE);
 				NB.encodeInt32(tmp, 4, (int) bb.length());
+				headers.update(tmp, 0, 8);
 				dos.write(tmp, 0, 8);
 				bb.writeTo(dos, null);
 			} finally {
 				bb.destroy();
 			}
 		}
+
+		if (untrackedCache != null) {
+			ByteArrayOutputStream untr = new ByteArrayOutputStream();
+			untrackedCache.write(untr);
+			NB.encodeInt32(tmp, 0, EXT_UNTR);
+			NB.encodeInt32(tmp, 4, untr.size());
+			headers.update(tmp, 0, 8);
+			dos.write(tmp, 0, 8);
+			untr.writeTo(dos);
+		}
+
+		if (fsMonitorToken != null
+				&& (repository == null || FsMonitor.isEnabled(repository))) {
+			ByteArrayOutputStream fsmn = new ByteArrayOutputStream();
+			writeFsMonitor(fsmn);
+			NB.encodeInt32(tmp, 0, EXT_FSMN);
+			NB.encodeInt32(tmp, 4, fsmn.size());
+			headers.update(tmp, 0, 8);
+			dos.write(tmp, 0, 8);
+			fsmn.writeTo(dos);
+		}
+
+		if (hasSparseDirectories()) {
+			NB.encodeInt32(tmp, 0, EXT_SDIR);
+			NB.encodeInt32(tmp, 4, 0);
+			headers.update(tmp, 0, 8);
+			dos.write(tmp, 0, 8);
+		}
+
+		for (byte[] raw : unknownExtensions) {
+			headers.update(raw, 0, 8);
+			dos.write(raw);
+		}
+
+		if (config != null && config.isRecordEndOfIndexEntries()
+				&& extStart <= 0xffffffffL) {
+			NB.encodeInt32(tmp, 0, EXT_EOIE);
+			NB.encodeInt32(tmp, 4, EOIE_SIZE);
+			NB.encodeInt32(tmp, 8, (int) extStart);
+			headers.digest(tmp, 12, Constants.OBJECT_ID_LENGTH);
+			dos.write(tmp, 0, 8 + EOIE_SIZE);
+		}
 		writeIndexChecksum = foot.digest();
 		os.write(writeIndexChecksum);
 		os.close();
 	}
 
+	private void writeFsMonitor(OutputStream out) throws IOException {
+		// Entries stored as valid are still valid for the unchanged token,
+		// even if the monitor was not asked.
+		Set<DirCacheEntry> stored = Collections
+				.newSetFromMap(new IdentityHashMap<>());
+		if (fsMonitorStored != null) {
+			stored.addAll(Arrays.asList(fsMonitorStored));
+		}
+		EWAHCompressedBitmap dirty = new EWAHCompressedBitmap();
+		for (int i = 0; i < entryCnt; i++) {
+			DirCacheEntry e = sortedEntries[i];
+			if (!e.isFsMonitorValid() && !stored.contains(e)) {
+				dirty.set(i);
+			}
+		}
+		dirty.setSizeInBits(entryCnt, false);
+		ByteArrayOutputStream bitmap = new ByteArrayOutputStream();
+		try (DataOutputStream dataOut = new DataOutputStream(bitmap)) {
+			dirty.serialize(dataOut);
+		}
+		byte[] hdr = new byte[4];
+		NB.encodeInt32(hdr, 0, FSMN_VERSION);
+		out.write(hdr);
+		out.write(fsMonitorToken.getBytes(UTF_8));
+		out.write(0);
+		NB.encodeInt32(hdr, 0, bitmap.size());
+		out.write(hdr);
+		bitmap.writeTo(out);
+	}
+
 	private void readConfig() {
 		if (version == null && this.repository != null) {
 			DirCacheConfig config = repository.getConfig()
@@ -720,6 +1505,28 @@ private void readConfig() {
 		}
 	}
 
+	private DirCacheConfig getConfig() {
+		if (repository == null) {
+			return null;
+		}
+		return repository.getConfig().get(DirCacheConfig::new);
+	}
+
+	/**
+	 * Get the number of threads to read or write the index with.
+	 *
+	 * @return number of threads from {@code index.threads}, all available
+	 *         processors if not configured
+	 */
+	private int getThreads() {
+		DirCacheConfig config = getConfig();
+		int threads = config != null ? config.getThreads() : 0;
+		if (threads <= 0) {
+			threads = Runtime.getRuntime().availableProcessors();
+		}
+		return threads;
+	}
+
 	private MessageDigest newMessageDigest() {
 		if (skipHash) {
 			return NullMessageDigest.getInstance();
@@ -798,6 +1605,9 @@ public int findEntry(String path) {
 	 * <p>
 	 * If no path matches the entry -(position+1) is returned, where position is
 	 * the location it would have gone within the index.
+	 * <p>
+	 * A path inside a sparse directory expands the directory first, which
+	 * moves the positions of the entries after it.
 	 *
 	 * @param p
 	 *            the byte array starting with the path to search for.
@@ -809,7 +1619,43 @@ public int findEntry(String path) {
 	 * @since 3.4
 	 */
 	public int findEntry(byte[] p, int pLen) {
-		return findEntry(0, p, pLen);
+		int i = findEntry(0, p, pLen);
+		if (i < 0 && expandSparseDirectory(-(i + 1), p, pLen)) {
+			i = findEntry(0, p, pLen);
+		}
+		return i;
+	}
+
+	/**
+	 * Expand the sparse directory containing a path not found in the index,
+	 * for callers looking up paths which are not aware of sparse
+	 * directories.
+	 *
+	 * @param pos
+	 *            position the path would have in the index
+	 * @return whether a sparse directory was expanded
+	 */
+	private boolean expandSparseDirectory(int pos, byte[] p, int pLen) {
+		if (pos == 0 || repository == null) {
+			return false;
+		}
+		// Paths inside a sparse directory sort right after its entry.
+		DirCacheEntry dir = sortedEntries[pos - 1];
+		if (!dir.isSparseDirectory() || pLen < dir.path.length
+				|| !DirCacheTree.peq(dir.path, p, dir.path.length)) {
+			return false;
+		}
+		expandSparseDirectoriesUnchecked(e -> e == dir);
+		return true;
+	}
+
+	private void expandSparseDirectoriesUnchecked(
+			Predicate<DirCacheEntry> filter) {
+		try {
+			expandSparseDirectories(filter);
+		} catch (IOException e) {
+			throw new UncheckedIOException(e);
+		}
 	}
 
 	int findEntry(int low, byte[] p, int pLen) {
@@ -912,6 +1758,9 @@ public DirCacheEntry getEntry(String path) {
 	 */
 	public DirCacheEntry[] getEntriesWithin(String path) {
 		if (path.length() == 0) {
+			if (repository != null) {
+				expandSparseDirectoriesUnchecked(e -> true);
+			}
 			DirCacheEntry[] r = new DirCacheEntry[entryCnt];
 			System.arraycopy(sortedEntries, 0, r, 0, entryCnt);
 			return r;
@@ -924,7 +1773,15 @@ public DirCacheEntry[] getEntriesWithin(String path) {
 		int eIdx = findEntry(p, pLen);
 		if (eIdx < 0)
 			eIdx = -(eIdx + 1);
-		final int lastIdx = nextEntry(p, pLen, eIdx);
+		int lastIdx = nextEntry(p, pLen, eIdx);
+		if (repository != null && hasSparseDirectories(eIdx, lastIdx)) {
+			expandSparseDirectoriesUnchecked(
+					e -> DirCacheTree.peq(p, e.path, pLen));
+			eIdx = findEntry(0, p, pLen);
+			if (eIdx < 0)
+				eIdx = -(eIdx + 1);
+			lastIdx = nextEntry(p, pLen, eIdx);
+		}
 		final DirCacheEntry[] r = new DirCacheEntry[lastIdx - eIdx];
 		System.arraycopy(sortedEntries, eIdx, r, 0, r.length);
 		return r;
@@ -956,6 +1813,164 @@ public DirCacheTree getCacheTree(boolean build) {
 		return tree;
 	}
 
+	/**
+	 * Get the untracked cache stored in this index.
+	 *
+	 * @return the untracked cache; null if the index has none
+	 * @since 6.9
+	 */
+	public UntrackedCache getUntrackedCache() {
+		return untrackedCache;
+	}
+
+	/**
+	 * Set the untracked cache stored in this index.
+	 *
+	 * @param cache
+	 *            the untracked cache; null to remove it from the index
+	 * @since 6.9
+	 */
+	public void setUntrackedCache(UntrackedCache cache) {
+		untrackedCache = cache;
+	}
+
+	/**
+	 * Write the untracked cache to the index file, if possible.
+	 * <p>
+	 * The index is only written if it can be locked immediately and was not
+	 * modified since this instance read it. Like C Git updating the index
+	 * after computing the status, failing to do so is not an error.
+	 *
+	 * @param cache
+	 *            the untracked cache to store; null to remove it from the
+	 *            index
+	 * @return {@code true} if the index file was written
+	 * @throws IOException
+	 *             if writing the index failed
+	 * @since 6.9
+	 */
+	public boolean writeUntrackedCache(UntrackedCache cache)
+			throws IOException {
+		untrackedCache = cache;
+		return writeIfUnmodified();
+	}
+
+	/**
+	 * Write this index back to its file, if possible.
+	 * <p>
+	 * Used to store information which only speeds up later operations, such
+	 * as the untracked cache or the entries found unmodified by a file system
+	 * monitor. The index is only written if it can be locked immediately and
+	 * was not modified since this instance read it. Like C Git updating the
+	 * index after computing the status, failing to do so is not an error.
+	 *
+	 * @return {@code true} if the index file was written
+	 * @throws IOException
+	 *             if writing the index failed
+	 * @since 6.9
+	 */
+	public boolean writeIfUnmodified() throws IOException {
+		if (liveFile == null || snapshot == null || !lock()) {
+			return false;
+		}
+		try {
+			if (isOutdated()) {
+				return false;
+			}
+			write();
+			return commit();
+		} finally {
+			unlock();
+		}
+	}
+
+	/**
+	 * Get the token of the file system monitor stored in this index.
+	 *
+	 * @return the token the entries flagged as
+	 *         {@link DirCacheEntry#isFsMonitorValid() valid} are valid for;
+	 *         null if the index has none
+	 * @since 6.9
+	 */
+	public String getFsMonitorToken() {
+		return fsMonitorToken;
+	}
+
+	/**
+	 * Query a file system monitor for the paths changed since the token
+	 * stored in this index.
+	 * <p>
+	 * Entries the index stored as valid are flagged as
+	 * {@link DirCacheEntry#isFsMonitorValid() valid} only if the monitor
+	 * still knows the stored token. Entries whose paths were reported lose
+	 * their valid flag, and the token is replaced by the one of the answer.
+	 * Callers comparing the entries to the working tree may then flag the
+	 * entries they found unmodified as valid, and write the index to
+	 * remember them.
+	 *
+	 * @param monitor
+	 *            the monitor of the repository's working tree
+	 * @return {@code true} if entries lost their valid flag
+	 * @throws IOException
+	 *             if the monitor could not be queried
+	 * @since 6.9
+	 */
+	public boolean refreshFsMonitor(FsMonitor monitor) throws IOException {
+		FsMonitor.Changes changes = monitor.query(fsMonitorToken);
+		Collection<String> paths = changes.getPaths();
+		DirCacheEntry[] stored = fsMonitorStored;
+		fsMonitorStored = null;
+		boolean invalidated = false;
+		if (fsMonitorToken == null || paths == null) {
+			for (int i = 0; i < entryCnt; i++) {
+				invalidated |= invalidateFsMonitor(sortedEntries[i]);
+			}
+		} else {
+			if (stored != null) {
+				for (DirCacheEntry e : stored) {
+					e.setFsMonitorValid(true);
+				}
+			}
+			for (String path : paths) {
+				invalidated |= invalidateFsMonitor(path);
+			}
+		}
+		fsMonitorToken = changes.getToken();
+		return invalidated;
+	}
+
+	/**
+	 * Remove the valid flag from the entry of a path, and from the entries
+	 * below it if it is a directory.
+	 */
+	private boolean invalidateFsMonitor(String path) {
+		byte[] p = Constants.encode(path);
+		int pLen = p.length;
+		while (pLen > 0 && p[pLen - 1] == '/') {
+			pLen--;
+		}
+		boolean invalidated = false;
+		int i = findEntry(p, pLen);
+		for (i = i < 0 ? -(i + 1) : i; i < entryCnt; i++) {
+			byte[] e = sortedEntries[i].path;
+			if (e.length < pLen || !Arrays.equals(e, 0, pLen, p, 0, pLen)) {
+				break;
+			}
+			if (pLen == 0 || e.length == pLen || e[pLen] == '/') {
+				invalidated |= invalidateFsMonitor(sortedEntries[i]);
+			}
+		}
+		return invalidated;
+	}
+
+	private static boolean invalidateFsMonitor(DirCacheEntry e) {
+		if (e.isFsMonitorValid()) {
+			e.setFsMonitorValid(false);
+			return true;
+		}
+		return false;
+	}
+
 	/**
 	 * Write all index trees to the object store, returning the root tree.
 	 *
@@ -994,6 +2009,245 @@ public boolean hasUnmergedPaths() {
 		return false;
 	}
 
+	boolean hasSparseDirectories() {
+		return hasSparseDirectories(0, entryCnt);
+	}
+
+	private boolean hasSparseDirectories(int start, int end) {
+		for (int i = start; i < end; i++) {
+			if (sortedEntries[i].isSparseDirectory()) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Replace the sparse directory entries of this index by the entries of
+	 * their trees.
+	 * <p>
+	 * A sparse index does not contain the files of directories outside of the
+	 * sparse checkout, see {@link DirCacheEntry#isSparseDirectory()}.
+	 * Looking up such paths with {@link #getEntry(String)},
+	 * {@link #findEntry(String)} or {@link #getEntriesWithin(String)} expands
+	 * the directories containing them, and tree walks expand sparse
+	 * directories when entering them. Applications accessing the entries by
+	 * position may expand the whole index first. If {@code index.sparse} is
+	 * enabled the directories are collapsed again when the index is
+	 * written.
+	 *
+	 * @param reader
+	 *            reader for the trees of the sparse directories
+	 * @throws IOException
+	 *             if a tree cannot be read
+	 * @since 6.9
+	 */
+	public void expandSparseDirectories(ObjectReader reader)
+			throws IOException {
+		expandSparseDirectories(reader, null);
+	}
+
+	/**
+	 * Expand the sparse directories which contain paths to be edited.
+	 *
+	 * @param edited
+	 *            tells whether a sparse directory entry needs to be expanded
+	 * @throws IOException
+	 *             if a tree cannot be read
+	 */
+	void expandSparseDirectories(Predicate<DirCacheEntry> edited)
+			throws IOException {
+		if (repository == null || !hasSparseDirectories()) {
+			return;
+		}
+		try (ObjectReader reader = repository.newObjectReader()) {
+			expandSparseDirectories(reader, edited);
+		}
+	}
+
+	private void expandSparseDirectories(ObjectReader reader,
+			Predicate<DirCacheEntry> filter) throws IOException {
+		DirCacheBuilder b = null;
+		for (int i = 0; i < entryCnt; i++) {
+			DirCacheEntry e = sortedEntries[i];
+			if (e.isSparseDirectory() && (filter == null || filter.test(e))) {
+				if (b == null) {
+					b = builder();
+					if (i > 0) {
+						b.keep(0, i);
+					}
+				}
+				DirCache dir = readSparseDirectory(e, reader);
+				rememberExpansion(e, dir);
+				for (int j = 0; j < dir.entryCnt; j++) {
+					b.add(dir.sortedEntries[j]);
+				}
+			} else if (b != null) {
+				b.keep(i, 1);
+			}
+		}
+		if (b != null) {
+			b.finish();
+		}
+	}
+
+	/**
+	 * Read the entries of a sparse directory.
+	 *
+	 * @param dir
+	 *            the sparse directory entry
+	 * @param reader
+	 *            reader for the directory's tree
+	 * @return an in-core index holding the files of the directory, with the
+	 *         skip-worktree flag set
+	 * @throws IOException
+	 *             if the tree cannot be read
+	 */
+	static DirCache readSparseDirectory(DirCacheEntry dir,
+			ObjectReader reader) throws IOException {
+		DirCache dc = newInCore();
+		DirCacheBuilder b = dc.builder();
+		b.addTree(dir.path, DirCacheEntry.STAGE_0, reader, dir.getObjectId());
+		b.finish();
+		for (int i = 0; i < dc.entryCnt; i++) {
+			dc.sortedEntries[i].setSkipWorkTree(true);
+		}
+		return dc;
+	}
+
+	/**
+	 * Remember the entries a sparse directory was expanded to.
+	 *
+	 * @param dir
+	 *            the sparse directory entry
+	 * @param expanded
+	 *            the index read by {@link #readSparseDirectory}
+	 */
+	void rememberExpansion(DirCacheEntry dir, DirCache expanded) {
+		if (expanded.entryCnt > 0) {
+			expansions.put(expanded.sortedEntries[0], new SparseExpansion(
+					dir, Arrays.copyOf(expanded.sortedEntries,
+							expanded.entryCnt)));
+		}
+	}
+
+	/**
+	 * Find the sparse directory the entries of a directory were expanded
+	 * from.
+	 *
+	 * @return the sparse directory entry, or null if the directory was not
+	 *         expanded from one or its entries changed since
+	 */
+	private DirCacheEntry findExpansion(int start, int cnt, int pathLen) {
+		SparseExpansion x = expansions.get(sortedEntries[start]);
+		if (x == null || x.dir.path.length != pathLen
+				|| x.entries.length != cnt) {
+			return null;
+		}
+		for (int i = 0; i < cnt; i++) {
+			if (sortedEntries[start + i] != x.entries[i]) {
+				return null;
+			}
+		}
+		return x.dir;
+	}
+
+	/**
+	 * Collapse the directories outside of a cone mode sparse checkout if
+	 * {@code index.sparse} is enabled, or expand all sparse directories.
+	 */
+	private void updateSparseIndex() throws IOException {
+		SparseCheckout sparse = getConfig().isSparseIndex()
+				? SparseCheckout.get(repository)
+				: null;
+		if (sparse == null || !sparse.isCone()) {
+			expandSparseDirectories(e -> true);
+			return;
+		}
+		// Directories which entered the sparse checkout are expanded first,
+		// their files will be checked out.
+		expandSparseDirectories(e -> !sparse.isSparseDirectory(
+				RawParseUtils.decode(e.path, 0, e.path.length - 1)));
+		if (entryCnt == 0) {
+			return;
+		}
+		DirCacheBuilder b = builder();
+		try (ObjectInserter ins = repository.newObjectInserter()) {
+			if (collapse(getCacheTree(true), 0, 0, sparse, ins, b)) {
+				ins.flush();
+				b.finish();
+			}
+		}
+	}
+
+	/**
+	 * Collapse the directories of a tree which are outside of the sparse
+	 * checkout.
+	 *
+	 * @return whether a directory was collapsed
+	 */
+	private boolean collapse(DirCacheTree t, int start, int pathOff,
+			SparseCheckout sparse, ObjectInserter ins, DirCacheBuilder b)
+			throws IOException {
+		boolean collapsed = false;
+		int end = start + t.getEntrySpan();
+		int child = 0;
+		int i = start;
+		while (i < end) {
+			DirCacheEntry e = sortedEntries[i];
+			DirCacheTree st = child < t.getChildCount() ? t.getChild(child)
+					: null;
+			if (st == null || !st.contains(e.path, pathOff, e.path.length)) {
+				b.keep(i++, 1);
+				continue;
+			}
+			child++;
+			int span = st.getEntrySpan();
+			int stOff = pathOff + st.nameLength() + 1;
+			if (span == 1 && e.isSparseDirectory()
+					&& e.path.length == stOff) {
+				b.keep(i, 1);
+			} else if (isSkipped(i, span) && sparse.isSparseDirectory(
+					RawParseUtils.decode(e.path, 0, stOff - 1))) {
+				// Only a directory which changed needs its tree written.
+				DirCacheEntry dir = findExpansion(i, span, stOff);
+				if (dir == null) {
+					ObjectId id = st.writeTree(sortedEntries, i, stOff, ins);
+					dir = new DirCacheEntry(Arrays.copyOf(e.path, stOff - 1),
+							id);
+				}
+				b.add(dir);
+				collapsed = true;
+			} else {
+				collapsed |= collapse(st, i, stOff, sparse, ins, b);
+			}
+			i += span;
+		}
+		return collapsed;
+	}
+
+	/** Entries a sparse directory was expanded to. */
+	private static class SparseExpansion {
+		final DirCacheEntry dir;
+
+		final DirCacheEntry[] entries;
+
+		SparseExpansion(DirCacheEntry dir, DirCacheEntry[] entries) {
+			this.dir = dir;
+			this.entries = entries;
+		}
+	}
+
+	private boolean isSkipped(int start, int cnt) {
+		for (int i = start; i < start + cnt; i++) {
+			DirCacheEntry e = sortedEntries[i];
+			if (!e.isMerged() || !e.isSkipWorkTree()) {
+				return false;
+			}
+		}
+		return true;
+	}
+
 	private void registerIndexChangedListener(IndexChangedListener listener) {
 		this.indexChangedListener = listener;
 	}
@@ -1009,7 +2263,8 @@ private void updateSmudgedEntries() throws IOException {
 		try (TreeWalk walk = new TreeWalk(repository)) {
 			walk.setOperationType(OperationType.CHECKIN_OP);
 			for (int i = 0; i < entryCnt; i++)
-				if (sortedEntries[i].isSmudged())
+				if (sortedEntries[i].isSmudged()
+						&& !sortedEntries[i].isSparseDirectory())
 					paths.add(sortedEntries[i].getPathString());
 			if (paths.isEmpty())
 				return;
@@ -1088,12 +2343,177 @@ public static DirCacheVersion fromInt(int val) {
 		}
 	}
 
+	/**
+	 * Splits the entries into the entries stored in a split index and the
+	 * entries of its shared index.
+	 * <p>
+	 * Entries read from the shared index and not modified since are only
+	 * referenced by their position. If too many entries differ from the
+	 * shared index, a new shared index holding all entries is written.
+	 */
+	private class SplitIndexWriter {
+		/** Entries to store in the split index. */
+		final DirCacheEntry[] entries;
+
+		final int count;
+
+		/** Content of the 'link' extension. */
+		final byte[] link;
+
+		SplitIndexWriter(File dir, DirCacheConfig config) throws IOException {
+			List<DirCacheEntry> replaced = new ArrayList<>();
+			List<DirCacheEntry> added = new ArrayList<>();
+			EWAHCompressedBitmap delete = new EWAHCompressedBitmap();
+			EWAHCompressedBitmap replace = new EWAHCompressedBitmap();
+			boolean rewrite = sharedEntries == null;
+			if (!rewrite) {
+				BitSet used = new BitSet(sharedEntries.length);
+				int last = -1;
+				for (int i = 0; i < entryCnt; i++) {
+					DirCacheEntry e = sortedEntries[i];
+					int pos = e.basePosition - 1;
+					if (pos > last && pos < sharedEntries.length
+							&& sharedEntries[pos].path == e.path) {
+						used.set(pos);
+						last = pos;
+						if (e.isUpdateInBase()) {
+							replaced.add(e);
+							replace.set(pos);
+						}
+					} else {
+						added.add(e);
+					}
+				}
+				for (int pos = used.nextClearBit(0); pos < sharedEntries.length; pos = used
+						.nextClearBit(pos + 1)) {
+					delete.set(pos);
+				}
+				int maxPercent = config != null ? config.getMaxPercentChange()
+						: DEFAULT_MAX_PERCENT_CHANGE;
+				int notShared = replaced.size() + added.size();
+				rewrite = maxPercent == 0 || (maxPercent < 100
+						&& (long) entryCnt * maxPercent < (long) notShared * 100);
+			}
+			if (!rewrite) {
+				File file = new File(dir,
+						SHARED_INDEX_PREFIX + sharedIndexId.name());
+				rewrite = !file.isFile();
+				if (!rewrite) {
+					// Protect the shared index from expiring while it is
+					// in use.
+					FileUtils.touch(file.toPath());
+				}
+			}
+			if (rewrite) {
+				writeSharedIndex(dir, config);
+				replaced.clear();
+				added.clear();
+				delete = new EWAHCompressedBitmap();
+				replace = new EWAHCompressedBitmap();
+			}
+
+			count = replaced.size() + added.size();
+			entries = new DirCacheEntry[count];
+			int n = 0;
+			for (DirCacheEntry e : replaced) {
+				entries[n++] = new DirCacheEntry(new byte[0], e);
+			}
+			for (DirCacheEntry e : added) {
+				entries[n++] = e;
+			}
+
+			ByteArrayOutputStream buf = new ByteArrayOutputStream();
+			DataOutputStream out = new DataOutputStream(buf);
+			sharedIndexId.copyRawTo(out);
+			delete.serialize(out);
+			replace.serialize(out);
+			out.flush();
+			link = buf.toByteArray();
+		}
+
+		private void writeSharedIndex(File dir, DirCacheConfig config)
+				throws IOException {
+			File tmp = File.createTempFile("sharedindex_", null, dir); //$NON-NLS-1$
+			try {
+				MessageDigest md = Constants.newMessageDigest();
+				try (OutputStream os = new BufferedOutputStream(
+						new DigestOutputStream(new FileOutputStream(tmp), md))) {
+					byte[] hdr = new byte[12];
+					System.arraycopy(SIG_DIRC, 0, hdr, 0, SIG_DIRC.length);
+					NB.encodeInt32(hdr, 4, version.getVersionCode());
+					NB.encodeInt32(hdr, 8, entryCnt);
+					os.write(hdr);
+					for (int i = 0; i < entryCnt; i++) {
+						sortedEntries[i].write(os, version,
+								i == 0 ? null : sortedEntries[i - 1]);
+					}
+					os.flush();
+					byte[] checksum = md.digest();
+					os.write(checksum);
+					sharedIndexId = ObjectId.fromRaw(checksum);
+				}
+				FileUtils.rename(tmp, new File(dir,
+						SHARED_INDEX_PREFIX + sharedIndexId.name()),
+						StandardCopyOption.ATOMIC_MOVE);
+			} finally {
+				FileUtils.delete(tmp, FileUtils.SKIP_MISSING);
+			}
+			sharedEntries = Arrays.copyOf(sortedEntries, entryCnt);
+			for (int i = 0; i < entryCnt; i++) {
+				sharedEntries[i].setBasePosition(i);
+			}
+			expireSharedIndexes(dir, config);
+		}
+
+		private void expireSharedIndexes(File dir, DirCacheConfig config) {
+			String expireStr = config != null ? config.getSharedIndexExpire()
+					: DEFAULT_SHARED_INDEX_EXPIRE;
+			Date expire;
+			try {
+				expire = GitDateParser.parse(expireStr, null,
+						SystemReader.getInstance().getLocale());
+			} catch (ParseException e) {
+				// Keep the files rather than failing the write.
+				return;
+			}
+			if (expire == GitDateParser.NEVER) {
+				return;
+			}
+			String current = SHARED_INDEX_PREFIX + sharedIndexId.name();
+			File[] files = dir.listFiles((d, name) -> name
+					.startsWith(SHARED_INDEX_PREFIX) && !name.equals(current));
+			if (files == null) {
+				return;
+			}
+			for (File f : files) {
+				// Other split indexes may still refer to younger files.
+				if (f.lastModified() < expire.getTime()) {
+					f.delete();
+				}
+			}
+		}
+	}
+
 	private static class DirCacheConfig {
 
 		private final DirCacheVersion indexVersion;
 
 		private final boolean skipHash;
 
+		private final int threads;
+
+		private final boolean recordEndOfIndexEntries;
+
+		private final boolean recordOffsetTable;
+
+		private final Boolean splitIndex;
+
+		private final int maxPercentChange;
+
+		private final String sharedIndexExpire;
+
+		private final boolean sparseIndex;
+
 		public DirCacheConfig(Config cfg) {
 			boolean manyFiles = cfg.getBoolean(
 					ConfigConstants.CONFIG_FEATURE_SECTION,
@@ -1105,6 +2525,47 @@ public DirCacheConfig(Config cfg) {
 							: DirCacheVersion.DIRC_VERSION_EXTENDED);
 			skipHash = cfg.getBoolean(ConfigConstants.CONFIG_INDEX_SECTION,
 					ConfigConstants.CONFIG_KEY_SKIPHASH, false);
+
+			// Like C Git, index.threads is a boolean or a number, and
+			// "true" or 0 mean as many threads as there are processors.
+			String value = cfg.getString(ConfigConstants.CONFIG_INDEX_SECTION,
+					null, ConfigConstants.CONFIG_KEY_THREADS);
+			Boolean bool = StringUtils.toBooleanOrNull(value);
+			if (value == null || Boolean.TRUE.equals(bool)) {
+				threads = 0;
+			} else if (bool != null) {
+				threads = 1;
+			} else {
+				threads = cfg.getInt(ConfigConstants.CONFIG_INDEX_SECTION,
+						ConfigConstants.CONFIG_KEY_THREADS, 0);
+			}
+			boolean parallel = value != null && threads != 1;
+			recordEndOfIndexEntries = cfg.getBoolean(
+					ConfigConstants.CONFIG_INDEX_SECTION,
+					ConfigConstants.CONFIG_KEY_RECORD_END_OF_INDEX_ENTRIES,
+					parallel);
+			recordOffsetTable = cfg.getBoolean(
+					ConfigConstants.CONFIG_INDEX_SECTION,
+					ConfigConstants.CONFIG_KEY_RECORD_OFFSET_TABLE, parallel);
+
+			// An unset core.splitIndex keeps an index split or not.
+			splitIndex = StringUtils.toBooleanOrNull(
+					cfg.getString(ConfigConstants.CONFIG_CORE_SECTION, null,
+							ConfigConstants.CONFIG_KEY_SPLIT_INDEX));
+			int percent = cfg.getInt(
+					ConfigConstants.CONFIG_SPLIT_INDEX_SECTION,
+					ConfigConstants.CONFIG_KEY_MAX_PERCENT_CHANGE,
+					DEFAULT_MAX_PERCENT_CHANGE);
+			maxPercentChange = percent < 0 || percent > 100
+					? DEFAULT_MAX_PERCENT_CHANGE
+					: percent;
+			String expire = cfg.getString(
+					ConfigConstants.CONFIG_SPLIT_INDEX_SECTION, null,
+					ConfigConstants.CONFIG_KEY_SHARED_INDEX_EXPIRE);
+			sharedIndexExpire = expire != null ? expire
+					: DEFAULT_SHARED_INDEX_EXPIRE;
+			sparseIndex = cfg.getBoolean(ConfigConstants.CONFIG_INDEX_SECTION,
+					ConfigConstants.CONFIG_KEY_SPARSE_INDEX, false);
 		}
 
 		public DirCacheVersion getIndexVersion() {
@@ -1114,5 +2575,33 @@ public DirCacheVersion getIndexVersion() {
 		public boolean isSkipHash() {
 			return skipHash;
 		}
+
+		public int getThreads() {
+			return threads;
+		}
+
+		public boolean isRecordEndOfIndexEntries() {
+			return recordEndOfIndexEntries;
+		}
+
+		public boolean isRecordOffsetTable() {
+			return recordOffsetTable;
+		}
+
+		public boolean isSplitIndex(boolean split) {
+			return splitIndex != null ? splitIndex.booleanValue() : split;
+		}
+
+		public int getMaxPercentChange() {
+			return maxPercentChange;
+		}
+
+		public String getSharedIndexExpire() {
+			return sharedIndexExpire;
+		}
+
+		public boolean isSparseIndex() {
+			return sparseIndex;
+		}
 	}
 }
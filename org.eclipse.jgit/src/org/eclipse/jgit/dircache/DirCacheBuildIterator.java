@@ -52,6 +52,12 @@
 public class DirCacheBuildIterator extends DirCacheIterator {
 	private final DirCacheBuilder builder;
 
+	/**
+	 * Position in the builder's cache after the sparse directory whose
+	 * expanded entries are walked; -1 when walking the builder's cache.
+	 */
+	private final int sparseEnd;
+
 	/**
 	 * Create a new iterator for an already loaded DirCache instance.
 	 * <p>
@@ -66,12 +72,21 @@ public class DirCacheBuildIterator extends DirCacheIterator {
 	public DirCacheBuildIterator(DirCacheBuilder dcb) {
 		super(dcb.getDirCache());
 		builder = dcb;
+		sparseEnd = -1;
 	}
 
 	DirCacheBuildIterator(final DirCacheBuildIterator p,
 			final DirCacheTree dct) {
 		super(p, dct);
 		builder = p.builder;
+		sparseEnd = p.sparseEnd;
+	}
+
+	private DirCacheBuildIterator(DirCacheBuildIterator p,
+			DirCache expanded) {
+		super(p, expanded);
+		builder = p.builder;
+		sparseEnd = p.ptr + 1;
 	}
 
 	@Override
@@ -80,28 +95,56 @@ public AbstractTreeIterator createSubtreeIterator(ObjectReader reader)
 		if (currentSubtree == null)
 			throw new IncorrectObjectTypeException(getEntryObjectId(),
 					Constants.TYPE_TREE);
+		if (isSparseDirectory()) {
+			DirCache expanded = expandSparseDirectory(reader);
+			builder.getDirCache().rememberExpansion(currentEntry, expanded);
+			return new DirCacheBuildIterator(this, expanded);
+		}
 		return new DirCacheBuildIterator(this, currentSubtree);
 	}
 
 	@Override
 	public void skip() throws CorruptObjectException {
-		if (currentSubtree != null)
-			builder.keep(ptr, currentSubtree.getEntrySpan());
+		int cnt = currentSubtree != null ? currentSubtree.getEntrySpan() : 1;
+		if (sparseEnd < 0)
+			builder.keep(ptr, cnt);
 		else
-			builder.keep(ptr, 1);
+			add(ptr, cnt);
 		next(1);
 	}
 
+	/**
+	 * Keep the sparse directory the iterator is positioned on, without
+	 * entering it.
+	 */
+	void keepSparseDirectory() {
+		builder.keep(ptr, 1);
+	}
+
 	@Override
 	public void stopWalk() {
 		final int cur = ptr;
 		final int cnt = cache.getEntryCount();
-		if (cur < cnt)
-			builder.keep(cur, cnt - cur);
+		if (sparseEnd < 0) {
+			if (cur < cnt)
+				builder.keep(cur, cnt - cur);
+			return;
+		}
+
+		// Rest of the expanded sparse directory, then of the index.
+		add(cur, cnt - cur);
+		final int total = builder.getDirCache().getEntryCount();
+		if (sparseEnd < total)
+			builder.keep(sparseEnd, total - sparseEnd);
+	}
+
+	private void add(int pos, int cnt) {
+		for (int i = pos; i < pos + cnt; i++)
+			builder.add(cache.getEntry(i));
 	}
 
 	@Override
 	protected boolean needsStopWalk() {
-		return ptr < cache.getEntryCount();
+		return sparseEnd >= 0 || ptr < cache.getEntryCount();
 	}
 }
@@ -43,6 +43,7 @@
 import org.eclipse.jgit.errors.MissingObjectException;
 import org.eclipse.jgit.events.WorkingTreeModifiedEvent;
 import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.lib.AsyncObjectSizeQueue;
 import org.eclipse.jgit.lib.ConfigConstants;
 import org.eclipse.jgit.lib.Constants;
 import org.eclipse.jgit.lib.CoreConfig.AutoCRLF;
@@ -109,6 +110,12 @@ public CheckoutMetadata(EolStreamType eolStreamType,
 				EolStreamType.DIRECT, null);
 	}
 
+	/**
+	 * Minimum number of files to update for a checkout to be parallel, unless
+	 * configured by {@code checkout.thresholdForParallelism}.
+	 */
+	private static final int DEFAULT_THRESHOLD_FOR_PARALLELISM = 100;
+
 	private Repository repo;
 
 	private Map<String, CheckoutMetadata> updated = new LinkedHashMap<>();
@@ -143,6 +150,12 @@ public CheckoutMetadata(EolStreamType eolStreamType,
 
 	private Checkout checkout;
 
+	/** Paths to check out, null if all paths are checked out. */
+	private SparseCheckout sparse;
+
+	/** Position of {@link #workingTree} in {@link #walk}. */
+	private int workingTreePos;
+
 	private ProgressMonitor monitor = NullProgressMonitor.INSTANCE;
 
 	/**
@@ -305,11 +318,12 @@ public void preScanTwoTrees() throws CorruptObjectException, IOException {
 		conflicts.clear();
 		walk = new NameConflictTreeWalk(repo);
 		builder = dc.builder();
+		sparse = SparseCheckout.get(repo);
 
 		walk.setHead(addTree(walk, headCommitTree));
 		addTree(walk, mergeCommitTree);
 		int dciPos = walk.addTree(new DirCacheBuildIterator(builder));
-		walk.addTree(workingTree);
+		workingTreePos = walk.addTree(workingTree);
 		workingTree.setDirCacheIterator(walk, dciPos);
 
 		while (walk.next()) {
@@ -317,7 +331,10 @@ public void preScanTwoTrees() throws CorruptObjectException, IOException {
 					walk.getTree(1, CanonicalTreeParser.class),
 					walk.getTree(2, DirCacheBuildIterator.class),
 					walk.getTree(3, WorkingTreeIterator.class));
-			if (walk.isSubtree())
+			if (walk.isSubtree() && !keepSparseDirectory(
+					walk.getTree(2, DirCacheBuildIterator.class),
+					walk.getTree(0, CanonicalTreeParser.class),
+					walk.getTree(1, CanonicalTreeParser.class)))
 				walk.enterSubtree();
 		}
 	}
@@ -343,23 +360,54 @@ public void prescanOneTree()
 		conflicts.clear();
 
 		builder = dc.builder();
+		sparse = SparseCheckout.get(repo);
 
 		walk = new NameConflictTreeWalk(repo);
 		walk.setHead(addTree(walk, mergeCommitTree));
 		int dciPos = walk.addTree(new DirCacheBuildIterator(builder));
-		walk.addTree(workingTree);
+		workingTreePos = walk.addTree(workingTree);
 		workingTree.setDirCacheIterator(walk, dciPos);
 
 		while (walk.next()) {
 			processEntry(walk.getTree(0, CanonicalTreeParser.class),
 					walk.getTree(1, DirCacheBuildIterator.class),
 					walk.getTree(2, WorkingTreeIterator.class));
-			if (walk.isSubtree())
+			if (walk.isSubtree() && !keepSparseDirectory(
+					walk.getTree(1, DirCacheBuildIterator.class),
+					walk.getTree(0, CanonicalTreeParser.class)))
 				walk.enterSubtree();
 		}
 		conflicts.removeAll(removed);
 	}
 
+	/**
+	 * Keeps a directory collapsed in a sparse index instead of walking its
+	 * files, if it stays outside of the sparse checkout and is not changed.
+	 *
+	 * @param i
+	 *            the index
+	 * @param trees
+	 *            the trees to check out
+	 * @return whether the directory was kept
+	 */
+	private boolean keepSparseDirectory(DirCacheBuildIterator i,
+			CanonicalTreeParser... trees) {
+		if (sparse == null || i == null || !i.isSparseDirectory()
+				|| walk.getTree(workingTreePos,
+						WorkingTreeIterator.class) != null
+				|| !sparse.isSparseDirectory(walk.getPathString())) {
+			return false;
+		}
+		for (CanonicalTreeParser t : trees) {
+			if (t == null || !FileMode.TREE.equals(t.getEntryFileMode())
+					|| !t.idEqual(i)) {
+				return false;
+			}
+		}
+		i.keepSparseDirectory();
+		return true;
+	}
+
 	private int addTree(TreeWalk tw, ObjectId id) throws MissingObjectException,
 			IncorrectObjectTypeException, IOException {
 		if (id == null) {
@@ -506,6 +554,12 @@ private boolean doCheckout() throws CorruptObjectException, IOException,
 		toBeDeleted.clear();
 		try (ObjectReader objectReader = repo.getObjectDatabase().newReader()) {
 			checkout = new Checkout(repo, null);
+			if (workingTree.getRepository() == repo) {
+				FsMonitor fsMonitor = FsMonitor.get(repo);
+				if (fsMonitor != null) {
+					dc.refreshFsMonitor(fsMonitor);
+				}
+			}
 			if (headCommitTree != null)
 				preScanTwoTrees();
 			else
@@ -562,40 +616,13 @@ private boolean doCheckout() throws CorruptObjectException, IOException,
 			}
 			removed = filterOut(removed, nonDeleted);
 			nonDeleted = null;
-			Iterator<Map.Entry<String, CheckoutMetadata>> toUpdate = updated
-					.entrySet().iterator();
-			Map.Entry<String, CheckoutMetadata> e = null;
-			try {
-				while (toUpdate.hasNext()) {
-					e = toUpdate.next();
-					String path = e.getKey();
-					CheckoutMetadata meta = e.getValue();
-					DirCacheEntry entry = dc.getEntry(path);
-					if (FileMode.GITLINK.equals(entry.getRawMode())) {
-						checkout.checkoutGitlink(entry, path);
-					} else {
-						checkout.checkout(entry, meta, objectReader, path);
-					}
-					e = null;
-
-					monitor.update(1);
-					if (monitor.isCancelled()) {
-						throw new CanceledException(MessageFormat.format(
-								JGitText.get().operationCanceled,
-								JGitText.get().checkingOutFiles));
-					}
-				}
-			} catch (Exception ex) {
-				// We didn't actually modify the current entry nor any that
-				// might follow.
-				if (e != null) {
-					toUpdate.remove();
-				}
-				while (toUpdate.hasNext()) {
-					e = toUpdate.next();
-					toUpdate.remove();
-				}
-				throw ex;
+			prefetchBlobs(objectReader);
+			int workers = getCheckoutWorkers();
+			if (workers > 1
+					&& updated.size() >= getParallelCheckoutThreshold()) {
+				checkoutInParallel(objectReader, workers);
+			} else {
+				checkoutSequentially(objectReader);
 			}
 			for (String conflict : conflicts) {
 				// the conflicts are likely to have multiple entries in the
@@ -633,6 +660,110 @@ private boolean doCheckout() throws CorruptObjectException, IOException,
 		return toBeDeleted.isEmpty();
 	}
 
+	private void prefetchBlobs(ObjectReader objectReader) throws IOException {
+		if (repo.getConfig().getString(
+				ConfigConstants.CONFIG_EXTENSIONS_SECTION, null,
+				ConfigConstants.CONFIG_KEY_PARTIAL_CLONE) == null) {
+			return;
+		}
+		// Asking for all sizes at once lets the reader of a partial clone
+		// fetch the missing blobs in one request instead of one by one.
+		List<ObjectId> blobs = new ArrayList<>(updated.size());
+		for (String path : updated.keySet()) {
+			DirCacheEntry entry = dc.getEntry(path);
+			if (!FileMode.GITLINK.equals(entry.getRawMode())) {
+				blobs.add(entry.getObjectId());
+			}
+		}
+		AsyncObjectSizeQueue<ObjectId> sizes = objectReader
+				.getObjectSize(blobs, false);
+		try {
+			while (sizes.next()) {
+				// Only the fetch of the missing blobs matters.
+			}
+		} finally {
+			sizes.release();
+		}
+	}
+
+	private void checkoutSequentially(ObjectReader objectReader)
+			throws IOException, CanceledException {
+		Iterator<Map.Entry<String, CheckoutMetadata>> toUpdate = updated
+				.entrySet().iterator();
+		Map.Entry<String, CheckoutMetadata> e = null;
+		try {
+			while (toUpdate.hasNext()) {
+				e = toUpdate.next();
+				String path = e.getKey();
+				CheckoutMetadata meta = e.getValue();
+				DirCacheEntry entry = dc.getEntry(path);
+				if (FileMode.GITLINK.equals(entry.getRawMode())) {
+					checkout.checkoutGitlink(entry, path);
+				} else {
+					checkout.checkout(entry, meta, objectReader, path);
+				}
+				e = null;
+
+				monitor.update(1);
+				if (monitor.isCancelled()) {
+					throw new CanceledException(MessageFormat.format(
+							JGitText.get().operationCanceled,
+							JGitText.get().checkingOutFiles));
+				}
+			}
+		} catch (Exception ex) {
+			// We didn't actually modify the current entry nor any that
+			// might follow.
+			if (e != null) {
+				toUpdate.remove();
+			}
+			while (toUpdate.hasNext()) {
+				e = toUpdate.next();
+				toUpdate.remove();
+			}
+			throw ex;
+		}
+	}
+
+	private void checkoutInParallel(ObjectReader objectReader, int workers)
+			throws IOException, CanceledException {
+		try (ParallelCheckout parallel = new ParallelCheckout(repo, checkout,
+				objectReader, workers, monitor)) {
+			try {
+				for (Map.Entry<String, CheckoutMetadata> e : updated
+						.entrySet()) {
+					String path = e.getKey();
+					parallel.add(dc.getEntry(path), e.getValue(), path);
+					if (monitor.isCancelled()) {
+						throw new CanceledException(MessageFormat.format(
+								JGitText.get().operationCanceled,
+								JGitText.get().checkingOutFiles));
+					}
+				}
+				parallel.finish();
+			} catch (Exception ex) {
+				// Files being written by workers may still succeed.
+				parallel.close();
+				updated.keySet().removeIf(path -> !parallel.isWritten(path));
+				throw ex;
+			}
+		}
+	}
+
+	private int getCheckoutWorkers() {
+		int workers = repo.getConfig().getInt(
+				ConfigConstants.CONFIG_CHECKOUT_SECTION,
+				ConfigConstants.CONFIG_KEY_WORKERS, 1);
+		return workers < 1 ? Runtime.getRuntime().availableProcessors()
+				: workers;
+	}
+
+	private int getParallelCheckoutThreshold() {
+		return repo.getConfig().getInt(ConfigConstants.CONFIG_CHECKOUT_SECTION,
+				ConfigConstants.CONFIG_KEY_THRESHOLD_FOR_PARALLELISM,
+				DEFAULT_THRESHOLD_FOR_PARALLELISM);
+	}
+
 	private static ArrayList<String> filterOut(ArrayList<String> strings,
 			IntList indicesToRemove) {
 		int n = indicesToRemove.size();
@@ -1231,9 +1362,12 @@ private void keep(String path, DirCacheEntry e, WorkingTreeIterator f)
 			return;
 		}
 		if (!FileMode.TREE.equals(e.getFileMode())) {
+			if (sparse != null && e.isMerged()) {
+				keepSparse(path, e, f);
+			}
 			builder.add(e);
 		}
-		if (force) {
+		if (force && !e.isSkipWorkTree()) {
 			if (f == null || f.isModified(e, true, walk.getObjectReader())) {
 				kept.add(path);
 				checkout.checkout(e,
@@ -1245,6 +1379,41 @@ private void keep(String path, DirCacheEntry e, WorkingTreeIterator f)
 		}
 	}
 
+	/**
+	 * Moves a kept entry into or out of the sparse checkout.
+	 *
+	 * @param path
+	 *            of the entry
+	 * @param e
+	 *            the kept entry
+	 * @param f
+	 *            the file in the working tree
+	 * @throws IOException
+	 *             if the file cannot be compared to the entry
+	 */
+	private void keepSparse(String path, DirCacheEntry e,
+			WorkingTreeIterator f) throws IOException {
+		boolean included = sparse.isIncluded(path);
+		if (included && e.isSkipWorkTree()) {
+			e.setSkipWorkTree(false);
+			if (f == null) {
+				updated.put(path, new CheckoutMetadata(
+						walk.getEolStreamType(CHECKOUT_OP),
+						walk.getFilterCommand(
+								Constants.ATTR_FILTER_TYPE_SMUDGE)));
+			}
+		} else if (!included && !e.isSkipWorkTree()) {
+			if (f == null) {
+				e.setSkipWorkTree(true);
+			} else if (!FileMode.TREE.equals(f.getEntryFileMode())
+					&& !f.isModified(e, true, walk.getObjectReader())) {
+				e.setSkipWorkTree(true);
+				remove(path);
+			}
+			// Modified files stay in the working tree.
+		}
+	}
+
 	private void remove(String path) {
 		removed.add(path);
 	}
@@ -1257,13 +1426,22 @@ private void update(CanonicalTreeParser tree) throws IOException {
 	private void update(int index, String path, ObjectId mId,
 			FileMode mode) throws IOException {
 		if (!FileMode.TREE.equals(mode)) {
-			updated.put(path, new CheckoutMetadata(
-					walk.getCheckoutEolStreamType(index),
-					walk.getSmudgeCommand(index)));
-
 			DirCacheEntry entry = new DirCacheEntry(path, DirCacheEntry.STAGE_0);
 			entry.setObjectId(mId);
 			entry.setFileMode(mode);
+			if (sparse != null && !sparse.isIncluded(path)) {
+				// Not checked out, an old file in the way is deleted.
+				entry.setSkipWorkTree(true);
+				WorkingTreeIterator f = walk.getTree(workingTreePos,
+						WorkingTreeIterator.class);
+				if (f != null && !FileMode.TREE.equals(f.getEntryFileMode())) {
+					remove(path);
+				}
+			} else {
+				updated.put(path, new CheckoutMetadata(
+						walk.getCheckoutEolStreamType(index),
+						walk.getSmudgeCommand(index)));
+			}
 			builder.add(entry);
 		}
 	}
@@ -16,6 +16,7 @@
 import static org.eclipse.jgit.lib.FileMode.TYPE_TREE;
 
 import java.io.IOException;
+import java.io.UncheckedIOException;
 import java.text.MessageFormat;
 import java.util.ArrayList;
 import java.util.Collections;
@@ -93,11 +94,30 @@ public boolean commit() throws IOException {
 	@Override
 	public void finish() {
 		if (!edits.isEmpty()) {
+			expandSparseDirectories();
 			applyEdits();
 			replace();
 		}
 	}
 
+	private void expandSparseDirectories() {
+		// Paths inside a sparse directory need the entries of its tree.
+		try {
+			cache.expandSparseDirectories(this::isEdited);
+		} catch (IOException e) {
+			throw new UncheckedIOException(e);
+		}
+	}
+
+	private boolean isEdited(DirCacheEntry dir) {
+		for (PathEdit e : edits) {
+			if (peq(dir.path, e.path, dir.path.length)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
 	private void applyEdits() {
 		Collections.sort(edits, EDIT_CMP);
 		editIdx = 0;
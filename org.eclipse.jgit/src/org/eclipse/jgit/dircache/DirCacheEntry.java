@@ -101,11 +101,23 @@ public class DirCacheEntry {
 	/** In-core flag signaling that the entry should be considered as modified. */
 	private static final int UPDATE_NEEDED = 0x1;
 
+	/**
+	 * In-core flag signaling that a file system monitor reported no change to
+	 * the file since the entry was found to be unmodified.
+	 */
+	private static final int FSMONITOR_VALID = 0x2;
+
+	/**
+	 * In-core flag signaling that the entry was modified since it was read
+	 * from the shared index of a split index.
+	 */
+	private static final int UPDATE_IN_BASE = 0x4;
+
 	/** (Possibly shared) header information storage. */
-	private final byte[] info;
+	private byte[] info;
 
 	/** First location within {@link #info} where our header starts. */
-	private final int infoOffset;
+	private int infoOffset;
 
 	/** Our encoded path name, from the root of the repository. */
 	final byte[] path;
@@ -113,6 +125,12 @@ public class DirCacheEntry {
 	/** Flags which are never stored to disk. */
 	private byte inCoreFlags;
 
+	/**
+	 * Position of the entry in the shared index of a split index, plus 1; 0
+	 * if the entry is not from a shared index.
+	 */
+	int basePosition;
+
 	DirCacheEntry(byte[] sharedInfo, MutableInteger infoAt, InputStream in,
 			MessageDigest md, Instant smudge, DirCacheVersion version,
 			DirCacheEntry previous)
@@ -200,7 +218,13 @@ public class DirCacheEntry {
 		}
 
 		try {
-			checkPath(path);
+			// Entries replacing entries of a shared index have no name, the
+			// DirCache checks that it is reading a split index.
+			if (isSparseDirectory()) {
+				checkSparseDirectoryPath(path);
+			} else if (path.length > 0) {
+				checkPath(path);
+			}
 		} catch (InvalidPathException e) {
 			CorruptObjectException p =
 				new CorruptObjectException(e.getMessage());
@@ -312,6 +336,26 @@ public DirCacheEntry(byte[] path, int stage) {
 		NB.encodeInt16(info, infoOffset + P_FLAGS, flags);
 	}
 
+	/**
+	 * Create a sparse directory entry.
+	 *
+	 * @param dir
+	 *            path of the directory, without trailing '/'
+	 * @param tree
+	 *            the directory's tree
+	 */
+	DirCacheEntry(byte[] dir, AnyObjectId tree) {
+		checkPath(dir);
+		path = Arrays.copyOf(dir, dir.length + 1);
+		path[dir.length] = '/';
+		info = new byte[INFO_LEN];
+		infoOffset = 0;
+		NB.encodeInt16(info, P_FLAGS, Math.min(path.length, NAME_MASK));
+		setFileMode(FileMode.TREE.getBits());
+		setObjectId(tree);
+		setSkipWorkTree(true);
+	}
+
 	/**
 	 * Duplicate DirCacheEntry with same path and copied info.
 	 * <p>
@@ -323,10 +367,35 @@ public DirCacheEntry(byte[] path, int stage) {
 	 * @since 4.2
 	 */
 	public DirCacheEntry(DirCacheEntry src) {
+		int len = src.isExtended() ? INFO_LEN_EXTENDED : INFO_LEN;
 		path = src.path;
-		info = new byte[INFO_LEN];
+		info = new byte[len];
 		infoOffset = 0;
-		System.arraycopy(src.info, src.infoOffset, info, 0, INFO_LEN);
+		System.arraycopy(src.info, src.infoOffset, info, 0, len);
+	}
+
+	/**
+	 * Create an entry with the info of another entry, including its stage
+	 * and extended flags, under a different path.
+	 * <p>
+	 * The path is not checked, it may be empty for entries of a split index
+	 * replacing an entry of the shared index.
+	 *
+	 * @param path
+	 *            path of the new entry
+	 * @param src
+	 *            entry to copy the info from
+	 */
+	DirCacheEntry(byte[] path, DirCacheEntry src) {
+		int len = src.isExtended() ? INFO_LEN_EXTENDED : INFO_LEN;
+		this.path = path;
+		info = new byte[len];
+		infoOffset = 0;
+		System.arraycopy(src.info, src.infoOffset, info, 0, len);
+		int flags = NB.decodeUInt16(info, P_FLAGS) & ~NAME_MASK;
+		NB.encodeInt16(info, P_FLAGS,
+				flags | Math.min(path.length, NAME_MASK));
+		inCoreFlags = UPDATE_IN_BASE;
 	}
 
 	private int readNulTerminatedString(InputStream in, OutputStream out)
@@ -348,6 +417,27 @@ private int readNulTerminatedString(InputStream in, OutputStream out)
 
 	void write(OutputStream os, DirCacheVersion version, DirCacheEntry previous)
 			throws IOException {
+		write(os, version, previous, false);
+	}
+
+	/**
+	 * Write this entry.
+	 *
+	 * @param os
+	 *            stream to write to
+	 * @param version
+	 *            index format version
+	 * @param previous
+	 *            the entry written before this one, or null
+	 * @param blockStart
+	 *            whether this entry starts a block of the index entry offset
+	 *            table. Such an entry shares no path prefix with
+	 *            {@code previous}, so that the block can be read without it.
+	 * @throws IOException
+	 *             if writing fails
+	 */
+	void write(OutputStream os, DirCacheVersion version, DirCacheEntry previous,
+			boolean blockStart) throws IOException {
 		final int len = isExtended() ? INFO_LEN_EXTENDED : INFO_LEN;
 		if (version != DirCacheVersion.DIRC_VERSION_PATHCOMPRESS) {
 			os.write(info, infoOffset, len);
@@ -364,7 +454,8 @@ void write(OutputStream os, DirCacheVersion version, DirCacheEntry previous)
 			int toRemove;
 			if (previous != null) {
 				// Figure out common prefix
-				int pathLen = Math.min(path.length, previous.path.length);
+				int pathLen = blockStart ? 0
+						: Math.min(path.length, previous.path.length);
 				while (pathCommon < pathLen
 						&& path[pathCommon] == previous.path[pathCommon]) {
 					pathCommon++;
@@ -456,6 +547,7 @@ public final void smudgeRacilyClean() {
 		// racily clean
 		final int base = infoOffset + P_SIZE;
 		Arrays.fill(info, base, base + 4, (byte) 0);
+		modified();
 	}
 
 	/**
@@ -507,6 +599,7 @@ public void setAssumeValid(boolean assume) {
 			info[infoOffset + P_FLAGS] |= (byte) ASSUME_VALID;
 		else
 			info[infoOffset + P_FLAGS] &= (byte) ~ASSUME_VALID;
+		inCoreFlags |= (byte) UPDATE_IN_BASE;
 	}
 
 	/**
@@ -526,11 +619,70 @@ public boolean isUpdateNeeded() {
 	 */
 	public void setUpdateNeeded(boolean updateNeeded) {
 		if (updateNeeded)
-			inCoreFlags |= (byte) UPDATE_NEEDED;
+			inCoreFlags = (byte) ((inCoreFlags | UPDATE_NEEDED)
+					& ~FSMONITOR_VALID);
 		else
 			inCoreFlags &= (byte) ~UPDATE_NEEDED;
 	}
 
+	/**
+	 * Whether a file system monitor vouches for this entry being unmodified.
+	 * <p>
+	 * The flag is set for entries found to match their working tree file, if
+	 * the {@link FsMonitor} of the repository did not report a change to the
+	 * file since. It is stored in the index file by the 'FSMN' extension, and
+	 * cleared whenever the entry is modified.
+	 *
+	 * @return {@code true} if the entry can be assumed to match the working
+	 *         tree file without checking it
+	 * @since 6.9
+	 */
+	public boolean isFsMonitorValid() {
+		return (inCoreFlags & FSMONITOR_VALID) != 0;
+	}
+
+	/**
+	 * Set whether a file system monitor vouches for this entry being
+	 * unmodified.
+	 *
+	 * @param valid
+	 *            whether the entry can be assumed to match the working tree
+	 *            file without checking it
+	 * @since 6.9
+	 */
+	public void setFsMonitorValid(boolean valid) {
+		if (valid)
+			inCoreFlags |= (byte) FSMONITOR_VALID;
+		else
+			inCoreFlags &= (byte) ~FSMONITOR_VALID;
+	}
+
+	/**
+	 * Whether the entry was modified since it was read from the shared index
+	 * of a split index.
+	 *
+	 * @return {@code true} if the entry differs from the shared index
+	 */
+	boolean isUpdateInBase() {
+		return (inCoreFlags & UPDATE_IN_BASE) != 0;
+	}
+
+	/**
+	 * Record the position of the entry in a newly written shared index.
+	 *
+	 * @param position
+	 *            position of the entry in the shared index
+	 */
+	void setBasePosition(int position) {
+		basePosition = position + 1;
+		inCoreFlags &= (byte) ~UPDATE_IN_BASE;
+	}
+
+	private void modified() {
+		inCoreFlags = (byte) ((inCoreFlags | UPDATE_IN_BASE)
+				& ~FSMONITOR_VALID);
+	}
+
 	/**
 	 * Get the stage of this entry.
 	 * <p>
@@ -558,6 +710,7 @@ public void setStage(int stage) {
 		}
 		byte flags = info[infoOffset + P_FLAGS];
 		info[infoOffset + P_FLAGS] = (byte) ((flags & 0xCF) | (stage << 4));
+		inCoreFlags |= (byte) UPDATE_IN_BASE;
 	}
 
 	/**
@@ -569,6 +722,37 @@ public boolean isSkipWorkTree() {
 		return (getExtendedFlags() & SKIP_WORKTREE) != 0;
 	}
 
+	/**
+	 * Set whether this entry should be skipped from the working tree.
+	 * <p>
+	 * Entries outside of a sparse checkout have this flag set. Their files
+	 * are not checked out and are not considered missing.
+	 *
+	 * @param skip
+	 *            true if the file of this entry should not be in the working
+	 *            tree
+	 * @since 6.9
+	 */
+	public void setSkipWorkTree(boolean skip) {
+		int flags = getExtendedFlags();
+		setExtendedFlags(skip ? flags | SKIP_WORKTREE : flags & ~SKIP_WORKTREE);
+	}
+
+	/**
+	 * Whether this entry is a directory of a sparse index.
+	 * <p>
+	 * A sparse index replaces the entries of a directory outside of a cone
+	 * mode sparse checkout by one entry for the directory's tree. Its path
+	 * ends with '/', and it has the skip-worktree flag set. The files of the
+	 * directory are not found in the index until it is expanded.
+	 *
+	 * @return true if this entry stands for all files of a directory
+	 * @since 6.9
+	 */
+	public boolean isSparseDirectory() {
+		return (getRawMode() & FileMode.TYPE_MASK) == FileMode.TYPE_TREE;
+	}
+
 	/**
 	 * Returns whether this entry is intent to be added to the Index.
 	 *
@@ -626,10 +810,12 @@ public void setFileMode(FileMode mode) {
 					JGitText.get().invalidModeForPath, mode, getPathString()));
 		}
 		NB.encodeInt32(info, infoOffset + P_MODE, mode.getBits());
+		modified();
 	}
 
 	void setFileMode(int mode) {
 		NB.encodeInt32(info, infoOffset + P_MODE, mode);
+		modified();
 	}
 
 	/**
@@ -650,6 +836,7 @@ public long getCreationTime() {
 	 */
 	public void setCreationTime(long when) {
 		encodeTS(P_CTIME, when);
+		modified();
 	}
 
 	/**
@@ -692,6 +879,7 @@ public Instant getLastModifiedInstant() {
 	@Deprecated
 	public void setLastModified(long when) {
 		encodeTS(P_MTIME, when);
+		modified();
 	}
 
 	/**
@@ -703,6 +891,7 @@ public void setLastModified(long when) {
 	 */
 	public void setLastModified(Instant when) {
 		encodeTS(P_MTIME, when);
+		modified();
 	}
 
 	/**
@@ -735,6 +924,7 @@ public int getLength() {
 	 */
 	public void setLength(int sz) {
 		NB.encodeInt32(info, infoOffset + P_SIZE, sz);
+		modified();
 	}
 
 	/**
@@ -769,6 +959,7 @@ public ObjectId getObjectId() {
 	 */
 	public void setObjectId(AnyObjectId id) {
 		id.copyRawTo(idBuffer(), idOffset());
+		modified();
 	}
 
 	/**
@@ -783,6 +974,7 @@ public void setObjectId(AnyObjectId id) {
 	public void setObjectIdFromRaw(byte[] bs, int p) {
 		final int n = Constants.OBJECT_ID_LENGTH;
 		System.arraycopy(bs, p, idBuffer(), idOffset(), n);
+		modified();
 	}
 
 	/**
@@ -860,8 +1052,13 @@ void copyMetaData(DirCacheEntry src, boolean keepStage) {
 			pStageShifted = origflags & SHIFTED_STAGE_MASK;
 		else
 			pStageShifted = newflags & SHIFTED_STAGE_MASK;
+		// Our buffer decides whether the extended flags fit, they are copied
+		// below.
 		NB.encodeInt16(info, infoOffset + P_FLAGS, pStageShifted | pLen
-				| (newflags & ~NAME_MASK & ~SHIFTED_STAGE_MASK));
+				| (origflags & EXTENDED)
+				| (newflags & ~NAME_MASK & ~SHIFTED_STAGE_MASK & ~EXTENDED));
+		setExtendedFlags(src.getExtendedFlags());
+		modified();
 	}
 
 	/**
@@ -906,6 +1103,27 @@ private int getExtendedFlags() {
 		return 0;
 	}
 
+	private void setExtendedFlags(int flags) {
+		if (flags == getExtendedFlags()) {
+			return;
+		}
+		if (flags == 0) {
+			info[infoOffset + P_FLAGS] &= (byte) ~EXTENDED;
+		} else {
+			if (!isExtended()) {
+				// The info may be shared with other entries and have no room
+				// for the extended flags.
+				byte[] extended = new byte[INFO_LEN_EXTENDED];
+				System.arraycopy(info, infoOffset, extended, 0, INFO_LEN);
+				info = extended;
+				infoOffset = 0;
+				info[P_FLAGS] |= (byte) EXTENDED;
+			}
+			NB.encodeInt16(info, infoOffset + P_FLAGS2, flags >>> 16);
+		}
+		inCoreFlags |= (byte) UPDATE_IN_BASE;
+	}
+
 	private static void checkPath(byte[] path) {
 		try {
 			SystemReader.getInstance().checkPath(path);
@@ -916,6 +1134,14 @@ private static void checkPath(byte[] path) {
 		}
 	}
 
+	private static void checkSparseDirectoryPath(byte[] path) {
+		int len = path.length;
+		if (len < 2 || path[len - 1] != '/') {
+			throw new InvalidPathException(toString(path));
+		}
+		checkPath(Arrays.copyOf(path, len - 1));
+	}
+
 	static String toString(byte[] path) {
 		return UTF_8.decode(ByteBuffer.wrap(path)).toString();
 	}
@@ -104,15 +104,62 @@ public DirCacheIterator(DirCache dc) {
 		parseEntry();
 	}
 
+	DirCacheIterator(DirCacheIterator p, DirCache expanded) {
+		super(p, p.path, p.pathLen + 1);
+		cache = expanded;
+		tree = findTree(expanded.getCacheTree(true), p.path, p.pathLen);
+		treeStart = 0;
+		treeEnd = tree.getEntrySpan();
+		subtreeId = p.subtreeId;
+		if (!eof())
+			parseEntry();
+	}
+
+	private static DirCacheTree findTree(DirCacheTree root, byte[] path,
+			int pathLen) {
+		// The expanded cache only holds the entries of the directory.
+		int depth = 1;
+		for (int i = 0; i < pathLen; i++)
+			if (path[i] == '/')
+				depth++;
+		DirCacheTree t = root;
+		while (depth-- > 0 && t.getChildCount() > 0)
+			t = t.getChild(0);
+		return t;
+	}
+
 	@Override
 	public AbstractTreeIterator createSubtreeIterator(ObjectReader reader)
 			throws IncorrectObjectTypeException, IOException {
 		if (currentSubtree == null)
 			throw new IncorrectObjectTypeException(getEntryObjectId(),
 					Constants.TYPE_TREE);
+		if (isSparseDirectory())
+			return new DirCacheIterator(this, expandSparseDirectory(reader));
 		return new DirCacheIterator(this, currentSubtree);
 	}
 
+	/**
+	 * Whether the current entry is a sparse directory.
+	 * <p>
+	 * The files of a directory outside of the sparse checkout are not in a
+	 * sparse index, the index only has an entry for the directory's tree.
+	 * Entering such a directory reads its tree.
+	 *
+	 * @return true if the iterator is positioned on a directory collapsed by
+	 *         a sparse index
+	 * @since 6.9
+	 */
+	public boolean isSparseDirectory() {
+		return currentSubtree != null && currentSubtree.getEntrySpan() == 1
+				&& currentEntry.isSparseDirectory()
+				&& currentEntry.path.length == pathLen + 1;
+	}
+
+	DirCache expandSparseDirectory(ObjectReader reader) throws IOException {
+		return DirCache.readSparseDirectory(currentEntry, reader);
+	}
+
 	@Override
 	public EmptyTreeIterator createEmptyTreeIterator() {
 		final byte[] n = new byte[Math.max(pathLen + 1, DEFAULT_PATH_SIZE)];
@@ -470,6 +470,12 @@ void validate(final DirCacheEntry[] cache, final int cCnt, int cIdx,
 		//
 		while (stIdx < childCnt)
 			removeChild(childCnt - 1);
+
+		// A sparse directory entry stands for this whole tree.
+		//
+		if (entrySpan == 1 && firstPath.length == pathOff
+				&& cache[cIdx - 1].isSparseDirectory())
+			id = cache[cIdx - 1].getObjectId();
 	}
 
 	private void insertChild(int stIdx, DirCacheTree st) {
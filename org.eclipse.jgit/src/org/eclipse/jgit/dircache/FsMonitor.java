@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.dircache;
+
+import java.io.IOException;
+import java.util.Collection;
+import java.util.function.Function;
+
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.Repository;
+import org.eclipse.jgit.util.StringUtils;
+
+/**
+ * A file system monitor, telling which paths of a working tree changed since
+ * an earlier query.
+ * <p>
+ * Each answer carries a token identifying the point in time it is valid for.
+ * The token is stored in the 'FSMN' extension of the index, together with the
+ * entries known to be unmodified at that time, and passed to the next query.
+ * Entries whose paths were not reported as changed since then do not need to
+ * be compared to the working tree again, see
+ * {@link DirCache#refreshFsMonitor(FsMonitor)}.
+ * <p>
+ * The monitor of a repository is configured by {@code core.fsmonitor}. The
+ * value {@code true} selects the built-in {@link WatchServiceFsMonitor}, any
+ * other value which is not a boolean is the command of a hook implementing
+ * version 2 of the C Git fsmonitor hook protocol. Applications can install
+ * their own monitors with {@link #setProvider(Function)}.
+ *
+ * @since 6.9
+ */
+public abstract class FsMonitor {
+
+	/** Answer of a {@link FsMonitor}. */
+	public static final class Changes {
+		private final String token;
+
+		private final Collection<String> paths;
+
+		/**
+		 * Create an answer.
+		 *
+		 * @param token
+		 *            token to pass to the next query; null if the monitor
+		 *            cannot answer later queries
+		 * @param paths
+		 *            paths relative to the working tree which changed since
+		 *            the queried token, using '/' as separator. A directory
+		 *            stands for all paths below it. Null if the monitor
+		 *            cannot tell, and all paths must be assumed to have
+		 *            changed.
+		 */
+		public Changes(String token, Collection<String> paths) {
+			this.token = token;
+			this.paths = paths;
+		}
+
+		/**
+		 * Get the token to pass to the next query.
+		 *
+		 * @return the token identifying the time of this answer; null if the
+		 *         monitor cannot answer later queries
+		 */
+		public String getToken() {
+			return token;
+		}
+
+		/**
+		 * Get the changed paths.
+		 *
+		 * @return paths which changed since the queried token; null if all
+		 *         paths must be assumed to have changed
+		 */
+		public Collection<String> getPaths() {
+			return paths;
+		}
+	}
+
+	private static volatile Function<Repository, FsMonitor> provider;
+
+	/**
+	 * Set the provider of file system monitors, replacing the configuration
+	 * by {@code core.fsmonitor}.
+	 *
+	 * @param p
+	 *            function returning the monitor of a repository, or null if
+	 *            the repository is not monitored; null to use the
+	 *            configuration of the repository again
+	 */
+	public static void setProvider(Function<Repository, FsMonitor> p) {
+		provider = p;
+	}
+
+	/**
+	 * Get the file system monitor of a repository.
+	 *
+	 * @param repo
+	 *            the repository
+	 * @return the monitor of the repository's working tree; null if the
+	 *         repository is bare or not monitored
+	 * @throws IOException
+	 *             if the monitor could not be started
+	 */
+	public static FsMonitor get(Repository repo) throws IOException {
+		if (repo.isBare()) {
+			return null;
+		}
+		Function<Repository, FsMonitor> p = provider;
+		if (p != null) {
+			return p.apply(repo);
+		}
+		String value = repo.getConfig().getString(
+				ConfigConstants.CONFIG_CORE_SECTION, null,
+				ConfigConstants.CONFIG_KEY_FSMONITOR);
+		if (StringUtils.isEmptyOrNull(value)) {
+			return null;
+		}
+		Boolean enabled = StringUtils.toBooleanOrNull(value);
+		if (enabled == null) {
+			return new HookFsMonitor(repo, value);
+		}
+		return enabled.booleanValue() ? WatchServiceFsMonitor.get(repo) : null;
+	}
+
+	/**
+	 * Whether a repository may have a file system monitor, without starting
+	 * it.
+	 *
+	 * @param repo
+	 *            the repository
+	 * @return {@code false} if the repository is bare, or no provider is set
+	 *         and {@code core.fsmonitor} is unset or {@code false}
+	 */
+	static boolean isEnabled(Repository repo) {
+		if (repo.isBare()) {
+			return false;
+		}
+		if (provider != null) {
+			return true;
+		}
+		String value = repo.getConfig().getString(
+				ConfigConstants.CONFIG_CORE_SECTION, null,
+				ConfigConstants.CONFIG_KEY_FSMONITOR);
+		if (StringUtils.isEmptyOrNull(value)) {
+			return false;
+		}
+		Boolean enabled = StringUtils.toBooleanOrNull(value);
+		return enabled == null || enabled.booleanValue();
+	}
+
+	/**
+	 * Query the paths which changed since an earlier query.
+	 * <p>
+	 * Implementations should not fail if the monitor is not working, but
+	 * return changes without paths instead.
+	 *
+	 * @param token
+	 *            token of the earlier answer; null if there is none
+	 * @return the changes since {@code token}
+	 * @throws IOException
+	 *             if the monitor could not be queried
+	 */
+	public abstract Changes query(String token) throws IOException;
+}
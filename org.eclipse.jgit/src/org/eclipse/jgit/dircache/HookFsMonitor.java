@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.dircache;
+
+import static java.nio.charset.StandardCharsets.UTF_8;
+
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.text.MessageFormat;
+import java.util.ArrayList;
+import java.util.List;
+
+import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.lib.Constants;
+import org.eclipse.jgit.lib.Repository;
+import org.eclipse.jgit.util.FS;
+import org.eclipse.jgit.util.FS.ExecutionResult;
+import org.eclipse.jgit.util.RawParseUtils;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * A {@link FsMonitor} running a hook command, such as the
+ * {@code fsmonitor-watchman} sample hook of C Git.
+ * <p>
+ * The hook is invoked with the protocol version {@code 2} and the token of
+ * the last query as arguments. It prints the new token and the changed paths,
+ * each terminated by a NUL byte. The path {@code /} means that all paths must
+ * be assumed to have changed.
+ */
+class HookFsMonitor extends FsMonitor {
+	private static final Logger LOG = LoggerFactory
+			.getLogger(HookFsMonitor.class);
+
+	private static final String PROTOCOL_VERSION = "2"; //$NON-NLS-1$
+
+	private final Repository repo;
+
+	private final String command;
+
+	HookFsMonitor(Repository repo, String command) {
+		this.repo = repo;
+		this.command = command;
+	}
+
+	@Override
+	public Changes query(String token) throws IOException {
+		FS fs = repo.getFS();
+		ProcessBuilder pb = fs.runInShell(command, new String[] {
+				PROTOCOL_VERSION, token != null ? token : "" }); //$NON-NLS-1$
+		pb.directory(repo.getWorkTree());
+		pb.environment().put(Constants.GIT_DIR_KEY,
+				repo.getDirectory().getAbsolutePath());
+		ExecutionResult result;
+		try {
+			result = fs.execute(pb, null);
+		} catch (InterruptedException e) {
+			throw new InterruptedIOException();
+		} catch (IOException e) {
+			LOG.warn(MessageFormat.format(
+					JGitText.get().fsMonitorCannotRunHook, command), e);
+			return new Changes(null, null);
+		}
+		if (result.getRc() != 0) {
+			LOG.warn(MessageFormat.format(JGitText.get().fsMonitorHookFailed,
+					command, Integer.valueOf(result.getRc())));
+			return new Changes(null, null);
+		}
+		return parse(result.getStdout().toByteArray());
+	}
+
+	static Changes parse(byte[] out) {
+		int end = out.length;
+		int ptr = RawParseUtils.next(out, 0, '\0');
+		if (ptr == 0 || out[ptr - 1] != 0) {
+			// Without a token later queries cannot be answered either.
+			return new Changes(null, null);
+		}
+		String token = RawParseUtils.decode(UTF_8, out, 0, ptr - 1);
+		List<String> paths = new ArrayList<>();
+		while (ptr < end) {
+			int next = RawParseUtils.next(out, ptr, '\0');
+			int pathEnd = out[next - 1] == 0 ? next - 1 : next;
+			if (pathEnd > ptr) {
+				if (out[ptr] == '/') {
+					return new Changes(token, null);
+				}
+				paths.add(RawParseUtils.decode(UTF_8, out, ptr, pathEnd));
+			}
+			ptr = next;
+		}
+		return new Changes(token, paths);
+	}
+}
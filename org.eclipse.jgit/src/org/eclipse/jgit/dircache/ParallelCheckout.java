@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.dircache;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.text.MessageFormat;
+import java.util.ArrayList;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Locale;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.Future;
+import java.util.concurrent.Semaphore;
+
+import org.eclipse.jgit.api.errors.CanceledException;
+import org.eclipse.jgit.dircache.DirCacheCheckout.CheckoutMetadata;
+import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.internal.util.Workers;
+import org.eclipse.jgit.lib.FileMode;
+import org.eclipse.jgit.lib.ObjectReader;
+import org.eclipse.jgit.lib.ProgressMonitor;
+import org.eclipse.jgit.lib.Repository;
+import org.eclipse.jgit.util.LazyFetch;
+
+/**
+ * Writes the files of a checkout on several threads.
+ * <p>
+ * Entries are prepared on the calling thread in the order they are added:
+ * parent directories are created, files and directories in the way are
+ * removed, and gitlinks and symbolic links are checked out. Regular files are
+ * then written in batches by at most the given number of
+ * {@link Workers worker threads}, each using its own {@link ObjectReader}.
+ * <p>
+ * Entries run through a smudge filter, which may not be safe to run
+ * concurrently, are checked out by the calling thread once the workers are
+ * done. So are, on a case insensitive file system, entries whose path or
+ * parent directories collide with an entry added before, and all entries
+ * colliding with these, which keeps their order.
+ */
+class ParallelCheckout implements AutoCloseable {
+	/** Number of files written by a worker at once. */
+	private static final int BATCH_SIZE = 32;
+
+	private static class Item {
+		final DirCacheEntry entry;
+
+		final CheckoutMetadata metadata;
+
+		final String path;
+
+		/** File prepared for a worker; null if the entry is deferred. */
+		final File file;
+
+		Item(DirCacheEntry entry, CheckoutMetadata metadata, String path,
+				File file) {
+			this.entry = entry;
+			this.metadata = metadata;
+			this.path = path;
+			this.file = file;
+		}
+	}
+
+	private final Repository repo;
+
+	private final Checkout checkout;
+
+	private final ObjectReader reader;
+
+	private final ProgressMonitor monitor;
+
+	/** Batches which may be written concurrently. */
+	private final Semaphore slots;
+
+	/** Lower case paths of the entries added, or null. */
+	private final Set<String> folded;
+
+	/** Lower case paths of the parent directories of the entries, or null. */
+	private final Set<String> foldedDirs;
+
+	private final List<Item> deferred = new ArrayList<>();
+
+	private final List<Future<?>> futures = new ArrayList<>();
+
+	private final List<Integer> batchSizes = new ArrayList<>();
+
+	private final Set<String> written = ConcurrentHashMap.newKeySet();
+
+	private List<Item> batch = new ArrayList<>(BATCH_SIZE);
+
+	private volatile boolean failed;
+
+	/**
+	 * Create a parallel checkout.
+	 *
+	 * @param repo
+	 *            repository to check out
+	 * @param checkout
+	 *            checkout used to prepare and write the files
+	 * @param reader
+	 *            reader of the calling thread
+	 * @param workers
+	 *            maximum number of worker threads
+	 * @param monitor
+	 *            progress monitor updated for each checked out entry
+	 */
+	ParallelCheckout(Repository repo, Checkout checkout, ObjectReader reader,
+			int workers, ProgressMonitor monitor) {
+		this.repo = repo;
+		this.checkout = checkout;
+		this.reader = reader;
+		this.monitor = monitor;
+		if (repo.getFS().isCaseSensitive()) {
+			folded = null;
+			foldedDirs = null;
+		} else {
+			folded = new HashSet<>();
+			foldedDirs = new HashSet<>();
+		}
+		this.slots = new Semaphore(workers);
+	}
+
+	/**
+	 * Check out an entry.
+	 *
+	 * @param entry
+	 *            entry to check out
+	 * @param metadata
+	 *            metadata for CR/LF handling and smudge filtering
+	 * @param path
+	 *            path of the entry
+	 * @throws IOException
+	 *             if the entry cannot be checked out
+	 */
+	void add(DirCacheEntry entry, CheckoutMetadata metadata, String path)
+			throws IOException {
+		boolean collides = folded != null && collides(path);
+		if (collides
+				|| metadata != null && metadata.smudgeFilterCommand != null) {
+			deferred.add(new Item(entry, metadata, path, null));
+			return;
+		}
+		if (FileMode.GITLINK.equals(entry.getRawMode())
+				|| checkout.isSymLink(entry)) {
+			checkoutNow(entry, metadata, path);
+			return;
+		}
+		batch.add(new Item(entry, metadata, path,
+				checkout.prepareFile(path)));
+		if (batch.size() == BATCH_SIZE) {
+			submit();
+		}
+	}
+
+	/**
+	 * Record the path of an entry on a case insensitive file system.
+	 *
+	 * @return {@code true} if the path, or one of its parent directories,
+	 *         differs only in case from an entry or a directory added before
+	 */
+	private boolean collides(String path) {
+		String lower = path.toLowerCase(Locale.ROOT);
+		boolean collides = !folded.add(lower) || foldedDirs.contains(lower);
+		for (int i = lower.indexOf('/'); i >= 0; i = lower.indexOf('/',
+				i + 1)) {
+			String dir = lower.substring(0, i);
+			collides |= folded.contains(dir);
+			foldedDirs.add(dir);
+		}
+		return collides;
+	}
+
+	private void checkoutNow(DirCacheEntry entry, CheckoutMetadata metadata,
+			String path) throws IOException {
+		if (FileMode.GITLINK.equals(entry.getRawMode())) {
+			checkout.checkoutGitlink(entry, path);
+		} else if (checkout.isSymLink(entry)) {
+			checkout.checkout(entry, metadata, reader, path);
+		} else {
+			checkout.writeFile(entry, metadata,
+					reader.open(entry.getObjectId()), path,
+					checkout.prepareFile(path));
+		}
+		written.add(path);
+		monitor.update(1);
+	}
+
+	private void submit() throws InterruptedIOException {
+		List<Item> items = batch;
+		batch = new ArrayList<>(BATCH_SIZE);
+		// Wait for a worker to be free, the entries prepared meanwhile would
+		// only queue up.
+		try {
+			slots.acquire();
+		} catch (InterruptedException e) {
+			throw new InterruptedIOException();
+		}
+		try {
+			futures.add(Workers.getExecutor()
+					.submit(LazyFetch.inherit(() -> {
+						try {
+							write(items);
+						} finally {
+							slots.release();
+						}
+						return null;
+					})));
+		} catch (RuntimeException e) {
+			slots.release();
+			throw e;
+		}
+		batchSizes.add(Integer.valueOf(items.size()));
+	}
+
+	private void write(List<Item> items) throws IOException {
+		try (ObjectReader r = repo.newObjectReader()) {
+			for (Item item : items) {
+				if (failed) {
+					return;
+				}
+				try {
+					checkout.writeFile(item.entry, item.metadata,
+							r.open(item.entry.getObjectId()), item.path,
+							item.file);
+				} catch (IOException | RuntimeException e) {
+					failed = true;
+					throw e;
+				}
+				written.add(item.path);
+			}
+		}
+	}
+
+	/**
+	 * Wait until all entries are checked out.
+	 *
+	 * @throws IOException
+	 *             if an entry could not be checked out
+	 * @throws CanceledException
+	 *             if the monitor was cancelled
+	 */
+	void finish() throws IOException, CanceledException {
+		if (!batch.isEmpty()) {
+			submit();
+		}
+		for (int i = 0; i < futures.size(); i++) {
+			try {
+				Workers.join(futures.get(i));
+			} catch (InterruptedException e) {
+				throw new InterruptedIOException();
+			}
+			monitor.update(batchSizes.get(i).intValue());
+			checkCancelled();
+		}
+		for (Item item : deferred) {
+			checkoutNow(item.entry, item.metadata, item.path);
+			checkCancelled();
+		}
+	}
+
+	private void checkCancelled() throws CanceledException {
+		if (monitor.isCancelled()) {
+			throw new CanceledException(MessageFormat.format(
+					JGitText.get().operationCanceled,
+					JGitText.get().checkingOutFiles));
+		}
+	}
+
+	/**
+	 * Whether an entry has been checked out.
+	 * <p>
+	 * After a failure, this is only accurate once the checkout is closed.
+	 *
+	 * @param path
+	 *            path of the entry
+	 * @return {@code true} if the entry has been checked out
+	 */
+	boolean isWritten(String path) {
+		return written.contains(path);
+	}
+
+	/**
+	 * Stop the workers, waiting for files being written.
+	 */
+	@Override
+	public void close() {
+		failed = true;
+		boolean interrupted = false;
+		for (Future<?> f : futures) {
+			for (;;) {
+				try {
+					f.get();
+					break;
+				} catch (InterruptedException e) {
+					interrupted = true;
+				} catch (ExecutionException e) {
+					// Reported by finish()
+					break;
+				}
+			}
+		}
+		if (interrupted) {
+			Thread.currentThread().interrupt();
+		}
+	}
+}
@@ -0,0 +1,371 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.dircache;
+
+import static java.nio.charset.StandardCharsets.UTF_8;
+
+import java.io.ByteArrayInputStream;
+import java.io.File;
+import java.io.IOException;
+import java.nio.file.Files;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collection;
+import java.util.Collections;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Set;
+import java.util.TreeSet;
+
+import org.eclipse.jgit.errors.LockFailedException;
+import org.eclipse.jgit.ignore.IgnoreNode;
+import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.internal.storage.file.LockFile;
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.Constants;
+import org.eclipse.jgit.lib.Repository;
+import org.eclipse.jgit.lib.StoredConfig;
+import org.eclipse.jgit.util.FileUtils;
+
+/**
+ * The paths of a sparse checkout.
+ * <p>
+ * If {@code core.sparseCheckout} is enabled, only the paths selected by the
+ * patterns in {@code $GIT_DIR/info/sparse-checkout} are checked out. The index
+ * entries of all other paths have the skip-worktree flag set: their files are
+ * not written, and not reported as missing.
+ * <p>
+ * In cone mode, enabled by {@code core.sparseCheckoutCone} which defaults to
+ * true, the patterns select directories. The files of the root directory are
+ * always checked out, as are all files below a selected directory and the
+ * files directly in the parent directories of a selected directory. Pattern
+ * files which do not follow the cone format are matched like gitignore files,
+ * selecting the matching paths.
+ *
+ * @since 6.9
+ */
+public class SparseCheckout {
+	private static final String ALL_ROOT_FILES = "/*"; //$NON-NLS-1$
+
+	private static final String NO_ROOT_DIRECTORIES = "!/*/"; //$NON-NLS-1$
+
+	private static final String NO_DIRECTORIES = "/*/"; //$NON-NLS-1$
+
+	/**
+	 * Get the sparse checkout of a repository.
+	 *
+	 * @param repo
+	 *            the repository
+	 * @return the sparse checkout of the repository's working tree; null if
+	 *         the repository is bare, sparse checkout is not enabled or no
+	 *         patterns are defined
+	 * @throws IOException
+	 *             if the patterns cannot be read
+	 */
+	public static SparseCheckout get(Repository repo) throws IOException {
+		if (repo.isBare() || !repo.getConfig().getBoolean(
+				ConfigConstants.CONFIG_CORE_SECTION,
+				ConfigConstants.CONFIG_KEY_SPARSE_CHECKOUT, false)) {
+			return null;
+		}
+		File file = getFile(repo);
+		if (!file.isFile()) {
+			return null;
+		}
+		byte[] raw = Files.readAllBytes(file.toPath());
+		if (repo.getConfig().getBoolean(ConfigConstants.CONFIG_CORE_SECTION,
+				ConfigConstants.CONFIG_KEY_SPARSE_CHECKOUT_CONE, true)) {
+			SparseCheckout cone = parseCone(
+					Arrays.asList(new String(raw, UTF_8).split("\n"))); //$NON-NLS-1$
+			if (cone != null) {
+				return cone;
+			}
+		}
+		IgnoreNode patterns = new IgnoreNode();
+		patterns.parse(file.getPath(), new ByteArrayInputStream(raw));
+		return new SparseCheckout(patterns);
+	}
+
+	/**
+	 * Create a cone mode sparse checkout.
+	 *
+	 * @param directories
+	 *            paths of the directories to check out, using '/' as
+	 *            separator
+	 * @return a sparse checkout of the given directories
+	 */
+	public static SparseCheckout cone(Collection<String> directories) {
+		Set<String> recursive = new TreeSet<>();
+		for (String dir : directories) {
+			String d = trimSlashes(dir);
+			if (!d.isEmpty()) {
+				recursive.add(d);
+			}
+		}
+		Set<String> parents = new HashSet<>();
+		parents.add(""); //$NON-NLS-1$
+		for (String dir : recursive) {
+			for (int s = dir.indexOf('/'); s > 0; s = dir.indexOf('/', s + 1)) {
+				parents.add(dir.substring(0, s));
+			}
+		}
+		SparseCheckout cone = new SparseCheckout(recursive, parents);
+		// Directories below a selected directory are selected anyway.
+		recursive.removeIf(d -> cone.isBelowRecursive(d));
+		parents.removeIf(d -> cone.isBelowRecursive(d + '/'));
+		return cone;
+	}
+
+	private static SparseCheckout parseCone(List<String> lines) {
+		Set<String> recursive = new TreeSet<>();
+		Set<String> parents = new HashSet<>();
+		parents.add(""); //$NON-NLS-1$
+		for (String raw : lines) {
+			String line = raw.trim();
+			if (line.isEmpty() || line.startsWith("#") //$NON-NLS-1$
+					|| line.equals(ALL_ROOT_FILES)
+					|| line.equals(NO_ROOT_DIRECTORIES)) {
+				continue;
+			}
+			boolean negated = line.startsWith("!"); //$NON-NLS-1$
+			String pattern = negated ? line.substring(1) : line;
+			if (!pattern.startsWith("/") || !pattern.endsWith("/")) { //$NON-NLS-1$ //$NON-NLS-2$
+				return null;
+			}
+			if (negated) {
+				// "!/dir/*/" limits "/dir/" to the files directly in it.
+				if (!pattern.endsWith(NO_DIRECTORIES)) {
+					return null;
+				}
+				String dir = unescape(pattern.substring(1,
+						pattern.length() - NO_DIRECTORIES.length()));
+				if (dir == null || !recursive.remove(dir)) {
+					return null;
+				}
+				parents.add(dir);
+			} else {
+				String dir = unescape(
+						pattern.substring(1, pattern.length() - 1));
+				if (dir == null || dir.isEmpty()) {
+					return null;
+				}
+				recursive.add(dir);
+			}
+		}
+		return new SparseCheckout(recursive, parents);
+	}
+
+	private static String unescape(String pattern) {
+		StringBuilder b = new StringBuilder(pattern.length());
+		for (int i = 0; i < pattern.length(); i++) {
+			char c = pattern.charAt(i);
+			if (c == '\\' && i + 1 < pattern.length()) {
+				c = pattern.charAt(++i);
+			} else if (c == '*' || c == '?' || c == '[') {
+				// Wildcards are not allowed in cone mode.
+				return null;
+			}
+			b.append(c);
+		}
+		return b.toString();
+	}
+
+	private static String escape(String path) {
+		StringBuilder b = new StringBuilder(path.length());
+		for (int i = 0; i < path.length(); i++) {
+			char c = path.charAt(i);
+			if (c == '\\' || c == '*' || c == '?' || c == '[') {
+				b.append('\\');
+			}
+			b.append(c);
+		}
+		return b.toString();
+	}
+
+	private static String trimSlashes(String path) {
+		int start = 0;
+		int end = path.length();
+		while (start < end && path.charAt(start) == '/') {
+			start++;
+		}
+		while (end > start && path.charAt(end - 1) == '/') {
+			end--;
+		}
+		return path.substring(start, end);
+	}
+
+	private static File getFile(Repository repo) {
+		return repo.getFS().resolve(repo.getDirectory(),
+				Constants.INFO_SPARSE_CHECKOUT);
+	}
+
+	/** Directories checked out with all their content, in cone mode. */
+	private final Set<String> recursive;
+
+	/** Directories whose direct files are checked out, in cone mode. */
+	private final Set<String> parents;
+
+	/** Patterns of a sparse checkout not in cone mode. */
+	private final IgnoreNode patterns;
+
+	private SparseCheckout(Set<String> recursive, Set<String> parents) {
+		this.recursive = recursive;
+		this.parents = parents;
+		this.patterns = null;
+	}
+
+	private SparseCheckout(IgnoreNode patterns) {
+		this.recursive = Collections.emptySet();
+		this.parents = Collections.emptySet();
+		this.patterns = patterns;
+	}
+
+	/**
+	 * Whether the patterns of this sparse checkout are in cone mode.
+	 *
+	 * @return true if this sparse checkout selects directories
+	 */
+	public boolean isCone() {
+		return patterns == null;
+	}
+
+	/**
+	 * Get the directories selected by a cone mode sparse checkout.
+	 *
+	 * @return sorted paths of the directories checked out with all their
+	 *         content; empty if not in cone mode
+	 */
+	public Collection<String> getDirectories() {
+		return Collections.unmodifiableSet(recursive);
+	}
+
+	/**
+	 * Whether a file is checked out.
+	 *
+	 * @param path
+	 *            path of the file, using '/' as separator
+	 * @return true if the file is part of the sparse checkout
+	 */
+	public boolean isIncluded(String path) {
+		if (patterns != null) {
+			return matches(path);
+		}
+		int s = path.lastIndexOf('/');
+		if (s < 0 || parents.contains(path.substring(0, s))) {
+			return true;
+		}
+		return isBelowRecursive(path);
+	}
+
+	/**
+	 * Whether a directory is entirely outside of the sparse checkout.
+	 * <p>
+	 * Only cone mode sparse checkouts select whole directories. A sparse
+	 * index collapses the entries of such directories into one entry.
+	 *
+	 * @param dir
+	 *            path of the directory, using '/' as separator, without
+	 *            trailing '/'
+	 * @return true if no file below the directory is checked out
+	 */
+	public boolean isSparseDirectory(String dir) {
+		return patterns == null && !parents.contains(dir)
+				&& !isBelowRecursive(dir + '/');
+	}
+
+	private boolean isBelowRecursive(String path) {
+		for (int s = path.indexOf('/'); s > 0; s = path.indexOf('/', s + 1)) {
+			if (recursive.contains(path.substring(0, s))) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	private boolean matches(String path) {
+		// The match of the closest directory decides for the paths below it,
+		// unless the path itself is matched.
+		String p = path;
+		boolean dir = false;
+		for (;;) {
+			Boolean match = patterns.checkIgnored(p, dir);
+			if (match != null) {
+				return match.booleanValue();
+			}
+			int s = p.lastIndexOf('/');
+			if (s < 0) {
+				return false;
+			}
+			p = p.substring(0, s);
+			dir = true;
+		}
+	}
+
+	/**
+	 * Write the patterns of a cone mode sparse checkout to a repository and
+	 * enable sparse checkout in its configuration.
+	 * <p>
+	 * The working tree is not updated, a following checkout moves it to the
+	 * new sparse checkout.
+	 *
+	 * @param repo
+	 *            the repository
+	 * @throws IOException
+	 *             if the patterns or the configuration cannot be written
+	 * @throws IllegalStateException
+	 *             if this sparse checkout is not in cone mode
+	 */
+	public void write(Repository repo) throws IOException {
+		if (!isCone()) {
+			throw new IllegalStateException(
+					JGitText.get().sparseCheckoutNotCone);
+		}
+		Set<String> dirs = new TreeSet<>(recursive);
+		dirs.addAll(parents);
+		dirs.remove(""); //$NON-NLS-1$
+		List<String> lines = new ArrayList<>();
+		lines.add(ALL_ROOT_FILES);
+		lines.add(NO_ROOT_DIRECTORIES);
+		for (String dir : dirs) {
+			String pattern = '/' + escape(dir) + '/';
+			lines.add(pattern);
+			if (parents.contains(dir)) {
+				lines.add('!' + pattern + "*/"); //$NON-NLS-1$
+			}
+		}
+		StringBuilder b = new StringBuilder();
+		for (String line : lines) {
+			b.append(line).append('\n');
+		}
+
+		File file = getFile(repo);
+		FileUtils.mkdirs(file.getParentFile(), true);
+		LockFile lock = new LockFile(file);
+		if (!lock.lock()) {
+			throw new LockFailedException(file);
+		}
+		try {
+			lock.write(b.toString().getBytes(UTF_8));
+			if (!lock.commit()) {
+				throw new LockFailedException(file);
+			}
+		} finally {
+			lock.unlock();
+		}
+
+		StoredConfig config = repo.getConfig();
+		config.setBoolean(ConfigConstants.CONFIG_CORE_SECTION, null,
+				ConfigConstants.CONFIG_KEY_SPARSE_CHECKOUT, true);
+		config.setBoolean(ConfigConstants.CONFIG_CORE_SECTION, null,
+				ConfigConstants.CONFIG_KEY_SPARSE_CHECKOUT_CONE, true);
+		config.save();
+	}
+}
@@ -0,0 +1,661 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.dircache;
+
+import static java.nio.charset.StandardCharsets.UTF_8;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.File;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.nio.file.Files;
+import java.nio.file.NoSuchFileException;
+import java.nio.file.Path;
+import java.time.Instant;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Set;
+
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.Constants;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.lib.ObjectInserter;
+import org.eclipse.jgit.lib.Repository;
+import org.eclipse.jgit.util.FS;
+import org.eclipse.jgit.util.MutableInteger;
+import org.eclipse.jgit.util.NB;
+import org.eclipse.jgit.util.RawParseUtils;
+import org.eclipse.jgit.util.SystemReader;
+
+import com.googlecode.javaewah.EWAHCompressedBitmap;
+import com.googlecode.javaewah.IntIterator;
+
+/**
+ * The untracked cache, stored in the 'UNTR' extension of a
+ * {@link org.eclipse.jgit.dircache.DirCache}.
+ * <p>
+ * For every directory of the working tree the cache records the stat data of
+ * the directory, the object id of its {@code .gitignore} file, and the names
+ * of the entries in it which are neither tracked nor ignored. Untracked
+ * directories are recorded with a trailing {@code '/'}. As long as the
+ * directory and the ignore rules that apply to it are unchanged, all other
+ * entries not in the index are known to be ignored, and the ignore rules do
+ * not have to be evaluated again.
+ * <p>
+ * The on-disk format is the one of C Git. C Git and JGit record the entries
+ * of different directory listings though, so each discards the directories
+ * recorded by the other one.
+ *
+ * @since 6.9
+ */
+public class UntrackedCache {
+	/** Size of the stat data recorded for a file or directory. */
+	private static final int STAT_SIZE = 36;
+
+	/**
+	 * Flags of the directory listing the cache is recorded for. JGit lists
+	 * every untracked file, which corresponds to no flags in C Git.
+	 */
+	private static final int DIR_FLAGS = 0;
+
+	private static final byte[] NO_STAT = new byte[STAT_SIZE];
+
+	private byte[] ident;
+
+	private byte[] infoExcludeStat = NO_STAT;
+
+	private byte[] excludesFileStat = NO_STAT;
+
+	private int dirFlags = DIR_FLAGS;
+
+	private ObjectId infoExcludeId = ObjectId.zeroId();
+
+	private ObjectId excludesFileId = ObjectId.zeroId();
+
+	private String excludePerDir = Constants.DOT_GIT_IGNORE;
+
+	private Directory root;
+
+	/** Modification time of the index the cache was read from. */
+	private Instant timestamp;
+
+	private boolean changed;
+
+	/**
+	 * Create an empty untracked cache.
+	 */
+	public UntrackedCache() {
+		ident = new byte[0];
+		changed = true;
+	}
+
+	/**
+	 * Parse the content of the 'UNTR' extension.
+	 *
+	 * @param raw
+	 *            buffer holding the extension
+	 * @param ptr
+	 *            position of the extension content in {@code raw}
+	 * @param end
+	 *            end of the extension content in {@code raw}
+	 * @param indexTime
+	 *            modification time of the index file; directories modified
+	 *            at or after this time are not trusted
+	 * @return the untracked cache, or {@code null} if the extension is not
+	 *         valid. Like C Git, a broken cache is silently dropped.
+	 */
+	static UntrackedCache parse(byte[] raw, int ptr, int end,
+			Instant indexTime) {
+		try {
+			return new UntrackedCache(raw, ptr, end, indexTime);
+		} catch (IOException | RuntimeException e) {
+			return null;
+		}
+	}
+
+	private UntrackedCache(byte[] raw, int ptr, int end, Instant indexTime)
+			throws IOException {
+		if (end - ptr <= 1 || raw[end - 1] != 0) {
+			throw new IOException();
+		}
+		end--;
+		MutableInteger p = new MutableInteger();
+		p.value = ptr;
+		int identLen = (int) decodeVarint(raw, p);
+		ident = Arrays.copyOfRange(raw, p.value, p.value + identLen);
+		p.value += identLen;
+
+		infoExcludeStat = Arrays.copyOfRange(raw, p.value,
+				p.value + STAT_SIZE);
+		excludesFileStat = Arrays.copyOfRange(raw, p.value + STAT_SIZE,
+				p.value + 2 * STAT_SIZE);
+		dirFlags = NB.decodeInt32(raw, p.value + 2 * STAT_SIZE);
+		p.value += 2 * STAT_SIZE + 4;
+		infoExcludeId = ObjectId.fromRaw(raw, p.value);
+		excludesFileId = ObjectId.fromRaw(raw,
+				p.value + Constants.OBJECT_ID_LENGTH);
+		p.value += 2 * Constants.OBJECT_ID_LENGTH;
+		excludePerDir = readString(raw, p, end);
+		timestamp = indexTime;
+		if (p.value >= end) {
+			return;
+		}
+
+		long dirCount = decodeVarint(raw, p);
+		if (dirCount <= 0) {
+			return;
+		}
+		if (dirCount > end - p.value) {
+			throw new IOException();
+		}
+		List<Directory> dirs = new ArrayList<>((int) dirCount);
+		root = readDirectory(raw, p, end, dirs);
+		if (dirs.size() != dirCount) {
+			throw new IOException();
+		}
+
+		DataInputStream in = new DataInputStream(new ByteArrayInputStream(
+				raw, p.value, end - p.value));
+		EWAHCompressedBitmap valid = readBitmap(in);
+		EWAHCompressedBitmap checkOnly = readBitmap(in);
+		EWAHCompressedBitmap excludeValid = readBitmap(in);
+		p.value = end - in.available();
+		for (IntIterator i = valid.intIterator(); i.hasNext();) {
+			Directory d = dirs.get(i.next());
+			d.stat = Arrays.copyOfRange(raw, p.value, p.value + STAT_SIZE);
+			p.value += STAT_SIZE;
+		}
+		for (IntIterator i = checkOnly.intIterator(); i.hasNext();) {
+			dirs.get(i.next()).checkOnly = true;
+		}
+		for (IntIterator i = excludeValid.intIterator(); i.hasNext();) {
+			Directory d = dirs.get(i.next());
+			d.excludeId = ObjectId.fromRaw(raw, p.value);
+			p.value += Constants.OBJECT_ID_LENGTH;
+		}
+		if (p.value > end) {
+			throw new IOException();
+		}
+	}
+
+	private Directory readDirectory(byte[] raw, MutableInteger p, int end,
+			List<Directory> dirs) throws IOException {
+		long untrackedCount = decodeVarint(raw, p);
+		long dirCount = decodeVarint(raw, p);
+		if (untrackedCount > end - p.value || dirCount > end - p.value) {
+			throw new IOException();
+		}
+		Directory d = new Directory(this, readString(raw, p, end));
+		dirs.add(d);
+		d.untracked = new ArrayList<>((int) untrackedCount);
+		for (int i = 0; i < untrackedCount; i++) {
+			d.untracked.add(readString(raw, p, end));
+		}
+		d.dirs = new ArrayList<>((int) dirCount);
+		for (int i = 0; i < dirCount; i++) {
+			d.dirs.add(readDirectory(raw, p, end, dirs));
+		}
+		return d;
+	}
+
+	private static String readString(byte[] raw, MutableInteger p, int end)
+			throws IOException {
+		int nul = RawParseUtils.next(raw, p.value, '\0') - 1;
+		if (nul >= end || raw[nul] != 0) {
+			throw new IOException();
+		}
+		String s = RawParseUtils.decode(UTF_8, raw, p.value, nul);
+		p.value = nul + 1;
+		return s;
+	}
+
+	private static EWAHCompressedBitmap readBitmap(DataInputStream in)
+			throws IOException {
+		EWAHCompressedBitmap bitmap = new EWAHCompressedBitmap();
+		bitmap.deserialize(in);
+		return bitmap;
+	}
+
+	private static long decodeVarint(byte[] raw, MutableInteger p) {
+		int c = raw[p.value++];
+		long val = c & 0x7f;
+		while ((c & 0x80) != 0) {
+			val++;
+			c = raw[p.value++];
+			val = (val << 7) | (c & 0x7f);
+		}
+		return val;
+	}
+
+	private static void encodeVarint(OutputStream out, long val)
+			throws IOException {
+		byte[] buf = new byte[16];
+		int n = buf.length;
+		buf[--n] = (byte) (val & 0x7f);
+		while ((val >>>= 7) != 0) {
+			buf[--n] = (byte) (0x80 | (--val & 0x7f));
+		}
+		out.write(buf, n, buf.length - n);
+	}
+
+	/**
+	 * Write the content of the 'UNTR' extension.
+	 *
+	 * @param out
+	 *            stream to write the extension content to
+	 * @throws IOException
+	 *             if writing fails
+	 */
+	void write(OutputStream out) throws IOException {
+		encodeVarint(out, ident.length);
+		out.write(ident);
+		out.write(infoExcludeStat);
+		out.write(excludesFileStat);
+		byte[] tmp = new byte[4];
+		NB.encodeInt32(tmp, 0, dirFlags);
+		out.write(tmp);
+		infoExcludeId.copyRawTo(out);
+		excludesFileId.copyRawTo(out);
+		out.write(Constants.encode(excludePerDir));
+		out.write(0);
+		if (root == null) {
+			encodeVarint(out, 0);
+			return;
+		}
+
+		List<Directory> dirs = new ArrayList<>();
+		ByteArrayOutputStream names = new ByteArrayOutputStream();
+		writeDirectory(root, names, dirs);
+		encodeVarint(out, dirs.size());
+		names.writeTo(out);
+
+		EWAHCompressedBitmap valid = new EWAHCompressedBitmap();
+		EWAHCompressedBitmap checkOnly = new EWAHCompressedBitmap();
+		EWAHCompressedBitmap excludeValid = new EWAHCompressedBitmap();
+		for (int i = 0; i < dirs.size(); i++) {
+			Directory d = dirs.get(i);
+			if (d.stat != null) {
+				valid.set(i);
+			}
+			if (d.checkOnly) {
+				checkOnly.set(i);
+			}
+			if (d.excludeId != null) {
+				excludeValid.set(i);
+			}
+		}
+		DataOutputStream dataOut = new DataOutputStream(out);
+		valid.serialize(dataOut);
+		checkOnly.serialize(dataOut);
+		excludeValid.serialize(dataOut);
+		dataOut.flush();
+		for (Directory d : dirs) {
+			if (d.stat != null) {
+				out.write(d.stat);
+			}
+		}
+		for (Directory d : dirs) {
+			if (d.excludeId != null) {
+				d.excludeId.copyRawTo(out);
+			}
+		}
+		out.write(0);
+	}
+
+	private static void writeDirectory(Directory d, OutputStream out,
+			List<Directory> dirs) throws IOException {
+		dirs.add(d);
+		List<String> untracked = d.stat != null ? d.untracked
+				: Collections.emptyList();
+		encodeVarint(out, untracked.size());
+		encodeVarint(out, d.dirs.size());
+		out.write(Constants.encode(d.name));
+		out.write(0);
+		for (String name : untracked) {
+			out.write(Constants.encode(name));
+			out.write(0);
+		}
+		for (Directory child : d.dirs) {
+			writeDirectory(child, out, dirs);
+		}
+	}
+
+	/**
+	 * Prepare the cache to be used with the working tree of a repository.
+	 * <p>
+	 * If the cache was recorded for another working tree, or if the global
+	 * ignore rules in {@code $GIT_DIR/info/exclude} or
+	 * {@code core.excludesFile} changed, all recorded directories are
+	 * dropped.
+	 *
+	 * @param repository
+	 *            the repository the cache belongs to
+	 * @throws IOException
+	 *             if the global ignore files cannot be read
+	 */
+	public void prepare(Repository repository) throws IOException {
+		FS fs = repository.getFS();
+		byte[] id = Constants.encode("Location " //$NON-NLS-1$
+				+ repository.getWorkTree().getAbsolutePath() + ", system " //$NON-NLS-1$
+				+ SystemReader.getInstance().getProperty("os.name") + '\0'); //$NON-NLS-1$
+		Path excludesFile = repository.getConfig().getPath(
+				ConfigConstants.CONFIG_CORE_SECTION, null,
+				ConfigConstants.CONFIG_KEY_EXCLUDESFILE, fs, null, null);
+		if (excludesFile == null) {
+			Path xdg = SystemReader.getInstance().getXdgConfigDirectory(fs);
+			if (xdg != null) {
+				excludesFile = xdg.resolve("git").resolve("ignore"); //$NON-NLS-1$ //$NON-NLS-2$
+			}
+		}
+		File infoExclude = fs.resolve(repository.getDirectory(),
+				Constants.INFO_EXCLUDE);
+		ObjectId newInfoExcludeId = idOf(infoExclude.toPath());
+		ObjectId newExcludesFileId = idOf(excludesFile);
+		if (Arrays.equals(ident, id) && dirFlags == DIR_FLAGS
+				&& Constants.DOT_GIT_IGNORE.equals(excludePerDir)
+				&& infoExcludeId.equals(newInfoExcludeId)
+				&& excludesFileId.equals(newExcludesFileId)) {
+			return;
+		}
+		ident = id;
+		dirFlags = DIR_FLAGS;
+		excludePerDir = Constants.DOT_GIT_IGNORE;
+		infoExcludeId = newInfoExcludeId;
+		infoExcludeStat = statOf(fs, infoExclude);
+		excludesFileId = newExcludesFileId;
+		excludesFileStat = excludesFile != null
+				? statOf(fs, excludesFile.toFile())
+				: NO_STAT;
+		root = null;
+		changed = true;
+	}
+
+	private static ObjectId idOf(Path file) throws IOException {
+		if (file == null) {
+			return ObjectId.zeroId();
+		}
+		byte[] data;
+		try {
+			data = Files.readAllBytes(file);
+		} catch (NoSuchFileException e) {
+			return ObjectId.zeroId();
+		}
+		return idOf(data);
+	}
+
+	/**
+	 * Compute the id recorded for the content of an ignore file.
+	 *
+	 * @param data
+	 *            content of the file
+	 * @return the blob id of {@code data}
+	 */
+	public static ObjectId idOf(byte[] data) {
+		try (ObjectInserter.Formatter f = new ObjectInserter.Formatter()) {
+			return f.idFor(Constants.OBJ_BLOB, data);
+		}
+	}
+
+	private static byte[] statOf(FS fs, File file) {
+		FS.Attributes attrs = fs.getAttributes(file);
+		if (!attrs.isRegularFile()) {
+			return NO_STAT;
+		}
+		return stat(attrs.getLastModifiedInstant(), attrs.getLength());
+	}
+
+	/**
+	 * Encode the stat data JGit can compare. Change and inode data are not
+	 * available and recorded as 0.
+	 */
+	private static byte[] stat(Instant lastModified, long length) {
+		byte[] stat = new byte[STAT_SIZE];
+		NB.encodeInt32(stat, 8, (int) lastModified.getEpochSecond());
+		NB.encodeInt32(stat, 12, lastModified.getNano());
+		NB.encodeInt32(stat, 32, (int) length);
+		return stat;
+	}
+
+	/**
+	 * Get the directory recorded for the root of the working tree.
+	 *
+	 * @return the root directory, created if necessary
+	 */
+	public Directory getRoot() {
+		if (root == null) {
+			root = new Directory(this, ""); //$NON-NLS-1$
+			changed = true;
+		}
+		return root;
+	}
+
+	/**
+	 * Whether the cache was modified since it was read.
+	 *
+	 * @return {@code true} if the cache has to be written to the index
+	 */
+	public boolean isChanged() {
+		return changed;
+	}
+
+	/**
+	 * Invalidate the directories containing a path whose presence in the
+	 * index changed.
+	 * <p>
+	 * The parent directories are invalidated as well, since the path may
+	 * have been the last tracked file of one of them.
+	 *
+	 * @param path
+	 *            path of the added or removed index entry
+	 */
+	void invalidate(byte[] path) {
+		Directory d = root;
+		int ptr = 0;
+		while (d != null) {
+			d.invalidate();
+			int slash = RawParseUtils.next(path, ptr, '/');
+			if (slash > path.length || path[slash - 1] != '/') {
+				return;
+			}
+			d = d.getDirectory(RawParseUtils.decode(UTF_8, path, ptr,
+					slash - 1));
+			ptr = slash;
+		}
+	}
+
+	/**
+	 * A directory recorded in the untracked cache.
+	 *
+	 * @since 6.9
+	 */
+	public static final class Directory {
+		private final UntrackedCache cache;
+
+		private final String name;
+
+		private List<String> untracked = new ArrayList<>();
+
+		private Set<String> untrackedSet;
+
+		private List<Directory> dirs = new ArrayList<>();
+
+		/** Stat data of the directory; null if the entry is not valid. */
+		private byte[] stat;
+
+		private boolean checkOnly;
+
+		/** Id of the per-directory ignore file; null if there is none. */
+		private ObjectId excludeId;
+
+		Directory(UntrackedCache cache, String name) {
+			this.cache = cache;
+			this.name = name;
+		}
+
+		/**
+		 * Get the name of this directory.
+		 *
+		 * @return name of the directory in its parent; the empty string for
+		 *         the root of the working tree
+		 */
+		public String getName() {
+			return name;
+		}
+
+		/**
+		 * Get the untracked entries recorded for this directory.
+		 *
+		 * @return names of the untracked entries. Names of directories end
+		 *         with {@code '/'}.
+		 */
+		public List<String> getUntracked() {
+			return Collections.unmodifiableList(untracked);
+		}
+
+		/**
+		 * Get a sub-directory.
+		 *
+		 * @param dirName
+		 *            name of the sub-directory
+		 * @return the recorded sub-directory, or {@code null}
+		 */
+		public Directory getDirectory(String dirName) {
+			for (Directory d : dirs) {
+				if (d.name.equals(dirName)) {
+					return d;
+				}
+			}
+			return null;
+		}
+
+		/**
+		 * Get a sub-directory, adding it to the cache if necessary.
+		 *
+		 * @param dirName
+		 *            name of the sub-directory
+		 * @return the sub-directory
+		 */
+		public Directory getOrAddDirectory(String dirName) {
+			Directory d = getDirectory(dirName);
+			if (d == null) {
+				d = new Directory(cache, dirName);
+				dirs.add(d);
+				cache.changed = true;
+			}
+			return d;
+		}
+
+		/**
+		 * Get the id of the per-directory ignore file the untracked entries
+		 * were recorded with.
+		 *
+		 * @return id of the ignore file, or {@code null} if there was none
+		 */
+		public ObjectId getIgnoreFileId() {
+			return excludeId;
+		}
+
+		/**
+		 * Whether the recorded untracked entries are still complete.
+		 *
+		 * @param lastModified
+		 *            current modification time of the directory
+		 * @param length
+		 *            current length of the directory
+		 * @return {@code true} if no entry was added to or removed from the
+		 *         directory since the entries were recorded
+		 */
+		public boolean isValid(Instant lastModified, long length) {
+			if (stat == null) {
+				return false;
+			}
+			byte[] current = stat(lastModified, length);
+			if (NB.decodeInt32(stat, 8) != NB.decodeInt32(current, 8)
+					|| NB.decodeInt32(stat, 12) != NB.decodeInt32(current,
+							12)
+					|| NB.decodeInt32(stat, 32) != NB.decodeInt32(current,
+							32)) {
+				return false;
+			}
+			// Like a racily clean index entry, a directory modified while
+			// the index was written may have changed since.
+			return cache.timestamp != null
+					&& lastModified.isBefore(cache.timestamp);
+		}
+
+		/**
+		 * Whether an entry was recorded as untracked.
+		 *
+		 * @param entryName
+		 *            name of the entry, with a trailing {@code '/'} for
+		 *            directories
+		 * @return {@code true} if the entry is untracked, {@code false} if
+		 *         it is ignored or tracked
+		 */
+		public boolean isUntracked(String entryName) {
+			if (untrackedSet == null) {
+				untrackedSet = new HashSet<>(untracked);
+			}
+			return untrackedSet.contains(entryName);
+		}
+
+		/**
+		 * Start recording the untracked entries of this directory again.
+		 *
+		 * @param lastModified
+		 *            current modification time of the directory
+		 * @param length
+		 *            current length of the directory
+		 * @param ignoreFileId
+		 *            id of the current per-directory ignore file, or
+		 *            {@code null} if there is none
+		 */
+		public void reset(Instant lastModified, long length,
+				ObjectId ignoreFileId) {
+			untracked = new ArrayList<>();
+			untrackedSet = null;
+			stat = stat(lastModified, length);
+			checkOnly = false;
+			excludeId = ignoreFileId;
+			cache.changed = true;
+		}
+
+		/**
+		 * Record an untracked entry.
+		 *
+		 * @param entryName
+		 *            name of the entry, with a trailing {@code '/'} for
+		 *            directories
+		 */
+		public void addUntracked(String entryName) {
+			if (!isUntracked(entryName)) {
+				untracked.add(entryName);
+				untrackedSet.add(entryName);
+				cache.changed = true;
+			}
+		}
+
+		void invalidate() {
+			if (stat != null) {
+				stat = null;
+				untracked = new ArrayList<>();
+				untrackedSet = null;
+				cache.changed = true;
+			}
+		}
+	}
+}
@@ -0,0 +1,390 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.dircache;
+
+import static java.nio.file.StandardWatchEventKinds.ENTRY_CREATE;
+import static java.nio.file.StandardWatchEventKinds.ENTRY_DELETE;
+import static java.nio.file.StandardWatchEventKinds.ENTRY_MODIFY;
+import static java.nio.file.StandardWatchEventKinds.OVERFLOW;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.nio.file.ClosedWatchServiceException;
+import java.nio.file.FileVisitResult;
+import java.nio.file.Files;
+import java.nio.file.LinkOption;
+import java.nio.file.NoSuchFileException;
+import java.nio.file.Path;
+import java.nio.file.SimpleFileVisitor;
+import java.nio.file.WatchEvent;
+import java.nio.file.WatchKey;
+import java.nio.file.WatchService;
+import java.nio.file.attribute.BasicFileAttributes;
+import java.text.MessageFormat;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.UUID;
+import java.util.concurrent.TimeUnit;
+
+import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.lib.Repository;
+import org.eclipse.jgit.util.FileUtils;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * A {@link FsMonitor} watching the working tree with a
+ * {@link java.nio.file.WatchService}, which uses inotify on Linux.
+ * <p>
+ * Only watch services notified by the operating system are used. Polling
+ * implementations, like the one of the JDK on macOS, rescan each directory on
+ * their own schedule and miss changes within the resolution of file
+ * modification times. Where only such a watch service is available, every
+ * query reports all paths as changed.
+ * <p>
+ * The monitor watches every directory of the working tree on a background
+ * thread, and remembers the paths changed since it was started. As it lives
+ * in the current process only, the first query of each process finds a token
+ * it did not hand out, and reports all paths as changed.
+ * <p>
+ * To make sure all changes made before a query are reported, the query
+ * creates a cookie file in the repository directory and waits until the
+ * watcher saw it.
+ */
+public class WatchServiceFsMonitor extends FsMonitor implements AutoCloseable {
+	private static final Logger LOG = LoggerFactory
+			.getLogger(WatchServiceFsMonitor.class);
+
+	private static final String COOKIE_DIR = "jgit-fsmonitor"; //$NON-NLS-1$
+
+	private static final String TOKEN_PREFIX = "jgit:"; //$NON-NLS-1$
+
+	/** Number of changed paths remembered before older ones are dropped. */
+	private static final int MAX_PATHS = 100_000;
+
+	private static final long COOKIE_TIMEOUT_MILLIS = 5000;
+
+	/** Watch services notified by the operating system instead of polling. */
+	private static final Set<String> NATIVE_WATCH_SERVICES = Set.of(
+			"sun.nio.fs.LinuxWatchService", //$NON-NLS-1$
+			"sun.nio.fs.WindowsWatchService"); //$NON-NLS-1$
+
+	private static final Map<File, WatchServiceFsMonitor> monitors = new HashMap<>();
+
+	/**
+	 * Get the monitor of a repository's working tree, starting it if
+	 * necessary.
+	 * <p>
+	 * A monitor which could not be started is kept as well, so that callers
+	 * fall back to scanning the working tree without trying to watch it
+	 * again on every call.
+	 *
+	 * @param repo
+	 *            a non-bare repository
+	 * @return the monitor of the working tree of the repository
+	 * @throws IOException
+	 *             if the working tree cannot be resolved
+	 */
+	public static WatchServiceFsMonitor get(Repository repo)
+			throws IOException {
+		File workTree = repo.getWorkTree().getCanonicalFile();
+		synchronized (monitors) {
+			WatchServiceFsMonitor m = monitors.get(workTree);
+			if (m == null || m.closed || m.failed) {
+				m = new WatchServiceFsMonitor(workTree.toPath(),
+						repo.getDirectory().getCanonicalFile().toPath());
+				monitors.put(workTree, m);
+			}
+			return m;
+		}
+	}
+
+	private final Path workTree;
+
+	private final Path gitDir;
+
+	private final Path cookieDir;
+
+	private final String instance = UUID.randomUUID().toString();
+
+	/**
+	 * The watch service; null if it would not report all changes or could
+	 * not be started.
+	 */
+	private final WatchService watcher;
+
+	/** Changed paths and the sequence number of their last change. */
+	private final LinkedHashMap<String, Long> changed = new LinkedHashMap<>() {
+		private static final long serialVersionUID = 1L;
+
+		@Override
+		protected boolean removeEldestEntry(Map.Entry<String, Long> eldest) {
+			if (size() > MAX_PATHS) {
+				firstSeq = eldest.getValue().longValue();
+				return true;
+			}
+			return false;
+		}
+	};
+
+	/** Sequence number of the last change. */
+	private long seq;
+
+	/** Changes after this sequence number are all known. */
+	private long firstSeq;
+
+	private final Set<String> seenCookies = new HashSet<>();
+
+	private int cookieCount;
+
+	private volatile boolean failed;
+
+	private volatile boolean closed;
+
+	private WatchServiceFsMonitor(Path workTree, Path gitDir) {
+		this.workTree = workTree;
+		this.gitDir = gitDir;
+		this.cookieDir = gitDir.resolve(COOKIE_DIR);
+		watcher = open();
+		if (watcher == null) {
+			return;
+		}
+		Thread thread = new Thread(this::run, "JGit-FsMonitor"); //$NON-NLS-1$
+		thread.setDaemon(true);
+		thread.start();
+	}
+
+	/**
+	 * Open the watch service and register all directories of the working
+	 * tree.
+	 *
+	 * @return the watch service; null if the platform's watch service polls
+	 *         or the working tree cannot be watched, e.g. because it has
+	 *         more directories than inotify may watch. The monitor then
+	 *         reports all paths as changed until it is closed.
+	 */
+	private WatchService open() {
+		WatchService ws = null;
+		try {
+			ws = workTree.getFileSystem().newWatchService();
+			if (!NATIVE_WATCH_SERVICES.contains(ws.getClass().getName())) {
+				ws.close();
+				return null;
+			}
+			Files.createDirectories(cookieDir);
+			cookieDir.register(ws, ENTRY_CREATE);
+			registerAll(ws, workTree);
+			return ws;
+		} catch (IOException e) {
+			LOG.warn(MessageFormat.format(JGitText.get().fsMonitorCannotWatch,
+					workTree), e);
+			if (ws != null) {
+				try {
+					ws.close();
+				} catch (IOException e2) {
+					// Ignore, the watch service is not used.
+				}
+			}
+			return null;
+		}
+	}
+
+	/**
+	 * Whether the monitor watches the working tree.
+	 *
+	 * @return {@code false} if the watch service of the platform polls or
+	 *         could not be started, and all paths are reported as changed
+	 */
+	boolean isWatching() {
+		return watcher != null;
+	}
+
+	private void registerAll(WatchService ws, Path dir) throws IOException {
+		Files.walkFileTree(dir, new SimpleFileVisitor<>() {
+			@Override
+			public FileVisitResult preVisitDirectory(Path d,
+					BasicFileAttributes attrs) throws IOException {
+				if (d.equals(gitDir)) {
+					return FileVisitResult.SKIP_SUBTREE;
+				}
+				try {
+					d.register(ws, ENTRY_CREATE, ENTRY_DELETE, ENTRY_MODIFY);
+				} catch (NoSuchFileException e) {
+					// Deleted while walking; its parent reports the deletion.
+					return FileVisitResult.SKIP_SUBTREE;
+				}
+				return FileVisitResult.CONTINUE;
+			}
+
+			@Override
+			public FileVisitResult visitFileFailed(Path f, IOException e) {
+				// Deleted while walking; its parent reports the deletion.
+				return FileVisitResult.CONTINUE;
+			}
+		});
+	}
+
+	private void run() {
+		try {
+			for (;;) {
+				// Drain all signalled keys before publishing cookies, so
+				// that every change made before a cookie is recorded when
+				// the cookie is seen.
+				WatchKey key = watcher.take();
+				List<String> cookies = new ArrayList<>();
+				do {
+					process(key, cookies);
+				} while ((key = watcher.poll()) != null);
+				if (!cookies.isEmpty()) {
+					synchronized (this) {
+						seenCookies.addAll(cookies);
+						notifyAll();
+					}
+				}
+			}
+		} catch (InterruptedException | ClosedWatchServiceException e) {
+			// Closed
+		} catch (IOException | RuntimeException e) {
+			LOG.error(MessageFormat.format(JGitText.get().fsMonitorCannotWatch,
+					workTree), e);
+		} finally {
+			synchronized (this) {
+				failed = true;
+				notifyAll();
+			}
+		}
+	}
+
+	private void process(WatchKey key, List<String> cookies)
+			throws IOException {
+		Path dir = (Path) key.watchable();
+		for (WatchEvent<?> event : key.pollEvents()) {
+			if (event.kind() == OVERFLOW) {
+				synchronized (this) {
+					changed.clear();
+					firstSeq = ++seq;
+				}
+				continue;
+			}
+			Path child = dir.resolve((Path) event.context());
+			if (dir.equals(cookieDir)) {
+				String name = child.getFileName().toString();
+				if (name.startsWith(instance)) {
+					cookies.add(name);
+				}
+				continue;
+			}
+			if (event.kind() == ENTRY_CREATE
+					&& Files.isDirectory(child, LinkOption.NOFOLLOW_LINKS)
+					&& !child.equals(gitDir)) {
+				registerAll(watcher, child);
+			}
+			String path = workTree.relativize(child).toString()
+					.replace(File.separatorChar, '/');
+			synchronized (this) {
+				changed.remove(path);
+				changed.put(path, Long.valueOf(++seq));
+			}
+		}
+		key.reset();
+	}
+
+	@Override
+	public Changes query(String token) throws IOException {
+		if (watcher == null) {
+			return new Changes(null, null);
+		}
+		String cookie;
+		synchronized (this) {
+			cookie = instance + '-' + (++cookieCount);
+		}
+		Path cookieFile = cookieDir.resolve(cookie);
+		try {
+			Files.createFile(cookieFile);
+		} catch (IOException e) {
+			LOG.warn(MessageFormat.format(JGitText.get().fsMonitorCannotWatch,
+					workTree), e);
+			return new Changes(null, null);
+		}
+		try {
+			synchronized (this) {
+				long deadline = System.nanoTime() + TimeUnit.MILLISECONDS
+						.toNanos(COOKIE_TIMEOUT_MILLIS);
+				while (!seenCookies.contains(cookie) && !failed) {
+					long wait = deadline - System.nanoTime();
+					if (wait <= 0) {
+						break;
+					}
+					TimeUnit.NANOSECONDS.timedWait(this, wait);
+				}
+				String newToken = TOKEN_PREFIX + instance + ':' + seq;
+				if (failed || !seenCookies.contains(cookie)) {
+					return new Changes(failed ? null : newToken, null);
+				}
+				long since = parseToken(token);
+				if (since < firstSeq) {
+					return new Changes(newToken, null);
+				}
+				List<String> paths = new ArrayList<>();
+				for (Map.Entry<String, Long> e : changed.entrySet()) {
+					if (e.getValue().longValue() > since) {
+						paths.add(e.getKey());
+					}
+				}
+				return new Changes(newToken, paths);
+			}
+		} catch (InterruptedException e) {
+			throw new InterruptedIOException();
+		} finally {
+			synchronized (this) {
+				seenCookies.remove(cookie);
+			}
+			FileUtils.delete(cookieFile, FileUtils.SKIP_MISSING);
+		}
+	}
+
+	private long parseToken(String token) {
+		String prefix = TOKEN_PREFIX + instance + ':';
+		if (token == null || !token.startsWith(prefix)) {
+			return -1;
+		}
+		try {
+			return Long.parseLong(token.substring(prefix.length()));
+		} catch (NumberFormatException e) {
+			return -1;
+		}
+	}
+
+	/**
+	 * Stop watching the working tree.
+	 */
+	@Override
+	public void close() {
+		closed = true;
+		synchronized (monitors) {
+			monitors.remove(workTree.toFile(), this);
+		}
+		if (watcher == null) {
+			return;
+		}
+		try {
+			watcher.close();
+		} catch (IOException e) {
+			// Ignore, the monitor is not used anymore.
+		}
+	}
+}
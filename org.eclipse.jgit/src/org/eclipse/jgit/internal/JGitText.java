@@ -104,6 +104,8 @@ public static JGitText get() {
 	/***/ public String bothRefTargetsMustNotBeNull;
 	/***/ public String branchNameInvalid;
 	/***/ public String buildingBitmaps;
+	/***/ public String bundleUriSkipped;
+	/***/ public String bundleUriUnexpectedHttpStatus;
 	/***/ public String cachedPacksPreventsIndexCreation;
 	/***/ public String cachedPacksPreventsListingObjects;
 	/***/ public String cannotAccessLastModifiedForSafeDeletion;
@@ -181,14 +183,19 @@ public static JGitText get() {
 	/***/ public String closeLockTokenFailed;
 	/***/ public String closed;
 	/***/ public String closePidLockFailed;
+	/***/ public String collectingObjectsForMultiPackIndex;
 	/***/ public String collisionOn;
 	/***/ public String commandClosedStderrButDidntExit;
 	/***/ public String commandRejectedByHook;
 	/***/ public String commandWasCalledInTheWrongState;
+	/***/ public String commitGraphChainBaseMismatch;
+	/***/ public String commitGraphChainInvalidLine;
 	/***/ public String commitGraphChunkNeeded;
 	/***/ public String commitGraphChunkRepeated;
+	/***/ public String commitGraphChunkSizeMismatch;
 	/***/ public String commitGraphChunkUnknown;
 	/***/ public String commitGraphFileIsTooLargeForJgit;
+	/***/ public String commitGraphHasBaseGraphs;
 	/***/ public String commitGraphUnexpectedSize;
 	/***/ public String commitGraphWritingCancelled;
 	/***/ public String commitMessageNotSpecified;
@@ -210,6 +217,8 @@ public static JGitText get() {
 	/***/ public String copyFileFailedNullFiles;
 	/***/ public String corruptCommitGraph;
 	/***/ public String corruptionDetectedReReadingAt;
+	/***/ public String corruptMultiPackIndex;
+	/***/ public String corruptMultiPackIndexReverseIndex;
 	/***/ public String corruptObjectBadDate;
 	/***/ public String corruptObjectBadEmail;
 	/***/ public String corruptObjectBadStream;
@@ -260,6 +269,7 @@ public static JGitText get() {
 	/***/ public String corruptObjectZeroId;
 	/***/ public String corruptReverseIndexChecksumIncorrect;
 	/***/ public String corruptPack;
+	/***/ public String corruptPackMtimesChecksumIncorrect;
 	/***/ public String corruptUseCnt;
 	/***/ public String couldNotFindTabInLine;
 	/***/ public String couldNotFindSixTabsInLine;
@@ -306,9 +316,14 @@ public static JGitText get() {
 	/***/ public String DIRCChecksumMismatch;
 	/***/ public String DIRCCorruptLength;
 	/***/ public String DIRCCorruptLengthFirst;
+	/***/ public String DIRCCorruptLinkExtension;
+	/***/ public String DIRCCorruptSharedIndex;
+	/***/ public String DIRCEntryWithoutName;
 	/***/ public String DIRCExtensionIsTooLargeAt;
 	/***/ public String DIRCExtensionNotSupportedByThisVersion;
 	/***/ public String DIRCHasTooManyEntries;
+	/***/ public String DIRCMissingSharedIndex;
+	/***/ public String DIRCOffsetTableMismatch;
 	/***/ public String DIRCUnrecognizedExtendedFlags;
 	/***/ public String downloadCancelled;
 	/***/ public String downloadCancelledDuringIndexing;
@@ -354,6 +369,7 @@ public static JGitText get() {
 	/***/ public String exceptionOccurredDuringReadingOfGIT_DIR;
 	/***/ public String exceptionWhileFindingUserHome;
 	/***/ public String exceptionWhileLoadingCommitGraph;
+	/***/ public String exceptionWhileLoadingMultiPackIndex;
 	/***/ public String exceptionWhileReadingPack;
 	/***/ public String expectedACKNAKFoundEOF;
 	/***/ public String expectedACKNAKGot;
@@ -388,6 +404,9 @@ public static JGitText get() {
 	/***/ public String flagIsDisposed;
 	/***/ public String flagNotFromThis;
 	/***/ public String flagsAlreadyCreated;
+	/***/ public String fsMonitorCannotRunHook;
+	/***/ public String fsMonitorCannotWatch;
+	/***/ public String fsMonitorHookFailed;
 	/***/ public String funnyRefname;
 	/***/ public String gcAlreadyRunning;
 	/***/ public String gcFailed;
@@ -438,12 +457,14 @@ public static JGitText get() {
 	/***/ public String invalidChannel;
 	/***/ public String invalidCommitParentNumber;
 	/***/ public String invalidCoreAbbrev;
+	/***/ public String invalidDeltaIsland;
 	/***/ public String invalidDepth;
 	/***/ public String invalidEncoding;
 	/***/ public String invalidEncryption;
 	/***/ public String invalidExpandWildcard;
 	/***/ public String invalidExtraEdgeListPosition;
 	/***/ public String invalidFilter;
+	/***/ public String invalidGenerationDataOverflowPosition;
 	/***/ public String invalidGitdirRef;
 	/***/ public String invalidGitModules;
 	/***/ public String invalidGitType;
@@ -521,6 +542,7 @@ public static JGitText get() {
 	/***/ public String logSmallerFiletime;
 	/***/ public String logXDGConfigHomeInvalid;
 	/***/ public String looseObjectHandleIsStale;
+	/***/ public String markingDeltaIslands;
 	/***/ public String maxCountMustBeNonNegative;
 	/***/ public String mergeConflictOnNonNoteEntries;
 	/***/ public String mergeConflictOnNotes;
@@ -552,6 +574,13 @@ public static JGitText get() {
 	/***/ public String month;
 	/***/ public String months;
 	/***/ public String monthsAgo;
+	/***/ public String multiPackBitmapChecksumMismatch;
+	/***/ public String multiPackIndexChunkNeeded;
+	/***/ public String multiPackIndexChunkSizeMismatch;
+	/***/ public String multiPackIndexChunkUnknown;
+	/***/ public String multiPackIndexFileIsTooLargeForJgit;
+	/***/ public String multiPackIndexInvalidPackId;
+	/***/ public String multiPackIndexWritingCancelled;
 	/***/ public String multipleMergeBasesFor;
 	/***/ public String nameMustNotBeNullOrEmpty;
 	/***/ public String need2Arguments;
@@ -576,6 +605,7 @@ public static JGitText get() {
 	/***/ public String notACommitGraph;
 	/***/ public String notADIRCFile;
 	/***/ public String notAGitDirectory;
+	/***/ public String notAMultiPackIndex;
 	/***/ public String notAPACKFile;
 	/***/ public String notARef;
 	/***/ public String notASCIIString;
@@ -756,6 +786,7 @@ public static JGitText get() {
 	/***/ public String sourceIsNotAWildcard;
 	/***/ public String sourceRefDoesntResolveToAnyObject;
 	/***/ public String sourceRefNotSpecifiedForRefspec;
+	/***/ public String sparseCheckoutNotCone;
 	/***/ public String squashCommitNotUpdatingHEAD;
 	/***/ public String sshCommandFailed;
 	/***/ public String sshCommandTimeout;
@@ -866,8 +897,12 @@ public static JGitText get() {
 	/***/ public String unmergedPaths;
 	/***/ public String unpackException;
 	/***/ public String unreadableCommitGraph;
+	/***/ public String unreadableMultiPackBitmap;
+	/***/ public String unreadableMultiPackBitmapFile;
+	/***/ public String unreadableMultiPackIndex;
 	/***/ public String unreadableObjectSizeIndex;
 	/***/ public String unreadablePackIndex;
+	/***/ public String unreadablePackMtimes;
 	/***/ public String unrecognizedPackExtension;
 	/***/ public String unrecognizedRef;
 	/***/ public String unsetMark;
@@ -879,10 +914,12 @@ public static JGitText get() {
 	/***/ public String unsupportedEncryptionVersion;
 	/***/ public String unsupportedGC;
 	/***/ public String unsupportedMark;
+	/***/ public String unsupportedMultiPackIndexVersion;
 	/***/ public String unsupportedObjectIdVersion;
 	/***/ public String unsupportedObjectSizeIndexVersion;
 	/***/ public String unsupportedOperationNotAddAtEnd;
 	/***/ public String unsupportedPackIndexVersion;
+	/***/ public String unsupportedPackMtimesVersion;
 	/***/ public String unsupportedPackReverseIndexVersion;
 	/***/ public String unsupportedPackVersion;
 	/***/ public String unsupportedReftableVersion;
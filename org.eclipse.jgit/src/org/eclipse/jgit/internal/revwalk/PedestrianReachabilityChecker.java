@@ -10,8 +10,11 @@
 package org.eclipse.jgit.internal.revwalk;
 
 import java.io.IOException;
+import java.util.ArrayList;
 import java.util.Collection;
+import java.util.Collections;
 import java.util.Iterator;
+import java.util.List;
 import java.util.Optional;
 import java.util.stream.Stream;
 
@@ -56,15 +59,42 @@ public Optional<RevCommit> areAllReachable(Collection<RevCommit> targets,
 			walk.sort(RevSort.TOPO);
 		}
 
+		// The commit-graph tells which starters are too old to reach a
+		// target. They are not walked, and a target none of the starters
+		// may reach is not reachable.
+		List<RevCommit> candidates = new ArrayList<>();
+		Iterator<RevCommit> iterator = starters.iterator();
+		while (iterator.hasNext()) {
+			candidates.add(iterator.next());
+		}
+		for (RevCommit target : targets) {
+			if (!mayReachAny(candidates, Collections.singleton(target))) {
+				return Optional.of(target);
+			}
+		}
+
 		for (RevCommit target: targets) {
 			walk.markStart(target);
 		}
 
-		Iterator<RevCommit> iterator = starters.iterator();
-		while (iterator.hasNext()) {
-			walk.markUninteresting(iterator.next());
+		for (RevCommit starter : candidates) {
+			if (mayReachAny(Collections.singleton(starter), targets)) {
+				walk.markUninteresting(starter);
+			}
 		}
 
 		return Optional.ofNullable(walk.next());
 	}
+
+	private boolean mayReachAny(Collection<RevCommit> from,
+			Collection<RevCommit> to) throws IOException {
+		for (RevCommit f : from) {
+			for (RevCommit t : to) {
+				if (!walk.cannotReach(f, t)) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
 }
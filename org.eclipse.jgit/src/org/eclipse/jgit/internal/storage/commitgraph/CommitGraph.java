@@ -151,5 +151,20 @@ interface CommitData {
 		 *         if the writer didn't calculate it.
 		 */
 		int getGeneration();
+
+		/**
+		 * Get the corrected commit date of the commit, the generation number
+		 * v2 of Git.
+		 * <p>
+		 * The corrected commit date is the commit time, unless a parent has a
+		 * corrected commit date which is not smaller, in which case it is one
+		 * more than the largest corrected commit date of the parents. Unlike
+		 * the commit time it is not affected by clock skew.
+		 *
+		 * @return the corrected commit date in seconds since EPOCH, or
+		 *         {@link org.eclipse.jgit.lib.Constants#COMMIT_GENERATION_NOT_COMPUTED}
+		 *         if the commit-graph has no generation data.
+		 */
+		long getCorrectedCommitDate();
 	}
 }
@@ -10,10 +10,13 @@
 
 package org.eclipse.jgit.internal.storage.commitgraph;
 
+import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_BASE_GRAPHS;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_BLOOM_FILTER_DATA;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_BLOOM_FILTER_INDEX;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_COMMIT_DATA;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_EXTRA_EDGE_LIST;
+import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_GENERATION_DATA;
+import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_GENERATION_DATA_OVERFLOW;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_OID_FANOUT;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_OID_LOOKUP;
 import static org.eclipse.jgit.lib.Constants.OBJECT_ID_LENGTH;
@@ -21,6 +24,7 @@
 import java.text.MessageFormat;
 
 import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.lib.ObjectId;
 
 /**
  * Builder for {@link CommitGraph}.
@@ -37,10 +41,18 @@ class CommitGraphBuilder {
 
 	private byte[] extraList;
 
+	private byte[] generationData;
+
+	private byte[] generationDataOverflow;
+
 	private byte[] bloomFilterIndex;
 
 	private byte[] bloomFilterData;
 
+	private int baseGraphCnt;
+
+	private byte[] baseGraphs;
+
 	/**
 	 * Create builder
 	 *
@@ -82,6 +94,21 @@ CommitGraphBuilder addExtraList(byte[] buffer)
 		return this;
 	}
 
+	CommitGraphBuilder addGenerationData(byte[] buffer)
+			throws CommitGraphFormatException {
+		assertChunkNotSeenYet(generationData, CHUNK_ID_GENERATION_DATA);
+		generationData = buffer;
+		return this;
+	}
+
+	CommitGraphBuilder addGenerationDataOverflow(byte[] buffer)
+			throws CommitGraphFormatException {
+		assertChunkNotSeenYet(generationDataOverflow,
+				CHUNK_ID_GENERATION_DATA_OVERFLOW);
+		generationDataOverflow = buffer;
+		return this;
+	}
+
 	CommitGraphBuilder addBloomFilterIndex(byte[] buffer)
 			throws CommitGraphFormatException {
 		assertChunkNotSeenYet(bloomFilterIndex, CHUNK_ID_BLOOM_FILTER_INDEX);
@@ -96,18 +123,51 @@ CommitGraphBuilder addBloomFilterData(byte[] buffer)
 		return this;
 	}
 
-	CommitGraph build() throws CommitGraphFormatException {
+	CommitGraphBuilder setBaseGraphCount(int cnt) {
+		baseGraphCnt = cnt;
+		return this;
+	}
+
+	CommitGraphBuilder addBaseGraphs(byte[] buffer)
+			throws CommitGraphFormatException {
+		assertChunkNotSeenYet(baseGraphs, CHUNK_ID_BASE_GRAPHS);
+		baseGraphs = buffer;
+		return this;
+	}
+
+	CommitGraphV1 build() throws CommitGraphFormatException {
 		assertChunkNotNull(oidFanout, CHUNK_ID_OID_FANOUT);
 		assertChunkNotNull(oidLookup, CHUNK_ID_OID_LOOKUP);
 		assertChunkNotNull(commitData, CHUNK_ID_COMMIT_DATA);
+		if (baseGraphCnt > 0) {
+			assertChunkNotNull(baseGraphs, CHUNK_ID_BASE_GRAPHS);
+		}
+		ObjectId[] baseGraphIds = new ObjectId[baseGraphCnt];
+		if (baseGraphs != null) {
+			if (baseGraphs.length != hashLength * baseGraphCnt) {
+				throw new CommitGraphFormatException(MessageFormat.format(
+						JGitText.get().commitGraphChunkSizeMismatch,
+						Integer.toHexString(CHUNK_ID_BASE_GRAPHS)));
+			}
+			for (int i = 0; i < baseGraphCnt; i++) {
+				baseGraphIds[i] = ObjectId.fromRaw(baseGraphs, i * hashLength);
+			}
+		}
 
 		GraphObjectIndex index = new GraphObjectIndex(hashLength, oidFanout,
 				oidLookup);
+		if (generationData != null
+				&& generationData.length != 4 * index.getCommitCnt()) {
+			throw new CommitGraphFormatException(MessageFormat.format(
+					JGitText.get().commitGraphChunkSizeMismatch,
+					Integer.toHexString(CHUNK_ID_GENERATION_DATA)));
+		}
 		GraphCommitData commitDataChunk = new GraphCommitData(hashLength,
-				commitData, extraList);
+				commitData, extraList, generationData, generationDataOverflow);
 		GraphChangedPathFilterData cpfData = new GraphChangedPathFilterData(
 				bloomFilterIndex, bloomFilterData);
-		return new CommitGraphV1(index, commitDataChunk, cpfData);
+		return new CommitGraphV1(index, commitDataChunk, cpfData,
+				baseGraphIds);
 	}
 
 	private void assertChunkNotNull(Object object, int chunkId)
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.commitgraph;
+
+import java.util.Arrays;
+
+import org.eclipse.jgit.lib.AnyObjectId;
+import org.eclipse.jgit.lib.ObjectId;
+
+/**
+ * A commit-graph split into layers, as listed by a
+ * {@code commit-graphs/commit-graph-chain} file.
+ * <p>
+ * Each layer only contains commits which are not in the layers below it, so
+ * new commits can be added by writing a small layer on top of the chain.
+ * Graph positions span all layers: the commits of the bottom layer come
+ * first, followed by the commits of each layer above it. The parent positions
+ * stored in a layer use these positions, so parents can be in any layer below.
+ *
+ * @since 6.9
+ */
+public class CommitGraphChain implements CommitGraph {
+
+	/** Chain without layers. */
+	public static final CommitGraphChain EMPTY = new CommitGraphChain(
+			new CommitGraphV1[0], new ObjectId[0]);
+
+	/**
+	 * Get the name of the file of a layer.
+	 *
+	 * @param layerId
+	 *            checksum of the layer
+	 * @return name of the file storing the layer, in the directory of the
+	 *         chain file
+	 */
+	public static String getLayerFileName(AnyObjectId layerId) {
+		return "graph-" + layerId.name() + ".graph"; //$NON-NLS-1$ //$NON-NLS-2$
+	}
+
+	private final CommitGraphV1[] layers;
+
+	private final ObjectId[] layerIds;
+
+	/** Number of commits in the layers below each layer. */
+	private final long[] offsets;
+
+	private final long commitCnt;
+
+	CommitGraphChain(CommitGraphV1[] layers, ObjectId[] layerIds) {
+		this.layers = layers;
+		this.layerIds = layerIds;
+		this.offsets = new long[layers.length];
+		long cnt = 0;
+		for (int i = 0; i < layers.length; i++) {
+			offsets[i] = cnt;
+			cnt += layers[i].getCommitCnt();
+		}
+		this.commitCnt = cnt;
+	}
+
+	/**
+	 * Get the number of layers.
+	 *
+	 * @return number of layers in the chain
+	 */
+	public int getLayerCount() {
+		return layers.length;
+	}
+
+	/**
+	 * Get the checksum of a layer.
+	 *
+	 * @param layer
+	 *            index of the layer, 0 being the bottom layer
+	 * @return checksum of the layer, naming its file
+	 */
+	public ObjectId getLayerId(int layer) {
+		return layerIds[layer];
+	}
+
+	/**
+	 * Get the number of commits in a layer.
+	 *
+	 * @param layer
+	 *            index of the layer, 0 being the bottom layer
+	 * @return number of commits stored in the layer
+	 */
+	public long getLayerCommitCnt(int layer) {
+		return layers[layer].getCommitCnt();
+	}
+
+	/**
+	 * Get the chain made of the bottom layers of this chain.
+	 *
+	 * @param layerCnt
+	 *            number of layers to keep
+	 * @return chain of the bottom {@code layerCnt} layers
+	 */
+	public CommitGraphChain getBase(int layerCnt) {
+		if (layerCnt == layers.length) {
+			return this;
+		}
+		return new CommitGraphChain(Arrays.copyOf(layers, layerCnt),
+				Arrays.copyOf(layerIds, layerCnt));
+	}
+
+	@Override
+	public int findGraphPosition(AnyObjectId commit) {
+		for (int i = layers.length - 1; i >= 0; i--) {
+			int pos = layers[i].findGraphPosition(commit);
+			if (pos >= 0) {
+				return (int) (offsets[i] + pos);
+			}
+		}
+		return -1;
+	}
+
+	@Override
+	public CommitData getCommitData(int graphPos) {
+		int i = findLayer(graphPos);
+		if (i < 0) {
+			return null;
+		}
+		return layers[i].getCommitData((int) (graphPos - offsets[i]));
+	}
+
+	@Override
+	public ObjectId getObjectId(int graphPos) {
+		int i = findLayer(graphPos);
+		if (i < 0) {
+			return null;
+		}
+		return layers[i].getObjectId((int) (graphPos - offsets[i]));
+	}
+
+	@Override
+	public ChangedPathFilter getChangedPathFilter(int graphPos) {
+		int i = findLayer(graphPos);
+		if (i < 0) {
+			return null;
+		}
+		return layers[i].getChangedPathFilter((int) (graphPos - offsets[i]));
+	}
+
+	@Override
+	public long getCommitCnt() {
+		return commitCnt;
+	}
+
+	private int findLayer(int graphPos) {
+		if (graphPos < 0 || graphPos >= commitCnt) {
+			return -1;
+		}
+		// Chains are merged to few layers, the top one being the smallest.
+		int i = layers.length - 1;
+		while (graphPos < offsets[i]) {
+			i--;
+		}
+		return i;
+	}
+}
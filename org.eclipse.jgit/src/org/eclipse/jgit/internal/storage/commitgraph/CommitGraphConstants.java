@@ -23,12 +23,18 @@ class CommitGraphConstants {
 
 	static final int CHUNK_ID_COMMIT_DATA = 0x43444154; /* "CDAT" */
 
+	static final int CHUNK_ID_GENERATION_DATA = 0x47444132; /* "GDA2" */
+
+	static final int CHUNK_ID_GENERATION_DATA_OVERFLOW = 0x47444f32; /* "GDO2" */
+
 	static final int CHUNK_ID_EXTRA_EDGE_LIST = 0x45444745; /* "EDGE" */
 
 	static final int CHUNK_ID_BLOOM_FILTER_INDEX = 0x42494458; /* "BIDX" */
 
 	static final int CHUNK_ID_BLOOM_FILTER_DATA = 0x42444154; /* "BDAT" */
 
+	static final int CHUNK_ID_BASE_GRAPHS = 0x42415345; /* "BASE" */
+
 	/**
 	 * First 4 bytes describe the chunk id. Value 0 is a terminating label.
 	 * Other 8 bytes provide the byte-offset in current file for chunk to start.
@@ -56,4 +62,13 @@ class CommitGraphConstants {
 	 * in Chunk Extra Edge List
 	 */
 	static final int GRAPH_EXTRA_EDGES_NEEDED = 0x80000000;
+
+	/**
+	 * Offset &amp; GENERATION_DATA_OVERFLOW != 0 means the offset of the
+	 * corrected commit date is in Chunk Generation Data Overflow
+	 */
+	static final int GENERATION_DATA_OVERFLOW = 0x80000000;
+
+	/** Largest offset of a corrected commit date stored in Generation Data */
+	static final long GENERATION_DATA_OFFSET_MAX = 0x7fffffffL;
 }
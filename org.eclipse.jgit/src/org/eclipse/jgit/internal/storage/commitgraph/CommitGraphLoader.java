@@ -10,10 +10,13 @@
 
 package org.eclipse.jgit.internal.storage.commitgraph;
 
+import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_BASE_GRAPHS;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_BLOOM_FILTER_DATA;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_BLOOM_FILTER_INDEX;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_COMMIT_DATA;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_EXTRA_EDGE_LIST;
+import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_GENERATION_DATA;
+import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_GENERATION_DATA_OVERFLOW;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_OID_FANOUT;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_OID_LOOKUP;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_LOOKUP_WIDTH;
@@ -25,13 +28,16 @@
 import java.io.InputStream;
 import java.text.MessageFormat;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.List;
 
 import org.eclipse.jgit.errors.ConfigInvalidException;
 import org.eclipse.jgit.internal.JGitText;
 import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.ObjectId;
 import org.eclipse.jgit.util.IO;
 import org.eclipse.jgit.util.NB;
+import org.eclipse.jgit.util.RawParseUtils;
 import org.eclipse.jgit.util.SystemReader;
 import org.eclipse.jgit.util.io.SilentFileInputStream;
 import org.slf4j.Logger;
@@ -65,9 +71,70 @@ public class CommitGraphLoader {
 	 */
 	public static CommitGraph open(File graphFile) throws FileNotFoundException,
 			CommitGraphFormatException, IOException {
+		return withoutBaseGraphs(openGraph(graphFile));
+	}
+
+	/**
+	 * Open the layers of a commit-graph chain for reading.
+	 * <p>
+	 * The chain file lists the checksums of the layers, the bottom layer
+	 * first. The layers are read from the {@code graph-<checksum>.graph}
+	 * files in the directory of the chain file.
+	 *
+	 * @param chainFile
+	 *            existing commit-graph chain file to read.
+	 * @return a copy of all layers of the chain in memory
+	 * @throws FileNotFoundException
+	 *             the chain file or one of its layers does not exist.
+	 * @throws CommitGraphFormatException
+	 *             the chain or one of its layers has an unexpected format.
+	 * @throws java.io.IOException
+	 *             the files exist but could not be read.
+	 * @since 6.9
+	 */
+	public static CommitGraphChain openChain(File chainFile)
+			throws FileNotFoundException, CommitGraphFormatException,
+			IOException {
+		byte[] raw = IO.readFully(chainFile);
+		List<ObjectId> ids = new ArrayList<>();
+		int ptr = 0;
+		while (ptr < raw.length) {
+			int end = RawParseUtils.nextLF(raw, ptr);
+			String line = RawParseUtils.decode(raw, ptr, end).trim();
+			ptr = end;
+			if (line.isEmpty()) {
+				continue;
+			}
+			if (!ObjectId.isId(line)) {
+				throw new CommitGraphFormatException(MessageFormat.format(
+						JGitText.get().commitGraphChainInvalidLine, line));
+			}
+			ids.add(ObjectId.fromString(line));
+		}
+
+		ObjectId[] layerIds = ids.toArray(new ObjectId[0]);
+		CommitGraphV1[] layers = new CommitGraphV1[layerIds.length];
+		File dir = chainFile.getParentFile();
+		for (int i = 0; i < layerIds.length; i++) {
+			File layerFile = new File(dir,
+					CommitGraphChain.getLayerFileName(layerIds[i]));
+			layers[i] = openGraph(layerFile);
+			if (!Arrays.equals(layers[i].getBaseGraphIds(),
+					Arrays.copyOf(layerIds, i))) {
+				throw new CommitGraphFormatException(MessageFormat.format(
+						JGitText.get().commitGraphChainBaseMismatch,
+						layerFile.getAbsolutePath()));
+			}
+		}
+		return new CommitGraphChain(layers, layerIds);
+	}
+
+	private static CommitGraphV1 openGraph(File graphFile)
+			throws FileNotFoundException, CommitGraphFormatException,
+			IOException {
 		try (SilentFileInputStream fd = new SilentFileInputStream(graphFile)) {
 			try {
-				return read(fd);
+				return readGraph(fd);
 			} catch (CommitGraphFormatException fe) {
 				throw fe;
 			} catch (IOException ioe) {
@@ -98,6 +165,22 @@ public static CommitGraph open(File graphFile) throws FileNotFoundException,
 	 */
 	public static CommitGraph read(InputStream fd)
 			throws CommitGraphFormatException, IOException {
+		return withoutBaseGraphs(readGraph(fd));
+	}
+
+	private static CommitGraph withoutBaseGraphs(CommitGraphV1 graph)
+			throws CommitGraphFormatException {
+		int cnt = graph.getBaseGraphIds().length;
+		if (cnt > 0) {
+			throw new CommitGraphFormatException(MessageFormat.format(
+					JGitText.get().commitGraphHasBaseGraphs,
+					Integer.valueOf(cnt)));
+		}
+		return graph;
+	}
+
+	private static CommitGraphV1 readGraph(InputStream fd)
+			throws CommitGraphFormatException, IOException {
 		byte[] hdr = new byte[8];
 		IO.readFully(fd, hdr, 0, hdr.length);
 
@@ -127,8 +210,8 @@ public static CommitGraph read(InputStream fd)
 		// Read the number of "chunkOffsets" (1 byte)
 		int numberOfChunks = hdr[6];
 
-		// hdr[7] is the number of base commit-graphs, which is not supported in
-		// current version
+		// Read the number of base commit-graphs of a layer in a chain
+		int numberOfBaseGraphs = hdr[7] & 0xff;
 
 		byte[] lookupBuffer = new byte[CHUNK_LOOKUP_WIDTH
 				* (numberOfChunks + 1)];
@@ -153,7 +236,8 @@ public static CommitGraph read(InputStream fd)
 			readChangedPathFilters = false;
 		}
 
-		CommitGraphBuilder builder = CommitGraphBuilder.builder();
+		CommitGraphBuilder builder = CommitGraphBuilder.builder()
+				.setBaseGraphCount(numberOfBaseGraphs);
 		for (int i = 0; i < numberOfChunks; i++) {
 			long chunkOffset = chunks.get(i).offset;
 			int chunkId = chunks.get(i).id;
@@ -180,6 +264,15 @@ public static CommitGraph read(InputStream fd)
 			case CHUNK_ID_EXTRA_EDGE_LIST:
 				builder.addExtraList(buffer);
 				break;
+			case CHUNK_ID_GENERATION_DATA:
+				builder.addGenerationData(buffer);
+				break;
+			case CHUNK_ID_GENERATION_DATA_OVERFLOW:
+				builder.addGenerationDataOverflow(buffer);
+				break;
+			case CHUNK_ID_BASE_GRAPHS:
+				builder.addBaseGraphs(buffer);
+				break;
 			case CHUNK_ID_BLOOM_FILTER_INDEX:
 				if (readChangedPathFilters) {
 					builder.addBloomFilterIndex(buffer);
@@ -26,11 +26,25 @@ class CommitGraphV1 implements CommitGraph {
 
 	private final GraphChangedPathFilterData cpfData;
 
+	private final ObjectId[] baseGraphIds;
+
 	CommitGraphV1(GraphObjectIndex index, GraphCommitData commitData,
-			GraphChangedPathFilterData cpfData) {
+			GraphChangedPathFilterData cpfData, ObjectId[] baseGraphIds) {
 		this.idx = index;
 		this.commitData = commitData;
 		this.cpfData = cpfData;
+		this.baseGraphIds = baseGraphIds;
+	}
+
+	/**
+	 * Get the checksums of the commit-graphs this graph is layered on.
+	 *
+	 * @return checksums of the base commit-graphs, the bottom layer first.
+	 *         Parent positions of commits in this graph count the commits of
+	 *         all these layers first.
+	 */
+	ObjectId[] getBaseGraphIds() {
+		return baseGraphIds;
 	}
 
 	@Override
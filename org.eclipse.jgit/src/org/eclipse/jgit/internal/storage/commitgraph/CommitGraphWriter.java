@@ -10,15 +10,20 @@
 
 package org.eclipse.jgit.internal.storage.commitgraph;
 
+import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_BASE_GRAPHS;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_BLOOM_FILTER_DATA;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_BLOOM_FILTER_INDEX;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_COMMIT_DATA;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_EXTRA_EDGE_LIST;
+import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_GENERATION_DATA;
+import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_GENERATION_DATA_OVERFLOW;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_OID_FANOUT;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_ID_OID_LOOKUP;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.CHUNK_LOOKUP_WIDTH;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.COMMIT_DATA_WIDTH;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.COMMIT_GRAPH_MAGIC;
+import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.GENERATION_DATA_OFFSET_MAX;
+import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.GENERATION_DATA_OVERFLOW;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.GRAPH_EXTRA_EDGES_NEEDED;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.GRAPH_LAST_EDGE;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.GRAPH_NO_PARENT;
@@ -121,21 +126,28 @@ public Stats write(@NonNull ProgressMonitor monitor,
 			return Stats.EMPTY;
 		}
 
+		GenerationData generationData = computeGenerationData(monitor);
 		BloomFilterChunks bloomFilterChunks = generateChangedPathFilters
 				? computeBloomFilterChunks(monitor)
 				: null;
 		List<ChunkHeader> chunks = new ArrayList<>();
-		chunks.addAll(createCoreChunks(hashsz, graphCommits));
+		chunks.addAll(createCoreChunks(hashsz, graphCommits, generationData));
 		chunks.addAll(createBloomFilterChunkHeaders(bloomFilterChunks));
+		int baseGraphCnt = graphCommits.getBase().getLayerCount();
+		if (baseGraphCnt > 0) {
+			chunks.add(new ChunkHeader(CHUNK_ID_BASE_GRAPHS,
+					hashsz * baseGraphCnt));
+		}
 		chunks = Collections.unmodifiableList(chunks);
 
 		long expectedSize = calculateExpectedSize(chunks);
+		ObjectId checksum;
 		try (CancellableDigestOutputStream out = new CancellableDigestOutputStream(
 				monitor, commitGraphStream)) {
-			writeHeader(out, chunks.size());
+			writeHeader(out, chunks.size(), baseGraphCnt);
 			writeChunkLookup(out, chunks);
-			writeChunks(out, chunks);
-			writeCheckSum(out);
+			writeChunks(out, chunks, generationData);
+			checksum = writeCheckSum(out);
 			if (expectedSize != out.length()) {
 				throw new IllegalStateException(String.format(
 						JGitText.get().commitGraphUnexpectedSize,
@@ -146,17 +158,25 @@ public Stats write(@NonNull ProgressMonitor monitor,
 			throw new IOException(JGitText.get().commitGraphWritingCancelled,
 					e);
 		}
-		return Stats.from(bloomFilterChunks);
+		return Stats.from(bloomFilterChunks, checksum);
 	}
 
 	private static List<ChunkHeader> createCoreChunks(int hashsz,
-			GraphCommits graphCommits) {
+			GraphCommits graphCommits, GenerationData generationData) {
 		List<ChunkHeader> chunks = new ArrayList<>();
 		chunks.add(new ChunkHeader(CHUNK_ID_OID_FANOUT, GRAPH_FANOUT_SIZE));
 		chunks.add(new ChunkHeader(CHUNK_ID_OID_LOOKUP,
 				hashsz * graphCommits.size()));
 		chunks.add(new ChunkHeader(CHUNK_ID_COMMIT_DATA,
 				(hashsz + 16) * graphCommits.size()));
+		if (generationData.offsets != null) {
+			chunks.add(new ChunkHeader(CHUNK_ID_GENERATION_DATA,
+					4 * graphCommits.size()));
+		}
+		if (generationData.overflowCnt > 0) {
+			chunks.add(new ChunkHeader(CHUNK_ID_GENERATION_DATA_OVERFLOW,
+					8 * generationData.overflowCnt));
+		}
 		if (graphCommits.getExtraEdgeCnt() > 0) {
 			chunks.add(new ChunkHeader(CHUNK_ID_EXTRA_EDGE_LIST,
 					graphCommits.getExtraEdgeCnt() * 4));
@@ -182,12 +202,13 @@ private static long calculateExpectedSize(List<ChunkHeader> chunks) {
 		return /* header */ 8 + chunkLookup + chunkContent + /* CRC */ 20;
 	}
 
-	private void writeHeader(CancellableDigestOutputStream out, int numChunks)
-			throws IOException {
+	private void writeHeader(CancellableDigestOutputStream out, int numChunks,
+			int numBaseGraphs) throws IOException {
 		byte[] headerBuffer = new byte[8];
 		NB.encodeInt32(headerBuffer, 0, COMMIT_GRAPH_MAGIC);
 		byte[] buff = { (byte) COMMIT_GRAPH_VERSION_GENERATED,
-				(byte) OID_HASH_VERSION, (byte) numChunks, (byte) 0 };
+				(byte) OID_HASH_VERSION, (byte) numChunks,
+				(byte) numBaseGraphs };
 		System.arraycopy(buff, 0, headerBuffer, 4, 4);
 		out.write(headerBuffer, 0, 8);
 		out.flush();
@@ -210,7 +231,8 @@ private void writeChunkLookup(CancellableDigestOutputStream out,
 	}
 
 	private void writeChunks(CancellableDigestOutputStream out,
-			List<ChunkHeader> chunks) throws IOException {
+			List<ChunkHeader> chunks, GenerationData generationData)
+			throws IOException {
 		for (ChunkHeader chunk : chunks) {
 			int chunkId = chunk.id;
 
@@ -222,7 +244,13 @@ private void writeChunks(CancellableDigestOutputStream out,
 				writeOidLookUp(out);
 				break;
 			case CHUNK_ID_COMMIT_DATA:
-				writeCommitData(out);
+				writeCommitData(out, generationData);
+				break;
+			case CHUNK_ID_GENERATION_DATA:
+				writeGenerationData(out, generationData);
+				break;
+			case CHUNK_ID_GENERATION_DATA_OVERFLOW:
+				writeGenerationDataOverflow(out, generationData);
 				break;
 			case CHUNK_ID_EXTRA_EDGE_LIST:
 				writeExtraEdges(out);
@@ -235,6 +263,9 @@ private void writeChunks(CancellableDigestOutputStream out,
 				}
 				chunk.data.get().writeTo(out);
 				break;
+			case CHUNK_ID_BASE_GRAPHS:
+				writeBaseGraphs(out);
+				break;
 			default:
 				throw new IllegalStateException(
 						"Don't know how to write chunk " + chunkId); //$NON-NLS-1$
@@ -242,10 +273,22 @@ private void writeChunks(CancellableDigestOutputStream out,
 		}
 	}
 
-	private void writeCheckSum(CancellableDigestOutputStream out)
+	private ObjectId writeCheckSum(CancellableDigestOutputStream out)
 			throws IOException {
-		out.write(out.getDigest());
+		byte[] checksum = out.getDigest();
+		out.write(checksum);
 		out.flush();
+		return ObjectId.fromRaw(checksum);
+	}
+
+	private void writeBaseGraphs(CancellableDigestOutputStream out)
+			throws IOException {
+		byte[] tmp = new byte[hashsz];
+		CommitGraphChain base = graphCommits.getBase();
+		for (int i = 0; i < base.getLayerCount(); i++) {
+			base.getLayerId(i).copyRawTo(tmp, 0);
+			out.write(tmp);
+		}
 	}
 
 	private void writeFanoutTable(CancellableDigestOutputStream out)
@@ -274,10 +317,10 @@ private void writeOidLookUp(CancellableDigestOutputStream out)
 		}
 	}
 
-	private void writeCommitData(CancellableDigestOutputStream out)
-			throws IOException {
+	private void writeCommitData(CancellableDigestOutputStream out,
+			GenerationData generationData) throws IOException {
 		ProgressMonitor monitor = out.getWriteMonitor();
-		int[] generations = computeGenerationNumbers(monitor);
+		int[] generations = generationData.generations;
 		monitor.beginTask(JGitText.get().writingOutCommitGraph,
 				graphCommits.size());
 		int num = 0;
@@ -295,14 +338,14 @@ private void writeCommitData(CancellableDigestOutputStream out)
 				edgeValue = GRAPH_NO_PARENT;
 			} else {
 				RevCommit parent = parents[0];
-				edgeValue = graphCommits.getOidPosition(parent);
+				edgeValue = graphCommits.getGraphPosition(parent);
 			}
 			NB.encodeInt32(tmp, hashsz, edgeValue);
 			if (parents.length == 1) {
 				edgeValue = GRAPH_NO_PARENT;
 			} else if (parents.length == 2) {
 				RevCommit parent = parents[1];
-				edgeValue = graphCommits.getOidPosition(parent);
+				edgeValue = graphCommits.getGraphPosition(parent);
 			} else if (parents.length > 2) {
 				edgeValue = GRAPH_EXTRA_EDGES_NEEDED | num;
 				num += parents.length - 1;
@@ -323,9 +366,45 @@ private void writeCommitData(CancellableDigestOutputStream out)
 		monitor.endTask();
 	}
 
-	private int[] computeGenerationNumbers(ProgressMonitor monitor)
+	private void writeGenerationData(CancellableDigestOutputStream out,
+			GenerationData generationData) throws IOException {
+		byte[] tmp = new byte[4];
+		int overflowCnt = 0;
+		for (long offset : generationData.offsets) {
+			if (offset > GENERATION_DATA_OFFSET_MAX) {
+				NB.encodeInt32(tmp, 0, GENERATION_DATA_OVERFLOW | overflowCnt++);
+			} else {
+				NB.encodeInt32(tmp, 0, (int) offset);
+			}
+			out.write(tmp);
+		}
+	}
+
+	private void writeGenerationDataOverflow(
+			CancellableDigestOutputStream out, GenerationData generationData)
+			throws IOException {
+		byte[] tmp = new byte[8];
+		for (long offset : generationData.offsets) {
+			if (offset > GENERATION_DATA_OFFSET_MAX) {
+				NB.encodeInt64(tmp, 0, offset);
+				out.write(tmp);
+			}
+		}
+	}
+
+	/**
+	 * Compute the generation numbers and corrected commit dates of all
+	 * commits.
+	 * <p>
+	 * Corrected commit dates are only written if the base layers have them
+	 * too, as they would not be comparable otherwise.
+	 */
+	private GenerationData computeGenerationData(ProgressMonitor monitor)
 			throws MissingObjectException {
+		CommitGraphChain base = graphCommits.getBase();
 		int[] generations = new int[graphCommits.size()];
+		long[] correctedDates = new long[graphCommits.size()];
+		boolean baseHasDates = true;
 		monitor.beginTask(JGitText.get().computingCommitGeneration,
 				graphCommits.size());
 		for (RevCommit cmit : graphCommits) {
@@ -341,37 +420,70 @@ private int[] computeGenerationNumbers(ProgressMonitor monitor)
 
 			while (!commitStack.empty()) {
 				int maxGeneration = 0;
+				long maxCorrectedDate = 0;
 				boolean allParentComputed = true;
 				RevCommit current = commitStack.peek();
 				RevCommit parent;
 
 				for (int i = 0; i < current.getParentCount(); i++) {
 					parent = current.getParent(i);
-					generation = generations[graphCommits
-							.getOidPosition(parent)];
-					if (generation == COMMIT_GENERATION_NOT_COMPUTED
-							|| generation == COMMIT_GENERATION_UNKNOWN) {
-						allParentComputed = false;
-						commitStack.push(parent);
-						break;
-					} else if (generation > maxGeneration) {
+					int parentPos = graphCommits.findOidPosition(parent);
+					long parentDate;
+					if (parentPos >= 0) {
+						generation = generations[parentPos];
+						if (generation == COMMIT_GENERATION_NOT_COMPUTED
+								|| generation == COMMIT_GENERATION_UNKNOWN) {
+							allParentComputed = false;
+							commitStack.push(parent);
+							break;
+						}
+						parentDate = correctedDates[parentPos];
+					} else {
+						CommitGraph.CommitData data = base.getCommitData(
+								graphCommits.getGraphPosition(parent));
+						generation = data.getGeneration();
+						parentDate = data.getCorrectedCommitDate();
+						if (parentDate == COMMIT_GENERATION_NOT_COMPUTED) {
+							baseHasDates = false;
+						}
+					}
+					if (generation > maxGeneration) {
 						maxGeneration = generation;
 					}
+					if (parentDate > maxCorrectedDate) {
+						maxCorrectedDate = parentDate;
+					}
 				}
 
 				if (allParentComputed) {
 					RevCommit commit = commitStack.pop();
+					int pos = graphCommits.getOidPosition(commit);
 					generation = maxGeneration + 1;
 					if (generation > GENERATION_NUMBER_MAX) {
 						generation = GENERATION_NUMBER_MAX;
 					}
-					generations[graphCommits
-							.getOidPosition(commit)] = generation;
+					generations[pos] = generation;
+					correctedDates[pos] = Math.max(commit.getCommitTime(),
+							maxCorrectedDate + 1);
 				}
 			}
 		}
 		monitor.endTask();
-		return generations;
+
+		if (!baseHasDates) {
+			return new GenerationData(generations, null, 0);
+		}
+		int overflowCnt = 0;
+		long[] offsets = correctedDates;
+		int i = 0;
+		for (RevCommit commit : graphCommits) {
+			offsets[i] = correctedDates[i] - commit.getCommitTime();
+			if (offsets[i] > GENERATION_DATA_OFFSET_MAX) {
+				overflowCnt++;
+			}
+			i++;
+		}
+		return new GenerationData(generations, offsets, overflowCnt);
 	}
 
 	private static Optional<HashSet<ByteBuffer>> computeBloomFilterPaths(
@@ -462,7 +574,7 @@ private void writeExtraEdges(CancellableDigestOutputStream out)
 				int edgeValue;
 				for (int n = 1; n < parents.length; n++) {
 					RevCommit parent = parents[n];
-					edgeValue = graphCommits.getOidPosition(parent);
+					edgeValue = graphCommits.getGraphPosition(parent);
 					if (n == parents.length - 1) {
 						edgeValue |= GRAPH_LAST_EDGE;
 					}
@@ -493,6 +605,25 @@ public ChunkHeader(int id, long size) {
 		}
 	}
 
+	private static class GenerationData {
+		/** Topological levels, stored in the Commit Data chunk. */
+		final int[] generations;
+
+		/**
+		 * Offsets of the corrected commit dates from the commit times, null
+		 * if they are not written.
+		 */
+		final long[] offsets;
+
+		final int overflowCnt;
+
+		GenerationData(int[] generations, long[] offsets, int overflowCnt) {
+			this.generations = generations;
+			this.offsets = offsets;
+			this.overflowCnt = overflowCnt;
+		}
+	}
+
 	private static class BloomFilterChunks {
 		final ByteArrayOutputStream index;
 
@@ -520,17 +651,21 @@ public static class Stats {
 
 		static final Stats EMPTY = new Stats();
 
-		static final Stats from(@Nullable BloomFilterChunks bloomFilterChunks) {
+		static final Stats from(@Nullable BloomFilterChunks bloomFilterChunks,
+				ObjectId checksum) {
 			Stats stats = new Stats();
 			if (bloomFilterChunks != null) {
 				stats.changedPathFiltersComputed = bloomFilterChunks.filtersComputed;
 				stats.changedPathFiltersReused = bloomFilterChunks.filtersReused;
 			}
+			stats.checksum = checksum;
 			return stats;
 		}
 
 		private Stats() {}
 
+		private ObjectId checksum;
+
 		private long changedPathFiltersReused = 0;
 
 		private long changedPathFiltersComputed = 0;
@@ -554,5 +689,18 @@ public long getChangedPathFiltersReused() {
 		public long getChangedPathFiltersComputed() {
 			return changedPathFiltersComputed;
 		}
+
+		/**
+		 * Returns the checksum at the end of the written commit-graph, which
+		 * names the file of a layer in a commit-graph chain.
+		 *
+		 * @return checksum of the commit-graph, or null if nothing was
+		 *         written
+		 * @since 6.9
+		 */
+		@Nullable
+		public ObjectId getChecksum() {
+			return checksum;
+		}
 	}
 }
@@ -11,6 +11,7 @@
 package org.eclipse.jgit.internal.storage.commitgraph;
 
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.COMMIT_DATA_WIDTH;
+import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.GENERATION_DATA_OVERFLOW;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.GRAPH_EDGE_LAST_MASK;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.GRAPH_EXTRA_EDGES_NEEDED;
 import static org.eclipse.jgit.internal.storage.commitgraph.CommitGraphConstants.GRAPH_LAST_EDGE;
@@ -22,6 +23,7 @@
 import org.eclipse.jgit.annotations.NonNull;
 import org.eclipse.jgit.internal.JGitText;
 import org.eclipse.jgit.internal.storage.commitgraph.CommitGraph.CommitData;
+import org.eclipse.jgit.lib.Constants;
 import org.eclipse.jgit.lib.ObjectId;
 import org.eclipse.jgit.util.NB;
 
@@ -36,6 +38,10 @@ class GraphCommitData {
 
 	private final byte[] extraList;
 
+	private final byte[] generationData;
+
+	private final byte[] generationDataOverflow;
+
 	private final int hashLength;
 
 	private final int commitDataLength;
@@ -49,11 +55,18 @@ class GraphCommitData {
 	 *            content of CommitData Chunk.
 	 * @param extraList
 	 *            content of Extra Edge List Chunk.
+	 * @param generationData
+	 *            content of Generation Data Chunk.
+	 * @param generationDataOverflow
+	 *            content of Generation Data Overflow Chunk.
 	 */
 	GraphCommitData(int hashLength, @NonNull byte[] commitData,
-			byte[] extraList) {
+			byte[] extraList, byte[] generationData,
+			byte[] generationDataOverflow) {
 		this.data = commitData;
 		this.extraList = extraList;
+		this.generationData = generationData;
+		this.generationDataOverflow = generationDataOverflow;
 		this.hashLength = hashLength;
 		this.commitDataLength = hashLength + COMMIT_DATA_WIDTH;
 	}
@@ -78,30 +91,51 @@ CommitData getCommitData(int graphPos) {
 
 		// parse generation
 		int generation = NB.decodeInt32(data, dataIdx + hashLength + 8) >> 2;
+		long correctedCommitDate = getCorrectedCommitDate(graphPos,
+				commitTime);
 
 		// parse first parent
 		int parent1 = NB.decodeInt32(data, dataIdx + hashLength);
 		if (parent1 == GRAPH_NO_PARENT) {
-			return new CommitDataImpl(tree, NO_PARENTS, commitTime, generation);
+			return new CommitDataImpl(tree, NO_PARENTS, commitTime, generation,
+					correctedCommitDate);
 		}
 
 		// parse second parent
 		int parent2 = NB.decodeInt32(data, dataIdx + hashLength + 4);
 		if (parent2 == GRAPH_NO_PARENT) {
 			return new CommitDataImpl(tree, new int[] { parent1 }, commitTime,
-					generation);
+					generation, correctedCommitDate);
 		}
 
 		if ((parent2 & GRAPH_EXTRA_EDGES_NEEDED) == 0) {
 			return new CommitDataImpl(tree, new int[] { parent1, parent2 },
-					commitTime, generation);
+					commitTime, generation, correctedCommitDate);
 		}
 
 		// parse parents for octopus merge
 		return new CommitDataImpl(tree,
 				findParentsForOctopusMerge(parent1,
 						parent2 & GRAPH_EDGE_LAST_MASK),
-				commitTime, generation);
+				commitTime, generation, correctedCommitDate);
+	}
+
+	private long getCorrectedCommitDate(int graphPos, long commitTime) {
+		if (generationData == null) {
+			return Constants.COMMIT_GENERATION_NOT_COMPUTED;
+		}
+		int offset = NB.decodeInt32(generationData, graphPos * 4);
+		if ((offset & GENERATION_DATA_OVERFLOW) == 0) {
+			return commitTime + offset;
+		}
+		int overflowPos = (offset & ~GENERATION_DATA_OVERFLOW) * 8;
+		if (generationDataOverflow == null
+				|| overflowPos > generationDataOverflow.length - 8) {
+			throw new IllegalArgumentException(MessageFormat.format(
+					JGitText.get().invalidGenerationDataOverflowPosition,
+					Integer.valueOf(offset & ~GENERATION_DATA_OVERFLOW)));
+		}
+		return commitTime + NB.decodeInt64(generationDataOverflow, overflowPos);
 	}
 
 	private int[] findParentsForOctopusMerge(int parent1, int extraEdgePos) {
@@ -141,12 +175,15 @@ private static class CommitDataImpl implements CommitData {
 
 		private final int generation;
 
+		private final long correctedCommitDate;
+
 		public CommitDataImpl(ObjectId tree, int[] parents, long commitTime,
-				int generation) {
+				int generation, long correctedCommitDate) {
 			this.tree = tree;
 			this.parents = parents;
 			this.commitTime = commitTime;
 			this.generation = generation;
+			this.correctedCommitDate = correctedCommitDate;
 		}
 
 		@Override
@@ -168,5 +205,10 @@ public long getCommitTime() {
 		public int getGeneration() {
 			return generation;
 		}
+
+		@Override
+		public long getCorrectedCommitDate() {
+			return correctedCommitDate;
+		}
 	}
 }
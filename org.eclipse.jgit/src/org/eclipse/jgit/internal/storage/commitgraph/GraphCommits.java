@@ -11,7 +11,10 @@
 package org.eclipse.jgit.internal.storage.commitgraph;
 
 import java.io.IOException;
+import java.util.ArrayDeque;
 import java.util.Collections;
+import java.util.Deque;
+import java.util.HashSet;
 import java.util.Iterator;
 import java.util.List;
 import java.util.Set;
@@ -26,6 +29,7 @@
 import org.eclipse.jgit.lib.ObjectReader;
 import org.eclipse.jgit.lib.ProgressMonitor;
 import org.eclipse.jgit.revwalk.RevCommit;
+import org.eclipse.jgit.revwalk.RevFlag;
 import org.eclipse.jgit.revwalk.RevObject;
 import org.eclipse.jgit.revwalk.RevSort;
 import org.eclipse.jgit.revwalk.RevWalk;
@@ -80,7 +84,107 @@ public static GraphCommits fromWalk(ProgressMonitor pm,
 			commits.add(c);
 		}
 		pm.endTask();
-		return new GraphCommits(commits, walk.getObjectReader());
+		return new GraphCommits(commits, walk.getObjectReader(),
+				CommitGraphChain.EMPTY);
+	}
+
+	/**
+	 * Prepare the commits for a new layer on top of a commit-graph chain.
+	 * <p>
+	 * Only the commits reachable from the wants which are not in the chain
+	 * yet are walked, so the cost is proportional to the size of the new
+	 * layer rather than to the size of the history.
+	 * <p>
+	 * To keep the number of layers logarithmic in the number of commits, the
+	 * top layers of the chain are merged into the new layer as long as the
+	 * top layer has at most {@code sizeMultiple} times as many commits as the
+	 * new layer, like {@code git commit-graph write --split} does. The
+	 * remaining layers are returned by {@link #getBase()}.
+	 *
+	 * @param pm
+	 *            progress monitor.
+	 * @param wants
+	 *            the list of wanted objects, writer walks commits starting at
+	 *            these. Must not be {@code null}.
+	 * @param walk
+	 *            the RevWalk to use. Must not be {@code null}.
+	 * @param chain
+	 *            the existing layers. Must not be {@code null}.
+	 * @param sizeMultiple
+	 *            size ratio between adjacent layers below which they are
+	 *            merged.
+	 * @return the commits of the new layer. Never null.
+	 * @throws IOException
+	 *             if an error occurred
+	 * @since 6.9
+	 */
+	public static GraphCommits fromWalk(ProgressMonitor pm,
+			@NonNull Set<? extends ObjectId> wants, @NonNull RevWalk walk,
+			@NonNull CommitGraphChain chain, int sizeMultiple)
+			throws IOException {
+		List<RevCommit> commits = walkNewCommits(pm, wants, walk, chain);
+		int keep = chain.getLayerCount();
+		long cnt = commits.size();
+		while (keep > 0 && cnt > 0
+				&& chain.getLayerCommitCnt(keep - 1) <= sizeMultiple * cnt) {
+			keep--;
+			cnt += chain.getLayerCommitCnt(keep);
+		}
+		if (keep == chain.getLayerCount()) {
+			return new GraphCommits(commits, walk.getObjectReader(), chain);
+		}
+
+		// Rewrite the commits of the merged layers, even if they are not
+		// reachable from the wants anymore, unless they were pruned.
+		CommitGraphChain base = chain.getBase(keep);
+		Set<ObjectId> starts = new HashSet<>(wants);
+		ObjectReader reader = walk.getObjectReader();
+		for (long pos = base.getCommitCnt(); pos < chain
+				.getCommitCnt(); pos++) {
+			ObjectId id = chain.getObjectId((int) pos);
+			if (reader.has(id)) {
+				starts.add(id);
+			}
+		}
+		commits = walkNewCommits(pm, starts, walk, base);
+		return new GraphCommits(commits, reader, base);
+	}
+
+	private static List<RevCommit> walkNewCommits(ProgressMonitor pm,
+			Set<? extends ObjectId> wants, RevWalk walk,
+			CommitGraphChain base) throws IOException {
+		walk.reset();
+		walk.setRetainBody(false);
+		RevFlag added = walk.newFlag("GRAPH_COMMIT"); //$NON-NLS-1$
+		Deque<RevCommit> todo = new ArrayDeque<>();
+		for (ObjectId id : wants) {
+			RevObject o = walk.parseAny(id);
+			if (o instanceof RevCommit && !o.has(added)
+					&& base.findGraphPosition(o) < 0) {
+				o.add(added);
+				todo.add((RevCommit) o);
+			}
+		}
+		List<RevCommit> commits = new BlockList<>();
+		RevCommit c;
+		pm.beginTask(JGitText.get().findingCommitsForCommitGraph,
+				ProgressMonitor.UNKNOWN);
+		while ((c = todo.pollLast()) != null) {
+			pm.update(1);
+			commits.add(c);
+			for (RevCommit p : c.getParents()) {
+				// Parents in the base are parsed too, the writer needs their
+				// trees to compute changed path filters.
+				walk.parseHeaders(p);
+				if (!p.has(added) && base.findGraphPosition(p) < 0) {
+					p.add(added);
+					todo.add(p);
+				}
+			}
+		}
+		pm.endTask();
+		walk.disposeFlag(added);
+		return commits;
 	}
 
 	private final List<RevCommit> sortedCommits;
@@ -91,6 +195,8 @@ public static GraphCommits fromWalk(ProgressMonitor pm,
 
 	private final ObjectReader objectReader;
 
+	private final CommitGraphChain base;
+
 	/**
 	 * Initialize the GraphCommits.
 	 *
@@ -98,8 +204,11 @@ public static GraphCommits fromWalk(ProgressMonitor pm,
 	 *            list of commits with their headers already parsed.
 	 * @param objectReader
 	 *            object reader
+	 * @param base
+	 *            layers below these commits
 	 */
-	private GraphCommits(List<RevCommit> commits, ObjectReader objectReader) {
+	private GraphCommits(List<RevCommit> commits, ObjectReader objectReader,
+			CommitGraphChain base) {
 		Collections.sort(commits); // sorted by name
 		sortedCommits = commits;
 		commitPosMap = new ObjectIdOwnerMap<>();
@@ -113,14 +222,47 @@ private GraphCommits(List<RevCommit> commits, ObjectReader objectReader) {
 		}
 		this.extraEdgeCnt = cnt;
 		this.objectReader = objectReader;
+		this.base = base;
 	}
 
 	int getOidPosition(RevCommit c) throws MissingObjectException {
+		int pos = findOidPosition(c);
+		if (pos < 0) {
+			throw new MissingObjectException(c, Constants.OBJ_COMMIT);
+		}
+		return pos;
+	}
+
+	int findOidPosition(RevCommit c) {
 		CommitWithPosition commitWithPosition = commitPosMap.get(c);
-		if (commitWithPosition == null) {
+		return commitWithPosition != null ? commitWithPosition.position : -1;
+	}
+
+	/**
+	 * Get the position of a commit in the graph made of the base layers and
+	 * these commits.
+	 */
+	int getGraphPosition(RevCommit c) throws MissingObjectException {
+		int pos = findOidPosition(c);
+		if (pos >= 0) {
+			return (int) base.getCommitCnt() + pos;
+		}
+		pos = base.findGraphPosition(c);
+		if (pos < 0) {
 			throw new MissingObjectException(c, Constants.OBJ_COMMIT);
 		}
-		return commitWithPosition.position;
+		return pos;
+	}
+
+	/**
+	 * Get the layers these commits are written on.
+	 *
+	 * @return the layers below these commits, empty if they are written to a
+	 *         single commit-graph file
+	 * @since 6.9
+	 */
+	public CommitGraphChain getBase() {
+		return base;
 	}
 
 	int getExtraEdgeCnt() {
@@ -11,12 +11,15 @@
 package org.eclipse.jgit.internal.storage.dfs;
 
 import static org.eclipse.jgit.internal.storage.pack.PackExt.PACK;
+import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_INDEX_THREADS;
+import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_PACK_SECTION;
 
 import java.io.EOFException;
 import java.io.IOException;
 import java.io.InputStream;
 import java.nio.ByteBuffer;
 import java.security.MessageDigest;
+import java.util.Arrays;
 import java.util.Collections;
 import java.util.List;
 import java.util.zip.CRC32;
@@ -100,6 +103,8 @@ protected DfsPackParser(DfsObjDatabase db, DfsInserter ins, InputStream in) {
 		this.objins = ins;
 		this.crc = new CRC32();
 		this.packDigest = Constants.newMessageDigest();
+		setThreads(db.getRepository().getConfig().getInt(CONFIG_PACK_SECTION,
+				CONFIG_KEY_INDEX_THREADS, 1));
 	}
 
 	@Override
@@ -333,37 +338,43 @@ protected int readDatabase(byte[] dst, int pos, int cnt) throws IOException {
 			return n;
 		}
 
-		if (readBlock == null || !readBlock.contains(packKey, readPos)) {
-			long start = toBlockStart(readPos);
-			readBlock = blockCache.get(packKey, start);
-			if (readBlock == null) {
-				int size = (int) Math.min(blockSize, packEnd - start);
-				byte[] buf = new byte[size];
-				if (read(start, buf, 0, size) != size)
-					throw new EOFException();
-				readBlock = new DfsBlock(packKey, start, buf);
-				blockCache.put(readBlock);
-			}
-		}
+		if (readBlock == null || !readBlock.contains(packKey, readPos))
+			readBlock = getBlock(readPos);
 
 		int n = readBlock.copy(readPos, dst, pos, cnt);
 		readPos += n;
 		return n;
 	}
 
+	private DfsBlock getBlock(long pos) throws IOException {
+		long start = toBlockStart(pos);
+		DfsBlock b = blockCache.get(packKey, start);
+		if (b == null) {
+			int size = (int) Math.min(blockSize, packEnd - start);
+			byte[] buf = new byte[size];
+			if (read(start, buf, 0, size) != size)
+				throw new EOFException();
+			b = new DfsBlock(packKey, start, buf);
+			blockCache.put(b);
+		}
+		return b;
+	}
+
 	private int read(long pos, byte[] dst, int off, int len) throws IOException {
 		if (len == 0)
 			return 0;
 
 		int cnt = 0;
-		while (0 < len) {
-			int r = out.read(pos, ByteBuffer.wrap(dst, off, len));
-			if (r <= 0)
-				break;
-			pos += r;
-			off += r;
-			len -= r;
-			cnt += r;
+		synchronized (out) {
+			while (0 < len) {
+				int r = out.read(pos, ByteBuffer.wrap(dst, off, len));
+				if (r <= 0)
+					break;
+				pos += r;
+				off += r;
+				len -= r;
+				cnt += r;
+			}
 		}
 		return cnt != 0 ? cnt : -1;
 	}
@@ -377,6 +388,56 @@ protected boolean checkCRC(int oldCRC) {
 		return oldCRC == (int) crc.getValue();
 	}
 
+	@Override
+	protected DatabaseReader newDatabaseReader() throws IOException {
+		if (isEmptyPack)
+			return null;
+		return new BlockReader();
+	}
+
+	/**
+	 * Reads the stored pack for a thread resolving deltas. Each reader keeps
+	 * its own copy of the buffered tail of the pack, so it does not touch
+	 * the buffer of the parser from another thread.
+	 */
+	private class BlockReader extends DatabaseReader {
+		private final byte[] tail = Arrays.copyOf(currBuf, currEnd);
+
+		private final long tailPos = currPos;
+
+		private long pos;
+
+		private DfsBlock block;
+
+		@Override
+		public void seek(long position) {
+			pos = position;
+		}
+
+		@Override
+		public int read(byte[] dst, int off, int cnt) throws IOException {
+			if (cnt == 0)
+				return 0;
+
+			if (tailPos <= pos) {
+				int p = (int) (pos - tailPos);
+				int n = Math.min(cnt, tail.length - p);
+				if (n == 0)
+					throw new EOFException();
+				System.arraycopy(tail, p, dst, off, n);
+				pos += n;
+				return n;
+			}
+
+			if (block == null || !block.contains(packKey, pos))
+				block = getBlock(pos);
+
+			int n = block.copy(pos, dst, off, cnt);
+			pos += n;
+			return n;
+		}
+	}
+
 	@Override
 	protected boolean onAppendBase(final int typeCode, final byte[] data,
 			final PackedObjectInfo info) throws IOException {
@@ -161,6 +161,12 @@ public Collection<CachedPack> getCachedPacksAndUpdate(
 		return Collections.emptyList();
 	}
 
+	@Override
+	public CachedPack getPartialCachedPackAndUpdate(
+			BitmapBuilder needBitmap) throws IOException {
+		return null;
+	}
+
 	@Override
 	public Collection<ObjectId> resolve(AbbreviatedObjectId id)
 			throws IOException {
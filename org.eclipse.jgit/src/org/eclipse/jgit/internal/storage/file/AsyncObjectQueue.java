@@ -0,0 +1,412 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.file;
+
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.Comparator;
+import java.util.List;
+import java.util.Queue;
+import java.util.concurrent.ArrayBlockingQueue;
+import java.util.concurrent.BlockingQueue;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.Executors;
+import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import org.eclipse.jgit.errors.MissingObjectException;
+import org.eclipse.jgit.lib.AsyncObjectLoaderQueue;
+import org.eclipse.jgit.lib.AsyncObjectSizeQueue;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.lib.ObjectLoader;
+import org.eclipse.jgit.lib.ObjectReader;
+import org.eclipse.jgit.util.LazyFetch;
+
+/**
+ * Loads objects of a {@link WindowCursor} in parallel.
+ * <p>
+ * The objects are first located in the packs and sorted by pack and offset,
+ * so that each pack is read sequentially. Objects not found in a pack, such as
+ * loose objects or objects of alternates, come last. The sorted objects are
+ * then inflated by worker threads, which claim consecutive batches of them.
+ * In a partial clone, the missing objects are fetched together beforehand.
+ * <p>
+ * The calling thread helps: when no loaded object is waiting, it loads the
+ * next unclaimed object itself. Progress therefore never depends on the
+ * worker threads, which are shared by all readers. A worker whose loaded
+ * object is not taken in time, e.g. because the queue was dropped without
+ * being released, leaves the rest of its batch to the calling thread and
+ * returns to the pool.
+ *
+ * @param <T>
+ *            type of the object identifiers
+ */
+final class AsyncObjectQueue<T extends ObjectId>
+		implements AsyncObjectLoaderQueue<T>, AsyncObjectSizeQueue<T> {
+	/** Number of objects a worker claims at once. */
+	private static final int BATCH_SIZE = 64;
+
+	private static final int MAX_WORKERS = Runtime.getRuntime()
+			.availableProcessors();
+
+	/** Time a worker waits for room in the queue before giving up. */
+	private static final long HAND_OVER_TIMEOUT_MILLIS = 1000;
+
+	/** Interval at which waiting threads check for cancellation. */
+	private static final long POLL_MILLIS = 50;
+
+	private static final Comparator<Entry<?>> BY_PACK_OFFSET = (a, b) -> {
+		if (a.pack != b.pack) {
+			return Integer.compare(a.packIndex, b.packIndex);
+		}
+		return Long.compare(a.offset, b.offset);
+	};
+
+	private static final class Entry<T extends ObjectId> {
+		final T id;
+
+		Pack pack;
+
+		/** Position of {@link #pack} in the pack list, or MAX_VALUE. */
+		int packIndex = Integer.MAX_VALUE;
+
+		long offset;
+
+		ObjectLoader loader;
+
+		long size;
+
+		Throwable error;
+
+		boolean loaded;
+
+		Entry(T id) {
+			this.id = id;
+		}
+	}
+
+	private static class ExecutorHolder {
+		static final ThreadPoolExecutor EXECUTOR;
+
+		static {
+			EXECUTOR = new ThreadPoolExecutor(MAX_WORKERS, MAX_WORKERS, 30,
+					TimeUnit.SECONDS, new LinkedBlockingQueue<>(),
+					new ThreadFactory() {
+						private final ThreadFactory baseFactory = Executors
+								.defaultThreadFactory();
+
+						@Override
+						public Thread newThread(Runnable taskBody) {
+							Thread thr = baseFactory.newThread(taskBody);
+							thr.setName("JGit-AsyncObjectLoader"); //$NON-NLS-1$
+							thr.setContextClassLoader(null);
+							thr.setDaemon(true);
+							return thr;
+						}
+					});
+			EXECUTOR.allowCoreThreadTimeOut(true);
+		}
+	}
+
+	private final WindowCursor curs;
+
+	private final boolean sizeOnly;
+
+	private final List<Entry<T>> entries;
+
+	/** Index of the next entry not claimed by a worker or the caller. */
+	private final AtomicInteger claimed = new AtomicInteger();
+
+	private final BlockingQueue<Entry<T>> done;
+
+	/** Entries left to the caller by workers which gave up. */
+	private final Queue<Entry<T>> spilled = new ConcurrentLinkedQueue<>();
+
+	private int delivered;
+
+	private Entry<T> cur;
+
+	private volatile boolean cancelled;
+
+	AsyncObjectQueue(WindowCursor curs, Iterable<T> objectIds,
+			boolean sizeOnly) {
+		this.curs = curs;
+		this.sizeOnly = sizeOnly;
+		List<Entry<T>> located = locate(curs.db.getPacks(), objectIds);
+		if (fetchPromised(curs, located)) {
+			List<T> ids = new ArrayList<>(located.size());
+			for (Entry<T> e : located) {
+				ids.add(e.id);
+			}
+			located = locate(curs.db.getPacks(), ids);
+		}
+		this.entries = located;
+
+		int batches = (entries.size() + BATCH_SIZE - 1) / BATCH_SIZE;
+		int workers = Math.min(MAX_WORKERS, batches - 1);
+		if (workers > 0) {
+			done = new ArrayBlockingQueue<>(4 * workers);
+			for (int i = 0; i < workers; i++) {
+				ExecutorHolder.EXECUTOR.execute(LazyFetch.inherit(this::work));
+			}
+		} else {
+			// Too few objects to be worth handing to other threads.
+			done = null;
+		}
+	}
+
+	private static <T extends ObjectId> List<Entry<T>> locate(
+			Collection<Pack> packList, Iterable<T> objectIds) {
+		Pack[] packs = packList.toArray(new Pack[0]);
+		List<Entry<T>> list = new ArrayList<>();
+		int last = 0;
+		for (T id : objectIds) {
+			Entry<T> e = new Entry<>(id);
+			for (int n = 0; n < packs.length; n++) {
+				// Objects requested together tend to be in the same pack.
+				int i = (last + n) % packs.length;
+				long offset = findOffset(packs[i], id);
+				if (0 < offset) {
+					e.pack = packs[i];
+					e.packIndex = i;
+					e.offset = offset;
+					last = i;
+					break;
+				}
+			}
+			list.add(e);
+		}
+		list.sort(BY_PACK_OFFSET);
+		return list;
+	}
+
+	private static <T extends ObjectId> boolean fetchPromised(
+			WindowCursor curs, List<Entry<T>> entries) {
+		PromisorRemote promisor = curs.db.getPromisorRemote();
+		if (promisor == null) {
+			return false;
+		}
+		try {
+			List<T> missing = new ArrayList<>();
+			for (Entry<T> e : entries) {
+				if (e.pack == null && !curs.db.has(e.id)) {
+					missing.add(e.id);
+				}
+			}
+			return !missing.isEmpty() && promisor.fetch(curs.db, missing);
+		} catch (IOException e) {
+			// Loading the objects fetches them one by one, reporting errors.
+			return false;
+		}
+	}
+
+	private static long findOffset(Pack pack, ObjectId id) {
+		try {
+			return pack.getIndex().findOffset(id);
+		} catch (IOException e) {
+			// Leave the object to the regular lookup, which reports errors.
+			return -1;
+		}
+	}
+
+	private void work() {
+		try (WindowCursor wc = new WindowCursor(curs.db)) {
+			wc.setStreamFileThreshold(curs.getStreamFileThreshold());
+			int n = entries.size();
+			while (!cancelled) {
+				int start = claimed.getAndAdd(BATCH_SIZE);
+				if (start >= n) {
+					return;
+				}
+				int end = Math.min(start + BATCH_SIZE, n);
+				for (int i = start; i < end && !cancelled; i++) {
+					Entry<T> e = entries.get(i);
+					load(wc, e);
+					if (!handOver(e)) {
+						spilled.addAll(entries.subList(i + 1, end));
+						return;
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * Queue a loaded entry for the caller.
+	 *
+	 * @return {@code false} if the caller did not make room in time, the
+	 *         entry was added to {@link #spilled} and the worker should stop
+	 */
+	private boolean handOver(Entry<T> e) {
+		long deadline = System.nanoTime()
+				+ TimeUnit.MILLISECONDS.toNanos(HAND_OVER_TIMEOUT_MILLIS);
+		try {
+			while (!cancelled) {
+				if (done.offer(e, POLL_MILLIS, TimeUnit.MILLISECONDS)) {
+					return true;
+				}
+				if (System.nanoTime() - deadline > 0) {
+					break;
+				}
+			}
+		} catch (InterruptedException err) {
+			Thread.currentThread().interrupt();
+		}
+		spilled.add(e);
+		return false;
+	}
+
+	private void load(WindowCursor wc, Entry<T> e) {
+		try {
+			if (sizeOnly) {
+				e.size = loadSize(wc, e);
+			} else {
+				e.loader = loadObject(wc, e);
+			}
+		} catch (IOException | RuntimeException | Error err) {
+			e.error = err;
+		}
+		e.loaded = true;
+	}
+
+	private static ObjectLoader loadObject(WindowCursor wc, Entry<?> e)
+			throws IOException {
+		if (e.pack != null) {
+			try {
+				ObjectLoader ldr = e.pack.get(wc, e.offset);
+				if (ldr != null) {
+					return ldr;
+				}
+			} catch (IOException packGone) {
+				// Fall back to the regular lookup, which rescans the packs.
+			}
+		}
+		return wc.open(e.id, ObjectReader.OBJ_ANY);
+	}
+
+	private static long loadSize(WindowCursor wc, Entry<?> e)
+			throws IOException {
+		if (e.pack != null) {
+			try {
+				long sz = e.pack.getObjectSize(wc, e.offset);
+				if (sz >= 0) {
+					return sz;
+				}
+			} catch (IOException packGone) {
+				// Fall back to the regular lookup, which rescans the packs.
+			}
+		}
+		return wc.getObjectSize(e.id, ObjectReader.OBJ_ANY);
+	}
+
+	@Override
+	public boolean next() throws MissingObjectException, IOException {
+		if (cancelled || delivered == entries.size()) {
+			cur = null;
+			return false;
+		}
+		Entry<T> e = done != null ? done.poll() : null;
+		if (e == null) {
+			e = spilled.poll();
+		}
+		if (e == null) {
+			int i = claimed.getAndIncrement();
+			if (i < entries.size()) {
+				e = entries.get(i);
+			} else {
+				// The remaining objects are being loaded by workers.
+				e = awaitLoaded();
+			}
+		}
+		if (!e.loaded) {
+			load(curs, e);
+		}
+		delivered++;
+		cur = e;
+		if (sizeOnly) {
+			rethrow(e);
+		}
+		return true;
+	}
+
+	private Entry<T> awaitLoaded() throws InterruptedIOException {
+		try {
+			for (;;) {
+				Entry<T> e = done.poll(POLL_MILLIS, TimeUnit.MILLISECONDS);
+				if (e == null) {
+					e = spilled.poll();
+				}
+				if (e != null) {
+					return e;
+				}
+			}
+		} catch (InterruptedException err) {
+			throw new InterruptedIOException();
+		}
+	}
+
+	private static void rethrow(Entry<?> e) throws IOException {
+		Throwable err = e.error;
+		if (err == null) {
+			return;
+		}
+		if (err instanceof IOException) {
+			throw (IOException) err;
+		}
+		if (err instanceof RuntimeException) {
+			throw (RuntimeException) err;
+		}
+		throw (Error) err;
+	}
+
+	@Override
+	public T getCurrent() {
+		return cur != null ? cur.id : null;
+	}
+
+	@Override
+	public ObjectId getObjectId() {
+		return getCurrent();
+	}
+
+	@Override
+	public ObjectLoader open() throws IOException {
+		rethrow(cur);
+		return cur.loader;
+	}
+
+	@Override
+	public long getSize() {
+		return cur.size;
+	}
+
+	@Override
+	public boolean cancel(boolean mayInterruptIfRunning) {
+		cancelled = true;
+		return true;
+	}
+
+	@Override
+	public void release() {
+		cancelled = true;
+		if (done != null) {
+			// Unblock workers waiting for room, they stop at their next
+			// object.
+			done.clear();
+		}
+		spilled.clear();
+	}
+}
@@ -190,7 +190,7 @@ void set(int position) {
 		}
 	}
 
-	private static final class CompressedBitmapBuilder implements BitmapBuilder {
+	static final class CompressedBitmapBuilder implements BitmapBuilder {
 		private ComboBitset bitset;
 		private final BitmapIndexImpl bitmapIndex;
 
@@ -256,12 +256,23 @@ public int cardinality() {
 		public boolean removeAllOrNone(PackBitmapIndex index) {
 			if (!bitmapIndex.packIndex.equals(index))
 				return false;
+			return removeAllOrNone(bitmapIndex.indexObjectCount);
+		}
 
-			EWAHCompressedBitmap curr = bitset.combine()
-					.xor(ones(bitmapIndex.indexObjectCount));
+		/**
+		 * Remove the first {@code count} positions from this bitmap if all of
+		 * them are set.
+		 *
+		 * @param count
+		 *            number of leading positions to remove.
+		 * @return true if the positions were removed; false if at least one
+		 *         of them was not set and the bitmap was left unchanged.
+		 */
+		boolean removeAllOrNone(int count) {
+			EWAHCompressedBitmap curr = bitset.combine().xor(ones(count));
 
 			IntIterator ii = curr.intIterator();
-			if (ii.hasNext() && ii.next() < bitmapIndex.indexObjectCount)
+			if (ii.hasNext() && ii.next() < count)
 				return false;
 			bitset = new ComboBitset(curr);
 			return true;
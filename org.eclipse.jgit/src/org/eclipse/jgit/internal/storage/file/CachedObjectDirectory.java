@@ -258,11 +258,21 @@ Collection<Pack> getPacks() {
 		return wrapped.getPacks();
 	}
 
+	@Override
+	PackBitmapIndex getMultiPackBitmapIndex() throws IOException {
+		return wrapped.getMultiPackBitmapIndex();
+	}
+
 	@Override
 	public Optional<CommitGraph> getCommitGraph() {
 		return wrapped.getCommitGraph();
 	}
 
+	@Override
+	PromisorRemote getPromisorRemote() {
+		return wrapped.getPromisorRemote();
+	}
+
 	private static class UnpackedObjectId extends ObjectIdOwnerMap.Entry {
 		UnpackedObjectId(AnyObjectId id) {
 			super(id);
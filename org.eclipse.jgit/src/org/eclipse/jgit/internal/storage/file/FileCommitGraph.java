@@ -30,6 +30,9 @@
  * <p>
  * This is the commit-graph file representation for a Git object database. Each
  * call to {@link FileCommitGraph#get()} will recheck for newer versions.
+ * <p>
+ * Like in C Git, a single {@code info/commit-graph} file takes precedence over
+ * the layers listed by {@code info/commit-graphs/commit-graph-chain}.
  */
 public class FileCommitGraph {
 	private final static Logger LOG = LoggerFactory
@@ -45,13 +48,15 @@ public class FileCommitGraph {
 	 */
 	FileCommitGraph(File objectsDir) {
 		this.baseGraph = new AtomicReference<>(new GraphSnapshot(
-				new File(objectsDir, Constants.INFO_COMMIT_GRAPH)));
+				new File(objectsDir, Constants.INFO_COMMIT_GRAPH),
+				new File(new File(objectsDir, Constants.INFO_COMMIT_GRAPHS),
+						Constants.COMMIT_GRAPH_CHAIN)));
 	}
 
 	/**
 	 * The method will first scan whether the ".git/objects/info/commit-graph"
-	 * has been modified, if so, it will re-parse the file, otherwise it will
-	 * return the same result as the last time.
+	 * or the commit-graph chain has been modified, if so, it will re-parse
+	 * the files, otherwise it will return the same result as the last time.
 	 *
 	 * @return commit-graph or null if commit-graph file does not exist or
 	 *         corrupt.
@@ -80,18 +85,25 @@ CommitGraph get() {
 	private static final class GraphSnapshot {
 		private final File file;
 
+		private final File chainFile;
+
 		private final FileSnapshot snapshot;
 
+		private final FileSnapshot chainSnapshot;
+
 		private final CommitGraph graph;
 
-		GraphSnapshot(@NonNull File file) {
-			this(file, null, null);
+		GraphSnapshot(@NonNull File file, @NonNull File chainFile) {
+			this(file, chainFile, null, null, null);
 		}
 
-		GraphSnapshot(@NonNull File file, FileSnapshot snapshot,
+		GraphSnapshot(@NonNull File file, @NonNull File chainFile,
+				FileSnapshot snapshot, FileSnapshot chainSnapshot,
 				CommitGraph graph) {
 			this.file = file;
+			this.chainFile = chainFile;
 			this.snapshot = snapshot;
+			this.chainSnapshot = chainSnapshot;
 			this.graph = graph;
 		}
 
@@ -100,21 +112,32 @@ CommitGraph getCommitGraph() {
 		}
 
 		GraphSnapshot refresh() {
-			if (graph == null && !file.exists()) {
-				// commit-graph file didn't exist
+			if (graph == null && !file.exists() && !chainFile.exists()) {
+				// neither commit-graph file nor chain existed
 				return this;
 			}
-			if (snapshot != null && !snapshot.isModified(file)) {
-				// commit-graph file was not modified
+			if (snapshot != null && !snapshot.isModified(file)
+					&& !chainSnapshot.isModified(chainFile)) {
+				// commit-graph files were not modified, the layers of a
+				// chain are named by their content and never change
 				return this;
 			}
-			return new GraphSnapshot(file, FileSnapshot.save(file),
-					open(file));
+			FileSnapshot s = save(file);
+			FileSnapshot cs = save(chainFile);
+			CommitGraph g = open(file, CommitGraphLoader::open);
+			if (g == null) {
+				g = open(chainFile, CommitGraphLoader::openChain);
+			}
+			return new GraphSnapshot(file, chainFile, s, cs, g);
 		}
 
-		private static CommitGraph open(File file) {
+		private static FileSnapshot save(File f) {
+			return f.exists() ? FileSnapshot.save(f) : FileSnapshot.MISSING_FILE;
+		}
+
+		private static CommitGraph open(File file, Loader loader) {
 			try {
-				return CommitGraphLoader.open(file);
+				return loader.load(file);
 			} catch (FileNotFoundException noFile) {
 				// ignore if file do not exist
 				return null;
@@ -133,4 +156,9 @@ private static CommitGraph open(File file) {
 			}
 		}
 	}
+
+	@FunctionalInterface
+	private interface Loader {
+		CommitGraph load(File file) throws IOException;
+	}
 }
@@ -73,5 +73,15 @@ abstract InsertLooseObjectResult insertUnpackedObject(File tmp,
 
 	abstract Collection<Pack> getPacks();
 
+	abstract PackBitmapIndex getMultiPackBitmapIndex() throws IOException;
+
 	abstract Optional<CommitGraph> getCommitGraph();
+
+	/**
+	 * Get the remote providing the objects missing from a partial clone.
+	 *
+	 * @return the promisor remote, or null if the repository is not a partial
+	 *         clone
+	 */
+	abstract PromisorRemote getPromisorRemote();
 }
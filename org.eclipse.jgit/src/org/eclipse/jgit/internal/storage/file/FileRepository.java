@@ -194,6 +194,7 @@ public FileRepository(BaseRepositoryBuilder options) throws IOException {
 				options.getAlternateObjectDirectories(), //
 				getFS(), //
 				new File(getDirectory(), Constants.SHALLOW));
+		objectDatabase.setPromisorRemote(new PromisorRemote(this));
 
 		if (objectDatabase.exists()) {
 			if (repositoryFormatVersion > 1)
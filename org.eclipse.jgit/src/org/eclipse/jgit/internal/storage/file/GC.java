@@ -14,9 +14,11 @@
 import static org.eclipse.jgit.internal.storage.pack.PackExt.COMMIT_GRAPH;
 import static org.eclipse.jgit.internal.storage.pack.PackExt.INDEX;
 import static org.eclipse.jgit.internal.storage.pack.PackExt.KEEP;
+import static org.eclipse.jgit.internal.storage.pack.PackExt.MTIMES;
 import static org.eclipse.jgit.internal.storage.pack.PackExt.PACK;
 import static org.eclipse.jgit.internal.storage.pack.PackExt.REVERSE_INDEX;
 
+import java.io.BufferedOutputStream;
 import java.io.File;
 import java.io.FileOutputStream;
 import java.io.IOException;
@@ -59,11 +61,13 @@
 import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.ExecutorService;
 import java.util.function.Supplier;
+import java.util.function.ToLongFunction;
 import java.util.regex.Pattern;
 import java.util.stream.Collectors;
 import java.util.stream.Stream;
 
 import org.eclipse.jgit.annotations.NonNull;
+import org.eclipse.jgit.annotations.Nullable;
 import org.eclipse.jgit.dircache.DirCacheIterator;
 import org.eclipse.jgit.errors.CancelledException;
 import org.eclipse.jgit.errors.CorruptObjectException;
@@ -71,11 +75,19 @@
 import org.eclipse.jgit.errors.MissingObjectException;
 import org.eclipse.jgit.errors.NoWorkTreeException;
 import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.internal.storage.commitgraph.CommitGraph;
+import org.eclipse.jgit.internal.storage.commitgraph.CommitGraphChain;
 import org.eclipse.jgit.internal.storage.commitgraph.CommitGraphWriter;
 import org.eclipse.jgit.internal.storage.commitgraph.GraphCommits;
+import org.eclipse.jgit.internal.storage.midx.MultiPackIndex;
+import org.eclipse.jgit.internal.storage.midx.MultiPackIndexLoader;
+import org.eclipse.jgit.internal.storage.midx.MultiPackIndexWriter;
+import org.eclipse.jgit.internal.storage.pack.DeltaIslands;
+import org.eclipse.jgit.internal.storage.pack.ObjectToPack;
 import org.eclipse.jgit.internal.storage.pack.PackExt;
 import org.eclipse.jgit.internal.storage.pack.PackWriter;
 import org.eclipse.jgit.internal.util.ShutdownHook;
+import org.eclipse.jgit.lib.AnyObjectId;
 import org.eclipse.jgit.lib.ConfigConstants;
 import org.eclipse.jgit.lib.Constants;
 import org.eclipse.jgit.lib.CoreConfig;
@@ -93,15 +105,19 @@
 import org.eclipse.jgit.lib.ReflogReader;
 import org.eclipse.jgit.lib.internal.WorkQueue;
 import org.eclipse.jgit.revwalk.ObjectWalk;
+import org.eclipse.jgit.revwalk.RevFlag;
 import org.eclipse.jgit.revwalk.RevObject;
 import org.eclipse.jgit.revwalk.RevWalk;
+import org.eclipse.jgit.revwalk.filter.ObjectFilter;
 import org.eclipse.jgit.storage.pack.PackConfig;
+import org.eclipse.jgit.storage.pack.PackStatistics;
 import org.eclipse.jgit.treewalk.TreeWalk;
 import org.eclipse.jgit.treewalk.filter.TreeFilter;
 import org.eclipse.jgit.util.FS;
 import org.eclipse.jgit.util.FS.LockToken;
 import org.eclipse.jgit.util.FileUtils;
 import org.eclipse.jgit.util.GitDateParser;
+import org.eclipse.jgit.util.LazyFetch;
 import org.eclipse.jgit.util.StringUtils;
 import org.eclipse.jgit.util.SystemReader;
 import org.slf4j.Logger;
@@ -140,6 +156,16 @@ public class GC {
 
 	private static final boolean DEFAULT_WRITE_COMMIT_GRAPH = false;
 
+	private static final boolean DEFAULT_SPLIT_COMMIT_GRAPH = false;
+
+	private static final int DEFAULT_COMMIT_GRAPH_SIZE_MULTIPLE = 2;
+
+	private static final boolean DEFAULT_WRITE_MULTI_PACK_INDEX = false;
+
+	private static final int DEFAULT_GEOMETRIC_FACTOR = 2;
+
+	private static final boolean DEFAULT_CRUFT_PACKS = false;
+
 	private static volatile ExecutorService executor;
 
 	/**
@@ -167,8 +193,16 @@ public static void setExecutor(ExecutorService e) {
 
 	private Boolean packKeptObjects;
 
+	private Integer geometricFactor;
+
 	private PackConfig pconfig;
 
+	/**
+	 * Statistics of the packs written by the last call to {@link #repack()} or
+	 * {@link #geometricRepack()}.
+	 */
+	private List<PackStatistics> lastPackStatistics = Collections.emptyList();
+
 	/**
 	 * the refs which existed during the last call to {@link #repack()}. This is
 	 * needed during {@link #prune(Set)} where we can optimize by looking at the
@@ -213,7 +247,9 @@ public GC(FileRepository repo) {
 	 * <ul>
 	 * <li>pack loose references into packed-refs</li>
 	 * <li>repack all reachable objects into new pack files and delete the old
-	 * pack files</li>
+	 * pack files, or if a geometric factor is configured, combine only the
+	 * loose objects and the smallest pack files (see
+	 * {@link #geometricRepack()})</li>
 	 * <li>prune all loose objects which are now reachable by packs</li>
 	 * </ul>
 	 *
@@ -282,6 +318,9 @@ private Collection<Pack> doGc() throws IOException, ParseException {
 		if (automatic && !needGc()) {
 			return Collections.emptyList();
 		}
+		// Objects missing from a partial clone are promised by its remote;
+		// gc leaves them alone instead of fetching them.
+		boolean enabled = LazyFetch.disable();
 		try (PidLock lock = new PidLock()) {
 			if (!lock.lock()) {
 				return Collections.emptyList();
@@ -289,13 +328,20 @@ private Collection<Pack> doGc() throws IOException, ParseException {
 			pm.start(6 /* tasks */);
 			packRefs();
 			// TODO: implement reflog_expire(pm, repo);
-			Collection<Pack> newPacks = repack();
+			Collection<Pack> newPacks = getGeometricFactor() > 1
+					? geometricRepack()
+					: repack();
 			prune(Collections.emptySet());
 			// TODO: implement rerere_gc(pm);
 			if (shouldWriteCommitGraphWhenGc()) {
 				writeCommitGraph(refsToObjectIds(getAllRefs()));
 			}
+			if (shouldWriteMultiPackIndexWhenGc()) {
+				writeMultiPackIndex();
+			}
 			return newPacks;
+		} finally {
+			LazyFetch.restore(enabled);
 		}
 	}
 
@@ -361,8 +407,7 @@ private void deleteOldPacks(Collection<Pack> oldPacks,
 		ObjectReader reader = repo.newObjectReader();
 		ObjectDirectory dir = repo.getObjectDatabase();
 		ObjectDirectoryInserter inserter = dir.newInserter();
-		boolean shouldLoosen = !"now".equals(getPruneExpireStr()) && //$NON-NLS-1$
-			getExpireDate() < Long.MAX_VALUE;
+		boolean shouldLoosen = shouldKeepUnreachable();
 
 		prunePreserved();
 		long packExpireDate = getPackExpireDate();
@@ -376,10 +421,7 @@ private void deleteOldPacks(Collection<Pack> oldPacks,
 				if (oldName.equals(newPack.getPackName()))
 					continue oldPackLoop;
 
-			if (!oldPack.shouldBeKept()
-					&& repo.getFS()
-							.lastModifiedInstant(oldPack.getPackFile())
-							.toEpochMilli() < packExpireDate) {
+			if (isExpiredPack(oldPack, packExpireDate)) {
 				if (shouldLoosen) {
 					loosen(inserter, reader, oldPack, ids);
 				}
@@ -388,12 +430,250 @@ private void deleteOldPacks(Collection<Pack> oldPacks,
 			}
 		}
 		packFilesToPrune.forEach(this::prunePack);
+		if (!packFilesToPrune.isEmpty()) {
+			// The multi-pack-index refers to packs which are gone now.
+			deleteMultiPackIndex();
+		}
 
 		// close the complete object database. That's my only chance to force
 		// rescanning and to detect that certain pack files are now deleted.
 		repo.getObjectDatabase().close();
 	}
 
+	/**
+	 * Whether unreachable objects of deleted pack files have to be kept until
+	 * they are old enough to be pruned.
+	 *
+	 * @return true if unreachable objects do not expire immediately
+	 * @throws ParseException
+	 *             if the configuration parameter "gc.pruneexpire" couldn't be
+	 *             parsed
+	 */
+	private boolean shouldKeepUnreachable() throws ParseException {
+		return !"now".equals(getPruneExpireStr()) && //$NON-NLS-1$
+				getExpireDate() < Long.MAX_VALUE;
+	}
+
+	private boolean isExpiredPack(Pack pack, long packExpireDate) {
+		return !pack.shouldBeKept() && repo.getFS()
+				.lastModifiedInstant(pack.getPackFile())
+				.toEpochMilli() < packExpireDate;
+	}
+
+	/**
+	 * Write the unreachable objects of the pack files about to be deleted and
+	 * the unreachable loose objects into a cruft pack, instead of loosening
+	 * them. Objects of old cruft packs keep their recorded modification time,
+	 * other packed objects get the modification time of their pack file.
+	 *
+	 * @param oldPacks
+	 *            old pack files
+	 * @param newPacks
+	 *            new pack files holding all reachable objects
+	 * @return the cruft pack, or null if there are no unreachable objects to
+	 *         keep
+	 * @throws ParseException
+	 *             if an error occurred during parsing
+	 * @throws IOException
+	 *             if an IO error occurred
+	 */
+	private Pack writeCruftPack(Collection<Pack> oldPacks,
+			Collection<Pack> newPacks) throws ParseException, IOException {
+		if (!shouldKeepUnreachable()) {
+			return null;
+		}
+		List<ObjectIdSet> packed = new ArrayList<>(newPacks.size());
+		Set<String> newNames = new HashSet<>();
+		for (Pack p : newPacks) {
+			packed.add(p.getIndex());
+			newNames.add(p.getPackName());
+		}
+		ObjectIdSet isPacked = id -> {
+			for (ObjectIdSet idx : packed) {
+				if (idx.contains(id)) {
+					return true;
+				}
+			}
+			return false;
+		};
+
+		long packExpireDate = getPackExpireDate();
+		try (CruftObjects cruft = new CruftObjects()) {
+			for (Pack oldPack : oldPacks) {
+				checkCancelled();
+				if (!newNames.contains(oldPack.getPackName())
+						&& isExpiredPack(oldPack, packExpireDate)) {
+					cruft.addPack(oldPack, isPacked);
+				}
+			}
+			for (ObjectId id : listLooseObjects()) {
+				checkCancelled();
+				if (!isPacked.contains(id)) {
+					cruft.addLoose(id);
+				}
+			}
+			Pack pack = cruft.write();
+			if (pack != null) {
+				lastPackStatistics.add(cruft.statistics);
+			}
+			return pack;
+		}
+	}
+
+	/**
+	 * Collect the objects of cruft packs which are older than the expire date.
+	 * Objects which are still recent in another cruft pack are not collected.
+	 *
+	 * @param objectsToKeep
+	 *            a set of objects which should explicitly not be pruned
+	 * @param expireDate
+	 *            objects older than this date, in milliseconds since the
+	 *            epoch, expire
+	 * @return ids of the expired objects
+	 * @throws IOException
+	 *             if an IO error occurred
+	 */
+	private Set<ObjectId> listExpiredCruftObjects(Set<ObjectId> objectsToKeep,
+			long expireDate) throws IOException {
+		Set<ObjectId> expired = new HashSet<>();
+		Set<ObjectId> recent = new HashSet<>();
+		Set<ObjectId> indexObjects = null;
+		for (Pack p : repo.getObjectDatabase().getPacks()) {
+			checkCancelled();
+			if (!p.isCruft() || p.shouldBeKept()) {
+				continue;
+			}
+			PackMtimes mtimes = p.getMtimes();
+			int position = 0;
+			for (PackIndex.MutableEntry entry : p) {
+				long mtime = mtimes.getMtime(position++);
+				ObjectId id = entry.toObjectId();
+				if (mtime * 1000 >= expireDate || objectsToKeep.contains(id)) {
+					recent.add(id);
+					continue;
+				}
+				if (indexObjects == null) {
+					indexObjects = listNonHEADIndexObjects();
+				}
+				if (indexObjects.contains(id)) {
+					recent.add(id);
+				} else {
+					expired.add(id);
+				}
+			}
+		}
+		expired.removeAll(recent);
+		return expired;
+	}
+
+	/**
+	 * Rewrite the cruft packs without the given expired objects.
+	 *
+	 * @param expired
+	 *            ids of the objects to drop
+	 * @throws IOException
+	 *             if an IO error occurred
+	 */
+	private void pruneCruftPacks(Set<ObjectId> expired) throws IOException {
+		List<Pack> cruftPacks = new ArrayList<>();
+		Pack newCruft;
+		try (CruftObjects cruft = new CruftObjects()) {
+			for (Pack p : repo.getObjectDatabase().getPacks()) {
+				checkCancelled();
+				if (p.isCruft() && !p.shouldBeKept()) {
+					cruftPacks.add(p);
+					cruft.addPack(p, expired::contains);
+				}
+			}
+			newCruft = cruft.write();
+		}
+		for (Pack p : cruftPacks) {
+			if (newCruft == null
+					|| !p.getPackName().equals(newCruft.getPackName())) {
+				p.close();
+				prunePack(p.getPackFile());
+			}
+		}
+		// The multi-pack-index refers to packs which are gone now.
+		deleteMultiPackIndex();
+	}
+
+	/**
+	 * Unreachable objects collected for a cruft pack, along with their
+	 * modification times.
+	 */
+	private class CruftObjects implements AutoCloseable {
+		private final WindowCursor curs = new WindowCursor(
+				repo.getObjectDatabase());
+
+		private final RevWalk rw = new RevWalk(curs);
+
+		private final List<RevObject> objects = new ArrayList<>();
+
+		/** Modification times in seconds since the epoch. */
+		private final Map<ObjectId, Long> mtimes = new HashMap<>();
+
+		private PackStatistics statistics;
+
+		void addPack(Pack pack, ObjectIdSet skip) throws IOException {
+			PackMtimes packMtimes = pack.isCruft() ? pack.getMtimes() : null;
+			long packMtime = repo.getFS()
+					.lastModifiedInstant(pack.getPackFile()).getEpochSecond();
+			int position = 0;
+			for (PackIndex.MutableEntry entry : pack) {
+				checkCancelled();
+				long mtime = packMtimes != null
+						? packMtimes.getMtime(position)
+						: packMtime;
+				position++;
+				ObjectId id = entry.toObjectId();
+				if (!skip.contains(id)) {
+					add(id, pack.getObjectType(curs, entry.getOffset()),
+							mtime);
+				}
+			}
+		}
+
+		void addLoose(ObjectId id) throws IOException {
+			long mtime = repo.getFS()
+					.lastModifiedInstant(
+							repo.getObjectDatabase().fileFor(id))
+					.getEpochSecond();
+			add(id, curs.open(id).getType(), mtime);
+		}
+
+		private void add(ObjectId id, int type, long mtime) {
+			Long old = mtimes.get(id);
+			if (old == null) {
+				objects.add(rw.lookupAny(id, type));
+				mtimes.put(id, Long.valueOf(mtime));
+			} else if (old.longValue() < mtime) {
+				mtimes.put(id, Long.valueOf(mtime));
+			}
+		}
+
+		Pack write() throws IOException {
+			if (objects.isEmpty()) {
+				return null;
+			}
+			try (PackWriter pw = new PackWriter(pconfig,
+					repo.newObjectReader())) {
+				pw.setDeltaBaseAsOffset(true);
+				pw.setCreateBitmaps(false);
+				pw.preparePack(objects.iterator());
+				Pack pack = writePack(pw, id -> mtimes.get(id).longValue());
+				statistics = pw.getStatistics();
+				return pack;
+			}
+		}
+
+		@Override
+		public void close() {
+			rw.close();
+			curs.close();
+		}
+	}
+
 	/**
 	 * Deletes old pack file, unless 'preserve-oldpacks' is set, in which case
 	 * it moves the pack file to the preserved directory
@@ -589,7 +869,11 @@ public void prune(Set<ObjectId> objectsToKeep) throws IOException,
 			pm.endTask();
 		}
 
-		if (deletionCandidates.isEmpty()) {
+		// Objects in cruft packs expire by their recorded modification time.
+		Set<ObjectId> expiredCruftObjects = listExpiredCruftObjects(
+				objectsToKeep, expireDate);
+
+		if (deletionCandidates.isEmpty() && expiredCruftObjects.isEmpty()) {
 			return;
 		}
 
@@ -624,6 +908,7 @@ public void prune(Set<ObjectId> objectsToKeep) throws IOException,
 			// leave this method.
 			ObjectWalk w = new ObjectWalk(repo);
 			try {
+				w.setObjectFilter(promisedObjectFilter());
 				for (Ref cr : newRefs) {
 					checkCancelled();
 					w.markStart(w.parseAny(cr.getObjectId()));
@@ -632,13 +917,13 @@ public void prune(Set<ObjectId> objectsToKeep) throws IOException,
 					for (Ref lpr : lastPackedRefs) {
 						w.markUninteresting(w.parseAny(lpr.getObjectId()));
 					}
-				removeReferenced(deletionCandidates, w);
+				removeReferenced(deletionCandidates, expiredCruftObjects, w);
 			} finally {
 				w.dispose();
 			}
 		}
 
-		if (deletionCandidates.isEmpty())
+		if (deletionCandidates.isEmpty() && expiredCruftObjects.isEmpty())
 			return;
 
 		// Since we have not left the method yet there are still
@@ -648,6 +933,7 @@ public void prune(Set<ObjectId> objectsToKeep) throws IOException,
 		// additional reflog entries not handled during last repack()
 		ObjectWalk w = new ObjectWalk(repo);
 		try {
+			w.setObjectFilter(promisedObjectFilter());
 			for (Ref ar : getAllRefs())
 				for (ObjectId id : listRefLogObjects(ar, lastRepackTime)) {
 					checkCancelled();
@@ -658,12 +944,12 @@ public void prune(Set<ObjectId> objectsToKeep) throws IOException,
 					checkCancelled();
 					w.markUninteresting(w.parseAny(lpr.getObjectId()));
 				}
-			removeReferenced(deletionCandidates, w);
+			removeReferenced(deletionCandidates, expiredCruftObjects, w);
 		} finally {
 			w.dispose();
 		}
 
-		if (deletionCandidates.isEmpty())
+		if (deletionCandidates.isEmpty() && expiredCruftObjects.isEmpty())
 			return;
 
 		checkCancelled();
@@ -685,6 +971,10 @@ public void prune(Set<ObjectId> objectsToKeep) throws IOException,
 					FileUtils.EMPTY_DIRECTORIES_ONLY | FileUtils.IGNORE_ERRORS);
 		}
 
+		if (!expiredCruftObjects.isEmpty()) {
+			pruneCruftPacks(expiredCruftObjects);
+		}
+
 		repo.getObjectDatabase().close();
 	}
 
@@ -748,12 +1038,13 @@ private long getPackExpireDate() throws ParseException {
 	 *             if an IO error occurred
 	 */
 	private void removeReferenced(Map<ObjectId, File> id2File,
-			ObjectWalk w) throws MissingObjectException,
-			IncorrectObjectTypeException, IOException {
+			Set<ObjectId> cruftIds, ObjectWalk w)
+			throws MissingObjectException, IncorrectObjectTypeException,
+			IOException {
 		RevObject ro = w.next();
 		while (ro != null) {
 			checkCancelled();
-			if (id2File.remove(ro.getId()) != null && id2File.isEmpty()) {
+			if (removeReferenced(id2File, cruftIds, ro)) {
 				return;
 			}
 			ro = w.next();
@@ -761,13 +1052,20 @@ private void removeReferenced(Map<ObjectId, File> id2File,
 		ro = w.nextObject();
 		while (ro != null) {
 			checkCancelled();
-			if (id2File.remove(ro.getId()) != null && id2File.isEmpty()) {
+			if (removeReferenced(id2File, cruftIds, ro)) {
 				return;
 			}
 			ro = w.nextObject();
 		}
 	}
 
+	private static boolean removeReferenced(Map<ObjectId, File> id2File,
+			Set<ObjectId> cruftIds, RevObject ro) {
+		boolean removed = id2File.remove(ro.getId()) != null;
+		removed |= cruftIds.remove(ro.getId());
+		return removed && id2File.isEmpty() && cruftIds.isEmpty();
+	}
+
 	private static boolean equals(Ref r1, Ref r2) {
 		if (r1 == null || r2 == null) {
 			return false;
@@ -823,7 +1121,9 @@ public void packRefs() throws IOException {
 	 * which are reachable from any of the other refs (e.g. tags), special refs
 	 * (e.g. FETCH_HEAD) or index are packed into a separate pack file. Objects
 	 * included in pack files which have a .keep file associated are never
-	 * repacked. All old pack files which existed before are deleted.
+	 * repacked. Neither are the pack files fetched from the promisor remote of
+	 * a partial clone, and the objects they reference are not looked for. All
+	 * other old pack files which existed before are deleted.
 	 *
 	 * @return a collection of the newly created pack files
 	 * @throws java.io.IOException
@@ -832,7 +1132,15 @@ public void packRefs() throws IOException {
 	 *             {@link java.io.IOException} occurs
 	 */
 	public Collection<Pack> repack() throws IOException {
-		Collection<Pack> toBeDeleted = repo.getObjectDatabase().getPacks();
+		Collection<Pack> toBeDeleted = new ArrayList<>();
+		List<Pack> promisorPacks = new ArrayList<>();
+		for (Pack p : repo.getObjectDatabase().getPacks()) {
+			if (p.isPromisor()) {
+				promisorPacks.add(p);
+			} else {
+				toBeDeleted.add(p);
+			}
+		}
 
 		long time = System.currentTimeMillis();
 		Collection<Ref> refsBefore = getAllRefs();
@@ -867,7 +1175,13 @@ public Collection<Pack> repack() throws IOException {
 		}
 
 		List<ObjectIdSet> excluded = new LinkedList<>();
-		for (Pack p : repo.getObjectDatabase().getPacks()) {
+		List<ObjectIdSet> promisor = new ArrayList<>();
+		for (Pack p : promisorPacks) {
+			checkCancelled();
+			promisor.add(p.getIndex());
+		}
+		excluded.addAll(promisor);
+		for (Pack p : toBeDeleted) {
 			checkCancelled();
 			if (!shouldPackKeptObjects() && p.shouldBeKept()) {
 				excluded.add(p.getIndex());
@@ -889,23 +1203,59 @@ public Collection<Pack> repack() throws IOException {
 			nonHeads.clear();
 		}
 
+		// Every pack which is not excluded is rewritten; account for them in
+		// the statistics of the first pack written.
+		long rewrittenBytes = 0;
+		long reusedBytes = 0;
+		for (Pack p : promisorPacks) {
+			reusedBytes += p.getPackFile().length();
+		}
+		for (Pack p : toBeDeleted) {
+			if (!shouldPackKeptObjects() && p.shouldBeKept()) {
+				reusedBytes += p.getPackFile().length();
+			} else {
+				rewrittenBytes += p.getPackFile().length();
+			}
+		}
+
+		DeltaIslands islands = null;
+		if (pconfig.isUseDeltaIslands()
+				&& pconfig.getDeltaIslands().length > 0) {
+			checkCancelled();
+			try (ObjectReader reader = repo.newObjectReader()) {
+				islands = DeltaIslands.compute(reader,
+						pconfig.getDeltaIslands(), refsBefore, pm);
+			}
+		}
+
+		lastPackStatistics = new ArrayList<>(2);
 		List<Pack> ret = new ArrayList<>(2);
 		Pack heads = null;
 		if (!allHeadsAndTags.isEmpty()) {
 			heads = writePack(allHeadsAndTags, PackWriter.NONE, allTags,
-					refsToExcludeFromBitmap, tagTargets, excluded, true);
+					refsToExcludeFromBitmap, tagTargets, excluded, promisor,
+					islands, true, rewrittenBytes, reusedBytes);
 			if (heads != null) {
 				ret.add(heads);
 				excluded.add(0, heads.getIndex());
+				rewrittenBytes = 0;
+				reusedBytes = 0;
 			}
 		}
 		if (!nonHeads.isEmpty()) {
 			Pack rest = writePack(nonHeads, allHeadsAndTags, PackWriter.NONE,
-					PackWriter.NONE, tagTargets, excluded, false);
+					PackWriter.NONE, tagTargets, excluded, promisor, islands,
+					false, rewrittenBytes, reusedBytes);
 			if (rest != null)
 				ret.add(rest);
 		}
 		try {
+			if (shouldWriteCruftPacks()) {
+				Pack cruft = writeCruftPack(toBeDeleted, ret);
+				if (cruft != null) {
+					ret.add(cruft);
+				}
+			}
 			deleteOldPacks(toBeDeleted, ret);
 		} catch (ParseException e) {
 			// TODO: the exception has to be wrapped into an IOException because
@@ -926,6 +1276,212 @@ public Collection<Pack> repack() throws IOException {
 		return ret;
 	}
 
+	/**
+	 * Like "git repack --geometric=&lt;factor&gt; -d" this method combines
+	 * the loose objects and the smallest pack files into a single new pack
+	 * file, keeping the object counts of the remaining pack files in a
+	 * geometric progression. Each pack file left in place holds at least
+	 * {@code factor} times as many objects as the next smaller one.
+	 * <p>
+	 * Unlike {@link #repack()} this does not walk the history; only the pack
+	 * files which break the progression are rewritten, larger pack files and
+	 * pack files with a .keep file are left untouched. The combined pack
+	 * files are deleted like the old pack files of {@link #repack()}, once
+	 * they expired. The factor is taken from
+	 * {@link #setGeometricFactor(int)} or the config parameter
+	 * {@code repack.geometricFactor}; if neither is greater than 1 a factor
+	 * of 2 is used.
+	 *
+	 * @return a collection of the newly created pack files
+	 * @throws java.io.IOException
+	 *             when during reading of packfiles or objects or during
+	 *             writing to the packfiles {@link java.io.IOException} occurs
+	 * @since 6.9
+	 */
+	public Collection<Pack> geometricRepack() throws IOException {
+		int factor = getGeometricFactor();
+		if (factor <= 1) {
+			factor = DEFAULT_GEOMETRIC_FACTOR;
+		}
+		long time = System.currentTimeMillis();
+		Collection<Ref> refsBefore = getAllRefs();
+		ObjectDirectory odb = repo.getObjectDatabase();
+		List<Pack> candidates = new ArrayList<>();
+		List<Pack> retained = new ArrayList<>();
+		Map<Pack, Long> objectCounts = new HashMap<>();
+		for (Pack p : odb.getPacks()) {
+			checkCancelled();
+			if (p.shouldBeKept() || p.isCruft() || p.isPromisor()) {
+				retained.add(p);
+			} else {
+				candidates.add(p);
+				objectCounts.put(p,
+						Long.valueOf(p.getIndex().getObjectCount()));
+			}
+		}
+		candidates.sort(Comparator.comparing(objectCounts::get));
+		long[] counts = new long[candidates.size()];
+		for (int i = 0; i < counts.length; i++) {
+			counts[i] = objectCounts.get(candidates.get(i)).longValue();
+		}
+		int split = geometricSplit(counts, factor);
+		List<Pack> rollUp = candidates.subList(0, split);
+		retained.addAll(candidates.subList(split, candidates.size()));
+
+		Set<ObjectId> looseObjects = listLooseObjects();
+		lastPackStatistics = new ArrayList<>(1);
+		if (looseObjects.isEmpty() && rollUp.size() < 2) {
+			// The pack files already form a geometric progression.
+			lastPackedRefs = refsBefore;
+			lastRepackTime = time;
+			return Collections.emptyList();
+		}
+
+		long rewrittenBytes = 0;
+		for (Pack p : rollUp) {
+			rewrittenBytes += p.getPackFile().length();
+		}
+		long reusedBytes = 0;
+		for (Pack p : retained) {
+			reusedBytes += p.getPackFile().length();
+		}
+
+		Pack pack;
+		WindowCursor curs = new WindowCursor(odb);
+		try (PackWriter pw = new PackWriter(pconfig, curs);
+				RevWalk rw = new RevWalk(curs)) {
+			pw.setDeltaBaseAsOffset(true);
+			pw.setReuseDeltaCommits(false);
+			for (Pack p : retained) {
+				pw.excludeObjects(p.getIndex());
+			}
+			pw.setCreateBitmaps(false);
+			pw.setRepackedPackSizes(rewrittenBytes, reusedBytes);
+
+			List<RevObject> objects = new ArrayList<>();
+			for (Pack p : rollUp) {
+				for (PackIndex.MutableEntry entry : p) {
+					checkCancelled();
+					RevObject o = rw.lookupAny(entry.toObjectId(),
+							p.getObjectType(curs, entry.getOffset()));
+					if (!o.has(RevFlag.SEEN)) {
+						o.add(RevFlag.SEEN);
+						objects.add(o);
+					}
+				}
+			}
+			for (ObjectId id : looseObjects) {
+				checkCancelled();
+				RevObject o = rw.lookupAny(id, curs.open(id).getType());
+				if (!o.has(RevFlag.SEEN)) {
+					o.add(RevFlag.SEEN);
+					objects.add(o);
+				}
+			}
+			pw.preparePack(objects.iterator());
+			pack = writePack(pw, null);
+			if (pack != null) {
+				lastPackStatistics.add(pw.getStatistics());
+			}
+		}
+
+		Collection<Pack> newPacks = pack != null
+				? Collections.singletonList(pack)
+				: Collections.emptyList();
+		try {
+			deleteOldPacks(rollUp, newPacks);
+		} catch (ParseException e) {
+			// See repack() why the exception is wrapped
+			throw new IOException(e);
+		}
+		prunePacked();
+		deleteTempPacksIdx();
+
+		// All loose objects were packed, so prune() may skip the objects
+		// reachable from these refs like after repack().
+		lastPackedRefs = refsBefore;
+		lastRepackTime = time;
+		return newPacks;
+	}
+
+	/**
+	 * Compute how many of the smallest pack files need to be combined so that
+	 * the object counts of all pack files form a geometric progression. This
+	 * follows the split computation of "git repack --geometric".
+	 *
+	 * @param counts
+	 *            object counts of the pack files, in ascending order
+	 * @param factor
+	 *            factor of the progression
+	 * @return the number of pack files, starting with the smallest one, to
+	 *         combine
+	 */
+	static int geometricSplit(long[] counts, int factor) {
+		int i;
+		for (i = counts.length - 1; i > 0; i--) {
+			if (counts[i] < factor * counts[i - 1]) {
+				break;
+			}
+		}
+		int split = i;
+		if (split > 0) {
+			// The larger pack of the last compared pair is not part of the
+			// progression either.
+			split++;
+		}
+		long total = 0;
+		for (i = 0; i < split; i++) {
+			total += counts[i];
+		}
+		// The combined pack may break the progression with the next larger
+		// packs; combine those as well.
+		for (i = split; i < counts.length; i++) {
+			if (counts[i] >= factor * total) {
+				break;
+			}
+			split++;
+			total += counts[i];
+		}
+		return split;
+	}
+
+	/**
+	 * List the ids of all loose objects.
+	 *
+	 * @return ids of all loose objects
+	 * @throws CancelledException
+	 *             if the operation was cancelled
+	 */
+	private Set<ObjectId> listLooseObjects() throws CancelledException {
+		Set<ObjectId> ids = new HashSet<>();
+		File objects = repo.getObjectsDirectory();
+		String[] fanout = objects.list();
+		if (fanout == null) {
+			return ids;
+		}
+		for (String d : fanout) {
+			checkCancelled();
+			if (d.length() != 2) {
+				continue;
+			}
+			String[] entries = new File(objects, d).list();
+			if (entries == null) {
+				continue;
+			}
+			for (String e : entries) {
+				if (e.length() != Constants.OBJECT_ID_STRING_LENGTH - 2) {
+					continue;
+				}
+				try {
+					ids.add(ObjectId.fromString(d + e));
+				} catch (IllegalArgumentException notAnObject) {
+					// ignoring the file that does not represent loose object
+				}
+			}
+		}
+		return ids;
+	}
+
 	private Set<ObjectId> refsToObjectIds(Collection<Ref> refs)
 			throws IOException {
 		Set<ObjectId> objectIds = new HashSet<>();
@@ -945,14 +1501,20 @@ private Set<ObjectId> refsToObjectIds(Collection<Ref> refs)
 
 	/**
 	 * Generate a new commit-graph file when 'core.commitGraph' is true.
+	 * <p>
+	 * If {@code gc.splitCommitGraph} is true only the commits which are not in
+	 * the commit-graph chain yet are written, to a new layer of the chain,
+	 * which is cheap enough to be done after each push. Layers of similar
+	 * size are merged, see {@code gc.commitGraphSizeMultiple}.
 	 *
 	 * @param wants
 	 *            the list of wanted objects, writer walks commits starting at
 	 *            these. Must not be {@code null}.
 	 * @throws IOException
 	 *             if an IO error occurred
+	 * @since 6.9
 	 */
-	void writeCommitGraph(@NonNull Set<? extends ObjectId> wants)
+	public void writeCommitGraph(@NonNull Set<? extends ObjectId> wants)
 			throws IOException {
 		if (!repo.getConfig().get(CoreConfig.KEY).enableCommitGraph()) {
 			return;
@@ -964,42 +1526,177 @@ void writeCommitGraph(@NonNull Set<? extends ObjectId> wants)
 		if (wants.isEmpty()) {
 			return;
 		}
+		File graphsDir = new File(repo.getObjectsDirectory(),
+				Constants.INFO_COMMIT_GRAPHS);
+		if (shouldSplitCommitGraph()) {
+			writeCommitGraphLayer(wants, graphsDir);
+		} else {
+			FileUtils.mkdirs(graphsDir, true);
+			LockFile lock = new LockFile(
+					new File(graphsDir, Constants.COMMIT_GRAPH_CHAIN));
+			if (!lock.lock()) {
+				// Another process is writing the commit-graph
+				return;
+			}
+			File tmpFile = null;
+			try (RevWalk walk = new RevWalk(repo)) {
+				CommitGraphWriter writer = new CommitGraphWriter(
+						GraphCommits.fromWalk(pm, wants, walk),
+						shouldWriteBloomFilter());
+				tmpFile = File.createTempFile("commit_", //$NON-NLS-1$
+						COMMIT_GRAPH.getTmpExtension(),
+						repo.getObjectDatabase().getInfoDirectory());
+				writeCommitGraphFile(writer, tmpFile);
+
+				// rename the temporary file to real file
+				File realFile = new File(repo.getObjectsDirectory(),
+						Constants.INFO_COMMIT_GRAPH);
+				FileUtils.rename(tmpFile, realFile,
+						StandardCopyOption.ATOMIC_MOVE);
+
+				// The chain is shadowed by the commit-graph file now
+				FileUtils.delete(
+						new File(graphsDir, Constants.COMMIT_GRAPH_CHAIN),
+						FileUtils.SKIP_MISSING);
+				deleteUnusedCommitGraphLayers(graphsDir,
+						Collections.emptySet());
+			} finally {
+				lock.unlock();
+				if (tmpFile != null && tmpFile.exists()) {
+					tmpFile.delete();
+				}
+			}
+		}
+		deleteTempCommitGraph(
+				repo.getObjectDatabase().getInfoDirectory().toPath());
+		deleteTempCommitGraph(graphsDir.toPath());
+	}
+
+	/**
+	 * Write the commits not yet in the commit-graph chain to a new layer, and
+	 * replace the chain by its base layers and the new layer.
+	 */
+	private void writeCommitGraphLayer(Set<? extends ObjectId> wants,
+			File graphsDir) throws IOException {
+		FileUtils.mkdirs(graphsDir, true);
+		File chainFile = new File(graphsDir, Constants.COMMIT_GRAPH_CHAIN);
+		LockFile lock = new LockFile(chainFile);
+		if (!lock.lock()) {
+			// Another process is adding a layer
+			return;
+		}
 		File tmpFile = null;
 		try (RevWalk walk = new RevWalk(repo)) {
-			CommitGraphWriter writer = new CommitGraphWriter(
-					GraphCommits.fromWalk(pm, wants, walk),
+			GraphCommits commits;
+			try {
+				commits = GraphCommits.fromWalk(pm, wants, walk,
+						getCommitGraphChain(), getCommitGraphSizeMultiple());
+			} catch (MissingObjectException e) {
+				// History of a commit in a merged layer was pruned, start a
+				// new chain from the wants.
+				commits = GraphCommits.fromWalk(pm, wants, walk,
+						CommitGraphChain.EMPTY, getCommitGraphSizeMultiple());
+			}
+			CommitGraphWriter writer = new CommitGraphWriter(commits,
 					shouldWriteBloomFilter());
 			tmpFile = File.createTempFile("commit_", //$NON-NLS-1$
-					COMMIT_GRAPH.getTmpExtension(),
-					repo.getObjectDatabase().getInfoDirectory());
-			// write the commit-graph file
-			try (FileOutputStream fos = new FileOutputStream(tmpFile);
-					FileChannel channel = fos.getChannel();
-					OutputStream channelStream = Channels
-							.newOutputStream(channel)) {
-				writer.write(pm, channelStream);
-				channel.force(true);
+					COMMIT_GRAPH.getTmpExtension(), graphsDir);
+			ObjectId layerId = writeCommitGraphFile(writer, tmpFile)
+					.getChecksum();
+			if (layerId == null) {
+				// All commits are in the chain already
+				return;
+			}
+			String layerName = CommitGraphChain.getLayerFileName(layerId);
+			FileUtils.rename(tmpFile, new File(graphsDir, layerName),
+					StandardCopyOption.ATOMIC_MOVE);
+
+			CommitGraphChain base = commits.getBase();
+			Set<String> layers = new HashSet<>();
+			StringBuilder chain = new StringBuilder();
+			for (int i = 0; i < base.getLayerCount(); i++) {
+				ObjectId id = base.getLayerId(i);
+				layers.add(CommitGraphChain.getLayerFileName(id));
+				chain.append(id.name()).append('\n');
+			}
+			layers.add(layerName);
+			chain.append(layerId.name()).append('\n');
+			lock.setFSync(true);
+			lock.write(Constants.encode(chain.toString()));
+			if (!lock.commit()) {
+				throw new IOException(MessageFormat.format(
+						JGitText.get().cannotCommitWriteTo, chainFile));
 			}
 
-			// rename the temporary file to real file
-			File realFile = new File(repo.getObjectsDirectory(),
-					Constants.INFO_COMMIT_GRAPH);
-			FileUtils.rename(tmpFile, realFile, StandardCopyOption.ATOMIC_MOVE);
+			// A commit-graph file would shadow the chain
+			FileUtils.delete(new File(repo.getObjectsDirectory(),
+					Constants.INFO_COMMIT_GRAPH), FileUtils.SKIP_MISSING);
+			deleteUnusedCommitGraphLayers(graphsDir, layers);
 		} finally {
+			lock.unlock();
 			if (tmpFile != null && tmpFile.exists()) {
 				tmpFile.delete();
 			}
 		}
-		deleteTempCommitGraph();
 	}
 
-	private void deleteTempCommitGraph() {
-		Path objectsDir = repo.getObjectDatabase().getInfoDirectory().toPath();
+	private CommitGraphChain getCommitGraphChain() {
+		CommitGraph graph = repo.getObjectDatabase().getCommitGraph()
+				.orElse(null);
+		// A single commit-graph file is replaced by a new chain
+		return graph instanceof CommitGraphChain ? (CommitGraphChain) graph
+				: CommitGraphChain.EMPTY;
+	}
+
+	private CommitGraphWriter.Stats writeCommitGraphFile(
+			CommitGraphWriter writer, File file) throws IOException {
+		try (FileOutputStream fos = new FileOutputStream(file);
+				FileChannel channel = fos.getChannel();
+				OutputStream channelStream = Channels
+						.newOutputStream(channel)) {
+			CommitGraphWriter.Stats stats = writer.write(pm, channelStream);
+			channel.force(true);
+			return stats;
+		}
+	}
+
+	/**
+	 * Delete the layers not in the chain anymore. Like packs, layers are
+	 * kept until they expire, since readers which loaded the previous chain
+	 * may still open them.
+	 */
+	private void deleteUnusedCommitGraphLayers(File graphsDir,
+			Set<String> layers) throws IOException {
+		if (!graphsDir.exists()) {
+			return;
+		}
+		long expireDate;
+		try {
+			expireDate = getPackExpireDate();
+		} catch (ParseException e) {
+			// See repack() why the exception is wrapped
+			throw new IOException(e);
+		}
+		try (DirectoryStream<Path> stream = Files
+				.newDirectoryStream(graphsDir.toPath(), "graph-*.graph")) { //$NON-NLS-1$
+			for (Path p : stream) {
+				if (!layers.contains(p.getFileName().toString())
+						&& repo.getFS().lastModifiedInstant(p)
+								.toEpochMilli() < expireDate) {
+					Files.deleteIfExists(p);
+				}
+			}
+		} catch (IOException e) {
+			LOG.error(e.getMessage(), e);
+		}
+	}
+
+	private void deleteTempCommitGraph(Path dir) {
 		Instant threshold = Instant.now().minus(1, ChronoUnit.DAYS);
-		if (!Files.exists(objectsDir)) {
+		if (!Files.exists(dir)) {
 			return;
 		}
-		try (DirectoryStream<Path> stream = Files.newDirectoryStream(objectsDir,
+		try (DirectoryStream<Path> stream = Files.newDirectoryStream(dir,
 				"commit_*_tmp")) { //$NON-NLS-1$
 			stream.forEach(t -> {
 				try {
@@ -1017,6 +1714,195 @@ private void deleteTempCommitGraph() {
 		}
 	}
 
+	/**
+	 * Write a multi-pack-index covering all packs of the repository.
+	 * <p>
+	 * The largest pack is the preferred pack: if an object is stored in more
+	 * than one pack the multi-pack-index refers to the copy in the preferred
+	 * pack, otherwise to the copy in the most recently modified pack. If
+	 * bitmaps are enabled by the pack config, reachability bitmaps spanning
+	 * all packs are written along with the multi-pack-index.
+	 *
+	 * @throws IOException
+	 *             if an IO error occurred
+	 * @since 6.9
+	 */
+	public void writeMultiPackIndex() throws IOException {
+		checkCancelled();
+		Collection<Pack> packs = repo.getObjectDatabase().getPacks();
+		if (packs.isEmpty()) {
+			deleteMultiPackIndex();
+			return;
+		}
+		Pack preferred = null;
+		for (Pack p : packs) {
+			if (preferred == null || p.getIndex().getObjectCount() > preferred
+					.getIndex().getObjectCount()) {
+				preferred = p;
+			}
+		}
+		MultiPackIndexWriter writer = new MultiPackIndexWriter();
+		writer.addPack(preferred.getPackFile().create(INDEX).getName(),
+				preferred.getIndex());
+		for (Pack p : packs) {
+			if (p != preferred) {
+				writer.addPack(p.getPackFile().create(INDEX).getName(),
+						p.getIndex());
+			}
+		}
+		File packDir = repo.getObjectDatabase().getPackDirectory();
+		File tmpFile = null;
+		File tmpBitmapFile = null;
+		try {
+			tmpFile = File.createTempFile("gc_", "_midx_tmp", packDir); //$NON-NLS-1$ //$NON-NLS-2$
+			try (FileOutputStream fos = new FileOutputStream(tmpFile);
+					FileChannel channel = fos.getChannel();
+					OutputStream channelStream = new BufferedOutputStream(
+							Channels.newOutputStream(channel))) {
+				writer.write(pm, channelStream);
+				channelStream.flush();
+				channel.force(true);
+			}
+
+			String bitmapName = null;
+			if (pconfig.isBuildBitmaps()) {
+				MultiPackIndex midx = MultiPackIndexLoader.open(tmpFile);
+				tmpBitmapFile = File.createTempFile("gc_", //$NON-NLS-1$
+						"_midx_bitmap_tmp", packDir); //$NON-NLS-1$
+				if (writeMultiPackBitmapIndex(midx, packs, tmpBitmapFile)) {
+					// Install the bitmaps first, readers look for them once
+					// they see the new multi-pack-index.
+					bitmapName = MultiPackBitmapIndex.getFileName(midx);
+					FileUtils.rename(tmpBitmapFile,
+							new File(packDir, bitmapName),
+							StandardCopyOption.ATOMIC_MOVE);
+				}
+			}
+
+			File realFile = new File(packDir, Constants.MULTI_PACK_INDEX);
+			FileUtils.rename(tmpFile, realFile, StandardCopyOption.ATOMIC_MOVE);
+			deleteMultiPackBitmaps(bitmapName);
+		} finally {
+			if (tmpFile != null && tmpFile.exists()) {
+				tmpFile.delete();
+			}
+			if (tmpBitmapFile != null && tmpBitmapFile.exists()) {
+				tmpBitmapFile.delete();
+			}
+		}
+	}
+
+	/**
+	 * Compute reachability bitmaps numbering the objects of a
+	 * multi-pack-index in pseudo-pack order.
+	 *
+	 * @param midx
+	 *            the multi-pack-index.
+	 * @param packs
+	 *            packs covered by the multi-pack-index.
+	 * @param bitmapFile
+	 *            file to write the bitmaps to.
+	 * @return whether bitmaps were written; false if some reachable object is
+	 *         not covered by the multi-pack-index.
+	 * @throws IOException
+	 *             if an IO error occurred
+	 */
+	private boolean writeMultiPackBitmapIndex(MultiPackIndex midx,
+			Collection<Pack> packs, File bitmapFile) throws IOException {
+		Map<String, Pack> byIndexName = new HashMap<>();
+		for (Pack p : packs) {
+			byIndexName.put(p.getPackFile().create(INDEX).getName(), p);
+		}
+		String[] names = midx.getPackNames();
+		Pack[] byPackId = new Pack[names.length];
+		for (int i = 0; i < names.length; i++) {
+			byPackId[i] = byIndexName.get(names[i]);
+		}
+
+		WindowCursor curs = new WindowCursor(repo.getObjectDatabase());
+		try (PackWriter pw = new PackWriter(pconfig, curs)) {
+			int count = midx.getObjectCount();
+			List<ObjectToPack> objects = new ArrayList<>(count);
+			for (int i = 0; i < count; i++) {
+				checkCancelled();
+				Pack p = byPackId[midx.getPackId(i)];
+				ObjectToPack otp = new ObjectToPack(midx.getObjectId(i),
+						p.getObjectType(curs, midx.getOffset(i)));
+				otp.setOffset(midx.getPseudoPackPosition(i));
+				objects.add(otp);
+			}
+
+			PackBitmapIndexBuilder bitmaps = pw.prepareBitmapIndex(pm,
+					objects, refsToObjectIds(getAllRefs()));
+			if (bitmaps == null) {
+				return false;
+			}
+			try (FileOutputStream fos = new FileOutputStream(bitmapFile);
+					FileChannel channel = fos.getChannel();
+					OutputStream channelStream = Channels
+							.newOutputStream(channel)) {
+				new PackBitmapIndexWriterV1(channelStream).write(bitmaps,
+						midx.getChecksum());
+				channel.force(true);
+			}
+			return true;
+		}
+	}
+
+	private void deleteMultiPackIndex() throws IOException {
+		File midx = new File(repo.getObjectDatabase().getPackDirectory(),
+				Constants.MULTI_PACK_INDEX);
+		FileUtils.delete(midx, FileUtils.RETRY | FileUtils.SKIP_MISSING);
+		deleteMultiPackBitmaps(null);
+	}
+
+	/**
+	 * Delete the bitmap files of multi-pack-indexes.
+	 *
+	 * @param keep
+	 *            name of the bitmap file to keep, or null.
+	 */
+	private void deleteMultiPackBitmaps(String keep) {
+		Path packDir = repo.getObjectDatabase().getPackDirectory().toPath();
+		if (!Files.exists(packDir)) {
+			return;
+		}
+		try (DirectoryStream<Path> stream = Files.newDirectoryStream(packDir,
+				Constants.MULTI_PACK_INDEX + "-*.bitmap")) { //$NON-NLS-1$
+			for (Path bitmap : stream) {
+				if (!bitmap.getFileName().toString().equals(keep)) {
+					Files.deleteIfExists(bitmap);
+				}
+			}
+		} catch (IOException e) {
+			LOG.error(e.getMessage(), e);
+		}
+	}
+
+	/**
+	 * If {@code true}, will rewrite the multi-pack-index file when gc is run.
+	 *
+	 * @return true if multi-pack-index should be written. Default is
+	 *         {@code false}.
+	 */
+	boolean shouldWriteMultiPackIndexWhenGc() {
+		return repo.getConfig().getBoolean(ConfigConstants.CONFIG_GC_SECTION,
+				ConfigConstants.CONFIG_KEY_WRITE_MULTI_PACK_INDEX,
+				DEFAULT_WRITE_MULTI_PACK_INDEX);
+	}
+
+	/**
+	 * If {@code true}, {@link #repack()} writes unreachable objects into a
+	 * cruft pack instead of loosening them.
+	 *
+	 * @return true if cruft packs should be written. Default is
+	 *         {@code false}.
+	 */
+	boolean shouldWriteCruftPacks() {
+		return repo.getConfig().getBoolean(ConfigConstants.CONFIG_GC_SECTION,
+				ConfigConstants.CONFIG_KEY_CRUFT_PACKS, DEFAULT_CRUFT_PACKS);
+	}
+
 	/**
 	 * If {@code true}, will rewrite the commit-graph file when gc is run.
 	 *
@@ -1039,6 +1925,31 @@ boolean shouldWriteBloomFilter() {
 				DEFAULT_WRITE_BLOOM_FILTER);
 	}
 
+	/**
+	 * If {@code true}, the commit-graph is written as a chain of layers, and
+	 * only the commits which are not in the chain yet are written.
+	 *
+	 * @return true if the commit-graph should be split. Default is
+	 *         {@code false}.
+	 */
+	boolean shouldSplitCommitGraph() {
+		return repo.getConfig().getBoolean(ConfigConstants.CONFIG_GC_SECTION,
+				ConfigConstants.CONFIG_KEY_SPLIT_COMMIT_GRAPH,
+				DEFAULT_SPLIT_COMMIT_GRAPH);
+	}
+
+	/**
+	 * Get the size ratio of adjacent commit-graph layers below which they are
+	 * merged.
+	 *
+	 * @return the size multiple. Default is {@code 2}.
+	 */
+	int getCommitGraphSizeMultiple() {
+		return repo.getConfig().getInt(ConfigConstants.CONFIG_GC_SECTION,
+				ConfigConstants.CONFIG_KEY_COMMIT_GRAPH_SIZE_MULTIPLE,
+				DEFAULT_COMMIT_GRAPH_SIZE_MULTIPLE);
+	}
+
 	private static boolean isHead(Ref ref) {
 		return ref.getName().startsWith(Constants.R_HEADS);
 	}
@@ -1101,6 +2012,11 @@ private void delete(Path d) {
 
 	private static Optional<PackFile> toPackFileWithValidExt(
 			Path packFilePath) {
+		if (packFilePath.getFileName().toString()
+				.startsWith(Constants.MULTI_PACK_INDEX)) {
+			// Bitmaps of the multi-pack-index don't belong to a pack.
+			return Optional.empty();
+		}
 		try {
 			PackFile packFile = new PackFile(packFilePath.toFile());
 			if (packFile.getPackExt() == null) {
@@ -1295,8 +2211,64 @@ private Set<ObjectId> listNonHEADIndexObjects()
 	private Pack writePack(@NonNull Set<? extends ObjectId> want,
 			@NonNull Set<? extends ObjectId> have, @NonNull Set<ObjectId> tags,
 			@NonNull Set<ObjectId> excludedRefsTips,
-			Set<ObjectId> tagTargets, List<ObjectIdSet> excludeObjects, boolean createBitmap)
-			throws IOException {
+			Set<ObjectId> tagTargets, List<ObjectIdSet> excludeObjects,
+			List<ObjectIdSet> promisor, DeltaIslands islands,
+			boolean createBitmap, long rewrittenPackBytes,
+			long reusedPackBytes) throws IOException {
+		checkCancelled();
+		try (PackWriter pw = new PackWriter(
+				pconfig,
+				repo.newObjectReader())) {
+			// prepare the PackWriter
+			pw.setDeltaBaseAsOffset(true);
+			pw.setReuseDeltaCommits(false);
+			if (tagTargets != null) {
+				pw.setTagTargets(tagTargets);
+			}
+			if (excludeObjects != null)
+				for (ObjectIdSet idx : excludeObjects)
+					pw.excludeObjects(idx);
+			pw.setDeltaIslands(islands);
+			pw.setRepackedPackSizes(rewrittenPackBytes, reusedPackBytes);
+			if (promisor.isEmpty()) {
+				pw.setCreateBitmaps(createBitmap);
+				pw.preparePack(pm, want, have, PackWriter.NONE,
+						union(tags, excludedRefsTips));
+			} else {
+				// Bitmaps would have to cover the promised objects too,
+				// which a partial clone does not have.
+				pw.setUseBitmaps(false);
+				pw.setCreateBitmaps(false);
+				try (ObjectWalk walk = new ObjectWalk(repo)) {
+					walk.setObjectFilter(new PromisedObjectFilter(promisor));
+					pw.preparePack(pm, walk, want, have,
+							union(tags, excludedRefsTips));
+				}
+			}
+			Pack pack = writePack(pw, null);
+			if (pack != null) {
+				lastPackStatistics.add(pw.getStatistics());
+			}
+			return pack;
+		}
+	}
+
+	/**
+	 * Write the objects prepared in a PackWriter into a new pack file.
+	 *
+	 * @param pw
+	 *            the prepared PackWriter
+	 * @param mtimes
+	 *            modification times of the objects if a cruft pack is written,
+	 *            otherwise null
+	 * @return the new pack, or null if there was nothing to write
+	 * @throws IOException
+	 *             if an IO error occurred
+	 */
+	private Pack writePack(PackWriter pw,
+			@Nullable ToLongFunction<AnyObjectId> mtimes) throws IOException {
+		if (pw.getObjectCount() == 0)
+			return null;
 		checkCancelled();
 		File tmpPack = null;
 		Map<PackExt, File> tmpExts = new TreeMap<>((o1, o2) -> {
@@ -1314,25 +2286,7 @@ private Pack writePack(@NonNull Set<? extends ObjectId> want,
 			}
 			return Integer.signum(o1.hashCode() - o2.hashCode());
 		});
-		try (PackWriter pw = new PackWriter(
-				pconfig,
-				repo.newObjectReader())) {
-			// prepare the PackWriter
-			pw.setDeltaBaseAsOffset(true);
-			pw.setReuseDeltaCommits(false);
-			if (tagTargets != null) {
-				pw.setTagTargets(tagTargets);
-			}
-			if (excludeObjects != null)
-				for (ObjectIdSet idx : excludeObjects)
-					pw.excludeObjects(idx);
-			pw.setCreateBitmaps(createBitmap);
-			pw.preparePack(pm, want, have, PackWriter.NONE,
-					union(tags, excludedRefsTips));
-			if (pw.getObjectCount() == 0)
-				return null;
-			checkCancelled();
-
+		try {
 			// create temporary files
 			ObjectId id = pw.computeName();
 			File packdir = repo.getObjectDatabase().getPackDirectory();
@@ -1385,6 +2339,24 @@ private Pack writePack(@NonNull Set<? extends ObjectId> want,
 				}
 			}
 
+			if (mtimes != null) {
+				File tmpMtimes = new File(packdir,
+						tmpBase + MTIMES.getTmpExtension());
+				tmpExts.put(MTIMES, tmpMtimes);
+				if (!tmpMtimes.createNewFile()) {
+					throw new IOException(MessageFormat.format(
+							JGitText.get().cannotCreateIndexfile,
+							tmpMtimes.getPath()));
+				}
+				try (FileOutputStream fos = new FileOutputStream(tmpMtimes);
+						FileChannel channel = fos.getChannel();
+						OutputStream stream = Channels
+								.newOutputStream(channel)) {
+					pw.writeMtimes(stream, mtimes);
+					channel.force(true);
+				}
+			}
+
 			if (pw.prepareBitmapIndex(pm)) {
 				File tmpBitmapIdx = new File(packdir,
 						tmpBase + BITMAP_INDEX.getTmpExtension());
@@ -1492,6 +2464,41 @@ private boolean shouldPackKeptObjects() {
 				.orElse(pconfig.isPackKeptObjects());
 	}
 
+	/**
+	 * Set the factor of the geometric progression of pack sizes which
+	 * {@link #gc()} maintains. If the factor is greater than 1 {@link #gc()}
+	 * calls {@link #geometricRepack()} instead of {@link #repack()}. If not
+	 * set the config parameter {@code repack.geometricFactor} is used.
+	 *
+	 * @param factor
+	 *            factor of the geometric progression; 0 or 1 to repack all
+	 *            objects
+	 * @since 6.9
+	 */
+	public void setGeometricFactor(int factor) {
+		this.geometricFactor = Integer.valueOf(factor);
+	}
+
+	private int getGeometricFactor() {
+		if (geometricFactor != null) {
+			return geometricFactor.intValue();
+		}
+		return repo.getConfig().getInt(ConfigConstants.CONFIG_REPACK_SECTION,
+				ConfigConstants.CONFIG_KEY_GEOMETRIC_FACTOR, 0);
+	}
+
+	/**
+	 * Get statistics of the pack files written by the last call to
+	 * {@link #repack()} or {@link #geometricRepack()}.
+	 *
+	 * @return statistics of the pack files written by the last repack; empty
+	 *         if no repack was done or it did not write any pack file
+	 * @since 6.9
+	 */
+	public List<PackStatistics> getPackStatistics() {
+		return Collections.unmodifiableList(lastPackStatistics);
+	}
+
 	/**
 	 * A class holding statistical data for a FileRepository regarding how many
 	 * objects are stored as loose or packed objects
@@ -1806,6 +2813,50 @@ private int getLooseObjectLimit() {
 				ConfigConstants.CONFIG_KEY_AUTO, DEFAULT_AUTOLIMIT);
 	}
 
+	/**
+	 * Get the filter for walks over the objects of a partial clone.
+	 *
+	 * @return the filter, or null if there are no promisor packs
+	 * @throws IOException
+	 *             the index of a promisor pack could not be read
+	 */
+	@Nullable
+	private ObjectFilter promisedObjectFilter() throws IOException {
+		List<ObjectIdSet> promisor = new ArrayList<>();
+		for (Pack p : repo.getObjectDatabase().getPacks()) {
+			if (p.isPromisor()) {
+				promisor.add(p.getIndex());
+			}
+		}
+		return promisor.isEmpty() ? null : new PromisedObjectFilter(promisor);
+	}
+
+	/**
+	 * Stops the walk at the objects of the promisor packs of a partial clone.
+	 * The objects they reference are promised by the remote, and are either
+	 * missing or are not needed to decide which objects to keep.
+	 */
+	private static class PromisedObjectFilter extends ObjectFilter {
+		private final List<ObjectIdSet> promisor;
+
+		PromisedObjectFilter(List<ObjectIdSet> promisor) {
+			this.promisor = promisor;
+		}
+
+		@Override
+		public boolean include(ObjectWalk walker, AnyObjectId objid)
+				throws IOException {
+			for (ObjectIdSet idx : promisor) {
+				if (idx.contains(objid)) {
+					return false;
+				}
+			}
+			// A tree written locally may reference an object which was
+			// never fetched.
+			return walker.getObjectReader().has(objid);
+		}
+	}
+
 	private class PidLock implements AutoCloseable {
 
 		private static final String GC_PID = "gc.pid"; //$NON-NLS-1$
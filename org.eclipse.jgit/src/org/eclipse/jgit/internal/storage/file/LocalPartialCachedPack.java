@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.file;
+
+import java.io.IOException;
+import java.util.Arrays;
+
+import org.eclipse.jgit.internal.storage.pack.CachedPack;
+import org.eclipse.jgit.internal.storage.pack.ObjectToPack;
+import org.eclipse.jgit.internal.storage.pack.PackOutputStream;
+import org.eclipse.jgit.internal.storage.pack.StoredObjectRepresentation;
+
+import com.googlecode.javaewah.EWAHCompressedBitmap;
+
+/**
+ * Objects of a pack which can be copied as they are, without the remaining
+ * objects of the pack.
+ * <p>
+ * The leading run of objects of the pack is copied in one piece. Every
+ * following object is copied on its own, in pack order, and the offset of
+ * its delta base is rewritten if objects between the two were left out.
+ */
+class LocalPartialCachedPack extends CachedPack {
+	final Pack pack;
+
+	/** Bitmap positions of the objects, as in the pack's bitmap index. */
+	final EWAHCompressedBitmap positions;
+
+	/** Offset of the first object following the leading run. */
+	final long runEnd;
+
+	/** Sorted offsets of the objects following the leading run. */
+	final long[] offsets;
+
+	LocalPartialCachedPack(Pack pack, EWAHCompressedBitmap positions,
+			long runEnd, long[] offsets) {
+		this.pack = pack;
+		this.positions = positions;
+		this.runEnd = runEnd;
+		this.offsets = offsets;
+	}
+
+	@Override
+	public long getObjectCount() throws IOException {
+		return positions.cardinality();
+	}
+
+	void copyAsIs(PackOutputStream out, WindowCursor wc) throws IOException {
+		pack.copyPartialAsIs(out, this, wc);
+	}
+
+	@Override
+	public boolean hasObject(ObjectToPack obj, StoredObjectRepresentation rep) {
+		LocalObjectRepresentation local = (LocalObjectRepresentation) rep;
+		return local.pack == pack && (local.offset < runEnd
+				|| Arrays.binarySearch(offsets, local.offset) >= 0);
+	}
+}
@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.file;
+
+import static java.nio.charset.StandardCharsets.UTF_8;
+import static org.eclipse.jgit.lib.Constants.OBJECT_ID_STRING_LENGTH;
+import static org.eclipse.jgit.lib.Ref.Storage.PACKED;
+
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.security.MessageDigest;
+import java.text.MessageFormat;
+
+import org.eclipse.jgit.annotations.Nullable;
+import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.lib.ObjectIdRef;
+import org.eclipse.jgit.lib.Ref;
+import org.eclipse.jgit.util.RawParseUtils;
+import org.eclipse.jgit.util.RefList;
+import org.eclipse.jgit.util.SystemReader;
+
+/**
+ * A sorted {@code packed-refs} file mapped into memory.
+ * <p>
+ * References are found by binary search over the file's records, and
+ * {@link Ref} objects are only created for the references looked up. This
+ * keeps reading a large {@code packed-refs} file cheap if callers only look
+ * at a few references, or at the references below a prefix.
+ * <p>
+ * On Windows a mapped file cannot be replaced until the mapping is garbage
+ * collected, which would make updates of {@code packed-refs} fail. There the
+ * file is read into memory instead.
+ */
+final class MappedPackedRefs {
+	/** Length of the object id and the space preceding the name. */
+	private static final int NAME_OFFSET = OBJECT_ID_STRING_LENGTH + 1;
+
+	/**
+	 * Map a {@code packed-refs} file.
+	 *
+	 * @param file
+	 *            the file to map
+	 * @return the mapped file, or null if the file's header does not declare
+	 *         it is sorted, or it is too large to be mapped at once
+	 * @throws java.io.FileNotFoundException
+	 *             if the file does not exist
+	 * @throws IOException
+	 *             if the file cannot be mapped
+	 */
+	@Nullable
+	static MappedPackedRefs open(File file) throws IOException {
+		ByteBuffer buf;
+		try (FileInputStream in = new FileInputStream(file);
+				FileChannel ch = in.getChannel()) {
+			long size = ch.size();
+			if (size > Integer.MAX_VALUE) {
+				return null;
+			}
+			if (SystemReader.getInstance().isWindows()) {
+				buf = ByteBuffer.allocate((int) size);
+				while (buf.hasRemaining() && ch.read(buf) >= 0) {
+					// Read until the buffer is full.
+				}
+				buf.flip();
+			} else {
+				buf = ch.map(FileChannel.MapMode.READ_ONLY, 0, size);
+			}
+		}
+		MappedPackedRefs refs = new MappedPackedRefs(file, buf);
+		return refs.sorted ? refs : null;
+	}
+
+	private final File file;
+
+	private final ByteBuffer buf;
+
+	private final int end;
+
+	/** Offset of the first record, after the header line. */
+	private final int start;
+
+	private final boolean sorted;
+
+	private final boolean peeled;
+
+	private MappedPackedRefs(File file, ByteBuffer buf) {
+		this.file = file;
+		this.buf = buf;
+		this.end = buf.limit();
+		String traits = ""; //$NON-NLS-1$
+		if (end > 0 && buf.get(0) == '#') {
+			start = nextLine(0);
+			String header = RawParseUtils.decode(UTF_8, bytes(0, start));
+			if (header.startsWith(RefDirectory.PACKED_REFS_HEADER)) {
+				traits = header
+						.substring(RefDirectory.PACKED_REFS_HEADER.length());
+			}
+		} else {
+			start = 0;
+		}
+		sorted = traits.contains(RefDirectory.PACKED_REFS_SORTED);
+		peeled = traits.contains(RefDirectory.PACKED_REFS_PEELED);
+	}
+
+	/**
+	 * Compute the digest of the file's content.
+	 *
+	 * @param digest
+	 *            the digest to update
+	 */
+	void digest(MessageDigest digest) {
+		digest.update(buf.duplicate());
+	}
+
+	/**
+	 * Look up a reference.
+	 *
+	 * @param name
+	 *            name of the reference
+	 * @return the reference, or null if the file does not contain it
+	 * @throws IOException
+	 *             if the file is corrupt
+	 */
+	@Nullable
+	Ref get(String name) throws IOException {
+		byte[] key = name.getBytes(UTF_8);
+		int rec = lowerBound(key);
+		if (rec < end && compareName(rec, key) == 0) {
+			return parse(rec);
+		}
+		return null;
+	}
+
+	/**
+	 * Read the references starting with a prefix.
+	 *
+	 * @param prefix
+	 *            prefix of the reference names, the empty string reads all
+	 *            references
+	 * @return the references, sorted by name
+	 * @throws IOException
+	 *             if the file is corrupt
+	 */
+	RefList<Ref> getRefs(String prefix) throws IOException {
+		RefList.Builder<Ref> refs = new RefList.Builder<>();
+		int rec = prefix.isEmpty() ? start : lowerBound(prefix.getBytes(UTF_8));
+		while (rec < end) {
+			Ref ref = parse(rec);
+			if (!ref.getName().startsWith(prefix)) {
+				break;
+			}
+			refs.add(ref);
+			rec = nextRecord(rec);
+		}
+		return refs.toRefList();
+	}
+
+	/** @return offset of the first record whose name is not below key */
+	private int lowerBound(byte[] key) throws IOException {
+		int lo = start;
+		int hi = end;
+		while (lo < hi) {
+			int rec = recordStart(lo, lo + (hi - lo) / 2);
+			if (compareName(rec, key) < 0) {
+				lo = nextRecord(rec);
+			} else {
+				hi = rec;
+			}
+		}
+		return lo;
+	}
+
+	/** @return start of the record containing pos, not before lo */
+	private int recordStart(int lo, int pos) {
+		int p = lineStart(lo, pos);
+		if (lo < p && buf.get(p) == '^') {
+			// A peeled line belongs to the record before it.
+			p = lineStart(lo, p - 1);
+		}
+		return p;
+	}
+
+	private int lineStart(int lo, int pos) {
+		int p = pos;
+		while (lo < p && buf.get(p - 1) != '\n') {
+			p--;
+		}
+		return p;
+	}
+
+	private int nextLine(int pos) {
+		int p = pos;
+		while (p < end && buf.get(p++) != '\n') {
+			// Skip to the start of the next line.
+		}
+		return p;
+	}
+
+	private int nextRecord(int rec) {
+		int p = nextLine(rec);
+		if (p < end && buf.get(p) == '^') {
+			p = nextLine(p);
+		}
+		return p;
+	}
+
+	/**
+	 * Compare the name of a record to a key like git sorts the file, by the
+	 * unsigned bytes of the names.
+	 */
+	private int compareName(int rec, byte[] key) throws IOException {
+		int eol = lineEnd(rec);
+		if (eol - rec <= NAME_OFFSET) {
+			throw corrupt();
+		}
+		int p = rec + NAME_OFFSET;
+		for (int i = 0; i < key.length; i++, p++) {
+			if (p == eol) {
+				return -1;
+			}
+			int cmp = (buf.get(p) & 0xff) - (key[i] & 0xff);
+			if (cmp != 0) {
+				return cmp;
+			}
+		}
+		return p == eol ? 0 : 1;
+	}
+
+	private Ref parse(int rec) throws IOException {
+		if (buf.get(rec) == '^') {
+			throw new IOException(JGitText.get().peeledLineBeforeRef);
+		}
+		int eol = lineEnd(rec);
+		if (eol - rec <= NAME_OFFSET
+				|| buf.get(rec + OBJECT_ID_STRING_LENGTH) != ' ') {
+			throw corrupt();
+		}
+		byte[] line = bytes(rec, eol);
+		ObjectId id = ObjectId.fromString(line, 0);
+		String name = RawParseUtils.decode(UTF_8, line, NAME_OFFSET,
+				line.length);
+		int next = nextLine(rec);
+		if (next < end && buf.get(next) == '^') {
+			if (lineEnd(next) - next <= OBJECT_ID_STRING_LENGTH) {
+				throw corrupt();
+			}
+			ObjectId peeledId = ObjectId.fromString(
+					bytes(next + 1, next + 1 + OBJECT_ID_STRING_LENGTH), 0);
+			return new ObjectIdRef.PeeledTag(PACKED, name, id, peeledId);
+		}
+		if (peeled) {
+			return new ObjectIdRef.PeeledNonTag(PACKED, name, id);
+		}
+		return new ObjectIdRef.Unpeeled(PACKED, name, id);
+	}
+
+	private int lineEnd(int pos) {
+		int p = pos;
+		while (p < end && buf.get(p) != '\n') {
+			p++;
+		}
+		return p;
+	}
+
+	private byte[] bytes(int from, int to) {
+		byte[] b = new byte[to - from];
+		for (int i = 0; i < b.length; i++) {
+			b[i] = buf.get(from + i);
+		}
+		return b;
+	}
+
+	private IOException corrupt() {
+		return new IOException(MessageFormat.format(
+				JGitText.get().packedRefsCorruptionDetected,
+				file.getAbsolutePath()));
+	}
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.file;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.InputStream;
+import java.text.MessageFormat;
+import java.util.Arrays;
+
+import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.internal.storage.file.PackBitmapIndexV1.BitmapFile;
+import org.eclipse.jgit.internal.storage.midx.MultiPackIndex;
+import org.eclipse.jgit.lib.AnyObjectId;
+import org.eclipse.jgit.lib.Constants;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.lib.ObjectIdOwnerMap;
+import org.eclipse.jgit.util.io.SilentFileInputStream;
+
+import com.googlecode.javaewah.EWAHCompressedBitmap;
+
+/**
+ * Reachability bitmaps covering all packs of a
+ * {@link org.eclipse.jgit.internal.storage.midx.MultiPackIndex}.
+ * <p>
+ * The file uses the v1 bitmap format. Bitmap entries refer to their commit by
+ * its position in the multi-pack-index, bits are numbered by pseudo-pack
+ * position and the header carries the checksum of the multi-pack-index
+ * instead of a pack checksum.
+ */
+public class MultiPackBitmapIndex extends BasePackBitmapIndex {
+	private final MultiPackIndex midx;
+
+	private final EWAHCompressedBitmap commits;
+
+	private final EWAHCompressedBitmap trees;
+
+	private final EWAHCompressedBitmap blobs;
+
+	private final EWAHCompressedBitmap tags;
+
+	/**
+	 * Get the name of the bitmap file belonging to a multi-pack-index.
+	 *
+	 * @param midx
+	 *            the multi-pack-index.
+	 * @return name of the bitmap file, relative to the pack directory.
+	 */
+	public static String getFileName(MultiPackIndex midx) {
+		return Constants.MULTI_PACK_INDEX + '-'
+				+ ObjectId.fromRaw(midx.getChecksum()).name() + ".bitmap"; //$NON-NLS-1$
+	}
+
+	/**
+	 * Read an existing multi-pack-index bitmap file.
+	 *
+	 * @param bitmapFile
+	 *            the bitmap file to read.
+	 * @param midx
+	 *            the multi-pack-index the bitmaps belong to.
+	 * @return the bitmap index.
+	 * @throws java.io.FileNotFoundException
+	 *             the file does not exist.
+	 * @throws IOException
+	 *             the file cannot be read, or belongs to another
+	 *             multi-pack-index.
+	 */
+	public static MultiPackBitmapIndex open(File bitmapFile,
+			MultiPackIndex midx) throws IOException {
+		try (SilentFileInputStream fd = new SilentFileInputStream(
+				bitmapFile)) {
+			try {
+				return read(fd, midx);
+			} catch (IOException ioe) {
+				throw new IOException(MessageFormat.format(
+						JGitText.get().unreadableMultiPackBitmapFile,
+						bitmapFile.getAbsolutePath()), ioe);
+			}
+		}
+	}
+
+	/**
+	 * Read a multi-pack-index bitmap file from a buffered stream.
+	 *
+	 * @param fd
+	 *            stream to read the bitmap file from. The caller is
+	 *            responsible for closing the stream.
+	 * @param midx
+	 *            the multi-pack-index the bitmaps belong to.
+	 * @return the bitmap index.
+	 * @throws IOException
+	 *             the stream cannot be read, or the bitmaps belong to another
+	 *             multi-pack-index.
+	 */
+	public static MultiPackBitmapIndex read(InputStream fd,
+			MultiPackIndex midx) throws IOException {
+		return new MultiPackBitmapIndex(fd, midx);
+	}
+
+	private MultiPackBitmapIndex(InputStream fd, MultiPackIndex midx)
+			throws IOException {
+		super(new ObjectIdOwnerMap<>());
+		this.midx = midx;
+
+		BitmapFile file = PackBitmapIndexV1.readBitmapFile(fd);
+		if (!Arrays.equals(file.checksum, midx.getChecksum())) {
+			throw new IOException(MessageFormat.format(
+					JGitText.get().multiPackBitmapChecksumMismatch,
+					ObjectId.fromRaw(file.checksum).name(),
+					ObjectId.fromRaw(midx.getChecksum()).name()));
+		}
+		this.packChecksum = file.checksum;
+		this.commits = file.commits;
+		this.trees = file.trees;
+		this.blobs = file.blobs;
+		this.tags = file.tags;
+		file.storeBitmaps(getBitmaps(), midx.getObjectCount(),
+				midx::getObjectId);
+	}
+
+	/**
+	 * Get the multi-pack-index these bitmaps belong to.
+	 *
+	 * @return the multi-pack-index.
+	 */
+	public MultiPackIndex getMultiPackIndex() {
+		return midx;
+	}
+
+	@Override
+	public int findPosition(AnyObjectId objectId) {
+		int position = midx.findPosition(objectId);
+		if (position < 0) {
+			return -1;
+		}
+		return midx.getPseudoPackPosition(position);
+	}
+
+	@Override
+	public ObjectId getObject(int position) throws IllegalArgumentException {
+		if (position < 0 || position >= midx.getObjectCount()) {
+			throw new IllegalArgumentException();
+		}
+		return midx.getObjectId(midx.getPositionAtPseudoPackPosition(position));
+	}
+
+	@Override
+	public EWAHCompressedBitmap ofObjectType(EWAHCompressedBitmap bitmap,
+			int type) {
+		switch (type) {
+		case Constants.OBJ_BLOB:
+			return blobs.and(bitmap);
+		case Constants.OBJ_TREE:
+			return trees.and(bitmap);
+		case Constants.OBJ_COMMIT:
+			return commits.and(bitmap);
+		case Constants.OBJ_TAG:
+			return tags.and(bitmap);
+		}
+		throw new IllegalArgumentException();
+	}
+
+	@Override
+	public int getObjectCount() {
+		return midx.getObjectCount();
+	}
+
+	@Override
+	public int getBitmapCount() {
+		return getBitmaps().size();
+	}
+}
@@ -101,6 +101,8 @@ public class ObjectDirectory extends FileObjectDatabase {
 
 	private Set<ObjectId> shallowCommitsIds;
 
+	private PromisorRemote promisorRemote;
+
 	/**
 	 * Initialize a reference to an on-disk object directory.
 	 *
@@ -214,6 +216,11 @@ public Collection<Pack> getPacks() {
 		return packed.getPacks();
 	}
 
+	@Override
+	PackBitmapIndex getMultiPackBitmapIndex() throws IOException {
+		return packed.getMultiPackBitmapIndex();
+	}
+
 	@Override
 	public long getApproximateObjectCount() {
 		long count = 0;
@@ -563,6 +570,16 @@ Config getConfig() {
 		return config;
 	}
 
+	void setPromisorRemote(PromisorRemote remote) {
+		promisorRemote = remote;
+	}
+
+	@Override
+	PromisorRemote getPromisorRemote() {
+		PromisorRemote remote = promisorRemote;
+		return remote != null && remote.getName() != null ? remote : null;
+	}
+
 	@Override
 	FS getFS() {
 		return fs;
@@ -12,11 +12,15 @@
 
 package org.eclipse.jgit.internal.storage.file;
 
+import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_INDEX_THREADS;
+import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_PACK_SECTION;
+
 import java.io.File;
 import java.io.FileOutputStream;
 import java.io.IOException;
 import java.io.InputStream;
 import java.io.RandomAccessFile;
+import java.nio.file.Files;
 import java.nio.file.StandardCopyOption;
 import java.security.MessageDigest;
 import java.text.MessageFormat;
@@ -32,6 +36,9 @@
 import org.eclipse.jgit.lib.Constants;
 import org.eclipse.jgit.lib.CoreConfig;
 import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.lib.ObjectInserter;
+import org.eclipse.jgit.lib.ObjectLoader;
+import org.eclipse.jgit.lib.ObjectStream;
 import org.eclipse.jgit.lib.ProgressMonitor;
 import org.eclipse.jgit.storage.pack.PackConfig;
 import org.eclipse.jgit.transport.PackLock;
@@ -94,6 +101,9 @@ public class ObjectDirectoryPackParser extends PackParser {
 
 	private PackConfig pconfig;
 
+	/** Number of objects sent, without the bases appended to thin packs. */
+	private long headerObjectCount;
+
 	ObjectDirectoryPackParser(FileObjectDatabase odb, InputStream src) {
 		super(odb, src);
 		this.db = odb;
@@ -102,6 +112,8 @@ public class ObjectDirectoryPackParser extends PackParser {
 		this.tailDigest = Constants.newMessageDigest();
 
 		indexVersion = db.getConfig().get(CoreConfig.KEY).getPackIndexVersion();
+		setThreads(db.getConfig().getInt(CONFIG_PACK_SECTION,
+				CONFIG_KEY_INDEX_THREADS, 1));
 	}
 
 	/**
@@ -174,6 +186,11 @@ public PackLock parse(ProgressMonitor receiving, ProgressMonitor resolving)
 
 			writeIdx();
 
+			if (!isPromisor() && headerObjectCount < getUnpackLimit()) {
+				unpackObjects();
+				return null;
+			}
+
 			tmpPack.setReadOnly();
 			tmpIdx.setReadOnly();
 
@@ -193,7 +210,7 @@ public PackLock parse(ProgressMonitor receiving, ProgressMonitor resolving)
 
 	@Override
 	protected void onPackHeader(long objectCount) throws IOException {
-		// Ignored, the count is not required.
+		headerObjectCount = objectCount;
 	}
 
 	@Override
@@ -284,6 +301,27 @@ protected boolean checkCRC(int oldCRC) {
 		return oldCRC == (int) crc.getValue();
 	}
 
+	@Override
+	protected DatabaseReader newDatabaseReader() throws IOException {
+		RandomAccessFile raf = new RandomAccessFile(tmpPack, "r"); //$NON-NLS-1$
+		return new DatabaseReader() {
+			@Override
+			public void seek(long position) throws IOException {
+				raf.seek(position);
+			}
+
+			@Override
+			public int read(byte[] dst, int pos, int cnt) throws IOException {
+				return raf.read(dst, pos, cnt);
+			}
+
+			@Override
+			public void close() throws IOException {
+				raf.close();
+			}
+		};
+	}
+
 	private static String baseName(File tmpPack) {
 		String name = tmpPack.getName();
 		return name.substring(0, name.lastIndexOf('.'));
@@ -394,6 +432,47 @@ private void writeIdx() throws IOException {
 		}
 	}
 
+	/*
+	 * Stores the objects of the received pack as loose objects. The pack is
+	 * read from a private directory, under a name Pack can open.
+	 */
+	private void unpackObjects() throws IOException {
+		File dir = Files.createTempDirectory(db.getDirectory().toPath(),
+				"incoming_").toFile(); //$NON-NLS-1$
+		try {
+			PackFile packFile = new PackFile(dir, ObjectId.fromRaw(packHash),
+					PackExt.PACK);
+			FileUtils.rename(tmpPack, packFile,
+					StandardCopyOption.ATOMIC_MOVE);
+			FileUtils.rename(tmpIdx, packFile.create(PackExt.INDEX),
+					StandardCopyOption.ATOMIC_MOVE);
+			Pack pack = new Pack(db.getConfig(), packFile, null);
+			try (WindowCursor curs = new WindowCursor(db);
+					ObjectInserter ins = db.newInserter()) {
+				long written = 0;
+				for (int i = 0; i < getObjectCount(); i++) {
+					PackedObjectInfo oe = getObject(i);
+					// Skips bases appended to thin packs and duplicates.
+					if (db.has(oe)) {
+						continue;
+					}
+					ObjectLoader ldr = pack.get(curs, oe);
+					try (ObjectStream in = ldr.openStream()) {
+						ins.insert(ldr.getType(), ldr.getSize(), in);
+					}
+					written++;
+				}
+				ins.flush();
+				setLooseObjectCount(written);
+			} finally {
+				pack.close();
+			}
+		} finally {
+			FileUtils.delete(dir,
+					FileUtils.RECURSIVE | FileUtils.IGNORE_ERRORS);
+		}
+	}
+
 	private PackLock renameAndOpenPack(String lockMessage)
 			throws IOException {
 		if (!keepEmpty && getObjectCount() == 0) {
@@ -447,12 +526,27 @@ private PackLock renameAndOpenPack(String lockMessage)
 			}
 		}
 
+		PackFile promisorFile = finalPack.create(PackExt.PROMISOR);
+		if (isPromisor()) {
+			// Mark the pack before it appears, so that it is never seen
+			// without its marker.
+			try {
+				FileUtils.createNewFile(promisorFile);
+			} catch (IOException e) {
+				cleanupTemporaryFiles();
+				keep.unlock();
+				throw e;
+			}
+		}
+
 		try {
 			FileUtils.rename(tmpPack, finalPack,
 					StandardCopyOption.ATOMIC_MOVE);
 		} catch (IOException e) {
 			cleanupTemporaryFiles();
 			keep.unlock();
+			FileUtils.delete(promisorFile,
+					FileUtils.SKIP_MISSING | FileUtils.IGNORE_ERRORS);
 			throw new IOException(MessageFormat.format(
 					JGitText.get().cannotMovePackTo, finalPack), e);
 		}
@@ -464,6 +558,8 @@ private PackLock renameAndOpenPack(String lockMessage)
 			keep.unlock();
 			if (!finalPack.delete())
 				finalPack.deleteOnExit();
+			FileUtils.delete(promisorFile,
+					FileUtils.SKIP_MISSING | FileUtils.IGNORE_ERRORS);
 			throw new IOException(MessageFormat.format(
 					JGitText.get().cannotMoveIndexTo, finalIdx), e);
 		}
@@ -485,6 +581,8 @@ private PackLock renameAndOpenPack(String lockMessage)
 				FileUtils.delete(finalPack);
 			if (finalIdx.exists())
 				FileUtils.delete(finalIdx);
+			FileUtils.delete(promisorFile,
+					FileUtils.SKIP_MISSING | FileUtils.IGNORE_ERRORS);
 			throw err;
 		} finally {
 			if (interrupted) {
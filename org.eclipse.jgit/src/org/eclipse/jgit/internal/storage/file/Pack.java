@@ -14,6 +14,8 @@
 
 import static org.eclipse.jgit.internal.storage.pack.PackExt.INDEX;
 import static org.eclipse.jgit.internal.storage.pack.PackExt.KEEP;
+import static org.eclipse.jgit.internal.storage.pack.PackExt.MTIMES;
+import static org.eclipse.jgit.internal.storage.pack.PackExt.PROMISOR;
 import static org.eclipse.jgit.internal.storage.pack.PackExt.REVERSE_INDEX;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_CORE_SECTION;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_PACKED_INDEX_GIT_USE_STRONGREFS;
@@ -70,6 +72,9 @@
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
+import com.googlecode.javaewah.EWAHCompressedBitmap;
+import com.googlecode.javaewah.IntIterator;
+
 /**
  * A Git version 2 pack file representation. A pack file contains Git objects in
  * delta packed format yielding high compression of lots of object where some
@@ -124,6 +129,8 @@ public class Pack implements Iterable<PackIndex.MutableEntry> {
 
 	private Optionally<PackBitmapIndex> bitmapIdx = Optionally.empty();
 
+	private PackMtimes mtimes;
+
 	/**
 	 * Objects we have tried to read, and discovered to be corrupt.
 	 * <p>
@@ -271,6 +278,52 @@ public boolean shouldBeKept() {
 		return keepFile.exists();
 	}
 
+	/**
+	 * Determines whether this is a cruft pack, holding unreachable objects
+	 * along with their modification times in a .mtimes file.
+	 *
+	 * @return true if a .mtimes file exists.
+	 */
+	boolean isCruft() {
+		return packFile.create(MTIMES).exists();
+	}
+
+	/**
+	 * Determines whether this pack was fetched from the promisor remote of a
+	 * partial clone, which promises the objects it references.
+	 *
+	 * @return true if a .promisor file exists.
+	 */
+	boolean isPromisor() {
+		return packFile.create(PROMISOR).exists();
+	}
+
+	/**
+	 * Get the modification times of the objects of this cruft pack.
+	 *
+	 * @return the modification times, by position in the pack index.
+	 * @throws IOException
+	 *             the .mtimes file does not exist, cannot be read or belongs
+	 *             to another pack.
+	 */
+	synchronized PackMtimes getMtimes() throws IOException {
+		if (mtimes == null) {
+			PackIndex idx = idx();
+			PackMtimes m = PackMtimes.open(packFile.create(MTIMES),
+					idx.getObjectCount());
+			if (!Arrays.equals(idx.packChecksum, m.getPackChecksum())) {
+				throw new PackMismatchException(MessageFormat.format(
+						JGitText.get().packChecksumMismatch,
+						packFile.getPath(), PackExt.INDEX.getExtension(),
+						Hex.toHexString(idx.packChecksum),
+						PackExt.MTIMES.getExtension(),
+						Hex.toHexString(m.getPackChecksum())));
+			}
+			mtimes = m;
+		}
+		return mtimes;
+	}
+
 	/**
 	 * Get an object from this pack.
 	 *
@@ -289,6 +342,34 @@ ObjectLoader get(WindowCursor curs, AnyObjectId id)
 		return 0 < offset && !isCorrupt(offset) ? load(curs, offset) : null;
 	}
 
+	/**
+	 * Get an object from this pack by its offset, as located by a
+	 * multi-pack-index.
+	 *
+	 * @param curs
+	 *            temporary working space associated with the calling thread.
+	 * @param offset
+	 *            offset of the object in this pack.
+	 * @return the object loader for the requested object; null if the object
+	 *         at this offset is known to be corrupt.
+	 * @throws IOException
+	 *             the pack file could not be read.
+	 */
+	ObjectLoader get(WindowCursor curs, long offset) throws IOException {
+		return hasObjectAt(offset) ? load(curs, offset) : null;
+	}
+
+	/**
+	 * Determine if an object at the offset is readable from this pack.
+	 *
+	 * @param offset
+	 *            offset of the object in this pack.
+	 * @return true if the object has not been found to be corrupt.
+	 */
+	boolean hasObjectAt(long offset) {
+		return 0 < offset && !isCorrupt(offset);
+	}
+
 	void resolve(Set<ObjectId> matches, AbbreviatedObjectId id, int matchLimit)
 			throws IOException {
 		idx().resolve(matches, id, matchLimit);
@@ -394,7 +475,167 @@ void copyPackAsIs(PackOutputStream out, WindowCursor curs)
 			throws IOException {
 		// Pin the first window, this ensures the length is accurate.
 		curs.pin(this, 0);
-		curs.copyPackAsIs(this, length, out);
+		curs.copyPackAsIs(this, 12, length - 20, out);
+	}
+
+	/**
+	 * Select the objects of a bitmap which can be copied from this pack as
+	 * they are.
+	 * <p>
+	 * An object stored as delta is only selected if its base is selected
+	 * too. Objects of the leading run of the bitmap are selected without
+	 * looking at them: bases of offset deltas precede the deltas, and packs
+	 * with a bitmap index do not store deltas by base object id.
+	 *
+	 * @param need
+	 *            objects to send, positioned as in this pack's bitmap index
+	 * @param curs
+	 *            cursor to read the object headers with
+	 * @return the selected objects, or null if there are none
+	 * @throws IOException
+	 *             the pack or its index cannot be read
+	 */
+	@Nullable
+	LocalPartialCachedPack selectPartialAsIs(EWAHCompressedBitmap need,
+			WindowCursor curs) throws IOException {
+		// Pin the first window, this ensures the length is accurate.
+		curs.pin(this, 0);
+		PackIndex idx = idx();
+		PackReverseIndex revIdx = getReverseIdx();
+		int cnt = (int) idx.getObjectCount();
+		BitSet selected = new BitSet(cnt);
+		LongList offsets = new LongList();
+		int run = 0;
+		final byte[] ib = curs.tempId;
+		for (IntIterator i = need.intIterator(); i.hasNext();) {
+			int position = i.next();
+			if (position >= cnt) {
+				break;
+			}
+			if (position == run) {
+				selected.set(position);
+				run++;
+				continue;
+			}
+
+			long pos = idx.findOffset(revIdx.findObjectByPosition(position));
+			readFully(pos, ib, 0, 20, curs);
+			int c = ib[0] & 0xff;
+			int p = 1;
+			final int typeCode = (c >> 4) & 7;
+			while ((c & 0x80) != 0)
+				c = ib[p++] & 0xff;
+			if (typeCode == Constants.OBJ_REF_DELTA) {
+				continue;
+			}
+			if (typeCode == Constants.OBJ_OFS_DELTA) {
+				c = ib[p++] & 0xff;
+				long ofs = c & 127;
+				while ((c & 128) != 0) {
+					ofs += 1;
+					c = ib[p++] & 0xff;
+					ofs <<= 7;
+					ofs += (c & 127);
+				}
+				int base = revIdx.findPosition(pos - ofs);
+				if (base < 0 || !selected.get(base)) {
+					continue;
+				}
+			}
+			selected.set(position);
+			offsets.add(pos);
+		}
+		if (run == 0 && offsets.size() == 0) {
+			return null;
+		}
+
+		long runEnd = run == cnt ? length - 20
+				: idx.findOffset(revIdx.findObjectByPosition(run));
+		long[] following = new long[offsets.size()];
+		for (int i = 0; i < following.length; i++) {
+			following[i] = offsets.get(i);
+		}
+		return new LocalPartialCachedPack(this,
+				selected.toEWAHCompressedBitmap(), runEnd, following);
+	}
+
+	void copyPartialAsIs(PackOutputStream out, LocalPartialCachedPack part,
+			WindowCursor curs) throws IOException {
+		// Pin the first window, this ensures the length is accurate.
+		curs.pin(this, 0);
+
+		// Offsets from which on the number of bytes left out of the output
+		// changes, and the number of bytes left out before these offsets.
+		LongList gapStarts = new LongList();
+		LongList gapSizes = new LongList();
+		long skipped = 0;
+		long copyStart = 12;
+		long copyEnd = part.runEnd;
+		final byte[] ib = curs.tempId;
+		for (long pos : part.offsets) {
+			if (pos != copyEnd) {
+				curs.copyPackAsIs(this, copyStart, copyEnd, out);
+				skipped += pos - copyEnd;
+				gapStarts.add(pos);
+				gapSizes.add(skipped);
+				copyStart = pos;
+			}
+			copyEnd = findEndOffset(pos);
+
+			readFully(pos, ib, 0, 20, curs);
+			int c = ib[0] & 0xff;
+			final int typeCode = (c >> 4) & 7;
+			if (typeCode != Constants.OBJ_OFS_DELTA) {
+				continue;
+			}
+			long inflatedLength = c & 15;
+			int shift = 4;
+			int p = 1;
+			while ((c & 0x80) != 0) {
+				c = ib[p++] & 0xff;
+				inflatedLength += ((long) (c & 0x7f)) << shift;
+				shift += 7;
+			}
+			c = ib[p++] & 0xff;
+			long ofs = c & 127;
+			while ((c & 128) != 0) {
+				ofs += 1;
+				c = ib[p++] & 0xff;
+				ofs <<= 7;
+				ofs += (c & 127);
+			}
+			long moved = skipped
+					- skippedBefore(gapStarts, gapSizes, pos - ofs);
+			if (moved == 0) {
+				continue;
+			}
+
+			// Objects between the delta and its base were left out, rewrite
+			// the header with the base's new distance.
+			curs.copyPackAsIs(this, copyStart, pos, out);
+			long headerStart = out.length();
+			out.writeOfsDeltaHeader(inflatedLength, ofs - moved);
+			skipped += p - (out.length() - headerStart);
+			gapStarts.add(pos + 1);
+			gapSizes.add(skipped);
+			copyStart = pos + p;
+		}
+		curs.copyPackAsIs(this, copyStart, copyEnd, out);
+	}
+
+	private static long skippedBefore(LongList gapStarts, LongList gapSizes,
+			long pos) {
+		int low = 0;
+		int high = gapStarts.size();
+		while (low < high) {
+			int mid = (low + high) >>> 1;
+			if (gapStarts.get(mid) <= pos) {
+				low = mid + 1;
+			} else {
+				high = mid;
+			}
+		}
+		return low == 0 ? 0 : gapSizes.get(low - 1);
 	}
 
 	final void copyAsIs(PackOutputStream out, LocalObjectToPack src,
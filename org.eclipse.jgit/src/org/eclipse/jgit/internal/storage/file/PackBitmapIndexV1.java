@@ -23,6 +23,7 @@
 import java.util.concurrent.Future;
 import java.util.concurrent.ThreadFactory;
 import java.util.concurrent.atomic.AtomicInteger;
+import java.util.function.IntFunction;
 
 import org.eclipse.jgit.annotations.Nullable;
 import org.eclipse.jgit.internal.JGitText;
@@ -94,6 +95,103 @@ public Thread newThread(Runnable runnable) {
 			reverseIndexFuture = executor.submit(reverseIndexSupplier::get);
 		}
 
+		BitmapFile file = readBitmapFile(fd);
+		this.packChecksum = file.checksum;
+		this.commits = file.commits;
+		this.trees = file.trees;
+		this.blobs = file.blobs;
+		this.tags = file.tags;
+
+		PackIndex index = packIndexSupplier.get();
+		this.packIndex = index;
+		file.storeBitmaps(bitmaps, (int) index.getObjectCount(),
+				nth -> index.getObjectId(nth));
+
+		PackReverseIndex computedReverseIndex;
+		if (loadParallelRevIndex && reverseIndexFuture != null) {
+			try {
+				computedReverseIndex = reverseIndexFuture.get();
+			} catch (InterruptedException | ExecutionException e) {
+				// Fallback to loading reverse index through a supplier.
+				computedReverseIndex = reverseIndexSupplier.get();
+			}
+		} else {
+			computedReverseIndex = reverseIndexSupplier.get();
+		}
+		this.reverseIndex = computedReverseIndex;
+	}
+
+	@Override
+	public int findPosition(AnyObjectId objectId) {
+		long offset = packIndex.findOffset(objectId);
+		if (offset == -1)
+			return -1;
+		return reverseIndex.findPosition(offset);
+	}
+
+	@Override
+	public ObjectId getObject(int position) throws IllegalArgumentException {
+		ObjectId objectId = reverseIndex.findObjectByPosition(position);
+		if (objectId == null)
+			throw new IllegalArgumentException();
+		return objectId;
+	}
+
+	@Override
+	public int getObjectCount() {
+		return (int) packIndex.getObjectCount();
+	}
+
+	@Override
+	public EWAHCompressedBitmap ofObjectType(
+			EWAHCompressedBitmap bitmap, int type) {
+		switch (type) {
+		case Constants.OBJ_BLOB:
+			return blobs.and(bitmap);
+		case Constants.OBJ_TREE:
+			return trees.and(bitmap);
+		case Constants.OBJ_COMMIT:
+			return commits.and(bitmap);
+		case Constants.OBJ_TAG:
+			return tags.and(bitmap);
+		}
+		throw new IllegalArgumentException();
+	}
+
+	@Override
+	public int getBitmapCount() {
+		return bitmaps.size();
+	}
+
+	@Override
+	public boolean equals(Object o) {
+		// TODO(cranger): compare the pack checksum?
+		if (o instanceof PackBitmapIndexV1)
+			return getPackIndex() == ((PackBitmapIndexV1) o).getPackIndex();
+		return false;
+	}
+
+	@Override
+	public int hashCode() {
+		return getPackIndex().hashCode();
+	}
+
+	PackIndex getPackIndex() {
+		return packIndex;
+	}
+
+	/**
+	 * Read the header, type bitmaps and bitmap entries of a v1 bitmap file.
+	 *
+	 * @param fd
+	 *            stream to read the bitmap file from.
+	 * @return the contents of the file; the entries still need to be mapped
+	 *         to objects by {@link BitmapFile#storeBitmaps}.
+	 * @throws IOException
+	 *             the stream cannot be read or is not a v1 bitmap file.
+	 */
+	static BitmapFile readBitmapFile(InputStream fd) throws IOException {
+		BitmapFile file = new BitmapFile();
 		final byte[] scratch = new byte[32];
 		IO.readFully(fd, scratch, 0, scratch.length);
 
@@ -128,18 +226,16 @@ public Thread newThread(Runnable runnable) {
 			throw new IOException(JGitText.get().indexFileIsTooLargeForJgit);
 
 		// Checksum applied on the bottom of the corresponding pack file.
-		this.packChecksum = new byte[20];
-		System.arraycopy(scratch, 12, packChecksum, 0, packChecksum.length);
+		file.checksum = new byte[20];
+		System.arraycopy(scratch, 12, file.checksum, 0, file.checksum.length);
 
 		// Read the bitmaps for the Git types
 		SimpleDataInput dataInput = new SimpleDataInput(fd);
-		this.commits = readBitmap(dataInput);
-		this.trees = readBitmap(dataInput);
-		this.blobs = readBitmap(dataInput);
-		this.tags = readBitmap(dataInput);
+		file.commits = readBitmap(dataInput);
+		file.trees = readBitmap(dataInput);
+		file.blobs = readBitmap(dataInput);
+		file.tags = readBitmap(dataInput);
 
-		// Read full bitmap from storage first.
-		List<IdxPositionBitmap> idxPositionBitmapList = new ArrayList<>();
 		// The xor offset is a single byte offset back in the list of entries.
 		IdxPositionBitmap[] recentBitmaps = new IdxPositionBitmap[MAX_XOR_OFFSET];
 		for (int i = 0; i < (int) numEntries; i++) {
@@ -181,96 +277,10 @@ public Thread newThread(Runnable runnable) {
 			}
 			IdxPositionBitmap idxPositionBitmap = new IdxPositionBitmap(
 					nthObjectId, xorIdxPositionBitmap, bitmap, flags);
-			idxPositionBitmapList.add(idxPositionBitmap);
+			file.entries.add(idxPositionBitmap);
 			recentBitmaps[i % recentBitmaps.length] = idxPositionBitmap;
 		}
-
-		this.packIndex = packIndexSupplier.get();
-		for (int i = 0; i < idxPositionBitmapList.size(); ++i) {
-			IdxPositionBitmap idxPositionBitmap = idxPositionBitmapList.get(i);
-			ObjectId objectId = packIndex
-					.getObjectId(idxPositionBitmap.nthObjectId);
-			StoredBitmap sb = new StoredBitmap(objectId,
-					idxPositionBitmap.bitmap,
-					idxPositionBitmap.getXorStoredBitmap(),
-					idxPositionBitmap.flags);
-			// Save the StoredBitmap for a possible future XorStoredBitmap
-			// reference.
-			idxPositionBitmap.sb = sb;
-			bitmaps.add(sb);
-		}
-
-		PackReverseIndex computedReverseIndex;
-		if (loadParallelRevIndex && reverseIndexFuture != null) {
-			try {
-				computedReverseIndex = reverseIndexFuture.get();
-			} catch (InterruptedException | ExecutionException e) {
-				// Fallback to loading reverse index through a supplier.
-				computedReverseIndex = reverseIndexSupplier.get();
-			}
-		} else {
-			computedReverseIndex = reverseIndexSupplier.get();
-		}
-		this.reverseIndex = computedReverseIndex;
-	}
-
-	@Override
-	public int findPosition(AnyObjectId objectId) {
-		long offset = packIndex.findOffset(objectId);
-		if (offset == -1)
-			return -1;
-		return reverseIndex.findPosition(offset);
-	}
-
-	@Override
-	public ObjectId getObject(int position) throws IllegalArgumentException {
-		ObjectId objectId = reverseIndex.findObjectByPosition(position);
-		if (objectId == null)
-			throw new IllegalArgumentException();
-		return objectId;
-	}
-
-	@Override
-	public int getObjectCount() {
-		return (int) packIndex.getObjectCount();
-	}
-
-	@Override
-	public EWAHCompressedBitmap ofObjectType(
-			EWAHCompressedBitmap bitmap, int type) {
-		switch (type) {
-		case Constants.OBJ_BLOB:
-			return blobs.and(bitmap);
-		case Constants.OBJ_TREE:
-			return trees.and(bitmap);
-		case Constants.OBJ_COMMIT:
-			return commits.and(bitmap);
-		case Constants.OBJ_TAG:
-			return tags.and(bitmap);
-		}
-		throw new IllegalArgumentException();
-	}
-
-	@Override
-	public int getBitmapCount() {
-		return bitmaps.size();
-	}
-
-	@Override
-	public boolean equals(Object o) {
-		// TODO(cranger): compare the pack checksum?
-		if (o instanceof PackBitmapIndexV1)
-			return getPackIndex() == ((PackBitmapIndexV1) o).getPackIndex();
-		return false;
-	}
-
-	@Override
-	public int hashCode() {
-		return getPackIndex().hashCode();
-	}
-
-	PackIndex getPackIndex() {
-		return packIndex;
+		return file;
 	}
 
 	private static EWAHCompressedBitmap readBitmap(DataInput dataInput)
@@ -280,6 +290,60 @@ private static EWAHCompressedBitmap readBitmap(DataInput dataInput)
 		return bitmap;
 	}
 
+	/**
+	 * Contents of a v1 bitmap file, with bitmap entries still identified by
+	 * the position of their object in the index the file belongs to.
+	 */
+	static final class BitmapFile {
+		/** Checksum of the pack (or multi-pack-index) the file belongs to. */
+		byte[] checksum;
+
+		EWAHCompressedBitmap commits;
+
+		EWAHCompressedBitmap trees;
+
+		EWAHCompressedBitmap blobs;
+
+		EWAHCompressedBitmap tags;
+
+		final List<IdxPositionBitmap> entries = new ArrayList<>();
+
+		/**
+		 * Create the stored bitmaps of all entries.
+		 *
+		 * @param bitmaps
+		 *            map to add the bitmaps to.
+		 * @param objectCount
+		 *            number of objects in the index the file belongs to.
+		 * @param nthObjectId
+		 *            maps the position of an object in the index, sorted by
+		 *            name, to its id.
+		 * @throws IOException
+		 *             an entry refers to a position beyond the index.
+		 */
+		void storeBitmaps(ObjectIdOwnerMap<StoredBitmap> bitmaps,
+				int objectCount, IntFunction<ObjectId> nthObjectId)
+				throws IOException {
+			for (IdxPositionBitmap idxPositionBitmap : entries) {
+				if (idxPositionBitmap.nthObjectId >= objectCount) {
+					throw new IOException(MessageFormat.format(
+							JGitText.get().invalidId, String
+									.valueOf(idxPositionBitmap.nthObjectId)));
+				}
+				ObjectId objectId = nthObjectId
+						.apply(idxPositionBitmap.nthObjectId);
+				StoredBitmap sb = new StoredBitmap(objectId,
+						idxPositionBitmap.bitmap,
+						idxPositionBitmap.getXorStoredBitmap(),
+						idxPositionBitmap.flags);
+				// Save the StoredBitmap for a possible future XorStoredBitmap
+				// reference.
+				idxPositionBitmap.sb = sb;
+				bitmaps.add(sb);
+			}
+		}
+	}
+
 	/**
 	 * Temporary holder of object position in pack index and other metadata for
 	 * {@code StoredBitmap}.
@@ -24,6 +24,7 @@
 import java.util.Collections;
 import java.util.EnumMap;
 import java.util.HashMap;
+import java.util.IdentityHashMap;
 import java.util.List;
 import java.util.Map;
 import java.util.Set;
@@ -35,6 +36,9 @@
 import org.eclipse.jgit.errors.PackMismatchException;
 import org.eclipse.jgit.errors.SearchForReuseTimeout;
 import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.internal.storage.midx.MultiPackIndex;
+import org.eclipse.jgit.internal.storage.midx.MultiPackIndexFormatException;
+import org.eclipse.jgit.internal.storage.midx.MultiPackIndexLoader;
 import org.eclipse.jgit.internal.storage.pack.ObjectToPack;
 import org.eclipse.jgit.internal.storage.pack.PackExt;
 import org.eclipse.jgit.internal.storage.pack.PackWriter;
@@ -42,6 +46,7 @@
 import org.eclipse.jgit.lib.AnyObjectId;
 import org.eclipse.jgit.lib.Config;
 import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.Constants;
 import org.eclipse.jgit.lib.ObjectId;
 import org.eclipse.jgit.lib.ObjectLoader;
 import org.eclipse.jgit.util.FileUtils;
@@ -73,6 +78,8 @@ class PackDirectory {
 
 	private final boolean trustFolderStat;
 
+	private final boolean useMultiPackIndex;
+
 	/**
 	 * Initialize a reference to an on-disk 'pack' directory.
 	 *
@@ -93,6 +100,12 @@ class PackDirectory {
 		// can be in this folder if these attributes have not changed.
 		trustFolderStat = config.getBoolean(ConfigConstants.CONFIG_CORE_SECTION,
 				ConfigConstants.CONFIG_KEY_TRUSTFOLDERSTAT, true);
+
+		// Whether to consult objects/pack/multi-pack-index, if present, to
+		// locate objects without probing the index of every pack.
+		useMultiPackIndex = config.getBoolean(
+				ConfigConstants.CONFIG_CORE_SECTION,
+				ConfigConstants.CONFIG_KEY_MULTI_PACK_INDEX, true);
 	}
 
 	/**
@@ -126,6 +139,22 @@ Collection<Pack> getPacks() {
 		return Collections.unmodifiableCollection(Arrays.asList(packs));
 	}
 
+	/**
+	 * Get the reachability bitmaps of the multi-pack-index.
+	 *
+	 * @return the bitmaps, or null if there is no multi-pack-index or it has
+	 *         no usable bitmaps.
+	 */
+	@Nullable
+	PackBitmapIndex getMultiPackBitmapIndex() {
+		PackList list = packList.get();
+		if (list == NO_PACKS) {
+			list = scanPacks(list);
+		}
+		MidxPacks midx = list.midx;
+		return midx != null ? midx.bitmaps.get(midx.index) : null;
+	}
+
 	@Override
 	public String toString() {
 		return "PackDirectory[" + getDirectory() + "]"; //$NON-NLS-1$ //$NON-NLS-2$
@@ -157,7 +186,18 @@ Pack getPack(AnyObjectId objectId) {
 		PackList pList;
 		do {
 			pList = packList.get();
-			for (Pack p : pList.packs) {
+			Pack[] search = pList.unindexed;
+			MidxPacks midx = pList.midx;
+			int pos = midx != null ? midx.index.findPosition(objectId) : -1;
+			if (pos >= 0) {
+				Pack p = midx.getPack(pos);
+				if (p.hasObjectAt(midx.index.getOffset(pos))) {
+					return p;
+				}
+				// The indexed copy is corrupt, look for another one.
+				search = pList.packs;
+			}
+			for (Pack p : search) {
 				try {
 					if (p.hasObject(objectId)) {
 						return p;
@@ -198,7 +238,13 @@ boolean resolve(Set<ObjectId> matches, AbbreviatedObjectId id,
 		PackList pList;
 		do {
 			pList = packList.get();
-			for (Pack p : pList.packs) {
+			if (pList.midx != null) {
+				pList.midx.index.resolve(matches, id, matchLimit);
+				if (matches.size() > matchLimit) {
+					return false;
+				}
+			}
+			for (Pack p : pList.unindexed) {
 				try {
 					p.resolve(matches, id, matchLimit);
 					p.resetTransientErrorCount();
@@ -220,7 +266,32 @@ ObjectLoader open(WindowCursor curs, AnyObjectId objectId)
 			int retries = 0;
 			SEARCH: for (;;) {
 				pList = packList.get();
-				for (Pack p : pList.packs) {
+				Pack[] search = pList.unindexed;
+				MidxPacks midx = pList.midx;
+				int pos = midx != null ? midx.index.findPosition(objectId)
+						: -1;
+				if (pos >= 0) {
+					Pack p = midx.getPack(pos);
+					try {
+						ObjectLoader ldr = p.get(curs,
+								midx.index.getOffset(pos));
+						p.resetTransientErrorCount();
+						if (ldr != null) {
+							return ldr;
+						}
+					} catch (PackMismatchException e) {
+						// Pack was modified; refresh the entire pack list.
+						if (searchPacksAgain(pList)) {
+							retries = checkRescanPackThreshold(retries, e);
+							continue SEARCH;
+						}
+					} catch (IOException e) {
+						handlePackError(e, p);
+					}
+					// The indexed copy is unusable, look for another one.
+					search = pList.packs;
+				}
+				for (Pack p : search) {
 					try {
 						ObjectLoader ldr = p.get(curs, objectId);
 						p.resetTransientErrorCount();
@@ -249,7 +320,33 @@ long getSize(WindowCursor curs, AnyObjectId id)
 			int retries = 0;
 			SEARCH: for (;;) {
 				pList = packList.get();
-				for (Pack p : pList.packs) {
+				Pack[] search = pList.unindexed;
+				MidxPacks midx = pList.midx;
+				int pos = midx != null ? midx.index.findPosition(id) : -1;
+				if (pos >= 0) {
+					Pack p = midx.getPack(pos);
+					long offset = midx.index.getOffset(pos);
+					try {
+						if (p.hasObjectAt(offset)) {
+							long len = p.getObjectSize(curs, offset);
+							p.resetTransientErrorCount();
+							if (0 <= len) {
+								return len;
+							}
+						}
+					} catch (PackMismatchException e) {
+						// Pack was modified; refresh the entire pack list.
+						if (searchPacksAgain(pList)) {
+							retries = checkRescanPackThreshold(retries, e);
+							continue SEARCH;
+						}
+					} catch (IOException e) {
+						handlePackError(e, p);
+					}
+					// The indexed copy is unusable, look for another one.
+					search = pList.packs;
+				}
+				for (Pack p : search) {
 					try {
 						long len = p.getObjectSize(curs, id);
 						p.resetTransientErrorCount();
@@ -383,7 +480,7 @@ void insert(Pack pack) {
 			final Pack[] newList = new Pack[1 + oldList.length];
 			newList[0] = pack;
 			System.arraycopy(oldList, 0, newList, 1, oldList.length);
-			n = new PackList(o.snapshot, newList);
+			n = new PackList(o.snapshot, newList, o.midx);
 		} while (!packList.compareAndSet(o, n));
 	}
 
@@ -401,7 +498,13 @@ private void remove(Pack deadPack) {
 			final Pack[] newList = new Pack[oldList.length - 1];
 			System.arraycopy(oldList, 0, newList, 0, j);
 			System.arraycopy(oldList, j + 1, newList, j, newList.length - j);
-			n = new PackList(o.snapshot, newList);
+			// A multi-pack-index referring to the dead pack is unusable
+			// until the next scan of the directory.
+			MidxPacks midx = o.midx;
+			if (midx != null && midx.covers(deadPack)) {
+				midx = null;
+			}
+			n = new PackList(o.snapshot, newList, midx);
 		} while (!packList.compareAndSet(o, n));
 		deadPack.close();
 	}
@@ -484,7 +587,74 @@ private PackList scanPacksImpl(PackList old) {
 
 		final Pack[] r = list.toArray(new Pack[0]);
 		Arrays.sort(r, Pack.SORT);
-		return new PackList(snapshot, r);
+		return new PackList(snapshot, r, scanMultiPackIndex(old.midx, r));
+	}
+
+	/**
+	 * Load the multi-pack-index of this directory, if any, and map it onto
+	 * the packs just scanned.
+	 *
+	 * @param old
+	 *            the multi-pack-index of the previous scan, reused if the file
+	 *            has not been modified.
+	 * @param packs
+	 *            the packs found in the directory.
+	 * @return the multi-pack-index; null if there is none, it cannot be read
+	 *         or it refers to packs which no longer exist.
+	 */
+	@Nullable
+	private MidxPacks scanMultiPackIndex(@Nullable MidxPacks old,
+			Pack[] packs) {
+		if (!useMultiPackIndex) {
+			return null;
+		}
+		File midxFile = new File(directory, Constants.MULTI_PACK_INDEX);
+		MultiPackIndex index;
+		FileSnapshot snapshot;
+		MidxBitmaps bitmaps;
+		if (old != null && !old.snapshot.isModified(midxFile)) {
+			index = old.index;
+			snapshot = old.snapshot;
+			bitmaps = old.bitmaps;
+		} else {
+			if (!midxFile.isFile()) {
+				return null;
+			}
+			snapshot = FileSnapshot.save(midxFile);
+			try {
+				index = MultiPackIndexLoader.open(midxFile);
+			} catch (FileNotFoundException noFile) {
+				return null;
+			} catch (MultiPackIndexFormatException e) {
+				LOG.warn(MessageFormat.format(
+						JGitText.get().corruptMultiPackIndex, midxFile), e);
+				return null;
+			} catch (IOException e) {
+				LOG.error(MessageFormat.format(
+						JGitText.get().exceptionWhileLoadingMultiPackIndex,
+						midxFile), e);
+				return null;
+			}
+			bitmaps = new MidxBitmaps(new File(directory,
+					MultiPackBitmapIndex.getFileName(index)));
+		}
+
+		Map<String, Pack> byIndexName = new HashMap<>();
+		for (Pack p : packs) {
+			byIndexName.put(p.getPackFile().create(INDEX).getName(), p);
+		}
+		String[] names = index.getPackNames();
+		Pack[] byPackId = new Pack[names.length];
+		for (int i = 0; i < names.length; i++) {
+			Pack p = byIndexName.get(names[i]);
+			if (p == null) {
+				// The multi-pack-index is stale, e.g. a repack removed one
+				// of its packs. Fall back to searching the packs one by one.
+				return null;
+			}
+			byPackId[i] = p;
+		}
+		return new MidxPacks(snapshot, index, byPackId, bitmaps);
 	}
 
 	private static Map<String, Pack> reuseMap(PackList old) {
@@ -558,9 +728,98 @@ static final class PackList {
 		/** All known packs, sorted by {@link Pack#SORT}. */
 		final Pack[] packs;
 
+		/** Multi-pack-index covering some of {@link #packs}, if any. */
+		@Nullable
+		final MidxPacks midx;
+
+		/** Packs not covered by {@link #midx}, sorted by {@link Pack#SORT}. */
+		final Pack[] unindexed;
+
 		PackList(FileSnapshot monitor, Pack[] packs) {
+			this(monitor, packs, null);
+		}
+
+		PackList(FileSnapshot monitor, Pack[] packs,
+				@Nullable MidxPacks midx) {
 			this.snapshot = monitor;
 			this.packs = packs;
+			this.midx = midx;
+			if (midx == null) {
+				this.unindexed = packs;
+			} else {
+				this.unindexed = Arrays.stream(packs)
+						.filter(p -> !midx.covers(p)).toArray(Pack[]::new);
+			}
+		}
+	}
+
+	static final class MidxPacks {
+		/** State of the multi-pack-index file when it was read. */
+		final FileSnapshot snapshot;
+
+		final MultiPackIndex index;
+
+		/** Packs by their pack-int-id in {@link #index}. */
+		private final Pack[] byPackId;
+
+		private final Set<Pack> covered;
+
+		/** Bitmaps of {@link #index}, shared by scans reusing the index. */
+		final MidxBitmaps bitmaps;
+
+		MidxPacks(FileSnapshot snapshot, MultiPackIndex index,
+				Pack[] byPackId, MidxBitmaps bitmaps) {
+			this.snapshot = snapshot;
+			this.index = index;
+			this.byPackId = byPackId;
+			this.bitmaps = bitmaps;
+			this.covered = Collections.newSetFromMap(new IdentityHashMap<>());
+			this.covered.addAll(Arrays.asList(byPackId));
+		}
+
+		/**
+		 * Get the pack holding the object at a multi-pack-index position.
+		 *
+		 * @param position
+		 *            position of the object in {@link #index}.
+		 * @return the pack holding the object
+		 */
+		Pack getPack(int position) {
+			return byPackId[index.getPackId(position)];
+		}
+
+		boolean covers(Pack p) {
+			return covered.contains(p);
+		}
+	}
+
+	/** Lazily loaded bitmap file of a multi-pack-index. */
+	static final class MidxBitmaps {
+		private final File file;
+
+		private boolean loaded;
+
+		private PackBitmapIndex bitmaps;
+
+		MidxBitmaps(File file) {
+			this.file = file;
+		}
+
+		@Nullable
+		synchronized PackBitmapIndex get(MultiPackIndex index) {
+			if (!loaded) {
+				loaded = true;
+				try {
+					bitmaps = MultiPackBitmapIndex.open(file, index);
+				} catch (FileNotFoundException e) {
+					// No bitmaps were written for this multi-pack-index.
+				} catch (IOException e) {
+					LOG.warn(MessageFormat.format(
+							JGitText.get().unreadableMultiPackBitmap, file),
+							e);
+				}
+			}
+			return bitmaps;
 		}
 	}
 }
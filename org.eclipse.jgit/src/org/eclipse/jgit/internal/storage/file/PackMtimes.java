@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.file;
+
+import static org.eclipse.jgit.lib.Constants.OBJECT_ID_LENGTH;
+
+import java.io.BufferedInputStream;
+import java.io.DataInput;
+import java.io.File;
+import java.io.FileNotFoundException;
+import java.io.IOException;
+import java.io.InputStream;
+import java.security.DigestInputStream;
+import java.text.MessageFormat;
+import java.util.Arrays;
+
+import org.eclipse.jgit.errors.CorruptObjectException;
+import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.lib.Constants;
+import org.eclipse.jgit.util.Hex;
+import org.eclipse.jgit.util.IO;
+import org.eclipse.jgit.util.io.SilentFileInputStream;
+
+/**
+ * Modification times of the objects of a cruft pack, parsed from a version 1
+ * {@code .mtimes} file.
+ * <p>
+ * The file format is specified at
+ * https://git-scm.com/docs/gitformat-pack#_pack_mtimes_files_have_the_format.
+ */
+final class PackMtimes {
+	/** Magic bytes that uniquely identify git mtimes files. */
+	static final byte[] MAGIC = { 'M', 'T', 'M', 'E' };
+
+	/** The first mtimes file version. */
+	static final int VERSION_1 = 1;
+
+	static final int OID_VERSION_SHA1 = 1;
+
+	private final int[] mtimes;
+
+	private final byte[] packChecksum;
+
+	/**
+	 * Open an existing mtimes file.
+	 *
+	 * @param mtimesFile
+	 *            the file to read.
+	 * @param objectCount
+	 *            number of objects in the corresponding pack.
+	 * @return the parsed modification times.
+	 * @throws FileNotFoundException
+	 *             the file does not exist.
+	 * @throws IOException
+	 *             the file cannot be read or is corrupt.
+	 */
+	static PackMtimes open(File mtimesFile, long objectCount)
+			throws IOException {
+		try (SilentFileInputStream fd = new SilentFileInputStream(
+				mtimesFile)) {
+			try {
+				return read(new BufferedInputStream(fd), objectCount);
+			} catch (IOException e) {
+				throw new IOException(
+						MessageFormat.format(JGitText.get().unreadablePackMtimes,
+								mtimesFile.getAbsolutePath()),
+						e);
+			}
+		}
+	}
+
+	/**
+	 * Read an mtimes file from a stream.
+	 *
+	 * @param src
+	 *            the stream to read. The caller is responsible for closing
+	 *            it.
+	 * @param objectCount
+	 *            number of objects in the corresponding pack.
+	 * @return the parsed modification times.
+	 * @throws IOException
+	 *             the stream cannot be read or the data is corrupt.
+	 */
+	static PackMtimes read(InputStream src, long objectCount)
+			throws IOException {
+		int count;
+		try {
+			count = Math.toIntExact(objectCount);
+		} catch (ArithmeticException e) {
+			throw new IllegalArgumentException(
+					JGitText.get().hugeIndexesAreNotSupportedByJgitYet, e);
+		}
+		DigestInputStream in = new DigestInputStream(src,
+				Constants.newMessageDigest());
+		byte[] magic = new byte[MAGIC.length];
+		IO.readFully(in, magic);
+		if (!Arrays.equals(magic, MAGIC)) {
+			throw new IOException(
+					MessageFormat.format(JGitText.get().expectedGot,
+							Arrays.toString(MAGIC), Arrays.toString(magic)));
+		}
+
+		DataInput dataIn = new SimpleDataInput(in);
+		int version = dataIn.readInt();
+		if (version != VERSION_1) {
+			throw new IOException(MessageFormat.format(
+					JGitText.get().unsupportedPackMtimesVersion,
+					String.valueOf(version)));
+		}
+		int oidVersion = dataIn.readInt();
+		if (oidVersion != OID_VERSION_SHA1) {
+			throw new IOException(MessageFormat.format(
+					JGitText.get().unsupportedObjectIdVersion,
+					String.valueOf(oidVersion)));
+		}
+
+		int[] mtimes = new int[count];
+		for (int i = 0; i < count; i++) {
+			mtimes[i] = dataIn.readInt();
+		}
+
+		byte[] packChecksum = new byte[OBJECT_ID_LENGTH];
+		IO.readFully(in, packChecksum);
+
+		// Take digest before reading the self checksum changes it.
+		byte[] observedSelfChecksum = in.getMessageDigest().digest();
+		byte[] readSelfChecksum = new byte[OBJECT_ID_LENGTH];
+		IO.readFully(in, readSelfChecksum);
+		if (!Arrays.equals(readSelfChecksum, observedSelfChecksum)) {
+			throw new CorruptObjectException(MessageFormat.format(
+					JGitText.get().corruptPackMtimesChecksumIncorrect,
+					Hex.toHexString(readSelfChecksum),
+					Hex.toHexString(observedSelfChecksum)));
+		}
+		return new PackMtimes(mtimes, packChecksum);
+	}
+
+	private PackMtimes(int[] mtimes, byte[] packChecksum) {
+		this.mtimes = mtimes;
+		this.packChecksum = packChecksum;
+	}
+
+	/**
+	 * Get the modification time of an object.
+	 *
+	 * @param position
+	 *            position of the object in the pack index.
+	 * @return modification time in seconds since the epoch.
+	 */
+	long getMtime(int position) {
+		return mtimes[position] & 0xffffffffL;
+	}
+
+	/**
+	 * Get the checksum of the pack these modification times belong to.
+	 *
+	 * @return checksum of the corresponding pack file.
+	 */
+	byte[] getPackChecksum() {
+		return packChecksum;
+	}
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.file;
+
+import static org.eclipse.jgit.internal.storage.file.PackMtimes.MAGIC;
+import static org.eclipse.jgit.internal.storage.file.PackMtimes.OID_VERSION_SHA1;
+import static org.eclipse.jgit.internal.storage.file.PackMtimes.VERSION_1;
+
+import java.io.BufferedOutputStream;
+import java.io.DataOutput;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.security.DigestOutputStream;
+import java.util.List;
+import java.util.function.ToLongFunction;
+
+import org.eclipse.jgit.lib.AnyObjectId;
+import org.eclipse.jgit.lib.Constants;
+import org.eclipse.jgit.transport.PackedObjectInfo;
+
+/**
+ * Writes the version 1 {@code .mtimes} file of a cruft pack, recording the
+ * modification time of each unreachable object stored in the pack.
+ * <p>
+ * The file format is specified at
+ * https://git-scm.com/docs/gitformat-pack#_pack_mtimes_files_have_the_format.
+ */
+public final class PackMtimesWriter {
+	private final DigestOutputStream out;
+
+	private final DataOutput dataOutput;
+
+	/**
+	 * Create a writer.
+	 *
+	 * @param dst
+	 *            the OutputStream that contents will be written to
+	 */
+	public PackMtimesWriter(OutputStream dst) {
+		out = new DigestOutputStream(
+				dst instanceof BufferedOutputStream ? dst
+						: new BufferedOutputStream(dst),
+				Constants.newMessageDigest());
+		dataOutput = new SimpleDataOutput(out);
+	}
+
+	/**
+	 * Write the modification times of the given objects.
+	 *
+	 * @param objectsByIndexPos
+	 *            the objects of the pack, sorted by forward index file
+	 *            position (currently SHA1 ordering)
+	 * @param mtimes
+	 *            modification time of an object, in seconds since the epoch
+	 * @param packChecksum
+	 *            the checksum of the corresponding pack file
+	 * @throws IOException
+	 *             if writing the output fails
+	 */
+	public void write(List<? extends PackedObjectInfo> objectsByIndexPos,
+			ToLongFunction<AnyObjectId> mtimes, byte[] packChecksum)
+			throws IOException {
+		out.write(MAGIC);
+		dataOutput.writeInt(VERSION_1);
+		dataOutput.writeInt(OID_VERSION_SHA1);
+		for (PackedObjectInfo oe : objectsByIndexPos) {
+			dataOutput.writeInt((int) mtimes.applyAsLong(oe));
+		}
+		out.write(packChecksum);
+		byte[] selfChecksum = out.getMessageDigest().digest();
+		out.write(selfChecksum);
+		out.flush();
+	}
+}
@@ -173,7 +173,8 @@ public void execute(RevWalk walk, ProgressMonitor monitor,
 
 			packedRefsLock = refdb.lockPackedRefsOrThrow();
 			PackedRefList oldPackedList = refdb.refreshPackedRefs();
-			RefList<Ref> newRefs = applyUpdates(walk, oldPackedList, pending);
+			RefList<Ref> newRefs = applyUpdates(walk,
+					oldPackedList.getRefs(RefDatabase.ALL), pending);
 			if (newRefs == null) {
 				return;
 			}
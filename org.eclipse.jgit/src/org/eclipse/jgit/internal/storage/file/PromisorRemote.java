@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.file;
+
+import java.io.IOException;
+import java.net.URISyntaxException;
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Set;
+
+import org.eclipse.jgit.annotations.Nullable;
+import org.eclipse.jgit.lib.AnyObjectId;
+import org.eclipse.jgit.lib.ConfigConstants;
+import org.eclipse.jgit.lib.NullProgressMonitor;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.transport.FilterSpec;
+import org.eclipse.jgit.transport.NegotiationAlgorithm;
+import org.eclipse.jgit.transport.RefSpec;
+import org.eclipse.jgit.transport.TagOpt;
+import org.eclipse.jgit.transport.Transport;
+import org.eclipse.jgit.util.LazyFetch;
+
+/**
+ * The promisor remote of a partial clone.
+ * <p>
+ * A partial clone, created by fetching with a filter, lacks objects reachable
+ * from its references. The remote named by {@code extensions.partialClone}
+ * promises to provide them: objects missing when they are read are fetched
+ * from it by their ids, in batches where the reader knows several objects in
+ * advance. Protocol v2 servers accept such requests; protocol v0 servers must
+ * allow unadvertised objects to be requested. Threads which only look for
+ * missing objects turn this off with {@link LazyFetch}.
+ */
+public class PromisorRemote {
+	private final FileRepository repo;
+
+	PromisorRemote(FileRepository repo) {
+		this.repo = repo;
+	}
+
+	/**
+	 * Get the name of the promisor remote.
+	 *
+	 * @return the remote named by {@code extensions.partialClone}, or null if
+	 *         the repository is not a partial clone
+	 */
+	@Nullable
+	String getName() {
+		return repo.getConfig().getString(
+				ConfigConstants.CONFIG_EXTENSIONS_SECTION, null,
+				ConfigConstants.CONFIG_KEY_PARTIAL_CLONE);
+	}
+
+	/**
+	 * Fetch objects missing from the object database.
+	 * <p>
+	 * Objects which are present, for example because another thread fetched
+	 * them meanwhile, are not fetched again. Nothing is fetched while
+	 * fetching is disabled on the current thread, see
+	 * {@link LazyFetch#disable()}.
+	 *
+	 * @param db
+	 *            the object database
+	 * @param ids
+	 *            the objects to fetch
+	 * @return true if the objects may now be read from the database
+	 * @throws IOException
+	 *             if the objects could not be fetched
+	 */
+	synchronized boolean fetch(FileObjectDatabase db,
+			Collection<? extends AnyObjectId> ids) throws IOException {
+		String remote = getName();
+		if (remote == null || !LazyFetch.isEnabled()) {
+			return false;
+		}
+		Set<ObjectId> seen = new HashSet<>();
+		List<RefSpec> specs = new ArrayList<>();
+		for (AnyObjectId id : ids) {
+			if (seen.add(id.copy()) && !db.has(id)) {
+				specs.add(new RefSpec(id.name()));
+			}
+		}
+		if (specs.isEmpty()) {
+			return true;
+		}
+		// The fetch itself must not fetch the objects it checks for, and
+		// trees must not bring all the blobs they reference along.
+		boolean enabled = LazyFetch.disable();
+		try (Transport tn = Transport.open(repo, remote)) {
+			tn.setTagOpt(TagOpt.NO_TAGS);
+			tn.setNegotiationAlgorithm(NegotiationAlgorithm.NOOP);
+			tn.setFilterSpec(FilterSpec.fromFilterLine("blob:none")); //$NON-NLS-1$
+			tn.fetch(NullProgressMonitor.INSTANCE, specs);
+		} catch (URISyntaxException e) {
+			throw new IOException(e.getMessage(), e);
+		} finally {
+			LazyFetch.restore(enabled);
+		}
+		return true;
+	}
+}
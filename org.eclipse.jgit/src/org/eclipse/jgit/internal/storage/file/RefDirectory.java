@@ -114,6 +114,13 @@ public class RefDirectory extends RefDatabase {
 	/** If in the header, denotes the file has peeled data. */
 	public static final String PACKED_REFS_PEELED = " peeled"; //$NON-NLS-1$
 
+	/**
+	 * If in the header, denotes the file's references are sorted by name.
+	 *
+	 * @since 6.9
+	 */
+	public static final String PACKED_REFS_SORTED = " sorted"; //$NON-NLS-1$
+
 	@SuppressWarnings("boxing")
 	private static final List<Integer> RETRY_SLEEP_MS =
 			Collections.unmodifiableList(Arrays.asList(0, 100, 200, 400, 800, 1600));
@@ -181,6 +188,9 @@ public class RefDirectory extends RefDatabase {
 
 	private final TrustPackedRefsStat trustPackedRefsStat;
 
+	/** Whether a sorted packed-refs file is mapped instead of parsed. */
+	private final boolean packedRefsMmap;
+
 	RefDirectory(RefDirectory refDb) {
 		parent = refDb.parent;
 		gitDir = refDb.gitDir;
@@ -192,6 +202,7 @@ public class RefDirectory extends RefDatabase {
 		packedRefs.set(refDb.packedRefs.get());
 		trustFolderStat = refDb.trustFolderStat;
 		trustPackedRefsStat = refDb.trustPackedRefsStat;
+		packedRefsMmap = refDb.packedRefsMmap;
 		inProcessPackedRefsLock = refDb.inProcessPackedRefsLock;
 	}
 
@@ -213,6 +224,9 @@ public class RefDirectory extends RefDatabase {
 				.getEnum(ConfigConstants.CONFIG_CORE_SECTION, null,
 						ConfigConstants.CONFIG_KEY_TRUST_PACKED_REFS_STAT,
 						TrustPackedRefsStat.UNSET);
+		packedRefsMmap = db.getConfig().getBoolean(
+				ConfigConstants.CONFIG_CORE_SECTION,
+				ConfigConstants.CONFIG_KEY_PACKED_REFS_MMAP, false);
 		inProcessPackedRefsLock = new ReentrantLock(true);
 	}
 
@@ -290,7 +304,8 @@ public boolean isNameConflicting(String name) throws IOException {
 	}
 
 	@Nullable
-	private Ref readAndResolve(String name, RefList<Ref> packed) throws IOException {
+	private Ref readAndResolve(String name, PackedRefList packed)
+			throws IOException {
 		try {
 			Ref ref = readRef(name, packed);
 			if (ref != null) {
@@ -323,7 +338,7 @@ public Ref exactRef(String name) throws IOException {
 	@NonNull
 	public Map<String, Ref> exactRef(String... refs) throws IOException {
 		try {
-			RefList<Ref> packed = getPackedRefs();
+			PackedRefList packed = getPackedRefs();
 			Map<String, Ref> result = new HashMap<>(refs.length);
 			for (String name : refs) {
 				Ref ref = readAndResolve(name, packed);
@@ -341,7 +356,7 @@ public Map<String, Ref> exactRef(String... refs) throws IOException {
 	@Nullable
 	public Ref firstExactRef(String... refs) throws IOException {
 		try {
-			RefList<Ref> packed = getPackedRefs();
+			PackedRefList packed = getPackedRefs();
 			for (String name : refs) {
 				Ref ref = readAndResolve(name, packed);
 				if (ref != null) {
@@ -359,7 +374,7 @@ public Map<String, Ref> getRefs(String prefix) throws IOException {
 		final RefList<LooseRef> oldLoose = looseRefs.get();
 		LooseScanner scan = new LooseScanner(oldLoose);
 		scan.scan(prefix);
-		final RefList<Ref> packed = getPackedRefs();
+		final PackedRefList packed = getPackedRefs();
 
 		RefList<LooseRef> loose;
 		if (scan.newLoose != null) {
@@ -390,7 +405,8 @@ public Map<String, Ref> getRefs(String prefix) throws IOException {
 		}
 		symbolic.sort();
 
-		return new RefMap(prefix, packed, upcast(loose), symbolic.toRefList());
+		return new RefMap(prefix, packed.getRefs(prefix), upcast(loose),
+				symbolic.toRefList());
 	}
 
 	@Override
@@ -590,7 +606,7 @@ void storedSymbolicRef(RefDirectoryUpdate u, FileSnapshot snapshot,
 	public RefDirectoryUpdate newUpdate(String name, boolean detach)
 			throws IOException {
 		boolean detachingSymbolicRef = false;
-		final RefList<Ref> packed = getPackedRefs();
+		final PackedRefList packed = getPackedRefs();
 		Ref ref = readRef(name, packed);
 		if (ref != null)
 			ref = resolve(ref, 0, null, null, packed);
@@ -673,15 +689,16 @@ void delete(RefDirectoryUpdate update) throws IOException {
 		// wind up reading it twice, before and after the lock, to ensure
 		// we don't miss an edit made externally.
 		PackedRefList packed = getPackedRefs();
-		if (packed.contains(name)) {
+		if (packed.get(name) != null) {
 			inProcessPackedRefsLock.lock();
 			try {
 				LockFile lck = lockPackedRefsOrThrow();
 				try {
 					packed = refreshPackedRefs();
-					int idx = packed.find(name);
+					RefList<Ref> all = packed.getRefs(ALL);
+					int idx = all.find(name);
 					if (0 <= idx) {
-						commitPackedRefs(lck, packed.remove(idx), packed, true);
+						commitPackedRefs(lck, all.remove(idx), packed, true);
 					}
 				} finally {
 					lck.unlock();
@@ -747,12 +764,12 @@ private void pack(Collection<String> refs,
 			LockFile lck = lockPackedRefsOrThrow();
 			try {
 				PackedRefList oldPacked = refreshPackedRefs();
-				RefList<Ref> newPacked = oldPacked;
+				RefList<Ref> newPacked = oldPacked.getRefs(ALL);
 
 				// Iterate over all refs to be packed
 				boolean dirty = false;
 				for (String refName : refs) {
-					Ref oldRef = readRef(refName, newPacked);
+					Ref oldRef = readRef(refName, oldPacked);
 					if (oldRef == null) {
 						continue; // A non-existent ref is already correctly packed.
 					}
@@ -897,7 +914,7 @@ void log(boolean force, RefUpdate update, String msg, boolean deref)
 	}
 
 	private Ref resolve(final Ref ref, int depth, String prefix,
-			RefList<LooseRef> loose, RefList<Ref> packed) throws IOException {
+			RefList<LooseRef> loose, PackedRefList packed) throws IOException {
 		if (ref.isSymbolic()) {
 			Ref dst = ref.getTarget();
 
@@ -908,10 +925,11 @@ private Ref resolve(final Ref ref, int depth, String prefix,
 			// recent scan of the loose directory, use it.
 			if (loose != null && dst.getName().startsWith(prefix)) {
 				int idx;
+				Ref p;
 				if (0 <= (idx = loose.find(dst.getName())))
 					dst = loose.get(idx);
-				else if (0 <= (idx = packed.find(dst.getName())))
-					dst = packed.get(idx);
+				else if ((p = packed.get(dst.getName())) != null)
+					dst = p;
 				else
 					return ref;
 			} else {
@@ -978,6 +996,14 @@ private PackedRefList readPackedRefs() throws IOException {
 					f -> {
 						FileSnapshot snapshot = FileSnapshot.save(f);
 						MessageDigest digest = Constants.newMessageDigest();
+						if (packedRefsMmap) {
+							MappedPackedRefs mapped = MappedPackedRefs.open(f);
+							if (mapped != null) {
+								mapped.digest(digest);
+								return new PackedRefList(mapped, snapshot,
+										ObjectId.fromRaw(digest.digest()));
+							}
+						}
 						try (BufferedReader br = new BufferedReader(
 								new InputStreamReader(
 										new DigestInputStream(
@@ -1099,7 +1125,8 @@ protected void writeFile(String name, byte[] content)
 		}.writePackedRefs();
 	}
 
-	private Ref readRef(String name, RefList<Ref> packed) throws IOException {
+	private Ref readRef(String name, PackedRefList packed)
+			throws IOException {
 		final RefList<LooseRef> curList = looseRefs.get();
 		final int idx = curList.find(name);
 		if (0 <= idx) {
@@ -1391,16 +1418,77 @@ static void sleep(long ms) throws InterruptedIOException {
 		}
 	}
 
-	static class PackedRefList extends RefList<Ref> {
+	/**
+	 * Immutable sorted list of packed references.
+	 * <p>
+	 * The references of a mapped {@code packed-refs} file are only parsed when
+	 * they are looked up, and all of them only if all are requested.
+	 */
+	static class PackedRefList {
 
 		private final FileSnapshot snapshot;
 
 		private final ObjectId id;
 
+		/** The mapped file, null if the references were parsed at once. */
+		private final MappedPackedRefs mapped;
+
+		/** All references; for a mapped file set once all were parsed. */
+		private volatile RefList<Ref> refs;
+
 		private PackedRefList(RefList<Ref> src, FileSnapshot s, ObjectId i) {
-			super(src);
 			snapshot = s;
 			id = i;
+			mapped = null;
+			refs = src;
+		}
+
+		private PackedRefList(MappedPackedRefs m, FileSnapshot s, ObjectId i) {
+			snapshot = s;
+			id = i;
+			mapped = m;
+		}
+
+		/**
+		 * Get a packed reference.
+		 *
+		 * @param name
+		 *            name of the reference
+		 * @return the reference, or null if it is not packed
+		 * @throws IOException
+		 *             if the mapped file is corrupt
+		 */
+		@Nullable
+		Ref get(String name) throws IOException {
+			RefList<Ref> all = refs;
+			if (all != null) {
+				return all.get(name);
+			}
+			return mapped.get(name);
+		}
+
+		/**
+		 * Get the packed references starting with a prefix.
+		 *
+		 * @param prefix
+		 *            prefix of the reference names, {@link RefDatabase#ALL}
+		 *            for all references
+		 * @return a sorted list containing at least the references starting
+		 *         with the prefix
+		 * @throws IOException
+		 *             if the mapped file is corrupt
+		 */
+		RefList<Ref> getRefs(String prefix) throws IOException {
+			RefList<Ref> all = refs;
+			if (all != null) {
+				return all;
+			}
+			if (!prefix.isEmpty()) {
+				return mapped.getRefs(prefix);
+			}
+			all = mapped.getRefs(ALL);
+			refs = all;
+			return all;
 		}
 	}
 
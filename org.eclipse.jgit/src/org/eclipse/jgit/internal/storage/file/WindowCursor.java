@@ -26,13 +26,18 @@
 import org.eclipse.jgit.errors.MissingObjectException;
 import org.eclipse.jgit.errors.StoredObjectRepresentationNotAvailableException;
 import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.internal.storage.file.BitmapIndexImpl.CompressedBitmapBuilder;
+import org.eclipse.jgit.internal.storage.midx.MultiPackIndex;
 import org.eclipse.jgit.internal.storage.pack.CachedPack;
 import org.eclipse.jgit.internal.storage.pack.ObjectReuseAsIs;
 import org.eclipse.jgit.internal.storage.pack.ObjectToPack;
+import org.eclipse.jgit.internal.storage.pack.PackExt;
 import org.eclipse.jgit.internal.storage.pack.PackOutputStream;
 import org.eclipse.jgit.internal.storage.pack.PackWriter;
 import org.eclipse.jgit.lib.AbbreviatedObjectId;
 import org.eclipse.jgit.lib.AnyObjectId;
+import org.eclipse.jgit.lib.AsyncObjectLoaderQueue;
+import org.eclipse.jgit.lib.AsyncObjectSizeQueue;
 import org.eclipse.jgit.lib.BitmapIndex;
 import org.eclipse.jgit.lib.BitmapIndex.BitmapBuilder;
 import org.eclipse.jgit.internal.storage.commitgraph.CommitGraph;
@@ -86,6 +91,10 @@ public ObjectReader newReader() {
 
 	@Override
 	public BitmapIndex getBitmapIndex() throws IOException {
+		PackBitmapIndex midxBitmaps = db.getMultiPackBitmapIndex();
+		if (midxBitmaps != null) {
+			return new BitmapIndexImpl(midxBitmaps);
+		}
 		for (Pack pack : db.getPacks()) {
 			PackBitmapIndex index = pack.getBitmapIndex();
 			if (index != null)
@@ -102,6 +111,17 @@ public Optional<CommitGraph> getCommitGraph() {
 	@Override
 	public Collection<CachedPack> getCachedPacksAndUpdate(
 			BitmapBuilder needBitmap) throws IOException {
+		PackBitmapIndex bitmaps = ((BitmapIndexImpl) needBitmap
+				.getBitmapIndex()).getPackBitmapIndex();
+		if (bitmaps instanceof MultiPackBitmapIndex) {
+			Pack pack = getLeadingPack((MultiPackBitmapIndex) bitmaps);
+			if (pack != null && ((CompressedBitmapBuilder) needBitmap)
+					.removeAllOrNone((int) pack.getObjectCount())) {
+				return Collections.<CachedPack> singletonList(
+						new LocalCachedPack(Collections.singletonList(pack)));
+			}
+			return Collections.emptyList();
+		}
 		for (Pack pack : db.getPacks()) {
 			PackBitmapIndex index = pack.getBitmapIndex();
 			if (needBitmap.removeAllOrNone(index))
@@ -111,6 +131,78 @@ public Collection<CachedPack> getCachedPacksAndUpdate(
 		return Collections.emptyList();
 	}
 
+	@Override
+	public CachedPack getPartialCachedPackAndUpdate(
+			BitmapBuilder needBitmap) throws IOException {
+		BitmapIndexImpl bitmapIndex = (BitmapIndexImpl) needBitmap
+				.getBitmapIndex();
+		PackBitmapIndex index = bitmapIndex.getPackBitmapIndex();
+		Pack pack = null;
+		if (index instanceof MultiPackBitmapIndex) {
+			pack = getLeadingPack((MultiPackBitmapIndex) index);
+		} else {
+			for (Pack p : db.getPacks()) {
+				if (p.getBitmapIndex() == index) {
+					pack = p;
+					break;
+				}
+			}
+		}
+		if (pack == null) {
+			return null;
+		}
+		LocalPartialCachedPack part = pack.selectPartialAsIs(
+				needBitmap.retrieveCompressed(), this);
+		if (part != null) {
+			needBitmap.andNot(new BitmapIndexImpl.CompressedBitmap(
+					part.positions, bitmapIndex));
+		}
+		return part;
+	}
+
+	/**
+	 * Find the pack whose objects take the first positions of multi-pack-index
+	 * bitmaps.
+	 * <p>
+	 * Pseudo-pack order groups the objects by pack and orders them by offset,
+	 * like the bitmaps of a single pack. Bitmap positions of the leading pack
+	 * therefore can be reused as positions in that pack, which allows sending
+	 * it as a cached pack.
+	 *
+	 * @param bitmaps
+	 *            the multi-pack-index bitmaps.
+	 * @return the leading pack, or null if no pack has all its objects at the
+	 *         start of the pseudo-pack order.
+	 * @throws IOException
+	 *             the pack index cannot be read.
+	 */
+	@Nullable
+	private Pack getLeadingPack(MultiPackBitmapIndex bitmaps)
+			throws IOException {
+		MultiPackIndex midx = bitmaps.getMultiPackIndex();
+		if (midx.getObjectCount() == 0) {
+			return null;
+		}
+		int packId = midx.getPackId(midx.getPositionAtPseudoPackPosition(0));
+		String name = midx.getPackNames()[packId];
+		for (Pack pack : db.getPacks()) {
+			if (!pack.getPackFile().create(PackExt.INDEX).getName()
+					.equals(name)) {
+				continue;
+			}
+			// Objects stored in other packs too may have been recorded for
+			// another pack; the pack leads only if none of them was.
+			long cnt = pack.getObjectCount();
+			if (cnt == 0 || cnt > midx.getObjectCount() || midx.getPackId(
+					midx.getPositionAtPseudoPackPosition((int) cnt - 1))
+					!= packId) {
+				return null;
+			}
+			return pack;
+		}
+		return null;
+	}
+
 	@Override
 	public Collection<ObjectId> resolve(AbbreviatedObjectId id)
 			throws IOException {
@@ -130,7 +222,10 @@ public boolean has(AnyObjectId objectId) throws IOException {
 	public ObjectLoader open(AnyObjectId objectId, int typeHint)
 			throws MissingObjectException, IncorrectObjectTypeException,
 			IOException {
-		final ObjectLoader ldr = db.openObject(this, objectId);
+		ObjectLoader ldr = db.openObject(this, objectId);
+		if (ldr == null && fetchPromised(objectId)) {
+			ldr = db.openObject(this, objectId);
+		}
 		if (ldr == null) {
 			if (typeHint == OBJ_ANY)
 				throw new MissingObjectException(objectId.copy(),
@@ -142,6 +237,18 @@ public ObjectLoader open(AnyObjectId objectId, int typeHint)
 		return ldr;
 	}
 
+	private boolean fetchPromised(AnyObjectId objectId) throws IOException {
+		PromisorRemote promisor = db.getPromisorRemote();
+		return promisor != null
+				&& promisor.fetch(db, Collections.singleton(objectId));
+	}
+
+	@Override
+	public <T extends ObjectId> AsyncObjectLoaderQueue<T> open(
+			Iterable<T> objectIds, boolean reportMissing) {
+		return new AsyncObjectQueue<>(this, objectIds, false);
+	}
+
 	@Override
 	public Set<ObjectId> getShallowCommits() throws IOException {
 		return db.getShallowCommits();
@@ -152,6 +259,9 @@ public long getObjectSize(AnyObjectId objectId, int typeHint)
 			throws MissingObjectException, IncorrectObjectTypeException,
 			IOException {
 		long sz = db.getObjectSize(this, objectId);
+		if (sz < 0 && fetchPromised(objectId)) {
+			sz = db.getObjectSize(this, objectId);
+		}
 		if (sz < 0) {
 			if (typeHint == OBJ_ANY)
 				throw new MissingObjectException(objectId.copy(),
@@ -161,6 +271,12 @@ public long getObjectSize(AnyObjectId objectId, int typeHint)
 		return sz;
 	}
 
+	@Override
+	public <T extends ObjectId> AsyncObjectSizeQueue<T> getObjectSize(
+			Iterable<T> objectIds, boolean reportMissing) {
+		return new AsyncObjectQueue<>(this, objectIds, true);
+	}
+
 	@Override
 	public LocalObjectToPack newObjectToPack(AnyObjectId objectId, int type) {
 		return new LocalObjectToPack(objectId, type);
@@ -230,13 +346,16 @@ int copy(final Pack pack, long position, final byte[] dstbuf,
 	@Override
 	public void copyPackAsIs(PackOutputStream out, CachedPack pack)
 			throws IOException {
-		((LocalCachedPack) pack).copyAsIs(out, this);
+		if (pack instanceof LocalPartialCachedPack) {
+			((LocalPartialCachedPack) pack).copyAsIs(out, this);
+		} else {
+			((LocalCachedPack) pack).copyAsIs(out, this);
+		}
 	}
 
-	void copyPackAsIs(final Pack pack, final long length,
+	void copyPackAsIs(final Pack pack, long position, final long end,
 			final PackOutputStream out) throws IOException {
-		long position = 12;
-		long remaining = length - (12 + 20);
+		long remaining = end - position;
 		while (0 < remaining) {
 			pin(pack, position);
 
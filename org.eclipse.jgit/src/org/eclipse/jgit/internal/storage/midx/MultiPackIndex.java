@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.midx;
+
+import java.util.Set;
+
+import org.eclipse.jgit.lib.AbbreviatedObjectId;
+import org.eclipse.jgit.lib.AnyObjectId;
+import org.eclipse.jgit.lib.ObjectId;
+
+/**
+ * The multi-pack-index maps every object of a set of packs to the pack storing
+ * it and its offset within that pack.
+ * <p>
+ * Objects are listed in lexicographic order, so locating an object takes a
+ * single binary search no matter how many packs are covered. If an object is
+ * stored in more than one of the covered packs only one copy is recorded.
+ * <p>
+ * Packs are identified by their "pack-int-id", the position of their index
+ * file name in the sorted list returned by {@link #getPackNames()}.
+ * <p>
+ * Besides the lexicographic order, objects have a position in pseudo-pack
+ * order: the order of the objects if the covered packs were concatenated,
+ * preferred pack first. Multi-pack reachability bitmaps number objects by
+ * their pseudo-pack position.
+ */
+public interface MultiPackIndex {
+
+	/**
+	 * Get the names of the pack index files covered by this multi-pack-index.
+	 *
+	 * @return the sorted names of the pack index files, e.g.
+	 *         {@code pack-1234...abcd.idx}. The position of a name in this
+	 *         array is the pack-int-id of the pack.
+	 */
+	String[] getPackNames();
+
+	/**
+	 * Get the number of distinct objects in this multi-pack-index.
+	 *
+	 * @return number of objects.
+	 */
+	int getObjectCount();
+
+	/**
+	 * Find the position of an object in the multi-pack-index.
+	 *
+	 * @param id
+	 *            the object to look for.
+	 * @return the position of the object or -1 if it is not covered.
+	 */
+	int findPosition(AnyObjectId id);
+
+	/**
+	 * Get the object at a position of the multi-pack-index.
+	 *
+	 * @param position
+	 *            position in the multi-pack-index, in
+	 *            {@code [0, getObjectCount())}.
+	 * @return the object id at this position.
+	 */
+	ObjectId getObjectId(int position);
+
+	/**
+	 * Get the pack-int-id of the pack holding the object at a position.
+	 *
+	 * @param position
+	 *            position in the multi-pack-index, in
+	 *            {@code [0, getObjectCount())}.
+	 * @return index of the pack in {@link #getPackNames()}.
+	 */
+	int getPackId(int position);
+
+	/**
+	 * Get the offset of the object at a position in its pack.
+	 *
+	 * @param position
+	 *            position in the multi-pack-index, in
+	 *            {@code [0, getObjectCount())}.
+	 * @return offset of the object in the pack identified by
+	 *         {@link #getPackId(int)}.
+	 */
+	long getOffset(int position);
+
+	/**
+	 * Get the pseudo-pack position of the object at a position.
+	 *
+	 * @param position
+	 *            position in the multi-pack-index, in
+	 *            {@code [0, getObjectCount())}.
+	 * @return position of the object in pseudo-pack order.
+	 */
+	int getPseudoPackPosition(int position);
+
+	/**
+	 * Get the position of the object at a pseudo-pack position.
+	 *
+	 * @param pseudoPackPosition
+	 *            position in pseudo-pack order, in
+	 *            {@code [0, getObjectCount())}.
+	 * @return position of the object in the multi-pack-index.
+	 */
+	int getPositionAtPseudoPackPosition(int pseudoPackPosition);
+
+	/**
+	 * Find objects matching the prefix abbreviation.
+	 *
+	 * @param matches
+	 *            set to add any located ObjectIds to. This is an output
+	 *            parameter.
+	 * @param id
+	 *            prefix to search for.
+	 * @param matchLimit
+	 *            maximum number of results to return. At most this many
+	 *            ObjectIds should be added to matches before returning.
+	 */
+	void resolve(Set<ObjectId> matches, AbbreviatedObjectId id,
+			int matchLimit);
+
+	/**
+	 * Get the checksum of the multi-pack-index file.
+	 *
+	 * @return the trailing checksum of the file.
+	 */
+	byte[] getChecksum();
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.midx;
+
+/**
+ * Constants relating to the multi-pack-index file.
+ */
+class MultiPackIndexConstants {
+
+	static final int MIDX_SIGNATURE = 0x4d494458; /* "MIDX" */
+
+	static final byte MIDX_VERSION = 1;
+
+	static final byte OID_HASH_VERSION = 1; /* SHA-1 */
+
+	static final int CHUNK_ID_PACKFILE_NAMES = 0x504e414d; /* "PNAM" */
+
+	static final int CHUNK_ID_OID_FANOUT = 0x4f494446; /* "OIDF" */
+
+	static final int CHUNK_ID_OID_LOOKUP = 0x4f49444c; /* "OIDL" */
+
+	static final int CHUNK_ID_OBJECT_OFFSETS = 0x4f4f4646; /* "OOFF" */
+
+	static final int CHUNK_ID_LARGE_OFFSETS = 0x4c4f4646; /* "LOFF" */
+
+	static final int CHUNK_ID_REVERSE_INDEX = 0x52494458; /* "RIDX" */
+
+	/** Size of the fixed header preceding the chunk lookup table. */
+	static final int MIDX_HEADER_SIZE = 12;
+
+	/**
+	 * First 4 bytes describe the chunk id. Value 0 is a terminating label.
+	 * Other 8 bytes provide the byte-offset in current file for chunk to start.
+	 */
+	static final int CHUNK_LOOKUP_WIDTH = 12;
+
+	/** Number of entries in the OID fanout table. */
+	static final int FANOUT = 256;
+
+	/**
+	 * First 4 bytes are the pack-int-id of the pack storing the object, the
+	 * next 4 bytes its offset in that pack.
+	 */
+	static final int OBJECT_OFFSETS_WIDTH = 8;
+
+	/**
+	 * Offset &amp; MIDX_LARGE_OFFSET_NEEDED != 0 means the remaining bits are
+	 * a position in the large offsets chunk.
+	 */
+	static final int MIDX_LARGE_OFFSET_NEEDED = 0x80000000;
+
+	/** Width of an entry in the reverse index chunk. */
+	static final int REVERSE_INDEX_WIDTH = 4;
+
+	/** Chunk data is padded to multiples of this alignment. */
+	static final int MIDX_CHUNK_ALIGNMENT = 4;
+}
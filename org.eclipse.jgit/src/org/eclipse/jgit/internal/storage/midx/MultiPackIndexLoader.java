@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.midx;
+
+import static java.nio.charset.StandardCharsets.UTF_8;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.CHUNK_ID_LARGE_OFFSETS;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.CHUNK_ID_OBJECT_OFFSETS;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.CHUNK_ID_OID_FANOUT;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.CHUNK_ID_OID_LOOKUP;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.CHUNK_ID_PACKFILE_NAMES;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.CHUNK_ID_REVERSE_INDEX;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.CHUNK_LOOKUP_WIDTH;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.MIDX_HEADER_SIZE;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.MIDX_SIGNATURE;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.MIDX_VERSION;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.OID_HASH_VERSION;
+import static org.eclipse.jgit.lib.Constants.OBJECT_ID_LENGTH;
+
+import java.io.File;
+import java.io.FileNotFoundException;
+import java.io.IOException;
+import java.io.InputStream;
+import java.text.MessageFormat;
+import java.util.ArrayList;
+import java.util.List;
+
+import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.util.IO;
+import org.eclipse.jgit.util.NB;
+import org.eclipse.jgit.util.io.SilentFileInputStream;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * The loader returns the representation of the multi-pack-index file content.
+ */
+public class MultiPackIndexLoader {
+
+	private final static Logger LOG = LoggerFactory
+			.getLogger(MultiPackIndexLoader.class);
+
+	/**
+	 * Open an existing multi-pack-index file for reading.
+	 *
+	 * @param midxFile
+	 *            existing multi-pack-index to read.
+	 * @return a copy of the multi-pack-index file in memory
+	 * @throws FileNotFoundException
+	 *             the file does not exist.
+	 * @throws MultiPackIndexFormatException
+	 *             multi-pack-index file's format is different from we
+	 *             expected.
+	 * @throws java.io.IOException
+	 *             the file exists but could not be read due to security errors
+	 *             or unexpected data corruption.
+	 */
+	public static MultiPackIndex open(File midxFile)
+			throws FileNotFoundException, MultiPackIndexFormatException,
+			IOException {
+		try (SilentFileInputStream fd = new SilentFileInputStream(midxFile)) {
+			try {
+				return read(fd);
+			} catch (MultiPackIndexFormatException fe) {
+				throw fe;
+			} catch (IOException ioe) {
+				throw new IOException(MessageFormat.format(
+						JGitText.get().unreadableMultiPackIndex,
+						midxFile.getAbsolutePath()), ioe);
+			}
+		}
+	}
+
+	/**
+	 * Read an existing multi-pack-index file from a buffered stream.
+	 *
+	 * @param fd
+	 *            stream to read the multi-pack-index file from. The stream
+	 *            must be buffered as some small IOs are performed against the
+	 *            stream. The caller is responsible for closing the stream.
+	 * @return a copy of the multi-pack-index file in memory
+	 * @throws MultiPackIndexFormatException
+	 *             the multi-pack-index file's format is different from we
+	 *             expected.
+	 * @throws java.io.IOException
+	 *             the stream cannot be read.
+	 */
+	public static MultiPackIndex read(InputStream fd)
+			throws MultiPackIndexFormatException, IOException {
+		byte[] hdr = new byte[MIDX_HEADER_SIZE];
+		IO.readFully(fd, hdr, 0, hdr.length);
+
+		if (NB.decodeInt32(hdr, 0) != MIDX_SIGNATURE) {
+			throw new MultiPackIndexFormatException(
+					JGitText.get().notAMultiPackIndex);
+		}
+		int v = hdr[4];
+		if (v != MIDX_VERSION) {
+			throw new MultiPackIndexFormatException(MessageFormat.format(
+					JGitText.get().unsupportedMultiPackIndexVersion,
+					Integer.valueOf(v)));
+		}
+		if (hdr[5] != OID_HASH_VERSION) {
+			throw new MultiPackIndexFormatException(
+					JGitText.get().incorrectOBJECT_ID_LENGTH);
+		}
+		int numberOfChunks = hdr[6] & 0xff;
+		// hdr[7] is the number of base multi-pack-index files, which is
+		// always 0 in the current format.
+		int numberOfPacks = NB.decodeInt32(hdr, 8);
+
+		byte[] lookupBuffer = new byte[CHUNK_LOOKUP_WIDTH
+				* (numberOfChunks + 1)];
+		IO.readFully(fd, lookupBuffer, 0, lookupBuffer.length);
+		List<ChunkSegment> chunks = new ArrayList<>(numberOfChunks + 1);
+		for (int i = 0; i <= numberOfChunks; i++) {
+			// chunks[numberOfChunks] is just a marker, in order to record the
+			// length of the last chunk.
+			int id = NB.decodeInt32(lookupBuffer, i * CHUNK_LOOKUP_WIDTH);
+			long offset = NB.decodeInt64(lookupBuffer,
+					i * CHUNK_LOOKUP_WIDTH + 4);
+			chunks.add(new ChunkSegment(id, offset));
+		}
+
+		byte[] packNames = null;
+		byte[] oidFanout = null;
+		byte[] oidLookup = null;
+		byte[] objectOffsets = null;
+		byte[] largeOffsets = null;
+		byte[] reverseIndex = null;
+		long pos = MIDX_HEADER_SIZE + lookupBuffer.length;
+		for (int i = 0; i < numberOfChunks; i++) {
+			long chunkOffset = chunks.get(i).offset;
+			int chunkId = chunks.get(i).id;
+			long len = chunks.get(i + 1).offset - chunkOffset;
+
+			if (chunkOffset != pos || len < 0) {
+				throw new MultiPackIndexFormatException(
+						JGitText.get().multiPackIndexChunkSizeMismatch);
+			}
+			if (len > Integer.MAX_VALUE - 8) { // http://stackoverflow.com/a/8381338
+				throw new MultiPackIndexFormatException(
+						JGitText.get().multiPackIndexFileIsTooLargeForJgit);
+			}
+
+			byte[] buffer = new byte[(int) len];
+			IO.readFully(fd, buffer, 0, buffer.length);
+			pos += len;
+
+			switch (chunkId) {
+			case CHUNK_ID_PACKFILE_NAMES:
+				packNames = buffer;
+				break;
+			case CHUNK_ID_OID_FANOUT:
+				oidFanout = buffer;
+				break;
+			case CHUNK_ID_OID_LOOKUP:
+				oidLookup = buffer;
+				break;
+			case CHUNK_ID_OBJECT_OFFSETS:
+				objectOffsets = buffer;
+				break;
+			case CHUNK_ID_LARGE_OFFSETS:
+				largeOffsets = buffer;
+				break;
+			case CHUNK_ID_REVERSE_INDEX:
+				reverseIndex = buffer;
+				break;
+			default:
+				LOG.warn(MessageFormat.format(
+						JGitText.get().multiPackIndexChunkUnknown,
+						Integer.toHexString(chunkId)));
+			}
+		}
+
+		requireChunk(packNames, CHUNK_ID_PACKFILE_NAMES);
+		requireChunk(oidFanout, CHUNK_ID_OID_FANOUT);
+		requireChunk(oidLookup, CHUNK_ID_OID_LOOKUP);
+		requireChunk(objectOffsets, CHUNK_ID_OBJECT_OFFSETS);
+
+		byte[] checksum = new byte[OBJECT_ID_LENGTH];
+		IO.readFully(fd, checksum, 0, checksum.length);
+
+		return new MultiPackIndexV1(parsePackNames(packNames, numberOfPacks),
+				oidFanout, oidLookup, objectOffsets, largeOffsets,
+				reverseIndex, checksum);
+	}
+
+	private static void requireChunk(byte[] chunk, int chunkId)
+			throws MultiPackIndexFormatException {
+		if (chunk == null) {
+			throw new MultiPackIndexFormatException(MessageFormat.format(
+					JGitText.get().multiPackIndexChunkNeeded,
+					Integer.toHexString(chunkId)));
+		}
+	}
+
+	private static String[] parsePackNames(byte[] buffer, int numberOfPacks)
+			throws MultiPackIndexFormatException {
+		String[] names = new String[numberOfPacks];
+		int ptr = 0;
+		for (int i = 0; i < numberOfPacks; i++) {
+			int end = ptr;
+			while (end < buffer.length && buffer[end] != 0) {
+				end++;
+			}
+			if (end == buffer.length || end == ptr) {
+				throw new MultiPackIndexFormatException(
+						JGitText.get().multiPackIndexChunkSizeMismatch);
+			}
+			names[i] = new String(buffer, ptr, end - ptr, UTF_8);
+			ptr = end + 1;
+		}
+		// Any remaining bytes are zero padding up to the chunk alignment.
+		return names;
+	}
+
+	private static class ChunkSegment {
+		final int id;
+
+		final long offset;
+
+		private ChunkSegment(int id, long offset) {
+			this.id = id;
+			this.offset = offset;
+		}
+	}
+}
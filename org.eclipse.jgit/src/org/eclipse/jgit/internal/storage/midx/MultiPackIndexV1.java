@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.midx;
+
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.FANOUT;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.MIDX_LARGE_OFFSET_NEEDED;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.OBJECT_OFFSETS_WIDTH;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.REVERSE_INDEX_WIDTH;
+import static org.eclipse.jgit.lib.Constants.OBJECT_ID_LENGTH;
+
+import java.text.MessageFormat;
+import java.util.Arrays;
+import java.util.BitSet;
+import java.util.Set;
+
+import org.eclipse.jgit.annotations.Nullable;
+import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.lib.AbbreviatedObjectId;
+import org.eclipse.jgit.lib.AnyObjectId;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.util.NB;
+
+/**
+ * Support for the multi-pack-index v1 format.
+ */
+class MultiPackIndexV1 implements MultiPackIndex {
+
+	private final String[] packNames;
+
+	private final int[] fanoutTable;
+
+	private final byte[] oidLookup;
+
+	private final byte[] objectOffsets;
+
+	@Nullable
+	private final byte[] largeOffsets;
+
+	@Nullable
+	private final byte[] reverseIndex;
+
+	private final byte[] checksum;
+
+	private volatile PseudoPackOrder pseudoPackOrder;
+
+	MultiPackIndexV1(String[] packNames, byte[] oidFanout, byte[] oidLookup,
+			byte[] objectOffsets, @Nullable byte[] largeOffsets,
+			@Nullable byte[] reverseIndex, byte[] checksum)
+			throws MultiPackIndexFormatException {
+		this.packNames = packNames;
+		this.oidLookup = oidLookup;
+		this.objectOffsets = objectOffsets;
+		this.largeOffsets = largeOffsets;
+		this.reverseIndex = reverseIndex;
+		this.checksum = checksum;
+
+		int[] table = new int[FANOUT];
+		for (int k = 0; k < table.length; k++) {
+			long uint32 = NB.decodeUInt32(oidFanout, k * 4);
+			if (uint32 > Integer.MAX_VALUE) {
+				throw new MultiPackIndexFormatException(
+						JGitText.get().multiPackIndexFileIsTooLargeForJgit);
+			}
+			table[k] = (int) uint32;
+		}
+		int count = table[FANOUT - 1];
+		if ((long) count * OBJECT_ID_LENGTH != oidLookup.length
+				|| (long) count * OBJECT_OFFSETS_WIDTH != objectOffsets.length
+				|| (reverseIndex != null && (long) count
+						* REVERSE_INDEX_WIDTH != reverseIndex.length)) {
+			throw new MultiPackIndexFormatException(
+					JGitText.get().multiPackIndexChunkSizeMismatch);
+		}
+		for (int i = 0; i < count; i++) {
+			int packId = getPackId(i);
+			if (packId < 0 || packId >= packNames.length) {
+				throw new MultiPackIndexFormatException(MessageFormat.format(
+						JGitText.get().multiPackIndexInvalidPackId,
+						Integer.valueOf(packId)));
+			}
+		}
+		if (reverseIndex != null) {
+			checkReverseIndex(reverseIndex, count);
+		}
+		this.fanoutTable = table;
+	}
+
+	private static void checkReverseIndex(byte[] reverseIndex, int count)
+			throws MultiPackIndexFormatException {
+		BitSet seen = new BitSet(count);
+		for (int i = 0; i < count; i++) {
+			int position = NB.decodeInt32(reverseIndex,
+					i * REVERSE_INDEX_WIDTH);
+			if (position < 0 || position >= count || seen.get(position)) {
+				throw new MultiPackIndexFormatException(
+						JGitText.get().corruptMultiPackIndexReverseIndex);
+			}
+			seen.set(position);
+		}
+	}
+
+	@Override
+	public String[] getPackNames() {
+		return packNames.clone();
+	}
+
+	@Override
+	public int getObjectCount() {
+		return fanoutTable[FANOUT - 1];
+	}
+
+	@Override
+	public int findPosition(AnyObjectId id) {
+		int levelOne = id.getFirstByte();
+		int high = fanoutTable[levelOne];
+		int low = levelOne > 0 ? fanoutTable[levelOne - 1] : 0;
+		while (low < high) {
+			int mid = (low + high) >>> 1;
+			int cmp = id.compareTo(oidLookup, mid * OBJECT_ID_LENGTH);
+			if (cmp < 0) {
+				high = mid;
+			} else if (cmp == 0) {
+				return mid;
+			} else {
+				low = mid + 1;
+			}
+		}
+		return -1;
+	}
+
+	@Override
+	public ObjectId getObjectId(int position) {
+		return ObjectId.fromRaw(oidLookup, position * OBJECT_ID_LENGTH);
+	}
+
+	@Override
+	public int getPackId(int position) {
+		return NB.decodeInt32(objectOffsets, position * OBJECT_OFFSETS_WIDTH);
+	}
+
+	@Override
+	public long getOffset(int position) {
+		int offset32 = NB.decodeInt32(objectOffsets,
+				position * OBJECT_OFFSETS_WIDTH + 4);
+		if ((offset32 & MIDX_LARGE_OFFSET_NEEDED) != 0
+				&& largeOffsets != null) {
+			int idx = offset32 & ~MIDX_LARGE_OFFSET_NEEDED;
+			return NB.decodeUInt64(largeOffsets, idx * 8);
+		}
+		return offset32 & 0xffffffffL;
+	}
+
+	@Override
+	public int getPseudoPackPosition(int position) {
+		return getPseudoPackOrder().pseudoPackPositions[position];
+	}
+
+	@Override
+	public int getPositionAtPseudoPackPosition(int pseudoPackPosition) {
+		return getPseudoPackOrder().positions[pseudoPackPosition];
+	}
+
+	private PseudoPackOrder getPseudoPackOrder() {
+		PseudoPackOrder order = pseudoPackOrder;
+		if (order == null) {
+			synchronized (this) {
+				order = pseudoPackOrder;
+				if (order == null) {
+					order = computePseudoPackOrder();
+					pseudoPackOrder = order;
+				}
+			}
+		}
+		return order;
+	}
+
+	private PseudoPackOrder computePseudoPackOrder() {
+		int count = getObjectCount();
+		int[] positions = new int[count];
+		if (reverseIndex != null) {
+			for (int i = 0; i < count; i++) {
+				positions[i] = NB.decodeInt32(reverseIndex,
+						i * REVERSE_INDEX_WIDTH);
+			}
+		} else {
+			// Without a reverse index chunk no pack is known to be
+			// preferred; order by pack-int-id and offset.
+			Integer[] order = new Integer[count];
+			for (int i = 0; i < count; i++) {
+				order[i] = Integer.valueOf(i);
+			}
+			Arrays.sort(order, (a, b) -> {
+				int cmp = Integer.compare(getPackId(a.intValue()),
+						getPackId(b.intValue()));
+				return cmp != 0 ? cmp
+						: Long.compare(getOffset(a.intValue()),
+								getOffset(b.intValue()));
+			});
+			for (int i = 0; i < count; i++) {
+				positions[i] = order[i].intValue();
+			}
+		}
+
+		int[] pseudoPackPositions = new int[count];
+		for (int i = 0; i < count; i++) {
+			pseudoPackPositions[positions[i]] = i;
+		}
+		return new PseudoPackOrder(positions, pseudoPackPositions);
+	}
+
+	@Override
+	public void resolve(Set<ObjectId> matches, AbbreviatedObjectId id,
+			int matchLimit) {
+		int levelOne = id.getFirstByte();
+		int max = fanoutTable[levelOne];
+		int low = levelOne > 0 ? fanoutTable[levelOne - 1] : 0;
+		int high = max;
+		while (low < high) {
+			int p = (low + high) >>> 1;
+			int cmp = id.prefixCompare(oidLookup, p * OBJECT_ID_LENGTH);
+			if (cmp < 0) {
+				high = p;
+			} else if (cmp == 0) {
+				// We may have landed in the middle of the matches. Move
+				// backwards to the start of matches, then walk forwards.
+				while (low < p && id.prefixCompare(oidLookup,
+						(p - 1) * OBJECT_ID_LENGTH) == 0) {
+					p--;
+				}
+				for (; p < max && id.prefixCompare(oidLookup,
+						p * OBJECT_ID_LENGTH) == 0; p++) {
+					matches.add(getObjectId(p));
+					if (matches.size() > matchLimit) {
+						break;
+					}
+				}
+				return;
+			} else {
+				low = p + 1;
+			}
+		}
+	}
+
+	@Override
+	public byte[] getChecksum() {
+		return checksum.clone();
+	}
+
+	private static final class PseudoPackOrder {
+		/** Position in the multi-pack-index by pseudo-pack position. */
+		final int[] positions;
+
+		/** Pseudo-pack position by position in the multi-pack-index. */
+		final int[] pseudoPackPositions;
+
+		PseudoPackOrder(int[] positions, int[] pseudoPackPositions) {
+			this.positions = positions;
+			this.pseudoPackPositions = pseudoPackPositions;
+		}
+	}
+}
@@ -0,0 +1,377 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.midx;
+
+import static java.nio.charset.StandardCharsets.UTF_8;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.CHUNK_ID_LARGE_OFFSETS;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.CHUNK_ID_OBJECT_OFFSETS;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.CHUNK_ID_OID_FANOUT;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.CHUNK_ID_OID_LOOKUP;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.CHUNK_ID_PACKFILE_NAMES;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.CHUNK_ID_REVERSE_INDEX;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.CHUNK_LOOKUP_WIDTH;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.FANOUT;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.MIDX_CHUNK_ALIGNMENT;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.MIDX_HEADER_SIZE;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.MIDX_LARGE_OFFSET_NEEDED;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.MIDX_SIGNATURE;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.MIDX_VERSION;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.OBJECT_OFFSETS_WIDTH;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.OID_HASH_VERSION;
+import static org.eclipse.jgit.internal.storage.midx.MultiPackIndexConstants.REVERSE_INDEX_WIDTH;
+import static org.eclipse.jgit.lib.Constants.OBJECT_ID_LENGTH;
+
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.io.OutputStream;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Comparator;
+import java.util.Iterator;
+import java.util.List;
+import java.util.PriorityQueue;
+
+import org.eclipse.jgit.annotations.NonNull;
+import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.internal.storage.file.PackIndex;
+import org.eclipse.jgit.internal.storage.io.CancellableDigestOutputStream;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.lib.ProgressMonitor;
+import org.eclipse.jgit.util.NB;
+
+/**
+ * Writes a multi-pack-index formatted file.
+ * <p>
+ * Packs are added in order of preference: if an object is stored in more than
+ * one pack, the multi-pack-index refers to the copy in the pack added first.
+ * <p>
+ * The objects are also listed in pseudo-pack order, the order they would have
+ * if all packs were concatenated with the first added (preferred) pack first
+ * and the others by pack-int-id. Bitmaps of a multi-pack-index use this
+ * order.
+ */
+public class MultiPackIndexWriter {
+
+	private final List<PackSource> packs = new ArrayList<>();
+
+	/**
+	 * Add a pack to be covered by the multi-pack-index.
+	 *
+	 * @param indexName
+	 *            file name of the pack index, e.g.
+	 *            {@code pack-1234...abcd.idx}.
+	 * @param index
+	 *            the loaded index of the pack.
+	 * @return {@code this}
+	 */
+	public MultiPackIndexWriter addPack(@NonNull String indexName,
+			@NonNull PackIndex index) {
+		packs.add(new PackSource(indexName, index, packs.size()));
+		return this;
+	}
+
+	/**
+	 * Write the multi-pack-index to the supplied stream.
+	 *
+	 * @param monitor
+	 *            progress monitor to report the number of items written.
+	 * @param midxStream
+	 *            output stream of multi-pack-index data. The stream should be
+	 *            buffered by the caller. The caller is responsible for closing
+	 *            the stream.
+	 * @return number of distinct objects written to the multi-pack-index
+	 * @throws IOException
+	 *             if an error occurred
+	 */
+	public int write(@NonNull ProgressMonitor monitor,
+			@NonNull OutputStream midxStream) throws IOException {
+		String[] names = packs.stream().map(p -> p.name).sorted()
+				.toArray(String[]::new);
+		for (PackSource p : packs) {
+			p.packId = Arrays.binarySearch(names, p.name);
+		}
+		ObjectEntries entries = collectObjects(monitor);
+
+		byte[] packNames = encodePackNames(names);
+		List<ChunkHeader> chunks = new ArrayList<>();
+		chunks.add(new ChunkHeader(CHUNK_ID_PACKFILE_NAMES, packNames.length));
+		chunks.add(new ChunkHeader(CHUNK_ID_OID_FANOUT, FANOUT * 4));
+		chunks.add(new ChunkHeader(CHUNK_ID_OID_LOOKUP,
+				(long) entries.count * OBJECT_ID_LENGTH));
+		chunks.add(new ChunkHeader(CHUNK_ID_OBJECT_OFFSETS,
+				(long) entries.count * OBJECT_OFFSETS_WIDTH));
+		if (entries.largeOffsetCount > 0) {
+			chunks.add(new ChunkHeader(CHUNK_ID_LARGE_OFFSETS,
+					entries.largeOffsetCount * 8L));
+		}
+		chunks.add(new ChunkHeader(CHUNK_ID_REVERSE_INDEX,
+				(long) entries.count * REVERSE_INDEX_WIDTH));
+
+		try (CancellableDigestOutputStream out = new CancellableDigestOutputStream(
+				monitor, midxStream)) {
+			writeHeader(out, chunks.size(), names.length);
+			writeChunkLookup(out, chunks);
+			out.write(packNames);
+			writeFanoutTable(out, entries);
+			out.write(entries.oids, 0, entries.count * OBJECT_ID_LENGTH);
+			writeObjectOffsets(out, entries);
+			if (entries.largeOffsetCount > 0) {
+				writeLargeOffsets(out, entries);
+			}
+			writeReverseIndex(out, entries, preferredPackId());
+			out.write(out.getDigest());
+			out.flush();
+		} catch (InterruptedIOException e) {
+			throw new IOException(
+					JGitText.get().multiPackIndexWritingCancelled, e);
+		}
+		return entries.count;
+	}
+
+	private int preferredPackId() {
+		return packs.isEmpty() ? -1 : packs.get(0).packId;
+	}
+
+	private ObjectEntries collectObjects(ProgressMonitor monitor) {
+		long total = 0;
+		PriorityQueue<PackSource> queue = new PriorityQueue<>(
+				Math.max(1, packs.size()), PackSource.ORDER);
+		for (PackSource p : packs) {
+			total += p.index.getObjectCount();
+			if (p.next()) {
+				queue.add(p);
+			}
+		}
+		if (total > Integer.MAX_VALUE / OBJECT_ID_LENGTH) {
+			throw new IllegalArgumentException(
+					JGitText.get().multiPackIndexFileIsTooLargeForJgit);
+		}
+
+		ObjectEntries entries = new ObjectEntries((int) total);
+		monitor.beginTask(JGitText.get().collectingObjectsForMultiPackIndex,
+				(int) total);
+		ObjectId last = null;
+		while (!queue.isEmpty()) {
+			PackSource p = queue.poll();
+			// The queue yields duplicates in order of preference, so only
+			// the first copy of an object is recorded.
+			if (last == null || !last.equals(p.current)) {
+				last = p.current;
+				entries.add(p.current, p.packId, p.offset);
+			}
+			monitor.update(1);
+			if (p.next()) {
+				queue.add(p);
+			}
+		}
+		monitor.endTask();
+		return entries;
+	}
+
+	private static byte[] encodePackNames(String[] names) {
+		int size = 0;
+		byte[][] raw = new byte[names.length][];
+		for (int i = 0; i < names.length; i++) {
+			raw[i] = names[i].getBytes(UTF_8);
+			size += raw[i].length + 1;
+		}
+		int padding = (MIDX_CHUNK_ALIGNMENT - size % MIDX_CHUNK_ALIGNMENT)
+				% MIDX_CHUNK_ALIGNMENT;
+		byte[] buf = new byte[size + padding];
+		int ptr = 0;
+		for (byte[] name : raw) {
+			System.arraycopy(name, 0, buf, ptr, name.length);
+			ptr += name.length + 1;
+		}
+		return buf;
+	}
+
+	private static void writeHeader(CancellableDigestOutputStream out,
+			int numChunks, int numPacks) throws IOException {
+		byte[] headerBuffer = new byte[MIDX_HEADER_SIZE];
+		NB.encodeInt32(headerBuffer, 0, MIDX_SIGNATURE);
+		headerBuffer[4] = MIDX_VERSION;
+		headerBuffer[5] = OID_HASH_VERSION;
+		headerBuffer[6] = (byte) numChunks;
+		headerBuffer[7] = 0; // number of base multi-pack-index files
+		NB.encodeInt32(headerBuffer, 8, numPacks);
+		out.write(headerBuffer);
+	}
+
+	private static void writeChunkLookup(CancellableDigestOutputStream out,
+			List<ChunkHeader> chunks) throws IOException {
+		long chunkOffset = MIDX_HEADER_SIZE
+				+ (chunks.size() + 1L) * CHUNK_LOOKUP_WIDTH;
+		byte[] buffer = new byte[CHUNK_LOOKUP_WIDTH];
+		for (ChunkHeader chunk : chunks) {
+			NB.encodeInt32(buffer, 0, chunk.id);
+			NB.encodeInt64(buffer, 4, chunkOffset);
+			out.write(buffer);
+			chunkOffset += chunk.size;
+		}
+		NB.encodeInt32(buffer, 0, 0);
+		NB.encodeInt64(buffer, 4, chunkOffset);
+		out.write(buffer);
+	}
+
+	private static void writeFanoutTable(CancellableDigestOutputStream out,
+			ObjectEntries entries) throws IOException {
+		int[] fanout = new int[FANOUT];
+		for (int i = 0; i < entries.count; i++) {
+			fanout[entries.oids[i * OBJECT_ID_LENGTH] & 0xff]++;
+		}
+		for (int i = 1; i < fanout.length; i++) {
+			fanout[i] += fanout[i - 1];
+		}
+		byte[] tmp = new byte[4];
+		for (int n : fanout) {
+			NB.encodeInt32(tmp, 0, n);
+			out.write(tmp, 0, 4);
+		}
+	}
+
+	private static void writeObjectOffsets(CancellableDigestOutputStream out,
+			ObjectEntries entries) throws IOException {
+		byte[] tmp = new byte[OBJECT_OFFSETS_WIDTH];
+		int large = 0;
+		for (int i = 0; i < entries.count; i++) {
+			long offset = entries.offsets[i];
+			NB.encodeInt32(tmp, 0, entries.packIds[i]);
+			if (needsLargeOffset(offset)) {
+				NB.encodeInt32(tmp, 4, MIDX_LARGE_OFFSET_NEEDED | large++);
+			} else {
+				NB.encodeInt32(tmp, 4, (int) offset);
+			}
+			out.write(tmp);
+		}
+	}
+
+	private static void writeLargeOffsets(CancellableDigestOutputStream out,
+			ObjectEntries entries) throws IOException {
+		byte[] tmp = new byte[8];
+		for (int i = 0; i < entries.count; i++) {
+			long offset = entries.offsets[i];
+			if (needsLargeOffset(offset)) {
+				NB.encodeInt64(tmp, 0, offset);
+				out.write(tmp);
+			}
+		}
+	}
+
+	private static void writeReverseIndex(CancellableDigestOutputStream out,
+			ObjectEntries entries, int preferredPackId) throws IOException {
+		Integer[] order = new Integer[entries.count];
+		for (int i = 0; i < order.length; i++) {
+			order[i] = Integer.valueOf(i);
+		}
+		Arrays.sort(order, (a, b) -> {
+			int packA = entries.packIds[a.intValue()];
+			int packB = entries.packIds[b.intValue()];
+			if (packA != packB) {
+				if (packA == preferredPackId) {
+					return -1;
+				}
+				if (packB == preferredPackId) {
+					return 1;
+				}
+				return Integer.compare(packA, packB);
+			}
+			return Long.compare(entries.offsets[a.intValue()],
+					entries.offsets[b.intValue()]);
+		});
+		byte[] tmp = new byte[REVERSE_INDEX_WIDTH];
+		for (Integer position : order) {
+			NB.encodeInt32(tmp, 0, position.intValue());
+			out.write(tmp);
+		}
+	}
+
+	private static boolean needsLargeOffset(long offset) {
+		return (offset & ~0x7fffffffL) != 0;
+	}
+
+	private static class ObjectEntries {
+		final byte[] oids;
+
+		final int[] packIds;
+
+		final long[] offsets;
+
+		int count;
+
+		int largeOffsetCount;
+
+		ObjectEntries(int capacity) {
+			oids = new byte[capacity * OBJECT_ID_LENGTH];
+			packIds = new int[capacity];
+			offsets = new long[capacity];
+		}
+
+		void add(ObjectId id, int packId, long offset) {
+			id.copyRawTo(oids, count * OBJECT_ID_LENGTH);
+			packIds[count] = packId;
+			offsets[count] = offset;
+			if (needsLargeOffset(offset)) {
+				largeOffsetCount++;
+			}
+			count++;
+		}
+	}
+
+	private static class PackSource {
+		static final Comparator<PackSource> ORDER = (a, b) -> {
+			int cmp = a.current.compareTo(b.current);
+			return cmp != 0 ? cmp : Integer.compare(a.preference, b.preference);
+		};
+
+		final String name;
+
+		final PackIndex index;
+
+		final int preference;
+
+		final Iterator<PackIndex.MutableEntry> entries;
+
+		int packId;
+
+		ObjectId current;
+
+		long offset;
+
+		PackSource(String name, PackIndex index, int preference) {
+			this.name = name;
+			this.index = index;
+			this.preference = preference;
+			this.entries = index.iterator();
+		}
+
+		boolean next() {
+			if (!entries.hasNext()) {
+				return false;
+			}
+			PackIndex.MutableEntry e = entries.next();
+			current = e.toObjectId();
+			offset = e.getOffset();
+			return true;
+		}
+	}
+
+	private static class ChunkHeader {
+		final int id;
+
+		final long size;
+
+		ChunkHeader(int id, long size) {
+			this.id = id;
+			this.size = size;
+		}
+	}
+}
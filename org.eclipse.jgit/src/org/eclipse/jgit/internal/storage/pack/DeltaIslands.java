@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.storage.pack;
+
+import static org.eclipse.jgit.lib.Constants.OBJ_TREE;
+
+import java.io.IOException;
+import java.text.MessageFormat;
+import java.util.ArrayList;
+import java.util.BitSet;
+import java.util.Collection;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+import java.util.regex.PatternSyntaxException;
+
+import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.lib.AnyObjectId;
+import org.eclipse.jgit.lib.FileMode;
+import org.eclipse.jgit.lib.NullProgressMonitor;
+import org.eclipse.jgit.lib.ObjectIdOwnerMap;
+import org.eclipse.jgit.lib.ObjectReader;
+import org.eclipse.jgit.lib.ProgressMonitor;
+import org.eclipse.jgit.lib.Ref;
+import org.eclipse.jgit.revwalk.RevCommit;
+import org.eclipse.jgit.revwalk.RevObject;
+import org.eclipse.jgit.revwalk.RevSort;
+import org.eclipse.jgit.revwalk.RevTag;
+import org.eclipse.jgit.revwalk.RevWalk;
+import org.eclipse.jgit.treewalk.CanonicalTreeParser;
+
+/**
+ * Delta islands of a repository.
+ * <p>
+ * Repositories of a fork network often share one object store, while every
+ * fork only serves the objects reachable from its own references. Grouping
+ * the references of each fork into an island, and only storing objects as
+ * delta against bases which belong to all islands of the object, ensures
+ * that a pack sent for any fork can reuse the stored deltas as they are.
+ * <p>
+ * References are grouped by regular expressions matched against their names,
+ * see
+ * {@link org.eclipse.jgit.storage.pack.PackConfig#setDeltaIslands(String[])}.
+ */
+public class DeltaIslands {
+	private static class Marks extends ObjectIdOwnerMap.Entry {
+		/** Islands of the object, shared with other objects; never mutated. */
+		BitSet islands;
+
+		Marks(AnyObjectId id) {
+			super(id);
+		}
+	}
+
+	/**
+	 * Compute the islands of all objects reachable from the given references.
+	 *
+	 * @param reader
+	 *            reader to parse the objects with
+	 * @param regexes
+	 *            regular expressions grouping the references into islands
+	 * @param refs
+	 *            references of the repository
+	 * @param pm
+	 *            progress monitor, may be null
+	 * @return the islands
+	 * @throws IllegalArgumentException
+	 *             if one of the regular expressions is invalid
+	 * @throws IOException
+	 *             if an object cannot be read
+	 */
+	public static DeltaIslands compute(ObjectReader reader, String[] regexes,
+			Collection<Ref> refs, ProgressMonitor pm) throws IOException {
+		List<Pattern> patterns = new ArrayList<>(regexes.length);
+		for (String regex : regexes) {
+			try {
+				patterns.add(Pattern.compile(regex));
+			} catch (PatternSyntaxException e) {
+				throw new IllegalArgumentException(MessageFormat.format(
+						JGitText.get().invalidDeltaIsland, regex), e);
+			}
+		}
+		if (pm == null) {
+			pm = NullProgressMonitor.INSTANCE;
+		}
+		DeltaIslands islands = new DeltaIslands();
+		pm.beginTask(JGitText.get().markingDeltaIslands,
+				ProgressMonitor.UNKNOWN);
+		try {
+			islands.compute(reader, patterns, refs, pm);
+		} finally {
+			pm.endTask();
+		}
+		return islands;
+	}
+
+	private final ObjectIdOwnerMap<Marks> marks = new ObjectIdOwnerMap<>();
+
+	private final Map<BitSet, BitSet> interned = new HashMap<>();
+
+	private final Map<String, Integer> names = new LinkedHashMap<>();
+
+	private DeltaIslands() {
+		// Computed by compute().
+	}
+
+	/**
+	 * Get the names of the islands.
+	 *
+	 * @return names of the islands, in the order they were found
+	 */
+	public List<String> getIslandNames() {
+		return Collections.unmodifiableList(new ArrayList<>(names.keySet()));
+	}
+
+	/**
+	 * Whether an object belongs to an island.
+	 *
+	 * @param id
+	 *            the object
+	 * @param island
+	 *            name of the island
+	 * @return true if the object is reachable from a reference of the island
+	 */
+	public boolean isInIsland(AnyObjectId id, String island) {
+		Integer bit = names.get(island);
+		Marks m = marks.get(id);
+		return bit != null && m != null && m.islands.get(bit.intValue());
+	}
+
+	/**
+	 * Whether an object may be stored as delta against a base.
+	 *
+	 * @param target
+	 *            the object to store as delta
+	 * @param base
+	 *            the delta base
+	 * @return true if the base belongs to all islands of the target. Objects
+	 *         not reachable from any island may use any base.
+	 */
+	public boolean canDelta(AnyObjectId target, AnyObjectId base) {
+		Marks t = marks.get(target);
+		if (t == null) {
+			return true;
+		}
+		Marks b = marks.get(base);
+		if (b == null) {
+			return false;
+		}
+		return contains(b.islands, t.islands);
+	}
+
+	private void compute(ObjectReader reader, List<Pattern> patterns,
+			Collection<Ref> refs, ProgressMonitor pm) throws IOException {
+		try (RevWalk rw = new RevWalk(reader)) {
+			rw.setRetainBody(false);
+			rw.sort(RevSort.TOPO);
+			CanonicalTreeParser parser = new CanonicalTreeParser();
+			for (Ref ref : refs) {
+				if (ref.isSymbolic() || ref.getObjectId() == null) {
+					continue;
+				}
+				Integer island = islandOf(patterns, ref.getName());
+				if (island == null) {
+					continue;
+				}
+				BitSet set = new BitSet();
+				set.set(island.intValue());
+				set = intern(set);
+				RevObject o = rw.parseAny(ref.getObjectId());
+				while (o instanceof RevTag) {
+					mark(o, set);
+					o = rw.parseAny(((RevTag) o).getObject());
+				}
+				if (o instanceof RevCommit) {
+					mark(o, set);
+					rw.markStart((RevCommit) o);
+				} else if (o.getType() == OBJ_TREE) {
+					markTree(reader, parser, o, set);
+				} else {
+					mark(o, set);
+				}
+			}
+			if (names.isEmpty()) {
+				return;
+			}
+
+			// Children are returned before their parents, so the islands of
+			// each commit are complete when it is returned.
+			List<RevCommit> commits = new ArrayList<>();
+			for (RevCommit c; (c = rw.next()) != null;) {
+				BitSet set = marks.get(c).islands;
+				for (RevCommit p : c.getParents()) {
+					mark(p, set);
+				}
+				commits.add(c);
+				pm.update(1);
+			}
+
+			// Older commits belong to more islands. Marking their trees first
+			// avoids walking most trees again for newer commits.
+			for (int i = commits.size() - 1; i >= 0; i--) {
+				RevCommit c = commits.get(i);
+				markTree(reader, parser, c.getTree(), marks.get(c).islands);
+			}
+		}
+	}
+
+	private Integer islandOf(List<Pattern> patterns, String refName) {
+		// The last matching expression determines the island.
+		for (int i = patterns.size() - 1; i >= 0; i--) {
+			Matcher m = patterns.get(i).matcher(refName);
+			if (!m.find()) {
+				continue;
+			}
+			StringBuilder name = new StringBuilder();
+			for (int g = 1; g <= m.groupCount(); g++) {
+				if (m.group(g) == null) {
+					continue;
+				}
+				if (name.length() > 0) {
+					name.append('-');
+				}
+				name.append(m.group(g));
+			}
+			return names.computeIfAbsent(name.toString(),
+					n -> Integer.valueOf(names.size()));
+		}
+		return null;
+	}
+
+	private void markTree(ObjectReader reader, CanonicalTreeParser parser,
+			AnyObjectId tree, BitSet set) throws IOException {
+		if (!mark(tree, set)) {
+			return;
+		}
+		byte[] raw = reader.open(tree, OBJ_TREE).getCachedBytes();
+		List<AnyObjectId> subtrees = null;
+		for (parser.reset(raw); !parser.eof(); parser.next()) {
+			int mode = parser.getEntryRawMode();
+			if (FileMode.TREE.equals(mode)) {
+				if (subtrees == null) {
+					subtrees = new ArrayList<>();
+				}
+				subtrees.add(parser.getEntryObjectId());
+			} else if (!FileMode.GITLINK.equals(mode)) {
+				mark(parser.getEntryObjectId(), set);
+			}
+		}
+		if (subtrees != null) {
+			for (AnyObjectId subtree : subtrees) {
+				markTree(reader, parser, subtree, set);
+			}
+		}
+	}
+
+	/**
+	 * Add an object to islands.
+	 *
+	 * @return true if the object was added to at least one island it did not
+	 *         belong to before
+	 */
+	private boolean mark(AnyObjectId id, BitSet set) {
+		Marks m = marks.get(id);
+		if (m == null) {
+			m = new Marks(id);
+			m.islands = set;
+			marks.add(m);
+			return true;
+		}
+		if (contains(m.islands, set)) {
+			return false;
+		}
+		BitSet union = (BitSet) m.islands.clone();
+		union.or(set);
+		m.islands = intern(union);
+		return true;
+	}
+
+	private BitSet intern(BitSet set) {
+		BitSet s = interned.putIfAbsent(set, set);
+		return s != null ? s : set;
+	}
+
+	private static boolean contains(BitSet set, BitSet subset) {
+		if (set == subset) {
+			return true;
+		}
+		for (int i = subset.nextSetBit(0); i >= 0; i = subset
+				.nextSetBit(i + 1)) {
+			if (!set.get(i)) {
+				return false;
+			}
+		}
+		return true;
+	}
+}
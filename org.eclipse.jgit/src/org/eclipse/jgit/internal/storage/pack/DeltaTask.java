@@ -33,6 +33,7 @@ static final class Block {
 		final PackConfig config;
 		final ObjectReader templateReader;
 		final DeltaCache dc;
+		final DeltaIslands islands;
 		final ThreadSafeProgressMonitor pm;
 		final ObjectToPack[] list;
 		final int beginIndex;
@@ -42,13 +43,15 @@ static final class Block {
 		long bytesPerUnit;
 
 		Block(int threads, PackConfig config, ObjectReader reader,
-				DeltaCache dc, ThreadSafeProgressMonitor pm,
+				DeltaCache dc, DeltaIslands islands,
+				ThreadSafeProgressMonitor pm,
 				ObjectToPack[] list, int begin, int end) {
 			this.tasks = new ArrayList<>(threads);
 			this.threads = threads;
 			this.config = config;
 			this.templateReader = reader;
 			this.dc = dc;
+			this.islands = islands;
 			this.pm = pm;
 			this.list = list;
 			this.beginIndex = begin;
@@ -281,7 +284,7 @@ public Object call() throws Exception {
 
 	DeltaWindow initWindow(Slice s) {
 		DeltaWindow w = new DeltaWindow(block.config, block.dc,
-				or, block.pm, block.bytesPerUnit,
+				block.islands, or, block.pm, block.bytesPerUnit,
 				block.list, s.beginIndex, s.endIndex);
 		synchronized (this) {
 			dw = w;
@@ -29,6 +29,7 @@ final class DeltaWindow {
 
 	private final PackConfig config;
 	private final DeltaCache deltaCache;
+	private final DeltaIslands islands;
 	private final ObjectReader reader;
 	private final ProgressMonitor monitor;
 	private final long bytesPerUnit;
@@ -60,11 +61,12 @@ final class DeltaWindow {
 	/** Used to compress cached deltas. */
 	private Deflater deflater;
 
-	DeltaWindow(PackConfig pc, DeltaCache dc, ObjectReader or,
-			ProgressMonitor pm, long bpu,
+	DeltaWindow(PackConfig pc, DeltaCache dc, DeltaIslands di,
+			ObjectReader or, ProgressMonitor pm, long bpu,
 			ObjectToPack[] in, int beginIndex, int endIndex) {
 		config = pc;
 		deltaCache = dc;
+		islands = di;
 		reader = or;
 		monitor = pm;
 		bytesPerUnit = bpu;
@@ -235,6 +237,10 @@ private void searchInWindow() throws IOException {
 
 	private boolean delta(DeltaWindowEntry src)
 			throws IOException {
+		// The base must be available to every island of the object.
+		if (islands != null && !islands.canDelta(res.object, src.object))
+			return NEXT_SRC;
+
 		// If the sizes are radically different, this is a bad pairing.
 		if (res.size() < src.size() >>> 4)
 			return NEXT_SRC;
@@ -14,6 +14,7 @@
 import java.util.Collection;
 import java.util.List;
 
+import org.eclipse.jgit.annotations.Nullable;
 import org.eclipse.jgit.errors.MissingObjectException;
 import org.eclipse.jgit.errors.StoredObjectRepresentationNotAvailableException;
 import org.eclipse.jgit.lib.AnyObjectId;
@@ -203,4 +204,27 @@ void copyPackAsIs(PackOutputStream out, CachedPack pack)
 	 */
 	Collection<CachedPack> getCachedPacksAndUpdate(
 			BitmapBuilder needBitmap) throws IOException;
+
+	/**
+	 * Obtain the objects of a pack that match the bitmap and can be sent
+	 * as-is, and update the bitmap by removing these objects.
+	 * <p>
+	 * Unlike {@link #getCachedPacksAndUpdate(BitmapBuilder)} this does not
+	 * require the bitmap to contain all objects of the pack. Objects stored
+	 * as delta must only be included if their base is included too. The
+	 * returned pack is sent by {@link #copyPackAsIs(PackOutputStream,
+	 * CachedPack)}, which has to store the deltas as offset deltas.
+	 *
+	 * @param needBitmap
+	 *            the bitmap that contains all of the objects the client wants.
+	 * @return the objects that can be sent as-is, or null if there are none
+	 *         or the implementation does not support partial reuse.
+	 * @throws java.io.IOException
+	 *             the pack cannot be read. Callers may choose to ignore this
+	 *             and continue as-if there were no reusable objects.
+	 * @since 6.9
+	 */
+	@Nullable
+	CachedPack getPartialCachedPackAndUpdate(BitmapBuilder needBitmap)
+			throws IOException;
 }
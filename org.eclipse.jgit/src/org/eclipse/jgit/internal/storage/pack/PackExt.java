@@ -36,7 +36,13 @@ public enum PackExt {
 	COMMIT_GRAPH("graph"), //$NON-NLS-1$
 
 	/** An object size index. */
-	OBJECT_SIZE_INDEX("objsize"); //$NON-NLS-1$
+	OBJECT_SIZE_INDEX("objsize"), //$NON-NLS-1$
+
+	/** The object modification times of a cruft pack. */
+	MTIMES("mtimes"), //$NON-NLS-1$
+
+	/** Marks a pack received from a promisor remote. */
+	PROMISOR("promisor"); //$NON-NLS-1$
 
 	private final String ext;
 
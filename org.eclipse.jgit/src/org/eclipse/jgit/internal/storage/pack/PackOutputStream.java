@@ -119,6 +119,28 @@ public final void writeHeader(ObjectToPack otp, long rawLength)
 		}
 	}
 
+	/**
+	 * Commits the header of an object stored as offset delta onto the stream.
+	 * <p>
+	 * Used when copying an object from another pack whose delta base is at a
+	 * different distance in this stream.
+	 *
+	 * @param rawLength
+	 *            number of bytes of the inflated delta instruction stream.
+	 * @param baseDistance
+	 *            number of bytes between the start of the delta base and the
+	 *            start of this object in the stream.
+	 * @throws java.io.IOException
+	 *             the underlying stream refused to accept the header.
+	 * @since 6.9
+	 */
+	public final void writeOfsDeltaHeader(long rawLength, long baseDistance)
+			throws IOException {
+		int n = objectHeader(rawLength, OBJ_OFS_DELTA, headerBuffer);
+		n = ofsDelta(baseDistance, headerBuffer, n);
+		write(headerBuffer, 0, n);
+	}
+
 	private static final int objectHeader(long len, int type, byte[] buf) {
 		byte b = (byte) ((type << 4) | (len & 0x0F));
 		int n = 0;
@@ -44,6 +44,7 @@
 import java.util.concurrent.Executors;
 import java.util.concurrent.Future;
 import java.util.concurrent.TimeUnit;
+import java.util.function.ToLongFunction;
 import java.util.zip.CRC32;
 import java.util.zip.CheckedOutputStream;
 import java.util.zip.Deflater;
@@ -61,12 +62,14 @@
 import org.eclipse.jgit.internal.storage.file.PackBitmapIndexBuilder;
 import org.eclipse.jgit.internal.storage.file.PackBitmapIndexWriterV1;
 import org.eclipse.jgit.internal.storage.file.PackIndexWriter;
+import org.eclipse.jgit.internal.storage.file.PackMtimesWriter;
 import org.eclipse.jgit.internal.storage.file.PackObjectSizeIndexWriter;
 import org.eclipse.jgit.internal.storage.file.PackReverseIndexWriter;
 import org.eclipse.jgit.lib.AnyObjectId;
 import org.eclipse.jgit.lib.AsyncObjectSizeQueue;
 import org.eclipse.jgit.lib.BatchingProgressMonitor;
 import org.eclipse.jgit.lib.BitmapIndex;
+import org.eclipse.jgit.lib.BitmapIndex.Bitmap;
 import org.eclipse.jgit.lib.BitmapIndex.BitmapBuilder;
 import org.eclipse.jgit.lib.BitmapObject;
 import org.eclipse.jgit.lib.Constants;
@@ -98,6 +101,8 @@
 import org.eclipse.jgit.util.BlockList;
 import org.eclipse.jgit.util.TemporaryBuffer;
 
+import com.googlecode.javaewah.IntIterator;
+
 /**
  * <p>
  * PackWriter class is responsible for generating pack files from specified set
@@ -217,6 +222,8 @@ public static Iterable<PackWriter> getInstances() {
 
 	private Set<ObjectId> tagTargets = NONE;
 
+	private DeltaIslands deltaIslands;
+
 	private Set<? extends ObjectId> excludeFromBitmapSelection = NONE;
 
 	private ObjectIdSet[] excludeInPacks;
@@ -663,6 +670,39 @@ public void setTagTargets(Set<ObjectId> objects) {
 		tagTargets = objects;
 	}
 
+	/**
+	 * Set the delta islands to restrict delta bases to.
+	 * <p>
+	 * Objects are only stored as delta against bases belonging to all of the
+	 * object's islands. Deltas stored in existing packs are reused only if
+	 * their base qualifies, otherwise a new base is searched for.
+	 *
+	 * @param islands
+	 *            the delta islands, or null to allow any delta base
+	 */
+	public void setDeltaIslands(DeltaIslands islands) {
+		deltaIslands = islands;
+	}
+
+	/**
+	 * Record how much existing pack data a repack producing this pack
+	 * rewrites and how much it leaves in place.
+	 * <p>
+	 * The values are only reported through {@link #getStatistics()}.
+	 *
+	 * @param rewrittenBytes
+	 *            total size in bytes of the existing pack files whose objects
+	 *            are rewritten into this pack.
+	 * @param reusedBytes
+	 *            total size in bytes of the existing pack files which are
+	 *            kept as they are.
+	 * @since 6.9
+	 */
+	public void setRepackedPackSizes(long rewrittenBytes, long reusedBytes) {
+		stats.rewrittenPackBytes = rewrittenBytes;
+		stats.reusedPackBytes = reusedBytes;
+	}
+
 	/**
 	 * Configure this pack for a shallow clone.
 	 *
@@ -1199,6 +1239,29 @@ public void writeReverseIndex(OutputStream stream) throws IOException {
 		stats.timeWriting += System.currentTimeMillis() - writeStart;
 	}
 
+	/**
+	 * Write the modification times of the objects of a cruft pack to the
+	 * output stream.
+	 * <p>
+	 * Called after
+	 * {@link #writePack(ProgressMonitor, ProgressMonitor, OutputStream)}.
+	 *
+	 * @param stream
+	 *            where to write the file contents to
+	 * @param mtimes
+	 *            modification time of an object in the pack, in seconds since
+	 *            the epoch
+	 * @throws IOException
+	 *             if writing to the stream fails
+	 * @since 6.9
+	 */
+	public void writeMtimes(OutputStream stream,
+			ToLongFunction<AnyObjectId> mtimes) throws IOException {
+		long writeStart = System.currentTimeMillis();
+		new PackMtimesWriter(stream).write(sortByName(), mtimes, packcsum);
+		stats.timeWriting += System.currentTimeMillis() - writeStart;
+	}
+
 	/**
 	 * Create a bitmap index file to match the pack file just written.
 	 * <p>
@@ -1707,8 +1770,8 @@ private void singleThreadDeltaSearch(ProgressMonitor monitor,
 			cost++;
 
 		beginPhase(PackingPhase.COMPRESSING, monitor, cost);
-		new DeltaWindow(config, new DeltaCache(config), reader,
-				monitor, bytesPerUnit,
+		new DeltaWindow(config, new DeltaCache(config), deltaIslands,
+				reader, monitor, bytesPerUnit,
 				list, 0, cnt).search();
 		endPhase(monitor);
 	}
@@ -1719,7 +1782,7 @@ private void parallelDeltaSearch(ProgressMonitor monitor,
 		DeltaCache dc = new ThreadSafeDeltaCache(config);
 		ThreadSafeProgressMonitor pm = new ThreadSafeProgressMonitor(monitor);
 		DeltaTask.Block taskBlock = new DeltaTask.Block(threads, config,
-				reader, dc, pm,
+				reader, dc, deltaIslands, pm,
 				list, 0, cnt);
 		taskBlock.partitionTasks();
 		beginPhase(PackingPhase.COMPRESSING, monitor, taskBlock.cost());
@@ -2247,9 +2310,19 @@ private void findObjectsToPackUsingBitmaps(
 		BitmapBuilder needBitmap = wantBitmap.andNot(haveBitmap);
 
 		if (useCachedPacks && reuseSupport != null && !reuseValidate
-				&& (excludeInPacks == null || excludeInPacks.length == 0))
-			cachedPacks.addAll(
-					reuseSupport.getCachedPacksAndUpdate(needBitmap));
+				&& (excludeInPacks == null || excludeInPacks.length == 0)) {
+			Collection<CachedPack> packs = reuseSupport
+					.getCachedPacksAndUpdate(needBitmap);
+			if (packs.isEmpty() && config.isPartialPackReuse()
+					&& deltaBaseAsOffset) {
+				CachedPack part = reuseSupport
+						.getPartialCachedPackAndUpdate(needBitmap);
+				if (part != null) {
+					packs = Collections.singletonList(part);
+				}
+			}
+			cachedPacks.addAll(packs);
+		}
 
 		for (BitmapObject obj : needBitmap) {
 			ObjectId objectId = obj.getObjectId();
@@ -2420,6 +2493,12 @@ public void select(ObjectToPack otp, StoredObjectRepresentation next) {
 
 		if (nFmt == PACK_DELTA && reuseDeltas && reuseDeltaFor(otp)) {
 			ObjectId baseId = next.getDeltaBase();
+			if (deltaIslands != null
+					&& !deltaIslands.canDelta(otp, baseId)) {
+				// Keep any representation selected before; if there is
+				// none the delta search picks a base within the islands.
+				return;
+			}
 			ObjectToPack ptr = objectsMap.get(baseId);
 			if (ptr != null && !ptr.isEdge()) {
 				otp.setDeltaBase(ptr);
@@ -2496,8 +2575,59 @@ public boolean prepareBitmapIndex(ProgressMonitor pm) throws IOException {
 		// Allow byName to be GC'd if JVM GC runs before the end of the method.
 		byName = null;
 
+		return buildBitmaps(pm, numCommits, stats.interestingObjects, false);
+	}
+
+	/**
+	 * Prepares bitmaps over objects already stored in existing packs, e.g. the
+	 * packs covered by a multi-pack-index, rather than a pack written by this
+	 * writer.
+	 * <p>
+	 * Bitmaps are computed for commits selected from the history reachable
+	 * from {@code want}. Every object reachable from {@code want} must be one
+	 * of {@code objects}.
+	 *
+	 * @param pm
+	 *            progress monitor to report bitmap building work.
+	 * @param objects
+	 *            objects numbered by the bitmaps, sorted by name. The offset
+	 *            of each object gives its order in the bitmaps. The list is
+	 *            resorted in place.
+	 * @param want
+	 *            tips of the history to select bitmap commits from.
+	 * @return the bitmaps, ready to be written by
+	 *         {@link org.eclipse.jgit.internal.storage.file.PackBitmapIndexWriterV1};
+	 *         null if an object reachable from {@code want} is not in
+	 *         {@code objects}.
+	 * @throws java.io.IOException
+	 *             when some I/O problem occur during reading objects.
+	 * @since 6.9
+	 */
+	@Nullable
+	public PackBitmapIndexBuilder prepareBitmapIndex(ProgressMonitor pm,
+			List<ObjectToPack> objects, Set<? extends ObjectId> want)
+			throws IOException {
+		if (pm == null) {
+			pm = NullProgressMonitor.INSTANCE;
+		}
+		int numCommits = 0;
+		for (ObjectToPack otp : objects) {
+			if (otp.getType() == OBJ_COMMIT) {
+				numCommits++;
+			}
+		}
+		writeBitmaps = new PackBitmapIndexBuilder(objects);
+		if (!buildBitmaps(pm, numCommits, want, true)) {
+			writeBitmaps = null;
+		}
+		return writeBitmaps;
+	}
+
+	private boolean buildBitmaps(ProgressMonitor pm, int numCommits,
+			Set<? extends ObjectId> want, boolean requireAllObjects)
+			throws IOException {
 		PackWriterBitmapPreparer bitmapPreparer = new PackWriterBitmapPreparer(
-				reader, writeBitmaps, pm, stats.interestingObjects, config);
+				reader, writeBitmaps, pm, want, config);
 
 		Collection<BitmapCommit> selectedCommits = bitmapPreparer
 				.selectCommits(numCommits, excludeFromBitmapSelection);
@@ -2518,8 +2648,12 @@ public boolean prepareBitmapIndex(ProgressMonitor pm) throws IOException {
 						JGitText.get().bitmapMissingObject, cmit.name(),
 						last.name()));
 			last = BitmapCommit.copyFrom(cmit).build();
-			writeBitmaps.processBitmapForWrite(cmit, bitmap.build(),
-					cmit.getFlags());
+			Bitmap built = bitmap.build();
+			if (requireAllObjects && !isInPack(built)) {
+				endPhase(pm);
+				return false;
+			}
+			writeBitmaps.processBitmapForWrite(cmit, built, cmit.getFlags());
 
 			// The bitmap walker should stop when the walk hits the previous
 			// commit, which saves time.
@@ -2533,6 +2667,20 @@ public boolean prepareBitmapIndex(ProgressMonitor pm) throws IOException {
 		return true;
 	}
 
+	/**
+	 * Whether all objects of a bitmap are in the pack being written.
+	 * <p>
+	 * The bitmap walker numbers reachable objects missing from the pack after
+	 * the objects of {@link #writeBitmaps}, so the highest set position tells
+	 * whether any of them was reached.
+	 */
+	private boolean isInPack(Bitmap bitmap) {
+		IntIterator positions = bitmap.retrieveCompressed()
+				.reverseIntIterator();
+		return !positions.hasNext()
+				|| positions.next() < writeBitmaps.getObjectCount();
+	}
+
 	private boolean reuseDeltaFor(ObjectToPack otp) {
 		int type = otp.getType();
 		if ((type & 2) != 0) // OBJ_TREE(2) or OBJ_BLOB(3)
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.internal.util;
+
+import java.io.IOException;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * Worker threads shared by the commands splitting their work over several
+ * threads, e.g. resolving the deltas of a received pack.
+ * <p>
+ * Threads are created on demand and end after being idle for a minute.
+ * Callers limit how many threads they use by the number of tasks they
+ * submit, which lets nested users not wait for each other.
+ */
+public final class Workers {
+	private static final AtomicInteger threadNumber = new AtomicInteger();
+
+	private static final ExecutorService executor = Executors
+			.newCachedThreadPool(r -> {
+				Thread t = new Thread(r, "JGit-Worker-" //$NON-NLS-1$
+						+ threadNumber.incrementAndGet());
+				t.setContextClassLoader(null);
+				t.setDaemon(true);
+				return t;
+			});
+
+	private Workers() {
+		// Static utility methods only
+	}
+
+	/**
+	 * Get the executor running the worker threads.
+	 *
+	 * @return the shared executor; it must not be shut down.
+	 */
+	public static ExecutorService getExecutor() {
+		return executor;
+	}
+
+	/**
+	 * Wait for a task and rethrow its failure as though it had been run by
+	 * the calling thread.
+	 *
+	 * @param <T>
+	 *            type of the result
+	 * @param task
+	 *            the task to wait for
+	 * @return the result of the task
+	 * @throws IOException
+	 *             the task failed with an IOException, or a checked
+	 *             exception which is wrapped
+	 * @throws InterruptedException
+	 *             the calling thread was interrupted while waiting
+	 */
+	public static <T> T join(Future<T> task)
+			throws IOException, InterruptedException {
+		try {
+			return task.get();
+		} catch (ExecutionException e) {
+			Throwable err = e.getCause();
+			if (err instanceof IOException) {
+				throw (IOException) err;
+			}
+			if (err instanceof RuntimeException) {
+				throw (RuntimeException) err;
+			}
+			if (err instanceof Error) {
+				throw (Error) err;
+			}
+			throw new IOException(err.getMessage(), err);
+		}
+	}
+}
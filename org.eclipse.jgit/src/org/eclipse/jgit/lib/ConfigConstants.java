@@ -841,6 +841,13 @@ public final class ConfigConstants {
 	 */
 	public static final String CONFIG_KEY_THREADS = "threads";
 
+	/**
+	 * The "pack.indexThreads" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_INDEX_THREADS = "indexThreads";
+
 	/**
 	 * The "pack.waitPreventRacyPack" key
 	 * @since 5.8
@@ -998,4 +1005,214 @@ public final class ConfigConstants {
 	 * @since 6.7
 	 */
 	public static final String CONFIG_KEY_READ_CHANGED_PATHS = "readChangedPaths";
+
+	/**
+	 * The "multiPackIndex" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_MULTI_PACK_INDEX = "multiPackIndex";
+
+	/**
+	 * The "writeMultiPackIndex" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_WRITE_MULTI_PACK_INDEX = "writeMultiPackIndex";
+
+	/**
+	 * The "geometricFactor" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_GEOMETRIC_FACTOR = "geometricFactor";
+
+	/**
+	 * The "cruftPacks" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_CRUFT_PACKS = "cruftPacks";
+
+	/**
+	 * The "recordEndOfIndexEntries" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_RECORD_END_OF_INDEX_ENTRIES = "recordEndOfIndexEntries";
+
+	/**
+	 * The "recordOffsetTable" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_RECORD_OFFSET_TABLE = "recordOffsetTable";
+
+	/**
+	 * The "untrackedCache" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_UNTRACKED_CACHE = "untrackedCache";
+
+	/**
+	 * The "fsmonitor" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_FSMONITOR = "fsmonitor";
+
+	/**
+	 * The "splitIndex" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_SPLIT_INDEX = "splitIndex";
+
+	/**
+	 * The "splitIndex" section
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_SPLIT_INDEX_SECTION = "splitIndex";
+
+	/**
+	 * The "maxPercentChange" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_MAX_PERCENT_CHANGE = "maxPercentChange";
+
+	/**
+	 * The "sharedIndexExpire" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_SHARED_INDEX_EXPIRE = "sharedIndexExpire";
+
+	/**
+	 * The "splitCommitGraph" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_SPLIT_COMMIT_GRAPH = "splitCommitGraph";
+
+	/**
+	 * The "commitGraphSizeMultiple" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_COMMIT_GRAPH_SIZE_MULTIPLE = "commitGraphSizeMultiple";
+
+	/**
+	 * The "checkout" section
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_CHECKOUT_SECTION = "checkout";
+
+	/**
+	 * The "workers" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_WORKERS = "workers";
+
+	/**
+	 * The "thresholdForParallelism" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_THRESHOLD_FOR_PARALLELISM = "thresholdForParallelism";
+
+	/**
+	 * The "add" section
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_ADD_SECTION = "add";
+
+	/**
+	 * The "sparseCheckout" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_SPARSE_CHECKOUT = "sparseCheckout";
+
+	/**
+	 * The "sparseCheckoutCone" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_SPARSE_CHECKOUT_CONE = "sparseCheckoutCone";
+
+	/**
+	 * The "sparse" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_SPARSE_INDEX = "sparse";
+
+	/**
+	 * The "promisor" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_PROMISOR = "promisor";
+
+	/**
+	 * The "partialclonefilter" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_PARTIAL_CLONE_FILTER = "partialclonefilter";
+
+	/**
+	 * The "partialClone" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_PARTIAL_CLONE = "partialClone";
+
+	/**
+	 * The "negotiationAlgorithm" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_NEGOTIATION_ALGORITHM = "negotiationAlgorithm";
+
+	/**
+	 * The "negotiate" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_NEGOTIATE = "negotiate";
+
+	/**
+	 * The "island" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_ISLAND = "island";
+
+	/**
+	 * The "useDeltaIslands" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_USE_DELTA_ISLANDS = "useDeltaIslands";
+
+	/**
+	 * The "packedRefsMmap" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_PACKED_REFS_MMAP = "packedRefsMmap";
+
+	/**
+	 * The "allowPackReuse" key
+	 *
+	 * @since 6.9
+	 */
+	public static final String CONFIG_KEY_ALLOW_PACK_REUSE = "allowPackReuse";
 }
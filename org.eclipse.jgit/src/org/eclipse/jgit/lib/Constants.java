@@ -290,6 +290,25 @@ public final class Constants {
 	 */
 	public static final String INFO_COMMIT_GRAPH = "info/commit-graph";
 
+	/**
+	 * info commit-graphs directory holding a commit-graph chain (goes under
+	 * OBJECTS)
+	 * @since 6.9
+	 */
+	public static final String INFO_COMMIT_GRAPHS = "info/commit-graphs";
+
+	/**
+	 * commit-graph chain file (goes under OBJECTS/info/commit-graphs)
+	 * @since 6.9
+	 */
+	public static final String COMMIT_GRAPH_CHAIN = "commit-graph-chain";
+
+	/**
+	 * multi-pack-index file (goes under OBJECTS/pack)
+	 * @since 6.9
+	 */
+	public static final String MULTI_PACK_INDEX = "multi-pack-index";
+
 	/** Packed refs file */
 	public static final String PACKED_REFS = "packed-refs";
 
@@ -307,6 +326,13 @@ public final class Constants {
 	 */
 	public static final String INFO_ATTRIBUTES = "info/attributes";
 
+	/**
+	 * Sparse checkout patterns file
+	 *
+	 * @since 6.9
+	 */
+	public static final String INFO_SPARSE_CHECKOUT = "info/sparse-checkout";
+
 	/**
 	 * The system property that contains the system user name
 	 *
@@ -31,6 +31,8 @@
 import org.eclipse.jgit.dircache.DirCache;
 import org.eclipse.jgit.dircache.DirCacheEntry;
 import org.eclipse.jgit.dircache.DirCacheIterator;
+import org.eclipse.jgit.dircache.FsMonitor;
+import org.eclipse.jgit.dircache.UntrackedCache;
 import org.eclipse.jgit.errors.ConfigInvalidException;
 import org.eclipse.jgit.errors.IncorrectObjectTypeException;
 import org.eclipse.jgit.errors.MissingObjectException;
@@ -49,6 +51,7 @@
 import org.eclipse.jgit.treewalk.filter.IndexDiffFilter;
 import org.eclipse.jgit.treewalk.filter.SkipWorkTreeFilter;
 import org.eclipse.jgit.treewalk.filter.TreeFilter;
+import org.eclipse.jgit.util.StringUtils;
 
 /**
  * Compares the index, a tree, and the working directory Ignored files are not
@@ -458,6 +461,15 @@ public boolean diff(ProgressMonitor monitor, int estWorkTreeSize,
 			int estIndexSize, String title, RepositoryBuilderFactory factory)
 			throws IOException {
 		dirCache = repository.readDirCache();
+		UntrackedCache untrackedCache = getUntrackedCache();
+		FsMonitor fsMonitor = null;
+		boolean fsMonitorChanged = false;
+		if (initialWorkingTreeIterator.getRepository() == repository) {
+			fsMonitor = FsMonitor.get(repository);
+			if (fsMonitor != null) {
+				fsMonitorChanged = dirCache.refreshFsMonitor(fsMonitor);
+			}
+		}
 
 		try (TreeWalk treeWalk = new TreeWalk(repository)) {
 			treeWalk.setOperationType(OperationType.CHECKIN_OP);
@@ -470,6 +482,7 @@ public boolean diff(ProgressMonitor monitor, int estWorkTreeSize,
 			treeWalk.addTree(new DirCacheIterator(dirCache));
 			treeWalk.addTree(initialWorkingTreeIterator);
 			initialWorkingTreeIterator.setDirCacheIterator(treeWalk, 1);
+			initialWorkingTreeIterator.setUntrackedCache(untrackedCache);
 			Collection<TreeFilter> filters = new ArrayList<>(4);
 
 			if (monitor != null) {
@@ -559,8 +572,9 @@ public boolean diff(ProgressMonitor monitor, int estWorkTreeSize,
 							}
 						}
 					} else {
-						if (workingTreeIterator.isModified(
-								dirCacheIterator.getDirCacheEntry(), true,
+						DirCacheEntry dirCacheEntry = dirCacheIterator
+								.getDirCacheEntry();
+						if (workingTreeIterator.isModified(dirCacheEntry, true,
 								treeWalk.getObjectReader())) {
 							// in index, in workdir, content differs => modified
 							if (!isEntryGitLink(dirCacheIterator)
@@ -568,6 +582,13 @@ public boolean diff(ProgressMonitor monitor, int estWorkTreeSize,
 									|| (ignoreSubmoduleMode != IgnoreSubmoduleMode.ALL
 											&& ignoreSubmoduleMode != IgnoreSubmoduleMode.DIRTY))
 								modified.add(treeWalk.getPathString());
+						} else if (fsMonitor != null
+								&& !dirCacheEntry.isFsMonitorValid()
+								&& !isEntryGitLink(dirCacheIterator)) {
+							// Changes to submodules are not reported by the
+							// monitor of this working tree.
+							dirCacheEntry.setFsMonitorValid(true);
+							fsMonitorChanged = true;
 						}
 					}
 				}
@@ -581,6 +602,15 @@ public boolean diff(ProgressMonitor monitor, int estWorkTreeSize,
 			}
 		}
 
+		// Only a complete walk recorded all untracked files.
+		if (monitor == null || !monitor.isCancelled()) {
+			if (untrackedCache != null && untrackedCache.isChanged()) {
+				dirCache.writeUntrackedCache(untrackedCache);
+			} else if (fsMonitorChanged) {
+				dirCache.writeIfUnmodified();
+			}
+		}
+
 		if (ignoreSubmoduleMode != IgnoreSubmoduleMode.ALL) {
 			try (SubmoduleWalk smw = new SubmoduleWalk(repository)) {
 				smw.setTree(new DirCacheIterator(dirCache));
@@ -670,6 +700,40 @@ public boolean diff(ProgressMonitor monitor, int estWorkTreeSize,
 		return true;
 	}
 
+	/**
+	 * Get the untracked cache to use for the diff, as configured by
+	 * {@code core.untrackedCache}.
+	 * <p>
+	 * Like in C Git, {@code true} adds an untracked cache to the index,
+	 * {@code false} removes it, and by default an existing one is used. The
+	 * cache can only be updated by a diff of the whole working tree.
+	 */
+	private UntrackedCache getUntrackedCache() throws IOException {
+		UntrackedCache cache = dirCache.getUntrackedCache();
+		Boolean enabled = StringUtils.toBooleanOrNull(
+				repository.getConfig().getString(
+						ConfigConstants.CONFIG_CORE_SECTION, null,
+						ConfigConstants.CONFIG_KEY_UNTRACKED_CACHE));
+		if (Boolean.FALSE.equals(enabled)) {
+			if (cache != null) {
+				dirCache.writeUntrackedCache(null);
+			}
+			return null;
+		}
+		if (filter != null
+				|| initialWorkingTreeIterator.getRepository() != repository) {
+			return null;
+		}
+		if (cache == null) {
+			if (!Boolean.TRUE.equals(enabled)) {
+				return null;
+			}
+			cache = new UntrackedCache();
+		}
+		cache.prepare(repository);
+		return cache;
+	}
+
 	private boolean hasFiles(File directory) {
 		try (DirectoryStream<java.nio.file.Path> dir = Files
 				.newDirectoryStream(directory.toPath())) {
@@ -136,11 +136,13 @@ public void writePackedRefs() throws IOException {
 		}
 
 		final StringWriter w = new StringWriter();
+		w.write(RefDirectory.PACKED_REFS_HEADER);
 		if (peeled) {
-			w.write(RefDirectory.PACKED_REFS_HEADER);
 			w.write(RefDirectory.PACKED_REFS_PEELED);
-			w.write('\n');
 		}
+		// The references are always written sorted by name.
+		w.write(RefDirectory.PACKED_REFS_SORTED);
+		w.write('\n');
 
 		final char[] tmp = new char[Constants.OBJECT_ID_STRING_LENGTH];
 		for (Ref r : refs) {
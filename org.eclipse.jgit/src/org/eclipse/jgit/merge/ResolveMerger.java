@@ -55,6 +55,7 @@
 import org.eclipse.jgit.dircache.DirCacheCheckout.CheckoutMetadata;
 import org.eclipse.jgit.dircache.DirCacheCheckout.StreamSupplier;
 import org.eclipse.jgit.dircache.DirCacheEntry;
+import org.eclipse.jgit.dircache.SparseCheckout;
 import org.eclipse.jgit.errors.BinaryBlobException;
 import org.eclipse.jgit.errors.IndexWriteException;
 import org.eclipse.jgit.errors.NoWorkTreeException;
@@ -216,6 +217,12 @@ public List<String> getModifiedFiles() {
 		 */
 		private Checkout checkout;
 
+		/**
+		 * Paths checked out if {@link #inCore} is {@code false}, null if all
+		 * paths are checked out.
+		 */
+		private SparseCheckout sparse;
+
 		/**
 		 * @param repo
 		 *            the {@link Repository}.
@@ -325,10 +332,31 @@ public DirCache getLockedDirCache() throws IOException {
 			}
 			if (builder == null) {
 				builder = dirCache.builder();
+				if (!inCore) {
+					sparse = SparseCheckout.get(nonNullRepo());
+				}
 			}
 			return dirCache;
 		}
 
+		/**
+		 * Whether the file of a path is left out of the working tree because
+		 * the path is outside of the sparse checkout.
+		 * <p>
+		 * Files which are present in the working tree nevertheless are
+		 * updated as usual.
+		 *
+		 * @param path
+		 *            of the file
+		 * @return {@code true} if the file is neither present nor to be
+		 *         written; its index entry gets the skip-worktree flag
+		 * @since 6.9
+		 */
+		public boolean isOutsideSparseCheckout(String path) {
+			return sparse != null && !sparse.isIncluded(path)
+					&& !new File(nonNullRepo().getWorkTree(), path).exists();
+		}
+
 		/**
 		 * Creates a {@link DirCacheBuildIterator} for the builder of this
 		 * {@link WorkTreeUpdater}.
@@ -447,6 +475,9 @@ public Map<String, DirCacheEntry> getToBeCheckedOut() {
 		 */
 		public void deleteFile(String path, File file, EolStreamType streamType,
 				String smudgeCommand) {
+			if (isOutsideSparseCheckout(path)) {
+				return;
+			}
 			toBeDeleted.put(path, file);
 			if (file != null && file.isFile()) {
 				addCheckoutMetadata(cleanupMetadataByPath, path, streamType,
@@ -530,7 +561,9 @@ private void checkout() throws NoWorkTreeException, IOException {
 					.entrySet()) {
 				DirCacheEntry dirCacheEntry = entry.getValue();
 				String gitPath = entry.getKey();
-				if (dirCacheEntry.getFileMode() == FileMode.GITLINK) {
+				if (isOutsideSparseCheckout(gitPath)) {
+					dirCacheEntry.setSkipWorkTree(true);
+				} else if (dirCacheEntry.getFileMode() == FileMode.GITLINK) {
 					checkout.checkoutGitlink(dirCacheEntry, gitPath);
 				} else {
 					checkout.checkout(dirCacheEntry,
@@ -976,8 +1009,12 @@ private DirCacheEntry addConflict(CanonicalTreeParser base,
 	 * @return the entry which was added to the index
 	 */
 	private DirCacheEntry keep(DirCacheEntry e) {
-		return workTreeUpdater.addExistingToIndex(e.getObjectId(), e.getRawPath(), e.getFileMode(),
+		DirCacheEntry kept = workTreeUpdater.addExistingToIndex(e.getObjectId(), e.getRawPath(), e.getFileMode(),
 				e.getStage(), e.getLastModifiedInstant(), e.getLength());
+		if (e.isSkipWorkTree()) {
+			kept.setSkipWorkTree(true);
+		}
+		return kept;
 	}
 
 	/**
@@ -1558,7 +1595,11 @@ private void updateIndex(CanonicalTreeParser base,
 		TemporaryBuffer rawMerged = null;
 		try {
 			rawMerged = doMerge(result);
-			File mergedFile = inCore ? null
+			// Clean merges outside of a sparse checkout only go to the index.
+			boolean skipWorkTree = !result.containsConflicts()
+					&& workTreeUpdater
+							.isOutsideSparseCheckout(tw.getPathString());
+			File mergedFile = inCore || skipWorkTree ? null
 					: writeMergedFile(rawMerged, attributes);
 			if (result.containsConflicts()) {
 				// A conflict occurred, the file will contain conflict markers
@@ -1579,11 +1620,15 @@ private void updateIndex(CanonicalTreeParser base,
 					tw.getRawMode(2));
 			FileMode mode = newMode == FileMode.MISSING.getBits()
 					? FileMode.REGULAR_FILE : FileMode.fromBits(newMode);
-			workTreeUpdater.insertToIndex(rawMerged.openInputStream(),
+			DirCacheEntry merged = workTreeUpdater.insertToIndex(
+					rawMerged.openInputStream(),
 					tw.getPathString().getBytes(UTF_8), mode,
 					DirCacheEntry.STAGE_0, lastModified,
 					(int) rawMerged.length(),
 					attributes.get(Constants.ATTR_MERGE));
+			if (skipWorkTree) {
+				merged.setSkipWorkTree(true);
+			}
 		} finally {
 			if (rawMerged != null) {
 				rawMerged.destroy();
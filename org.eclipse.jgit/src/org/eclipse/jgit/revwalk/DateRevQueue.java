@@ -36,18 +36,37 @@ public class DateRevQueue extends AbstractRevQueue {
 
 	private int last = -1;
 
+	private final boolean byCorrectedDate;
+
 	/** Create an empty date queue. */
 	public DateRevQueue() {
 		super(false);
+		byCorrectedDate = false;
 	}
 
 	DateRevQueue(boolean firstParent) {
+		this(firstParent, false);
+	}
+
+	/**
+	 * Create an empty date queue.
+	 *
+	 * @param firstParent
+	 *            whether only first parents are walked
+	 * @param byCorrectedDate
+	 *            order commits from the commit-graph by their corrected commit
+	 *            date instead of their commit time. Parents are then never
+	 *            returned before their children, even with clock skew.
+	 */
+	DateRevQueue(boolean firstParent, boolean byCorrectedDate) {
 		super(firstParent);
+		this.byCorrectedDate = byCorrectedDate;
 	}
 
 	DateRevQueue(Generator s) throws MissingObjectException,
 			IncorrectObjectTypeException, IOException {
 		super(s.firstParent);
+		byCorrectedDate = false;
 		for (;;) {
 			final RevCommit c = s.next();
 			if (c == null)
@@ -64,13 +83,13 @@ public void add(RevCommit c) {
 			buildIndex();
 
 		Entry q = head;
-		final long when = c.commitTime;
+		final long when = when(c);
 
-		if (first <= last && index[first].commit.commitTime > when) {
+		if (first <= last && index[first].when > when) {
 			int low = first, high = last;
 			while (low <= high) {
 				int mid = (low + high) >>> 1;
-				int t = index[mid].commit.commitTime;
+				long t = index[mid].when;
 				if (t < when)
 					high = mid - 1;
 				else if (t > when)
@@ -81,18 +100,18 @@ else if (t > when)
 				}
 			}
 			low = Math.min(low, high);
-			while (low > first && when == index[low].commit.commitTime)
+			while (low > first && when == index[low].when)
 				--low;
 			q = index[low];
 		}
 
-		final Entry n = newEntry(c);
-		if (q == null || (q == head && when > q.commit.commitTime)) {
+		final Entry n = newEntry(c, when);
+		if (q == null || (q == head && when > q.when)) {
 			n.next = q;
 			head = n;
 		} else {
 			Entry p = q.next;
-			while (p != null && p.commit.commitTime >= when) {
+			while (p != null && p.when >= when) {
 				q = p;
 				p = q.next;
 			}
@@ -178,13 +197,23 @@ public String toString() {
 		return s.toString();
 	}
 
-	private Entry newEntry(RevCommit c) {
+	private long when(RevCommit c) {
+		if (byCorrectedDate) {
+			// The corrected commit date is never smaller than the commit
+			// time, and unknown for commits not in the commit-graph.
+			return Math.max(c.commitTime, c.getCorrectedCommitDate());
+		}
+		return c.commitTime;
+	}
+
+	private Entry newEntry(RevCommit c, long when) {
 		Entry r = free;
 		if (r == null)
 			r = new Entry();
 		else
 			free = r.next;
 		r.commit = c;
+		r.when = when;
 		return r;
 	}
 
@@ -197,5 +226,7 @@ static class Entry {
 		Entry next;
 
 		RevCommit commit;
+
+		long when;
 	}
 }
@@ -43,6 +43,8 @@ class MergeBaseGenerator extends Generator {
 	private final RevWalk walker;
 	private final DateRevQueue pending;
 
+	private final RevCommit cutoff;
+
 	private int branchMask;
 	private int recarryTest;
 	private int recarryMask;
@@ -54,7 +56,8 @@ class MergeBaseGenerator extends Generator {
 	MergeBaseGenerator(RevWalk w) {
 		super(w.isFirstParent());
 		walker = w;
-		pending = new DateRevQueue(firstParent);
+		pending = new DateRevQueue(firstParent, true);
+		cutoff = w.mergeBaseCutoff;
 	}
 
 	void init(AbstractRevQueue p) throws IOException {
@@ -114,6 +117,13 @@ private RevCommit _next() throws MissingObjectException,
 				return null;
 			}
 
+			if (cutoff != null && RevWalk.isBelowGeneration(c, cutoff)) {
+				// Only merge bases which may reach the cutoff commit are
+				// asked for, and neither this commit nor its ancestors can.
+				c.flags |= POPPED;
+				continue;
+			}
+
 			for (RevCommit p : c.getParents()) {
 				if ((p.flags & IN_PENDING) != 0)
 					continue;
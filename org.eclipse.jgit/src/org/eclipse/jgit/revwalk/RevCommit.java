@@ -636,6 +636,23 @@ int getGeneration() {
 		return Constants.COMMIT_GENERATION_UNKNOWN;
 	}
 
+	/**
+	 * Get the corrected commit date of the commit, as defined in
+	 * {@link org.eclipse.jgit.internal.storage.commitgraph.CommitGraph.CommitData#getCorrectedCommitDate()}
+	 * <p>
+	 * Like the generation number, the corrected commit date of a commit is
+	 * always larger than the ones of its parents, but it stays close to the
+	 * commit time, so that it cuts walks shorter.
+	 *
+	 * @return the corrected commit date, or
+	 *         {@link org.eclipse.jgit.lib.Constants#COMMIT_GENERATION_NOT_COMPUTED}
+	 *         if the commit is not in the commit-graph or the commit-graph has
+	 *         no generation data
+	 */
+	long getCorrectedCommitDate() {
+		return Constants.COMMIT_GENERATION_NOT_COMPUTED;
+	}
+
 	/**
 	 * Get the changed path filter of the commit.
 	 * <p>
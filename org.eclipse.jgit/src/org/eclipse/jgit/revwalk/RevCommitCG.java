@@ -32,6 +32,8 @@ class RevCommitCG extends RevCommit {
 
 	private int generation = Constants.COMMIT_GENERATION_UNKNOWN;
 
+	private long correctedCommitDate = Constants.COMMIT_GENERATION_NOT_COMPUTED;
+
 	/**
 	 * Create a new commit reference.
 	 *
@@ -79,6 +81,7 @@ private void parseInGraph(RevWalk walk) throws IOException {
 		this.tree = walk.lookupTree(data.getTree());
 		this.commitTime = (int) data.getCommitTime();
 		this.generation = data.getGeneration();
+		this.correctedCommitDate = data.getCorrectedCommitDate();
 
 		if (getParents() == null) {
 			int[] pGraphList = data.getParents();
@@ -102,6 +105,11 @@ int getGeneration() {
 		return generation;
 	}
 
+	@Override
+	long getCorrectedCommitDate() {
+		return correctedCommitDate;
+	}
+
 	/** {@inheritDoc} */
 	@Override
 	public ChangedPathFilter getChangedPathFilter(RevWalk rw) {
@@ -202,6 +202,12 @@ public class RevWalk implements Iterable<RevCommit>, AutoCloseable {
 
 	boolean shallowCommitsInitialized;
 
+	/**
+	 * Commit whose ancestors the {@link MergeBaseGenerator} does not need to
+	 * walk, as they cannot reach it; null to walk all.
+	 */
+	RevCommit mergeBaseCutoff;
+
 	private enum GetMergedIntoStrategy {
 		RETURN_ON_FIRST_FOUND, RETURN_ON_FIRST_NOT_FOUND, EVALUATE_ALL
 	}
@@ -431,8 +437,12 @@ public boolean isMergedInto(RevCommit base, RevCommit tip)
 		try {
 			finishDelayedFreeFlags();
 			reset(~freeFlags & APP_FLAGS);
+			if (cannotReach(tip, base)) {
+				return false;
+			}
 			filter = RevFilter.MERGE_BASE;
 			treeFilter = TreeFilter.ALL;
+			mergeBaseCutoff = base;
 			markStart(tip);
 			markStart(base);
 			RevCommit mergeBase;
@@ -445,7 +455,52 @@ public boolean isMergedInto(RevCommit base, RevCommit tip)
 		} finally {
 			filter = oldRF;
 			treeFilter = oldTF;
+			mergeBaseCutoff = null;
+		}
+	}
+
+	/**
+	 * Determine if the commit-graph proves that a commit cannot reach another
+	 * commit.
+	 * <p>
+	 * A commit can only reach commits with a smaller generation number. This
+	 * compares the corrected commit dates of the commits if both are known,
+	 * and their topological generation numbers otherwise. Both are only known
+	 * for commits in the commit-graph.
+	 *
+	 * @param from
+	 *            commit to start from
+	 * @param to
+	 *            commit to reach
+	 * @return true if {@code from} cannot reach {@code to}; false if it may
+	 *         reach it
+	 * @throws java.io.IOException
+	 *             a pack file or loose object could not be read.
+	 * @since 6.9
+	 */
+	public boolean cannotReach(RevCommit from, RevCommit to)
+			throws IOException {
+		if ((from.flags & PARSED) == 0) {
+			from.parseHeaders(this);
+		}
+		if ((to.flags & PARSED) == 0) {
+			to.parseHeaders(this);
+		}
+		return isBelowGeneration(from, to);
+	}
+
+	static boolean isBelowGeneration(RevCommit c, RevCommit target) {
+		long date = c.getCorrectedCommitDate();
+		long targetDate = target.getCorrectedCommitDate();
+		if (date != Constants.COMMIT_GENERATION_NOT_COMPUTED
+				&& targetDate != Constants.COMMIT_GENERATION_NOT_COMPUTED) {
+			return date < targetDate;
 		}
+		int generation = c.getGeneration();
+		int targetGeneration = target.getGeneration();
+		return generation != Constants.COMMIT_GENERATION_NOT_COMPUTED
+				&& targetGeneration != Constants.COMMIT_GENERATION_NOT_COMPUTED
+				&& generation < targetGeneration;
 	}
 
 	/**
@@ -552,7 +607,6 @@ private List<Ref> getMergedInto(RevCommit needle, Collection<Ref> haystacks,
 			if ((needle.flags & PARSED) == 0) {
 				needle.parseHeaders(this);
 			}
-			int cutoff = needle.getGeneration();
 			for (Ref r : haystacks) {
 				if (monitor.isCancelled()) {
 					return result;
@@ -568,7 +622,7 @@ private List<Ref> getMergedInto(RevCommit needle, Collection<Ref> haystacks,
 				boolean commitFound = false;
 				RevCommit next;
 				while ((next = next()) != null) {
-					if (next.getGeneration() < cutoff) {
+					if (isBelowGeneration(next, needle)) {
 						markUninteresting(next);
 						uninteresting.add(next);
 					}
@@ -13,6 +13,7 @@
 
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_CORE_SECTION;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_BIGFILE_THRESHOLD;
+import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_ALLOW_PACK_REUSE;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_BITMAP_CONTIGUOUS_COMMIT_COUNT;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_BITMAP_DISTANT_COMMIT_SPAN;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_BITMAP_EXCESSIVE_BRANCH_COUNT;
@@ -27,6 +28,7 @@
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_DELTA_COMPRESSION;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_DEPTH;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_INDEXVERSION;
+import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_ISLAND;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_MIN_BYTES_OBJ_SIZE_INDEX;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_MIN_SIZE_PREVENT_RACYPACK;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_PACK_KEPT_OBJECTS;
@@ -37,6 +39,7 @@
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_SEARCH_FOR_REUSE_TIMEOUT;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_SINGLE_PACK;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_THREADS;
+import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_USE_DELTA_ISLANDS;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_WAIT_PREVENT_RACYPACK;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_WINDOW;
 import static org.eclipse.jgit.lib.ConfigConstants.CONFIG_KEY_WINDOW_MEMORY;
@@ -258,6 +261,23 @@ public class PackConfig {
 	 */
 	public static final String[] DEFAULT_BITMAP_EXCLUDED_REFS_PREFIXES = new String[0];
 
+	/**
+	 * Default setting of whether repacking honors delta islands: {@value}
+	 *
+	 * @see #setUseDeltaIslands(boolean)
+	 * @since 6.9
+	 */
+	public static final boolean DEFAULT_USE_DELTA_ISLANDS = false;
+
+	/**
+	 * Default setting of whether objects may be copied from a part of a pack
+	 * with bitmap index: {@value}
+	 *
+	 * @see #setPartialPackReuse(boolean)
+	 * @since 6.9
+	 */
+	public static final boolean DEFAULT_PARTIAL_PACK_REUSE = true;
+
 	/**
 	 * Default minimum size for an object to be included in the size index:
 	 * {@value}
@@ -340,6 +360,12 @@ public class PackConfig {
 
 	private boolean singlePack;
 
+	private String[] deltaIslands = new String[0];
+
+	private boolean useDeltaIslands = DEFAULT_USE_DELTA_ISLANDS;
+
+	private boolean partialPackReuse = DEFAULT_PARTIAL_PACK_REUSE;
+
 	private int minBytesForObjSizeIndex = DEFAULT_MIN_BYTES_FOR_OBJ_SIZE_INDEX;
 
 	/**
@@ -410,6 +436,9 @@ public PackConfig(PackConfig cfg) {
 		this.bitmapInactiveBranchAgeInDays = cfg.bitmapInactiveBranchAgeInDays;
 		this.cutDeltaChains = cfg.cutDeltaChains;
 		this.singlePack = cfg.singlePack;
+		this.deltaIslands = cfg.deltaIslands;
+		this.useDeltaIslands = cfg.useDeltaIslands;
+		this.partialPackReuse = cfg.partialPackReuse;
 		this.searchForReuseTimeout = cfg.searchForReuseTimeout;
 		this.minBytesForObjSizeIndex = cfg.minBytesForObjSizeIndex;
 	}
@@ -675,6 +704,102 @@ public void setSinglePack(boolean single) {
 		singlePack = single;
 	}
 
+	/**
+	 * Get the regular expressions grouping references into delta islands.
+	 *
+	 * @return the regular expressions matched against reference names. Empty
+	 *         by default.
+	 * @see #setDeltaIslands(String[])
+	 * @since 6.9
+	 */
+	public String[] getDeltaIslands() {
+		return deltaIslands;
+	}
+
+	/**
+	 * Set the regular expressions grouping references into delta islands.
+	 * <p>
+	 * Every reference whose name is matched by one of the expressions belongs
+	 * to an island, and objects belong to the islands of all references they
+	 * are reachable from. An object is only stored as delta against a base
+	 * which belongs to all of the object's islands, so packs sent for the
+	 * references of any island can reuse the stored deltas.
+	 * <p>
+	 * The island of a reference is named by the capturing groups of the last
+	 * expression matching its name, joined by {@code '-'}. References with the
+	 * same name belong to the same island. Expressions without capturing
+	 * groups put all references they match into a single island.
+	 *
+	 * @param regexes
+	 *            the regular expressions matched against reference names
+	 * @see #setUseDeltaIslands(boolean)
+	 * @since 6.9
+	 */
+	public void setDeltaIslands(String[] regexes) {
+		deltaIslands = regexes;
+	}
+
+	/**
+	 * Whether garbage collection restricts deltas to delta islands.
+	 *
+	 * Default setting: {@value #DEFAULT_USE_DELTA_ISLANDS}
+	 *
+	 * @return true if garbage collection honors the delta islands configured
+	 *         by {@link #setDeltaIslands(String[])}
+	 * @since 6.9
+	 */
+	public boolean isUseDeltaIslands() {
+		return useDeltaIslands;
+	}
+
+	/**
+	 * Set whether garbage collection restricts deltas to delta islands.
+	 *
+	 * Default setting: {@value #DEFAULT_USE_DELTA_ISLANDS}
+	 *
+	 * @param use
+	 *            true to honor the delta islands configured by
+	 *            {@link #setDeltaIslands(String[])}
+	 * @since 6.9
+	 */
+	public void setUseDeltaIslands(boolean use) {
+		useDeltaIslands = use;
+	}
+
+	/**
+	 * Whether objects may be copied from a part of a pack with bitmap index.
+	 *
+	 * Default setting: {@value #DEFAULT_PARTIAL_PACK_REUSE}
+	 *
+	 * @return true if objects may be copied from a part of a pack with bitmap
+	 *         index as they are
+	 * @since 6.9
+	 */
+	public boolean isPartialPackReuse() {
+		return partialPackReuse;
+	}
+
+	/**
+	 * Set whether objects may be copied from a part of a pack with bitmap
+	 * index.
+	 * <p>
+	 * When sending objects found by bitmaps, the objects of the pack with
+	 * bitmap index which the receiver needs are copied from the pack in one
+	 * go, without selecting a representation for each of them. Objects stored
+	 * as delta against a base the receiver does not need are sent the usual
+	 * way. This only applies if cached packs may be used, see
+	 * {@link org.eclipse.jgit.internal.storage.pack.PackWriter#setUseCachedPacks(boolean)}.
+	 *
+	 * Default setting: {@value #DEFAULT_PARTIAL_PACK_REUSE}
+	 *
+	 * @param reuse
+	 *            true to copy objects from a part of a pack as they are
+	 * @since 6.9
+	 */
+	public void setPartialPackReuse(boolean reuse) {
+		partialPackReuse = reuse;
+	}
+
 	/**
 	 * Get the number of objects to try when looking for a delta base.
 	 *
@@ -1415,6 +1540,15 @@ public void fromConfig(Config rc) {
 				CONFIG_KEY_PRESERVE_OLD_PACKS, DEFAULT_PRESERVE_OLD_PACKS));
 		setPrunePreserved(rc.getBoolean(CONFIG_PACK_SECTION,
 				CONFIG_KEY_PRUNE_PRESERVED, DEFAULT_PRUNE_PRESERVED));
+		String[] islands = rc.getStringList(CONFIG_PACK_SECTION, null,
+				CONFIG_KEY_ISLAND);
+		if (islands.length > 0) {
+			setDeltaIslands(islands);
+		}
+		setUseDeltaIslands(rc.getBoolean(CONFIG_REPACK_SECTION,
+				CONFIG_KEY_USE_DELTA_ISLANDS, isUseDeltaIslands()));
+		setPartialPackReuse(rc.getBoolean(CONFIG_PACK_SECTION,
+				CONFIG_KEY_ALLOW_PACK_REUSE, isPartialPackReuse()));
 	}
 
 	@Override
@@ -1452,6 +1586,8 @@ public String toString() {
 		b.append(", singlePack=").append(getSinglePack()); //$NON-NLS-1$
 		b.append(", minBytesForObjSizeIndex=") //$NON-NLS-1$
 				.append(getMinBytesForObjSizeIndex());
+		b.append(", useDeltaIslands=").append(isUseDeltaIslands()); //$NON-NLS-1$
+		b.append(", partialPackReuse=").append(isPartialPackReuse()); //$NON-NLS-1$
 		return b.toString();
 	}
 }
@@ -313,6 +313,22 @@ public static class Accumulator {
 		 */
 		public long offloadedPackfileSize;
 
+		/**
+		 * Total size (in bytes) of the existing pack files whose objects were
+		 * rewritten into this pack by a repack.
+		 *
+		 * @since 6.9
+		 */
+		public long rewrittenPackBytes;
+
+		/**
+		 * Total size (in bytes) of the existing pack files which a repack left
+		 * in place instead of rewriting them.
+		 *
+		 * @since 6.9
+		 */
+		public long reusedPackBytes;
+
 		/**
 		 * Statistics about each object type in the pack (commits, tags, trees
 		 * and blobs.)
@@ -684,6 +700,29 @@ public long getOffloadedPackfilesSize() {
 		return statistics.offloadedPackfileSize;
 	}
 
+	/**
+	 * Get total size (in bytes) of the existing pack files rewritten into
+	 * this pack
+	 *
+	 * @return total size (in bytes) of the existing pack files whose objects
+	 *         were rewritten into this pack by a repack.
+	 * @since 6.9
+	 */
+	public long getRewrittenPackBytes() {
+		return statistics.rewrittenPackBytes;
+	}
+
+	/**
+	 * Get total size (in bytes) of the existing pack files left in place
+	 *
+	 * @return total size (in bytes) of the existing pack files which a repack
+	 *         left in place instead of rewriting them.
+	 * @since 6.9
+	 */
+	public long getReusedPackBytes() {
+		return statistics.reusedPackBytes;
+	}
+
 	/**
 	 * Get total time spent processing this pack.
 	 *
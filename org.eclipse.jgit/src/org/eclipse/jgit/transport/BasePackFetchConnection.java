@@ -29,6 +29,7 @@
 import java.io.OutputStream;
 import java.text.MessageFormat;
 import java.time.Instant;
+import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.Collection;
 import java.util.Collections;
@@ -41,12 +42,14 @@
 import java.util.Set;
 import java.util.stream.Collectors;
 
+import org.eclipse.jgit.annotations.Nullable;
 import org.eclipse.jgit.errors.PackProtocolException;
 import org.eclipse.jgit.errors.RemoteRepositoryException;
 import org.eclipse.jgit.errors.TransportException;
 import org.eclipse.jgit.internal.JGitText;
 import org.eclipse.jgit.lib.AnyObjectId;
 import org.eclipse.jgit.lib.Config;
+import org.eclipse.jgit.lib.ConfigConstants;
 import org.eclipse.jgit.lib.MutableObjectId;
 import org.eclipse.jgit.lib.NullProgressMonitor;
 import org.eclipse.jgit.lib.ObjectDatabase;
@@ -220,6 +223,17 @@ public abstract class BasePackFetchConnection extends BasePackConnection
 
 	private boolean useNegotiationTip;
 
+	private final NegotiationAlgorithm negotiationAlgorithm;
+
+	/** Source of the "have" lines of {@link NegotiationAlgorithm#SKIPPING}. */
+	private SkippingNegotiator skipping;
+
+	/** Number of requests sent to negotiate the common commits. */
+	private int roundTrips;
+
+	/** Commits acknowledged by the remote, collected by negotiateCommon. */
+	private Set<ObjectId> acknowledged;
+
 	private boolean noDone;
 
 	private boolean noProgress;
@@ -251,6 +265,9 @@ public abstract class BasePackFetchConnection extends BasePackConnection
 	 */
 	private final FilterSpec filterSpec;
 
+	/** Whether received packs are marked as promisor packs. */
+	private final boolean promisor;
+
 	/**
 	 * Create a new connection to fetch using the native git transport.
 	 *
@@ -260,20 +277,28 @@ public abstract class BasePackFetchConnection extends BasePackConnection
 	public BasePackFetchConnection(PackTransport packTransport) {
 		super(packTransport);
 
+		NegotiationAlgorithm algorithm = transport.getNegotiationAlgorithm();
 		if (local != null) {
 			final FetchConfig cfg = getFetchConfig();
 			allowOfsDelta = cfg.allowOfsDelta;
 			maxHaves = cfg.maxHaves;
 			useNegotiationTip = cfg.useNegotiationTip;
+			if (algorithm == null) {
+				algorithm = cfg.negotiationAlgorithm;
+			}
 		} else {
 			allowOfsDelta = true;
 			maxHaves = Integer.MAX_VALUE;
 			useNegotiationTip = false;
 		}
+		negotiationAlgorithm = algorithm != null ? algorithm
+				: NegotiationAlgorithm.CONSECUTIVE;
 
 		includeTags = transport.getTagOpt() != TagOpt.NO_TAGS;
-		thinPack = transport.isFetchThin();
 		filterSpec = transport.getFilterSpec();
+		promisor = !filterSpec.isNoOp() || transport.isPromisorRemote();
+		// Thin packs of a partial clone may use missing objects as bases.
+		thinPack = transport.isFetchThin() && !promisor;
 		depth = transport.getDepth();
 		deepenSince = transport.getDeepenSince();
 		deepenNots = transport.getDeepenNots();
@@ -306,11 +331,17 @@ static class FetchConfig {
 
 		final boolean useNegotiationTip;
 
+		final NegotiationAlgorithm negotiationAlgorithm;
+
 		FetchConfig(Config c) {
 			allowOfsDelta = c.getBoolean("repack", "usedeltabaseoffset", true); //$NON-NLS-1$ //$NON-NLS-2$
 			maxHaves = c.getInt("fetch", "maxhaves", Integer.MAX_VALUE); //$NON-NLS-1$ //$NON-NLS-2$
 			useNegotiationTip = c.getBoolean("fetch", "usenegotiationtip", //$NON-NLS-1$ //$NON-NLS-2$
 					false);
+			negotiationAlgorithm = c.getEnum(
+					ConfigConstants.CONFIG_FETCH_SECTION, null,
+					ConfigConstants.CONFIG_KEY_NEGOTIATION_ALGORITHM,
+					NegotiationAlgorithm.CONSECUTIVE);
 		}
 
 		FetchConfig(boolean allowOfsDelta, int maxHaves) {
@@ -333,6 +364,7 @@ static class FetchConfig {
 			this.allowOfsDelta = allowOfsDelta;
 			this.maxHaves = maxHaves;
 			this.useNegotiationTip = useNegotiationTip;
+			this.negotiationAlgorithm = NegotiationAlgorithm.CONSECUTIVE;
 		}
 	}
 
@@ -361,6 +393,11 @@ public boolean didFetchTestConnectivity() {
 		return false;
 	}
 
+	@Override
+	public int getNegotiationRoundTrips() {
+		return roundTrips;
+	}
+
 	@Override
 	public void setPackLockMessage(String message) {
 		lockMessage = message;
@@ -376,6 +413,7 @@ public Collection<PackLock> getPackLocks() {
 	private void clearState() {
 		walk.dispose();
 		reachableCommits = null;
+		skipping = null;
 		state = null;
 		pckState = null;
 	}
@@ -403,13 +441,16 @@ protected void doFetch(final ProgressMonitor monitor,
 			final Collection<Ref> want, final Set<ObjectId> have,
 			OutputStream outputStream) throws TransportException {
 		boolean hasObjects = !have.isEmpty();
+		roundTrips = 0;
 		try {
 			noProgress = monitor == NullProgressMonitor.INSTANCE;
 
 			if (hasObjects) {
 				markRefsAdvertised();
 			}
-			markReachable(want, have, maxTimeWanted(want, hasObjects));
+			if (negotiationAlgorithm != NegotiationAlgorithm.NOOP) {
+				markReachable(want, have, maxTimeWanted(want, hasObjects));
+			}
 
 			if (TransferConfig.ProtocolVersion.V2
 					.equals(getProtocolVersion())) {
@@ -465,18 +506,7 @@ private void doFetchV2(ProgressMonitor monitor, Collection<Ref> want,
 		sideband = true;
 		negotiateBegin();
 
-		pckState.writeString("command=" + GitProtocolConstants.COMMAND_FETCH); //$NON-NLS-1$
-		// Capabilities are sent as command arguments in protocol V2
-		String agent = UserAgent.get();
-		if (agent != null && isCapableOf(GitProtocolConstants.OPTION_AGENT)) {
-			pckState.writeString(
-					GitProtocolConstants.OPTION_AGENT + '=' + agent);
-		}
-		Set<String> capabilities = new HashSet<>();
-		String advertised = getCapability(GitProtocolConstants.COMMAND_FETCH);
-		if (!StringUtils.isEmptyOrNull(advertised)) {
-			capabilities.addAll(Arrays.asList(advertised.split("\\s+"))); //$NON-NLS-1$
-		}
+		Set<String> capabilities = writeFetchCommandV2();
 		// Arguments
 		pckState.writeDelim();
 		for (String capability : getCapabilitiesV2(capabilities)) {
@@ -503,6 +533,7 @@ private void doFetchV2(ProgressMonitor monitor, Collection<Ref> want,
 			// The "state" buffer contains the full fetch request with all
 			// common objects found so far.
 			state.writeTo(out, monitor);
+			roundTrips++;
 			sentDone = sendNextHaveBatch(fetchState, pckOut, monitor);
 			if (sentDone) {
 				break;
@@ -545,6 +576,157 @@ private void doFetchV2(ProgressMonitor monitor, Collection<Ref> want,
 		receivePack(monitor, outputStream);
 	}
 
+	/**
+	 * Writes the V2 fetch command to the "state" buffer.
+	 *
+	 * @return the arguments of the fetch command supported by the remote
+	 * @throws IOException
+	 *             on errors
+	 */
+	private Set<String> writeFetchCommandV2() throws IOException {
+		pckState.writeString("command=" + GitProtocolConstants.COMMAND_FETCH); //$NON-NLS-1$
+		// Capabilities are sent as command arguments in protocol V2
+		String agent = UserAgent.get();
+		if (agent != null && isCapableOf(GitProtocolConstants.OPTION_AGENT)) {
+			pckState.writeString(
+					GitProtocolConstants.OPTION_AGENT + '=' + agent);
+		}
+		Set<String> capabilities = new HashSet<>();
+		String advertised = getCapability(GitProtocolConstants.COMMAND_FETCH);
+		if (!StringUtils.isEmptyOrNull(advertised)) {
+			capabilities.addAll(Arrays.asList(advertised.split("\\s+"))); //$NON-NLS-1$
+		}
+		return capabilities;
+	}
+
+	/**
+	 * Ask the remote for the bundles clients may fetch before fetching from
+	 * the remote, using the protocol V2 "bundle-uri" command.
+	 * <p>
+	 * Unlike a fetch, this does not count as the operation of the
+	 * connection: {@link #fetch} may still be called afterwards.
+	 *
+	 * @return the bundle list, or {@code null} if the remote does not support
+	 *         the "bundle-uri" command
+	 * @throws TransportException
+	 *             if the command could not be run or its output not be read
+	 */
+	@Nullable
+	BundleList getBundleList() throws TransportException {
+		if (!TransferConfig.ProtocolVersion.V2.equals(getProtocolVersion())
+				|| !isCapableOf(GitProtocolConstants.COMMAND_BUNDLE_URI)) {
+			return null;
+		}
+		try {
+			pckOut.writeString(
+					"command=" + GitProtocolConstants.COMMAND_BUNDLE_URI); //$NON-NLS-1$
+			String agent = UserAgent.get();
+			if (agent != null
+					&& isCapableOf(GitProtocolConstants.OPTION_AGENT)) {
+				pckOut.writeString(
+						GitProtocolConstants.OPTION_AGENT + '=' + agent);
+			}
+			pckOut.writeDelim();
+			pckOut.end();
+			List<String> lines = new ArrayList<>();
+			for (String line : pckIn.readStrings()) {
+				lines.add(line);
+			}
+			return BundleList.parse(lines, uri);
+		} catch (TransportException err) {
+			close();
+			throw err;
+		} catch (IOException | RuntimeException err) {
+			close();
+			throw new TransportException(err.getMessage(), err);
+		}
+	}
+
+	/**
+	 * Find the commits in the history of the given commits which the remote
+	 * has, without fetching anything.
+	 * <p>
+	 * Used by push to send only objects the remote lacks, even if the remote
+	 * does not advertise all of its references. The remote must support
+	 * protocol V2 and the "wait-for-done" argument of the fetch command.
+	 *
+	 * @param monitor
+	 *            for cancellation
+	 * @param tips
+	 *            commits whose history is negotiated
+	 * @return the commits acknowledged by the remote; empty if the remote
+	 *         does not support the negotiation
+	 * @throws TransportException
+	 *             if the negotiation failed
+	 */
+	Set<ObjectId> negotiateCommon(ProgressMonitor monitor,
+			Collection<? extends ObjectId> tips) throws TransportException {
+		if (local == null || !TransferConfig.ProtocolVersion.V2
+				.equals(getProtocolVersion())) {
+			return Collections.emptySet();
+		}
+		markStartedOperation();
+		try {
+			state = new TemporaryBuffer.Heap(Integer.MAX_VALUE);
+			pckState = new PacketLineOut(state);
+			if (!writeFetchCommandV2()
+					.contains(GitProtocolConstants.OPTION_WAIT_FOR_DONE)) {
+				return Collections.emptySet();
+			}
+			pckState.writeDelim();
+			pckState.writeString(GitProtocolConstants.OPTION_WAIT_FOR_DONE);
+			outNeedsEnd = false;
+
+			markRefsAdvertised();
+			for (ObjectId id : tips) {
+				markReachable(id);
+			}
+			negotiateBegin();
+			acknowledged = new HashSet<>();
+			FetchStateV2 fetchState = new FetchStateV2();
+			boolean last = false;
+			while (!last) {
+				List<RevCommit> haves = new ArrayList<>();
+				while (haves.size() < fetchState.havesToSend) {
+					RevCommit c = nextHave();
+					if (c == null) {
+						break;
+					}
+					haves.add(c);
+				}
+				if (haves.isEmpty()) {
+					break;
+				}
+				fetchState.havesTotal += haves.size();
+				last = (fetchState.hadAcks
+						&& fetchState.havesWithoutAck > MAX_HAVES)
+						|| fetchState.havesTotal > maxHaves;
+
+				// Unlike a fetch, never send "done": the remote would send a
+				// pack.
+				state.writeTo(out, monitor);
+				for (RevCommit c : haves) {
+					pckOut.writeString(PACKET_HAVE + c.name() + '\n');
+				}
+				pckOut.end();
+				roundTrips++;
+				fetchState.havesWithoutAck += haves.size();
+				if (readAcknowledgments(fetchState, pckIn, monitor)) {
+					break;
+				}
+				fetchState.incHavesToSend(statelessRPC);
+			}
+			return acknowledged;
+		} catch (CancelledException ce) {
+			return Collections.emptySet();
+		} catch (IOException | RuntimeException err) {
+			throw new TransportException(err.getMessage(), err);
+		} finally {
+			acknowledged = null;
+			clearState();
+		}
+	}
+
 	/**
 	 * Sends the next batch of "have"s and terminates the {@code output}.
 	 *
@@ -567,7 +749,7 @@ private boolean sendNextHaveBatch(FetchStateV2 fetchState,
 			throws IOException, CancelledException {
 		long n = 0;
 		while (n < fetchState.havesToSend) {
-			final RevCommit c = walk.next();
+			final RevCommit c = nextHave();
 			if (c == null) {
 				break;
 			}
@@ -634,6 +816,9 @@ private boolean readAcknowledgments(FetchStateV2 fetchState,
 				if (ack == AckNackResult.ACK_COMMON) {
 					// markCommon appends the object to the "state"
 					markCommon(walk.parseAny(returnedId), ack, true);
+					if (acknowledged != null) {
+						acknowledged.add(returnedId.toObjectId());
+					}
 					fetchState.havesWithoutAck = 0;
 					fetchState.hadAcks = true;
 				} else if (ack == AckNackResult.ACK_READY) {
@@ -907,7 +1092,7 @@ private void negotiate(ProgressMonitor monitor, boolean mayHaveShallow, Set<Obje
 
 		negotiateBegin();
 		SEND_HAVES: for (;;) {
-			final RevCommit c = walk.next();
+			final RevCommit c = nextHave();
 			if (c == null) {
 				break SEND_HAVES;
 			}
@@ -931,6 +1116,7 @@ private void negotiate(ProgressMonitor monitor, boolean mayHaveShallow, Set<Obje
 
 			pckOut.end();
 			resultsPending++; // Each end will cause a result to come back.
+			roundTrips++;
 
 			if (havesSent == 32 && !statelessRPC) {
 				// On the first block we race ahead and try to send
@@ -1018,6 +1204,7 @@ private void negotiate(ProgressMonitor monitor, boolean mayHaveShallow, Set<Obje
 			//
 			pckOut.writeString(PACKET_DONE + '\n');
 			pckOut.flush();
+			roundTrips++;
 		}
 
 		if (!receivedAck) {
@@ -1097,6 +1284,21 @@ public boolean requiresCommitBody() {
 				return false;
 			}
 		});
+		if (negotiationAlgorithm == NegotiationAlgorithm.SKIPPING) {
+			skipping = new SkippingNegotiator(walk, COMMON, ADVERTISED,
+					reachableCommits);
+		}
+	}
+
+	private RevCommit nextHave() throws IOException {
+		switch (negotiationAlgorithm) {
+		case NOOP:
+			return null;
+		case SKIPPING:
+			return skipping.next();
+		default:
+			return walk.next();
+		}
 	}
 
 	private void markRefsAdvertised() {
@@ -1142,6 +1344,7 @@ private void receivePack(final ProgressMonitor monitor,
 			parser.setAllowThin(thinPack);
 			parser.setObjectChecker(transport.getObjectChecker());
 			parser.setLockMessage(lockMessage);
+			parser.setPromisor(promisor);
 			packLock = parser.parse(monitor);
 			ins.flush();
 		} finally {
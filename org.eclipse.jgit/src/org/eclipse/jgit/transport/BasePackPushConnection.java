@@ -17,7 +17,9 @@
 import java.io.InputStream;
 import java.io.OutputStream;
 import java.text.MessageFormat;
+import java.util.ArrayList;
 import java.util.Collection;
+import java.util.Collections;
 import java.util.HashSet;
 import java.util.List;
 import java.util.Map;
@@ -91,6 +93,7 @@ public abstract class BasePackPushConnection extends BasePackConnection implemen
 	private final boolean thinPack;
 	private final boolean atomic;
 	private final boolean useBitmaps;
+	private final boolean negotiate;
 
 	/** A list of option strings associated with this push. */
 	private List<String> pushOptions;
@@ -105,6 +108,9 @@ public abstract class BasePackPushConnection extends BasePackConnection implemen
 	private boolean sentCommand;
 	private boolean writePack;
 
+	/** Commits the remote has, found by negotiation. */
+	private Set<ObjectId> negotiatedHaves = Collections.emptySet();
+
 	/** Time in milliseconds spent transferring the pack data. */
 	private long packTransferTime;
 
@@ -120,6 +126,7 @@ public BasePackPushConnection(PackTransport packTransport) {
 		atomic = transport.isPushAtomic();
 		pushOptions = transport.getPushOptions();
 		useBitmaps = transport.isPushUseBitmaps();
+		negotiate = transport.isPushNegotiate();
 	}
 
 	@Override
@@ -177,6 +184,9 @@ protected void doPush(final ProgressMonitor monitor,
 			final Map<String, RemoteRefUpdate> refUpdates,
 			OutputStream outputStream) throws TransportException {
 		try {
+			if (negotiate) {
+				negotiatedHaves = negotiateHaves(refUpdates.values(), monitor);
+			}
 			writeCommands(refUpdates.values(), monitor, outputStream);
 
 			if (pushOptions != null && capablePushOptions)
@@ -212,6 +222,43 @@ protected void doPush(final ProgressMonitor monitor,
 		}
 	}
 
+	/**
+	 * Find the commits the remote has in the history of the pushed commits,
+	 * running the negotiation of a fetch on a separate connection.
+	 * <p>
+	 * The remote may have commits not reachable from the references it
+	 * advertises to push, for example from hidden references. Negotiation is
+	 * an optimization only: if it fails, the pack omits only objects
+	 * reachable from the advertised references.
+	 *
+	 * @param refUpdates
+	 *            the updates to push
+	 * @param monitor
+	 *            for cancellation
+	 * @return the commits acknowledged by the remote
+	 */
+	private Set<ObjectId> negotiateHaves(
+			Collection<RemoteRefUpdate> refUpdates, ProgressMonitor monitor) {
+		List<ObjectId> tips = new ArrayList<>();
+		for (RemoteRefUpdate r : refUpdates) {
+			if (!r.isDelete()) {
+				tips.add(r.getNewObjectId());
+			}
+		}
+		if (tips.isEmpty()) {
+			return Collections.emptySet();
+		}
+		try (FetchConnection fetch = transport.openFetch()) {
+			if (fetch instanceof BasePackFetchConnection) {
+				return ((BasePackFetchConnection) fetch)
+						.negotiateCommon(monitor, tips);
+			}
+		} catch (NotSupportedException | TransportException e) {
+			// Push without the negotiated commits.
+		}
+		return Collections.emptySet();
+	}
+
 	private void writeCommands(final Collection<RemoteRefUpdate> refUpdates,
 			final ProgressMonitor monitor, OutputStream outputStream) throws IOException {
 		final String capabilities = enableCapabilities(monitor, outputStream);
@@ -312,6 +359,7 @@ private void writePack(final Map<String, RemoteRefUpdate> refUpdates,
 					remoteObjects.add(oid);
 			}
 			remoteObjects.addAll(additionalHaves);
+			remoteObjects.addAll(negotiatedHaves);
 			for (RemoteRefUpdate r : refUpdates.values()) {
 				if (!ObjectId.zeroId().equals(r.getNewObjectId()))
 					newObjects.add(r.getNewObjectId());
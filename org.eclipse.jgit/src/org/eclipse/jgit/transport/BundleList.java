@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.transport;
+
+import java.io.File;
+import java.net.URI;
+import java.net.URISyntaxException;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+
+/**
+ * List of bundles sent by a server in response to the protocol V2
+ * "bundle-uri" command.
+ * <p>
+ * The list consists of "key=value" lines using the keys of the "bundle"
+ * configuration section: {@code bundle.version}, {@code bundle.mode} and, for
+ * each bundle, {@code bundle.<id>.uri} and the optional
+ * {@code bundle.<id>.creationToken}.
+ */
+final class BundleList {
+	/** A bundle of the list. */
+	static final class Bundle {
+		URIish uri;
+
+		long creationToken;
+	}
+
+	private final boolean any;
+
+	private final List<Bundle> bundles;
+
+	private BundleList(boolean any, List<Bundle> bundles) {
+		this.any = any;
+		this.bundles = bundles;
+	}
+
+	/**
+	 * Parse a bundle list.
+	 * <p>
+	 * Relative URIs name files below the URI of the remote, like git
+	 * resolves them; they are ignored if the remote is neither local nor
+	 * reached by HTTP. Unknown keys and bundles without a valid URI are
+	 * ignored. A list of an unsupported version is empty.
+	 *
+	 * @param lines
+	 *            the "key=value" lines of the list
+	 * @param remote
+	 *            URI of the remote which sent the list
+	 * @return the list
+	 */
+	@SuppressWarnings("nls")
+	static BundleList parse(List<String> lines, URIish remote) {
+		String version = null;
+		String mode = "all";
+		Map<String, Bundle> byId = new LinkedHashMap<>();
+		for (String line : lines) {
+			int eq = line.indexOf('=');
+			if (eq < 0 || !line.startsWith("bundle.")) {
+				continue;
+			}
+			String key = line.substring("bundle.".length(), eq);
+			String value = line.substring(eq + 1);
+			int dot = key.lastIndexOf('.');
+			if (dot < 0) {
+				switch (key.toLowerCase(Locale.ROOT)) {
+				case "version":
+					version = value;
+					break;
+				case "mode":
+					mode = value;
+					break;
+				default:
+					break;
+				}
+				continue;
+			}
+			Bundle b = byId.computeIfAbsent(key.substring(0, dot),
+					id -> new Bundle());
+			switch (key.substring(dot + 1).toLowerCase(Locale.ROOT)) {
+			case "uri":
+				b.uri = toUri(value, remote);
+				break;
+			case "creationtoken":
+				try {
+					b.creationToken = Long.parseUnsignedLong(value);
+				} catch (NumberFormatException e) {
+					// Keep the default order of the bundle.
+				}
+				break;
+			default:
+				break;
+			}
+		}
+		if (!"1".equals(version)) {
+			return new BundleList(false, Collections.emptyList());
+		}
+
+		List<Bundle> bundles = new ArrayList<>(byId.size());
+		for (Bundle b : byId.values()) {
+			if (b.uri != null) {
+				bundles.add(b);
+			}
+		}
+		// Bundles with lower creation tokens are prerequisites of the
+		// following ones, so they have to be fetched first.
+		bundles.sort((a, b) -> Long.compareUnsigned(a.creationToken,
+				b.creationToken));
+		return new BundleList("any".equals(mode), bundles);
+	}
+
+	@SuppressWarnings("nls")
+	private static URIish toUri(String value, URIish remote) {
+		try {
+			URIish uri = new URIish(value);
+			if (uri.getScheme() != null || uri.getHost() != null
+					|| (uri.getPath() != null
+							&& new File(uri.getPath()).isAbsolute())) {
+				return uri;
+			}
+			String scheme = remote.getScheme();
+			if ("http".equals(scheme) || "https".equals(scheme)) {
+				String base = remote.toString();
+				if (!base.endsWith("/")) {
+					base += '/';
+				}
+				return new URIish(new URI(base).resolve(value).toString());
+			}
+			if ((scheme == null || "file".equals(scheme))
+					&& remote.getHost() == null && remote.getPath() != null) {
+				return new URIish(new File(remote.getPath(), value).toPath()
+						.normalize().toString());
+			}
+			return null;
+		} catch (URISyntaxException | IllegalArgumentException e) {
+			return null;
+		}
+	}
+
+	/**
+	 * Whether fetching any single bundle of the list is sufficient.
+	 *
+	 * @return {@code true} if the mode of the list is "any", {@code false} if
+	 *         all bundles should be fetched
+	 */
+	boolean isAny() {
+		return any;
+	}
+
+	/**
+	 * Get the bundles in the order they should be fetched.
+	 *
+	 * @return the bundles
+	 */
+	List<Bundle> getBundles() {
+		return bundles;
+	}
+}
@@ -164,6 +164,19 @@ void fetch(final ProgressMonitor monitor,
 	 */
 	boolean didFetchTestConnectivity();
 
+	/**
+	 * Get the number of requests the last fetch sent to the remote to find
+	 * the commits both sides have in common.
+	 *
+	 * @return number of negotiation round trips of the last fetch; 0 if the
+	 *         transport does not negotiate
+	 * @see NegotiationAlgorithm
+	 * @since 6.9
+	 */
+	default int getNegotiationRoundTrips() {
+		return 0;
+	}
+
 	/**
 	 * Set the lock message used when holding a pack out of garbage collection.
 	 * <p>
@@ -18,7 +18,9 @@
 import static org.eclipse.jgit.transport.ReceiveCommand.Type.UPDATE_NONFASTFORWARD;
 
 import java.io.File;
+import java.io.FileInputStream;
 import java.io.IOException;
+import java.io.InputStream;
 import java.io.OutputStreamWriter;
 import java.io.Writer;
 import java.text.MessageFormat;
@@ -49,6 +51,7 @@
 import org.eclipse.jgit.revwalk.ObjectWalk;
 import org.eclipse.jgit.revwalk.RevObject;
 import org.eclipse.jgit.revwalk.RevWalk;
+import org.eclipse.jgit.util.LazyFetch;
 import org.eclipse.jgit.util.StringUtils;
 
 class FetchProcess {
@@ -100,6 +103,9 @@ void execute(ProgressMonitor monitor, FetchResult result,
 		packLocks.clear();
 		localRefs = null;
 
+		// Objects missing from a partial clone are fetched with the objects
+		// asked for, not one by one while looking for them.
+		boolean fetchMissing = LazyFetch.disable();
 		Throwable e1 = null;
 		try {
 			executeImp(monitor, result, initialBranch);
@@ -107,6 +113,7 @@ void execute(ProgressMonitor monitor, FetchResult result,
 			e1 = err;
 			throw err;
 		} finally {
+			LazyFetch.restore(fetchMissing);
 			try {
 				for (PackLock lock : packLocks) {
 					lock.unlock();
@@ -159,6 +166,10 @@ private void executeImp(final ProgressMonitor monitor,
 			}
 			result.setAdvertisedRefs(transport.getURI(), refsMap);
 			result.peerUserAgent = conn.getPeerUserAgent();
+			if (getHead != null && transport.isUseBundleUri()
+					&& !transport.isDryRun()) {
+				fetchBundles(monitor, result);
+			}
 			final Set<Ref> matched = new HashSet<>();
 			for (RefSpec spec : toFetch) {
 				if (spec.getSource() == null)
@@ -283,6 +294,69 @@ private void addUpdateBatchCommands(FetchResult result,
 		}
 	}
 
+	/*
+	 * Fetches the bundles advertised by the remote into refs/bundles/*, so
+	 * the objects in them are neither asked for nor sent again.
+	 */
+	private void fetchBundles(ProgressMonitor monitor, FetchResult result)
+			throws TransportException {
+		if (!(conn instanceof BasePackFetchConnection)) {
+			return;
+		}
+		BundleList list = ((BasePackFetchConnection) conn).getBundleList();
+		if (list == null) {
+			return;
+		}
+		for (BundleList.Bundle b : list.getBundles()) {
+			try {
+				fetchBundle(monitor, b.uri);
+				if (list.isAny()) {
+					return;
+				}
+			} catch (IOException e) {
+				result.addMessages(MessageFormat.format(
+						JGitText.get().bundleUriSkipped, b.uri,
+						e.getMessage()));
+			}
+		}
+	}
+
+	@SuppressWarnings("nls")
+	private void fetchBundle(ProgressMonitor monitor, URIish uri)
+			throws IOException {
+		String scheme = uri.getScheme();
+		if ("http".equals(scheme) || "https".equals(scheme)) {
+			// Download it with the HTTP configuration of the local
+			// repository, like a fetch from the bundle's URI would.
+			try (TransportHttp http = new TransportHttp(transport.local,
+					uri)) {
+				http.setTimeout(transport.getTimeout());
+				fetchBundle(monitor, uri, http.openBundle());
+			}
+			return;
+		}
+		// A remote must not make us read any local file it can name.
+		if ((scheme == null || "file".equals(scheme)) && uri.getHost() == null
+				&& (transport instanceof TransportLocal
+						|| transport.isAllowFileBundleUri())) {
+			fetchBundle(monitor, uri, new FileInputStream(uri.getPath()));
+			return;
+		}
+		throw new NotSupportedException(MessageFormat
+				.format(JGitText.get().URINotSupported, uri));
+	}
+
+	private void fetchBundle(ProgressMonitor monitor, URIish uri,
+			InputStream in) throws IOException {
+		try (TransportBundleStream bundle = new TransportBundleStream(
+				transport.local, uri, in)) {
+			bundle.setTagOpt(TagOpt.NO_TAGS);
+			bundle.setCheckFetchedObjects(transport.isCheckFetchedObjects());
+			bundle.fetch(monitor, Collections.singletonList(
+					new RefSpec("+refs/heads/*:refs/bundles/*")));
+		}
+	}
+
 	private void fetchObjects(ProgressMonitor monitor)
 			throws TransportException {
 		try {
@@ -301,6 +375,7 @@ private void closeConnection(FetchResult result) {
 		if (conn != null) {
 			conn.close();
 			result.addMessages(conn.getMessages());
+			result.addNegotiationRoundTrips(conn.getNegotiationRoundTrips());
 			conn = null;
 		}
 	}
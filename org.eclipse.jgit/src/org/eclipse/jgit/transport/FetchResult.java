@@ -30,6 +30,8 @@ public class FetchResult extends OperationResult {
 
 	private final Map<String, FetchResult> submodules;
 
+	private int negotiationRoundTrips;
+
 	FetchResult() {
 		forMerge = new ArrayList<>();
 		submodules = new HashMap<>();
@@ -63,4 +65,23 @@ public void addSubmodule(String path, FetchResult result) {
 	public Map<String, FetchResult> submoduleResults() {
 		return Collections.unmodifiableMap(submodules);
 	}
+
+	void addNegotiationRoundTrips(int n) {
+		negotiationRoundTrips += n;
+	}
+
+	/**
+	 * Get the number of requests sent to the remote to find the commits both
+	 * sides have in common.
+	 * <p>
+	 * A fetch following tags opens a second connection; the round trips of
+	 * both are counted.
+	 *
+	 * @return number of negotiation round trips of the fetch
+	 * @see NegotiationAlgorithm
+	 * @since 6.9
+	 */
+	public int getNegotiationRoundTrips() {
+		return negotiationRoundTrips;
+	}
 }
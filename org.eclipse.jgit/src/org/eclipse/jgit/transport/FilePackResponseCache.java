@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.transport;
+
+import java.io.BufferedOutputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileNotFoundException;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.io.OutputStream;
+import java.nio.file.StandardCopyOption;
+import java.time.Duration;
+import java.time.Instant;
+import java.util.Arrays;
+import java.util.Comparator;
+import java.util.HashMap;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.CountDownLatch;
+
+import org.eclipse.jgit.annotations.Nullable;
+import org.eclipse.jgit.lib.ObjectId;
+import org.eclipse.jgit.util.FS;
+import org.eclipse.jgit.util.FileUtils;
+
+/**
+ * A {@link PackResponseCache} storing the packs in files of a local
+ * directory.
+ * <p>
+ * A pack is generated into its file before it is sent, so clients waiting
+ * for the same pack do not depend on the speed of the client which caused
+ * the generation. Packs are generated again once they are older than the
+ * maximum age.
+ * <p>
+ * Whenever a pack is stored, packs older than the maximum age are deleted,
+ * and then the oldest packs until all packs together fit into the maximum
+ * size. A pack larger than the maximum size is sent without being stored.
+ *
+ * @since 6.9
+ */
+public class FilePackResponseCache implements PackResponseCache {
+	private static class Generation {
+		final CountDownLatch done = new CountDownLatch(1);
+
+		volatile boolean stored;
+	}
+
+	private final File directory;
+
+	private final Duration maxAge;
+
+	private final long maxSize;
+
+	private final Map<ObjectId, Generation> running = new ConcurrentHashMap<>();
+
+	/** Held while storing a pack and deleting packs. */
+	private final Object storeLock = new Object();
+
+	/**
+	 * Create a cache storing packs in a directory.
+	 *
+	 * @param directory
+	 *            the directory to store the packs in, created when the first
+	 *            pack is stored
+	 * @param maxAge
+	 *            maximum age of a stored pack to be sent
+	 * @param maxSize
+	 *            maximum number of bytes of all stored packs
+	 */
+	public FilePackResponseCache(File directory, Duration maxAge,
+			long maxSize) {
+		this.directory = directory;
+		this.maxAge = maxAge;
+		this.maxSize = maxSize;
+	}
+
+	@Override
+	public void writePack(ObjectId key, PackGenerator generator,
+			OutputStream out) throws IOException {
+		File file = new File(directory, key.name() + ".pack"); //$NON-NLS-1$
+		if (isFresh(file) && send(file, out)) {
+			return;
+		}
+
+		Generation g = new Generation();
+		Generation other = running.putIfAbsent(key, g);
+		if (other != null) {
+			await(other);
+			if (!other.stored || !send(file, out)) {
+				generator.writePack(out);
+			}
+			return;
+		}
+		File tmp = null;
+		try {
+			FileInputStream in = null;
+			try {
+				// Another generation may have completed since the lookup
+				// above.
+				if (isFresh(file)) {
+					in = open(file);
+				}
+				if (in == null) {
+					tmp = generate(generator);
+					in = store(tmp, file);
+				}
+				g.stored = in != null;
+			} finally {
+				running.remove(key, g);
+				g.done.countDown();
+			}
+			if (in == null) {
+				// Too large to be stored, send the generated pack once.
+				in = new FileInputStream(tmp);
+			}
+			try (FileInputStream pack = in) {
+				pack.transferTo(out);
+			}
+		} finally {
+			if (tmp != null) {
+				FileUtils.delete(tmp, FileUtils.SKIP_MISSING);
+			}
+		}
+	}
+
+	private File generate(PackGenerator generator) throws IOException {
+		FileUtils.mkdirs(directory, true);
+		File tmp = File.createTempFile("pack_", ".tmp", directory); //$NON-NLS-1$ //$NON-NLS-2$
+		try (OutputStream fileOut = new BufferedOutputStream(
+				new FileOutputStream(tmp))) {
+			generator.writePack(fileOut);
+		} catch (IOException | RuntimeException e) {
+			FileUtils.delete(tmp, FileUtils.SKIP_MISSING);
+			throw e;
+		}
+		return tmp;
+	}
+
+	/**
+	 * Store a generated pack, and delete packs to make room for it.
+	 * <p>
+	 * The stored pack is opened before other threads may delete it.
+	 *
+	 * @return the opened pack, or null if it is larger than the cache
+	 */
+	private FileInputStream store(File tmp, File file) throws IOException {
+		if (tmp.length() > maxSize) {
+			return null;
+		}
+		synchronized (storeLock) {
+			FileUtils.rename(tmp, file, StandardCopyOption.ATOMIC_MOVE);
+			FileInputStream in = new FileInputStream(file);
+			evict(file);
+			return in;
+		}
+	}
+
+	/**
+	 * Delete expired packs, then the oldest packs until the stored packs fit
+	 * into the maximum size.
+	 *
+	 * @param keep
+	 *            the pack just stored, which is not deleted
+	 */
+	private void evict(File keep) {
+		File[] packs = directory
+				.listFiles((dir, name) -> name.endsWith(".pack")); //$NON-NLS-1$
+		if (packs == null) {
+			return;
+		}
+		Map<File, Instant> modified = new HashMap<>();
+		long total = 0;
+		for (File pack : packs) {
+			modified.put(pack, FS.DETECTED.lastModifiedInstant(pack));
+			total += pack.length();
+		}
+		Arrays.sort(packs, Comparator.comparing(modified::get));
+		Instant expired = Instant.now().minus(maxAge);
+		for (File pack : packs) {
+			if (pack.equals(keep)) {
+				continue;
+			}
+			if (total <= maxSize && modified.get(pack).isAfter(expired)) {
+				break;
+			}
+			long length = pack.length();
+			try {
+				FileUtils.delete(pack, FileUtils.SKIP_MISSING);
+				total -= length;
+			} catch (IOException e) {
+				// Still being sent on a system not deleting open files.
+			}
+		}
+	}
+
+	@Nullable
+	private static FileInputStream open(File file) {
+		try {
+			return new FileInputStream(file);
+		} catch (FileNotFoundException e) {
+			return null;
+		}
+	}
+
+	private static boolean send(File file, OutputStream out)
+			throws IOException {
+		FileInputStream in = open(file);
+		if (in == null) {
+			return false;
+		}
+		try (FileInputStream pack = in) {
+			pack.transferTo(out);
+			return true;
+		}
+	}
+
+	private boolean isFresh(File file) {
+		Instant modified = FS.DETECTED.lastModifiedInstant(file);
+		return !modified.equals(Instant.EPOCH)
+				&& modified.plus(maxAge).isAfter(Instant.now());
+	}
+
+	private static void await(Generation g) throws IOException {
+		try {
+			g.done.await();
+		} catch (InterruptedException e) {
+			Thread.currentThread().interrupt();
+			throw new InterruptedIOException();
+		}
+	}
+}
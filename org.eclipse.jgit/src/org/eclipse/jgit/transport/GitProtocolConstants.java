@@ -275,6 +275,14 @@ public final class GitProtocolConstants {
 	 */
 	public static final String COMMAND_OBJECT_INFO = "object-info"; //$NON-NLS-1$
 
+	/**
+	 * The server supports listing bundles clients may fetch before fetching
+	 * from the server.
+	 *
+	 * @since 6.9
+	 */
+	public static final String COMMAND_BUNDLE_URI = "bundle-uri"; //$NON-NLS-1$
+
 	/**
 	 * HTTP header to set by clients to request a specific git protocol version
 	 * in the HTTP transport.
@@ -13,6 +13,7 @@
 import java.io.IOException;
 import java.io.PipedInputStream;
 import java.io.PipedOutputStream;
+import java.util.Collections;
 
 import org.eclipse.jgit.errors.TransportException;
 import org.eclipse.jgit.internal.JGitText;
@@ -101,7 +102,9 @@ public void run() {
 		worker.start();
 
 		init(in_r, out_w);
-		readAdvertisedRefs();
+		if (!readAdvertisedRefs()) {
+			lsRefs(Collections.emptyList());
+		}
 	}
 
 	@Override
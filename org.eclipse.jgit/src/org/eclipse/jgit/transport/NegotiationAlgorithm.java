@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.transport;
+
+import java.util.Locale;
+
+import org.eclipse.jgit.lib.Config;
+
+/**
+ * Git config values for {@code fetch.negotiationAlgorithm}.
+ * <p>
+ * The algorithm selects the local commits a fetch sends to the remote as
+ * "have" lines, to find the commits both sides have in common.
+ *
+ * @since 6.9
+ */
+public enum NegotiationAlgorithm implements Config.ConfigEnum {
+
+	/**
+	 * Send the local commits one after another, newest first, until the
+	 * remote knows enough common commits.
+	 */
+	CONSECUTIVE("default"), //$NON-NLS-1$
+
+	/**
+	 * Like {@link #CONSECUTIVE}, but skip an exponentially growing number of
+	 * commits along the history of each local reference while the remote
+	 * does not acknowledge any of them. Needs fewer round trips if the local
+	 * history diverges a lot from the remote's, but may fetch more objects.
+	 */
+	SKIPPING,
+
+	/**
+	 * Send no local commits at all. The remote sends all objects reachable
+	 * from the wanted objects.
+	 */
+	NOOP;
+
+	private final String alias;
+
+	private NegotiationAlgorithm() {
+		alias = null;
+	}
+
+	private NegotiationAlgorithm(String alias) {
+		this.alias = alias;
+	}
+
+	@Override
+	public String toConfigValue() {
+		return name().toLowerCase(Locale.ROOT);
+	}
+
+	@Override
+	public boolean matchConfigValue(String in) {
+		return toConfigValue().equalsIgnoreCase(in)
+				|| (alias != null && alias.equalsIgnoreCase(in));
+	}
+}
@@ -21,7 +21,11 @@
 import java.util.Arrays;
 import java.util.Comparator;
 import java.util.List;
+import java.util.concurrent.Callable;
+import java.util.concurrent.Future;
 import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.zip.CRC32;
 import java.util.zip.DataFormatException;
 import java.util.zip.Inflater;
 
@@ -30,6 +34,7 @@
 import org.eclipse.jgit.errors.TooLargeObjectInPackException;
 import org.eclipse.jgit.internal.JGitText;
 import org.eclipse.jgit.internal.storage.pack.BinaryDelta;
+import org.eclipse.jgit.internal.util.Workers;
 import org.eclipse.jgit.lib.AnyObjectId;
 import org.eclipse.jgit.lib.BatchingProgressMonitor;
 import org.eclipse.jgit.lib.BlobObjectChecker;
@@ -46,8 +51,10 @@
 import org.eclipse.jgit.lib.ObjectReader;
 import org.eclipse.jgit.lib.ObjectStream;
 import org.eclipse.jgit.lib.ProgressMonitor;
+import org.eclipse.jgit.lib.ThreadSafeProgressMonitor;
 import org.eclipse.jgit.util.BlockList;
 import org.eclipse.jgit.util.IO;
+import org.eclipse.jgit.util.LazyFetch;
 import org.eclipse.jgit.util.LongMap;
 import org.eclipse.jgit.util.NB;
 import org.eclipse.jgit.util.sha1.SHA1;
@@ -152,9 +159,18 @@ public enum Source {
 	/** Message to protect the pack data from garbage collection. */
 	private String lockMessage;
 
+	/** Whether the pack was received from a promisor remote. */
+	private boolean promisor;
+
 	/** Git object size limit */
 	private long maxObjectSizeLimit;
 
+	/** Packs with fewer objects are stored as loose objects. */
+	private int unpackLimit;
+
+	/** Number of threads resolving deltas, 0 to use all processors. */
+	private int threads = 1;
+
 	private final ReceivedPackStatistics.Builder stats =
 			new ReceivedPackStatistics.Builder();
 
@@ -389,6 +405,32 @@ public void setLockMessage(String msg) {
 		lockMessage = msg;
 	}
 
+	/**
+	 * Whether the pack is marked as received from a promisor remote.
+	 *
+	 * @return true if the pack is marked as received from a promisor remote
+	 * @since 6.9
+	 */
+	public boolean isPromisor() {
+		return promisor;
+	}
+
+	/**
+	 * Mark the pack as received from a promisor remote.
+	 * <p>
+	 * The objects referenced by a promisor pack but missing from the
+	 * repository can be fetched from the remote when they are needed.
+	 * Implementations storing packs as files write a {@code .promisor} file
+	 * next to the pack.
+	 *
+	 * @param promisor
+	 *            true if the pack was received from a promisor remote
+	 * @since 6.9
+	 */
+	public void setPromisor(boolean promisor) {
+		this.promisor = promisor;
+	}
+
 	/**
 	 * Set the maximum allowed Git object size.
 	 * <p>
@@ -402,6 +444,63 @@ public void setMaxObjectSizeLimit(long limit) {
 		maxObjectSizeLimit = limit;
 	}
 
+	/**
+	 * Get the number of objects below which the objects of a pack are stored
+	 * as loose objects.
+	 *
+	 * @return the unpack limit; 0 if packs are always kept
+	 * @since 6.9
+	 */
+	public int getUnpackLimit() {
+		return unpackLimit;
+	}
+
+	/**
+	 * Set the number of objects below which the objects of a pack are stored
+	 * as loose objects.
+	 * <p>
+	 * Storing the objects of small packs, e.g. of pushes of a single commit,
+	 * as loose objects avoids accumulating many small pack files until the
+	 * next garbage collection. Implementations which do not store loose
+	 * objects ignore the limit.
+	 *
+	 * @param limit
+	 *            packs with fewer objects than this are stored as loose
+	 *            objects; 0 to always keep the pack
+	 * @since 6.9
+	 */
+	public void setUnpackLimit(int limit) {
+		unpackLimit = limit;
+	}
+
+	/**
+	 * Get the number of threads used to resolve deltas.
+	 *
+	 * @return number of threads used to resolve deltas. 0 means the number
+	 *         of available processors.
+	 * @since 6.9
+	 */
+	public int getThreads() {
+		return threads;
+	}
+
+	/**
+	 * Set the number of threads used to resolve deltas.
+	 * <p>
+	 * With more than one thread the delta trees of the base objects in the
+	 * pack are resolved concurrently, if the implementation supports
+	 * {@link #newDatabaseReader()}. By default deltas are resolved by the
+	 * thread calling {@link #parse(ProgressMonitor, ProgressMonitor)}.
+	 *
+	 * @param threads
+	 *            number of threads, 0 to use the number of available
+	 *            processors.
+	 * @since 6.9
+	 */
+	public void setThreads(int threads) {
+		this.threads = threads;
+	}
+
 	/**
 	 * Get the number of objects in the stream.
 	 * <p>
@@ -598,103 +697,89 @@ private void processDeltas(ProgressMonitor resolving) throws IOException {
 	private void resolveDeltas(ProgressMonitor progress)
 			throws IOException {
 		final int last = entryCount;
+		int n = threads;
+		if (n == 0) {
+			n = Runtime.getRuntime().availableProcessors();
+		}
+		if (n > 1 && last > 1) {
+			List<DatabaseReader> readers = openDatabaseReaders(
+					Math.min(n, last));
+			if (readers != null) {
+				parallelResolveDeltas(progress, readers, last);
+				return;
+			}
+		}
+		DeltaResolver resolver = new DatabaseDeltaResolver(progress);
 		for (int i = 0; i < last; i++) {
-			resolveDeltas(entries[i], progress);
+			resolver.resolveDeltas(entries[i]);
 			if (progress.isCancelled())
 				throw new IOException(
 						JGitText.get().downloadCancelledDuringIndexing);
 		}
 	}
 
-	private void resolveDeltas(final PackedObjectInfo oe,
-			ProgressMonitor progress) throws IOException {
-		UnresolvedDelta children = firstChildOf(oe);
-		if (children == null)
-			return;
-
-		DeltaVisit visit = new DeltaVisit();
-		visit.nextChild = children;
-
-		ObjectTypeAndSize info = openDatabase(oe, new ObjectTypeAndSize());
-		switch (info.type) {
-		case Constants.OBJ_COMMIT:
-		case Constants.OBJ_TREE:
-		case Constants.OBJ_BLOB:
-		case Constants.OBJ_TAG:
-			visit.data = inflateAndReturn(Source.DATABASE, info.size);
-			visit.id = oe;
-			break;
-		default:
-			throw new IOException(MessageFormat.format(
-					JGitText.get().unknownObjectType,
-					Integer.valueOf(info.type)));
+	private List<DatabaseReader> openDatabaseReaders(int count)
+			throws IOException {
+		List<DatabaseReader> readers = new ArrayList<>(count);
+		try {
+			for (int i = 0; i < count; i++) {
+				DatabaseReader r = newDatabaseReader();
+				if (r == null) {
+					break;
+				}
+				readers.add(r);
+			}
+		} catch (IOException | RuntimeException e) {
+			closeReaders(readers);
+			throw e;
 		}
-
-		if (!checkCRC(oe.getCRC())) {
-			throw new IOException(MessageFormat.format(
-					JGitText.get().corruptionDetectedReReadingAt,
-					Long.valueOf(oe.getOffset())));
+		if (readers.size() < 2) {
+			closeReaders(readers);
+			return null;
 		}
-
-		resolveDeltas(visit.next(), info.type, info, progress);
+		return readers;
 	}
 
-	private void resolveDeltas(DeltaVisit visit, final int type,
-			ObjectTypeAndSize info, ProgressMonitor progress)
-			throws IOException {
-		stats.addDeltaObject(type);
-		do {
-			progress.update(1);
-			info = openDatabase(visit.delta, info);
-			switch (info.type) {
-			case Constants.OBJ_OFS_DELTA:
-			case Constants.OBJ_REF_DELTA:
-				break;
-
-			default:
-				throw new IOException(MessageFormat.format(
-						JGitText.get().unknownObjectType,
-						Integer.valueOf(info.type)));
+	private static void closeReaders(List<DatabaseReader> readers) {
+		for (DatabaseReader r : readers) {
+			try {
+				r.close();
+			} catch (IOException e) {
+				// Ignored, the readers only read data already stored.
 			}
+		}
+	}
 
-			byte[] delta = inflateAndReturn(Source.DATABASE, info.size);
-			long finalSz = BinaryDelta.getResultSize(delta);
-			checkIfTooLarge(type, finalSz);
-
-			visit.data = BinaryDelta.apply(visit.parent.data, delta);
-			delta = null;
-
-			if (!checkCRC(visit.delta.crc))
-				throw new IOException(MessageFormat.format(
-						JGitText.get().corruptionDetectedReReadingAt,
-						Long.valueOf(visit.delta.position)));
-
-			SHA1 objectDigest = objectHasher.reset();
-			objectDigest.update(Constants.encodedTypeString(type));
-			objectDigest.update((byte) ' ');
-			objectDigest.update(Constants.encodeASCII(visit.data.length));
-			objectDigest.update((byte) 0);
-			objectDigest.update(visit.data);
-			objectDigest.digest(tempObjectId);
-
-			verifySafeObject(tempObjectId, type, visit.data);
-			if (isCheckObjectCollisions() && readCurs.has(tempObjectId)) {
-				checkObjectCollision(tempObjectId, type, visit.data,
-						visit.delta.sizeBeforeInflating);
+	private void parallelResolveDeltas(ProgressMonitor progress,
+			List<DatabaseReader> readers, int last) throws IOException {
+		ThreadSafeProgressMonitor pm = new ThreadSafeProgressMonitor(
+				progress);
+		AtomicInteger next = new AtomicInteger();
+		List<Future<?>> futures = new ArrayList<>(readers.size());
+		try {
+			pm.startWorkers(readers.size());
+			for (DatabaseReader r : readers) {
+				futures.add(Workers.getExecutor()
+						.submit(LazyFetch.inherit(
+								new ReaderDeltaResolver(r, pm, next, last))));
 			}
+			pm.waitForCompletion();
 
-			PackedObjectInfo oe;
-			oe = newInfo(tempObjectId, visit.delta, visit.parent.id);
-			oe.setFullSize(finalSz);
-			oe.setOffset(visit.delta.position);
-			oe.setType(type);
-			onInflatedObjectData(oe, type, visit.data);
-			addObjectAndTrack(oe);
-			visit.id = oe;
-
-			visit.nextChild = firstChildOf(oe);
-			visit = visit.next();
-		} while (visit != null);
+			// All resolvers have ended; report the first failure as though
+			// the deltas had been resolved by this thread.
+			for (Future<?> f : futures) {
+				Workers.join(f);
+			}
+		} catch (InterruptedException ie) {
+			next.set(last);
+			for (Future<?> f : futures) {
+				f.cancel(true);
+			}
+			throw new IOException(
+					JGitText.get().downloadCancelledDuringIndexing, ie);
+		} finally {
+			closeReaders(readers);
+		}
 	}
 
 	private final void checkIfTooLarge(int typeCode, long size)
@@ -867,8 +952,8 @@ private void resolveDeltasWithExternalBases(ProgressMonitor progress)
 			if (onAppendBase(typeCode, visit.data, oe))
 				entries[entryCount++] = oe;
 			visit.nextChild = firstChildOf(oe);
-			resolveDeltas(visit.next(), typeCode,
-					new ObjectTypeAndSize(), progress);
+			new DatabaseDeltaResolver(progress).resolveDeltas(visit.next(),
+					typeCode);
 
 			if (progress.isCancelled())
 				throw new IOException(
@@ -1317,6 +1402,19 @@ protected void setExpectedObjectCount(long expectedObjectCount) {
 		this.expectedObjectCount = expectedObjectCount;
 	}
 
+	/**
+	 * Record the number of objects the implementation stored as loose
+	 * objects instead of keeping the pack.
+	 *
+	 * @param count
+	 *            number of loose objects written
+	 * @see #setUnpackLimit(int)
+	 * @since 6.9
+	 */
+	protected void setLooseObjectCount(long count) {
+		stats.setNumLooseObjects(count);
+	}
+
 	/**
 	 * Store bytes received from the raw stream.
 	 * <p>
@@ -1527,6 +1625,25 @@ protected abstract int readDatabase(byte[] dst, int pos, int cnt)
 	 */
 	protected abstract boolean checkCRC(int oldCRC);
 
+	/**
+	 * Open an additional reader on the data already stored in the database.
+	 * <p>
+	 * Each thread resolving deltas concurrently reads the objects it needs
+	 * through its own reader, while the subclass event methods are still
+	 * invoked by one thread at a time. Implementations which cannot read
+	 * their stored data from several threads return null, deltas are then
+	 * resolved by a single thread through
+	 * {@link #seekDatabase(PackedObjectInfo, ObjectTypeAndSize)}.
+	 *
+	 * @return a new reader, or null if concurrent reads are not supported.
+	 * @throws java.io.IOException
+	 *             the reader cannot be opened.
+	 * @since 6.9
+	 */
+	protected DatabaseReader newDatabaseReader() throws IOException {
+		return null;
+	}
+
 	/**
 	 * Event notifying the start of an object stored whole (not as a delta).
 	 *
@@ -1697,6 +1814,44 @@ public void setCRC(int crc32) {
 		}
 	}
 
+	/**
+	 * Reads back the pack data stored in the database by one thread.
+	 *
+	 * @since 6.9
+	 */
+	public abstract static class DatabaseReader implements AutoCloseable {
+		/**
+		 * Position the reader on the given offset of the pack.
+		 *
+		 * @param position
+		 *            offset of the object header in the pack.
+		 * @throws java.io.IOException
+		 *             the database cannot be accessed.
+		 */
+		public abstract void seek(long position) throws IOException;
+
+		/**
+		 * Read data from the current position, advancing it.
+		 *
+		 * @param dst
+		 *            buffer to copy data into.
+		 * @param pos
+		 *            first position within {@code dst} to copy data into.
+		 * @param cnt
+		 *            maximum number of bytes to copy.
+		 * @return number of bytes read; 0 or -1 at the end of the data.
+		 * @throws java.io.IOException
+		 *             the database cannot be accessed.
+		 */
+		public abstract int read(byte[] dst, int pos, int cnt)
+				throws IOException;
+
+		@Override
+		public void close() throws IOException {
+			// Nothing to release by default.
+		}
+	}
+
 	private static class DeltaVisit {
 		final UnresolvedDelta delta;
 
@@ -1742,6 +1897,377 @@ private void addObjectAndTrack(PackedObjectInfo oe) {
 			newObjectIds.add(oe);
 	}
 
+	/**
+	 * Resolves the delta trees of base objects stored in the database.
+	 * <p>
+	 * Subclasses read the stored objects back. State shared with other
+	 * resolvers, including the subclass event methods, is only touched while
+	 * holding the lock of the parser.
+	 */
+	private abstract class DeltaResolver {
+		private final ProgressMonitor progress;
+
+		private final SHA1 hasher;
+
+		private final MutableObjectId id;
+
+		DeltaResolver(ProgressMonitor progress, SHA1 hasher,
+				MutableObjectId id) {
+			this.progress = progress;
+			this.hasher = hasher;
+			this.id = id;
+		}
+
+		/**
+		 * Position on a stored object and read its header.
+		 *
+		 * @param position
+		 *            offset of the object in the pack
+		 * @param obj
+		 *            the object if it is a base object, or null
+		 * @param delta
+		 *            the object if it is a delta, or null
+		 * @return type and inflated size of the object
+		 * @throws IOException
+		 *             the object cannot be read
+		 */
+		abstract ObjectTypeAndSize open(long position, PackedObjectInfo obj,
+				UnresolvedDelta delta) throws IOException;
+
+		/**
+		 * Inflate the data of the object the resolver is positioned on.
+		 *
+		 * @param size
+		 *            inflated size of the object
+		 * @return the inflated data
+		 * @throws IOException
+		 *             the data cannot be read or is corrupt
+		 */
+		abstract byte[] inflate(long size) throws IOException;
+
+		/**
+		 * Check the CRC of the data read since the last {@code open()}.
+		 *
+		 * @param oldCRC
+		 *            CRC computed when the pack was received
+		 * @return true if the data was read back unchanged
+		 */
+		abstract boolean checkCRC(int oldCRC);
+
+		void resolveDeltas(PackedObjectInfo oe) throws IOException {
+			UnresolvedDelta children;
+			synchronized (PackParser.this) {
+				children = firstChildOf(oe);
+			}
+			if (children == null) {
+				return;
+			}
+
+			DeltaVisit visit = new DeltaVisit();
+			visit.nextChild = children;
+
+			ObjectTypeAndSize info = open(oe.getOffset(), oe, null);
+			switch (info.type) {
+			case Constants.OBJ_COMMIT:
+			case Constants.OBJ_TREE:
+			case Constants.OBJ_BLOB:
+			case Constants.OBJ_TAG:
+				visit.data = inflate(info.size);
+				visit.id = oe;
+				break;
+			default:
+				throw new IOException(MessageFormat.format(
+						JGitText.get().unknownObjectType,
+						Integer.valueOf(info.type)));
+			}
+
+			if (!checkCRC(oe.getCRC())) {
+				throw new IOException(MessageFormat.format(
+						JGitText.get().corruptionDetectedReReadingAt,
+						Long.valueOf(oe.getOffset())));
+			}
+
+			resolveDeltas(visit.next(), info.type);
+		}
+
+		void resolveDeltas(DeltaVisit visit, int type) throws IOException {
+			synchronized (PackParser.this) {
+				stats.addDeltaObject(type);
+			}
+			do {
+				progress.update(1);
+				ObjectTypeAndSize info = open(visit.delta.position, null,
+						visit.delta);
+				switch (info.type) {
+				case Constants.OBJ_OFS_DELTA:
+				case Constants.OBJ_REF_DELTA:
+					break;
+
+				default:
+					throw new IOException(MessageFormat.format(
+							JGitText.get().unknownObjectType,
+							Integer.valueOf(info.type)));
+				}
+
+				byte[] delta = inflate(info.size);
+				long finalSz = BinaryDelta.getResultSize(delta);
+				checkIfTooLarge(type, finalSz);
+
+				visit.data = BinaryDelta.apply(visit.parent.data, delta);
+				delta = null;
+
+				if (!checkCRC(visit.delta.crc)) {
+					throw new IOException(MessageFormat.format(
+							JGitText.get().corruptionDetectedReReadingAt,
+							Long.valueOf(visit.delta.position)));
+				}
+
+				SHA1 objectDigest = hasher.reset();
+				objectDigest.update(Constants.encodedTypeString(type));
+				objectDigest.update((byte) ' ');
+				objectDigest.update(Constants.encodeASCII(visit.data.length));
+				objectDigest.update((byte) 0);
+				objectDigest.update(visit.data);
+				objectDigest.digest(id);
+
+				PackedObjectInfo oe;
+				synchronized (PackParser.this) {
+					verifySafeObject(id, type, visit.data);
+					if (isCheckObjectCollisions() && readCurs.has(id)) {
+						checkObjectCollision(id, type, visit.data,
+								visit.delta.sizeBeforeInflating);
+					}
+
+					oe = newInfo(id, visit.delta, visit.parent.id);
+					oe.setFullSize(finalSz);
+					oe.setOffset(visit.delta.position);
+					oe.setType(type);
+					onInflatedObjectData(oe, type, visit.data);
+					addObjectAndTrack(oe);
+					visit.nextChild = firstChildOf(oe);
+				}
+				visit.id = oe;
+				visit = visit.next();
+			} while (visit != null);
+		}
+	}
+
+	/**
+	 * Resolves deltas on the calling thread, reading through the subclass
+	 * methods accessing the database.
+	 */
+	private class DatabaseDeltaResolver extends DeltaResolver {
+		private final ObjectTypeAndSize info = new ObjectTypeAndSize();
+
+		DatabaseDeltaResolver(ProgressMonitor progress) {
+			super(progress, objectHasher, tempObjectId);
+		}
+
+		@Override
+		ObjectTypeAndSize open(long position, PackedObjectInfo obj,
+				UnresolvedDelta delta) throws IOException {
+			return obj != null ? openDatabase(obj, info)
+					: openDatabase(delta, info);
+		}
+
+		@Override
+		byte[] inflate(long size) throws IOException {
+			return inflateAndReturn(Source.DATABASE, size);
+		}
+
+		@Override
+		boolean checkCRC(int oldCRC) {
+			return PackParser.this.checkCRC(oldCRC);
+		}
+	}
+
+	/**
+	 * Resolves the delta trees of a range of base objects on a worker thread,
+	 * reading the stored pack data through its own {@link DatabaseReader},
+	 * inflater and CRC.
+	 */
+	private class ReaderDeltaResolver extends DeltaResolver
+			implements Callable<Void> {
+		private final DatabaseReader db;
+
+		private final ThreadSafeProgressMonitor pm;
+
+		private final AtomicInteger next;
+
+		private final int last;
+
+		private final byte[] readBuf = new byte[BUFFER_SIZE];
+
+		private final byte[] skipBuffer = new byte[512];
+
+		private int rOffset;
+
+		private int rAvail;
+
+		private final CRC32 crc = new CRC32();
+
+		private final ObjectTypeAndSize info = new ObjectTypeAndSize();
+
+		private Inflater inf;
+
+		ReaderDeltaResolver(DatabaseReader db,
+				ThreadSafeProgressMonitor progress, AtomicInteger next,
+				int last) {
+			super(progress, SHA1.newInstance(), new MutableObjectId());
+			this.db = db;
+			this.pm = progress;
+			this.next = next;
+			this.last = last;
+		}
+
+		@Override
+		public Void call() throws IOException {
+			inf = InflaterCache.get();
+			try {
+				for (int i = next.getAndIncrement(); i < last; i = next
+						.getAndIncrement()) {
+					resolveDeltas(entries[i]);
+					if (pm.isCancelled()) {
+						throw new IOException(JGitText
+								.get().downloadCancelledDuringIndexing);
+					}
+				}
+				return null;
+			} catch (IOException | RuntimeException | Error e) {
+				// Stop the other resolvers, the parse has failed.
+				next.set(last);
+				throw e;
+			} finally {
+				InflaterCache.release(inf);
+				inf = null;
+				pm.endWorker();
+			}
+		}
+
+		@Override
+		ObjectTypeAndSize open(long position, PackedObjectInfo obj,
+				UnresolvedDelta delta) throws IOException {
+			db.seek(position);
+			rOffset = 0;
+			rAvail = 0;
+			crc.reset();
+
+			int c = readByte();
+			info.type = (c >> 4) & 7;
+			long sz = c & 15;
+			int shift = 4;
+			while ((c & 0x80) != 0) {
+				c = readByte();
+				sz += ((long) (c & 0x7f)) << shift;
+				shift += 7;
+			}
+			info.size = sz;
+
+			switch (info.type) {
+			case Constants.OBJ_COMMIT:
+			case Constants.OBJ_TREE:
+			case Constants.OBJ_BLOB:
+			case Constants.OBJ_TAG:
+				break;
+
+			case Constants.OBJ_OFS_DELTA:
+				do {
+					c = readByte();
+				} while ((c & 128) != 0);
+				break;
+
+			case Constants.OBJ_REF_DELTA:
+				for (int i = 0; i < Constants.OBJECT_ID_LENGTH; i++) {
+					readByte();
+				}
+				break;
+
+			default:
+				throw new IOException(MessageFormat.format(
+						JGitText.get().unknownObjectType,
+						Integer.valueOf(info.type)));
+			}
+			return info;
+		}
+
+		@Override
+		boolean checkCRC(int oldCRC) {
+			return oldCRC == (int) crc.getValue();
+		}
+
+		private int readByte() throws IOException {
+			if (rAvail == 0) {
+				fill();
+			}
+			int c = readBuf[rOffset++] & 0xff;
+			rAvail--;
+			crc.update(c);
+			return c;
+		}
+
+		private void fill() throws IOException {
+			int n = db.read(readBuf, 0, readBuf.length);
+			if (n <= 0) {
+				throw new EOFException(
+						JGitText.get().packfileIsTruncatedNoParam);
+			}
+			rOffset = 0;
+			rAvail = n;
+		}
+
+		@Override
+		byte[] inflate(long inflatedSize) throws IOException {
+			byte[] dst = new byte[(int) inflatedSize];
+			int n = 0;
+			int p = rOffset;
+			int len = rAvail;
+			inf.reset();
+			inf.setInput(readBuf, p, len);
+			try {
+				while (!inf.finished()) {
+					if (inf.needsInput()) {
+						crc.update(readBuf, p, len);
+						fill();
+						p = rOffset;
+						len = rAvail;
+						inf.setInput(readBuf, p, len);
+						continue;
+					}
+					int r;
+					if (n < dst.length) {
+						r = inf.inflate(dst, n, dst.length - n);
+						n += r;
+					} else {
+						r = inf.inflate(skipBuffer);
+						if (r > 0) {
+							throw corrupt(
+									JGitText.get().wrongDecompressedLength);
+						}
+					}
+					if (r == 0 && !inf.finished() && !inf.needsInput()) {
+						throw corrupt(JGitText.get().unknownZlibError);
+					}
+				}
+			} catch (DataFormatException dfe) {
+				throw corrupt(dfe.getMessage());
+			}
+			if (n != dst.length) {
+				throw corrupt(JGitText.get().wrongDecompressedLength);
+			}
+
+			int used = len - inf.getRemaining();
+			crc.update(readBuf, p, used);
+			rOffset = p + used;
+			rAvail = len - used;
+			return dst;
+		}
+
+		private CorruptObjectException corrupt(String detail) {
+			return new CorruptObjectException(MessageFormat.format(
+					JGitText.get().packfileCorruptionDetected, detail));
+		}
+	}
+
 	private class InflaterStream extends InputStream {
 		private final Inflater inf;
 
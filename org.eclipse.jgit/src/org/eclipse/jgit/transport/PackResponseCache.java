@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.transport;
+
+import java.io.IOException;
+import java.io.OutputStream;
+
+import org.eclipse.jgit.lib.ObjectId;
+
+/**
+ * Cache of the packs sent by {@link UploadPack}.
+ * <p>
+ * Many clients sending the same request, e.g. build machines cloning a
+ * repository at the same time, are all sent the same pack. A cache allows
+ * to generate the pack once and send the stored copy to the other clients.
+ * <p>
+ * {@link UploadPack} identifies a pack by a key computed from the request,
+ * the state of the references the pack depends on, and the
+ * {@link org.eclipse.jgit.storage.pack.PackConfig} used to write it. Only
+ * packs for requests without objects in common with the client, and without
+ * shallow, deepen or filter arguments, are cached.
+ *
+ * @see UploadPack#setPackResponseCache(PackResponseCache)
+ * @since 6.9
+ */
+public interface PackResponseCache {
+	/**
+	 * Generator of a pack, called if the cache does not hold the pack.
+	 *
+	 * @since 6.9
+	 */
+	@FunctionalInterface
+	interface PackGenerator {
+		/**
+		 * Write the pack.
+		 *
+		 * @param out
+		 *            stream to write the pack to
+		 * @throws IOException
+		 *             if the pack cannot be generated or written
+		 */
+		void writePack(OutputStream out) throws IOException;
+	}
+
+	/**
+	 * Write a pack, from the cache if it holds the pack.
+	 * <p>
+	 * If the cache does not hold the pack, implementations call the
+	 * generator, write the generated pack to {@code out} and may store it.
+	 * Implementations should let concurrent calls for the same key wait for a
+	 * single generation of the pack.
+	 *
+	 * @param key
+	 *            key identifying the pack
+	 * @param generator
+	 *            generator of the pack
+	 * @param out
+	 *            stream to write the pack to
+	 * @throws IOException
+	 *             if the pack cannot be read from the cache, generated, or
+	 *             written
+	 */
+	void writePack(ObjectId key, PackGenerator generator, OutputStream out)
+			throws IOException;
+}
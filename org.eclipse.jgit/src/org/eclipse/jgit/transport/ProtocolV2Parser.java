@@ -310,4 +310,26 @@ ObjectInfoRequest parseObjectInfoRequest(PacketLineIn pckIn)
 
 		return builder.setObjectIDs(objectIDs).build();
 	}
+
+	/*
+	 * Read a bundle-uri request. The command has no arguments, so only the
+	 * capabilities and an empty argument list are accepted.
+	 */
+	void parseBundleUriRequest(PacketLineIn pckIn)
+			throws PackProtocolException, IOException {
+		String line = consumeCapabilities(pckIn, serverOption -> {
+			// Not used by bundle-uri.
+		}, agent -> {
+			// Not used by bundle-uri.
+		}, clientSID -> {
+			// Not used by bundle-uri.
+		});
+		if (PacketLineIn.isDelimiter(line)) {
+			line = pckIn.readString();
+		}
+		if (!PacketLineIn.isEnd(line)) {
+			throw new PackProtocolException(MessageFormat
+					.format(JGitText.get().unexpectedPacketLine, line));
+		}
+	}
 }
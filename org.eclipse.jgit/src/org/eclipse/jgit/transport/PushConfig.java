@@ -125,6 +125,8 @@ public boolean matchConfigValue(String in) {
 
 	private final PushDefault pushDefault;
 
+	private final boolean negotiate;
+
 	/**
 	 * Creates a new instance.
 	 *
@@ -138,6 +140,8 @@ public PushConfig(Config config) {
 				PushRecurseSubmodulesMode.NO);
 		pushDefault = config.getEnum(ConfigConstants.CONFIG_PUSH_SECTION, null,
 				ConfigConstants.CONFIG_KEY_DEFAULT, PushDefault.SIMPLE);
+		negotiate = config.getBoolean(ConfigConstants.CONFIG_PUSH_SECTION,
+				ConfigConstants.CONFIG_KEY_NEGOTIATE, false);
 	}
 
 	/**
@@ -159,4 +163,15 @@ public PushRecurseSubmodulesMode getRecurseSubmodules() {
 	public PushDefault getPushDefault() {
 		return pushDefault;
 	}
+
+	/**
+	 * Retrieves the value of git config {@code push.negotiate}.
+	 *
+	 * @return whether push negotiates the commits the remote has before
+	 *         sending a pack
+	 * @since 6.9
+	 */
+	public boolean isNegotiate() {
+		return negotiate;
+	}
 }
@@ -268,6 +268,9 @@ public Set<String> getCapabilities() {
 	/** Git object size limit */
 	private long maxObjectSizeLimit;
 
+	/** Packs with fewer objects are stored as loose objects. */
+	private int unpackLimit;
+
 	/** Total pack size limit */
 	private long maxPackSizeLimit = -1;
 
@@ -331,6 +334,7 @@ public ReceivePack(Repository into) {
 		allowPushOptions = rc.allowPushOptions;
 		maxCommandBytes = rc.maxCommandBytes;
 		maxDiscardBytes = rc.maxDiscardBytes;
+		unpackLimit = rc.unpackLimit;
 		advertiseRefsHook = AdvertiseRefsHook.DEFAULT;
 		refFilter = RefFilter.DEFAULT;
 		advertisedHaves = new HashSet<>();
@@ -356,6 +360,8 @@ private static class ReceiveConfig {
 
 		final long maxDiscardBytes;
 
+		final int unpackLimit;
+
 		final SignedPushConfig signedPush;
 
 		ReceiveConfig(Config config) {
@@ -373,6 +379,8 @@ private static class ReceiveConfig {
 			maxDiscardBytes = config.getLong("receive", //$NON-NLS-1$
 					"maxCommandDiscardBytes", //$NON-NLS-1$
 					-1);
+			unpackLimit = config.getInt("receive", "unpackLimit", //$NON-NLS-1$ //$NON-NLS-2$
+					config.getInt("transfer", "unpackLimit", 0)); //$NON-NLS-1$ //$NON-NLS-2$
 			signedPush = SignedPushConfig.KEY.parse(config);
 		}
 	}
@@ -882,6 +890,25 @@ public void setMaxObjectSizeLimit(long limit) {
 		maxObjectSizeLimit = limit;
 	}
 
+	/**
+	 * Set the number of objects below which a received pack is stored as
+	 * loose objects.
+	 * <p>
+	 * Pushes of a few commits then do not each add a pack file to the
+	 * repository. The number of objects stored as loose objects is reported
+	 * by {@link ReceivedPackStatistics#getNumLooseObjects()}. Default setting
+	 * is {@code receive.unpackLimit}, or {@code transfer.unpackLimit} if not
+	 * set. Repositories not storing loose objects ignore the limit.
+	 *
+	 * @param limit
+	 *            packs with fewer objects than this are stored as loose
+	 *            objects; 0 to always keep the pack
+	 * @since 6.9
+	 */
+	public void setUnpackLimit(int limit) {
+		unpackLimit = limit;
+	}
+
 	/**
 	 * Set the maximum allowed pack size.
 	 * <p>
@@ -1556,6 +1583,7 @@ private void receivePack() throws IOException {
 			parser.setObjectChecker(objectChecker);
 			parser.setLockMessage(lockMsg);
 			parser.setMaxObjectSizeLimit(maxObjectSizeLimit);
+			parser.setUnpackLimit(unpackLimit);
 			packLock = parser.parse(receiving, resolving);
 			packSize = Long.valueOf(parser.getPackSize());
 			stats = parser.getReceivedPackStatistics();
@@ -34,6 +34,8 @@ public class ReceivedPackStatistics {
 	private long numDeltaBlob;
 	private long numDeltaTag;
 
+	private long numLooseObjects;
+
 	/**
 	 * Get number of bytes read from the input stream
 	 *
@@ -155,6 +157,19 @@ public long getNumDeltaTag() {
 		return numDeltaTag;
 	}
 
+	/**
+	 * Get number of objects stored as loose objects instead of keeping the
+	 * pack, because the pack had fewer objects than the unpack limit
+	 *
+	 * @return number of objects stored as loose objects; 0 if the pack was
+	 *         kept
+	 * @see PackParser#setUnpackLimit(int)
+	 * @since 6.9
+	 */
+	public long getNumLooseObjects() {
+		return numLooseObjects;
+	}
+
 	/** A builder for {@link ReceivedPackStatistics}. */
 	public static class Builder {
 		private long numBytesRead;
@@ -173,6 +188,8 @@ public static class Builder {
 		private long numDeltaBlob;
 		private long numDeltaTag;
 
+		private long numLooseObjects;
+
 		/**
 		 * Set number of bytes read from the input stream
 		 *
@@ -256,6 +273,18 @@ Builder incrementObjectsDuplicated() {
 			return this;
 		}
 
+		/**
+		 * Set number of objects stored as loose objects
+		 *
+		 * @param count
+		 *            number of objects stored as loose objects
+		 * @return this
+		 */
+		Builder setNumLooseObjects(long count) {
+			numLooseObjects = count;
+			return this;
+		}
+
 		/**
 		 * Increment a delta object count.
 		 *
@@ -298,6 +327,7 @@ ReceivedPackStatistics build() {
 			s.numDeltaTree = numDeltaTree;
 			s.numDeltaBlob = numDeltaBlob;
 			s.numDeltaTag = numDeltaTag;
+			s.numLooseObjects = numLooseObjects;
 			s.numObjectsDuplicated = numObjectsDuplicated;
 			return s;
 		}
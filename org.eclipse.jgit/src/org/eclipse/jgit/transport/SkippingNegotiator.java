@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.transport;
+
+import java.io.IOException;
+import java.util.Collection;
+import java.util.PriorityQueue;
+
+import org.eclipse.jgit.lib.ObjectIdOwnerMap;
+import org.eclipse.jgit.revwalk.RevCommit;
+import org.eclipse.jgit.revwalk.RevFlag;
+import org.eclipse.jgit.revwalk.RevWalk;
+
+/**
+ * Selects the "have" lines of {@link NegotiationAlgorithm#SKIPPING}.
+ * <p>
+ * Like the consecutive negotiation, local commits are visited newest first.
+ * Along each line of history an increasing number of commits is skipped after
+ * every commit sent: 1, 2, 4, 7, 11 and so on, until the remote acknowledges
+ * a commit. Commits known to be common end the walk of their history.
+ */
+class SkippingNegotiator {
+	/** Upper bound of the number of commits skipped in a row. */
+	private static final int MAX_TTL = 0xffff;
+
+	private static class Entry extends ObjectIdOwnerMap.Entry {
+		final RevCommit commit;
+
+		/** Number of commits skipped before this one was reached. */
+		int originalTtl;
+
+		/** Number of commits still to skip, including this one. */
+		int ttl;
+
+		boolean popped;
+
+		Entry(RevCommit commit) {
+			super(commit);
+			this.commit = commit;
+		}
+	}
+
+	private final RevWalk walk;
+
+	private final RevFlag common;
+
+	private final RevFlag advertised;
+
+	private final ObjectIdOwnerMap<Entry> entries = new ObjectIdOwnerMap<>();
+
+	private final PriorityQueue<Entry> queue = new PriorityQueue<>(
+			(a, b) -> Integer.compare(b.commit.getCommitTime(),
+					a.commit.getCommitTime()));
+
+	/**
+	 * @param walk
+	 *            walk to parse commits with
+	 * @param common
+	 *            flag of the commits known to be common
+	 * @param advertised
+	 *            flag of the commits advertised by the remote
+	 * @param tips
+	 *            commits to start from
+	 */
+	SkippingNegotiator(RevWalk walk, RevFlag common, RevFlag advertised,
+			Collection<RevCommit> tips) {
+		this.walk = walk;
+		this.common = common;
+		this.advertised = advertised;
+		for (RevCommit c : tips) {
+			push(c);
+		}
+	}
+
+	/**
+	 * Get the next commit to send as "have".
+	 *
+	 * @return the next commit, or null if there are no more commits to send
+	 * @throws IOException
+	 *             if a commit cannot be read
+	 */
+	RevCommit next() throws IOException {
+		for (;;) {
+			Entry e = queue.poll();
+			if (e == null) {
+				return null;
+			}
+			e.popped = true;
+			RevCommit c = e.commit;
+			boolean remoteKnowsIsCommon = c.has(common);
+			if (remoteKnowsIsCommon || c.has(advertised)) {
+				// The remote has this commit and all of its history. Send
+				// it only if the remote does not know yet that we have it.
+				c.add(common);
+				c.carry(common);
+				if (!remoteKnowsIsCommon) {
+					return c;
+				}
+				continue;
+			}
+			boolean parentPushed = false;
+			for (RevCommit p : c.getParents()) {
+				parentPushed |= pushParent(e, p);
+			}
+			// Commits without parents left to visit are sent anyway, they
+			// end their line of history.
+			if (e.ttl == 0 || !parentPushed) {
+				return c;
+			}
+		}
+	}
+
+	private Entry push(RevCommit c) {
+		Entry e = entries.get(c);
+		if (e == null) {
+			e = new Entry(c);
+			entries.add(e);
+			queue.add(e);
+		}
+		return e;
+	}
+
+	private boolean pushParent(Entry child, RevCommit parent)
+			throws IOException {
+		Entry e = entries.get(parent);
+		if (e != null && e.popped) {
+			// Already visited due to clock skew, ignore this parent.
+			return false;
+		}
+		if (e == null) {
+			walk.parseHeaders(parent);
+			e = push(parent);
+		}
+		int originalTtl;
+		int ttl;
+		if (child.ttl > 0) {
+			originalTtl = child.originalTtl;
+			ttl = child.ttl - 1;
+		} else {
+			originalTtl = Math.min(child.originalTtl * 3 / 2 + 1, MAX_TTL);
+			ttl = originalTtl;
+		}
+		if (e.originalTtl < originalTtl) {
+			e.originalTtl = originalTtl;
+			e.ttl = ttl;
+		}
+		return true;
+	}
+}
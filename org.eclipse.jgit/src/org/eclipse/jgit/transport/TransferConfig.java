@@ -125,6 +125,11 @@ static ProtocolVersion parse(@Nullable String name) {
 	private final boolean advertiseSidebandAll;
 	private final boolean advertiseWaitForDone;
 	private final boolean advertiseObjectInfo;
+	private final boolean advertiseBundleUri;
+
+	private final boolean bundleUri;
+
+	private final boolean bundleUriAllowFile;
 
 	private final boolean allowReceiveClientSID;
 
@@ -219,6 +224,11 @@ public TransferConfig(Config rc) {
 				"advertisewaitfordone", false);
 		advertiseObjectInfo = rc.getBoolean("uploadpack",
 				"advertiseobjectinfo", false);
+		advertiseBundleUri = rc.getBoolean("uploadpack",
+				"advertisebundleuris", false);
+		bundleUri = rc.getBoolean("transfer", "bundleuri", false);
+		bundleUriAllowFile = rc.getBoolean("transfer", "bundleuriallowfile",
+				false);
 		allowReceiveClientSID = rc.getBoolean("transfer", "advertisesid",
 				false);
 	}
@@ -357,6 +367,39 @@ public boolean isAdvertiseObjectInfo() {
 		return advertiseObjectInfo;
 	}
 
+	/**
+	 * Whether to advertise bundle-uri to all clients
+	 *
+	 * @return true to advertise bundle-uri to all clients
+	 * @since 6.9
+	 */
+	public boolean isAdvertiseBundleUri() {
+		return advertiseBundleUri;
+	}
+
+	/**
+	 * Whether clones fetch the bundles advertised by the server first
+	 *
+	 * @return true if clones fetch the bundles advertised by the server before
+	 *         fetching from the server
+	 * @since 6.9
+	 */
+	public boolean isBundleUri() {
+		return bundleUri;
+	}
+
+	/**
+	 * Whether clones fetch bundles from local files advertised by a remote
+	 * which is not local
+	 *
+	 * @return true if clones fetch bundles from {@code file://} URIs and
+	 *         local paths advertised by any remote
+	 * @since 6.9
+	 */
+	public boolean isBundleUriAllowFile() {
+		return bundleUriAllowFile;
+	}
+
 	/**
 	 * Whether to advertise and receive session-id capability
 	 *
@@ -46,6 +46,7 @@
 import org.eclipse.jgit.hooks.Hooks;
 import org.eclipse.jgit.hooks.PrePushHook;
 import org.eclipse.jgit.internal.JGitText;
+import org.eclipse.jgit.lib.ConfigConstants;
 import org.eclipse.jgit.lib.Constants;
 import org.eclipse.jgit.lib.ObjectChecker;
 import org.eclipse.jgit.lib.ObjectId;
@@ -53,6 +54,7 @@
 import org.eclipse.jgit.lib.Ref;
 import org.eclipse.jgit.lib.Repository;
 import org.eclipse.jgit.storage.pack.PackConfig;
+import org.eclipse.jgit.util.LazyFetch;
 
 /**
  * Connects two Git repositories together and copies objects between them.
@@ -762,6 +764,9 @@ static String findTrackingRefName(final String remoteName,
 	/** Should fetch request thin-pack if remote repository can produce it. */
 	private boolean fetchThin = DEFAULT_FETCH_THIN;
 
+	/** How fetch finds the commits common with the remote; null for config. */
+	private NegotiationAlgorithm negotiationAlgorithm;
+
 	/** Name of the receive pack program, if it must be executed. */
 	private String optionReceivePack = RemoteConfig.DEFAULT_RECEIVE_PACK;
 
@@ -777,6 +782,14 @@ static String findTrackingRefName(final String remoteName,
 	/** Should push use bitmaps? */
 	private boolean pushUseBitmaps = DEFAULT_PUSH_USE_BITMAPS;
 
+	/** Should push negotiate the commits the remote has? */
+	private boolean pushNegotiate;
+
+	/** Should clones fetch the bundles advertised by the remote first? */
+	private boolean useBundleUri;
+
+	private boolean allowFileBundleUri;
+
 	/** Should push just check for operation result, not really push. */
 	private boolean dryRun;
 
@@ -832,6 +845,10 @@ protected Transport(Repository local, URIish uri) {
 		this.uri = uri;
 		this.protocol = tc.protocolVersion;
 		this.objectChecker = tc.newObjectChecker();
+		this.useBundleUri = tc.isBundleUri();
+		this.allowFileBundleUri = tc.isBundleUriAllowFile();
+		this.pushNegotiate = local.getConfig().get(PushConfig::new)
+				.isNegotiate();
 		this.credentialsProvider = CredentialsProvider.getDefault();
 	}
 
@@ -950,6 +967,36 @@ public void setFetchThin(boolean fetchThin) {
 		this.fetchThin = fetchThin;
 	}
 
+	/**
+	 * Get the algorithm fetch uses to find the commits common with the
+	 * remote.
+	 *
+	 * @return the negotiation algorithm, or null if
+	 *         {@code fetch.negotiationAlgorithm} of the local repository is
+	 *         used
+	 * @since 6.9
+	 */
+	public NegotiationAlgorithm getNegotiationAlgorithm() {
+		return negotiationAlgorithm;
+	}
+
+	/**
+	 * Set the algorithm fetch uses to find the commits common with the
+	 * remote.
+	 * <p>
+	 * A partial clone fetches its missing objects with
+	 * {@link NegotiationAlgorithm#NOOP}, as the remote would otherwise omit
+	 * them as reachable from commits the clone has.
+	 *
+	 * @param algorithm
+	 *            the negotiation algorithm, or null to use
+	 *            {@code fetch.negotiationAlgorithm} of the local repository
+	 * @since 6.9
+	 */
+	public void setNegotiationAlgorithm(NegotiationAlgorithm algorithm) {
+		this.negotiationAlgorithm = algorithm;
+	}
+
 	/**
 	 * Whether fetch will verify if received objects are formatted correctly.
 	 *
@@ -1095,6 +1142,99 @@ public void setPushUseBitmaps(boolean useBitmaps) {
 		this.pushUseBitmaps = useBitmaps;
 	}
 
+	/**
+	 * Whether push negotiates the commits the remote has before sending a
+	 * pack. Default setting is {@code push.negotiate} of the local repository.
+	 *
+	 * @return true if push negotiates the commits the remote has
+	 * @since 6.9
+	 */
+	public boolean isPushNegotiate() {
+		return pushNegotiate;
+	}
+
+	/**
+	 * Set whether push negotiates the commits the remote has before sending
+	 * a pack.
+	 * <p>
+	 * Without negotiation the pack omits only objects reachable from the
+	 * references the remote advertises. Negotiation runs like a fetch, using
+	 * the fetch negotiation algorithm, and also finds commits reachable from
+	 * hidden references. The remote must support protocol V2 and the
+	 * "wait-for-done" fetch argument, otherwise push proceeds without
+	 * negotiation.
+	 *
+	 * @param negotiate
+	 *            true to negotiate the commits the remote has
+	 * @see NegotiationAlgorithm
+	 * @since 6.9
+	 */
+	public void setPushNegotiate(boolean negotiate) {
+		this.pushNegotiate = negotiate;
+	}
+
+	/**
+	 * Whether a clone fetches the bundles advertised by the remote before
+	 * fetching from the remote. Default setting is {@code transfer.bundleURI}
+	 * of the local repository.
+	 *
+	 * @return true if a clone fetches the bundles advertised by the remote
+	 * @since 6.9
+	 */
+	public boolean isUseBundleUri() {
+		return useBundleUri;
+	}
+
+	/**
+	 * Set whether a clone fetches the bundles advertised by the remote before
+	 * fetching from the remote.
+	 * <p>
+	 * The remote must support protocol V2 and the "bundle-uri" command. The
+	 * bundles are fetched from the advertised {@code http://} or
+	 * {@code https://} URIs, and their branches are stored as
+	 * {@code refs/bundles/*}. The following fetch then only transfers the
+	 * objects missing from the bundles. Bundles which cannot be fetched are
+	 * skipped. {@code file://} URIs and local paths are only used if the
+	 * remote is local too, or if {@link #setAllowFileBundleUri(boolean)}
+	 * allows them.
+	 *
+	 * @param useBundleUri
+	 *            true to fetch the bundles advertised by the remote first
+	 * @since 6.9
+	 */
+	public void setUseBundleUri(boolean useBundleUri) {
+		this.useBundleUri = useBundleUri;
+	}
+
+	/**
+	 * Whether bundles are fetched from local files advertised by a remote
+	 * which is not local. Default setting is
+	 * {@code transfer.bundleURIAllowFile} of the local repository.
+	 *
+	 * @return true if bundles are fetched from {@code file://} URIs and
+	 *         local paths advertised by any remote
+	 * @since 6.9
+	 */
+	public boolean isAllowFileBundleUri() {
+		return allowFileBundleUri;
+	}
+
+	/**
+	 * Set whether bundles are fetched from local files advertised by a remote
+	 * which is not local.
+	 * <p>
+	 * A remote could otherwise make the client read any local file it can
+	 * name, so this should only be allowed for trusted remotes.
+	 *
+	 * @param allow
+	 *            true to fetch bundles from {@code file://} URIs and local
+	 *            paths advertised by any remote
+	 * @since 6.9
+	 */
+	public void setAllowFileBundleUri(boolean allow) {
+		this.allowFileBundleUri = allow;
+	}
+
 	/**
 	 * Whether destination refs should be removed if they no longer exist at the
 	 * source repository.
@@ -1166,6 +1306,18 @@ public final void setFilterSpec(@NonNull FilterSpec filter) {
 		filterSpec = requireNonNull(filter);
 	}
 
+	/**
+	 * Whether the remote is a promisor remote of the local repository.
+	 *
+	 * @return true if the remote of this transport is configured with
+	 *         {@code remote.<name>.promisor}
+	 */
+	boolean isPromisorRemote() {
+		return local != null && remoteName != null && local.getConfig()
+				.getBoolean(ConfigConstants.CONFIG_REMOTE_SECTION, remoteName,
+						ConfigConstants.CONFIG_KEY_PROMISOR, false);
+	}
+
 
 	/**
 	 * Retrieves the depth for a shallow clone.
@@ -1481,7 +1633,11 @@ public FetchResult fetch(final ProgressMonitor monitor,
 		final FetchResult result = new FetchResult();
 		new FetchProcess(this, toFetch).execute(monitor, result, branch);
 
-		local.autoGC(monitor);
+		// Objects missing from a partial clone are fetched while they are
+		// being read, possibly by a gc which must not start another one.
+		if (LazyFetch.isEnabled()) {
+			local.autoGC(monitor);
+		}
 
 		return result;
 	}
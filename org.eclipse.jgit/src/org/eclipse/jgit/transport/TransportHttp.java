@@ -1105,6 +1105,67 @@ protected HttpConnection httpOpen(String method, URL u,
 		return conn;
 	}
 
+	/**
+	 * Download the bundle named by the URI of this transport.
+	 * <p>
+	 * Like the requests of a fetch, the request uses the timeout of this
+	 * transport, the proxy and the {@code http} configuration for the URI.
+	 * Redirects are followed unless {@code http.followRedirects} is
+	 * {@code false}, but not from https to http.
+	 *
+	 * @return the content of the bundle
+	 * @throws IOException
+	 *             if the bundle could not be downloaded
+	 */
+	InputStream openBundle() throws IOException {
+		URL u = new URL(currentUri.toString());
+		for (int redirects = 0;; redirects++) {
+			HttpConnection c = httpOpen(METHOD_GET, u,
+					AcceptEncoding.UNSPECIFIED);
+			int status = HttpSupport.response(c);
+			switch (status) {
+			case HttpConnection.HTTP_OK:
+				return c.getInputStream();
+			case HttpConnection.HTTP_MOVED_PERM:
+			case HttpConnection.HTTP_MOVED_TEMP:
+			case HttpConnection.HTTP_SEE_OTHER:
+			case HttpConnection.HTTP_11_MOVED_PERM:
+			case HttpConnection.HTTP_11_MOVED_TEMP:
+				if (http.getFollowRedirects() == HttpRedirectMode.FALSE) {
+					throw new TransportException(uri,
+							MessageFormat.format(JGitText.get().redirectsOff,
+									Integer.valueOf(status)));
+				}
+				String location = c.getHeaderField(HDR_LOCATION);
+				if (location == null || location.isEmpty()) {
+					throw new TransportException(uri, MessageFormat.format(
+							JGitText.get().redirectLocationMissing, u));
+				}
+				if (redirects >= http.getMaxRedirects()) {
+					throw new TransportException(uri, MessageFormat.format(
+							JGitText.get().redirectLimitExceeded,
+							Integer.valueOf(http.getMaxRedirects()), u,
+							location));
+				}
+				URL next = new URL(u, location);
+				String protocol = next.getProtocol();
+				if (!protocol.equalsIgnoreCase(u.getProtocol())
+						&& !"https".equalsIgnoreCase(protocol)) { //$NON-NLS-1$
+					throw new TransportException(uri, MessageFormat.format(
+							JGitText.get().redirectBlocked, u, next));
+				}
+				u = next;
+				break;
+			default:
+				throw new TransportException(uri,
+						MessageFormat.format(
+								JGitText.get().bundleUriUnexpectedHttpStatus,
+								Integer.valueOf(status),
+								c.getResponseMessage()));
+			}
+		}
+	}
+
 	/**
 	 * Adds a list of header strings to the connection. Headers are expected to
 	 * separate keys from values, i.e. "Key: Value". Headers without colon or
@@ -1553,6 +1614,19 @@ class SmartHttpFetchConnection extends BasePackFetchConnection {
 			}
 		}
 
+		@Override
+		BundleList getBundleList() throws TransportException {
+			if (!TransferConfig.ProtocolVersion.V2.equals(getProtocolVersion())
+					|| !isCapableOf(GitProtocolConstants.COMMAND_BUNDLE_URI)) {
+				return null;
+			}
+			// Each command is sent in a request of its own.
+			LongPollService service = new LongPollService(SVC_UPLOAD_PACK,
+					getProtocolVersion());
+			init(service.getInputStream(), service.getOutputStream());
+			return super.getBundleList();
+		}
+
 		@Override
 		protected void doFetch(ProgressMonitor monitor, Collection<Ref> want,
 				Set<ObjectId> have, OutputStream outputStream)
@@ -16,6 +16,7 @@
 import static org.eclipse.jgit.lib.Constants.R_TAGS;
 import static org.eclipse.jgit.transport.GitProtocolConstants.CAPABILITY_REF_IN_WANT;
 import static org.eclipse.jgit.transport.GitProtocolConstants.CAPABILITY_SERVER_OPTION;
+import static org.eclipse.jgit.transport.GitProtocolConstants.COMMAND_BUNDLE_URI;
 import static org.eclipse.jgit.transport.GitProtocolConstants.COMMAND_FETCH;
 import static org.eclipse.jgit.transport.GitProtocolConstants.COMMAND_LS_REFS;
 import static org.eclipse.jgit.transport.GitProtocolConstants.COMMAND_OBJECT_INFO;
@@ -53,12 +54,14 @@
 import java.io.InputStream;
 import java.io.OutputStream;
 import java.io.UncheckedIOException;
+import java.security.MessageDigest;
 import java.text.MessageFormat;
 import java.time.Duration;
 import java.time.Instant;
 import java.util.ArrayList;
 import java.util.Collection;
 import java.util.Collections;
+import java.util.Comparator;
 import java.util.HashSet;
 import java.util.List;
 import java.util.Map;
@@ -81,6 +84,7 @@
 import org.eclipse.jgit.internal.storage.pack.CachedPackUriProvider;
 import org.eclipse.jgit.internal.storage.pack.PackWriter;
 import org.eclipse.jgit.internal.transport.parser.FirstWant;
+import org.eclipse.jgit.lib.Config;
 import org.eclipse.jgit.lib.Constants;
 import org.eclipse.jgit.lib.NullProgressMonitor;
 import org.eclipse.jgit.lib.ObjectId;
@@ -354,6 +358,8 @@ public Set<String> getOptions() {
 
 	private CachedPackUriProvider cachedPackUriProvider;
 
+	private PackResponseCache packResponseCache;
+
 	/**
 	 * Create a new pack upload for an open repository.
 	 *
@@ -751,6 +757,23 @@ public void setCachedPackUriProvider(@Nullable CachedPackUriProvider p) {
 		cachedPackUriProvider = p;
 	}
 
+	/**
+	 * Set the cache of the packs sent to clients.
+	 * <p>
+	 * Packs for requests without objects in common with the client, and
+	 * without shallow, deepen or filter arguments, are taken from the cache,
+	 * so identical requests are only computed once. Packs sent with packfile
+	 * URIs are not cached. The statistics of a pack sent
+	 * from the cache are not available, see {@link #getStatistics()}.
+	 *
+	 * @param cache
+	 *            the cache, or null to generate every pack
+	 * @since 6.9
+	 */
+	public void setPackResponseCache(@Nullable PackResponseCache cache) {
+		packResponseCache = cache;
+	}
+
 	private boolean useProtocolV2() {
 		return (transferConfig.protocolVersion == null
 			|| ProtocolVersion.V2.equals(transferConfig.protocolVersion))
@@ -1363,6 +1386,32 @@ private void objectInfo(PacketLineOut pckOut) throws IOException {
 		pckOut.end();
 	}
 
+	/*
+	 * Sends the bundle list configured in the "bundle" section of the
+	 * repository configuration, as "key=value" lines.
+	 */
+	@SuppressWarnings("nls")
+	private void bundleUri(PacketLineOut pckOut) throws IOException {
+		ProtocolV2Parser parser = new ProtocolV2Parser(transferConfig);
+		parser.parseBundleUriRequest(pckIn);
+
+		Config cfg = db.getConfig();
+		for (String name : cfg.getNames("bundle")) {
+			for (String value : cfg.getStringList("bundle", null, name)) {
+				pckOut.writeString("bundle." + name + '=' + value);
+			}
+		}
+		for (String id : cfg.getSubsections("bundle")) {
+			for (String name : cfg.getNames("bundle", id)) {
+				for (String value : cfg.getStringList("bundle", id, name)) {
+					pckOut.writeString(
+							"bundle." + id + '.' + name + '=' + value);
+				}
+			}
+		}
+		pckOut.end();
+	}
+
 	/*
 	 * Returns true if this is the last command and we should tear down the
 	 * connection.
@@ -1393,6 +1442,10 @@ private boolean serveOneCommandV2(PacketLineOut pckOut) throws IOException {
 			objectInfo(pckOut);
 			return false;
 		}
+		if (command.equals("command=" + COMMAND_BUNDLE_URI)) { //$NON-NLS-1$
+			bundleUri(pckOut);
+			return false;
+		}
 		throw new PackProtocolException(MessageFormat
 				.format(JGitText.get().unknownTransportCommand, command));
 	}
@@ -1423,6 +1476,9 @@ private List<String> getV2CapabilityAdvertisement() {
 		if (transferConfig.isAdvertiseObjectInfo()) {
 			caps.add(COMMAND_OBJECT_INFO);
 		}
+		if (transferConfig.isAdvertiseBundleUri()) {
+			caps.add(COMMAND_BUNDLE_URI);
+		}
 
 		return caps;
 	}
@@ -2377,9 +2433,119 @@ private void sendPack(ProgressMonitor pm, PacketLineOut pckOut,
 		}
 		msgOut.flush();
 
-		PackConfig cfg = packConfig;
-		if (cfg == null)
-			cfg = new PackConfig(db);
+		PackConfig cfg = packConfig != null ? packConfig : new PackConfig(db);
+		ObjectId cacheKey = getPackResponseCacheKey(req, cfg, allTags,
+				deepenNots);
+		if (cacheKey == null) {
+			writePack(pm, pckOut, packOut, req, cfg, accumulator, allTags,
+					unshallowCommits, deepenNots);
+			return;
+		}
+
+		if (pckOut.isUsingSideband()) {
+			pckOut.writeString(GitProtocolConstants.SECTION_PACKFILE + '\n');
+		}
+		packResponseCache.writePack(cacheKey,
+				out -> writePack(pm, null, out, req, cfg, accumulator, allTags,
+						unshallowCommits, deepenNots),
+				packOut);
+	}
+
+	/**
+	 * Compute the key identifying the pack sent for a request in the
+	 * {@link PackResponseCache}.
+	 *
+	 * @return the key, or null if the pack must not be taken from the cache
+	 */
+	@Nullable
+	private ObjectId getPackResponseCacheKey(FetchRequest req, PackConfig cfg,
+			@Nullable Collection<Ref> allTags, List<ObjectId> deepenNots) {
+		if (packResponseCache == null || !commonBase.isEmpty()) {
+			return null;
+		}
+		// Only cache full fetches, so that clients cannot fill the cache
+		// with variants of a pack.
+		if (!req.getClientShallowCommits().isEmpty() || req.getDepth() != 0
+				|| req.getDeepenSince() != 0 || !deepenNots.isEmpty()
+				|| !req.getFilterSpec().isNoOp()) {
+			return null;
+		}
+		if (req instanceof FetchV2Request && cachedPackUriProvider != null
+				&& !((FetchV2Request) req).getPackfileUriProtocols()
+						.isEmpty()) {
+			return null;
+		}
+
+		StringBuilder b = new StringBuilder();
+		appendSorted(b, "want", wantIds); //$NON-NLS-1$
+		Set<String> caps = req.getClientCapabilities();
+		for (String cap : new String[] { OPTION_OFS_DELTA, OPTION_THIN_PACK,
+				OPTION_INCLUDE_TAG }) {
+			if (caps.contains(cap)) {
+				b.append(cap).append('\n');
+			}
+		}
+		if (caps.contains(OPTION_INCLUDE_TAG) && allTags != null) {
+			// Tags are included depending on the state of the tag refs.
+			allTags.stream().filter(r -> r.getObjectId() != null)
+					.sorted(Comparator.comparing(Ref::getName))
+					.forEach(r -> b.append("tag ") //$NON-NLS-1$
+							.append(r.getObjectId().name()).append(' ')
+							.append(r.getName()).append('\n'));
+		}
+		appendPackConfig(b, cfg);
+
+		MessageDigest md = Constants.newMessageDigest();
+		return ObjectId.fromRaw(md.digest(Constants.encode(b.toString())));
+	}
+
+	/**
+	 * Append the options of a pack configuration which change the pack
+	 * written for a request. Options which only affect resources used while
+	 * writing it, or files written next to a pack, are left out.
+	 */
+	private static void appendPackConfig(StringBuilder b, PackConfig cfg) {
+		b.append("reuseDeltas ") //$NON-NLS-1$
+				.append(cfg.isReuseDeltas()).append('\n');
+		b.append("reuseObjects ") //$NON-NLS-1$
+				.append(cfg.isReuseObjects()).append('\n');
+		b.append("partialPackReuse ") //$NON-NLS-1$
+				.append(cfg.isPartialPackReuse()).append('\n');
+		b.append("deltaCompress ") //$NON-NLS-1$
+				.append(cfg.isDeltaCompress()).append('\n');
+		b.append("maxDeltaDepth ") //$NON-NLS-1$
+				.append(cfg.getMaxDeltaDepth()).append('\n');
+		b.append("cutDeltaChains ") //$NON-NLS-1$
+				.append(cfg.getCutDeltaChains()).append('\n');
+		b.append("deltaSearchWindowSize ") //$NON-NLS-1$
+				.append(cfg.getDeltaSearchWindowSize()).append('\n');
+		b.append("deltaSearchMemoryLimit ") //$NON-NLS-1$
+				.append(cfg.getDeltaSearchMemoryLimit()).append('\n');
+		b.append("bigFileThreshold ") //$NON-NLS-1$
+				.append(cfg.getBigFileThreshold()).append('\n');
+		b.append("compressionLevel ") //$NON-NLS-1$
+				.append(cfg.getCompressionLevel()).append('\n');
+		if (cfg.isUseDeltaIslands()) {
+			b.append("deltaIslands"); //$NON-NLS-1$
+			for (String island : cfg.getDeltaIslands()) {
+				b.append(' ').append(island);
+			}
+			b.append('\n');
+		}
+	}
+
+	private static void appendSorted(StringBuilder b, String name,
+			Collection<? extends ObjectId> ids) {
+		b.append(name);
+		ids.stream().sorted().forEach(id -> b.append(' ').append(id.name()));
+		b.append('\n');
+	}
+
+	private void writePack(ProgressMonitor pm, @Nullable PacketLineOut pckOut,
+			OutputStream packOut, FetchRequest req, PackConfig cfg,
+			PackStatistics.Accumulator accumulator,
+			@Nullable Collection<Ref> allTags, List<ObjectId> unshallowCommits,
+			List<ObjectId> deepenNots) throws IOException {
 		@SuppressWarnings("resource") // PackWriter is referenced in the finally
 										// block, and is closed there
 		final PackWriter pw = new PackWriter(cfg, walk.getObjectReader(),
@@ -2485,7 +2651,7 @@ else if (ref.getName().startsWith(Constants.R_HEADS))
 				}
 			}
 
-			if (pckOut.isUsingSideband()) {
+			if (pckOut != null && pckOut.isUsingSideband()) {
 				if (req instanceof FetchV2Request &&
 						cachedPackUriProvider != null &&
 						!((FetchV2Request) req).getPackfileUriProtocols().isEmpty()) {
@@ -211,6 +211,14 @@ private Entry[] entries() {
 		return fs.list(directory, fileModeStrategy);
 	}
 
+	@Override
+	protected Entry getDirectoryEntry() {
+		if (parent == null) {
+			return new FileEntry(directory, fs, fileModeStrategy);
+		}
+		return super.getDirectoryEntry();
+	}
+
 	/**
 	 * An interface representing the methods used to determine the FileMode for
 	 * a FileEntry.
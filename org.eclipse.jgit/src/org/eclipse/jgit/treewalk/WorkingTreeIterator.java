@@ -33,6 +33,7 @@
 import java.util.Comparator;
 import java.util.HashMap;
 import java.util.Map;
+import java.util.Objects;
 
 import org.eclipse.jgit.api.errors.FilterFailedException;
 import org.eclipse.jgit.attributes.AttributesNode;
@@ -42,6 +43,7 @@
 import org.eclipse.jgit.diff.RawText;
 import org.eclipse.jgit.dircache.DirCacheEntry;
 import org.eclipse.jgit.dircache.DirCacheIterator;
+import org.eclipse.jgit.dircache.UntrackedCache;
 import org.eclipse.jgit.errors.CorruptObjectException;
 import org.eclipse.jgit.errors.LargeObjectException;
 import org.eclipse.jgit.errors.MissingObjectException;
@@ -124,6 +126,18 @@ public abstract class WorkingTreeIterator extends AbstractTreeIterator {
 	/** If there is a .gitignore file present, the parsed rules from it. */
 	private IgnoreNode ignoreNode;
 
+	/** The .gitignore file of this directory, if there is one. */
+	private Entry ignoreFileEntry;
+
+	/** Untracked cache record of this directory, if the cache is used. */
+	private UntrackedCache.Directory untrackedDir;
+
+	/** Whether the ignore rules did not change since they were cached. */
+	private boolean untrackedRulesValid;
+
+	/** Whether {@link #untrackedDir} tells which entries are ignored. */
+	private boolean untrackedDirValid;
+
 	/**
 	 * cached clean filter command. Use a Ref in order to distinguish between
 	 * the ref not cached yet and the value null
@@ -233,6 +247,76 @@ public void setDirCacheIterator(TreeWalk walk, int treeId) {
 		state.dirCacheTree = treeId;
 	}
 
+	/**
+	 * Use an untracked cache to tell which entries not in the index are
+	 * ignored.
+	 * <p>
+	 * Entries of directories which did not change since they were recorded in
+	 * the cache, and whose ignore rules did not change either, are not
+	 * matched against the ignore rules again. The results for all other
+	 * directories are recorded in the cache. This requires that
+	 * {@link #setDirCacheIterator(TreeWalk, int)} was called, and that the
+	 * walk asks {@link #isEntryIgnored()} for every entry which is not in the
+	 * index, as {@link org.eclipse.jgit.treewalk.filter.IndexDiffFilter}
+	 * does.
+	 * <p>
+	 * Must be invoked on the root iterator, before the walk starts.
+	 *
+	 * @param cache
+	 *            the untracked cache, prepared for the repository of this
+	 *            iterator with
+	 *            {@link UntrackedCache#prepare(Repository)}; {@code null}
+	 *            to not use an untracked cache
+	 * @since 6.9
+	 */
+	public void setUntrackedCache(UntrackedCache cache) {
+		untrackedDir = null;
+		if (cache != null && state.walk != null) {
+			initUntrackedDir(cache.getRoot(), true);
+		}
+	}
+
+	private void initUntrackedDir(UntrackedCache.Directory dir,
+			boolean parentRulesValid) {
+		Entry e = getDirectoryEntry();
+		if (e == null) {
+			return;
+		}
+		ObjectId ignoreFileId = null;
+		if (ignoreFileEntry != null) {
+			try (InputStream in = ignoreFileEntry.openInputStream()) {
+				ignoreFileId = UntrackedCache.idOf(in.readAllBytes());
+			} catch (IOException err) {
+				// Evaluate the ignore rules of this subtree normally.
+				return;
+			}
+		}
+		Instant lastModified = e.getLastModifiedInstant();
+		long length = e.getLength();
+		untrackedRulesValid = parentRulesValid
+				&& Objects.equals(ignoreFileId, dir.getIgnoreFileId());
+		untrackedDirValid = untrackedRulesValid
+				&& dir.isValid(lastModified, length);
+		if (!untrackedDirValid) {
+			dir.reset(lastModified, length, ignoreFileId);
+		}
+		untrackedDir = dir;
+	}
+
+	/**
+	 * Get the entry of the directory this iterator lists.
+	 *
+	 * @return the entry of the directory in the parent iterator, or
+	 *         {@code null} if it is not known
+	 * @since 6.9
+	 */
+	protected Entry getDirectoryEntry() {
+		if (parent instanceof WorkingTreeIterator) {
+			return ((WorkingTreeIterator) parent).current();
+		}
+		return null;
+	}
+
 	/**
 	 * Retrieves the {@link DirCacheIterator} at the current entry if
 	 * {@link #setDirCacheIterator(TreeWalk, int)} was called.
@@ -673,6 +757,20 @@ && getEolStreamType(
 	 *             a relevant ignore rule file exists but cannot be read.
 	 */
 	public boolean isEntryIgnored() throws IOException {
+		if (untrackedDir != null && getDirCacheIterator() == null) {
+			String name = current().getName();
+			if (FileMode.TREE.equals(mode) || FileMode.GITLINK.equals(mode)) {
+				name += '/';
+			}
+			if (untrackedDirValid) {
+				return !untrackedDir.isUntracked(name);
+			}
+			boolean ignored = isEntryIgnored(pathLen);
+			if (!ignored) {
+				untrackedDir.addUntracked(name);
+			}
+			return ignored;
+		}
 		return isEntryIgnored(pathLen);
 	}
 
@@ -794,11 +892,13 @@ protected void init(Entry[] list) {
 				continue;
 			if (Constants.DOT_GIT.equals(name))
 				continue;
-			if (Constants.DOT_GIT_IGNORE.equals(name))
+			if (Constants.DOT_GIT_IGNORE.equals(name)) {
+				ignoreFileEntry = e;
 				ignoreNode = new PerDirectoryIgnoreNode(
 						TreeWalk.pathOf(path, 0, pathOffset)
 								+ Constants.DOT_GIT_IGNORE,
 						e);
+			}
 			if (Constants.DOT_GIT_ATTRIBUTES.equals(name))
 				attributesNode = new PerDirectoryAttributesNode(e);
 			if (i != o)
@@ -815,6 +915,14 @@ protected void init(Entry[] list) {
 			parseEntry();
 		else if (pathLen == 0) // see bug 445363
 			pathLen = pathOffset;
+
+		if (parent instanceof WorkingTreeIterator) {
+			WorkingTreeIterator p = (WorkingTreeIterator) parent;
+			if (p.untrackedDir != null) {
+				initUntrackedDir(p.untrackedDir.getOrAddDirectory(
+						p.current().getName()), p.untrackedRulesValid);
+			}
+		}
 	}
 
 	/**
@@ -895,7 +1003,7 @@ public boolean isModeDifferent(int rawMode) {
 	 *         which tells whether and how the entries metadata differ
 	 */
 	public MetadataDiff compareMetadata(DirCacheEntry entry) {
-		if (entry.isAssumeValid())
+		if (entry.isAssumeValid() || entry.isFsMonitorValid())
 			return MetadataDiff.EQUAL;
 
 		if (entry.isUpdateNeeded())
@@ -955,6 +1063,11 @@ public boolean isModified(DirCacheEntry entry, boolean forceContentCheck,
 			ObjectReader reader) throws IOException {
 		if (entry == null)
 			return !FileMode.MISSING.equals(getEntryFileMode());
+		if (entry.isFsMonitorValid()) {
+			// The file system monitor did not see the file change since it
+			// was found to be unmodified.
+			return false;
+		}
 		MetadataDiff diff = compareMetadata(entry);
 		switch (diff) {
 		case DIFFER_BY_TIMESTAMP:
@@ -155,6 +155,19 @@ public boolean include(TreeWalk tw) throws MissingObjectException,
 			}
 		}
 
+		// A directory collapsed by a sparse index is not in the working tree.
+		// Only its tree can differ from the other trees.
+		if (wm == 0 && di != null && di.isSparseDirectory()) {
+			for (int i = 0; i < cnt; i++) {
+				if (i == dirCache || i == workingTree)
+					continue;
+				if (tw.getRawMode(i) != tw.getRawMode(dirCache)
+						|| !tw.idEqual(i, dirCache))
+					return true;
+			}
+			return false;
+		}
+
 		// If the working tree file doesn't exist, it does exist for at least
 		// one other so include this difference.
 		if (wm == 0)
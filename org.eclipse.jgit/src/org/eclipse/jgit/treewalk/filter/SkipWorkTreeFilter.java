@@ -43,7 +43,11 @@ public boolean include(TreeWalk walker) {
 			return true;
 
 		DirCacheEntry e = i.getDirCacheEntry();
-		return e == null || !e.isSkipWorkTree();
+		if (e == null) {
+			// Directories collapsed by a sparse index are skipped as a whole.
+			return !i.isSparseDirectory();
+		}
+		return !e.isSkipWorkTree();
 	}
 
 	@Override
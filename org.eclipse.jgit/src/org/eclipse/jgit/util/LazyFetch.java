@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026, JGit contributors
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Distribution License v. 1.0 which is available at
+ * https://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+package org.eclipse.jgit.util;
+
+import java.util.concurrent.Callable;
+
+/**
+ * Controls whether objects missing from a partial clone are fetched from its
+ * promisor remote when the current thread reads them.
+ * <p>
+ * Fetching is enabled by default. Code which looks for missing objects
+ * without needing them, for example a fetch deciding what to ask for,
+ * disables it for the current thread, and passes that state on to the
+ * worker threads it uses.
+ *
+ * @since 6.9
+ */
+public final class LazyFetch {
+	/** Set while the current thread must not fetch missing objects. */
+	private static final ThreadLocal<Boolean> DISABLED = new ThreadLocal<>();
+
+	private LazyFetch() {
+		// Static utility methods only
+	}
+
+	/**
+	 * Whether missing objects are fetched on the current thread.
+	 *
+	 * @return {@code false} if fetching was disabled by {@link #disable()}
+	 */
+	public static boolean isEnabled() {
+		return DISABLED.get() == null;
+	}
+
+	/**
+	 * Stop fetching missing objects on the current thread.
+	 *
+	 * @return whether missing objects were fetched before, to be passed to
+	 *         {@link #restore(boolean)}
+	 */
+	public static boolean disable() {
+		boolean enabled = isEnabled();
+		DISABLED.set(Boolean.TRUE);
+		return enabled;
+	}
+
+	/**
+	 * Restore fetching missing objects on the current thread.
+	 *
+	 * @param enabled
+	 *            the value returned by the matching {@link #disable()}
+	 */
+	public static void restore(boolean enabled) {
+		if (enabled) {
+			DISABLED.remove();
+		}
+	}
+
+	/**
+	 * Pass the state of the current thread to a task run on another thread.
+	 * <p>
+	 * If fetching missing objects is disabled on the current thread, it is
+	 * disabled while the returned task runs, so that worker threads reading
+	 * objects for the current thread do not fetch them one by one.
+	 *
+	 * @param task
+	 *            the task to run on another thread
+	 * @return the task to submit instead of {@code task}
+	 */
+	public static Runnable inherit(Runnable task) {
+		if (isEnabled()) {
+			return task;
+		}
+		return () -> {
+			boolean enabled = disable();
+			try {
+				task.run();
+			} finally {
+				restore(enabled);
+			}
+		};
+	}
+
+	/**
+	 * Pass the state of the current thread to a task run on another thread.
+	 *
+	 * @param <V>
+	 *            type of the result of the task
+	 * @param task
+	 *            the task to run on another thread
+	 * @return the task to submit instead of {@code task}
+	 * @see #inherit(Runnable)
+	 */
+	public static <V> Callable<V> inherit(Callable<V> task) {
+		if (isEnabled()) {
+			return task;
+		}
+		return () -> {
+			boolean enabled = disable();
+			try {
+				return task.call();
+			} finally {
+				restore(enabled);
+			}
+		};
+	}
+}